@@ -0,0 +1,373 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_core.cpp
+// Purpose:     BWX_SDK Library Benchmarks; bwx_core (JSON, strings, dates, properties, resources)
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include <bwx_sdk/bwx_core/bwx_datetime.h>
+#include <bwx_sdk/bwx_core/bwx_json.h>
+#include <bwx_sdk/bwx_core/bwx_oop.h>
+#include <bwx_sdk/bwx_core/bwx_string.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_resource_manager.h>
+
+#include <memory>
+#include <random>
+
+#include "bwx_bench.h"
+
+using namespace bwx_sdk;
+
+namespace {
+
+    // Array of records shaped like an application's data file: strings, numbers, flags, nesting
+    std::string MakeJsonDocument(int64_t records) {
+        std::mt19937 random(42);
+        std::string text = "{\"version\":3,\"generator\":\"bwx_bench\",\"records\":[";
+
+        for (int64_t i = 0; i < records; ++i) {
+            if (i > 0) text += ',';
+            text += "{\"id\":" + std::to_string(i);
+            text += ",\"name\":\"Record \\\"" + std::to_string(random() % 100000) + "\\\" \\u00e9t\\u00e9\"";
+            text += ",\"score\":" + std::to_string(static_cast<double>(random() % 1000000) / 1000.0);
+            text += ",\"active\":" + std::string(random() % 2 ? "true" : "false");
+            text += ",\"parent\":null,\"tags\":[\"alpha\",\"beta\",\"gamma\"]";
+            text += ",\"position\":{\"x\":" + std::to_string(random() % 1920) + ",\"y\":" + std::to_string(random() % 1080) + "}}";
+        }
+
+        text += "]}";
+        return text;
+    }
+
+    // Words of 2-10 letters joined by the separator
+    std::string MakeText(size_t words, char separator) {
+        std::mt19937 random(7);
+        std::string text;
+        text.reserve(words * 7);
+
+        for (size_t i = 0; i < words; ++i) {
+            if (i > 0) text += separator;
+            const int length = 2 + static_cast<int>(random() % 9);
+            for (int c = 0; c < length; ++c) text += static_cast<char>('a' + random() % 26);
+        }
+        return text;
+    }
+
+    // JSON
+
+    void JSON_ParseUtf8(bwx_bench::State& state) {
+        const std::string text = MakeJsonDocument(state.GetArg());
+        for (auto _ : state) {
+            bwxJSON json;
+            bwx_bench::DoNotOptimize(json.ParseFromUtf8(text));
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.size()));
+    }
+    BWX_BENCHMARK(JSON_ParseUtf8, 10, 1000, 20000);
+
+    void JSON_ParseString(bwx_bench::State& state) {
+        const std::string utf8 = MakeJsonDocument(state.GetArg());
+        const wxString text = wxString::FromUTF8(utf8.data(), utf8.size());
+        for (auto _ : state) {
+            bwxJSON json;
+            bwx_bench::DoNotOptimize(json.ParseFromString(text));
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(utf8.size()));
+    }
+    BWX_BENCHMARK(JSON_ParseString, 1000);
+
+    void JSON_SerializeUtf8(bwx_bench::State& state) {
+        bwxJSON json;
+        json.ParseFromUtf8(MakeJsonDocument(state.GetArg()));
+
+        std::string out;
+        for (auto _ : state) {
+            out.clear();
+            json.SerializeToUtf8(out);
+            bwx_bench::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(out.size()));
+    }
+    BWX_BENCHMARK(JSON_SerializeUtf8, 10, 1000, 20000);
+
+    void JSON_SerializePretty(bwx_bench::State& state) {
+        bwxJSON json;
+        json.ParseFromUtf8(MakeJsonDocument(state.GetArg()));
+
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(json.SerializePretty());
+        }
+    }
+    BWX_BENCHMARK(JSON_SerializePretty, 1000);
+
+    // Strings
+
+    void String_SplitView(bwx_bench::State& state) {
+        const std::string text = MakeText(static_cast<size_t>(state.GetArg()), ',');
+        for (auto _ : state) {
+            size_t count = 0;
+            for (std::string_view piece : str::bwxSplit(text, ",")) count += piece.size();
+            bwx_bench::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.size()));
+    }
+    BWX_BENCHMARK(String_SplitView, 100000);
+
+    void String_SimpleExplode(bwx_bench::State& state) {
+        const wxString text = MakeText(static_cast<size_t>(state.GetArg()), ',');
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(str::bwxSimpleExplode(text, ","));
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.length()));
+    }
+    BWX_BENCHMARK(String_SimpleExplode, 100000);
+
+    void String_MultiReplace(bwx_bench::State& state) {
+        const std::string text = MakeText(static_cast<size_t>(state.GetArg()), ' ');
+        const str::bwxMultiReplacer replacer({ { "ab", "[AB]" }, { "abc", "<ABC>" }, { "xyz", "" }, { "qu", "kw" },
+            { "th", "TH" }, { "e", "E" }, { "ing", "ING" }, { "zz", "z" } });
+
+        std::string out;
+        for (auto _ : state) {
+            out.clear();
+            replacer.Replace(out, text);
+            bwx_bench::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.size()));
+    }
+    BWX_BENCHMARK(String_MultiReplace, 100000);
+
+    void String_ReplaceAll(bwx_bench::State& state) {
+        const wxString text = MakeText(static_cast<size_t>(state.GetArg()), ' ');
+        wxArrayString from;
+        wxArrayString to;
+        for (const char* pattern : { "ab", "abc", "xyz", "qu", "th", "e", "ing", "zz" }) from.Add(pattern);
+        for (const char* replacement : { "[AB]", "<ABC>", "", "kw", "TH", "E", "ING", "z" }) to.Add(replacement);
+
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(str::bwxReplaceAll(text, from, to));
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.length()));
+    }
+    BWX_BENCHMARK(String_ReplaceAll, 100000);
+
+    void String_RemoveChars(bwx_bench::State& state) {
+        const std::string text = MakeText(static_cast<size_t>(state.GetArg()), ' ');
+        const str::bwxCharFilter filter("aeiou ");
+
+        std::string out;
+        for (auto _ : state) {
+            out.clear();
+            str::bwxRemoveChars(out, text, filter);
+            bwx_bench::DoNotOptimize(out.data());
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.size()));
+    }
+    BWX_BENCHMARK(String_RemoveChars, 100000);
+
+    void String_Trim(bwx_bench::State& state) {
+        const wxString text = "   " + wxString(MakeText(16, ' ')) + "  \t ";
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(str::bwxTrim(text));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(String_Trim);
+
+    void String_ToLowerCase(bwx_bench::State& state) {
+        const wxString text = str::bwxToUpperCase(MakeText(1000, ' '));
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(str::bwxToLowerCase(text));
+        }
+        state.SetBytesProcessed(state.GetIterations() * static_cast<int64_t>(text.length()));
+    }
+    BWX_BENCHMARK(String_ToLowerCase);
+
+    // Date and time
+
+    wxDateTime MakeDate(int64_t i) {
+        return wxDateTime(static_cast<wxDateTime::wxDateTime_t>(1 + i % 28), static_cast<wxDateTime::Month>(i % 12),
+            static_cast<int>(1990 + i % 50), static_cast<wxDateTime::wxDateTime_t>(i % 24),
+            static_cast<wxDateTime::wxDateTime_t>(i % 60), static_cast<wxDateTime::wxDateTime_t>(i % 60));
+    }
+
+    void DateTime_Format(bwx_bench::State& state) {
+        const wxDateTime date = MakeDate(12345);
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(dt::bwxFormatDateTime(date));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(DateTime_Format);
+
+    void DateTime_FormatNames(bwx_bench::State& state) {
+        const wxDateTime date = MakeDate(12345);
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(dt::bwxFormatDateTime(date, "$dd, $D $MMMM $YYYY $hh:$m"));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(DateTime_FormatNames);
+
+    void DateTime_FormatToBuffer(bwx_bench::State& state) {
+        const dt::bwxDateTimeFormat format;
+        const wxDateTime date = MakeDate(12345);
+        char buffer[64];
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(format.FormatTo(date, buffer, sizeof(buffer)));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(DateTime_FormatToBuffer);
+
+    void DateTime_ToISO8601(bwx_bench::State& state) {
+        const wxDateTime date = MakeDate(12345);
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(dt::bwxToISO8601(date));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(DateTime_ToISO8601);
+
+    void DateTime_ParseISO8601(bwx_bench::State& state) {
+        const std::string text = "2026-10-15T13:45:30.250+02:00";
+        wxDateTime date;
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(dt::bwxParseISO8601(text, date));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(DateTime_ParseISO8601);
+
+    // Properties
+
+    void Property_Set(bwx_bench::State& state) {
+        bwxProperty<int> property(0);
+        int value = 0;
+        for (auto _ : state) {
+            property.set(++value);
+        }
+        bwx_bench::DoNotOptimize(property.get());
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(Property_Set);
+
+    void Property_SetNotify(bwx_bench::State& state) {
+        int64_t notified = 0;
+        bwxProperty<int> property(0, nullptr, [&notified](const int&, const int&) { notified++; });
+        int value = 0;
+        for (auto _ : state) {
+            property.set(++value);
+        }
+        bwx_bench::DoNotOptimize(notified);
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(Property_SetNotify);
+
+    void Property_SetHistory(bwx_bench::State& state) {
+        bwxProperty<wxString> property(wxString(), nullptr, nullptr, nullptr, static_cast<size_t>(state.GetArg()));
+        const wxString values[2] = { "first value", "second value" };
+        int64_t i = 0;
+        for (auto _ : state) {
+            property.set(values[++i & 1]);
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(Property_SetHistory, 100);
+
+    void Property_SetBound(bwx_bench::State& state) {
+        std::vector<std::unique_ptr<bwxProperty<int>>> properties;
+        for (int64_t i = 0; i < state.GetArg(); ++i) properties.push_back(std::make_unique<bwxProperty<int>>(0));
+        for (size_t i = 1; i < properties.size(); ++i) properties[i - 1]->bind(*properties[i]);
+
+        int value = 0;
+        for (auto _ : state) {
+            properties.front()->set(++value);
+        }
+        state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+    }
+    BWX_BENCHMARK(Property_SetBound, 8);
+
+    // Sets every property of a batch; one notification each when the batch ends
+    void Property_BatchNotify(bwx_bench::State& state) {
+        int64_t notified = 0;
+        std::vector<std::unique_ptr<bwxProperty<int>>> properties;
+        for (int64_t i = 0; i < state.GetArg(); ++i) {
+            properties.push_back(std::make_unique<bwxProperty<int>>(0, nullptr, [&notified](const int&, const int&) { notified++; }));
+        }
+
+        int value = 0;
+        for (auto _ : state) {
+            bwxPropertyBatch batch;
+            ++value;
+            for (auto& property : properties) {
+                property->set(value);
+                property->set(value + 1);
+            }
+        }
+        bwx_bench::DoNotOptimize(notified);
+        state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+    }
+    BWX_BENCHMARK(Property_BatchNotify, 100);
+
+    // Resource manager lookups (no GL involved - the resource only has to load)
+
+    struct BenchResource {
+        bool LoadFromFile(const std::string&) { return true; }
+        void Unload() {}
+    };
+
+    using BenchResourceManager = bwxGLResourceManager<BenchResource>;
+
+    std::vector<std::string> FillResources(BenchResourceManager& manager, int64_t count) {
+        std::vector<std::string> names;
+        for (int64_t i = 0; i < count; ++i) {
+            names.push_back("assets/textures/material_" + std::to_string(i) + ".png");
+            manager.KeepAlive(names.back(), std::make_shared<BenchResource>());
+        }
+        return names;
+    }
+
+    void ResourceManager_GetByName(bwx_bench::State& state) {
+        BenchResourceManager manager;
+        const std::vector<std::string> names = FillResources(manager, state.GetArg());
+        size_t i = 0;
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(manager.Get(names[i++ % names.size()]));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(ResourceManager_GetByName, 16, 1024);
+
+    void ResourceManager_Has(bwx_bench::State& state) {
+        BenchResourceManager manager;
+        const std::vector<std::string> names = FillResources(manager, state.GetArg());
+        size_t i = 0;
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(manager.Has(names[i++ % names.size()]));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(ResourceManager_Has, 16, 1024);
+
+    void ResourceManager_ResolveHandle(bwx_bench::State& state) {
+        BenchResourceManager manager;
+        std::vector<bwxGLResourceHandle> handles;
+        for (const std::string& name : FillResources(manager, state.GetArg())) handles.push_back(manager.GetHandle(name));
+
+        size_t i = 0;
+        for (auto _ : state) {
+            bwx_bench::DoNotOptimize(manager.Resolve(handles[i++ % handles.size()]));
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(ResourceManager_ResolveHandle, 16, 1024);
+
+}
@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_gui.cpp
+// Purpose:     BWX_SDK Library Benchmarks; bwx_gui (text storage, text layout)
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include <bwx_sdk/bwx_gui/bwx_text_document.h>
+#include <bwx_sdk/bwx_gui/bwx_text_renderer.h>
+
+#include <random>
+
+#include "bwx_bench.h"
+
+using namespace bwx_sdk::gui;
+
+namespace {
+
+    // Manuscript-like text: words of 2-10 letters, a paragraph every ~80 words
+    wxString MakeDocument(int64_t words) {
+        std::mt19937 random(42);
+        wxString text;
+        text.Alloc(static_cast<size_t>(words) * 7);
+
+        for (int64_t i = 0; i < words; ++i) {
+            const int length = 2 + static_cast<int>(random() % 9);
+            for (int c = 0; c < length; ++c)
+                text.Append(static_cast<wxChar>('a' + random() % 26));
+            text.Append(random() % 80 == 0 ? wxChar('\n') : wxChar(' '));
+        }
+
+        return text;
+    }
+
+    // Gap buffer, 100k word document; edits keep the length stable
+
+    std::unique_ptr<ITextStorage> MakeStorage(int64_t words) {
+        std::unique_ptr<ITextStorage> storage = CreateTextStorage(TextStorageType::GapBuffer);
+        storage->SetText(MakeDocument(words));
+        return storage;
+    }
+
+    void GapBuffer_TypeAtCursor(bwx_bench::State& state) {
+        std::unique_ptr<ITextStorage> storage = MakeStorage(state.GetArg());
+        int pos = storage->GetLength() / 2;
+        for (auto _ : state) {
+            storage->InsertText(pos++, "x");
+            storage->DeleteText(pos - 1, pos);
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(GapBuffer_TypeAtCursor, 100000);
+
+    void GapBuffer_Backspace(bwx_bench::State& state) {
+        std::unique_ptr<ITextStorage> storage = MakeStorage(state.GetArg());
+        const int pos = storage->GetLength() / 2;
+        for (auto _ : state) {
+            storage->DeleteText(pos - 1, pos);
+            storage->InsertText(pos - 1, "y");
+        }
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    BWX_BENCHMARK(GapBuffer_Backspace, 100000);
+
+    // Moves the gap on every edit - the gap buffer's worst case
+    void GapBuffer_RandomInsertDelete(bwx_bench::State& state) {
+        std::unique_ptr<ITextStorage> storage = MakeStorage(state.GetArg());
+        std::mt19937 random(7);
+        for (auto _ : state) {
+            const int insertPos = static_cast<int>(random() % (storage->GetLength() + 1));
+            storage->InsertText(insertPos, "word ");
+            const int deletePos = static_cast<int>(random() % (storage->GetLength() - 5));
+            storage->DeleteText(deletePos, deletePos + 5);
+        }
+        state.SetItemsProcessed(state.GetIterations() * 2);
+    }
+    BWX_BENCHMARK(GapBuffer_RandomInsertDelete, 100000);
+
+    void GapBuffer_RangeRead(bwx_bench::State& state) {
+        std::unique_ptr<ITextStorage> storage = MakeStorage(state.GetArg());
+        std::mt19937 random(7);
+        storage->InsertText(storage->GetLength() / 2, "gap");
+        for (auto _ : state) {
+            const int pos = static_cast<int>(random() % (storage->GetLength() - 4096));
+            bwx_bench::DoNotOptimize(storage->GetText(pos, pos + 4096));
+        }
+        state.SetBytesProcessed(state.GetIterations() * 4096 * static_cast<int64_t>(sizeof(wxChar)));
+    }
+    BWX_BENCHMARK(GapBuffer_RangeRead, 100000);
+
+    // FullViewRenderer::CalculateLayout() through UpdateLayout() (the public entry), 800x600 client
+
+    void TextLayout_Full(bwx_bench::State& state) {
+        bwxTextDocument document;
+        document.SetText(MakeDocument(state.GetArg()));
+
+        FullViewRenderer renderer;
+        renderer.SetLazyLayout(false);
+        renderer.SetDocument(&document);
+        renderer.OnResize(800, 600);
+
+        const wxRect client(0, 0, 800, 600);
+        for (auto _ : state) {
+            renderer.InvalidateLayout();
+            bwx_bench::DoNotOptimize(renderer.UpdateLayout(0, client));
+        }
+        state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+        state.SetLabel("words");
+    }
+    BWX_BENCHMARK(TextLayout_Full, 20000, 200000);
+
+    // Time to first paint with estimated off-screen heights
+    void TextLayout_Lazy(bwx_bench::State& state) {
+        bwxTextDocument document;
+        document.SetText(MakeDocument(state.GetArg()));
+
+        FullViewRenderer renderer;
+        renderer.SetLazyLayout(true);
+        renderer.SetBackgroundLayout(false);
+        renderer.SetDocument(&document);
+        renderer.OnResize(800, 600);
+
+        const wxRect client(0, 0, 800, 600);
+        for (auto _ : state) {
+            renderer.InvalidateLayout();
+            bwx_bench::DoNotOptimize(renderer.UpdateLayout(0, client));
+        }
+        state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+        state.SetLabel("words");
+    }
+    BWX_BENCHMARK(TextLayout_Lazy, 200000);
+
+    // One character typed in the middle of a laid out document (re-wraps one paragraph)
+    void TextLayout_Edit(bwx_bench::State& state) {
+        bwxTextDocument document;
+        document.SetText(MakeDocument(state.GetArg()));
+
+        FullViewRenderer renderer;
+        renderer.SetLazyLayout(false);
+        renderer.SetDocument(&document);
+        renderer.OnResize(800, 600);
+
+        const wxRect client(0, 0, 800, 600);
+        renderer.UpdateLayout(0, client);
+
+        const int pos = document.GetLength() / 2;
+        for (auto _ : state) {
+            document.InsertText(pos, "x");
+            renderer.OnTextEdited(pos, 0, 1);
+            renderer.UpdateLayout(0, client);
+
+            document.DeleteText(pos, pos + 1);
+            renderer.OnTextEdited(pos, 1, 0);
+            bwx_bench::DoNotOptimize(renderer.UpdateLayout(0, client));
+        }
+        state.SetItemsProcessed(state.GetIterations() * 2);
+    }
+    BWX_BENCHMARK(TextLayout_Edit, 200000);
+
+}
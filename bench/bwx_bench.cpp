@@ -0,0 +1,277 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_bench.cpp
+// Purpose:     BWX_SDK Library Benchmarks; Runner and JSON report
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include "bwx_bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <regex>
+#include <thread>
+
+namespace bwx_bench {
+
+    namespace {
+
+        struct Benchmark {
+            std::string name;
+            Function function;
+            int64_t arg;
+        };
+
+        struct Result {
+            std::string name;
+            int64_t iterations;
+            int repetitions;
+            double realNs;  ///< Median per iteration
+            double minNs;
+            double cpuNs;
+            double itemsPerSecond;
+            double bytesPerSecond;
+            std::string label;
+        };
+
+        struct Options {
+            std::string filter = ".";
+            double minTime = 0.2;
+            int repetitions = 5;
+            std::string jsonFile;
+            bool list = false;
+        };
+
+        std::vector<Benchmark>& GetBenchmarks() {
+            static std::vector<Benchmark> benchmarks;
+            return benchmarks;
+        }
+
+        State RunOnce(const Benchmark& benchmark, int64_t iterations) {
+            State state(iterations, benchmark.arg);
+            benchmark.function(state);
+            return state;
+        }
+
+        Result Run(const Benchmark& benchmark, const Options& options) {
+            // Grows the iteration count until one run takes minTime
+            int64_t iterations = 1;
+            while (true) {
+                const double seconds = RunOnce(benchmark, iterations).GetRealSeconds();
+                if (seconds >= options.minTime || iterations >= 1000000000) break;
+
+                const double scale = seconds > 0.0 ? options.minTime * 1.4 / seconds : 100.0;
+                iterations = std::min<int64_t>(1000000000, std::max<int64_t>(iterations + 1, static_cast<int64_t>(iterations * std::min(scale, 100.0))));
+            }
+
+            std::vector<double> realNs;
+            std::vector<double> cpuNs;
+            double items = 0.0;
+            double bytes = 0.0;
+            double realSeconds = 0.0;
+            std::string label;
+
+            for (int i = 0; i < options.repetitions; ++i) {
+                const State state = RunOnce(benchmark, iterations);
+                realNs.push_back(state.GetRealSeconds() * 1e9 / iterations);
+                cpuNs.push_back(state.GetCpuSeconds() * 1e9 / iterations);
+                items += static_cast<double>(state.GetItemsProcessed());
+                bytes += static_cast<double>(state.GetBytesProcessed());
+                realSeconds += state.GetRealSeconds();
+                label = state.GetLabel();
+            }
+
+            const double minNs = *std::min_element(realNs.begin(), realNs.end());
+            std::sort(realNs.begin(), realNs.end());
+            std::sort(cpuNs.begin(), cpuNs.end());
+
+            Result result;
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.repetitions = options.repetitions;
+            result.realNs = realNs[realNs.size() / 2];
+            result.minNs = minNs;
+            result.cpuNs = cpuNs[cpuNs.size() / 2];
+            result.itemsPerSecond = realSeconds > 0.0 ? items / realSeconds : 0.0;
+            result.bytesPerSecond = realSeconds > 0.0 ? bytes / realSeconds : 0.0;
+            result.label = label;
+            return result;
+        }
+
+        std::string FormatRate(double perSecond, const char* unit) {
+            const char* prefixes[] = { "", "k", "M", "G", "T" };
+            int prefix = 0;
+            while (perSecond >= 1000.0 && prefix < 4) {
+                perSecond /= 1000.0;
+                prefix++;
+            }
+            char text[64];
+            std::snprintf(text, sizeof(text), "%.2f %s%s/s", perSecond, prefixes[prefix], unit);
+            return text;
+        }
+
+        void Print(const Result& result) {
+            std::string counters;
+            if (result.bytesPerSecond > 0.0) counters += " " + FormatRate(result.bytesPerSecond, "B");
+            if (result.itemsPerSecond > 0.0) counters += " " + FormatRate(result.itemsPerSecond, "items");
+            if (!result.label.empty()) counters += " " + result.label;
+
+            std::printf("%-44s %14.1f ns %14.1f ns %12lld%s\n", result.name.c_str(), result.realNs, result.cpuNs,
+                static_cast<long long>(result.iterations), counters.c_str());
+            std::fflush(stdout);
+        }
+
+        std::string Escape(const std::string& text) {
+            std::string out;
+            for (char c : text) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        // Same layout as Google Benchmark's JSON reporter, so its compare.py can diff two runs
+        bool WriteJson(const std::string& filename, const std::vector<Result>& results) {
+            std::ofstream file(filename, std::ios::binary);
+            if (!file) return false;
+
+            char date[32];
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            file << "{\n  \"context\": {\n";
+            file << "    \"date\": \"" << date << "\",\n";
+            file << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+            file << "    \"library_build_type\": \"release\",\n";
+#else
+            file << "    \"library_build_type\": \"debug\",\n";
+#endif
+            file << "    \"wx_version\": \"" << wxVERSION_NUM_DOT_STRING << "\"\n";
+            file << "  },\n  \"benchmarks\": [\n";
+
+            for (size_t i = 0; i < results.size(); ++i) {
+                const Result& result = results[i];
+                file << "    {\n";
+                file << "      \"name\": \"" << Escape(result.name) << "\",\n";
+                file << "      \"run_name\": \"" << Escape(result.name) << "\",\n";
+                file << "      \"run_type\": \"iteration\",\n";
+                file << "      \"repetitions\": " << result.repetitions << ",\n";
+                file << "      \"iterations\": " << result.iterations << ",\n";
+                file << "      \"real_time\": " << result.realNs << ",\n";
+                file << "      \"cpu_time\": " << result.cpuNs << ",\n";
+                file << "      \"min_real_time\": " << result.minNs << ",\n";
+                if (result.bytesPerSecond > 0.0) file << "      \"bytes_per_second\": " << result.bytesPerSecond << ",\n";
+                if (result.itemsPerSecond > 0.0) file << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+                if (!result.label.empty()) file << "      \"label\": \"" << Escape(result.label) << "\",\n";
+                file << "      \"time_unit\": \"ns\"\n";
+                file << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+            }
+
+            file << "  ]\n}\n";
+            return static_cast<bool>(file);
+        }
+
+        bool ParseOption(const char* argument, const char* name, std::string& value) {
+            const size_t length = std::strlen(name);
+            if (std::strncmp(argument, name, length) != 0 || argument[length] != '=') return false;
+            value = argument + length + 1;
+            return true;
+        }
+
+        bool ParseOptions(int argc, char** argv, Options& options) {
+            for (int i = 1; i < argc; ++i) {
+                std::string value;
+                if (ParseOption(argv[i], "--filter", value)) options.filter = value;
+                else if (ParseOption(argv[i], "--min-time", value)) options.minTime = std::max(0.001, std::atof(value.c_str()));
+                else if (ParseOption(argv[i], "--repetitions", value)) options.repetitions = std::max(1, std::atoi(value.c_str()));
+                else if (ParseOption(argv[i], "--json", value)) options.jsonFile = value;
+                else if (std::strcmp(argv[i], "--list") == 0) options.list = true;
+                else return false;
+            }
+            return true;
+        }
+
+    }
+
+    int Register(const char* name, Function function, std::vector<int64_t> args) {
+        if (args.empty()) {
+            GetBenchmarks().push_back({ name, function, 0 });
+        }
+        for (int64_t arg : args) {
+            GetBenchmarks().push_back({ std::string(name) + "/" + std::to_string(arg), function, arg });
+        }
+        return 0;
+    }
+
+}
+
+// Usage: bwx_bench [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>] [--json=<file>] [--list]
+int main(int argc, char** argv) {
+    using namespace bwx_bench;
+
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>] [--json=<file>] [--list]\n", argv[0]);
+        return 1;
+    }
+
+    std::regex filter;
+    try {
+        filter = std::regex(options.filter);
+    }
+    catch (const std::regex_error&) {
+        std::fprintf(stderr, "Invalid filter: %s\n", options.filter.c_str());
+        return 1;
+    }
+
+    std::vector<Benchmark*> selected;
+    for (Benchmark& benchmark : GetBenchmarks()) {
+        if (std::regex_search(benchmark.name, filter)) selected.push_back(&benchmark);
+    }
+
+    if (options.list) {
+        for (const Benchmark* benchmark : selected) std::printf("%s\n", benchmark->name.c_str());
+        return 0;
+    }
+
+    // Text layout needs the GUI toolkit; the command line is ours, so wxApp::OnInit() is not run
+    int wxArgc = 1;
+    wxApp::SetInstance(new wxApp());
+    if (!wxEntryStart(wxArgc, argv)) {
+        std::fprintf(stderr, "Cannot initialize wxWidgets\n");
+        return 1;
+    }
+    wxLog::EnableLogging(false);
+
+#ifndef NDEBUG
+    std::printf("***WARNING*** Debug build, timings are not representative\n");
+#endif
+    std::printf("%-44s %17s %17s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+    std::printf("%s\n", std::string(93, '-').c_str());
+
+    std::vector<Result> results;
+    for (const Benchmark* benchmark : selected) {
+        results.push_back(Run(*benchmark, options));
+        Print(results.back());
+    }
+
+    wxEntryCleanup();
+
+    if (!options.jsonFile.empty() && !WriteJson(options.jsonFile, results)) {
+        std::fprintf(stderr, "Cannot write %s\n", options.jsonFile.c_str());
+        return 1;
+    }
+
+    return 0;
+}
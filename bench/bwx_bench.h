@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_bench.h
+// Purpose:     BWX_SDK Library Benchmarks; Minimal micro-benchmark harness
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_BENCH_H_
+#define _BWX_BENCH_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+    Google Benchmark style, without the dependency:
+
+        void JSON_Parse(bwx_bench::State& state) {
+            const std::string text = MakeDocument(state.GetArg());   // setup, not timed
+            for (auto _ : state) {
+                bwxJSON json;
+                bwx_bench::DoNotOptimize(json.ParseFromUtf8(text));
+            }
+            state.SetBytesProcessed(state.GetIterations() * text.size());
+        }
+        BWX_BENCHMARK(JSON_Parse, 10, 1000);                          // JSON_Parse/10, JSON_Parse/1000
+
+    The runner picks the iteration count so one run takes --min-time, repeats the run and
+    reports the median; all inputs come from fixed seeds, so runs are comparable.
+*/
+
+namespace bwx_bench {
+
+    class State {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        State(int64_t iterations, int64_t arg) : m_iterations(iterations), m_arg(arg) {}
+
+        // Loop variable type; a user-provided destructor keeps an unused "_" from being warned about
+        struct Value {
+            ~Value() {}
+        };
+
+        class Iterator {
+        public:
+            Iterator(State* state, int64_t remaining) : m_state(state), m_remaining(remaining) {}
+
+            inline bool operator!=(const Iterator&) {
+                if (m_remaining != 0) return true;
+                if (m_state) m_state->Stop();
+                return false;
+            }
+            inline void operator++() { --m_remaining; }
+            inline Value operator*() const { return Value(); }
+
+        private:
+            State* m_state;
+            int64_t m_remaining;
+        };
+
+        inline Iterator begin() {
+            Start();
+            return Iterator(this, m_iterations);
+        }
+        inline Iterator end() { return Iterator(nullptr, 0); }
+
+        // Excludes work inside the loop (e.g. resetting the input) from the measurement
+        inline void PauseTiming() { m_pauseStart = Clock::now(); }
+        inline void ResumeTiming() { m_paused += Clock::now() - m_pauseStart; }
+
+        inline int64_t GetArg() const { return m_arg; }
+        inline int64_t GetIterations() const { return m_iterations; }
+
+        inline void SetItemsProcessed(int64_t items) { m_items = items; }
+        inline void SetBytesProcessed(int64_t bytes) { m_bytes = bytes; }
+        inline void SetLabel(const std::string& label) { m_label = label; }
+
+        inline double GetRealSeconds() const { return std::chrono::duration<double>(m_realTime - m_paused).count(); }
+        // Process CPU time; paused intervals are taken off as wall time
+        inline double GetCpuSeconds() const {
+            const double cpu = static_cast<double>(m_cpuTime) / CLOCKS_PER_SEC - std::chrono::duration<double>(m_paused).count();
+            return cpu > 0.0 ? cpu : 0.0;
+        }
+        inline int64_t GetItemsProcessed() const { return m_items; }
+        inline int64_t GetBytesProcessed() const { return m_bytes; }
+        inline const std::string& GetLabel() const { return m_label; }
+
+    private:
+        inline void Start() {
+            m_cpuStart = std::clock();
+            m_start = Clock::now();
+        }
+        inline void Stop() {
+            m_realTime = Clock::now() - m_start;
+            m_cpuTime = std::clock() - m_cpuStart;
+        }
+
+        int64_t m_iterations;
+        int64_t m_arg;
+        Clock::time_point m_start;
+        Clock::time_point m_pauseStart;
+        Clock::duration m_realTime{0};
+        Clock::duration m_paused{0};
+        std::clock_t m_cpuStart = 0;
+        std::clock_t m_cpuTime = 0;
+        int64_t m_items = 0;
+        int64_t m_bytes = 0;
+        std::string m_label;
+    };
+
+    using Function = std::function<void(State&)>;
+
+    // Registers name/arg for every argument (just name without arguments); returns a dummy for static init
+    int Register(const char* name, Function function, std::vector<int64_t> args = {});
+
+    // Keeps the compiler from dropping a computation whose result is unused
+    template <typename T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+}  // namespace bwx_bench
+
+#define BWX_BENCH_CONCAT_(a, b) a##b
+#define BWX_BENCH_CONCAT(a, b) BWX_BENCH_CONCAT_(a, b)
+
+#define BWX_BENCHMARK(function, ...) \
+    static const int BWX_BENCH_CONCAT(bwxBenchRegistered_, __LINE__) = ::bwx_bench::Register(#function, function, {__VA_ARGS__})
+
+#endif
@@ -422,6 +422,7 @@ MyFrame::MyFrame(wxWindow* parent, wxWindowID id, const wxString& title, const w
 	//-------------------------------------------
 	// SHADERS
 #if USE_SHADER_PROGRAM_MANAGER
+	bwx_sdk::bwxGLProgramBinaryCache::GetInstance().SetDirectory("shader_cache");
 	bwx_sdk::bwxGLShaderProgramManager::GetInstance().CreateShaderProgramFromStrings("solid", solid_vertex_src, solid_fragment_src);
 	bwx_sdk::bwxGLShaderProgramManager::GetInstance().CreateShaderProgramFromStrings("mesh", mesh_vertex_src, mesh_fragment_src);
 	active_shader_program = bwx_sdk::bwxGLShaderProgramManager::GetInstance().GetShaderProgramPtr("solid").get();
@@ -501,7 +502,7 @@ void MyFrame::InitScene() {
 	using namespace bwx_sdk;
 
 	// ---------- CAMERA ----------
-	auto cameraNode = std::make_shared<bwxGLNode>();
+	auto cameraNode = bwxGLNode::Create();
 	auto camTransform = cameraNode->AddComponent<bwxGLTransformComponent>();
 	auto camComponent = cameraNode->AddComponent<bwxGLCameraComponent>(bwxGL_CAMERA_TYPE::CAMERA_TYPE_SPECTATOR);
 	auto movement = cameraNode->AddComponent<bwxGLMovementComponent>();
@@ -510,7 +511,7 @@ void MyFrame::InitScene() {
 	camTransform->SetPosition(0.0f, 0.0f, 5.0f);
 
 	// ---------- LIGHT 1 (yellow) ----------
-	auto light1 = std::make_shared<bwxGLNode>();
+	auto light1 = bwxGLNode::Create();
 	auto light1Transform = light1->AddComponent<bwxGLTransformComponent>();
 	auto light1Comp = light1->AddComponent<bwxGLLightComponent>(bwxGL_LIGHT_TYPE::LIGHT_POINT);
 
@@ -520,7 +521,7 @@ void MyFrame::InitScene() {
 	light1Comp->SetRange(10.0f);
 
 	// ---------- LIGHT 2 (blue) ----------
-	auto light2 = std::make_shared<bwxGLNode>();
+	auto light2 = bwxGLNode::Create();
 	auto light2Transform = light2->AddComponent<bwxGLTransformComponent>();
 	auto light2Comp = light2->AddComponent<bwxGLLightComponent>(bwxGL_LIGHT_TYPE::LIGHT_POINT);
 
@@ -530,7 +531,7 @@ void MyFrame::InitScene() {
 	light2Comp->SetRange(10.0f);
 
 	// ---------- CUBE ----------
-	auto cubeNode = std::make_shared<bwxGLNode>();
+	auto cubeNode = bwxGLNode::Create();
 	auto cubeTransform = cubeNode->AddComponent<bwxGLTransformComponent>();
 	auto cubeRenderable = cubeNode->AddComponent<bwxGLRenderableComponent>();
 
@@ -546,7 +547,7 @@ void MyFrame::InitScene() {
 	auto& renderSystem = bwxGLRenderSystem::GetInstance();
 	//renderSystem.SetActiveCamera(cameraNode);
 	//renderSystem.SetLightSystem(std::make_shared<bwxGLLightSystem>(lightSystem));
-	//renderSystem.Register(cubeRenderable);
+	//renderSystem.RegisterRenderable(cubeRenderable);
 }
 
 
@@ -623,6 +624,10 @@ void MyFrame::OnFPS(wxCommandEvent& event)
 		m_fpsLimit = 60;
 	else if (event.GetId() == ID_FPS_120)
 		m_fpsLimit = 120;
+
+	// Deadline pacing, rounded to the refresh rate of the display showing the frame
+	fps.SetPacing(bwx_sdk::bwxGL_FRAME_PACING::FRAME_PACING_PRECISE);
+	fps.AlignToDisplay(this);
 }
 
 //---------------------------------------------------------------------------
@@ -704,10 +709,11 @@ void MyFrame::Render()
 	// RENDER TEXT
 	glm::mat4 ortho = glm::ortho(0.0f, (float)canvas->x, 0.0f, (float)canvas->y);
 
-	// Text with OpenGL coordinates... (from bottom-left corner)
-	textSmall->Render(bwx_sdk::str::bwxStringToWstring(fps.GetFPSStr()), ortho, glm::vec2(10, 42), 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	textSmall->Render(bwx_sdk::str::bwxStringToWstring(std::format("FPS Limit: {}", m_fpsLimit)), ortho, glm::vec2(10, 26), 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-	textSmall->Render(L"(c) 2025 by Bartosz Warzocha", ortho, glm::vec2(10, 10), 0.9f, glm::vec4(0.0f, 1.0f, 1.0f, 1.0f)); // Smaller scale looks better
+	// Text with OpenGL coordinates... (from bottom-left corner), queued and drawn with one call
+	textSmall->Queue(bwx_sdk::str::bwxStringToWstring(fps.GetFPSStr()), glm::vec2(10, 42), 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+	textSmall->Queue(bwx_sdk::str::bwxStringToWstring(std::format("FPS Limit: {} (jitter {:.2f} ms)", m_fpsLimit, fps.GetFrameTimeStdDev() * 1000.0f)), glm::vec2(10, 26), 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+	textSmall->Queue(L"(c) 2025 by Bartosz Warzocha", glm::vec2(10, 10), 0.9f, glm::vec4(0.0f, 1.0f, 1.0f, 1.0f)); // Smaller scale looks better
+	textSmall->Flush(ortho);
 	
 	// Text with window coordinates... (from top-left corner)
 	textLarge->Render(
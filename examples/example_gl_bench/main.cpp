@@ -0,0 +1,511 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        main.cpp
+// Purpose:     BWX_SDK Library Example; Offscreen render system benchmark (frame time percentiles)
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include <wx/glcanvas.h>
+
+#include <bwx_sdk/bwx_gl/bwx_gl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+using namespace bwx_sdk;
+
+namespace {
+
+    struct Options {
+        int meshes = 1000;
+        int lights = 8;
+        int texts = 20;
+        bool skybox = false;
+        int frames = 500;
+        int warmup = 50;
+        int width = 1280;
+        int height = 720;
+        bool indirect = true;
+        bool clustered = false;
+        bool prepass = false;
+        std::string jsonFile;
+    };
+
+    const char* USAGE =
+        "Usage: example_gl_bench [--meshes=<n>] [--lights=<n>] [--texts=<n>] [--skybox] [--frames=<n>] [--warmup=<n>]\n"
+        "                        [--width=<px>] [--height=<px>] [--no-indirect] [--clustered] [--prepass] [--json=<file>]\n";
+
+    bool ParseOption(const std::string& argument, const char* name, std::string& value) {
+        const size_t length = std::strlen(name);
+        if (argument.compare(0, length, name) != 0 || argument.size() <= length || argument[length] != '=') return false;
+        value = argument.substr(length + 1);
+        return true;
+    }
+
+    bool ParseOptions(const std::vector<std::string>& arguments, Options& options) {
+        for (const std::string& argument : arguments) {
+            std::string value;
+            if (ParseOption(argument, "--meshes", value)) options.meshes = std::max(0, std::atoi(value.c_str()));
+            else if (ParseOption(argument, "--lights", value)) options.lights = std::clamp(std::atoi(value.c_str()), 0, bwxGL_MAX_LIGHTS);
+            else if (ParseOption(argument, "--texts", value)) options.texts = std::max(0, std::atoi(value.c_str()));
+            else if (ParseOption(argument, "--frames", value)) options.frames = std::max(1, std::atoi(value.c_str()));
+            else if (ParseOption(argument, "--warmup", value)) options.warmup = std::max(0, std::atoi(value.c_str()));
+            else if (ParseOption(argument, "--width", value)) options.width = std::max(16, std::atoi(value.c_str()));
+            else if (ParseOption(argument, "--height", value)) options.height = std::max(16, std::atoi(value.c_str()));
+            else if (ParseOption(argument, "--json", value)) options.jsonFile = value;
+            else if (argument == "--skybox") options.skybox = true;
+            else if (argument == "--no-indirect") options.indirect = false;
+            else if (argument == "--clustered") options.clustered = true;
+            else if (argument == "--prepass") options.prepass = true;
+            else return false;
+        }
+        return true;
+    }
+
+    // Unit cube, 4 vertices per face so every face has its own normal
+    std::shared_ptr<bwxGLMesh> MakeCube() {
+        static const glm::vec3 normals[6] = {
+            { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+        };
+
+        std::vector<bwxGLVertex> vertices;
+        std::vector<GLuint> indices;
+        for (const glm::vec3& n : normals) {
+            const glm::vec3 u = std::abs(n.y) > 0.5f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+            const glm::vec3 v = glm::cross(n, u);
+            const GLuint base = static_cast<GLuint>(vertices.size());
+
+            const glm::vec2 corners[4] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+            for (const glm::vec2& c : corners) {
+                bwxGLVertex vertex = {};
+                vertex.position = 0.5f * (n + c.x * u + c.y * v);
+                vertex.normal = n;
+                vertex.texCoord = 0.5f * (c + glm::vec2(1.0f));
+                vertices.push_back(vertex);
+            }
+            // u x v == n, so the corners run counter-clockwise seen from outside
+            const GLuint quad[6] = { 0, 1, 2, 0, 2, 3 };
+            for (GLuint i : quad) indices.push_back(base + i);
+        }
+
+        auto mesh = std::make_shared<bwxGLMesh>(bwxGL_MESH_NORMAL | bwxGL_MESH_TEX_COORD | bwxGL_MESH_INDICES);
+        mesh->SetVertices(std::move(vertices));
+        mesh->SetIndices(std::move(indices));
+        mesh->SetupMesh();
+        return mesh;
+    }
+
+    std::shared_ptr<bwxGLShaderProgram> MakeProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+        bwxGLShader vertex, fragment;
+        if (!vertex.LoadShader(SHADER_VERTEX, vertexSource) || !fragment.LoadShader(SHADER_FRAGMENT, fragmentSource)) return nullptr;
+
+        auto program = std::make_shared<bwxGLShaderProgram>();
+        program->AttachShader(vertex);
+        program->AttachShader(fragment);
+        return program->Link() ? program : nullptr;
+    }
+
+    // Nearest rank; values must be sorted
+    double Percentile(const std::vector<double>& values, double percent) {
+        if (values.empty()) return -1.0;
+        const size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * values.size()));
+        return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+
+    struct Stats {
+        double p50, p95, p99, mean, max;
+    };
+
+    Stats Summarize(std::vector<double> values) {
+        if (values.empty()) return { -1.0, -1.0, -1.0, -1.0, -1.0 };
+
+        std::sort(values.begin(), values.end());
+        double sum = 0.0;
+        for (double value : values) sum += value;
+        return { Percentile(values, 50.0), Percentile(values, 95.0), Percentile(values, 99.0), sum / values.size(), values.back() };
+    }
+
+    void PrintStats(const char* name, const Stats& stats, const char* unit) {
+        if (stats.mean < 0.0) {
+            std::printf("  %-16s n/a\n", name);
+            return;
+        }
+        std::printf("  %-16s p50 %10.3f  p95 %10.3f  p99 %10.3f  mean %10.3f  max %10.3f %s\n", name,
+            stats.p50, stats.p95, stats.p99, stats.mean, stats.max, unit);
+    }
+
+    void WriteStats(std::ofstream& file, const char* name, const Stats& stats, bool last) {
+        file << "    \"" << name << "\": ";
+        if (stats.mean < 0.0) file << "null";
+        else file << "{ \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99
+            << ", \"mean\": " << stats.mean << ", \"max\": " << stats.max << " }";
+        file << (last ? "\n" : ",\n");
+    }
+
+}
+
+//---------------------------------------------------------------------------
+// Benchmark: a stress scene drawn into a framebuffer object; the window only
+// owns the GL context and is never swapped
+//---------------------------------------------------------------------------
+
+class BenchApp : public wxApp {
+public:
+    bool OnInit() override;
+    int OnRun() override;
+
+private:
+    void Run();
+    bool InitGL();
+    void BuildScene();
+    void RenderFrame(int frame);
+    void Report();
+    void Teardown();
+
+    Options m_options;
+    int m_exitCode = 0;
+
+    wxFrame* m_frame = nullptr;
+    wxGLCanvas* m_canvas = nullptr;
+    wxGLContext* m_context = nullptr;
+
+    GLuint m_framebuffer = 0;
+    GLuint m_colorBuffer = 0;
+    GLuint m_depthBuffer = 0;
+
+    std::vector<std::shared_ptr<bwxGLNode>> m_nodes;
+    std::vector<std::shared_ptr<bwxGLRenderableComponent>> m_renderables;
+    std::unique_ptr<bwxGLTTF> m_font;
+    std::unique_ptr<bwxGLText> m_text;
+    glm::mat4 m_ortho = glm::mat4(1.0f);
+
+    // Measured frames only, in frame order
+    std::vector<double> m_cpuMs;
+    std::vector<double> m_gpuMs;
+    std::vector<double> m_drawCalls;
+    std::vector<double> m_stateChanges;
+    std::vector<double> m_uploadedKB;
+};
+
+wxIMPLEMENT_APP_CONSOLE(BenchApp);
+
+bool BenchApp::OnInit() {
+    std::vector<std::string> arguments;
+    for (int i = 1; i < argc; ++i) arguments.push_back(argv[i].ToStdString());
+
+    if (!ParseOptions(arguments, m_options)) {
+        std::fprintf(stderr, "%s", USAGE);
+        return false;
+    }
+
+    wxGLAttributes attributes;
+    attributes.PlatformDefaults().RGBA().DoubleBuffer().Depth(24).EndList();
+    if (!wxGLCanvas::IsDisplaySupported(attributes)) {
+        std::fprintf(stderr, "Unsupported OpenGL configuration\n");
+        return false;
+    }
+
+    // The context needs a realized window on most platforms; it is small and never presented
+    m_frame = new wxFrame(nullptr, wxID_ANY, "bwx_sdk GL benchmark", wxDefaultPosition, wxSize(64, 64));
+    m_canvas = new wxGLCanvas(m_frame, attributes, wxID_ANY);
+
+    m_frame->Show();
+    CallAfter(&BenchApp::Run);
+    return true;
+}
+
+int BenchApp::OnRun() {
+    const int result = wxApp::OnRun();
+    return m_exitCode != 0 ? m_exitCode : result;
+}
+
+void BenchApp::Run() {
+    // Mapped asynchronously on some platforms
+    if (!m_canvas->IsShownOnScreen()) {
+        CallAfter(&BenchApp::Run);
+        return;
+    }
+
+    if (InitGL()) {
+        BuildScene();
+
+        auto& profiler = bwxGLProfiler::GetInstance();
+        profiler.SetEnabled(true);
+
+        // Reports lag a frame behind, so one extra frame resolves the last measured one
+        for (int frame = 0; frame < m_options.warmup + m_options.frames + 1; ++frame) {
+            RenderFrame(frame);
+        }
+
+        profiler.SetEnabled(false);
+        Report();
+        Teardown();
+    }
+    else {
+        wxDELETE(m_context);
+        m_exitCode = 1;
+    }
+
+    m_frame->Destroy();
+}
+
+bool BenchApp::InitGL() {
+    wxGLContextAttrs contextAttributes;
+    contextAttributes.PlatformDefaults().CoreProfile().OGLVersion(4, 5).EndList();
+
+    m_context = new wxGLContext(m_canvas, nullptr, &contextAttributes);
+    if (!m_context->IsOK() || !m_canvas->SetCurrent(*m_context)) {
+        std::fprintf(stderr, "Cannot create an OpenGL 4.5 core context\n");
+        return false;
+    }
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::fprintf(stderr, "Cannot initialize GLEW\n");
+        return false;
+    }
+
+    glGenRenderbuffers(1, &m_colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_options.width, m_options.height);
+
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_options.width, m_options.height);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::fprintf(stderr, "Offscreen framebuffer is incomplete\n");
+        return false;
+    }
+
+    glViewport(0, 0, m_options.width, m_options.height);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
+
+    std::printf("%s / %s / %s\n", reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+        reinterpret_cast<const char*>(glGetString(GL_RENDERER)), reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    return true;
+}
+
+void BenchApp::BuildScene() {
+    auto& renderSystem = bwxGLRenderSystem::GetInstance();
+    auto& lightSystem = bwxGLLightSystem::GetInstance();
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const bool indirect = m_options.indirect && bwxGLRenderSystem::IsMultiDrawIndirectSupported();
+    renderSystem.SetMultiDrawIndirect(indirect);
+    renderSystem.SetClusteredLighting(m_options.clustered);
+    renderSystem.SetDepthPrePass(m_options.prepass);
+
+    // Meshes: one shared cube on a grid, materials alternating so the queue has state to sort
+    const int side = std::max(1, static_cast<int>(std::ceil(std::cbrt(static_cast<double>(std::max(1, m_options.meshes))))));
+    const float spacing = 2.5f;
+    const float extent = side * spacing;
+
+    auto cube = MakeCube();
+    auto program = MakeProgram(bwxGLShaderGenerator::GetVertexShader(true, true, true, false, indirect),
+        bwxGLShaderGenerator::GetFragmentShader(false, true, m_options.clustered));
+    if (program) program->SetDepthPrePass(m_options.prepass);
+    else std::fprintf(stderr, "Scene shader failed to build, meshes are skipped\n");
+
+    std::vector<std::shared_ptr<bwxGLMaterial>> materials;
+    for (int i = 0; i < 8; ++i) {
+        auto material = std::make_shared<bwxGLMaterial>("bench_" + std::to_string(i));
+        material->SetDiffuse(glm::vec4(unit(random), unit(random), unit(random), 1.0f));
+        materials.push_back(material);
+    }
+
+    for (int i = 0; program && i < m_options.meshes; ++i) {
+        auto node = bwxGLNode::Create();
+        auto transform = node->AddComponent<bwxGLTransformComponent>();
+        auto renderable = node->AddComponent<bwxGLRenderableComponent>();
+
+        transform->SetPosition(glm::vec3(i % side, (i / side) % side, i / (side * side)) * spacing - glm::vec3(extent * 0.5f));
+        transform->SetRotation(unit(random) * 3.14f, unit(random) * 3.14f, 0.0f);
+        renderable->SetMesh(cube);
+        renderable->SetShaderProgram(program);
+        renderable->SetMaterial(materials[i % materials.size()]);
+
+        renderSystem.RegisterRenderable(renderable);
+        m_renderables.push_back(renderable);
+        m_nodes.push_back(node);
+    }
+
+    // Lights scattered through the grid
+    for (int i = 0; i < m_options.lights; ++i) {
+        auto node = bwxGLNode::Create();
+        auto transform = node->AddComponent<bwxGLTransformComponent>();
+        auto light = node->AddComponent<bwxGLLightComponent>(bwxGL_LIGHT_TYPE::LIGHT_POINT);
+
+        transform->SetPosition(glm::vec3(unit(random), unit(random), unit(random)) * extent - glm::vec3(extent * 0.5f));
+        light->SetLightColor(glm::vec3(0.5f) + 0.5f * glm::vec3(unit(random), unit(random), unit(random)));
+        light->SetPower(1.0f);
+        light->SetRange(spacing * 4.0f);
+
+        lightSystem.Register(node);
+        m_nodes.push_back(node);
+    }
+    // The light system is a singleton; the render system only borrows it
+    renderSystem.SetLightSystem(std::shared_ptr<bwxGLLightSystem>(&lightSystem, [](bwxGLLightSystem*) {}));
+
+    // Camera in front of the grid, the whole grid in view
+    auto cameraNode = bwxGLNode::Create();
+    auto cameraTransform = cameraNode->AddComponent<bwxGLTransformComponent>();
+    auto camera = cameraNode->AddComponent<bwxGLCameraComponent>(bwxGL_CAMERA_TYPE::CAMERA_TYPE_SPECTATOR);
+    cameraTransform->SetPosition(0.0f, 0.0f, extent * 1.5f);
+    camera->SetProjectionPerspective(60.0f, static_cast<float>(m_options.width) / m_options.height, 0.1f, extent * 4.0f + 1000.0f);
+    camera->Update(0.0f);
+    renderSystem.SetActiveCamera(camera);
+    m_nodes.push_back(cameraNode);
+
+    if (m_options.skybox) {
+        auto skyBox = std::make_shared<bwxGLSkyBox>(500, std::vector<std::string>(6, "./assets/images/texture.png"));
+        skyBox->UseDefaultSkyBoxShader();
+        renderSystem.SetSkyBox(skyBox);
+    }
+
+    if (m_options.texts > 0) {
+        m_font = std::make_unique<bwxGLTTF>();
+        if (m_font->LoadFromFile("./assets/fonts/Ubuntu-R.ttf", 14)) m_text = std::make_unique<bwxGLText>(*m_font);
+        else std::fprintf(stderr, "Cannot load ./assets/fonts/Ubuntu-R.ttf, text is skipped\n");
+    }
+    m_ortho = glm::ortho(0.0f, static_cast<float>(m_options.width), 0.0f, static_cast<float>(m_options.height));
+
+    std::printf("Scene: %d meshes, %d lights, %d text lines, skybox %s; %dx%d offscreen; indirect %s, clustered %s, pre-pass %s\n",
+        static_cast<int>(m_renderables.size()), m_options.lights, m_text ? m_options.texts : 0, m_options.skybox ? "on" : "off",
+        m_options.width, m_options.height, indirect ? "on" : "off", m_options.clustered ? "on" : "off", m_options.prepass ? "on" : "off");
+}
+
+void BenchApp::RenderFrame(int frame) {
+    auto& profiler = bwxGLProfiler::GetInstance();
+    const int measured = frame - m_options.warmup;
+    const bool last = measured >= m_options.frames;
+
+    profiler.BeginFrame();
+
+    // BeginFrame() resolved the previous frame; glFinish() below keeps the report exactly one frame behind
+    const bwxGLProfileReport& report = profiler.GetReport();
+    if (measured > 0 && !report.entries.empty()) {
+        m_cpuMs.push_back(report.GetCPUFrameTime());
+        if (report.GetGPUFrameTime() >= 0.0) m_gpuMs.push_back(report.GetGPUFrameTime());
+        m_drawCalls.push_back(static_cast<double>(report.counters.drawCalls));
+        m_stateChanges.push_back(static_cast<double>(report.counters.stateChanges));
+        m_uploadedKB.push_back(static_cast<double>(report.counters.uploadedBytes) / 1024.0);
+    }
+
+    if (!last) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        bwxGLRenderSystem::GetInstance().RenderAll();
+
+        if (m_text) {
+            bwxGL_PROFILE_SCOPE("Text");
+            const float lineHeight = 18.0f;
+            const int rows = std::max(1, static_cast<int>((m_options.height - 20) / lineHeight));
+            for (int i = 0; i < m_options.texts; ++i) {
+                const glm::vec2 pos(10.0f + (i / rows) * 220.0f, m_options.height - 20.0f - (i % rows) * lineHeight);
+                m_text->Queue(L"Line " + std::to_wstring(i) + L", frame " + std::to_wstring(frame), pos, 1.0f, glm::vec4(1.0f));
+            }
+            m_text->Flush(m_ortho);
+        }
+    }
+
+    profiler.EndFrame();
+
+    // Nothing is presented, so without this the driver would queue frames without bound
+    glFinish();
+}
+
+void BenchApp::Report() {
+    const Stats cpu = Summarize(m_cpuMs);
+    const Stats gpu = Summarize(m_gpuMs);
+    const Stats drawCalls = Summarize(m_drawCalls);
+    const Stats stateChanges = Summarize(m_stateChanges);
+    const Stats uploaded = Summarize(m_uploadedKB);
+
+#ifndef NDEBUG
+    std::printf("***WARNING*** Debug build, timings are not representative\n");
+#endif
+    std::printf("\n%d frames (%d warm-up), %d measured\n", m_options.frames, m_options.warmup, static_cast<int>(m_cpuMs.size()));
+    PrintStats("CPU frame", cpu, "ms");
+    PrintStats("GPU frame", gpu, bwxGLProfiler::IsGPUTimingSupported() ? "ms" : "ms (no ARB_timer_query)");
+    PrintStats("draw calls", drawCalls, "");
+    PrintStats("state changes", stateChanges, "");
+    PrintStats("uploaded", uploaded, "KB");
+    std::printf("  submitted %zu, culled %zu\n", bwxGLRenderSystem::GetInstance().GetSubmittedCount(),
+        bwxGLRenderSystem::GetInstance().GetCulledCount());
+
+    if (m_options.jsonFile.empty()) return;
+
+    std::ofstream file(m_options.jsonFile, std::ios::binary);
+    file << "{\n  \"scene\": {\n";
+    file << "    \"meshes\": " << m_renderables.size() << ",\n";
+    file << "    \"lights\": " << m_options.lights << ",\n";
+    file << "    \"texts\": " << (m_text ? m_options.texts : 0) << ",\n";
+    file << "    \"skybox\": " << (m_options.skybox ? "true" : "false") << ",\n";
+    file << "    \"width\": " << m_options.width << ",\n";
+    file << "    \"height\": " << m_options.height << ",\n";
+    file << "    \"indirect\": " << (bwxGLRenderSystem::GetInstance().IsMultiDrawIndirect() ? "true" : "false") << ",\n";
+    file << "    \"clustered\": " << (m_options.clustered ? "true" : "false") << ",\n";
+    file << "    \"prepass\": " << (m_options.prepass ? "true" : "false") << "\n";
+    file << "  },\n  \"frames\": " << m_cpuMs.size() << ",\n  \"results\": {\n";
+    WriteStats(file, "cpu_frame_ms", cpu, false);
+    WriteStats(file, "gpu_frame_ms", gpu, false);
+    WriteStats(file, "draw_calls", drawCalls, false);
+    WriteStats(file, "state_changes", stateChanges, false);
+    WriteStats(file, "uploaded_kb", uploaded, true);
+    file << "  }\n}\n";
+
+    if (!file) {
+        std::fprintf(stderr, "Cannot write %s\n", m_options.jsonFile.c_str());
+        m_exitCode = 1;
+    }
+}
+
+void BenchApp::Teardown() {
+    // GL objects go while the context is still current
+    auto& renderSystem = bwxGLRenderSystem::GetInstance();
+    for (const auto& renderable : m_renderables) renderSystem.UnregisterRenderable(renderable);
+    renderSystem.SetSkyBox(nullptr);
+    renderSystem.SetActiveCamera(nullptr);
+    renderSystem.SetLightSystem(nullptr);
+    bwxGLLightSystem::GetInstance().Clear();
+
+    m_renderables.clear();
+    m_nodes.clear();
+    m_text.reset();
+    m_font.reset();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_colorBuffer);
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+
+    wxDELETE(m_context);
+}
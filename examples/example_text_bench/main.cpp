@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        main.cpp
+// Purpose:     BWX_SDK Library Example; ITextStorage benchmark (Gap Buffer vs Piece Table)
+// Author:      Bartosz Warzocha
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+    #include <wx/wx.h>
+#endif
+
+#include <bwx_sdk/bwx_gui/bwx_text_document.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+
+using namespace bwx_sdk::gui;
+
+namespace {
+
+    // Builds a manuscript-like text: words of 2-10 letters, a paragraph every ~80 words
+    wxString MakeDocument(int words) {
+        std::mt19937 random(42);
+        wxString text;
+        text.Alloc(words * 7);
+
+        for (int i = 0; i < words; ++i) {
+            const int length = 2 + static_cast<int>(random() % 9);
+            for (int c = 0; c < length; ++c)
+                text.Append(static_cast<wxChar>('a' + random() % 26));
+            text.Append(random() % 80 == 0 ? wxChar('\n') : wxChar(' '));
+        }
+
+        return text;
+    }
+
+    double Measure(const std::function<void()>& work) {
+        const auto start = std::chrono::steady_clock::now();
+        work();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Run(const char* name, TextStorageType type, const wxString& document, int edits) {
+        std::unique_ptr<ITextStorage> storage = CreateTextStorage(type);
+        std::mt19937 random(7);
+        size_t checksum = 0;
+
+        std::printf("%s\n", name);
+
+        std::printf("  load                  %10.2f ms\n", Measure([&] {
+            storage->SetText(document);
+        }));
+
+        std::printf("  type at cursor x%-6d %10.2f ms\n", edits * 10, Measure([&] {
+            int pos = storage->GetLength() / 2;
+            for (int i = 0; i < edits * 10; ++i)
+                storage->InsertText(pos++, "x");
+        }));
+
+        std::printf("  random insert x%-6d  %10.2f ms\n", edits, Measure([&] {
+            for (int i = 0; i < edits; ++i)
+                storage->InsertText(static_cast<int>(random() % (storage->GetLength() + 1)), "word ");
+        }));
+
+        std::printf("  random delete x%-6d  %10.2f ms\n", edits, Measure([&] {
+            for (int i = 0; i < edits; ++i) {
+                const int pos = static_cast<int>(random() % (storage->GetLength() - 16));
+                storage->DeleteText(pos, pos + 1 + static_cast<int>(random() % 16));
+            }
+        }));
+
+        std::printf("  random char x%-8d  %10.2f ms\n", edits * 100, Measure([&] {
+            for (int i = 0; i < edits * 100; ++i)
+                checksum += storage->GetChar(static_cast<int>(random() % storage->GetLength()));
+        }));
+
+        std::printf("  4k range x%-11d  %10.2f ms\n", edits, Measure([&] {
+            for (int i = 0; i < edits; ++i) {
+                const int pos = static_cast<int>(random() % (storage->GetLength() - 4096));
+                checksum += storage->GetText(pos, pos + 4096).Length();
+            }
+        }));
+
+        std::printf("  full text x10         %10.2f ms\n", Measure([&] {
+            for (int i = 0; i < 10; ++i)
+                checksum += storage->GetText().Length();
+        }));
+
+        std::printf("  (checksum %zu)\n\n", checksum);
+    }
+
+}
+
+// Usage: example_text_bench [words] [edits]
+int main(int argc, char** argv) {
+    const int words = argc > 1 ? std::max(1000, std::atoi(argv[1])) : 500000;
+    const int edits = argc > 2 ? std::max(1, std::atoi(argv[2])) : 2000;
+
+    const wxString document = MakeDocument(words);
+    std::printf("Document: %d words, %d characters\n\n", words, static_cast<int>(document.Length()));
+
+    Run("Gap Buffer", TextStorageType::GapBuffer, document, edits);
+    Run("Piece Table", TextStorageType::PieceTable, document, edits);
+
+    return 0;
+}
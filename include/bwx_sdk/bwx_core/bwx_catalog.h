@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_catalog.h
+// Purpose:     BWX_SDK Library; Memory-mapped, pre-indexed translation catalog
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_CATALOG_H_
+#define _BWX_CATALOG_H_
+
+#include <wx/string.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Read-only translation catalog compiled by scripts/compile_catalogs.py (.bwxcat).
+ *
+ * The file is memory-mapped; a minimal perfect hash (hash and displace) gives the only
+ * candidate entry of a message, so a lookup hashes the msgid once, compares one key and
+ * returns a UTF-8 view into the mapping - no allocation, no locking. Views stay valid
+ * while the catalog exists.
+ */
+class bwxCatalog {
+public:
+    static std::shared_ptr<const bwxCatalog> Load(const wxString& filename, wxString* error = nullptr);
+
+    ~bwxCatalog();
+
+    bwxCatalog(const bwxCatalog&) = delete;
+    bwxCatalog& operator=(const bwxCatalog&) = delete;
+
+    // Empty view if the message has no translation
+    std::string_view Find(std::string_view msgid) const;
+    std::string_view Find(std::string_view context, std::string_view msgid) const;  ///< msgctxt entry
+    std::string_view FindPlural(std::string_view msgid, size_t form) const;         ///< msgstr[form]
+
+    // Translation or the msgid itself
+    inline std::string_view Translate(std::string_view msgid) const {
+        std::string_view translation = Find(msgid);
+        return translation.empty() ? msgid : translation;
+    }
+
+    inline size_t GetCount() const { return m_count; }
+
+private:
+    struct File;
+
+    struct Entry {
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        uint32_t valueOffset;
+        uint32_t valueLength;
+    };
+
+    bwxCatalog();
+
+    const Entry* FindEntry(std::string_view context, std::string_view msgid) const;
+
+    std::unique_ptr<File> m_file;
+    const uint32_t* m_displacements = nullptr;
+    const Entry* m_entries = nullptr;
+    const char* m_strings = nullptr;
+    uint32_t m_count = 0;
+    uint32_t m_bucketCount = 0;
+    uint32_t m_seed = 0;
+};
+
+}  // namespace bwx_sdk
+
+#endif
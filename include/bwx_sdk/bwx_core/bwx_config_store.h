@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_config_store.h
+// Purpose:     BWX_SDK Library; Typed config store with lazy load and background write-back
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_CONFIG_STORE_H_
+#define _BWX_CONFIG_STORE_H_
+
+#include <wx/debug.h>
+#include <wx/string.h>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <bwx_sdk/bwx_core/bwx_config_utils.h>
+
+class wxFileConfig;
+
+namespace bwx_sdk {
+
+/**
+ * @brief Typed handle of a bwxConfigStore entry - a stable index into the entry array.
+ */
+template <typename T>
+class bwxConfigKey {
+public:
+    bwxConfigKey() = default;
+
+    inline bool IsOk() const { return m_id != INVALID_ID; }
+
+private:
+    friend class bwxConfigStore;
+
+    static constexpr uint32_t INVALID_ID = UINT32_MAX;
+
+    explicit bwxConfigKey(uint32_t id) : m_id(id) {}
+
+    uint32_t m_id = INVALID_ID;
+};
+
+/**
+ * @brief Config entries registered to typed keys.
+ *
+ * Reading a number or a flag is an atomic load from the entry slot (lock-free, no lookup, no
+ * wxAny), so settings can be read every frame. The file is opened and an entry read on its first
+ * access. Set() marks the entry dirty; a background thread writes the dirty entries when no change
+ * came for the write delay (debounce) and flushes the file through wxFileConfig, which replaces it
+ * atomically (temporary file + rename). Remaining changes are written by Flush() and the destructor.
+ *
+ * Register keys before the store is used from other threads; Get() and Set() are thread-safe.
+ * The file is re-read before every write, so values saved meanwhile by bwxConfigUtils::SaveConfig()
+ * are kept. Invalid keys (a failed Add) assert and read as the type's zero value.
+ */
+class bwxConfigStore {
+public:
+    static bwxConfigStore& GetInstance();
+
+    explicit bwxConfigStore(const wxString& filename = wxEmptyString);  ///< Empty = file of bwxSetFileConf()
+    ~bwxConfigStore();
+
+    bwxConfigStore(const bwxConfigStore&) = delete;
+    bwxConfigStore& operator=(const bwxConfigStore&) = delete;
+
+    // Registering a path again returns its key (invalid key if the type differs)
+    bwxConfigKey<wxString> AddString(const wxString& path, const wxString& defaultValue);
+    bwxConfigKey<int> AddInt(const wxString& path, int defaultValue);
+    bwxConfigKey<float> AddFloat(const wxString& path, float defaultValue);
+    bwxConfigKey<double> AddDouble(const wxString& path, double defaultValue);
+    bwxConfigKey<bool> AddBool(const wxString& path, bool defaultValue);
+
+    inline int Get(bwxConfigKey<int> key) { return static_cast<int>(static_cast<int64_t>(Load(key.m_id))); }
+    inline float Get(bwxConfigKey<float> key) { return static_cast<float>(std::bit_cast<double>(Load(key.m_id))); }
+    inline double Get(bwxConfigKey<double> key) { return std::bit_cast<double>(Load(key.m_id)); }
+    inline bool Get(bwxConfigKey<bool> key) { return Load(key.m_id) != 0; }
+    wxString Get(bwxConfigKey<wxString> key);
+
+    inline void Set(bwxConfigKey<int> key, int value) { Store(key.m_id, static_cast<uint64_t>(static_cast<int64_t>(value))); }
+    inline void Set(bwxConfigKey<float> key, float value) { Store(key.m_id, std::bit_cast<uint64_t>(static_cast<double>(value))); }
+    inline void Set(bwxConfigKey<double> key, double value) { Store(key.m_id, std::bit_cast<uint64_t>(value)); }
+    inline void Set(bwxConfigKey<bool> key, bool value) { Store(key.m_id, value ? 1 : 0); }
+    void Set(bwxConfigKey<wxString> key, const wxString& value);
+
+    // Write-back after delay without changes, but not later than maxDelay after the first one
+    void SetWriteDelay(std::chrono::milliseconds delay, std::chrono::milliseconds maxDelay);
+
+    bool Flush();  ///< Writes dirty entries now; false if the file cannot be written
+
+    inline size_t GetEntryCount() const { return m_slots.size(); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> bits{0};  ///< Value of a number or flag entry
+        std::atomic<bool> loaded{false};
+        std::atomic<bool> dirty{false};
+        bwxConfigEntryType type = CONFIG_ENTRY_TYPE_STRING;
+        wxString path;
+        uint64_t defaultBits = 0;
+        wxString defaultString;
+        wxString string;                ///< Value of a string entry (m_stringMutex)
+    };
+
+    inline uint64_t Load(uint32_t id) {
+        wxCHECK_MSG(id < m_slots.size(), 0, "Invalid bwxConfigStore key");
+        Slot& slot = m_slots[id];
+        if (!slot.loaded.load(std::memory_order_acquire))
+            LoadSlot(slot);
+        return slot.bits.load(std::memory_order_relaxed);
+    }
+
+    void Store(uint32_t id, uint64_t bits);
+
+    uint32_t Add(const wxString& path, bwxConfigEntryType type, uint64_t defaultBits, const wxString& defaultString);
+    void LoadSlot(Slot& slot);
+    void MarkDirty(Slot& slot);
+    void OpenConfig();
+    void WriterLoop();
+
+    wxString m_filename;
+    std::deque<Slot> m_slots;  ///< Stable addresses, indexed by key ID
+    std::map<wxString, uint32_t> m_ids;
+
+    std::mutex m_fileMutex;  ///< wxFileConfig access and growing m_slots
+    std::unique_ptr<wxFileConfig> m_config;
+    std::mutex m_stringMutex;
+
+    std::mutex m_writeMutex;
+    std::condition_variable m_writeWake;
+    std::thread m_writer;  ///< Started by the first change
+    bool m_running = true;
+    bool m_writePending = false;
+    std::chrono::steady_clock::time_point m_firstChange;
+    std::chrono::steady_clock::time_point m_lastChange;
+    std::chrono::milliseconds m_delay{500};
+    std::chrono::milliseconds m_maxDelay{5000};
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -57,6 +57,7 @@ public:
 class bwxConfigUtils {
 private:
     static bwxPropertyMap<wxString, bwxConfigEntry> m_configEntries;
+    static bool m_logOnLoad;
 
 public:
     static void LoadConfig();
@@ -88,6 +89,10 @@ public:
     static bool Get(const wxString& key, wxColour* c);
 
     static void ShowInLog();
+
+    // ShowInLog() at the end of every LoadConfig(); off by default, as it costs one log line per entry at startup
+    static void SetLogOnLoad(bool log) { m_logOnLoad = log; }
+    static bool IsLogOnLoad() { return m_logOnLoad; }
 };
 
 }  // namespace bwx_sdk
@@ -18,6 +18,11 @@
 
 #include "bwx_sdk/bwx_globals.h"
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace bwx_sdk {
 namespace dt {
 
@@ -79,6 +84,71 @@ wxString bwxFormatDateTime(const wxDateTime& dt, const wxString& format = wxT("$
 
 std::string bwxToISO8601(wxDateTime date);
 
+/**
+ * @brief Format of bwxFormatDateTime() parsed once, for formatting many dates.
+ *
+ * Digits are written straight into the output; only the textual fields (names, zodiac,
+ * "A.D.", "y.", AM/PM hours) go through translations. Output is UTF-8.
+ */
+class bwxDateTimeFormat {
+public:
+    explicit bwxDateTimeFormat(const wxString& format = wxT("$YY-$M-$D $h:$m:$s"));
+
+    // Writes up to size chars (no terminating zero); returns the length of the whole text
+    size_t FormatTo(const wxDateTime& dt, char* buffer, size_t size) const;
+    void FormatTo(const wxDateTime& dt, std::string& out) const;  ///< Appends to out
+    wxString Format(const wxDateTime& dt) const;
+
+    inline const wxString& GetFormat() const { return m_format; }
+
+private:
+    enum Field : uint8_t {
+        FIELD_TEXT,
+        FIELD_YEAR_AD,          ///< $YYYY
+        FIELD_YEAR_SUFFIX,      ///< $YYY
+        FIELD_YEAR,             ///< $YY
+        FIELD_YEAR_SHORT,       ///< $Y
+        FIELD_MONTH_NAME,       ///< $MMMM
+        FIELD_MONTH_GENITIVE,   ///< $MMM
+        FIELD_MONTH_SHORT,      ///< $MM
+        FIELD_MONTH,            ///< $M
+        FIELD_DAY_OF_YEAR,      ///< $DD
+        FIELD_DAY,              ///< $D
+        FIELD_WEEK_OF_YEAR,     ///< $W
+        FIELD_WEEK_OF_MONTH,    ///< $w
+        FIELD_WEEK_DAY_NAME,    ///< $dd
+        FIELD_WEEK_DAY_SHORT,   ///< $d
+        FIELD_HOUR_12_AM_PM,    ///< $hhh
+        FIELD_HOUR_12,          ///< $hh
+        FIELD_HOUR,             ///< $h
+        FIELD_MINUTE,           ///< $m
+        FIELD_MILLISECOND,      ///< $ss
+        FIELD_SECOND,           ///< $s
+        FIELD_ZODIAC            ///< $Z, $z
+    };
+
+    struct Token {
+        Field field;
+        uint32_t offset;  ///< FIELD_TEXT: UTF-8 text in m_text
+        uint32_t length;
+    };
+
+    template <typename Sink>
+    void Write(const wxDateTime& dt, Sink& sink) const;
+
+    wxString m_format;
+    std::vector<Token> m_tokens;
+    std::string m_text;
+};
+
+constexpr size_t BWX_ISO8601_MAX_LENGTH = 32;
+
+// "YYYY-MM-DDTHH:MM:SS[.mmm]" into a buffer of BWX_ISO8601_MAX_LENGTH chars; returns the length (0 = invalid date)
+size_t bwxFormatISO8601(const wxDateTime& date, char* buffer, bool milliseconds = false);
+
+// "YYYY-MM-DD[(T| )HH:MM[:SS[.fraction]]][Z|(+|-)HH[:MM]]"; a date with a zone is converted to local time
+bool bwxParseISO8601(std::string_view text, wxDateTime& date);
+
 int bwxCalculateAge(wxDateTime birthDate, wxDateTime currentDate = wxDateTime::Today());
 
 bool bwxIsValidDate(int d, int m, int y);
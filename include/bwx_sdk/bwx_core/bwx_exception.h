@@ -15,9 +15,32 @@
 namespace bwx {
 namespace core {
 
+/// @brief Severity level for exception handling decisions
+enum class ExceptionSeverity {
+    Info,      ///< Informational, always continue
+    Warning,   ///< Warning, continue by default
+    Error,     ///< Error, continue with user confirmation
+    Critical   ///< Critical, abort by default
+};
+
+/// @brief Kind of bwx exception (one per exception class)
+enum class ExceptionCategory {
+    Generic,   ///< BwxException itself
+    Layout,    ///< LayoutException
+    Widget,    ///< WidgetException
+    Window,    ///< WindowException
+    Resource   ///< ResourceException
+};
+
+/// @brief Get display name of category ("Layout", ..., "Application" for Generic)
+const char* getCategoryName(ExceptionCategory category) noexcept;
+
 /// @brief Base exception class for all bwx_sdk exceptions
 /// @details Derives from std::runtime_error for compatibility with standard C++ exception handling.
 ///          All bwx exceptions should derive from this class.
+///          Throwing only stores the message and source location; the full text
+///          (category prefix, message, "at file:line") is built by the first what() call,
+///          so exceptions caught and dropped never pay for formatting.
 class BwxException : public std::runtime_error {
 public:
     /// @brief Construct exception with message
@@ -28,16 +51,39 @@ public:
 
     /// @brief Construct exception with message and source location
     /// @param message Human-readable error description
-    /// @param file Source file where exception occurred
+    /// @param file Source file where exception occurred (string literal, e.g. __FILE__)
     /// @param line Line number where exception occurred
     BwxException(const std::string& message, const char* file, int line)
-        : std::runtime_error(formatMessage(message, file, line))
+        : std::runtime_error(message)
+        , m_file(file)
+        , m_line(line)
     {}
 
     virtual ~BwxException() = default;
 
+    /// @brief Get full message, e.g. "Layout Error: message (at file:line)"
+    /// @note Formatted on first call - do not make the first call from two threads at once.
+    const char* what() const noexcept override;
+
+    /// @brief Get message as given to the constructor
+    const char* getMessage() const noexcept { return std::runtime_error::what(); }
+
+    /// @brief Get source file (nullptr if not given)
+    const char* getFile() const noexcept { return m_file; }
+
+    /// @brief Get source line (0 if not given)
+    int getLine() const noexcept { return m_line; }
+
+    /// @brief Get category - classification is one virtual call, no dynamic_cast chain
+    virtual ExceptionCategory getCategory() const noexcept { return ExceptionCategory::Generic; }
+
+    /// @brief Get default severity for handling decisions
+    virtual ExceptionSeverity getSeverity() const noexcept { return ExceptionSeverity::Error; }
+
 private:
-    static std::string formatMessage(const std::string& message, const char* file, int line);
+    const char* m_file = nullptr;  ///< Source file (static storage)
+    int m_line = 0;                ///< Source line
+    mutable std::string m_what;    ///< Full message (empty until first what())
 };
 
 /// @brief Exception for layout-related operations (FitInside, Layout, sizers)
@@ -47,13 +93,10 @@ private:
 ///          - Invalid layout configurations
 class LayoutException : public BwxException {
 public:
-    explicit LayoutException(const std::string& message)
-        : BwxException("Layout Error: " + message)
-    {}
+    using BwxException::BwxException;
 
-    LayoutException(const std::string& message, const char* file, int line)
-        : BwxException("Layout Error: " + message, file, line)
-    {}
+    ExceptionCategory getCategory() const noexcept override { return ExceptionCategory::Layout; }
+    ExceptionSeverity getSeverity() const noexcept override { return ExceptionSeverity::Warning; }
 };
 
 /// @brief Exception for widget/control operations
@@ -63,13 +106,10 @@ public:
 ///          - Control value errors
 class WidgetException : public BwxException {
 public:
-    explicit WidgetException(const std::string& message)
-        : BwxException("Widget Error: " + message)
-    {}
+    using BwxException::BwxException;
 
-    WidgetException(const std::string& message, const char* file, int line)
-        : BwxException("Widget Error: " + message, file, line)
-    {}
+    ExceptionCategory getCategory() const noexcept override { return ExceptionCategory::Widget; }
+    ExceptionSeverity getSeverity() const noexcept override { return ExceptionSeverity::Warning; }
 };
 
 /// @brief Exception for window/dialog operations
@@ -79,13 +119,10 @@ public:
 ///          - Window hierarchy issues
 class WindowException : public BwxException {
 public:
-    explicit WindowException(const std::string& message)
-        : BwxException("Window Error: " + message)
-    {}
+    using BwxException::BwxException;
 
-    WindowException(const std::string& message, const char* file, int line)
-        : BwxException("Window Error: " + message, file, line)
-    {}
+    ExceptionCategory getCategory() const noexcept override { return ExceptionCategory::Window; }
+    ExceptionSeverity getSeverity() const noexcept override { return ExceptionSeverity::Error; }
 };
 
 /// @brief Exception for resource operations (icons, bitmaps, fonts)
@@ -95,13 +132,10 @@ public:
 ///          - Font initialization issues
 class ResourceException : public BwxException {
 public:
-    explicit ResourceException(const std::string& message)
-        : BwxException("Resource Error: " + message)
-    {}
+    using BwxException::BwxException;
 
-    ResourceException(const std::string& message, const char* file, int line)
-        : BwxException("Resource Error: " + message, file, line)
-    {}
+    ExceptionCategory getCategory() const noexcept override { return ExceptionCategory::Resource; }
+    ExceptionSeverity getSeverity() const noexcept override { return ExceptionSeverity::Warning; }
 };
 
 /// @brief Convenience macro for throwing exceptions with source location
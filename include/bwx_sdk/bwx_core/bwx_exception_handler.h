@@ -10,17 +10,11 @@
 #include <string>
 #include <functional>
 
+#include "bwx_exception.h"
+
 namespace bwx {
 namespace core {
 
-/// @brief Severity level for exception handling decisions
-enum class ExceptionSeverity {
-    Info,      ///< Informational, always continue
-    Warning,   ///< Warning, continue by default
-    Error,     ///< Error, continue with user confirmation
-    Critical   ///< Critical, abort by default
-};
-
 /// @brief Callback function type for custom exception logging
 /// @param severity Exception severity level
 /// @param message Formatted exception message
@@ -32,6 +26,8 @@ using ExceptionLogCallback = std::function<void(ExceptionSeverity severity,
 /// @brief Exception handling utilities
 /// @details Static utility class for processing exceptions caught in wxApp::OnExceptionInMainLoop().
 ///          Provides formatting, logging, and decision-making helpers.
+///          bwx exceptions are classified by BwxException::getCategory()/getSeverity()
+///          (one cast to BwxException, then virtual calls).
 class ExceptionHandler {
 public:
     /// @brief Format exception message for display
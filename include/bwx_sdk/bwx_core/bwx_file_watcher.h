@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_file_watcher.h
+// Purpose:     BWX_SDK Library; Event-driven file change notifications
+// Author:      Bartosz Warzocha
+// Created:     2026-10-14
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_FILE_WATCHER_H_
+#define _BWX_FILE_WATCHER_H_
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <wx/fswatcher.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Queues changed files reported by wxFileSystemWatcher (inotify, ReadDirectoryChangesW, kqueue).
+ *
+ * Watch() registers a callback for one file; the file's directory is watched once for all its
+ * files. Notifications only mark the file as changed - callbacks run in Dispatch(), which the
+ * application calls at a safe point of its frame (on the GL thread for GL resources). Several
+ * notifications of one save collapse into a single callback.
+ *
+ * wxFileSystemWatcher needs a running event loop, so Watch() fails before the application's
+ * main loop has started; callers then fall back to polling.
+ *
+ * The application must call Shutdown() from wxApp::OnExit(): the instance is never destroyed, so
+ * managers may still unwatch during static destruction, and nothing tears down wx objects after wx.
+ */
+class bwxFileWatcher : public wxEvtHandler {
+public:
+    using Callback = std::function<void(const std::string& path)>;
+
+    static bwxFileWatcher& GetInstance();
+
+    bwxFileWatcher(const bwxFileWatcher&) = delete;
+    bwxFileWatcher& operator=(const bwxFileWatcher&) = delete;
+
+    // owner groups the registrations of one client for Unwatch*() and Dispatch()
+    bool Watch(const std::string& path, const void* owner, Callback callback);
+    void Unwatch(const std::string& path, const void* owner);
+    void UnwatchAll(const void* owner);
+
+    // Runs the callbacks of files changed since the last call; nullptr dispatches for every owner
+    size_t Dispatch(const void* owner = nullptr);
+
+    bool IsWatching(const std::string& path) const;
+    static bool IsAvailable();  ///< An event loop is running
+
+    void Shutdown();  ///< Stops watching for good; call before wxApp::OnExit() returns
+    inline bool IsShutDown() const { return m_shutDown; }
+
+private:
+    struct Listener {
+        const void* owner;
+        Callback callback;
+    };
+
+    bwxFileWatcher() = default;
+    ~bwxFileWatcher();
+
+    void OnFileSystemEvent(wxFileSystemWatcherEvent& event);
+    void QueueChange(const std::string& path);
+    void ReleaseDirectory(const std::string& directory);
+
+    static std::string Normalize(const std::string& path);
+    static std::string GetDirectory(const std::string& path);
+
+    std::unique_ptr<wxFileSystemWatcher> m_watcher;
+    bool m_shutDown = false;
+    std::unordered_map<std::string, std::vector<Listener>> m_listeners;  ///< By normalized file path
+    std::unordered_map<std::string, int> m_directories;                  ///< Watched directories, use count
+
+    mutable std::mutex m_mutex;
+    std::set<std::pair<std::string, const void*>> m_changes;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -22,9 +22,16 @@
 #include <wx/log.h>
 
 #include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
 #include <vector>
 
 #include "bwx_sdk/bwx_globals.h"
+#include "bwx_sdk/bwx_core/bwx_catalog.h"
+#include "bwx_sdk/bwx_core/bwx_job_system.h"
 
 namespace bwx_sdk {
 
@@ -65,6 +72,7 @@ private:
 };
 
 WX_DECLARE_STRING_HASH_MAP(bwxLanguage, LangMap);
+WX_DECLARE_STRING_HASH_MAP(wxString, LangNameMap);  ///< Language name -> short name
 
 class bwxInternat : public wxLocale {
 public:
@@ -74,8 +82,16 @@ public:
 
     bwxInternat(const wxString& shortName, const wxString& name, const wxString& uname, wxLanguage wxLangCode);
 
+    ~bwxInternat() override;
+
     bool Init(const wxString& shortName = wxEmptyString);
 
+    // Init() with the compiled catalog loaded on a bwxJobSystem worker; Translate() returns source strings
+    // until it is in. The gettext catalogs are still added here, wxTranslations is not thread-safe
+    bool InitAsync(const wxString& shortName = wxEmptyString);
+    bool IsCatalogPending() const { return !m_catalogJobs.IsDone(); }
+    void WaitForCatalog();
+
     bool InitByName(const wxString& name);
 
     void SetDefaultAppLanguage(const bwxLanguage& l) noexcept { m_defaultLang = l; }
@@ -108,13 +124,36 @@ public:
 
     void ResetToDefaultLanguage();
 
+    // Compiled catalogs (scripts/compile_catalogs.py): <lang folder>/<short name>/<short name>.bwxcat.
+    // Switching is an atomic pointer swap; loaded catalogs are kept, so views from Translate() stay
+    // valid while this object exists. An empty short name switches back to the source strings.
+    bool UseCompiledCatalog(const wxString& shortName);
+
+    // Zero-allocation lookup in the active compiled catalog (UTF-8); the msgid if not translated
+    static inline std::string_view Translate(std::string_view msgid) {
+        const bwxCatalog* catalog = m_activeCatalog.load(std::memory_order_acquire);
+        return catalog ? catalog->Translate(msgid) : msgid;
+    }
+
+    static inline const bwxCatalog* GetActiveCatalog() { return m_activeCatalog.load(std::memory_order_acquire); }
+
 private:
+    static std::atomic<const bwxCatalog*> m_activeCatalog;
+
     bwxLanguage m_defaultLang;
     LangMap m_langMap;
+    LangNameMap m_langNames;
+    std::map<wxString, std::shared_ptr<const bwxCatalog>> m_compiledCatalogs;  ///< Under m_catalogMutex
+    std::mutex m_catalogMutex;
+    uint64_t m_catalogRequest = 0;  ///< Bumped by every switch; a background load only activates if still the latest
+    bwxJobCounter m_catalogJobs;
     wxString m_langFolder = bwxDEFAULT_LANG_FOLDER;
     bool m_useShortCatalogNames = true;
 
+    bool InitLanguage(const wxString& shortName, bool async);
     bool LoadCatalogs(const wxLanguageInfo* langInfo);
+    void LoadCompiledCatalogAsync(const wxString& shortName);
+    wxString CompiledCatalogPath(const wxString& shortName) const;
 };
 
 }  // namespace bwx_sdk
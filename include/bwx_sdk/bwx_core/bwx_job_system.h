@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_job_system.h
+// Purpose:     BWX_SDK Library; Work-stealing job system
+// Author:      Bartosz Warzocha
+// Created:     2026-10-14
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JOB_SYSTEM_H_
+#define _BWX_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Number of unfinished jobs of a group. Wait() returns when it drops to zero.
+ */
+class bwxJobCounter {
+public:
+    bwxJobCounter() = default;
+    bwxJobCounter(const bwxJobCounter&) = delete;
+    bwxJobCounter& operator=(const bwxJobCounter&) = delete;
+
+    inline bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class bwxJobSystem;
+    std::atomic<int> m_pending{0};
+};
+
+/**
+ * @brief Fixed pool of worker threads, each with its own job deque.
+ *
+ * Workers pop their own newest job and steal the oldest ones from others when idle.
+ * A thread waiting on a counter runs pending jobs instead of blocking, so jobs may
+ * schedule and wait for their own sub-jobs.
+ */
+class bwxJobSystem {
+public:
+    using Job = std::function<void()>;
+
+    static bwxJobSystem& GetInstance();
+
+    explicit bwxJobSystem(unsigned int workerCount = 0);  ///< 0 = hardware threads - 1
+    ~bwxJobSystem();
+
+    bwxJobSystem(const bwxJobSystem&) = delete;
+    bwxJobSystem& operator=(const bwxJobSystem&) = delete;
+
+    void Schedule(Job job, bwxJobCounter* counter = nullptr);
+    void Wait(bwxJobCounter& counter);
+
+    // Splits [0, count) into chunks of at least grainSize and waits for all of them
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& func);
+
+    inline unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_threads.size()); }
+
+private:
+    struct Entry {
+        Job job;
+        bwxJobCounter* counter = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Entry> entries;
+    };
+
+    void WorkerLoop(unsigned int index);
+    bool RunOne(int preferredQueue);
+    bool Pop(unsigned int queue, Entry& entry);
+    bool Steal(unsigned int thief, Entry& entry);
+    void Execute(Entry& entry);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;  ///< One per worker, plus one for outside threads
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_queued{0};
+    std::atomic<bool> m_running{true};
+};
+
+}  // namespace bwx_sdk
+
+#endif
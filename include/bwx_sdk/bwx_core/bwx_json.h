@@ -24,8 +24,11 @@
 #include <wx/txtstrm.h>
 #include <wx/wfstream.h>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -52,6 +55,7 @@ public:
 
     explicit bwxJSON(const bwxJsonValue& defaultValue);
 
+    // Copies share data (copy-on-write): O(1), a map is copied only when one side modifies it
     bwxJSON(const bwxJSON& other);
 
     bwxJSON(bwxJSON&& other) noexcept;
@@ -66,8 +70,31 @@ public:
 
     bool ParseFromString(const wxString& jsonText);
 
+    bool ParseFromUtf8(std::string_view jsonText);
+
     wxString SerializeToString() const;
 
+    // Serialize as UTF-8 (indent > 0: pretty-printed); appends to out, so one buffer can be reused
+    std::string SerializeToUtf8(int indent = 0) const;
+
+    void SerializeToUtf8(std::string& out, int indent = 0) const;
+
+    // Escape text for storing as a string value (values and keys are kept and written raw)
+    static void EscapeUtf8(std::string_view text, std::string& out);
+
+    // MessagePack binary form (integer types kept, strings raw) - see bwx_json_msgpack.h
+    void SerializeToMsgPack(std::vector<uint8_t>& out) const;
+
+    bool ParseFromMsgPack(const void* data, size_t size);
+
+    bool SaveToMsgPackFile(const wxString& filename) const;
+
+    bool LoadFromMsgPackFile(const wxString& filename);
+
+    bool SaveToMsgPackStream(wxOutputStream& stream) const;
+
+    bool LoadFromMsgPackStream(wxInputStream& stream);
+
     bool HasKey(const wxString& key) const;
 
     void RemoveKey(const wxString& key);
@@ -80,6 +107,13 @@ public:
 
     bwxJsonValue FindValue(const wxString& key) const;
 
+    // Value in place (nullptr if missing) - no copy; valid until this object is modified
+    const bwxJsonValue* GetValuePtr(const wxString& key) const;
+
+    // Nested object ready for modification (nullptr if not an object) - copied first if it is
+    // shared with another tree, so snapshots are not affected
+    bwxJSON* GetObjectForWrite(const wxString& key);
+
     void AppendToArray(const wxString& key, const bwxJsonValue& value);
 
     std::vector<bwxJsonValue> GetArray(const wxString& key) const;
@@ -176,25 +210,23 @@ public:
     bwxJSON Map(std::function<bwxJsonValue(const wxString&, const bwxJsonValue&)> transform) const;
 
 private:
-    std::unordered_map<wxString, bwxJsonValue> m_data;
+    using bwxJsonMap = std::unordered_map<wxString, bwxJsonValue>;
 
-    wxString m_lastError;
-
-    wxString EscapeString(const wxString& str) const;
+    std::shared_ptr<bwxJsonMap> m_data;  ///< Shared between copies; nullptr when empty
 
-    wxString JsonValueToString(const bwxJsonValue& value) const;
-
-    size_t SkipWhitespace(const wxString& text, size_t start) const;
+    wxString m_lastError;
 
-    bwxJsonValue ParseValue(const wxString& text, size_t& pos);
+    const bwxJsonMap& Data() const;
 
-    wxString ParseString(const wxString& text, size_t& pos);
+    // Detaches a shared map before modification
+    bwxJsonMap& MutableData();
 
-    bwxJsonValue ParseNumber(const wxString& text, size_t& pos);
+    // Detaches a shared nested object before modification
+    static bwxJSON& MutableObject(std::shared_ptr<bwxJSON>& object);
 
-    bwxJsonValue ParseObject(const wxString& text, size_t& pos);
+    void WriteUtf8(std::string& out, int indent, int level) const;
 
-    bwxJsonValue ParseArray(const wxString& text, size_t& pos);
+    static void WriteValueUtf8(std::string& out, const bwxJsonValue& value, int indent, int level);
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,487 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_bind.h
+// Purpose:     BWX_SDK Library; Typed struct binding for bwxJSON
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_BIND_H_
+#define _BWX_JSON_BIND_H_
+
+#include <wx/string.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_json.h>
+#include <bwx_sdk/bwx_core/bwx_json_stream.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Struct member bound to a JSON key (see BWX_JSON_BIND).
+ */
+template <typename T, typename M>
+struct bwxJsonField {
+    const char* key;
+    M T::*member;
+    bool required;
+};
+
+template <typename T, typename M>
+constexpr bwxJsonField<T, M> bwxJsonMakeField(const char* key, M T::*member, bool required = false) {
+    return {key, member, required};
+}
+
+/**
+ * Field list of a struct, written at namespace scope next to it:
+ *
+ *     BWX_JSON_BIND(SceneNode, BWX_JSON_REQUIRED(name), BWX_JSON_FIELD(transform),
+ *                   BWX_JSON_FIELD_AS("child-nodes", children))
+ *
+ * Supported member types: bool, integers, floating point, wxString, std::string,
+ * std::vector and std::optional of those, other bound structs and bwxJsonValue.
+ * Members missing from the input keep their value unless marked as required.
+ */
+#define BWX_JSON_BIND(Type, ...)                                  \
+    [[maybe_unused]] constexpr auto bwxJsonDescribe(const Type*) { \
+        using Self = Type;                                        \
+        return std::make_tuple(__VA_ARGS__);                      \
+    }
+
+#define BWX_JSON_FIELD(member) ::bwx_sdk::bwxJsonMakeField(#member, &Self::member)
+#define BWX_JSON_FIELD_AS(key, member) ::bwx_sdk::bwxJsonMakeField(key, &Self::member)
+#define BWX_JSON_REQUIRED(member) ::bwx_sdk::bwxJsonMakeField(#member, &Self::member, true)
+
+/**
+ * @brief Error of a typed decode with the path of the failing value ("nodes[2].name").
+ */
+class bwxJsonBindContext {
+public:
+    inline void Push(const char* key) { m_path.push_back({key, 0}); }
+    inline void Push(size_t index) { m_path.push_back({nullptr, index}); }
+    inline void Pop() { m_path.pop_back(); }
+
+    bool Fail(const wxString& message) {
+        wxString path;
+        for (const Segment& segment : m_path) {
+            if (segment.key) {
+                if (!path.IsEmpty()) path += ".";
+                path += wxString::FromUTF8(segment.key);
+            } else {
+                path += wxString::Format(wxT("[%zu]"), segment.index);
+            }
+        }
+        m_error = wxString::Format(wxT("JSON binding error at %s: %s"), path.IsEmpty() ? wxString(wxT("$")) : path, message);
+        return false;
+    }
+
+    inline wxString GetError() const { return m_error; }
+
+private:
+    struct Segment {
+        const char* key;
+        size_t index;
+    };
+
+    std::vector<Segment> m_path;
+    wxString m_error;
+};
+
+namespace detail {
+
+template <typename T>
+concept bwxJsonBound = requires(const T* type) { bwxJsonDescribe(type); };
+
+template <typename T>
+struct bwxJsonIsVector : std::false_type {};
+template <typename T, typename A>
+struct bwxJsonIsVector<std::vector<T, A>> : std::true_type {};
+
+template <typename T>
+struct bwxJsonIsOptional : std::false_type {};
+template <typename T>
+struct bwxJsonIsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+constexpr auto bwxJsonFields() {
+    return bwxJsonDescribe(static_cast<const T*>(nullptr));
+}
+
+// Keys as wxString, built once per struct type (bwxJSON lookups)
+template <typename T>
+const auto& bwxJsonKeys() {
+    static const auto keys =
+        std::apply([](const auto&... field) { return std::array<wxString, sizeof...(field)>{wxString::FromUTF8(field.key)...}; },
+                   bwxJsonFields<T>());
+    return keys;
+}
+
+template <typename T>
+bool bwxJsonStoreInteger(auto number, T& out, bwxJsonBindContext& context) {
+    if (!std::in_range<T>(number)) return context.Fail(wxT("integer out of range"));
+    out = static_cast<T>(number);
+    return true;
+}
+
+// ========================================================================
+// Decoding from a bwxJSON tree (values in place, no copies)
+// ========================================================================
+
+template <typename T>
+bool bwxJsonDecodeObject(const bwxJSON& json, T& out, bwxJsonBindContext& context);
+
+template <typename T>
+bool bwxJsonDecodeValue(const bwxJsonValue& value, T& out, bwxJsonBindContext& context) {
+    if constexpr (std::is_same_v<T, bwxJsonValue>) {
+        out = value;
+        return true;
+    } else if constexpr (bwxJsonIsOptional<T>::value) {
+        if (!value.has_value() || std::holds_alternative<std::nullptr_t>(*value)) {
+            out.reset();
+            return true;
+        }
+        return bwxJsonDecodeValue(value, out.emplace(), context);
+    } else {
+        if (!value.has_value()) return context.Fail(wxT("unexpected null"));
+        const auto& data = *value;
+
+        if constexpr (std::is_same_v<T, bool>) {
+            if (const bool* flag = std::get_if<bool>(&data)) {
+                out = *flag;
+                return true;
+            }
+            return context.Fail(wxT("expected boolean"));
+        } else if constexpr (std::is_integral_v<T>) {
+            if (const int* number = std::get_if<int>(&data)) return bwxJsonStoreInteger(*number, out, context);
+            if (const int64_t* number = std::get_if<int64_t>(&data)) return bwxJsonStoreInteger(*number, out, context);
+            if (const uint64_t* number = std::get_if<uint64_t>(&data)) return bwxJsonStoreInteger(*number, out, context);
+            return context.Fail(wxT("expected integer"));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if (const double* number = std::get_if<double>(&data)) out = static_cast<T>(*number);
+            else if (const int* number = std::get_if<int>(&data)) out = static_cast<T>(*number);
+            else if (const int64_t* number = std::get_if<int64_t>(&data)) out = static_cast<T>(*number);
+            else if (const uint64_t* number = std::get_if<uint64_t>(&data)) out = static_cast<T>(*number);
+            else return context.Fail(wxT("expected number"));
+            return true;
+        } else if constexpr (std::is_same_v<T, wxString>) {
+            if (const wxString* text = std::get_if<wxString>(&data)) out = *text;
+            else if (const std::string* text = std::get_if<std::string>(&data)) out = wxString::FromUTF8(text->data(), text->size());
+            else return context.Fail(wxT("expected string"));
+            return true;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            if (const std::string* text = std::get_if<std::string>(&data)) out = *text;
+            else if (const wxString* text = std::get_if<wxString>(&data)) out = text->utf8_str().data();
+            else return context.Fail(wxT("expected string"));
+            return true;
+        } else if constexpr (bwxJsonIsVector<T>::value) {
+            const auto* items = std::get_if<std::vector<bwxJsonValueHelper>>(&data);
+            if (!items) return context.Fail(wxT("expected array"));
+
+            out.clear();
+            out.reserve(items->size());
+            for (size_t i = 0; i < items->size(); ++i) {
+                context.Push(i);
+                if (!bwxJsonDecodeValue((*items)[i].value, out.emplace_back(), context)) return false;
+                context.Pop();
+            }
+            return true;
+        } else if constexpr (bwxJsonBound<T>) {
+            const auto* object = std::get_if<std::shared_ptr<bwxJSON>>(&data);
+            if (!object || !*object) return context.Fail(wxT("expected object"));
+            return bwxJsonDecodeObject(**object, out, context);
+        } else {
+            static_assert(bwxJsonBound<T>, "Unsupported member type - bind the struct with BWX_JSON_BIND");
+            return false;
+        }
+    }
+}
+
+template <typename T>
+bool bwxJsonDecodeObject(const bwxJSON& json, T& out, bwxJsonBindContext& context) {
+    const auto& keys = bwxJsonKeys<T>();
+    return std::apply(
+        [&](const auto&... field) {
+            size_t index = 0;
+            auto decodeField = [&](const auto& field) {
+                const bwxJsonValue* value = json.GetValuePtr(keys[index++]);
+                context.Push(field.key);
+                if (!value) {
+                    if (field.required) return context.Fail(wxT("missing required member"));
+                    context.Pop();
+                    return true;
+                }
+                if (!bwxJsonDecodeValue(*value, out.*field.member, context)) return false;
+                context.Pop();
+                return true;
+            };
+            return (decodeField(field) && ...);
+        },
+        bwxJsonFields<T>());
+}
+
+// ========================================================================
+// Decoding from a bwxJsonReader (single pass over the tokens, no tree)
+// ========================================================================
+
+inline bool bwxJsonReaderFail(bwxJsonReader& reader, bwxJsonBindContext& context, const wxString& expected) {
+    return context.Fail(reader.IsOk() ? expected : reader.GetLastError());
+}
+
+template <typename T>
+bool bwxJsonReadObject(bwxJsonReader& reader, T& out, bwxJsonBindContext& context);
+
+// Reader is on the first token of the value
+template <typename T>
+bool bwxJsonReadValue(bwxJsonReader& reader, T& out, bwxJsonBindContext& context) {
+    const bwxJsonReader::Token token = reader.GetToken();
+
+    if constexpr (std::is_same_v<T, bwxJsonValue>) {
+        return reader.ReadValue(out) || bwxJsonReaderFail(reader, context, wxT("invalid value"));
+    } else if constexpr (bwxJsonIsOptional<T>::value) {
+        if (token == bwxJsonReader::TOKEN_NULL) {
+            out.reset();
+            return true;
+        }
+        return bwxJsonReadValue(reader, out.emplace(), context);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (token != bwxJsonReader::TOKEN_BOOL) return bwxJsonReaderFail(reader, context, wxT("expected boolean"));
+        out = reader.GetBool();
+        return true;
+    } else if constexpr (std::is_integral_v<T>) {
+        if (token == bwxJsonReader::TOKEN_INT) return bwxJsonStoreInteger(reader.GetInt(), out, context);
+        if (token == bwxJsonReader::TOKEN_UINT) return bwxJsonStoreInteger(reader.GetUInt(), out, context);
+        return bwxJsonReaderFail(reader, context, wxT("expected integer"));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (token == bwxJsonReader::TOKEN_DOUBLE) out = static_cast<T>(reader.GetDouble());
+        else if (token == bwxJsonReader::TOKEN_INT) out = static_cast<T>(reader.GetInt());
+        else if (token == bwxJsonReader::TOKEN_UINT) out = static_cast<T>(reader.GetUInt());
+        else return bwxJsonReaderFail(reader, context, wxT("expected number"));
+        return true;
+    } else if constexpr (std::is_same_v<T, wxString> || std::is_same_v<T, std::string>) {
+        if (token != bwxJsonReader::TOKEN_STRING) return bwxJsonReaderFail(reader, context, wxT("expected string"));
+        const std::string_view raw = reader.GetRawString();
+        if constexpr (std::is_same_v<T, wxString>) out = wxString::FromUTF8(raw.data(), raw.size());
+        else out.assign(raw.data(), raw.size());
+        return true;
+    } else if constexpr (bwxJsonIsVector<T>::value) {
+        if (token != bwxJsonReader::TOKEN_START_ARRAY) return bwxJsonReaderFail(reader, context, wxT("expected array"));
+
+        out.clear();
+        for (size_t i = 0;; ++i) {
+            if (reader.Next() == bwxJsonReader::TOKEN_END_ARRAY) return true;
+            context.Push(i);
+            if (!bwxJsonReadValue(reader, out.emplace_back(), context)) return false;
+            context.Pop();
+        }
+    } else if constexpr (bwxJsonBound<T>) {
+        if (token != bwxJsonReader::TOKEN_START_OBJECT) return bwxJsonReaderFail(reader, context, wxT("expected object"));
+        return bwxJsonReadObject(reader, out, context);
+    } else {
+        static_assert(bwxJsonBound<T>, "Unsupported member type - bind the struct with BWX_JSON_BIND");
+        return false;
+    }
+}
+
+template <typename T>
+bool bwxJsonReadObject(bwxJsonReader& reader, T& out, bwxJsonBindContext& context) {
+    constexpr auto fields = bwxJsonFields<T>();
+    constexpr size_t fieldCount = std::tuple_size_v<decltype(fields)>;
+    std::array<bool, fieldCount> seen{};
+    std::string key;
+
+    for (;;) {
+        const bwxJsonReader::Token token = reader.Next();
+        if (token == bwxJsonReader::TOKEN_END_OBJECT) break;
+        if (token != bwxJsonReader::TOKEN_KEY) return bwxJsonReaderFail(reader, context, wxT("expected key"));
+
+        // Member matched against the field keys (key copied - Next() reuses the buffer); unknown
+        // members are skipped
+        key.assign(reader.GetRawString());
+        reader.Next();
+        if (!reader.IsOk()) return bwxJsonReaderFail(reader, context, wxT("expected value"));
+
+        bool matched = false;
+        bool valid = std::apply(
+            [&](const auto&... field) {
+                size_t index = 0;
+                auto readField = [&](const auto& field) {
+                    const size_t current = index++;
+                    if (matched || key != field.key) return true;
+
+                    matched = true;
+                    seen[current] = true;
+                    context.Push(field.key);
+                    if (!bwxJsonReadValue(reader, out.*field.member, context)) return false;
+                    context.Pop();
+                    return true;
+                };
+                return (readField(field) && ...);
+            },
+            fields);
+        if (!valid) return false;
+
+        if (!matched && (reader.GetToken() == bwxJsonReader::TOKEN_START_OBJECT || reader.GetToken() == bwxJsonReader::TOKEN_START_ARRAY) &&
+            !reader.Skip())
+            return bwxJsonReaderFail(reader, context, wxT("invalid value"));
+    }
+
+    return std::apply(
+        [&](const auto&... field) {
+            size_t index = 0;
+            auto checkField = [&](const auto& field) {
+                if (seen[index++] || !field.required) return true;
+                context.Push(field.key);
+                return context.Fail(wxT("missing required member"));
+            };
+            return (checkField(field) && ...);
+        },
+        fields);
+}
+
+// ========================================================================
+// Encoding
+// ========================================================================
+
+template <typename T>
+void bwxJsonEncodeObject(const T& in, bwxJSON& json);
+
+template <typename T>
+bwxJsonValue bwxJsonEncodeValue(const T& in) {
+    if constexpr (std::is_same_v<T, bwxJsonValue>) {
+        return in;
+    } else if constexpr (bwxJsonIsOptional<T>::value) {
+        return in ? bwxJsonEncodeValue(*in) : bwxJsonValue(std::nullopt);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return in;
+    } else if constexpr (std::is_integral_v<T>) {
+        // Same alternatives the parser picks: int, then int64_t, then uint64_t
+        if (std::in_range<int>(in)) return static_cast<int>(in);
+        if (std::in_range<int64_t>(in)) return static_cast<int64_t>(in);
+        return static_cast<uint64_t>(in);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<double>(in);
+    } else if constexpr (std::is_same_v<T, wxString> || std::is_same_v<T, std::string>) {
+        return in;
+    } else if constexpr (bwxJsonIsVector<T>::value) {
+        std::vector<bwxJsonValueHelper> items;
+        items.reserve(in.size());
+        for (const auto& item : in) items.push_back(bwxJsonValueHelper{bwxJsonEncodeValue(item)});
+        return items;
+    } else if constexpr (bwxJsonBound<T>) {
+        auto object = std::make_shared<bwxJSON>();
+        bwxJsonEncodeObject(in, *object);
+        return object;
+    } else {
+        static_assert(bwxJsonBound<T>, "Unsupported member type - bind the struct with BWX_JSON_BIND");
+        return std::nullopt;
+    }
+}
+
+template <typename T>
+void bwxJsonEncodeObject(const T& in, bwxJSON& json) {
+    const auto& keys = bwxJsonKeys<T>();
+    std::apply(
+        [&](const auto&... field) {
+            size_t index = 0;
+            ((json[keys[index++]] = bwxJsonEncodeValue(in.*field.member)), ...);
+        },
+        bwxJsonFields<T>());
+}
+
+template <typename T>
+void bwxJsonWriteValue(const T& in, bwxJsonWriter& writer) {
+    if constexpr (std::is_same_v<T, bwxJsonValue>) {
+        writer.Value(in);
+    } else if constexpr (bwxJsonIsOptional<T>::value) {
+        if (in) bwxJsonWriteValue(*in, writer);
+        else writer.Null();
+    } else if constexpr (std::is_same_v<T, bool>) {
+        writer.Bool(in);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        writer.Int(in);
+    } else if constexpr (std::is_integral_v<T>) {
+        writer.UInt(in);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        writer.Double(in);
+    } else if constexpr (std::is_same_v<T, wxString>) {
+        const wxScopedCharBuffer utf8 = in.utf8_str();
+        writer.RawString(std::string_view(utf8.data(), utf8.length()));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        writer.RawString(in);
+    } else if constexpr (bwxJsonIsVector<T>::value) {
+        writer.StartArray();
+        for (const auto& item : in) bwxJsonWriteValue(item, writer);
+        writer.EndArray();
+    } else if constexpr (bwxJsonBound<T>) {
+        writer.StartObject();
+        std::apply(
+            [&](const auto&... field) {
+                ((writer.RawKey(field.key), bwxJsonWriteValue(in.*field.member, writer)), ...);
+            },
+            bwxJsonFields<T>());
+        writer.EndObject();
+    } else {
+        static_assert(bwxJsonBound<T>, "Unsupported member type - bind the struct with BWX_JSON_BIND");
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Decode a bound struct from a bwxJSON object - one in-place lookup per field.
+ *
+ * Strings are taken raw, as bwxJSON keeps them. On failure the error names the path.
+ */
+template <typename T>
+bool bwxJsonDecode(const bwxJSON& json, T& out, wxString* error = nullptr) {
+    bwxJsonBindContext context;
+    const bool ok = detail::bwxJsonDecodeObject(json, out, context);
+    if (!ok && error) *error = context.GetError();
+    return ok;
+}
+
+/**
+ * @brief Decode the next root object of a reader straight into a bound struct (single pass,
+ * no tree; unknown members are skipped).
+ */
+template <typename T>
+bool bwxJsonDecode(bwxJsonReader& reader, T& out, wxString* error = nullptr) {
+    bwxJsonBindContext context;
+    const bool ok = reader.Next() == bwxJsonReader::TOKEN_START_OBJECT
+                        ? detail::bwxJsonReadObject(reader, out, context)
+                        : detail::bwxJsonReaderFail(reader, context, wxT("expected object"));
+    if (!ok && error) *error = context.GetError();
+    return ok;
+}
+
+template <typename T>
+void bwxJsonEncode(const T& in, bwxJSON& json) {
+    detail::bwxJsonEncodeObject(in, json);
+}
+
+template <typename T>
+void bwxJsonEncode(const T& in, bwxJsonWriter& writer) {
+    detail::bwxJsonWriteValue(in, writer);
+}
+
+}  // namespace bwx_sdk
+
+#endif
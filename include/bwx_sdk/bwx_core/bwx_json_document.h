@@ -0,0 +1,214 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_document.h
+// Purpose:     BWX_SDK Library; Compact arena-allocated JSON DOM
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_DOCUMENT_H_
+#define _BWX_JSON_DOCUMENT_H_
+
+#include <wx/string.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_json.h>
+
+namespace bwx_sdk {
+
+struct bwxJsonMember;
+
+/**
+ * @brief 16-byte tagged JSON value living in a bwxJsonDocument arena.
+ *
+ * Strings are raw JSON string contents (escape sequences unchanged, as in bwxJSON), viewing
+ * the document source until modified. Arrays and objects point to contiguous item/member blocks.
+ */
+class bwxJsonNode {
+public:
+    enum Type : uint8_t { TYPE_NULL, TYPE_BOOL, TYPE_INT, TYPE_UINT, TYPE_DOUBLE, TYPE_STRING, TYPE_ARRAY, TYPE_OBJECT };
+
+    bwxJsonNode() : m_type(TYPE_NULL), m_capacityShift(0), m_reserved(0), m_size(0) { m_value.i = 0; }
+
+    inline Type GetType() const { return static_cast<Type>(m_type); }
+    inline bool IsNull() const { return m_type == TYPE_NULL; }
+    inline bool IsBool() const { return m_type == TYPE_BOOL; }
+    inline bool IsNumber() const { return m_type == TYPE_INT || m_type == TYPE_UINT || m_type == TYPE_DOUBLE; }
+    inline bool IsString() const { return m_type == TYPE_STRING; }
+    inline bool IsArray() const { return m_type == TYPE_ARRAY; }
+    inline bool IsObject() const { return m_type == TYPE_OBJECT; }
+
+    bool AsBool(bool defaultValue = false) const;
+    int AsInt(int defaultValue = 0) const;
+    int64_t AsInt64(int64_t defaultValue = 0) const;
+    uint64_t AsUInt64(uint64_t defaultValue = 0) const;
+    double AsDouble(double defaultValue = 0.0) const;
+    std::string_view AsString(std::string_view defaultValue = {}) const;
+    wxString AsWxString(const wxString& defaultValue = "") const;
+
+    // Number of array items or object members (0 for other types)
+    inline uint32_t GetSize() const { return (m_type == TYPE_ARRAY || m_type == TYPE_OBJECT) ? m_size : 0; }
+
+    // Array item (null node if out of range or not an array)
+    const bwxJsonNode& operator[](size_t index) const;
+    bwxJsonNode* GetItem(size_t index);
+
+    // Object member by position (nullptr if out of range or not an object)
+    const bwxJsonMember* GetMember(size_t index) const;
+    bwxJsonMember* GetMember(size_t index);
+
+    void SetNull();
+    void SetBool(bool value);
+    void SetInt(int64_t value);
+    void SetUInt(uint64_t value);
+    void SetDouble(double value);
+
+private:
+    friend class bwxJsonDocument;
+
+    uint8_t m_type;
+    uint8_t m_capacityShift;  ///< Items/members block holds 1 << (shift - 1) entries (0 = exactly m_size)
+    uint16_t m_reserved;
+    uint32_t m_size;  ///< String bytes, array items or object members
+
+    union {
+        bool b;
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char* str;
+        bwxJsonNode* items;
+        bwxJsonMember* members;
+    } m_value;
+};
+
+static_assert(sizeof(bwxJsonNode) == 16, "bwxJsonNode must stay 16 bytes");
+
+/**
+ * @brief Object member: interned key ID plus value (keys are stored once per document).
+ */
+struct bwxJsonMember {
+    uint32_t key;
+    bwxJsonNode value;
+};
+
+/**
+ * @brief Compact JSON DOM - alternative to bwxJSON for large documents.
+ *
+ * All nodes live in a monotonic arena (freed together with the document), objects keep
+ * members in insertion order with interned keys, and strings view the source buffer
+ * owned by the document. Parsing allocates a handful of arena blocks instead of several
+ * heap blocks and reference counts per value.
+ *
+ * Modification is append-only (set values, add members/items); replaced blocks stay in
+ * the arena until Clear() or the next Parse().
+ */
+class bwxJsonDocument {
+public:
+    bwxJsonDocument();
+    ~bwxJsonDocument();
+
+    bwxJsonDocument(const bwxJsonDocument&) = delete;
+    bwxJsonDocument& operator=(const bwxJsonDocument&) = delete;
+
+    // Takes ownership of the UTF-8 text - strings and keys view it
+    bool Parse(std::string jsonText);
+    bool ParseFromUtf8(std::string_view jsonText) { return Parse(std::string(jsonText)); }
+    bool LoadFromFile(const wxString& filename);
+
+    // JSON Lines (NDJSON): root becomes an array of the records, one per non-blank line, and
+    // the text is copied. Invalid lines are left out; returns their count (first error in
+    // GetLastError()). Record offsets (recordOffsets) and error positions start at baseOffset.
+    size_t ParseLines(std::string_view text, size_t baseOffset = 0, std::vector<size_t>* recordOffsets = nullptr);
+
+    std::string SerializeToUtf8() const;
+    bool SaveToFile(const wxString& filename) const;
+
+    void Clear();
+
+    // Like Clear(), but keeps the last arena block and buffers for the next parse
+    void Reset();
+
+    inline bwxJsonNode& GetRoot() { return m_root; }
+    inline const bwxJsonNode& GetRoot() const { return m_root; }
+
+    wxString GetLastError() const { return m_lastError; }
+
+    // Object lookup (nullptr if missing or not an object); linear over interned key IDs
+    const bwxJsonNode* Find(const bwxJsonNode& object, std::string_view key) const;
+    bwxJsonNode* Find(bwxJsonNode& object, std::string_view key);
+
+    std::string_view GetKey(const bwxJsonMember& member) const { return m_keys[member.key]; }
+
+    // Copies text into the arena (string no longer views the source)
+    void SetString(bwxJsonNode& node, std::string_view text);
+
+    // Turn node into an empty array/object with room for capacity entries
+    void SetArray(bwxJsonNode& node, uint32_t capacity = 0);
+    void SetObject(bwxJsonNode& node, uint32_t capacity = 0);
+
+    // Append (returned reference is valid until the next append to the same container)
+    bwxJsonNode& Append(bwxJsonNode& array);
+    bwxJsonNode& SetMember(bwxJsonNode& object, std::string_view key);  ///< Existing member or new one
+
+    // Copy into bwxJSON tree (root must be an object)
+    bwxJSON ToJSON() const;
+
+    // Arena statistics (diagnostics)
+    inline size_t GetArenaSize() const { return m_arenaSize; }
+    inline size_t GetKeyCount() const { return m_keys.size(); }
+
+private:
+    struct ParseState;
+
+    static constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+    void* Allocate(size_t size, size_t alignment);
+    template <typename T>
+    T* AllocateArray(size_t count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+
+    uint32_t InternKey(std::string_view key, bool copy);
+    uint32_t FindKey(std::string_view key) const;
+    void Reserve(bwxJsonNode& node, uint32_t needed);
+
+    bool ParseValue(ParseState& state, bwxJsonNode& node, int depth);
+    bool ParseString(ParseState& state, std::string_view& text);
+    bool ParseNumber(ParseState& state, bwxJsonNode& node);
+    bool ParseArray(ParseState& state, bwxJsonNode& node, int depth);
+    bool ParseObject(ParseState& state, bwxJsonNode& node, int depth);
+
+    void SerializeNode(const bwxJsonNode& node, std::string& out) const;
+    bwxJsonValue ToJsonValue(const bwxJsonNode& node) const;
+
+    std::string m_source;  ///< Parsed text (string and key views point here)
+    bwxJsonNode m_root;
+    wxString m_lastError;
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;  ///< Arena blocks
+    char* m_blockStart = nullptr;  ///< Start of the block m_blockPos points into
+    char* m_blockPos = nullptr;
+    char* m_blockEnd = nullptr;
+    size_t m_arenaSize = 0;  ///< Bytes allocated from the system for the arena
+
+    std::vector<std::string_view> m_keys;  ///< Interned keys by ID
+    std::unordered_map<std::string_view, uint32_t> m_keyIds;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_lazy.h
+// Purpose:     BWX_SDK Library; Lazy (index-first) JSON reader
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_LAZY_H_
+#define _BWX_JSON_LAZY_H_
+
+#include <wx/string.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_json.h>
+#include <bwx_sdk/bwx_core/bwx_json_path.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Read-only lazy bwxJSON: parsing builds only a structural index (tape), values are
+ * decoded on access.
+ *
+ * The tape holds one 8-byte entry per string, scalar and bracket; each container entry
+ * points past its end, so unvisited subtrees are skipped in O(1). Values come back in the
+ * same form bwxJSON::ParseFromUtf8() gives them (raw strings, int/int64_t/uint64_t/double).
+ * Numbers and literals are validated when read. Paths use the separator ("." by default)
+ * and array indexes ("a.b.0.c"); a root key containing the separator is matched first.
+ * Decoded containers are cached, so the object is not safe for concurrent access.
+ */
+class bwxJsonLazy {
+public:
+    bwxJsonLazy() = default;
+
+    // Takes ownership of the UTF-8 text (root must be an object, as in bwxJSON)
+    bool Parse(std::string jsonText);
+    bool ParseFromUtf8(std::string_view jsonText) { return Parse(std::string(jsonText)); }
+    bool LoadFromFile(const wxString& filename);
+
+    void Clear();
+
+    inline bool IsValid() const { return !m_tape.empty(); }
+    inline wxString GetLastError() const { return m_lastError; }
+
+    inline void SetPathSeparator(const wxString& separator) { m_separator = separator; }
+
+    bool HasKey(const wxString& path) const;
+    bwxJsonValue GetValue(const wxString& path, const bwxJsonValue& defaultValue = std::nullopt) const;
+
+    // Root object keys and their count
+    std::vector<wxString> GetKeys() const;
+    size_t GetSize() const;
+
+    int AsInt(const wxString& path, int defaultValue = 0) const;
+    int64_t AsInt64(const wxString& path, int64_t defaultValue = 0) const;
+    uint64_t AsUInt64(const wxString& path, uint64_t defaultValue = 0) const;
+    double AsDouble(const wxString& path, double defaultValue = 0.0) const;
+    bool AsBool(const wxString& path, bool defaultValue = false) const;
+    wxString AsWxString(const wxString& path, const wxString& defaultValue = "") const;
+    std::string AsStdString(const wxString& path, const std::string& defaultValue = "") const;
+
+    bool IsNull(const wxString& path) const;
+
+    template <typename T>
+    bool IsType(const wxString& path) const {
+        const auto value = GetValue(path);
+        return value.has_value() && std::holds_alternative<T>(*value);
+    }
+
+    // Compiled path queries - only matched values are decoded
+    std::vector<bwxJsonValue> Select(const bwxJsonPath& path) const;
+
+    // Many paths in one pass over the index; result[i] holds matches of paths[i]
+    std::vector<std::vector<bwxJsonValue>> Extract(const std::vector<bwxJsonPath>& paths) const;
+
+    // Decode everything (same as bwxJSON::ParseFromUtf8 on the whole text)
+    bwxJSON ToJSON() const;
+
+    // Index statistics (diagnostics)
+    inline size_t GetTapeSize() const { return m_tape.size(); }
+
+private:
+    struct Entry {
+        uint32_t begin;  ///< Offset of the first character (quote, bracket, digit...)
+        uint32_t end;    ///< Strings/scalars: offset past the value; brackets: tape index of the pair
+    };
+
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    bool BuildTape();
+    bool Fail(size_t offset, const char* message);
+
+    inline size_t Next(size_t index) const {
+        const char c = m_text[m_tape[index].begin];
+        return (c == '{' || c == '[') ? m_tape[index].end + 1 : index + 1;
+    }
+
+    std::string_view RawString(size_t index) const;
+    size_t FindMember(size_t object, std::string_view key) const;
+    size_t FindPath(const wxString& path) const;
+    bwxJsonValue Decode(size_t index) const;
+    void Walk(size_t index, size_t depth, const std::vector<const bwxJsonPath*>& paths, const std::vector<size_t>& active,
+              std::vector<std::vector<bwxJsonValue>>& results) const;
+
+    std::string m_text;
+    std::vector<Entry> m_tape;
+    wxString m_lastError;
+    wxString m_separator = ".";
+
+    mutable std::unordered_map<size_t, bwxJsonValue> m_decoded;  ///< Decoded containers by tape index
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_msgpack.h
+// Purpose:     BWX_SDK Library; MessagePack encoding of bwxJSON values
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_MSGPACK_H_
+#define _BWX_JSON_MSGPACK_H_
+
+#include <wx/stream.h>
+#include <wx/string.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_json.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief MessagePack writer - to a byte vector or (buffered) to a wxOutputStream.
+ *
+ * Value() keeps the bwxJsonValue integer types: int is written in the smallest form,
+ * int64_t/uint64_t always as int 64/uint 64, so bwxMsgPackReader::ReadValue() restores them.
+ * Strings are written as stored (bwxJSON keeps them raw).
+ */
+class bwxMsgPackWriter {
+public:
+    explicit bwxMsgPackWriter(std::vector<uint8_t>& out);
+    explicit bwxMsgPackWriter(wxOutputStream& stream, size_t bufferSize = 64 * 1024);
+    ~bwxMsgPackWriter();
+
+    bwxMsgPackWriter(const bwxMsgPackWriter&) = delete;
+    bwxMsgPackWriter& operator=(const bwxMsgPackWriter&) = delete;
+
+    // Container headers - followed by count values (map: count key/value pairs)
+    void MapHeader(uint32_t count);
+    void ArrayHeader(uint32_t count);
+
+    void String(std::string_view utf8);
+    void String(const wxString& text);
+    void Binary(const void* data, uint32_t size);
+
+    void Int(int64_t value);    ///< Smallest encoding
+    void UInt(uint64_t value);  ///< Smallest encoding
+    void Int64(int64_t value);  ///< Always int 64
+    void UInt64(uint64_t value);  ///< Always uint 64
+    void Double(double value);
+    void Bool(bool value);
+    void Null();
+
+    void Value(const bwxJsonValue& value);
+    void Value(const bwxJSON& object);
+
+    bool Flush();
+    inline bool IsOk() const { return m_ok; }
+
+private:
+    void Put(uint8_t byte) { m_out->push_back(byte); }
+    void PutBigEndian(uint64_t value, int bytes);
+    void FlushIfFull();
+
+    std::vector<uint8_t> m_ownBuffer;
+    std::vector<uint8_t>* m_out;
+    wxOutputStream* m_stream = nullptr;
+    size_t m_bufferSize = 0;
+    bool m_ok = true;
+};
+
+/**
+ * @brief MessagePack pull reader over a memory block - strings and binaries are views into it.
+ *
+ * Next() returns one item; container tokens give their entry count (GetCount()).
+ */
+class bwxMsgPackReader {
+public:
+    enum Token {
+        TOKEN_NONE,
+        TOKEN_MAP,     ///< GetCount() key/value pairs follow
+        TOKEN_ARRAY,   ///< GetCount() items follow
+        TOKEN_STRING,
+        TOKEN_BINARY,
+        TOKEN_INT,     ///< Integer in a non 64-bit form (GetInt())
+        TOKEN_INT64,   ///< int 64 (GetInt())
+        TOKEN_UINT64,  ///< uint 64 (GetUInt())
+        TOKEN_DOUBLE,
+        TOKEN_BOOL,
+        TOKEN_NULL,
+        TOKEN_END,     ///< No more data
+        TOKEN_ERROR    ///< See GetLastError(); all further calls return TOKEN_ERROR
+    };
+
+    bwxMsgPackReader(const void* data, size_t size);
+
+    Token Next();
+
+    inline Token GetToken() const { return m_token; }
+    inline uint32_t GetCount() const { return m_count; }
+    inline std::string_view GetStringView() const { return m_text; }
+    inline wxString GetString() const { return wxString::FromUTF8(m_text.data(), m_text.size()); }
+    inline int64_t GetInt() const { return m_int; }
+    inline uint64_t GetUInt() const { return m_uint; }
+    inline double GetDouble() const { return m_double; }
+    inline bool GetBool() const { return m_bool; }
+
+    // Skip children of the current TOKEN_MAP/TOKEN_ARRAY
+    bool Skip();
+
+    // Decode the current item with its children into a bwxJSON value
+    bool ReadValue(bwxJsonValue& value);
+
+    inline bool IsOk() const { return m_token != TOKEN_ERROR; }
+    inline wxString GetLastError() const { return m_lastError; }
+    inline size_t GetOffset() const { return m_pos; }
+
+private:
+    Token Fail(const char* message);
+    bool Need(size_t bytes);
+    uint64_t GetBigEndian(int bytes);
+    bool SkipChildren(int depth);
+    bool ReadChildren(bwxJsonValue& value, int depth);
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+
+    Token m_token = TOKEN_NONE;
+    uint32_t m_count = 0;
+    std::string_view m_text;
+    int64_t m_int = 0;
+    uint64_t m_uint = 0;
+    double m_double = 0.0;
+    bool m_bool = false;
+    wxString m_lastError;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_ndjson.h
+// Purpose:     BWX_SDK Library; Parallel NDJSON (JSON Lines) reader
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_NDJSON_H_
+#define _BWX_JSON_NDJSON_H_
+
+#include <wx/string.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
+#include <bwx_sdk/bwx_core/bwx_json_document.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief One parsed NDJSON record - valid only during the callback.
+ */
+struct bwxNdjsonRecord {
+    size_t offset;                    ///< Byte offset of the record in the input
+    const bwxJsonDocument& document;  ///< Arena holding the value (keys, strings)
+    const bwxJsonNode& value;
+};
+
+/**
+ * @brief Parallel NDJSON (JSON Lines) reader.
+ *
+ * The input (a memory-mapped file or a memory block) is split at newlines into chunks parsed
+ * on bwxJobSystem workers, each into a bwxJsonDocument whose arena is reused for later chunks.
+ * Only a few chunks are in flight at a time, so memory does not grow with the input.
+ * ORDERED delivers records in input order on the calling thread; UNORDERED calls back on the
+ * workers as soon as a chunk is parsed (the callback must be thread-safe).
+ * Invalid lines are skipped and counted.
+ */
+class bwxNdjsonReader {
+public:
+    enum Order { ORDERED, UNORDERED };
+
+    // Return false to stop reading
+    using Callback = std::function<bool(const bwxNdjsonRecord& record)>;
+
+    explicit bwxNdjsonReader(bwxJobSystem& jobSystem = bwxJobSystem::GetInstance());
+
+    inline void SetOrder(Order order) { m_order = order; }
+    inline void SetChunkSize(size_t bytes) { m_chunkSize = bytes ? bytes : 1; }
+
+    // Both return false if the input cannot be read or some lines were invalid
+    bool ParseFile(const wxString& filename, const Callback& callback);
+    bool Parse(std::string_view text, const Callback& callback);
+
+    inline size_t GetRecordCount() const { return m_recordCount; }
+    inline size_t GetErrorCount() const { return m_errorCount; }
+    inline wxString GetLastError() const { return m_lastError; }  ///< First invalid line (offset in the input)
+
+private:
+    struct Chunk;
+
+    void ParseChunk(Chunk& chunk, const Callback& callback);
+    void Collect(Chunk& chunk, const Callback& callback);
+
+    bwxJobSystem& m_jobSystem;
+    Order m_order = ORDERED;
+    size_t m_chunkSize = 1024 * 1024;
+
+    std::atomic<bool> m_stop{false};
+    size_t m_recordCount = 0;
+    size_t m_errorCount = 0;
+    wxString m_lastError;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_path.h
+// Purpose:     BWX_SDK Library; Compiled JSON path queries
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_PATH_H_
+#define _BWX_JSON_PATH_H_
+
+#include <wx/string.h>
+
+#include <string>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_json.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief JSON path parsed once and evaluated many times.
+ *
+ * Syntax: "scene.nodes[*].transform", "a.b[0].c", "items.*.name", "[\"key.with.dots\"]"
+ * (optional leading "$"). Keys are compared raw, as bwxJSON and bwxJsonLazy store them.
+ * Evaluation against a tree returns pointers into it - no values are copied.
+ */
+class bwxJsonPath {
+public:
+    struct Segment {
+        enum Type { KEY, INDEX, ANY };
+
+        Type type = KEY;
+        wxString key;         ///< KEY: member name
+        std::string keyUtf8;  ///< KEY: member name as UTF-8 (lazy index lookups)
+        size_t index = 0;     ///< INDEX: array position
+    };
+
+    bwxJsonPath() = default;
+    explicit bwxJsonPath(const wxString& path) { Compile(path); }
+
+    bool Compile(const wxString& path);
+
+    inline bool IsValid() const { return m_valid; }
+    inline wxString GetLastError() const { return m_lastError; }
+    inline const wxString& GetPath() const { return m_path; }
+    inline const std::vector<Segment>& GetSegments() const { return m_segments; }
+
+    // All matches (wildcards may give several); pointers valid until the tree is modified
+    std::vector<const bwxJsonValue*> Select(const bwxJSON& root) const;
+    const bwxJsonValue* SelectFirst(const bwxJSON& root) const;
+
+    // Many paths in one walk - shared prefixes are visited once; result[i] holds matches of paths[i]
+    static std::vector<std::vector<const bwxJsonValue*>> Extract(const bwxJSON& root, const std::vector<bwxJsonPath>& paths);
+
+private:
+    bool Fail(size_t position, const char* message);
+
+    wxString m_path;
+    std::vector<Segment> m_segments;
+    bool m_valid = false;
+    wxString m_lastError;
+};
+
+}  // namespace bwx_sdk
+
+#endif
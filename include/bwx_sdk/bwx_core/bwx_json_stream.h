@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_stream.h
+// Purpose:     BWX_SDK Library; Streaming JSON reader and writer
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_JSON_STREAM_H_
+#define _BWX_JSON_STREAM_H_
+
+#include <wx/stream.h>
+#include <wx/string.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_json.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Pull (event) JSON reader over a wxInputStream - constant memory, no tree.
+ *
+ * Next() returns one token at a time. Strings and keys are available raw (escapes as
+ * written, like bwxJSON keeps them) or decoded. Comments and trailing commas are accepted
+ * like in bwxJSON, and several root values in a row (JSON Lines logs) are read one after another.
+ */
+class bwxJsonReader {
+public:
+    enum Token {
+        TOKEN_NONE,
+        TOKEN_START_OBJECT,
+        TOKEN_END_OBJECT,
+        TOKEN_START_ARRAY,
+        TOKEN_END_ARRAY,
+        TOKEN_KEY,
+        TOKEN_STRING,
+        TOKEN_INT,
+        TOKEN_UINT,
+        TOKEN_DOUBLE,
+        TOKEN_BOOL,
+        TOKEN_NULL,
+        TOKEN_END,   ///< End of input after complete values
+        TOKEN_ERROR  ///< See GetLastError(); all further calls return TOKEN_ERROR
+    };
+
+    explicit bwxJsonReader(wxInputStream& stream, size_t bufferSize = 64 * 1024);
+
+    Token Next();
+
+    inline Token GetToken() const { return m_token; }
+
+    // Current key or string: raw UTF-8 contents and decoded text
+    inline std::string_view GetRawString() const { return m_text; }
+    std::string GetUtf8() const;
+    wxString GetString() const;
+
+    inline int64_t GetInt() const { return m_int; }
+    inline uint64_t GetUInt() const { return m_uint; }
+    double GetDouble() const;
+    inline bool GetBool() const { return m_bool; }
+
+    // Nesting level of the current token (1 inside the root container)
+    inline int GetDepth() const { return static_cast<int>(m_stack.size()); }
+
+    // Skip children of TOKEN_START_OBJECT/TOKEN_START_ARRAY (reader stops on the matching end token)
+    bool Skip();
+
+    // Materialize the current value with its children (strings raw, as bwxJSON::ParseFromUtf8 does)
+    bool ReadValue(bwxJsonValue& value);
+
+    inline bool IsOk() const { return m_token != TOKEN_ERROR; }
+    inline wxString GetLastError() const { return m_lastError; }
+
+    // Bytes consumed so far
+    inline uint64_t GetOffset() const { return m_offset + m_pos; }
+
+private:
+    int Peek();
+    bool SkipWhitespace();
+    Token Fail(const char* message);
+    Token ReadValueToken(int c);
+    bool ReadString();
+    Token ReadNumber();
+    bool ReadWord(const char* word);
+    void EndValue();
+
+    wxInputStream& m_stream;
+    std::vector<char> m_buffer;
+    size_t m_pos = 0;
+    size_t m_end = 0;
+    uint64_t m_offset = 0;  ///< Stream offset of m_buffer[0]
+    bool m_eof = false;
+
+    std::vector<char> m_stack;  ///< Open containers ('{' or '[')
+    bool m_needComma = false;   ///< Value completed in the current container
+    bool m_afterKey = false;    ///< Key read, member value expected
+
+    Token m_token = TOKEN_NONE;
+    std::string m_text;  ///< Raw string/key or number characters
+    int64_t m_int = 0;
+    uint64_t m_uint = 0;
+    double m_double = 0.0;
+    bool m_bool = false;
+    wxString m_lastError;
+};
+
+/**
+ * @brief Streaming JSON writer - output goes to a wxOutputStream through a fixed-size buffer.
+ *
+ * Commas and (with indent > 0) line breaks are inserted automatically. Several root values
+ * are separated with new lines (JSON Lines). The destructor flushes.
+ */
+class bwxJsonWriter {
+public:
+    explicit bwxJsonWriter(wxOutputStream& stream, int indent = 0, size_t bufferSize = 64 * 1024);
+    ~bwxJsonWriter();
+
+    bwxJsonWriter(const bwxJsonWriter&) = delete;
+    bwxJsonWriter& operator=(const bwxJsonWriter&) = delete;
+
+    void StartObject();
+    void EndObject();
+    void StartArray();
+    void EndArray();
+
+    // Keys and strings are escaped; Raw* variants write contents as given (already escaped)
+    void Key(std::string_view utf8);
+    void Key(const wxString& key);
+    void RawKey(std::string_view utf8);
+
+    void String(std::string_view utf8);
+    void String(const wxString& text);
+    void RawString(std::string_view utf8);
+
+    void Int(int64_t value);
+    void UInt(uint64_t value);
+    void Double(double value);
+    void Bool(bool value);
+    void Null();
+
+    // bwxJSON value or tree (strings written raw, as bwxJSON serializes them)
+    void Value(const bwxJsonValue& value);
+    void Value(const bwxJSON& object);
+
+    bool Flush();
+    inline bool IsOk() const { return m_ok; }
+
+private:
+    void BeforeValue();
+    void EndContainer(char close);
+    void NewLine();
+    void FlushIfFull();
+
+    wxOutputStream& m_stream;
+    std::string m_buffer;
+    size_t m_bufferSize;
+    int m_indent;
+
+    std::vector<bool> m_hasItems;  ///< Per open container: something written already
+    bool m_afterKey = false;
+    bool m_rootWritten = false;
+    bool m_ok = true;
+};
+
+}  // namespace bwx_sdk
+
+#endif
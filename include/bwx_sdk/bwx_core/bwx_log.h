@@ -0,0 +1,314 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_log.h
+// Purpose:     BWX_SDK Library; Asynchronous, rate-limited logging
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_LOG_H_
+#define _BWX_LOG_H_
+
+#include <wx/ffile.h>
+#include <wx/string.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace bwx_sdk {
+
+enum bwxLogLevel {
+    BWX_LOGLEVEL_TRACE = 0,
+    BWX_LOGLEVEL_DEBUG,
+    BWX_LOGLEVEL_INFO,
+    BWX_LOGLEVEL_WARNING,
+    BWX_LOGLEVEL_ERROR,
+    BWX_LOGLEVEL_NONE
+};
+
+enum bwxLogTarget {
+    BWX_LOG_TO_WXLOG = 1,  ///< wxLogGeneric() (wxLog queues messages of other threads itself)
+    BWX_LOG_TO_FILE = 2    ///< File given to bwxLogger::SetFile()
+};
+
+}  // namespace bwx_sdk
+
+// Calls below this level are removed at compile time (arguments are not evaluated either)
+#ifndef BWX_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define BWX_LOG_MIN_LEVEL ::bwx_sdk::BWX_LOGLEVEL_INFO
+#else
+#define BWX_LOG_MIN_LEVEL ::bwx_sdk::BWX_LOGLEVEL_TRACE
+#endif
+#endif
+
+namespace bwx_sdk {
+
+/**
+ * @brief State of one logging call site: level and rate limit (one static object per macro use).
+ */
+class bwxLogSite {
+public:
+    constexpr bwxLogSite(const char* file, int line, bwxLogLevel level, uint32_t maxPerSecond)
+        : m_file(file), m_line(line), m_level(level), m_maxPerSecond(maxPerSecond) {}
+
+    // False if the site exceeded its limit in the current second; suppressed = records dropped before this one
+    inline bool Allow(int64_t nowMs, uint32_t& suppressed) {
+        if (m_maxPerSecond == 0) return true;
+
+        int64_t start = m_windowStart.load(std::memory_order_relaxed);
+        if (nowMs - start >= 1000 && m_windowStart.compare_exchange_strong(start, nowMs, std::memory_order_relaxed))
+            m_count.store(0, std::memory_order_relaxed);
+
+        if (m_count.fetch_add(1, std::memory_order_relaxed) >= m_maxPerSecond) {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    inline const char* GetFile() const { return m_file; }
+    inline int GetLine() const { return m_line; }
+    inline bwxLogLevel GetLevel() const { return m_level; }
+
+private:
+    const char* m_file;
+    int m_line;
+    bwxLogLevel m_level;
+    uint32_t m_maxPerSecond;  ///< 0 = no limit
+    std::atomic<int64_t> m_windowStart{0};
+    std::atomic<uint32_t> m_count{0};
+    std::atomic<uint32_t> m_suppressed{0};
+};
+
+/**
+ * @brief How a log argument is kept until the background thread formats the record.
+ *
+ * Values are stored as they are; strings are copied (the caller's buffer may be gone by then).
+ */
+template <typename T, typename = void>
+struct bwxLogArg {
+    using Stored = T;
+    static inline const T& Store(const T& value) { return value; }
+};
+
+template <typename T>
+struct bwxLogArg<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using Stored = int;
+    static inline int Store(T value) { return static_cast<int>(value); }
+};
+
+template <>
+struct bwxLogArg<bool> {
+    using Stored = int;
+    static inline int Store(bool value) { return value ? 1 : 0; }
+};
+
+template <>
+struct bwxLogArg<const char*> {
+    using Stored = std::string;
+    static inline std::string Store(const char* value) { return value ? value : "(null)"; }
+};
+
+template <>
+struct bwxLogArg<char*> : bwxLogArg<const char*> {};
+
+template <size_t N>
+struct bwxLogArg<char[N]> : bwxLogArg<const char*> {};
+
+template <>
+struct bwxLogArg<std::string> {
+    using Stored = std::string;
+    static inline const std::string& Store(const std::string& value) { return value; }
+};
+
+template <>
+struct bwxLogArg<const wchar_t*> {
+    using Stored = std::wstring;
+    static inline std::wstring Store(const wchar_t* value) { return value ? value : L"(null)"; }
+};
+
+template <>
+struct bwxLogArg<wchar_t*> : bwxLogArg<const wchar_t*> {};
+
+template <size_t N>
+struct bwxLogArg<wchar_t[N]> : bwxLogArg<const wchar_t*> {};
+
+template <>
+struct bwxLogArg<wxString> {
+    using Stored = std::wstring;
+    static inline std::wstring Store(const wxString& value) { return value.ToStdWstring(); }
+};
+
+/**
+ * @brief Logger that formats and writes records on a background thread.
+ *
+ * A call checks the level (compile time, then one atomic load) and the rate limit of its site,
+ * copies the format pointer and the arguments into a slot of a bounded lock-free MPSC ring and
+ * returns; it never waits. The writer thread formats the records with wxString::Format() and
+ * writes them in batches. When the ring is full the record is dropped and counted.
+ *
+ * Use the BWX_LOG_* macros; the format must be a string literal (it is formatted later).
+ */
+class bwxLogger {
+public:
+    static bwxLogger& GetInstance();
+
+    bwxLogger(const bwxLogger&) = delete;
+    bwxLogger& operator=(const bwxLogger&) = delete;
+
+    inline bool IsEnabled(bwxLogLevel level) const { return level >= m_level.load(std::memory_order_relaxed); }
+
+    inline void SetLevel(bwxLogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+    inline bwxLogLevel GetLevel() const { return static_cast<bwxLogLevel>(m_level.load(std::memory_order_relaxed)); }
+
+    void SetTargets(int targets);  ///< bwxLogTarget flags, BWX_LOG_TO_WXLOG by default
+    bool SetFile(const wxString& filename);  ///< Appends; also enables BWX_LOG_TO_FILE
+
+    void Flush();  ///< Waits until the records logged so far are written
+
+    inline uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    template <typename... Args>
+    void Write(bwxLogSite& site, const char* format, const Args&... args);
+
+private:
+    static constexpr size_t CAPACITY = 4096;  ///< Power of 2
+    static constexpr size_t PAYLOAD_SIZE = 160;
+
+    using FormatFunc = void (*)(const char* format, void* payload, wxString& out);
+    using DestroyFunc = void (*)(void* payload);
+
+    struct Record {
+        bwxLogSite* site;
+        int64_t time;  ///< ms since the epoch
+        uint32_t suppressed;
+        const char* format;
+        FormatFunc formatPayload;
+        DestroyFunc destroyPayload;
+        alignas(std::max_align_t) unsigned char payload[PAYLOAD_SIZE];
+    };
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    template <typename T>
+    static inline const T& Pass(const T& value) { return value; }
+    static inline const char* Pass(const std::string& value) { return value.c_str(); }
+    static inline const wchar_t* Pass(const std::wstring& value) { return value.c_str(); }
+
+    template <typename Payload>
+    static void FormatPayload(const char* format, void* payload, wxString& out) {
+        std::apply([&](const auto&... values) { out = wxString::Format(format, Pass(values)...); }, *static_cast<Payload*>(payload));
+    }
+
+    template <typename Payload>
+    static void DestroyPayload(void* payload) {
+        static_cast<Payload*>(payload)->~Payload();
+    }
+
+    bwxLogger();
+    ~bwxLogger();
+
+    static int64_t Now();
+
+    Record* Claim(size_t& position);
+    void Publish(size_t position);
+
+    void WriterLoop();
+    bool Drain();
+    void WriteRecord(Record& record, std::string& fileBatch);
+    void WriteMessage(bwxLogLevel level, int64_t time, const char* file, int line, const wxString& message, std::string& fileBatch);
+
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<size_t> m_enqueue{0};
+    alignas(64) size_t m_dequeue = 0;  ///< Writer thread only
+    uint64_t m_reportedDropped = 0;    ///< Writer thread only
+    std::atomic<size_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<int> m_level{BWX_LOG_MIN_LEVEL};
+
+    std::mutex m_targetMutex;
+    int m_targets = BWX_LOG_TO_WXLOG;
+    wxFFile m_file;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    bool m_running = true;
+    std::thread m_writer;
+};
+
+template <typename... Args>
+void bwxLogger::Write(bwxLogSite& site, const char* format, const Args&... args) {
+    const int64_t now = Now();
+    uint32_t suppressed = 0;
+    if (!site.Allow(now, suppressed)) return;
+
+    size_t position = 0;
+    Record* record = Claim(position);
+    if (!record) return;
+
+    record->site = &site;
+    record->time = now;
+    record->suppressed = suppressed;
+
+    using Payload = std::tuple<typename bwxLogArg<std::remove_cv_t<Args>>::Stored...>;
+    if constexpr (sizeof(Payload) <= PAYLOAD_SIZE && alignof(Payload) <= alignof(std::max_align_t)) {
+        ::new (static_cast<void*>(record->payload)) Payload(bwxLogArg<std::remove_cv_t<Args>>::Store(args)...);
+        record->format = format;
+        record->formatPayload = &FormatPayload<Payload>;
+        record->destroyPayload = &DestroyPayload<Payload>;
+    } else {
+        // Too many arguments for a slot - formatted here
+        using Text = std::tuple<std::wstring>;
+        ::new (static_cast<void*>(record->payload)) Text(wxString::Format(format, args...).ToStdWstring());
+        record->format = "%s";
+        record->formatPayload = &FormatPayload<Text>;
+        record->destroyPayload = &DestroyPayload<Text>;
+    }
+
+    Publish(position);
+}
+
+}  // namespace bwx_sdk
+
+#define BWX_LOG_LIMITED(level, maxPerSecond, ...)                                                        \
+    do {                                                                                                 \
+        if constexpr (static_cast<int>(level) >= static_cast<int>(BWX_LOG_MIN_LEVEL)) {                 \
+            static ::bwx_sdk::bwxLogSite bwxLogSite_(__FILE__, __LINE__, level, maxPerSecond);           \
+            ::bwx_sdk::bwxLogger& bwxLogger_ = ::bwx_sdk::bwxLogger::GetInstance();                      \
+            if (bwxLogger_.IsEnabled(level)) bwxLogger_.Write(bwxLogSite_, __VA_ARGS__);                 \
+        }                                                                                                \
+    } while (0)
+
+#define BWX_LOG(level, ...) BWX_LOG_LIMITED(level, 0, __VA_ARGS__)
+
+#define BWX_LOG_TRACE(...) BWX_LOG(::bwx_sdk::BWX_LOGLEVEL_TRACE, __VA_ARGS__)
+#define BWX_LOG_DEBUG(...) BWX_LOG(::bwx_sdk::BWX_LOGLEVEL_DEBUG, __VA_ARGS__)
+#define BWX_LOG_INFO(...) BWX_LOG(::bwx_sdk::BWX_LOGLEVEL_INFO, __VA_ARGS__)
+#define BWX_LOG_WARNING(...) BWX_LOG(::bwx_sdk::BWX_LOGLEVEL_WARNING, __VA_ARGS__)
+#define BWX_LOG_ERROR(...) BWX_LOG(::bwx_sdk::BWX_LOGLEVEL_ERROR, __VA_ARGS__)
+
+#endif
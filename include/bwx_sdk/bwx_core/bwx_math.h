@@ -19,8 +19,11 @@
 
 #include <math.h>
 
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <limits>
+#include <span>
 #include <type_traits>
 
 #include "bwx_sdk/bwx_globals.h"
@@ -53,23 +56,182 @@ int bwxNextPower2(int x);
 
 unsigned int bwxRoundUpToPower2(unsigned int x);
 
-template <typename T>
-T bwxRand(T min, T max) {
-    static_assert(std::is_arithmetic<T>::value, "bwxRand requires a numeric type.");
+/**
+ * @brief SplitMix64 - expands one 64-bit seed into well mixed values (seeds of the other generators).
+ */
+class bwxSplitMix64 {
+public:
+    using result_type = uint64_t;
+
+    constexpr explicit bwxSplitMix64(uint64_t seed = 0) : m_state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    constexpr result_type operator()() {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+/**
+ * @brief xoshiro256** - fast 64-bit generator with 2^256 period; the default generator of the SDK.
+ *
+ * Not thread-safe by design: use one instance per thread (bwxGetThreadRandom()).
+ */
+class bwxXoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    constexpr explicit bwxXoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    constexpr void Seed(uint64_t seed) {
+        bwxSplitMix64 mix(seed);
+        for (uint64_t& word : m_state) word = mix();
+    }
+
+    constexpr result_type operator()() {
+        const uint64_t result = Rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = Rotl(m_state[3], 45);
+        return result;
+    }
+
+    // Advances by 2^128 draws - gives non-overlapping streams for parallel work
+    void Jump();
+
+private:
+    static constexpr uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t m_state[4] = {};
+};
+
+/**
+ * @brief PCG32 (XSH RR) - small-state 32-bit generator with selectable streams.
+ */
+class bwxPcg32 {
+public:
+    using result_type = uint32_t;
+
+    constexpr explicit bwxPcg32(uint64_t seed = 0, uint64_t stream = 0) { Seed(seed, stream); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    constexpr void Seed(uint64_t seed, uint64_t stream = 0) {
+        m_increment = (stream << 1) | 1;
+        m_state = 0;
+        (*this)();
+        m_state += seed;
+        (*this)();
+    }
 
-    static bool initialized = false;
-    if (!initialized) {
-        std::srand(static_cast<unsigned int>(std::time(0)));
-        initialized = true;
+    constexpr result_type operator()() {
+        const uint64_t old = m_state;
+        m_state = old * 6364136223846793005ULL + m_increment;
+        const uint32_t shifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (shifted >> rotation) | (shifted << ((0u - rotation) & 31));
     }
 
-    if (std::is_integral<T>::value) {
-        return min + std::rand() % ((max - min) + 1);
+private:
+    uint64_t m_state = 0;
+    uint64_t m_increment = 1;
+};
+
+using bwxRandomGenerator = bwxXoshiro256;
+
+// Generator of the calling thread, seeded on first use from the global seed and a per-thread stream number
+bwxRandomGenerator& bwxGetThreadRandom();
+
+// New global seed: the calling thread restarts at stream 0, other threads reseed on their next draw
+void bwxSetRandomSeed(uint64_t seed);
+
+// Seeds only the calling thread (e.g. with a job index) - reproducible regardless of thread scheduling
+void bwxSetThreadRandomSeed(uint64_t seed);
+
+// 64 x 64 -> 128-bit product: returns the low word, high word in high
+inline uint64_t bwxMulWide(uint64_t a, uint64_t b, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#else
+    const uint64_t aLow = a & 0xffffffffULL, aHigh = a >> 32;
+    const uint64_t bLow = b & 0xffffffffULL, bHigh = b >> 32;
+    const uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    const uint64_t middle = (ll >> 32) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+    return (middle << 32) | (ll & 0xffffffffULL);
+#endif
+}
+
+/**
+ * @brief Uniform value from min to max (inclusive for integers, max excluded for floating point).
+ *
+ * Integers use the multiply-and-reject method (no modulo bias), floating point values the top
+ * mantissa bits of one draw.
+ */
+template <typename T, typename Generator>
+T bwxUniform(Generator& generator, T min, T max) {
+    static_assert(std::is_arithmetic<T>::value, "bwxUniform requires a numeric type.");
+    static_assert(sizeof(typename Generator::result_type) == 8, "bwxUniform requires a 64-bit generator.");
+
+    if constexpr (std::is_floating_point<T>::value) {
+        if constexpr (sizeof(T) <= sizeof(float)) {
+            const float unit = static_cast<float>(generator() >> 40) * 0x1.0p-24f;
+            return min + static_cast<T>(unit) * (max - min);
+        } else {
+            const double unit = static_cast<double>(generator() >> 11) * 0x1.0p-53;
+            return min + static_cast<T>(unit) * (max - min);
+        }
     } else {
-        return min + static_cast<T>(std::rand()) / (static_cast<T>(RAND_MAX / (max - min)));
+        using U = std::make_unsigned_t<T>;
+        if (max <= min) return min;
+
+        const uint64_t range = static_cast<uint64_t>(static_cast<U>(max) - static_cast<U>(min)) + 1;  // 0 = whole 64-bit range
+        if (range == 0) return static_cast<T>(generator());
+
+        // Lemire: high word of x * range, rejecting the few x of the incomplete last interval
+        uint64_t x = generator();
+        uint64_t high = 0;
+        uint64_t low = bwxMulWide(x, range, high);
+        if (low < range) {
+            const uint64_t threshold = (0 - range) % range;
+            while (low < threshold) {
+                x = generator();
+                low = bwxMulWide(x, range, high);
+            }
+        }
+        return static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(high)));
     }
 }
 
+template <typename T>
+T bwxRand(T min, T max) {
+    static_assert(std::is_arithmetic<T>::value, "bwxRand requires a numeric type.");
+    return bwxUniform<T>(bwxGetThreadRandom(), min, max);
+}
+
+// Bulk bwxRand() from the thread generator, several independent lanes per step (vectorizable)
+void bwxFillRandom(std::span<int> values, int min, int max);
+void bwxFillRandom(std::span<unsigned int> values, unsigned int min, unsigned int max);
+void bwxFillRandom(std::span<float> values, float min, float max);
+void bwxFillRandom(std::span<double> values, double min, double max);
+
 /*
 template <typename T>
 T bwxRandom(T minVal, T maxVal)
@@ -121,6 +283,23 @@ constexpr T bwxNormalize(T x, T minVal, T maxVal) {
     return (x - minVal) / (maxVal - minVal);
 }
 
+// Batch kernels over float spans (AVX2, SSE2 or NEON, chosen at run time; scalar elsewhere).
+// They process as many values as the shortest span holds; out may be the same span as an input.
+// Accuracy against the scalar std:: versions:
+//  - bwxSqrt, bwxDistance2D, bwxLerp, bwxClamp: identical (IEEE square root, same operation order)
+//  - bwxRsqrt: estimate + Newton step, relative error below 5e-7 of 1 / std::sqrt (0 -> inf, inf -> 0)
+//  - bwxNormalize, bwxRemap: multiply by a precomputed reciprocal, within 2 ulp of the division
+void bwxSqrt(std::span<const float> values, std::span<float> out);
+void bwxRsqrt(std::span<const float> values, std::span<float> out);
+void bwxDistance2D(std::span<const float> x1, std::span<const float> y1, std::span<const float> x2,
+                   std::span<const float> y2, std::span<float> out);
+void bwxLerp(std::span<const float> a, std::span<const float> b, float t, std::span<float> out);
+void bwxClamp(std::span<const float> values, float minVal, float maxVal, std::span<float> out);
+void bwxNormalize(std::span<const float> values, float minVal, float maxVal, std::span<float> out);
+void bwxRemap(std::span<const float> values, float inMin, float inMax, float outMin, float outMax, std::span<float> out);
+
+const char* bwxGetSimdLevel();  ///< "AVX2", "SSE2", "NEON" or "scalar"
+
 }  // namespace math
 }  // namespace bwx_sdk
 
@@ -0,0 +1,194 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_metrics.h
+// Purpose:     BWX_SDK Library; Runtime metrics: counters, gauges and histograms
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_METRICS_H_
+#define _BWX_METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bwx_json.h"
+
+#define BWX_METRIC_HISTOGRAM_BUCKETS 40
+#define BWX_METRIC_HISTOGRAM_MIN_EXP -10  // Upper bound of the first bucket is 2^-10 (~1 us for milliseconds)
+
+namespace bwx_sdk {
+
+enum bwxMetricType { BWX_METRIC_COUNTER = 0, BWX_METRIC_GAUGE, BWX_METRIC_HISTOGRAM };
+
+/**
+ * @brief Monotonic count (hits, misses, loads). Relaxed atomics, any thread.
+ */
+class bwxMetricCounter {
+public:
+    inline void Add(uint64_t count = 1) { m_value.fetch_add(count, std::memory_order_relaxed); }
+    inline uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+    inline void Reset() { m_value.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+/**
+ * @brief Current level (bytes held, resources alive). Relaxed atomics, any thread.
+ */
+class bwxMetricGauge {
+public:
+    inline void Set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    inline void Add(int64_t delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    inline int64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * @brief Distribution of positive values (durations in ms, sizes) in power-of-two buckets.
+ *
+ * Record() is a handful of relaxed atomic operations, no lock; percentiles are estimated from
+ * the buckets, so they are exact to within a factor of two and clamped to the observed min/max.
+ */
+class bwxMetricHistogram {
+public:
+    void Record(double value);
+
+    inline uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+    inline double GetSum() const { return m_sum.load(std::memory_order_relaxed); }
+    double GetMin() const;
+    double GetMax() const;
+    double GetPercentile(double fraction) const;  ///< fraction in [0, 1]; 0 without samples
+
+    void Reset();
+
+private:
+    std::array<std::atomic<uint64_t>, BWX_METRIC_HISTOGRAM_BUCKETS> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<double> m_sum{0.0};
+    std::atomic<double> m_min{std::numeric_limits<double>::infinity()};
+    std::atomic<double> m_max{0.0};
+};
+
+// Values of one metric at GetSnapshot() time
+struct bwxMetricSnapshot {
+    std::string name;
+    bwxMetricType type = BWX_METRIC_COUNTER;
+    int64_t value = 0;  ///< Counter or gauge
+    uint64_t count = 0;  ///< Histogram samples
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+};
+
+/**
+ * @brief Process-wide metrics by name.
+ *
+ * Registration takes a lock and returns a reference that stays valid for the life of the
+ * process; keep it (the BWX_METRIC_* macros keep one per call site) and updates never lock.
+ * Names are dotted paths, e.g. "gl.textures.vram_bytes"; a name is unique per metric type.
+ *
+ * @code
+ * BWX_METRIC_COUNTER("gl.textures.misses").Add();
+ * BWX_METRIC_GAUGE("gl.buffers.vram_bytes").Add(size);
+ * {
+ *     BWX_METRIC_SCOPE_TIME("core.json.parse_ms");
+ *     json.ParseFromUtf8(text);
+ * }
+ * bwxMetrics::GetInstance().ToJSON().SaveToFile("metrics.json");
+ * @endcode
+ */
+class bwxMetrics {
+public:
+    static bwxMetrics& GetInstance();
+
+    bwxMetrics(const bwxMetrics&) = delete;
+    bwxMetrics& operator=(const bwxMetrics&) = delete;
+
+    bwxMetricCounter& GetCounter(const std::string& name);
+    bwxMetricGauge& GetGauge(const std::string& name);
+    bwxMetricHistogram& GetHistogram(const std::string& name);
+
+    // Sorted by name; values are read one by one, so metrics changing meanwhile may be from slightly different moments
+    std::vector<bwxMetricSnapshot> GetSnapshot() const;
+
+    // { "counters": { name: value }, "gauges": { name: value }, "histograms": { name: { count, sum, min, max, mean, p50, p95, p99 } } }
+    bwxJSON ToJSON() const;
+
+    // Counters and histograms back to zero; gauges keep their level
+    void Reset();
+
+private:
+    bwxMetrics() = default;
+
+    mutable std::mutex m_mutex;  ///< Guards the maps only, never the values
+    std::map<std::string, std::unique_ptr<bwxMetricCounter>> m_counters;
+    std::map<std::string, std::unique_ptr<bwxMetricGauge>> m_gauges;
+    std::map<std::string, std::unique_ptr<bwxMetricHistogram>> m_histograms;
+};
+
+/**
+ * @brief Records the milliseconds between construction and destruction into a histogram.
+ */
+class bwxMetricTimer {
+public:
+    explicit bwxMetricTimer(bwxMetricHistogram& histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~bwxMetricTimer() {
+        m_histogram.Record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    bwxMetricTimer(const bwxMetricTimer&) = delete;
+    bwxMetricTimer& operator=(const bwxMetricTimer&) = delete;
+
+private:
+    bwxMetricHistogram& m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace bwx_sdk
+
+// Handle registered on the first pass through the call site, a static reference afterwards; name must not change
+#define BWX_METRIC_COUNTER(name)                                                                        \
+    ([]() -> ::bwx_sdk::bwxMetricCounter& {                                                             \
+        static ::bwx_sdk::bwxMetricCounter& bwxMetric = ::bwx_sdk::bwxMetrics::GetInstance().GetCounter(name); \
+        return bwxMetric;                                                                               \
+    }())
+#define BWX_METRIC_GAUGE(name)                                                                        \
+    ([]() -> ::bwx_sdk::bwxMetricGauge& {                                                             \
+        static ::bwx_sdk::bwxMetricGauge& bwxMetric = ::bwx_sdk::bwxMetrics::GetInstance().GetGauge(name); \
+        return bwxMetric;                                                                             \
+    }())
+#define BWX_METRIC_HISTOGRAM(name)                                                                        \
+    ([]() -> ::bwx_sdk::bwxMetricHistogram& {                                                             \
+        static ::bwx_sdk::bwxMetricHistogram& bwxMetric = ::bwx_sdk::bwxMetrics::GetInstance().GetHistogram(name); \
+        return bwxMetric;                                                                                 \
+    }())
+
+#define BWX_METRIC_CONCAT_INNER(a, b) a##b
+#define BWX_METRIC_CONCAT(a, b) BWX_METRIC_CONCAT_INNER(a, b)
+#define BWX_METRIC_SCOPE_TIME(name) ::bwx_sdk::bwxMetricTimer BWX_METRIC_CONCAT(bwxMetricTimer_, __LINE__)(BWX_METRIC_HISTOGRAM(name))
+
+#endif  // _BWX_METRICS_H_
@@ -12,10 +12,13 @@
 #define _BWXOOP_H_
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
@@ -38,29 +41,329 @@ wxDECLARE_EVENT(EVT_BWXPROPERTY_MAP_CHANGED, wxCommandEvent);
 
 namespace bwx_sdk {
 
+	/**
+	 * @brief Range of changed vector indices [first, last).
+	 *
+	 * After removals the range may extend past the current size of the vector.
+	 */
+	struct bwxPropertyRange {
+		size_t first = 0;   ///< First changed index.
+		size_t last = 0;    ///< One past the last changed index.
+	};
+
+	/**
+	 * @brief Changed keys of a map property.
+	 * @tparam K Type of the keys.
+	 */
+	template <typename K>
+	struct bwxPropertyKeys {
+		std::vector<K> keys;    ///< Sorted, unique changed keys (empty if all is set).
+		bool all = false;       ///< True if the whole map was replaced (clear, undo, redo).
+	};
+
+	/**
+	 * @brief Property change event carrying the changed part of the property.
+	 *
+	 * Posted with the EVT_BWXPROPERTY_VECTOR_CHANGED (bwxPropertyRange) and
+	 * EVT_BWXPROPERTY_MAP_CHANGED (bwxPropertyKeys) types, so existing wxCommandEvent
+	 * handlers keep working. Use Get() in a handler to read the change.
+	 *
+	 * @tparam Change Type of the change description.
+	 */
+	template <typename Change>
+	class bwxPropertyChangeEvent : public wxCommandEvent {
+	public:
+		/**
+		 * @brief Constructs the event.
+		 * @param type Event type.
+		 * @param change Changed part of the property.
+		 */
+		bwxPropertyChangeEvent(wxEventType type, Change change)
+			: wxCommandEvent(type), m_change(std::move(change)) {}
+
+		/**
+		 * @brief Retrieves the change.
+		 * @return Constant reference to the change description.
+		 */
+		const Change& GetChange() const { return m_change; }
+
+		wxEvent* Clone() const override { return new bwxPropertyChangeEvent(*this); }
+
+		/**
+		 * @brief Retrieves the change carried by an event.
+		 * @param evt Event received by a handler.
+		 * @return Pointer to the change or nullptr if the event carries no such change.
+		 */
+		static const Change* Get(const wxEvent& evt) {
+			auto* changeEvt = dynamic_cast<const bwxPropertyChangeEvent*>(&evt);
+			return changeEvt ? &changeEvt->m_change : nullptr;
+		}
+
+	private:
+		Change m_change;    ///< Changed part of the property.
+	};
+
+	//-----------------------------------------------------------------------------------
+
+	/**
+	 * @brief Base class of properties whose notifications can be deferred by bwxPropertyBatch.
+	 */
+	class bwxPropertyNotifier {
+	public:
+		bwxPropertyNotifier() = default;
+		bwxPropertyNotifier(const bwxPropertyNotifier&) = delete;
+		bwxPropertyNotifier& operator=(const bwxPropertyNotifier&) = delete;
+
+		/**
+		 * @brief Drops a pending notification of the property.
+		 *
+		 * A property changed inside a batch must be destroyed on the thread owning the batch.
+		 */
+		virtual ~bwxPropertyNotifier() {
+			if (!m_batchPending) return;
+			auto& pending = batchState().pending;
+			std::replace(pending.begin(), pending.end(), this, static_cast<bwxPropertyNotifier*>(nullptr));
+		}
+
+	protected:
+		/**
+		 * @brief Defers the notification if a batch is open on the calling thread.
+		 * @return True if deferred - flushNotify() is called when the outermost batch ends.
+		 */
+		bool deferNotify() {
+			BatchState& state = batchState();
+			if (state.depth == 0) return false;
+			if (!m_batchPending.exchange(true)) state.pending.push_back(this);
+			return true;
+		}
+
+		/** @brief Sends the notification collected during a batch. */
+		virtual void flushNotify() = 0;
+
+	private:
+		friend class bwxPropertyBatch;
+
+		/** @brief Open batches and properties waiting for their notification (per thread). */
+		struct BatchState {
+			int depth = 0;
+			std::vector<bwxPropertyNotifier*> pending;
+		};
+
+		static BatchState& batchState() {
+			thread_local BatchState state;
+			return state;
+		}
+
+		std::atomic<bool> m_batchPending{ false };   ///< Registered in an open batch.
+	};
+
+	/**
+	 * @brief Scope deferring property change notifications on the current thread.
+	 *
+	 * While a batch is open, bwxProperty, bwxPropertyVector and bwxPropertyMap collect their
+	 * changes instead of notifying. When the outermost batch ends, every changed property posts
+	 * one coalesced event (with the changed range or keys) and calls its change callback once.
+	 * Bound properties are still updated immediately; a container records one undo step per batch.
+	 *
+	 * @code
+	 * {
+	 *     bwxPropertyBatch batch;
+	 *     for (const auto& item : items) vector.add(item);
+	 * }   // one EVT_BWXPROPERTY_VECTOR_CHANGED
+	 * @endcode
+	 */
+	class bwxPropertyBatch {
+	public:
+		bwxPropertyBatch() { bwxPropertyNotifier::batchState().depth++; }
+		bwxPropertyBatch(const bwxPropertyBatch&) = delete;
+		bwxPropertyBatch& operator=(const bwxPropertyBatch&) = delete;
+
+		/** @brief Ends the batch; the outermost one sends the collected notifications. */
+		~bwxPropertyBatch() {
+			auto& state = bwxPropertyNotifier::batchState();
+			if (state.depth > 1) {
+				state.depth--;
+				return;
+			}
+
+			// Changes made by notified code are appended and sent in the same pass
+			for (size_t i = 0; i < state.pending.size(); ++i) {
+				bwxPropertyNotifier* notifier = state.pending[i];
+				if (!notifier) continue;
+				state.pending[i] = nullptr;
+				notifier->m_batchPending = false;
+				notifier->flushNotify();
+			}
+			state.pending.clear();
+			state.depth--;
+		}
+
+		/**
+		 * @brief Checks if a batch is open on the current thread.
+		 * @return True if notifications are deferred.
+		 */
+		static bool IsActive() { return bwxPropertyNotifier::batchState().depth > 0; }
+	};
+
+	//-----------------------------------------------------------------------------------
+
+	/**
+	 * @brief Fixed-capacity undo/redo history with the newest entry at the front.
+	 *
+	 * Storage is allocated when the capacity is set; pushing onto a full ring overwrites
+	 * the oldest entry, so pushes and pops do not allocate.
+	 *
+	 * @tparam Entry Type of the history entries (default-constructible).
+	 */
+	template <typename Entry>
+	class bwxHistoryRing {
+	public:
+		/**
+		 * @brief Changes the capacity, keeping the newest entries.
+		 * @param capacity Maximum number of entries (0 disables the history).
+		 */
+		void setCapacity(size_t capacity) {
+			const size_t keep = std::min(m_size, capacity);
+			std::vector<Entry> items(capacity);
+			for (size_t i = 0; i < keep; ++i) {
+				items[keep - 1 - i] = std::move(at(i));
+			}
+			m_items.swap(items);
+			m_size = keep;
+			m_head = capacity ? keep % capacity : 0;
+		}
+
+		/**
+		 * @brief Adds the newest entry, dropping the oldest one if the ring is full.
+		 * @param entry Entry to add.
+		 */
+		void push_front(Entry entry) {
+			if (m_items.empty()) return;
+			m_items[m_head] = std::move(entry);
+			m_head = (m_head + 1) % m_items.size();
+			if (m_size < m_items.size()) m_size++;
+		}
+
+		/** @brief Retrieves the newest entry (the ring must not be empty). */
+		Entry& front() { return at(0); }
+
+		/** @brief Removes the newest entry (the ring must not be empty). */
+		void pop_front() {
+			m_head = (m_head + m_items.size() - 1) % m_items.size();
+			m_items[m_head] = Entry();
+			m_size--;
+		}
+
+		/** @brief Removes all entries (capacity is kept). */
+		void clear() {
+			for (size_t i = 0; i < m_size; ++i) {
+				at(i) = Entry();
+			}
+			m_size = 0;
+		}
+
+		bool empty() const noexcept { return m_size == 0; }
+		size_t size() const noexcept { return m_size; }
+		size_t capacity() const noexcept { return m_items.size(); }
+
+	private:
+		/** @brief Retrieves the index-th newest entry. */
+		Entry& at(size_t index) { return m_items[(m_head + m_items.size() - 1 - index) % m_items.size()]; }
+
+		std::vector<Entry> m_items;     ///< Entries in chronological order, starting anywhere.
+		size_t m_head = 0;              ///< Slot of the next entry.
+		size_t m_size = 0;              ///< Number of stored entries.
+	};
+
+	/**
+	 * @brief Describes how bwxProperty stores its history - the default keeps whole values.
+	 *
+	 * A specialization provides Entry, Record() (entry turning newValue back into oldValue)
+	 * and Exchange() (applies the entry to the value and turns it into its inverse), so one
+	 * entry serves both undo and redo.
+	 *
+	 * @tparam T Type of the property value.
+	 */
+	template <typename T>
+	struct bwxPropertyHistoryTraits {
+		using Entry = T;
+
+		static Entry Record(const T& oldValue, const T&) { return oldValue; }
+		static void Exchange(T& value, Entry& entry) { std::swap(value, entry); }
+	};
+
+	/**
+	 * @brief History traits for sequences storing only the changed middle part (delta).
+	 * @tparam S Sequence type (std::basic_string, std::vector).
+	 */
+	template <typename S>
+	struct bwxPropertySequenceHistoryTraits {
+		/** @brief Replace length items at position with items. */
+		struct Entry {
+			size_t position = 0;
+			size_t length = 0;
+			S items{};
+		};
+
+		static Entry Record(const S& oldValue, const S& newValue) {
+			const size_t common = std::min(oldValue.size(), newValue.size());
+			size_t prefix = 0;
+			while (prefix < common && oldValue[prefix] == newValue[prefix]) prefix++;
+			size_t suffix = 0;
+			while (suffix < common - prefix && oldValue[oldValue.size() - 1 - suffix] == newValue[newValue.size() - 1 - suffix]) suffix++;
+
+			return Entry{ prefix, newValue.size() - prefix - suffix,
+				S(oldValue.begin() + prefix, oldValue.end() - suffix) };
+		}
+
+		static void Exchange(S& value, Entry& entry) {
+			auto first = value.begin() + entry.position;
+			S removed(first, first + entry.length);
+			value.erase(first, first + entry.length);
+			value.insert(value.begin() + entry.position, entry.items.begin(), entry.items.end());
+			entry.length = entry.items.size();
+			entry.items = std::move(removed);
+		}
+	};
+
+	template <typename C, typename Traits, typename Alloc>
+	struct bwxPropertyHistoryTraits<std::basic_string<C, Traits, Alloc>>
+		: bwxPropertySequenceHistoryTraits<std::basic_string<C, Traits, Alloc>> {};
+
+	template <typename U, typename Alloc>
+	struct bwxPropertyHistoryTraits<std::vector<U, Alloc>>
+		: bwxPropertySequenceHistoryTraits<std::vector<U, Alloc>> {};
+
+	//-----------------------------------------------------------------------------------
+
 	/**
 	 * @brief Template class representing a property with advanced features.
 	 *
 	 * This class manages a single value with the following capabilities:
 	 * - Value validation with customizable validator.
 	 * - Change and rejection callbacks.
-	 * - Undo/redo functionality with configurable history limit.
+	 * - Undo/redo functionality with configurable history limit (fixed-capacity ring,
+	 *   deltas for strings and vectors - see bwxPropertyHistoryTraits).
 	 * - Read-only mode to prevent modifications.
 	 * - wxWidgets event notifications and callback handling.
 	 * - Timestamp tracking for the last modification.
-	 * - Property binding to synchronize values between properties.
+	 * - Property binding to synchronize values between properties (each property of the
+	 *   binding graph is updated once per change, cycles are allowed).
+	 * - Coalesced notifications inside bwxPropertyBatch.
 	 * - Arithmetic and comparison operators.
 	 * - Conversion of the value to C-style strings (for supported types).
 	 *
 	 * @tparam T Type of the value.
 	 */
 	template <typename T>
-	class bwxProperty {
+	class bwxProperty : public bwxPropertyNotifier {
 	public:
 		using Validator = std::function<bool(const T&)>;              ///< Validator function to validate new values.
 		using ChangeCallback = std::function<void(const T&, const T&)>; ///< Callback invoked when the value changes.
 		using RejectCallback = std::function<void(const T&)>;        ///< Callback invoked when a value is rejected.
 		using Timestamp = std::chrono::system_clock::time_point;     ///< Timestamp of the last modification.
+		using HistoryTraits = bwxPropertyHistoryTraits<T>;           ///< Storage of the undo/redo history.
+		using HistoryEntry = typename HistoryTraits::Entry;          ///< Undo/redo history entry.
 
 		/**
 		 * @brief Constructs a Property with optional parameters.
@@ -87,7 +390,10 @@ namespace bwx_sdk {
 				m_historyLimit(historyLimit),
 				m_undoTimeout(undoTimeout),
 				m_lastChangeTime(std::chrono::system_clock::now()),
-				m_eventHandler(eventHandler) {} 
+				m_eventHandler(eventHandler) {
+			m_undoHistory.setCapacity(historyLimit);
+			m_redoHistory.setCapacity(historyLimit);
+		}
 
 		/**
 		 * @brief Assigns a new value to the property.
@@ -104,25 +410,7 @@ namespace bwx_sdk {
 		 * @param newValue Value to set.
 		 */
 		void set(const T& newValue) {
-			wxMutexLocker lock(m_mutex);
-			if (m_readOnly) return;
-
-			if (m_validator && !m_validator(newValue)) {
-				if (m_onReject) m_onReject(newValue);
-				return;
-			}
-
-			if (newValue != m_value) {
-				recordHistory(m_value);
-				clearRedoHistory();
-				if (m_onChange) m_onChange(m_value, newValue);
-
-				m_value = newValue;
-				m_lastChangeTime = std::chrono::system_clock::now();
-
-				notifyChange();
-				propagateBinding(newValue);
-			}
+			if (assign(newValue)) propagateBinding(newValue);
 		}
 
 		/**
@@ -170,6 +458,9 @@ namespace bwx_sdk {
 
 		/**
 		 * @brief Assigns a callback for value changes.
+		 *
+		 * Inside a bwxPropertyBatch it runs once, when the batch ends, with the value from before
+		 * the first change and the final one (not at all if the value came back).
 		 * @param onChange Callback to set.
 		 */
 		void setOnChangeCallback(ChangeCallback onChange) {
@@ -209,21 +500,26 @@ namespace bwx_sdk {
 		 * @return True if successful, false otherwise.
 		 */
 		bool undo() {
-			wxMutexLocker lock(m_mutex);
-			if (m_undoHistory.empty()) return false;
+			T value;
+			{
+				wxMutexLocker lock(m_mutex);
+				if (m_undoHistory.empty()) return false;
+
+				auto now = std::chrono::system_clock::now();
+				if (m_undoTimeout && std::chrono::duration_cast<std::chrono::seconds>(now - m_lastChangeTime) > *m_undoTimeout) {
+					return false;
+				}
+
+				HistoryEntry entry = std::move(m_undoHistory.front());
+				m_undoHistory.pop_front();
+				HistoryTraits::Exchange(m_value, entry);
+				m_redoHistory.push_front(std::move(entry));
+				m_lastChangeTime = now;
 
-			auto now = std::chrono::system_clock::now();
-			if (m_undoTimeout && std::chrono::duration_cast<std::chrono::seconds>(now - m_lastChangeTime) > *m_undoTimeout) {
-				return false;
+				notifyChange();
+				value = m_value;
 			}
-
-			m_redoHistory.push_front(m_value);
-			m_value = m_undoHistory.front();
-			m_undoHistory.pop_front();
-			m_lastChangeTime = now;
-
-			notifyChange();
-			propagateBinding(m_value);
+			propagateBinding(value);
 			return true;
 		}
 
@@ -232,16 +528,21 @@ namespace bwx_sdk {
 		 * @return True if successful, false otherwise.
 		 */
 		bool redo() {
-			wxMutexLocker lock(m_mutex);
-			if (m_redoHistory.empty()) return false;
-
-			m_undoHistory.push_front(m_value);
-			m_value = m_redoHistory.front();
-			m_redoHistory.pop_front();
-			m_lastChangeTime = std::chrono::system_clock::now();
+			T value;
+			{
+				wxMutexLocker lock(m_mutex);
+				if (m_redoHistory.empty()) return false;
+
+				HistoryEntry entry = std::move(m_redoHistory.front());
+				m_redoHistory.pop_front();
+				HistoryTraits::Exchange(m_value, entry);
+				m_undoHistory.push_front(std::move(entry));
+				m_lastChangeTime = std::chrono::system_clock::now();
 
-			notifyChange();
-			propagateBinding(m_value);
+				notifyChange();
+				value = m_value;
+			}
+			propagateBinding(value);
 			return true;
 		}
 
@@ -252,8 +553,8 @@ namespace bwx_sdk {
 		void setHistoryLimit(size_t limit) {
 			wxMutexLocker lock(m_mutex);
 			m_historyLimit = limit;
-			trimHistory(m_undoHistory);
-			trimHistory(m_redoHistory);
+			m_undoHistory.setCapacity(limit);
+			m_redoHistory.setCapacity(limit);
 		}
 
 		/**
@@ -325,11 +626,46 @@ namespace bwx_sdk {
 		bool operator>=(const T& rhs) const { return m_value >= rhs; }
 
 	private:
-		/** @brief Records the current value into the undo history. */
-		void recordHistory(const T& oldValue) {
+		/**
+		 * @brief Validates and stores a new value without propagating it to bound properties.
+		 * @return True if the value changed.
+		 */
+		bool assign(const T& newValue) {
+			wxMutexLocker lock(m_mutex);
+			if (m_readOnly) return false;
+
+			if (m_validator && !m_validator(newValue)) {
+				if (m_onReject) m_onReject(newValue);
+				return false;
+			}
+
+			if (newValue != m_value) {
+				recordHistory(m_value, newValue);
+				clearRedoHistory();
+				if (bwxPropertyBatch::IsActive()) {
+					// Called from flushNotify() with the value the batch started from
+					if (!m_callbackPending) {
+						m_callbackOldValue = m_value;
+						m_callbackPending = true;
+					}
+				}
+				else if (m_onChange) {
+					m_onChange(m_value, newValue);
+				}
+
+				m_value = newValue;
+				m_lastChangeTime = std::chrono::system_clock::now();
+
+				notifyChange();
+				return true;
+			}
+			return false;
+		}
+
+		/** @brief Records the change into the undo history. */
+		void recordHistory(const T& oldValue, const T& newValue) {
 			if (m_historyLimit == 0) return;
-			m_undoHistory.push_front(oldValue);
-			trimHistory(m_undoHistory);
+			m_undoHistory.push_front(HistoryTraits::Record(oldValue, newValue));
 		}
 
 		/** @brief Clears the redo history. */
@@ -337,25 +673,62 @@ namespace bwx_sdk {
 			m_redoHistory.clear();
 		}
 
-		/** @brief Trims the history to respect the configured limit. */
-		void trimHistory(std::deque<T>& history) {
-			while (history.size() > m_historyLimit) {
-				history.pop_back();
-			}
+		/** @brief Notifies listeners through wxWidgets events (deferred inside a batch). */
+		void notifyChange() {
+			m_changePending = true;
+			if (!deferNotify()) sendChange();
 		}
 
-		/** @brief Notifies listeners through callbacks and wxWidgets events. */
-		void notifyChange() {
+		/** @brief Posts the event for the pending change. */
+		void sendChange() {
+			m_changePending = false;
 			if (m_eventHandler) {
 				wxCommandEvent evt(EVT_BWXPROPERTY_CHANGED);
 				m_eventHandler->AddPendingEvent(evt);
 			}
 		}
 
-		/** @brief Propagates value changes to bound properties. */
+		/** @brief Sends the change collected during a batch. */
+		void flushNotify() override {
+			wxMutexLocker lock(m_mutex);
+			if (m_callbackPending) {
+				m_callbackPending = false;
+				if (m_onChange && m_callbackOldValue != m_value) m_onChange(m_callbackOldValue, m_value);
+			}
+			if (m_changePending) sendChange();
+		}
+
+		/**
+		 * @brief Propagates the value through the binding graph (breadth-first, no recursion).
+		 *
+		 * Properties are marked with the epoch of the change, so each one is visited once even
+		 * in cycles; propagation stops at properties rejecting or already holding the value.
+		 */
 		void propagateBinding(const T& newValue) {
+			static std::atomic<uint64_t> lastEpoch{ 0 };
+			const uint64_t epoch = ++lastEpoch;
+			m_bindingEpoch = epoch;
+
+			// Reused per thread; nested changes (from callbacks) work on their own tail
+			thread_local std::vector<bwxProperty<T>*> queue;
+			struct QueueTail {
+				std::vector<bwxProperty<T>*>& queue;
+				size_t start;
+				~QueueTail() { queue.resize(start); }
+			} tail{ queue, queue.size() };
+
+			enqueueBound(queue, epoch);
+			for (size_t i = tail.start; i < queue.size(); ++i) {
+				bwxProperty<T>* prop = queue[i];
+				if (prop->assign(newValue)) prop->enqueueBound(queue, epoch);
+			}
+		}
+
+		/** @brief Adds bound properties not yet visited in the epoch to the queue. */
+		void enqueueBound(std::vector<bwxProperty<T>*>& queue, uint64_t epoch) {
+			wxMutexLocker lock(m_mutex);
 			for (auto* boundProp : m_boundProperties) {
-				if (boundProp) boundProp->set(newValue);
+				if (boundProp && boundProp->m_bindingEpoch.exchange(epoch) != epoch) queue.push_back(boundProp);
 			}
 		}
 
@@ -369,14 +742,434 @@ namespace bwx_sdk {
 		bool m_readOnly = false;                         ///< Read-only mode flag.
 		wxEvtHandler* m_eventHandler = nullptr;          ///< wxWidgets event handler.
 		Timestamp m_lastChangeTime;                      ///< Timestamp of the last modification.
-		std::deque<T> m_undoHistory;                     ///< Undo history.
-		std::deque<T> m_redoHistory;                     ///< Redo history.
+		bwxHistoryRing<HistoryEntry> m_undoHistory;      ///< Undo history.
+		bwxHistoryRing<HistoryEntry> m_redoHistory;      ///< Redo history.
 		std::vector<bwxProperty<T>*> m_boundProperties;     ///< Bound properties for synchronization.
+		std::atomic<uint64_t> m_bindingEpoch{ 0 };       ///< Last binding propagation that visited the property.
+		bool m_changePending = false;                    ///< Change waiting for its notification.
+		bool m_callbackPending = false;                  ///< m_onChange deferred by the open batch.
+		T m_callbackOldValue{};                          ///< Value before the first change of the batch.
 		mutable wxMutex m_mutex;                         ///< Mutex for thread safety.
 	};
 
 	//-----------------------------------------------------------------------------------
 
+	/**
+	 * @brief Non-owning, non-allocating reference to a callable (function_ref).
+	 *
+	 * Function pointers and captureless lambdas are stored by value. Other callables are
+	 * referenced and must outlive the bwxFunctionRef; temporaries of them are rejected at
+	 * compile time.
+	 *
+	 * @tparam Signature Function signature, e.g. bool(const int&).
+	 */
+	template <typename Signature>
+	class bwxFunctionRef;
+
+	template <typename R, typename... Args>
+	class bwxFunctionRef<R(Args...)> {
+	public:
+		bwxFunctionRef() noexcept = default;
+		bwxFunctionRef(std::nullptr_t) noexcept {}
+
+		/**
+		 * @brief Wraps a callable.
+		 * @param callable Function pointer, captureless lambda or a named callable object.
+		 */
+		template <typename F>
+			requires(!std::is_same_v<std::remove_cvref_t<F>, bwxFunctionRef> && std::is_invocable_r_v<R, F&, Args...>)
+		bwxFunctionRef(F&& callable) noexcept {
+			if constexpr (std::is_convertible_v<F, R (*)(Args...)>) {
+				m_target.function = static_cast<R (*)(Args...)>(callable);
+				m_call = [](const Target& target, Args... args) -> R { return target.function(std::forward<Args>(args)...); };
+			}
+			else {
+				static_assert(std::is_lvalue_reference_v<F>, "A temporary callable would dangle - pass a named object or a captureless lambda.");
+				m_target.object = const_cast<void*>(static_cast<const void*>(std::addressof(callable)));
+				m_call = [](const Target& target, Args... args) -> R {
+					return (*static_cast<std::remove_reference_t<F>*>(target.object))(std::forward<Args>(args)...);
+				};
+			}
+		}
+
+		R operator()(Args... args) const { return m_call(m_target, std::forward<Args>(args)...); }
+
+		explicit operator bool() const noexcept { return m_call != nullptr; }
+
+	private:
+		union Target {
+			void* object;
+			R (*function)(Args...);
+		};
+
+		Target m_target{};                                         ///< Referenced object or stored function.
+		R (*m_call)(const Target&, Args...) = nullptr;             ///< Type-erased invoker.
+	};
+
+	//-----------------------------------------------------------------------------------
+
+	/** @brief Concurrency policy: no synchronization (single thread). */
+	struct bwxPropertyNoLock {};
+
+	/** @brief Concurrency policy: value kept in a lock-free std::atomic<T>. */
+	struct bwxPropertyAtomic {};
+
+	/** @brief Concurrency policy: wxMutex around every access. */
+	struct bwxPropertyMutex {};
+
+	/** @brief History policy: no undo/redo (no history storage, no timestamps). */
+	struct bwxPropertyNoHistory {};
+
+	/** @brief History policy: undo/redo with a limit, timeout and change timestamp. */
+	struct bwxPropertyHistory {};
+
+	/**
+	 * @brief Lightweight property with compile-time concurrency and history policies.
+	 *
+	 * Alternative to bwxProperty for large numbers of model fields: nothing that is not
+	 * used is stored or executed. Callbacks are bwxFunctionRef (no allocation), the mutex
+	 * exists only with bwxPropertyMutex and the undo/redo storage only with bwxPropertyHistory.
+	 *
+	 * Callbacks, event notification and binding run after the new value is stored and
+	 * outside the lock, so bound properties may be bound both ways. With bwxPropertyAtomic
+	 * only the value and the read-only flag are atomic - configure callbacks and bindings
+	 * before sharing the property between threads.
+	 *
+	 * @tparam T Type of the value.
+	 * @tparam Concurrency bwxPropertyNoLock, bwxPropertyAtomic or bwxPropertyMutex.
+	 * @tparam History bwxPropertyNoHistory or bwxPropertyHistory.
+	 */
+	template <typename T, typename Concurrency = bwxPropertyNoLock, typename History = bwxPropertyNoHistory>
+	class bwxBasicProperty {
+		static constexpr bool IS_ATOMIC = std::is_same_v<Concurrency, bwxPropertyAtomic>;
+		static constexpr bool IS_LOCKED = std::is_same_v<Concurrency, bwxPropertyMutex>;
+		static constexpr bool HAS_HISTORY = std::is_same_v<History, bwxPropertyHistory>;
+
+		static_assert(IS_ATOMIC || IS_LOCKED || std::is_same_v<Concurrency, bwxPropertyNoLock>, "Unknown concurrency policy.");
+		static_assert(HAS_HISTORY || std::is_same_v<History, bwxPropertyNoHistory>, "Unknown history policy.");
+		static_assert(!IS_ATOMIC || !HAS_HISTORY, "History needs bwxPropertyNoLock or bwxPropertyMutex.");
+
+	public:
+		using Validator = bwxFunctionRef<bool(const T&)>;              ///< Validator function to validate new values.
+		using ChangeCallback = bwxFunctionRef<void(const T&, const T&)>; ///< Callback invoked after the value changes.
+		using RejectCallback = bwxFunctionRef<void(const T&)>;        ///< Callback invoked when a value is rejected.
+		using Timestamp = std::chrono::system_clock::time_point;      ///< Timestamp of the last modification.
+		using ValueType = std::conditional_t<IS_ATOMIC || IS_LOCKED, T, const T&>; ///< get() result (copy when shared).
+
+		/**
+		 * @brief Constructs a property.
+		 * @param defaultValue Initial value of the property.
+		 */
+		explicit bwxBasicProperty(const T& defaultValue = T())
+			: m_value(defaultValue), m_defaultValue(defaultValue) {
+			if constexpr (IS_ATOMIC) {
+				static_assert(std::is_trivially_copyable_v<T> && std::atomic<T>::is_always_lock_free,
+					"bwxPropertyAtomic needs a trivially copyable, lock-free type.");
+			}
+			if constexpr (HAS_HISTORY) m_history.lastChangeTime = std::chrono::system_clock::now();
+		}
+
+		bwxBasicProperty(const bwxBasicProperty&) = delete;
+		bwxBasicProperty& operator=(const bwxBasicProperty&) = delete;
+
+		/**
+		 * @brief Assigns a new value to the property.
+		 * @param newValue Value to assign.
+		 * @return Reference to the updated property.
+		 */
+		bwxBasicProperty& operator=(const T& newValue) {
+			set(newValue);
+			return *this;
+		}
+
+		/**
+		 * @brief Sets a new value for the property.
+		 * @param newValue Value to set.
+		 * @return True if the value changed.
+		 */
+		bool set(const T& newValue) {
+			if (isReadOnly()) return false;
+
+			if (m_validator && !m_validator(newValue)) {
+				if (m_onReject) m_onReject(newValue);
+				return false;
+			}
+
+			T oldValue;
+			if constexpr (IS_ATOMIC) {
+				oldValue = m_value.exchange(newValue, std::memory_order_acq_rel);
+				if (oldValue == newValue) return false;
+			}
+			else {
+				Guard lock(m_mutex);
+				if (newValue == m_value) return false;
+
+				oldValue = std::move(m_value);
+				m_value = newValue;
+				if constexpr (HAS_HISTORY) {
+					if (m_history.limit > 0) {
+						m_history.undo.push_front(oldValue);
+						trimHistory(m_history.undo);
+					}
+					m_history.redo.clear();
+					m_history.lastChangeTime = std::chrono::system_clock::now();
+				}
+			}
+
+			changed(oldValue, newValue);
+			return true;
+		}
+
+		/**
+		 * @brief Retrieves the current value.
+		 * @return Reference to the value (bwxPropertyNoLock) or its copy.
+		 */
+		[[nodiscard]] ValueType get() const noexcept(!IS_LOCKED) {
+			if constexpr (IS_ATOMIC) {
+				return m_value.load(std::memory_order_acquire);
+			}
+			else {
+				Guard lock(m_mutex);
+				return m_value;
+			}
+		}
+
+		/**
+		 * @brief Retrieves the default value.
+		 * @return Constant reference to the default value.
+		 */
+		[[nodiscard]] const T& getDefault() const noexcept { return m_defaultValue; }
+
+		/**
+		 * @brief Resets the value to its default.
+		 */
+		void reset() { set(m_defaultValue); }
+
+		/**
+		 * @brief Sets a new validator function.
+		 * @param validator Validator function to set.
+		 */
+		void setValidator(Validator validator) { m_validator = validator; }
+
+		/**
+		 * @brief Assigns a callback for value changes.
+		 * @param onChange Callback to set.
+		 */
+		void setOnChangeCallback(ChangeCallback onChange) { m_onChange = onChange; }
+
+		/**
+		 * @brief Assigns a callback for value rejections.
+		 * @param onReject Callback to set.
+		 */
+		void setOnRejectCallback(RejectCallback onReject) { m_onReject = onReject; }
+
+		/**
+		 * @brief Sets the wxWidgets handler notified with EVT_BWXPROPERTY_CHANGED.
+		 * @param eventHandler Handler or nullptr.
+		 */
+		void setEventHandler(wxEvtHandler* eventHandler) { m_eventHandler = eventHandler; }
+
+		/**
+		 * @brief Enables or disables read-only mode.
+		 * @param readOnly True to enable, false to disable.
+		 */
+		void setReadOnly(bool readOnly) {
+			if constexpr (IS_ATOMIC) {
+				m_readOnly.store(readOnly, std::memory_order_relaxed);
+			}
+			else {
+				Guard lock(m_mutex);
+				m_readOnly = readOnly;
+			}
+		}
+
+		/**
+		 * @brief Checks if the property is read-only.
+		 * @return True if read-only, false otherwise.
+		 */
+		[[nodiscard]] bool isReadOnly() const noexcept(!IS_LOCKED) {
+			if constexpr (IS_ATOMIC) {
+				return m_readOnly.load(std::memory_order_relaxed);
+			}
+			else {
+				Guard lock(m_mutex);
+				return m_readOnly;
+			}
+		}
+
+		/**
+		 * @brief Binds another property to synchronize value changes.
+		 * @param other Property to bind to.
+		 */
+		void bind(bwxBasicProperty& other) { m_boundProperties.push_back(&other); }
+
+		/**
+		 * @brief Undoes the last value change.
+		 * @return True if successful, false otherwise.
+		 */
+		bool undo() requires HAS_HISTORY {
+			T oldValue;
+			T newValue;
+			{
+				Guard lock(m_mutex);
+				if (m_history.undo.empty()) return false;
+
+				auto now = std::chrono::system_clock::now();
+				if (m_history.undoTimeout && std::chrono::duration_cast<std::chrono::seconds>(now - m_history.lastChangeTime) > *m_history.undoTimeout) {
+					return false;
+				}
+
+				oldValue = m_value;
+				m_history.redo.push_front(m_value);
+				m_value = std::move(m_history.undo.front());
+				m_history.undo.pop_front();
+				m_history.lastChangeTime = now;
+				newValue = m_value;
+			}
+
+			changed(oldValue, newValue);
+			return true;
+		}
+
+		/**
+		 * @brief Redoes the previously undone value change.
+		 * @return True if successful, false otherwise.
+		 */
+		bool redo() requires HAS_HISTORY {
+			T oldValue;
+			T newValue;
+			{
+				Guard lock(m_mutex);
+				if (m_history.redo.empty()) return false;
+
+				oldValue = m_value;
+				m_history.undo.push_front(m_value);
+				m_value = std::move(m_history.redo.front());
+				m_history.redo.pop_front();
+				m_history.lastChangeTime = std::chrono::system_clock::now();
+				newValue = m_value;
+			}
+
+			changed(oldValue, newValue);
+			return true;
+		}
+
+		/**
+		 * @brief Sets the history limit for undo/redo operations.
+		 * @param limit Number of history entries to retain (0 disables recording).
+		 */
+		void setHistoryLimit(size_t limit) requires HAS_HISTORY {
+			Guard lock(m_mutex);
+			m_history.limit = limit;
+			trimHistory(m_history.undo);
+			trimHistory(m_history.redo);
+		}
+
+		/**
+		 * @brief Retrieves the configured history limit.
+		 * @return History limit.
+		 */
+		[[nodiscard]] size_t getHistoryLimit() const requires HAS_HISTORY {
+			Guard lock(m_mutex);
+			return m_history.limit;
+		}
+
+		/**
+		 * @brief Clears the undo and redo histories.
+		 */
+		void clearHistory() requires HAS_HISTORY {
+			Guard lock(m_mutex);
+			m_history.undo.clear();
+			m_history.redo.clear();
+		}
+
+		/**
+		 * @brief Sets the timeout for undo operations.
+		 * @param timeout Timeout duration.
+		 */
+		void setUndoTimeout(std::chrono::seconds timeout) requires HAS_HISTORY {
+			Guard lock(m_mutex);
+			m_history.undoTimeout = timeout;
+		}
+
+		/**
+		 * @brief Retrieves the timestamp of the last change.
+		 * @return Last change timestamp.
+		 */
+		Timestamp getLastChangeTime() const requires HAS_HISTORY {
+			Guard lock(m_mutex);
+			return m_history.lastChangeTime;
+		}
+
+		// Arithmetic operators (read and write are separate steps, also with bwxPropertyAtomic)
+		bwxBasicProperty& operator+=(const T& rhs) { set(get() + rhs); return *this; }
+		bwxBasicProperty& operator-=(const T& rhs) { set(get() - rhs); return *this; }
+		bwxBasicProperty& operator*=(const T& rhs) { set(get() * rhs); return *this; }
+		bwxBasicProperty& operator/=(const T& rhs) { set(get() / rhs); return *this; }
+
+		// Comparison operators
+		bool operator==(const T& rhs) const { return get() == rhs; }
+		bool operator!=(const T& rhs) const { return get() != rhs; }
+		bool operator<(const T& rhs) const { return get() < rhs; }
+		bool operator<=(const T& rhs) const { return get() <= rhs; }
+		bool operator>(const T& rhs) const { return get() > rhs; }
+		bool operator>=(const T& rhs) const { return get() >= rhs; }
+
+	private:
+		/** @brief Placeholder for storage a policy does not need. */
+		struct Empty {};
+
+		/** @brief Lock stand-in for policies without a mutex. */
+		struct NoGuard {
+			explicit NoGuard(Empty&) {}
+		};
+
+		/** @brief Undo/redo storage (bwxPropertyHistory only). */
+		struct HistoryData {
+			std::deque<T> undo;                                ///< Undo history.
+			std::deque<T> redo;                                ///< Redo history.
+			size_t limit = 0;                                  ///< Undo/redo history limit.
+			std::optional<std::chrono::seconds> undoTimeout;   ///< Undo operation timeout.
+			Timestamp lastChangeTime;                          ///< Timestamp of the last modification.
+		};
+
+		using Guard = std::conditional_t<IS_LOCKED, wxMutexLocker, NoGuard>;
+
+		/** @brief Runs callbacks, event notification and binding (outside the lock). */
+		void changed(const T& oldValue, const T& newValue) {
+			if (m_onChange) m_onChange(oldValue, newValue);
+
+			if (m_eventHandler) {
+				wxCommandEvent evt(EVT_BWXPROPERTY_CHANGED);
+				m_eventHandler->AddPendingEvent(evt);
+			}
+
+			for (auto* boundProp : m_boundProperties) {
+				boundProp->set(newValue);
+			}
+		}
+
+		/** @brief Trims the history to respect the configured limit. */
+		void trimHistory(std::deque<T>& history) {
+			while (history.size() > m_history.limit) {
+				history.pop_back();
+			}
+		}
+
+		std::conditional_t<IS_ATOMIC, std::atomic<T>, T> m_value;            ///< Current value of the property.
+		T m_defaultValue;                                                    ///< Default value used for resets.
+		std::conditional_t<IS_ATOMIC, std::atomic<bool>, bool> m_readOnly{ false }; ///< Read-only mode flag.
+		Validator m_validator;                                               ///< Validator function for new values.
+		ChangeCallback m_onChange;                                           ///< Callback for value changes.
+		RejectCallback m_onReject;                                           ///< Callback for rejected values.
+		wxEvtHandler* m_eventHandler = nullptr;                              ///< wxWidgets event handler.
+		std::vector<bwxBasicProperty*> m_boundProperties;                    ///< Bound properties for synchronization.
+		[[no_unique_address]] std::conditional_t<HAS_HISTORY, HistoryData, Empty> m_history; ///< Undo/redo state.
+		[[no_unique_address]] mutable std::conditional_t<IS_LOCKED, wxMutex, Empty> m_mutex;  ///< Mutex (bwxPropertyMutex only).
+	};
+
+	//-----------------------------------------------------------------------------------
+
 	/**
 	 * @brief Template class representing a vector-based property with advanced features.
 	 *
@@ -384,7 +1177,8 @@ namespace bwx_sdk {
 	 * - Safe element insertion, removal, and retrieval.
 	 * - Undo/redo support with configurable history limits.
 	 * - Read-only mode to prevent modifications.
-	 * - wxWidgets event notifications and callback handling on data changes.
+	 * - wxWidgets event notifications (with the changed range) and callback handling on data changes.
+	 * - Coalesced notifications and a single undo step inside bwxPropertyBatch.
 	 * - Timestamp recording for the last data modification.
 	 * - Iterators for standard container traversal.
 	 * - Optional value retrieval for safe access.
@@ -395,7 +1189,7 @@ namespace bwx_sdk {
 	 * @tparam T Type of the elements in the vector.
 	 */
 	template <typename T>
-	class bwxPropertyVector {
+	class bwxPropertyVector : public bwxPropertyNotifier {
 	public:
 		using ChangeCallback = std::function<void()>; ///< Callback invoked when the vector changes.
 		using Timestamp = std::chrono::system_clock::time_point; ///< Timestamp of the last modification.
@@ -433,7 +1227,7 @@ namespace bwx_sdk {
 			recordHistory();
 			m_data.push_back(value);
 			m_lastChangeTime = std::chrono::system_clock::now();
-			notifyChange();
+			notifyChange(m_data.size() - 1, m_data.size());
 		}
 
 		/**
@@ -463,9 +1257,10 @@ namespace bwx_sdk {
 		 */
 		void clear() {
 			wxMutexLocker lock(m_mutex);
+			const size_t oldSize = m_data.size();
 			recordHistory();
 			m_data.clear();
-			notifyChange();
+			notifyChange(0, oldSize);
 		}
 
 		/**
@@ -508,10 +1303,12 @@ namespace bwx_sdk {
 			wxMutexLocker lock(m_mutex);
 			if (m_undoHistory.empty()) return false;
 
+			const size_t oldSize = m_data.size();
 			m_redoHistory.push_front(m_data);
 			m_data = m_undoHistory.front();
 			m_undoHistory.pop_front();
-			notifyChange();
+			m_batchRecorded = false;
+			notifyChange(0, std::max(oldSize, m_data.size()));
 			return true;
 		}
 
@@ -523,10 +1320,12 @@ namespace bwx_sdk {
 			wxMutexLocker lock(m_mutex);
 			if (m_redoHistory.empty()) return false;
 
+			const size_t oldSize = m_data.size();
 			m_undoHistory.push_front(m_data);
 			m_data = m_redoHistory.front();
 			m_redoHistory.pop_front();
-			notifyChange();
+			m_batchRecorded = false;
+			notifyChange(0, std::max(oldSize, m_data.size()));
 			return true;
 		}
 
@@ -628,21 +1427,43 @@ namespace bwx_sdk {
 		}
 
 	private:
+		/** @brief Notifies listeners about changed indices [first, last) (deferred inside a batch). */
+		void notifyChange(size_t first, size_t last) {
+			if (m_changePending) {
+				m_pendingRange.first = std::min(m_pendingRange.first, first);
+				m_pendingRange.last = std::max(m_pendingRange.last, last);
+			}
+			else {
+				m_pendingRange = { first, last };
+				m_changePending = true;
+			}
+			if (!deferNotify()) sendChange();
+		}
+
 		/** @brief Notifies registered listeners via callbacks and wxWidgets events. */
-		void notifyChange() {
+		void sendChange() {
+			m_changePending = false;
 			if (m_onChange) m_onChange();
 			if (m_eventHandler) {
-				wxCommandEvent evt(EVT_BWXPROPERTY_VECTOR_CHANGED);
+				bwxPropertyChangeEvent<bwxPropertyRange> evt(EVT_BWXPROPERTY_VECTOR_CHANGED, m_pendingRange);
 				m_eventHandler->AddPendingEvent(evt);
 			}
 		}
 
-		/** @brief Records the current vector state into the undo history. */
+		/** @brief Sends the change collected during a batch. */
+		void flushNotify() override {
+			wxMutexLocker lock(m_mutex);
+			m_batchRecorded = false;
+			if (m_changePending) sendChange();
+		}
+
+		/** @brief Records the current vector state into the undo history (once per batch). */
 		void recordHistory() {
-			if (m_historyLimit == 0) return;
+			if (m_historyLimit == 0 || m_batchRecorded) return;
 			m_undoHistory.push_front(m_data);
 			trimHistory(m_undoHistory);
 			m_redoHistory.clear();
+			m_batchRecorded = bwxPropertyBatch::IsActive();
 		}
 
 		/** @brief Trims the history deque to comply with the history limit. */
@@ -668,6 +1489,9 @@ namespace bwx_sdk {
 		ChangeCallback m_onChange = nullptr;              ///< Callback for vector changes.
 		Timestamp m_lastChangeTime;                       ///< Last modification timestamp.
 		bool m_readOnly = false;                          ///< Read-only mode flag.
+		bwxPropertyRange m_pendingRange;                  ///< Range changed since the last notification.
+		bool m_changePending = false;                     ///< Change waiting for its notification.
+		bool m_batchRecorded = false;                     ///< Undo step already recorded in the open batch.
 		mutable wxMutex m_mutex;                          ///< Mutex for thread-safe access.
 	};
 
@@ -680,7 +1504,8 @@ namespace bwx_sdk {
 	 * - Insertion, retrieval, and removal of elements with thread safety.
 	 * - Undo/redo support with configurable history limits.
 	 * - Read-only mode to prevent modifications.
-	 * - wxWidgets event notifications and callback handling on data changes.
+	 * - wxWidgets event notifications (with the changed keys) and callback handling on data changes.
+	 * - Coalesced notifications and a single undo step inside bwxPropertyBatch.
 	 * - Timestamp tracking of the last modification.
 	 * - Iterators for standard container traversal.
 	 * - Optional value retrieval for safe access.
@@ -692,7 +1517,7 @@ namespace bwx_sdk {
 	 * @tparam V Type of the values in the map.
 	 */
 	template <typename K, typename V>
-	class bwxPropertyMap {
+	class bwxPropertyMap : public bwxPropertyNotifier {
 	public:
 		using ChangeCallback = std::function<void()>; ///< Callback invoked when the map changes.
 		using Timestamp = std::chrono::system_clock::time_point; ///< Timestamp of the last modification.
@@ -732,7 +1557,7 @@ namespace bwx_sdk {
 			recordHistory();
 			m_data[key] = value;
 			m_lastChangeTime = std::chrono::system_clock::now();
-			notifyChange();
+			notifyChange(&key);
 		}
 
 		/**
@@ -767,7 +1592,7 @@ namespace bwx_sdk {
 			wxMutexLocker lock(m_mutex);
 			recordHistory();
 			m_data.clear();
-			notifyChange();
+			notifyChange(nullptr);
 		}
 
 		/**
@@ -813,7 +1638,8 @@ namespace bwx_sdk {
 			m_redoHistory.push_front(m_data);
 			m_data = m_undoHistory.front();
 			m_undoHistory.pop_front();
-			notifyChange();
+			m_batchRecorded = false;
+			notifyChange(nullptr);
 			return true;
 		}
 
@@ -828,7 +1654,8 @@ namespace bwx_sdk {
 			m_undoHistory.push_front(m_data);
 			m_data = m_redoHistory.front();
 			m_redoHistory.pop_front();
-			notifyChange();
+			m_batchRecorded = false;
+			notifyChange(nullptr);
 			return true;
 		}
 
@@ -946,7 +1773,7 @@ namespace bwx_sdk {
 				m_data[key] = V(); // Wymusza inicjalizacj, jeli brak domylnego konstruktora
 			}
 			m_lastChangeTime = std::chrono::system_clock::now();
-			notifyChange();
+			notifyChange(&key);
 			return m_data[key];
 		}
 
@@ -966,21 +1793,46 @@ namespace bwx_sdk {
 		}
 
 	private:
+		/** @brief Notifies listeners about a changed key - nullptr for all (deferred inside a batch). */
+		void notifyChange(const K* key) {
+			if (!key) {
+				m_pendingKeys.all = true;
+				m_pendingKeys.keys.clear();
+			}
+			else if (!m_pendingKeys.all) {
+				m_pendingKeys.keys.push_back(*key);
+			}
+			if (!deferNotify()) sendChange();
+		}
+
 		/** @brief Notifies listeners through callbacks and wxWidgets events. */
-		void notifyChange() {
+		void sendChange() {
+			bwxPropertyKeys<K> change = std::move(m_pendingKeys);
+			m_pendingKeys = {};
+			std::sort(change.keys.begin(), change.keys.end());
+			change.keys.erase(std::unique(change.keys.begin(), change.keys.end()), change.keys.end());
+
 			if (m_onChange) m_onChange();
 			if (m_eventHandler) {
-				wxCommandEvent evt(EVT_BWXPROPERTY_MAP_CHANGED);
+				bwxPropertyChangeEvent<bwxPropertyKeys<K>> evt(EVT_BWXPROPERTY_MAP_CHANGED, std::move(change));
 				m_eventHandler->AddPendingEvent(evt);
 			}
 		}
 
-		/** @brief Records the current state into the undo history. */
+		/** @brief Sends the change collected during a batch. */
+		void flushNotify() override {
+			wxMutexLocker lock(m_mutex);
+			m_batchRecorded = false;
+			if (m_pendingKeys.all || !m_pendingKeys.keys.empty()) sendChange();
+		}
+
+		/** @brief Records the current state into the undo history (once per batch). */
 		void recordHistory() {
-			if (m_historyLimit == 0) return;
+			if (m_historyLimit == 0 || m_batchRecorded) return;
 			m_undoHistory.push_front(m_data);
 			trimHistory(m_undoHistory);
 			m_redoHistory.clear();
+			m_batchRecorded = bwxPropertyBatch::IsActive();
 		}
 
 		/** @brief Trims the history to respect the configured limit. */
@@ -1006,6 +1858,8 @@ namespace bwx_sdk {
 		ChangeCallback m_onChange = nullptr;              ///< Callback function for changes.
 		Timestamp m_lastChangeTime;                       ///< Timestamp of the last change.
 		bool m_readOnly = false;                          ///< Read-only mode flag.
+		bwxPropertyKeys<K> m_pendingKeys;                 ///< Keys changed since the last notification.
+		bool m_batchRecorded = false;                     ///< Undo step already recorded in the open batch.
 		mutable wxMutex m_mutex;                          ///< Mutex for thread-safe access.
 	};
 
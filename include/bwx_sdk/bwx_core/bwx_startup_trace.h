@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_startup_trace.h
+// Purpose:     BWX_SDK Library; Startup timeline of SDK init phases (Chrome trace format)
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+// WARNING! This is a lightweight, automatically formatted version of the file.
+// The file has been processed by clang-format and Python scripts of the project.
+// (https://github.com/bartoszwarzocha/bwx_sdk/tree/master/scripts)
+// Full versions of source code files, including hidden sections and Doxygen comments,
+// can be found in the 'src' directory.
+
+#ifndef _BWX_STARTUP_TRACE_H_
+#define _BWX_STARTUP_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BWX_STARTUP_TRACE_MAX_EVENTS 4096  // Later events are dropped, so a trace left enabled stays bounded
+
+namespace bwx_sdk {
+
+struct bwxStartupEvent {
+    std::string name;
+    std::string category;
+    int64_t startUs = 0;      ///< Since the SDK was loaded
+    int64_t durationUs = -1;  ///< -1 for instant marks
+    uint32_t thread = 0;      ///< 1 for the thread that called Enable(), others numbered as they first record
+};
+
+/**
+ * @brief Timeline of the SDK's init phases, from library load to the first interactive frame.
+ *
+ * Disabled by default; then a phase costs one relaxed load. Phases may be recorded from any thread
+ * (catalogs loaded on a worker show up on their own track). SaveChromeTrace() writes the Trace Event
+ * format read by chrome://tracing and Perfetto.
+ *
+ * @code
+ * bool MyApp::OnInit() {
+ *     bwxStartupTrace::GetInstance().Enable();
+ *     {
+ *         BWX_STARTUP_PHASE("app.config");
+ *         bwxConfigUtils::LoadConfig();
+ *     }
+ *     ...
+ *     CallAfter([]() {
+ *         bwxStartupTrace::GetInstance().MarkInteractive();
+ *         bwxStartupTrace::GetInstance().SaveChromeTrace("startup.json");
+ *     });
+ * }
+ * @endcode
+ */
+class bwxStartupTrace {
+public:
+    static bwxStartupTrace& GetInstance();
+
+    bwxStartupTrace(const bwxStartupTrace&) = delete;
+    bwxStartupTrace& operator=(const bwxStartupTrace&) = delete;
+
+    void Enable(bool enable = true);  ///< The calling thread becomes the "main" track
+    inline bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    static int64_t Now();  ///< Microseconds since the SDK was loaded
+
+    void Record(const std::string& name, const char* category, int64_t startUs, int64_t durationUs);
+    void Mark(const std::string& name, const char* category = "startup");  ///< Instant event
+
+    // "interactive" mark; also kept as the core.startup.interactive_ms gauge. The first call counts
+    void MarkInteractive();
+    inline int64_t GetInteractiveUs() const { return m_interactiveUs.load(std::memory_order_relaxed); }  ///< -1 until marked
+
+    std::vector<bwxStartupEvent> GetEvents() const;  ///< In recording order
+
+    // { "traceEvents": [ ... ], "displayTimeUnit": "ms" }; complete ("X") and instant ("i") events
+    std::string ToChromeTrace() const;
+    bool SaveChromeTrace(const std::string& path) const;
+
+    void Clear();
+
+private:
+    bwxStartupTrace() = default;
+
+    uint32_t GetThreadIndex();  ///< Under m_mutex
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<int64_t> m_interactiveUs{-1};
+
+    mutable std::mutex m_mutex;
+    std::vector<bwxStartupEvent> m_events;
+    std::map<std::thread::id, uint32_t> m_threads;
+};
+
+/**
+ * @brief Records the time between construction and destruction as one phase, when tracing is enabled.
+ */
+class bwxStartupPhase {
+public:
+    explicit bwxStartupPhase(const char* name, const char* category = "startup")
+        : m_name(name), m_category(category), m_start(bwxStartupTrace::GetInstance().IsEnabled() ? bwxStartupTrace::Now() : -1) {}
+    ~bwxStartupPhase() {
+        if (m_start >= 0) bwxStartupTrace::GetInstance().Record(m_name, m_category, m_start, bwxStartupTrace::Now() - m_start);
+    }
+
+    bwxStartupPhase(const bwxStartupPhase&) = delete;
+    bwxStartupPhase& operator=(const bwxStartupPhase&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    int64_t m_start;
+};
+
+}  // namespace bwx_sdk
+
+#define BWX_STARTUP_CONCAT_INNER(a, b) a##b
+#define BWX_STARTUP_CONCAT(a, b) BWX_STARTUP_CONCAT_INNER(a, b)
+#define BWX_STARTUP_PHASE(...) ::bwx_sdk::bwxStartupPhase BWX_STARTUP_CONCAT(bwxStartupPhase_, __LINE__)(__VA_ARGS__)
+
+#endif  // _BWX_STARTUP_TRACE_H_
@@ -19,6 +19,15 @@
 
 #include "bwx_sdk/bwx_globals.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 namespace bwx_sdk {
 namespace str {
 
@@ -83,6 +92,137 @@ T bwxFromString(const wxString& str) {
 
 std::wstring bwxStringToWstring(const std::string& str);
 
+//----------------------------------------------------------------------------------------------
+// std::string_view counterparts (byte/UTF-8 text, no per-piece allocation)
+//----------------------------------------------------------------------------------------------
+
+/**
+ * @brief Range of the pieces of a string between separators, as views into it.
+ *
+ * Yields the same pieces as bwxSimpleExplode(): nothing for an empty string or separator,
+ * empty pieces between adjacent separators, no empty piece after a trailing separator.
+ */
+class bwxSplitView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        inline std::string_view operator*() const { return m_view->m_str.substr(m_start, m_end - m_start); }
+
+        inline iterator& operator++() {
+            Seek(m_end + m_view->m_separator.size());
+            return *this;
+        }
+
+        inline iterator operator++(int) {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        inline bool operator==(const iterator& other) const { return m_start == other.m_start; }
+        inline bool operator!=(const iterator& other) const { return m_start != other.m_start; }
+
+    private:
+        friend class bwxSplitView;
+
+        iterator(const bwxSplitView* view, size_t from) : m_view(view) { Seek(from); }
+
+        inline void Seek(size_t from) {
+            if (from >= m_view->m_str.size()) {
+                m_start = std::string_view::npos;
+                return;
+            }
+            m_start = from;
+            m_end = std::min(m_view->m_str.find(m_view->m_separator, from), m_view->m_str.size());
+        }
+
+        const bwxSplitView* m_view = nullptr;
+        size_t m_start = std::string_view::npos;  ///< npos = end
+        size_t m_end = 0;
+    };
+
+    bwxSplitView(std::string_view str, std::string_view separator) : m_str(str), m_separator(separator) {}
+
+    inline iterator begin() const { return m_separator.empty() ? end() : iterator(this, 0); }
+    inline iterator end() const { return iterator(); }
+
+private:
+    std::string_view m_str;
+    std::string_view m_separator;
+};
+
+inline bwxSplitView bwxSplit(std::string_view str, std::string_view separator) {
+    return bwxSplitView(str, separator);
+}
+
+/**
+ * @brief Set of bytes tested with one table lookup (ASCII characters for UTF-8 text).
+ */
+class bwxCharFilter {
+public:
+    bwxCharFilter() { m_table.fill(false); }
+
+    explicit bwxCharFilter(std::string_view chars) : bwxCharFilter() { Add(chars); }
+
+    inline void Add(std::string_view chars) {
+        for (unsigned char ch : chars) m_table[ch] = true;
+    }
+
+    inline bool Contains(unsigned char ch) const { return m_table[ch]; }
+
+private:
+    std::array<bool, 256> m_table;
+};
+
+// Appends str without the filtered bytes to out
+void bwxRemoveChars(std::string& out, std::string_view str, const bwxCharFilter& filter);
+
+std::string bwxRemoveChars(std::string_view str, const bwxCharFilter& filter);
+
+/**
+ * @brief Replaces many patterns in one pass (Aho-Corasick automaton).
+ *
+ * At each position the leftmost, then longest, match is replaced and scanning continues after
+ * it, so replacements are never searched again (unlike consecutive bwxReplaceAll() passes).
+ * The automaton is built by the first Replace() after Add(); build it (one Replace() call)
+ * before sharing the replacer between threads.
+ */
+class bwxMultiReplacer {
+public:
+    bwxMultiReplacer() = default;
+    explicit bwxMultiReplacer(const std::vector<std::pair<std::string, std::string>>& replacements);
+
+    void Add(std::string_view pattern, std::string_view replacement);  ///< Empty patterns are ignored
+
+    // Appends the replaced text to out (reserved for the input size)
+    void Replace(std::string& out, std::string_view str) const;
+    std::string Replace(std::string_view str) const;
+
+private:
+    void Build() const;
+
+    struct Pattern {
+        std::string text;
+        std::string replacement;
+    };
+
+    std::vector<Pattern> m_patterns;
+
+    // Automaton, built lazily: next[state * 256 + byte], longest pattern ending in a state (-1 none)
+    mutable std::vector<int32_t> m_next;
+    mutable std::vector<int32_t> m_match;
+    mutable std::vector<uint32_t> m_depth;
+    mutable bool m_built = false;
+};
+
 }  // namespace str
 }  // namespace bwx_sdk
 
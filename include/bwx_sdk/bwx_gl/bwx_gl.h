@@ -52,34 +52,66 @@
 #include <unordered_map>
 #include <vector>
 
+#include "bwx_gl_animation.h"
 #include "bwx_gl_armature.h"
+#include "bwx_gl_bounds.h"
+#include "bwx_gl_bvh.h"
 #include "bwx_gl_buffer.h"
 #include "bwx_gl_buffer_manager.h"
 #include "bwx_gl_camera_component.h"
+#include "bwx_gl_command_buffer.h"
 #include "bwx_gl_component.h"
+#include "bwx_gl_compressed_image.h"
 #include "bwx_gl_control_component.h"
+#include "bwx_gl_dynamic_resolution.h"
+#include "bwx_gl_geometry_pool.h"
 #include "bwx_gl_image_loader.h"
+#include "bwx_gl_light_clusters.h"
 #include "bwx_gl_light_component.h"
 #include "bwx_gl_light_system.h"
+#include "bwx_gl_lod.h"
 #include "bwx_gl_material.h"
 #include "bwx_gl_material_manager.h"
 #include "bwx_gl_mesh.h"
+#include "bwx_gl_mesh_optimizer.h"
+#include "bwx_gl_mesh_simplifier.h"
 #include "bwx_gl_model.h"
 #include "bwx_gl_movement_component.h"
+#include "bwx_gl_movement_system.h"
 #include "bwx_gl_node.h"
+#include "bwx_gl_occlusion.h"
+#include "bwx_gl_picker.h"
+#include "bwx_gl_pool_allocator.h"
+#include "bwx_gl_profiler.h"
+#include "bwx_gl_program_cache.h"
+#include "bwx_gl_registry.h"
+#include "bwx_gl_render_queue.h"
 #include "bwx_gl_render_system.h"
+#include "bwx_gl_render_thread.h"
 #include "bwx_gl_renderable_component.h"
 #include "bwx_gl_resource_manager.h"
+#include "bwx_gl_ring_buffer.h"
 #include "bwx_gl_scene.h"
+#include "bwx_gl_scene_cache.h"
 #include "bwx_gl_scene_loader.h"
 #include "bwx_gl_shader.h"
 #include "bwx_gl_shader_generator.h"
 #include "bwx_gl_shader_manager.h"
+#include "bwx_gl_skeleton.h"
 #include "bwx_gl_skybox.h"
+#include "bwx_gl_text_view_renderer.h"
 #include "bwx_gl_texture.h"
+#include "bwx_gl_texture_array.h"
+#include "bwx_gl_texture_cooker.h"
+#include "bwx_gl_texture_loader.h"
 #include "bwx_gl_texture_manager.h"
+#include "bwx_gl_texture_streamer.h"
+#include "bwx_gl_thumbnail_renderer.h"
 #include "bwx_gl_transform_component.h"
+#include "bwx_gl_transform_system.h"
 #include "bwx_gl_ttf.h"
+#include "bwx_gl_upload_worker.h"
 #include "bwx_gl_utils.h"
+#include "bwx_gl_vertex_layout.h"
 
 #endif  // _BWX_GL_H_
@@ -0,0 +1,190 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_animation.h
+// Purpose:     BWX_SDK Library; OpenGL Skeletal animation clips, sampling and blending
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_ANIMATION_H_
+#define _BWX_GL_ANIMATION_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bwx_gl_skeleton.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_ANIMATION_MAX_LAYERS 4    // Clips blended by one bwxGLAnimator
+#define bwxGL_ANIMATION_JOB_GRAIN 4     // Animators evaluated per job in bwxGLAnimationSystem::Update()
+
+/**
+ * @brief Local bone transforms as separate translation, rotation and scale arrays.
+ *
+ * Clips sample into a pose and poses blend component-wise; only the final pose is turned into
+ * the skeleton's local matrices.
+ */
+struct bwxGLPose {
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+
+    void FromBindPose(const bwxGLSkeleton& skeleton);
+
+    // Moves this pose towards other by alpha (0 keeps this pose, 1 copies other)
+    void Blend(const bwxGLPose& other, float alpha);
+
+    void ToLocalTransforms(std::vector<glm::mat4>& locals) const;
+
+    inline size_t GetBoneCount() const { return translations.size(); }
+};
+
+/**
+ * @brief Keyframed animation of one skeleton, stored quantized in a few contiguous arrays.
+ *
+ * Key times are 16-bit fractions of the duration. Translations and scales are 16-bit values
+ * within the per-channel range, and rotations are 16-bit snorm quaternions already placed in one
+ * hemisphere, so neighbouring keys interpolate the short way. A track refers to its bone by
+ * index, so a clip belongs to the skeleton it was built for (or to a copy of it).
+ */
+class bwxGLAnimationClip {
+public:
+    // Source keys, times in seconds
+    struct Keys {
+        int32_t bone = -1;
+        std::vector<std::pair<float, glm::vec3>> translations;
+        std::vector<std::pair<float, glm::quat>> rotations;
+        std::vector<std::pair<float, glm::vec3>> scales;
+    };
+
+    bwxGLAnimationClip(const std::string& name, float duration);
+
+    void AddTrack(const Keys& keys);
+
+    // Overwrites the animated bones of pose; time is clamped to [0, duration]
+    void Sample(float time, bwxGLPose& pose) const;
+
+    inline const std::string& GetName() const { return m_name; }
+    inline float GetDuration() const { return m_duration; }
+    inline size_t GetTrackCount() const { return m_tracks.size(); }
+    size_t GetMemorySize() const;  ///< Bytes of the key arrays
+
+private:
+    struct Channel {
+        uint32_t first = 0;
+        uint32_t count = 0;
+        glm::vec3 min = glm::vec3(0.0f);    ///< Range of translation/scale keys
+        glm::vec3 extent = glm::vec3(0.0f);
+    };
+
+    struct Track {
+        int32_t bone;
+        Channel translation;
+        Channel rotation;
+        Channel scale;
+    };
+
+    uint16_t QuantizeTime(float time) const;
+    Channel AddVectors(const std::vector<std::pair<float, glm::vec3>>& keys, std::vector<uint16_t>& times,
+                       std::vector<glm::u16vec3>& values);
+
+    // Key pair around time (in key units) and the fraction between them
+    static uint32_t FindKey(const std::vector<uint16_t>& times, const Channel& channel, float time, float& alpha);
+    static glm::vec3 SampleVector(const std::vector<uint16_t>& times, const std::vector<glm::u16vec3>& values,
+                                  const Channel& channel, float time);
+    glm::quat SampleRotation(const Channel& channel, float time) const;
+
+    std::string m_name;
+    float m_duration;
+    std::vector<Track> m_tracks;
+
+    std::vector<uint16_t> m_translationTimes;
+    std::vector<glm::u16vec3> m_translations;
+    std::vector<uint16_t> m_rotationTimes;
+    std::vector<glm::i16vec4> m_rotations;
+    std::vector<uint16_t> m_scaleTimes;
+    std::vector<glm::u16vec3> m_scales;
+};
+
+/**
+ * @brief Plays and blends up to bwxGL_ANIMATION_MAX_LAYERS clips on one skeleton.
+ *
+ * Evaluate() samples every weighted layer, blends the results and writes the skeleton's local
+ * transforms and palette. The skeleton must not be shared with another animator, so copy the
+ * model's skeleton for every animated instance.
+ */
+class bwxGLAnimator {
+public:
+    struct Layer {
+        std::shared_ptr<const bwxGLAnimationClip> clip;
+        float time = 0.0f;
+        float speed = 1.0f;
+        float weight = 1.0f;
+        bool loop = true;
+    };
+
+    explicit bwxGLAnimator(std::shared_ptr<bwxGLSkeleton> skeleton);
+
+    // Replaces the clip of the layer; returns false for a layer out of range
+    bool Play(size_t layer, std::shared_ptr<const bwxGLAnimationClip> clip, float weight = 1.0f, bool loop = true);
+    void Stop(size_t layer);
+
+    inline Layer& GetLayer(size_t layer) { return m_layers[layer]; }
+    inline const Layer& GetLayer(size_t layer) const { return m_layers[layer]; }
+    inline const std::shared_ptr<bwxGLSkeleton>& GetSkeleton() const { return m_skeleton; }
+
+    void Advance(float deltaTime);
+    void Evaluate();
+
+private:
+    std::shared_ptr<bwxGLSkeleton> m_skeleton;
+    Layer m_layers[bwxGL_ANIMATION_MAX_LAYERS];
+    bwxGLPose m_bindPose;
+    bwxGLPose m_pose;
+    bwxGLPose m_sample;
+};
+
+/**
+ * @brief Advances and evaluates all registered animators on the job system.
+ *
+ * Call Update() once per frame before bwxGLRenderSystem::RenderAll(), which packs the resulting
+ * skeleton palettes for the skinning shaders.
+ */
+class bwxGLAnimationSystem {
+public:
+    static bwxGLAnimationSystem& GetInstance();
+
+    bwxGLAnimationSystem(const bwxGLAnimationSystem&) = delete;
+    bwxGLAnimationSystem& operator=(const bwxGLAnimationSystem&) = delete;
+
+    void RegisterAnimator(std::shared_ptr<bwxGLAnimator> animator);
+    void UnregisterAnimator(std::shared_ptr<bwxGLAnimator> animator);
+    void Clear();
+
+    void Update(float deltaTime);
+
+    inline size_t GetAnimatorCount() const { return m_animators.size(); }
+
+private:
+    bwxGLAnimationSystem() = default;
+    ~bwxGLAnimationSystem() = default;
+
+    std::vector<std::shared_ptr<bwxGLAnimator>> m_animators;
+};
+
+}  // namespace bwx_sdk
+
+#endif
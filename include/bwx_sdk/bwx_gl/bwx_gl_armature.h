@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "bwx_gl_node.h"
+#include "bwx_gl_skeleton.h"
 
 namespace bwx_sdk {
 
@@ -40,35 +41,26 @@ struct bwxGLBone {
     std::vector<std::shared_ptr<bwxGLBone>> children;
 };
 
+// Node owning a bwxGLSkeleton; bone access by name resolves the index on every call, animation
+// code should keep indices (bwxGLSkeleton::FindBone) and write the local transforms directly
 class bwxGLArmature : public bwxGLNode {
 public:
     bwxGLArmature();
+    explicit bwxGLArmature(std::shared_ptr<bwxGLSkeleton> skeleton);
     virtual ~bwxGLArmature();
-    /* TODO: Implement the following methods
-    void AddBone(std::shared_ptr<bwxGLBone> bone);
-    void RemoveBone(std::shared_ptr<bwxGLBone> bone);
-    std::vector<std::shared_ptr<bwxGLBone>> GetBones() const;
+
+    inline void SetSkeleton(std::shared_ptr<bwxGLSkeleton> skeleton) { m_skeleton = skeleton; }
+    inline const std::shared_ptr<bwxGLSkeleton>& GetSkeleton() const { return m_skeleton; }
+
+    bool SetBoneTransform(const std::string& name, const glm::mat4& transform);
+    glm::mat4 GetBoneTransform(const std::string& name) const;  ///< Identity for unknown bones
+    glm::mat4 GetBoneOffset(const std::string& name) const;
+
+    // Recomputes the bone palette after the local transforms changed
     void Update();
-    void Render();
-    void SetBoneTransform(const std::string& name, const glm::mat4& transform);
-    glm::mat4 GetBoneTransform(const std::string& name);
-    void SetBoneOffset(const std::string& name, const glm::mat4& offset);
-    glm::mat4 GetBoneOffset(const std::string& name);
-    void SetBoneFinalTransform(const std::string& name, const glm::mat4& finalTransform);
-    glm::mat4 GetBoneFinalTransform(const std::string& name);
-    void SetBoneChildren(const std::string& name, const std::vector<std::shared_ptr<bwxGLBone>>& children);
-    std::vector<std::shared_ptr<bwxGLBone>> GetBoneChildren(const std::string& name);
-    void SetBoneName(const std::string& name, const std::string& newName);
-    std::string GetBoneName(const std::string& name);
-    void SetBone(const std::string& name, std::shared_ptr<bwxGLBone> bone);
-    std::shared_ptr<bwxGLBone> GetBone(const std::string& name);
-    void SetBones(const std::vector<std::shared_ptr<bwxGLBone>>& bones);
-    void SetBones(const std::unordered_map<std::string, std::shared_ptr<bwxGLBone>>& bones);
-    void SetBones(const std::vector<std::string>& names, const std::vector<std::shared_ptr<bwxGLBone>>& bones);
-    void SetBones(const std::vector<std::string>& names, const std::vector<glm::mat4>& offsets);
-    */
+
 private:
-    std::vector<std::shared_ptr<bwxGLBone>> m_bones;
+    std::shared_ptr<bwxGLSkeleton> m_skeleton;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_bounds.h
+// Purpose:     BWX_SDK Library; OpenGL Bounding volumes and view frustum
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_BOUNDS_H_
+#define _BWX_GL_BOUNDS_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <glm/glm.hpp>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Axis-aligned bounding box. Empty (invalid) until the first point is added.
+ */
+struct bwxGLBoundingBox {
+    glm::vec3 min = glm::vec3(1.0f);
+    glm::vec3 max = glm::vec3(-1.0f);
+
+    inline bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+    inline void Reset() { min = glm::vec3(1.0f); max = glm::vec3(-1.0f); }
+
+    inline glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+    inline glm::vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+    void Expand(const glm::vec3& point);
+    void Expand(const bwxGLBoundingBox& box);
+
+    bwxGLBoundingBox Transform(const glm::mat4& matrix) const;
+};
+
+/**
+ * @brief View frustum planes extracted from a view-projection matrix.
+ */
+class bwxGLFrustum {
+public:
+    bwxGLFrustum() = default;
+    explicit bwxGLFrustum(const glm::mat4& viewProjection) { Update(viewProjection); }
+
+    void Update(const glm::mat4& viewProjection);
+
+    bool IsBoxVisible(const bwxGLBoundingBox& box) const;
+    bool IsSphereVisible(const glm::vec3& center, float radius) const;
+
+private:
+    glm::vec4 m_planes[6];  ///< left, right, bottom, top, near, far (normals point inside)
+};
+
+}  // namespace bwx_sdk
+
+#endif
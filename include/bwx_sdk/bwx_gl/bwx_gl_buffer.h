@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "bwx_gl_resource_manager.h"
+#include "bwx_gl_vertex_layout.h"
 
 namespace bwx_sdk {
 
@@ -37,11 +38,16 @@ public:
                 GLenum target = GL_ARRAY_BUFFER, GLenum usage = GL_STATIC_DRAW);
     bwxGLBuffer(GLsizeiptr size, GLsizei stride, const std::vector<GLint>& layout, GLenum target = GL_ARRAY_BUFFER,
                 GLenum usage = GL_DYNAMIC_DRAW);
+    // Pre-encoded data in any layout, including the quantized encodings
+    bwxGLBuffer(const void* data, GLsizeiptr size, const bwxGLVertexLayout& layout, GLenum target = GL_ARRAY_BUFFER,
+                GLenum usage = GL_STATIC_DRAW);
 
     void Create(const std::vector<float>& data, GLsizei stride, const std::vector<GLint>& layout,
                 GLenum target = GL_ARRAY_BUFFER, GLenum usage = GL_STATIC_DRAW);
     void Create(GLsizeiptr size, GLsizei stride, const std::vector<GLint>& layout, GLenum target = GL_ARRAY_BUFFER,
                 GLenum usage = GL_DYNAMIC_DRAW);
+    void Create(const void* data, GLsizeiptr size, const bwxGLVertexLayout& layout, GLenum target = GL_ARRAY_BUFFER,
+                GLenum usage = GL_STATIC_DRAW);
 
     virtual ~bwxGLBuffer();
 
@@ -53,14 +59,27 @@ public:
 
     inline GLuint GetID() const { return m_bufferID; }
     inline GLuint GetVAO() const { return m_vaoID; }
+    inline GLsizeiptr GetStorageSize() const { return m_storageSize; }  ///< Bytes of GPU storage, counted in "gl.buffers.vram_bytes"
 
     void SetData(const void* data, GLsizeiptr size, GLenum usage = GL_STATIC_DRAW);
     void SetData(const std::vector<GLuint>& indices, GLenum usage = GL_STATIC_DRAW);
+    void SetSubData(GLintptr offset, const void* data, GLsizeiptr size);
+
+    // Allocates new storage and maps it for writing; the buffer stays bound until Unmap()
+    void* MapWrite(GLsizeiptr size, GLenum usage = GL_STATIC_DRAW);
+    bool Unmap();
 
 protected:
+    // Expects the VAO and the buffer to be bound
+    void SetupLayout(GLsizei stride, const std::vector<GLint>& layout);
+
+    // After every (re)allocation of the storage; 0 once it is deleted
+    void SetStorageSize(GLsizeiptr size);
+
     GLuint m_bufferID = 0;
     GLuint m_vaoID = 0;
     GLenum m_target = GL_ARRAY_BUFFER;
+    GLsizeiptr m_storageSize = 0;
 };
 
 }  // namespace bwx_sdk
@@ -20,11 +20,15 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "bwx_gl_buffer.h"
+#include "bwx_gl_geometry_pool.h"
+#include "bwx_gl_ring_buffer.h"
 
 namespace bwx_sdk {
 
@@ -54,18 +58,38 @@ public:
     static bwxGLBufferManager& GetInstance();
 
     bwxGLBuffer* GetOrCreateVBO(const std::string& key, const std::vector<float>& vertices);
+    // Raw bytes; nullptr data only allocates the storage
+    bwxGLBuffer* GetOrCreateVBO(const std::string& key, const void* data, GLsizeiptr size, GLenum usage = GL_STATIC_DRAW);
     bwxGLBuffer* GetOrCreateEBO(const std::string& key, const std::vector<unsigned int>& indices);
+    bwxGLBuffer* GetOrCreateEBO(const std::string& key, const void* indices, GLsizeiptr size);
     bwxGLBuffer* GetOrCreateUBO(const std::string& key, const std::vector<float>& data);
     bwxGLBuffer* GetOrCreateTBO(const std::string& key, const std::vector<float>& data);
     bwxGLBuffer* GetOrCreateTFO(const std::string& key, const std::vector<float>& data);
 
+    // Any thread; the data is kept until ProcessLoadRequests() creates the buffer on the GL thread.
+    // While bwxGLUploadWorker runs the buffer is created there and stored by its Update() instead
+    bool RequestVBO(const std::string& key, std::vector<float> vertices);
+    bool RequestEBO(const std::string& key, std::vector<unsigned int> indices);
+
+    // Streaming buffer; stored in the VBO or UBO slot depending on target
+    bwxGLRingBuffer* GetOrCreateRingBuffer(const std::string& key, GLenum target, GLsizeiptr regionSize,
+                                           GLuint regions = bwxGL_RING_BUFFER_REGIONS);
+
     void ReleaseBuffer(const std::string& key);
 
+    // Shared VBO/EBO/VAO for all meshes with this vertex layout, created on first use.
+    // Meshes keep their pool alive, so Clear() only drops the manager's reference
+    std::shared_ptr<bwxGLGeometryPool> GetGeometryPool(const bwxGLVertexLayout& layout);
+
     void Clear();
 
 private:
-    bwxGLBufferManager() = default;
+    bwxGLBufferManager() { EnableMetrics("gl.buffers"); }
     ~bwxGLBufferManager();
+
+    bool RequestBuffer(const std::string& key, GLenum target, std::function<void(bwxGLBuffer&)> fill);
+
+    std::unordered_map<uint64_t, std::shared_ptr<bwxGLGeometryPool>> m_geometryPools;
 };
 
 }  // namespace bwx_sdk
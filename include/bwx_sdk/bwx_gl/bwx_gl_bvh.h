@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_bvh.h
+// Purpose:     BWX_SDK Library; OpenGL Dynamic bounding volume hierarchy
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_BVH_H_
+#define _BWX_GL_BVH_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bwx_gl_bounds.h"
+
+#define bwxGL_BVH_NULL_NODE -1
+#define bwxGL_BVH_MARGIN 0.1f  // Leaf boxes grow by this part of their size, so small moves need no reinsertion
+
+namespace bwx_sdk {
+
+    /**
+     * @brief Dynamic AABB tree: every object is a leaf, every inner node bounds its two children.
+     *
+     * Leaves store a slightly enlarged ("fat") box; Move() only reinserts an object that left it,
+     * so objects that jitter or move slowly cost nothing most frames. A new leaf goes next to the
+     * sibling whose combined surface area grows least, and rotations keep the tree balanced, so
+     * queries visit O(log n) nodes for O(1) results. Queries report the fat boxes, so results are
+     * conservative - callers test their exact bounds when it matters. Queries only read the tree,
+     * so several threads may run them at once while nobody modifies it.
+     */
+    class bwxGLBVH {
+    public:
+        bwxGLBVH() = default;
+
+        // Returns the proxy id used by Move() and Remove()
+        int32_t Insert(const bwxGLBoundingBox& box, void* userData);
+        void Remove(int32_t proxy);
+        bool Move(int32_t proxy, const bwxGLBoundingBox& box);  ///< True when the leaf was reinserted
+        void Clear();
+
+        inline void* GetUserData(int32_t proxy) const { return m_nodes[proxy].userData; }
+        inline const bwxGLBoundingBox& GetFatBounds(int32_t proxy) const { return m_nodes[proxy].box; }
+
+        // Results are appended to out
+        void QueryFrustum(const bwxGLFrustum& frustum, std::vector<void*>& out) const;
+        void QueryBox(const bwxGLBoundingBox& box, std::vector<void*>& out) const;
+        void QuerySphere(const glm::vec3& center, float radius, std::vector<void*>& out) const;
+
+        // Box hits along the ray with their entry distance, nearest first; direction need not be normalized,
+        // distances are in world units
+        void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+            std::vector<std::pair<void*, float>>& out) const;
+        void* RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float* distance = nullptr) const;
+
+        inline size_t GetCount() const { return m_count; }
+        int GetHeight() const;
+
+    private:
+        struct Node {
+            bwxGLBoundingBox box;
+            void* userData = nullptr;
+            int32_t parent = bwxGL_BVH_NULL_NODE;  ///< Next free node while on the free list
+            int32_t left = bwxGL_BVH_NULL_NODE;
+            int32_t right = bwxGL_BVH_NULL_NODE;
+            int height = -1;                       ///< 0 for leaves, -1 for free nodes
+
+            inline bool IsLeaf() const { return left == bwxGL_BVH_NULL_NODE; }
+        };
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        int32_t Balance(int32_t node);
+        void Refit(int32_t node);
+
+        bool RayBox(const bwxGLBoundingBox& box, const glm::vec3& origin, const glm::vec3& inverse, float maxDistance, float& distance) const;
+
+        std::vector<Node> m_nodes;
+        int32_t m_root = bwxGL_BVH_NULL_NODE;
+        int32_t m_freeList = bwxGL_BVH_NULL_NODE;
+        size_t m_count = 0;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_BVH_H_
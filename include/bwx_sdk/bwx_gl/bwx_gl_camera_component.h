@@ -58,6 +58,8 @@ namespace bwx_sdk {
         bwxGL_CAMERA_TYPE GetCameraType() const;
         float GetAspectRatio() const;
         float GetFOV() const;
+        float GetNearPlane() const;
+        float GetFarPlane() const;
 
         void Update(float deltaTime) override;
 
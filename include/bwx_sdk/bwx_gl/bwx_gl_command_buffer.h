@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_command_buffer.h
+// Purpose:     BWX_SDK Library; OpenGL Recorded command list (linear arena)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_COMMAND_BUFFER_H_
+#define _BWX_GL_COMMAND_BUFFER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define bwxGL_COMMAND_BLOCK_SIZE (64 * 1024)
+#define bwxGL_RENDER_THREAD_FRAMES 2  // Frames in flight with bwxGLRenderThread: one replayed, one recorded
+
+namespace bwx_sdk {
+
+class bwxGLBuffer;
+
+/**
+ * @brief GL work of a frame recorded on one thread and executed later on the thread owning the context.
+ *
+ * Commands and their payloads are placed one after another in memory blocks kept between frames;
+ * Reset() only rewinds them, so once the blocks have grown to the size of a frame recording does not
+ * allocate. Payloads are copied, the recording thread may reuse its data right away. Whatever a
+ * command captures by pointer must stay valid until it has been executed.
+ *
+ * @code
+ * bwxGLCommandBuffer& commands = renderThread.BeginFrame();
+ * commands.UploadBuffer(frameUBO, 0, &frameData, sizeof(frameData));
+ * bwxGLRenderSystem::GetInstance().Record(commands);
+ * commands.Record([overlay] { overlay->Draw(); });     // overlay must outlive the replay
+ * renderThread.EndFrame();
+ * @endcode
+ */
+class bwxGLCommandBuffer {
+public:
+    explicit bwxGLCommandBuffer(size_t blockSize = bwxGL_COMMAND_BLOCK_SIZE);
+    ~bwxGLCommandBuffer();
+
+    bwxGLCommandBuffer(const bwxGLCommandBuffer&) = delete;
+    bwxGLCommandBuffer& operator=(const bwxGLCommandBuffer&) = delete;
+
+    // The callable (and its captures) is moved into the arena and destroyed by Reset()
+    template <typename F>
+    void Record(F&& function);
+
+    // Arena memory for payloads; valid until Reset()
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* Copy(const T* data, size_t count);
+
+    void UploadBuffer(bwxGLBuffer* buffer, GLintptr offset, const void* data, GLsizeiptr size);
+    void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+    void Clear(GLbitfield mask);
+
+    // In recording order; call on the thread with the context current
+    void Execute();
+
+    // Destroys the commands and keeps the memory
+    void Reset();
+
+    inline bool IsEmpty() const { return m_first == nullptr; }
+    inline size_t GetCommandCount() const { return m_count; }
+    inline size_t GetUsedBytes() const { return m_used; }
+    size_t GetCapacity() const;
+
+private:
+    struct Command {
+        void (*execute)(Command*) = nullptr;
+        void (*destroy)(Command*) = nullptr;  ///< nullptr when there is nothing to destroy
+        Command* next = nullptr;
+    };
+
+    template <typename F>
+    struct Call : Command {
+        template <typename G>
+        explicit Call(G&& f) : function(std::forward<G>(f)) {
+            execute = [](Command* command) { static_cast<Call*>(command)->function(); };
+            if (!std::is_trivially_destructible<F>::value) destroy = [](Command* command) { static_cast<Call*>(command)->~Call(); };
+        }
+
+        F function;
+    };
+
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    void Append(Command* command);
+
+    size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    size_t m_block = 0;  ///< Block being filled
+
+    Command* m_first = nullptr;
+    Command* m_last = nullptr;
+    size_t m_count = 0;
+    size_t m_used = 0;
+};
+
+template <typename F>
+inline void bwxGLCommandBuffer::Record(F&& function) {
+    using Type = Call<std::decay_t<F>>;
+    Append(new (Allocate(sizeof(Type), alignof(Type))) Type(std::forward<F>(function)));
+}
+
+template <typename T>
+inline T* bwxGLCommandBuffer::Copy(const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable payloads can be copied into the arena");
+    if (count == 0) return nullptr;
+
+    T* copy = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    std::memcpy(copy, data, sizeof(T) * count);
+    return copy;
+}
+
+}  // namespace bwx_sdk
+
+#endif
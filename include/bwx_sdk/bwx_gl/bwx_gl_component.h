@@ -29,6 +29,9 @@ namespace bwx_sdk {
 		virtual void Update(float deltaTime) {} // Optional update
 		virtual void Render() {} // Optional render
 
+		// Components touching wx or GL state are updated serially on the calling thread
+		virtual bool IsMainThreadOnly() const { return false; }
+
 		void SetNode(std::shared_ptr<bwxGLNode> node) { m_node = node; }
 		std::shared_ptr<bwxGLNode> GetNode() const { return m_node.lock(); }
 
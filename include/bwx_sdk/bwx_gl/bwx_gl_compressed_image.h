@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_compressed_image.h
+// Purpose:     BWX_SDK Library; OpenGL KTX2/DDS container loading
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_COMPRESSED_IMAGE_H_
+#define _BWX_GL_COMPRESSED_IMAGE_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+#include <wx/string.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace bwx_sdk {
+
+struct bwxGLImageLevel {
+    int width = 0;
+    int height = 0;
+    size_t offset = 0;  ///< Into GetData()
+    size_t size = 0;
+};
+
+/**
+ * @brief Pre-compressed (BCn, ETC2/EAC, ASTC) or plain RGB(A)8 image with its stored mip chain.
+ *
+ * Reads KTX2 without supercompression and DDS (legacy FourCC and DX10 header). Parsing does no GL
+ * calls, so it may run on a worker thread. Levels are uploaded as stored: rows must already be in GL
+ * order (bottom row first), as bwxGLTextureCooker writes them.
+ */
+class bwxGLCompressedImage {
+public:
+    bwxGLCompressedImage() = default;
+
+    bool Load(const wxString& file);  ///< Container picked by the file magic
+    bool LoadDDS(const unsigned char* data, size_t size);
+    bool LoadKTX2(const unsigned char* data, size_t size);
+
+    static bool IsContainer(const wxString& file);  ///< .dds / .ktx2 extension
+
+    // Driver capability for a compressed internal format; uncompressed formats are always supported
+    static bool IsFormatSupported(GLenum format);
+    static GLenum ToSRGB(GLenum format);  ///< sRGB variant, or the format itself when there is none
+    static bool GetBlockInfo(GLenum format, int& blockWidth, int& blockHeight, int& blockBytes);
+
+    inline GLenum GetFormat() const { return m_format; }
+    inline bool IsCompressed() const { return m_compressed; }
+    inline bool HasAlpha() const { return m_alpha; }
+    inline int GetWidth() const { return m_levels.empty() ? 0 : m_levels[0].width; }
+    inline int GetHeight() const { return m_levels.empty() ? 0 : m_levels[0].height; }
+    inline size_t GetLevelCount() const { return m_levels.size(); }
+    inline const bwxGLImageLevel& GetLevel(size_t level) const { return m_levels[level]; }
+    inline const unsigned char* GetLevelData(size_t level) const { return m_data.data() + m_levels[level].offset; }
+
+    // Total bytes of all levels, i.e. the VRAM the image takes
+    size_t GetDataSize() const;
+
+private:
+    void Reset();
+    bool SetFormat(GLenum format, bool alpha);
+    bool AddLevel(int width, int height, const unsigned char* data, size_t available);
+
+    std::vector<unsigned char> m_data;
+    std::vector<bwxGLImageLevel> m_levels;
+    GLenum m_format = 0;
+    bool m_compressed = false;
+    bool m_alpha = false;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -68,6 +68,7 @@ namespace bwx_sdk {
         void BindMouseWheelToMovement(bwxGL_MOVEMENT_TYPE moveType, float sensitivity = 1.0f);
 
         void Update(float delta);
+        bool IsMainThreadOnly() const override { return true; } // wxGetKeyState()
 
     private:
         void OnMouseMotion(wxMouseEvent& event);
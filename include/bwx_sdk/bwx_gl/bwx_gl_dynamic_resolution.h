@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_dynamic_resolution.h
+// Purpose:     BWX_SDK Library; OpenGL Dynamic resolution driven by GPU frame time
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_DYNAMIC_RESOLUTION_H_
+#define _BWX_GL_DYNAMIC_RESOLUTION_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#define bwxGL_DYNAMIC_RESOLUTION_TARGET_MS 16.0   // GPU time per frame held by default (60 Hz with some headroom)
+#define bwxGL_DYNAMIC_RESOLUTION_MIN_SCALE 0.5f
+#define bwxGL_DYNAMIC_RESOLUTION_STEP 0.05f       // Largest change of the scale per adjustment
+
+namespace bwx_sdk {
+
+    /**
+     * @brief Renders the 3D scene at a fraction of the viewport size chosen to hold a GPU frame time.
+     *
+     * Begin() redirects drawing into an offscreen colour + depth target sized for the largest scale,
+     * with the viewport shrunk to the current scale; End() stretches that part onto the framebuffer
+     * bound before, with a linear blit (no shader, no extra pass). Whatever is drawn after End() -
+     * bwxGLText, UI - stays at native resolution. The depth buffer of that framebuffer is left as the
+     * application cleared it.
+     *
+     * The scale follows the GPU frame time of bwxGLProfiler, so the profiler must be enabled and GPU
+     * timing supported; without timings the scale stays where it is. Pixel cost grows with the square
+     * of the scale, so each adjustment aims at scale * sqrt(target / time), limited to the step size;
+     * after a change the controller waits until the profiler reports frames drawn at the new scale.
+     */
+    class bwxGLDynamicResolution {
+    public:
+        bwxGLDynamicResolution() = default;
+        ~bwxGLDynamicResolution() = default;
+
+        bwxGLDynamicResolution(const bwxGLDynamicResolution&) = delete;
+        bwxGLDynamicResolution& operator=(const bwxGLDynamicResolution&) = delete;
+
+        // Disabling releases the target, so call it with the context current
+        void SetEnabled(bool enabled);
+        inline bool IsEnabled() const { return m_enabled; }
+
+        inline void SetTargetFrameTime(double ms) { m_targetMs = ms > 0.0 ? ms : bwxGL_DYNAMIC_RESOLUTION_TARGET_MS; }
+        inline double GetTargetFrameTime() const { return m_targetMs; }
+
+        // Per axis; above 1 the scene is supersampled when there is time to spare
+        void SetScaleLimits(float minScale, float maxScale = 1.0f);
+        inline float GetMinScale() const { return m_minScale; }
+        inline float GetMaxScale() const { return m_maxScale; }
+
+        inline void SetScaleStep(float step) { m_step = step > 0.0f ? step : bwxGL_DYNAMIC_RESOLUTION_STEP; }
+        inline float GetScaleStep() const { return m_step; }
+
+        void SetScale(float scale);  ///< Starting point; the controller moves on from there
+        inline float GetScale() const { return m_scale; }
+
+        // GL thread, around the 3D scene. Begin() returns false (and changes nothing) when disabled
+        bool Begin();
+        void End();
+
+        inline bool IsActive() const { return m_active; }
+        inline const glm::ivec4& GetNativeViewport() const { return m_native; }  ///< Viewport at Begin()
+        inline const glm::ivec2& GetRenderSize() const { return m_size; }
+
+        void Release();
+
+    private:
+        void Adjust(double gpuMs);
+        bool CreateTarget(int width, int height);
+
+        bool m_enabled = false;
+        double m_targetMs = bwxGL_DYNAMIC_RESOLUTION_TARGET_MS;
+        float m_minScale = bwxGL_DYNAMIC_RESOLUTION_MIN_SCALE;
+        float m_maxScale = 1.0f;
+        float m_step = bwxGL_DYNAMIC_RESOLUTION_STEP;
+        float m_scale = 1.0f;
+
+        double m_averageMs = -1.0;     // Smoothed GPU frame time, -1 before the first sample
+        uint64_t m_lastReport = 0;     // Profiler frame already taken into account
+        uint64_t m_settleUntil = 0;    // Reports of frames before this one may be of an older scale
+
+        GLuint m_framebuffer = 0;
+        GLuint m_colorTarget = 0;
+        GLuint m_depthTarget = 0;
+        glm::ivec2 m_targetSize = glm::ivec2(0);
+
+        bool m_active = false;
+        GLint m_previousFramebuffer = 0;
+        glm::ivec4 m_native = glm::ivec4(0);
+        glm::ivec2 m_size = glm::ivec2(0);
+    };
+
+} // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_geometry_pool.h
+// Purpose:     BWX_SDK Library; OpenGL Shared vertex/index buffer suballocation
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_GEOMETRY_POOL_H_
+#define _BWX_GL_GEOMETRY_POOL_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <map>
+
+#include "bwx_gl_buffer.h"
+#include "bwx_gl_vertex_layout.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_GEOMETRY_POOL_VERTEX_BYTES (16 * 1024 * 1024)  // Initial sizes, doubled when full
+#define bwxGL_GEOMETRY_POOL_INDEX_BYTES (8 * 1024 * 1024)
+
+/**
+ * @brief First-fit free list over [0, capacity); neighbouring free ranges are merged on Free().
+ */
+class bwxGLRangeAllocator {
+public:
+    static constexpr GLsizeiptr INVALID = -1;
+
+    explicit bwxGLRangeAllocator(GLsizeiptr capacity = 0);
+
+    GLsizeiptr Allocate(GLsizeiptr size, GLsizeiptr alignment = 1);  ///< INVALID when nothing fits
+    void Free(GLsizeiptr offset, GLsizeiptr size);
+    void Grow(GLsizeiptr capacity);  ///< Only enlarges; existing ranges keep their offsets
+
+    inline GLsizeiptr GetCapacity() const { return m_capacity; }
+    inline GLsizeiptr GetUsed() const { return m_used; }
+
+private:
+    std::map<GLsizeiptr, GLsizeiptr> m_free;  ///< offset -> size
+    GLsizeiptr m_capacity = 0;
+    GLsizeiptr m_used = 0;
+};
+
+struct bwxGLGeometryAllocation {
+    GLsizeiptr vertexOffset = bwxGLRangeAllocator::INVALID;  ///< Bytes, multiple of the stride
+    GLsizeiptr vertexSize = 0;
+    GLsizeiptr indexOffset = bwxGLRangeAllocator::INVALID;   ///< Bytes, 4-byte aligned
+    GLsizeiptr indexSize = 0;
+    GLint baseVertex = 0;  ///< For glDrawElementsBaseVertex / first vertex of glDrawArrays
+
+    inline bool IsValid() const { return vertexOffset != bwxGLRangeAllocator::INVALID; }
+};
+
+/**
+ * @brief One large VBO + EBO and a single VAO shared by every mesh with the same vertex layout.
+ *
+ * Meshes draw their own range with glDrawElementsBaseVertex, so switching between them needs no
+ * VAO or buffer bind. Buffers grow by copying on the GPU; offsets handed out stay valid.
+ */
+class bwxGLGeometryPool {
+public:
+    bwxGLGeometryPool(const bwxGLVertexLayout& layout, GLsizeiptr vertexBytes = bwxGL_GEOMETRY_POOL_VERTEX_BYTES,
+                      GLsizeiptr indexBytes = bwxGL_GEOMETRY_POOL_INDEX_BYTES);
+    ~bwxGLGeometryPool();
+
+    bwxGLGeometryPool(const bwxGLGeometryPool&) = delete;
+    bwxGLGeometryPool& operator=(const bwxGLGeometryPool&) = delete;
+
+    bool Allocate(GLsizei vertexCount, GLsizeiptr indexBytes, bwxGLGeometryAllocation& allocation);
+    void Free(bwxGLGeometryAllocation& allocation);
+
+    // Pointer to write the allocation's vertices into (mapped, or staging when mapping fails); nullptr on error
+    void* MapVertices(const bwxGLGeometryAllocation& allocation);
+    bool UnmapVertices(const bwxGLGeometryAllocation& allocation);  ///< False: storage lost, write again
+    void WriteIndices(const bwxGLGeometryAllocation& allocation, const void* data);
+
+    inline GLuint GetVAO() const { return m_vao; }
+    inline const bwxGLVertexLayout& GetLayout() const { return m_layout; }
+    inline bwxGLBuffer* GetVBO() const { return m_vbo; }
+    inline bwxGLBuffer* GetEBO() const { return m_ebo; }
+
+private:
+    bwxGLBuffer* Resize(bwxGLBuffer* buffer, GLenum target, GLsizeiptr oldSize, GLsizeiptr newSize);
+    void SetupVAO();
+
+    bwxGLVertexLayout m_layout;
+    bwxGLRangeAllocator m_vertexAllocator;
+    bwxGLRangeAllocator m_indexAllocator;
+
+    bwxGLBuffer* m_vbo = nullptr;
+    bwxGLBuffer* m_ebo = nullptr;
+    GLuint m_vao = 0;
+
+    std::vector<unsigned char> m_staging;
+    bool m_mapped = false;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -37,19 +37,32 @@ public:
 
     bool Load(const wxString& file, bwxGL_IMG_ROTATE_MODE rotate = bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0,
               bool forcePowerOf2 = false);
+    // Same as Load() without querying the driver, so it may run on a worker thread
+    bool Decode(const wxString& file, bwxGL_IMG_ROTATE_MODE rotate = bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0,
+                bool powerOf2 = false);
+
+    // Direct path: Open() decodes the file and fixes the output size, CopyTo() writes the GL-ordered
+    // pixels straight into caller memory (e.g. a mapped PBO) and frees the decoded image. Rotation and
+    // the bottom-up row order are applied during that single copy. Both may run on worker threads
+    bool Open(const wxString& file, bwxGL_IMG_ROTATE_MODE rotate = bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0,
+              bool powerOf2 = false);
+    bool CopyTo(GLubyte* destination, size_t size);
+    inline size_t GetDataSize() const { return static_cast<size_t>(m_width) * m_height * GetBytesPerPixel(); }
 
     const std::vector<GLubyte>& Data() const;
+    inline std::vector<GLubyte> ReleaseData() { return std::move(m_data); }
     int GetBytesPerPixel() const;
+    inline bool HasAlpha() const { return m_alpha; }  ///< Still valid once CopyTo() freed the image
 
     inline int Width() const { return m_width; }
     inline int Height() const { return m_height; }
 
 private:
-    void RotateImage(bwxGL_IMG_ROTATE_MODE rotate);
-
     std::vector<GLubyte> m_data;
     int m_width;
     int m_height;
+    bool m_alpha = false;
+    bwxGL_IMG_ROTATE_MODE m_rotate = bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_light_clusters.h
+// Purpose:     BWX_SDK Library; Clustered forward light assignment (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_LIGHT_CLUSTERS_H_
+#define _BWX_GL_LIGHT_CLUSTERS_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "bwx_gl_light_system.h"
+#include "bwx_gl_buffer.h"
+
+#define bwxGL_CLUSTER_X 16
+#define bwxGL_CLUSTER_Y 9
+#define bwxGL_CLUSTER_Z 24
+#define bwxGL_CLUSTER_MAX_LIGHTS 4096
+#define bwxGL_CLUSTER_LIGHT_TEXELS 6 // RGBA32F texels per bwxGLPackedLight
+
+// Texture units of the light, grid and index buffers (materials use the low ones)
+#define bwxGL_CLUSTER_TEXTURE_UNIT 13
+
+namespace bwx_sdk {
+
+    class bwxGLShaderProgram; // Forward declaration
+
+    /**
+     * @brief Bins lights into a view-space froxel grid (exponential depth slices).
+     *
+     * Everything lives in texture buffers, so shaders fetch only the lights of their own
+     * cluster instead of looping over the whole lights UBO. Lights without a range (sun,
+     * hemi) go to a global list read by every fragment.
+     */
+    class bwxGLLightClusters {
+    public:
+        bwxGLLightClusters() = default;
+        ~bwxGLLightClusters();
+
+        void Build(const std::vector<bwxGLPackedLight>& lights, const glm::mat4& view, const glm::mat4& projection,
+            float nearPlane, float farPlane, const glm::ivec4& viewport);
+        void Upload(const std::vector<bwxGLPackedLight>& lights, bool lightsChanged);
+
+        void Bind() const;
+        void ApplyToShader(bwxGLShaderProgram& shader) const;
+
+        void Release();
+
+        inline size_t GetLightCount() const { return m_lightCount; }
+        inline size_t GetIndexCount() const { return m_indices.size(); }
+
+    private:
+        struct ClusterBox {
+            glm::vec3 min;
+            glm::vec3 max;
+        };
+
+        void BuildClusterBoxes(const glm::mat4& projection);
+        void AssignLocal(const bwxGLPackedLight& light, uint32_t index, const glm::mat4& view, const glm::mat4& projection);
+        int GetSlice(float depth) const;
+
+        void CreateTexture(std::unique_ptr<bwxGLBuffer>& buffer, GLuint& texture, GLenum format);
+
+        std::vector<ClusterBox> m_boxes;
+        glm::mat4 m_boxesProjection = glm::mat4(0.0f);
+        float m_near = 0.0f;
+        float m_far = 0.0f;
+        float m_sliceScale = 0.0f;
+        float m_sliceBias = 0.0f;
+        glm::ivec4 m_viewport = glm::ivec4(0);
+
+        std::vector<glm::uvec2> m_pairs;     ///< (cluster, light) found this frame
+        std::vector<glm::uvec2> m_grid;      ///< offset, count per cluster
+        std::vector<uint32_t> m_indices;     ///< global lights first, then per-cluster lists
+        std::vector<uint32_t> m_globalLights;
+        size_t m_lightCount = 0;
+        size_t m_globalCount = 0;
+
+        std::unique_ptr<bwxGLBuffer> m_lightBuffer;
+        std::unique_ptr<bwxGLBuffer> m_gridBuffer;
+        std::unique_ptr<bwxGLBuffer> m_indexBuffer;
+        GLuint m_lightTexture = 0;
+        GLuint m_gridTexture = 0;
+        GLuint m_indexTexture = 0;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_LIGHT_CLUSTERS_H_
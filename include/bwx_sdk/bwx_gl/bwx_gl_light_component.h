@@ -69,7 +69,12 @@ namespace bwx_sdk {
 
         int GetType() const;
 
+        // Incremented by every setter; the light system repacks only changed lights
+        inline unsigned int GetVersion() const { return m_version; }
+
     private:
+        inline void MarkDirty() { ++m_version; }
+
         bwxGL_LIGHT_TYPE m_type;
 
         glm::vec3 m_objectColor;
@@ -86,6 +91,8 @@ namespace bwx_sdk {
 
         float m_innerCone;
         float m_outerCone;
+
+        unsigned int m_version = 0;
     };
 
 } // namespace bwx_sdk
@@ -18,9 +18,12 @@
 #include <glm/glm.hpp>
 
 #include "bwx_gl_light_component.h"
+#include "bwx_gl_transform_component.h"
 #include "bwx_gl_node.h"
 #include "bwx_gl_buffer.h"
 
+#define bwxGL_MAX_LIGHTS 64 // Size of the lights UBO array (bwxGL_LIGHTS_UBO_BINDING)
+
 namespace bwx_sdk {
 
     struct bwxGLPackedLight {
@@ -39,7 +42,8 @@ namespace bwx_sdk {
             return instance;
         }
 
-        void Register(std::shared_ptr<bwxGLNode> node);
+        void Register(std::shared_ptr<bwxGLNode> node); // Ignored without both light and transform components
+        void RegisterAll(); // Every node with light + transform components (bwxGLRegistry)
         void Unregister(std::shared_ptr<bwxGLNode> node);
         void Clear();
 
@@ -47,13 +51,33 @@ namespace bwx_sdk {
 
         const std::vector<bwxGLPackedLight>& GetPackedLights() const;
 
+        // Range of packed lights changed since the last ClearDirty(). It may reach one slot past
+        // the end: that slot must be zeroed, as shaders stop at the first light without power.
+        bool GetDirtyRange(size_t& first, size_t& count) const;
+        void ClearDirty();
+        void MarkAllDirty();
+
     private:
         bwxGLLightSystem() = default;
         ~bwxGLLightSystem() = default;
 
-        std::vector<std::weak_ptr<bwxGLNode>> m_registeredNodes;
+        struct LightEntry {
+            std::weak_ptr<bwxGLNode> node;
+            std::shared_ptr<bwxGLLightComponent> light;
+            std::shared_ptr<bwxGLTransformComponent> transform;
+            unsigned int lightVersion = ~0u;
+            unsigned int transformVersion = ~0u;
+        };
+
+        void Pack(const LightEntry& entry, bwxGLPackedLight& packed) const;
+        void Remove(size_t index);
+        void MarkDirty(size_t index);
+
+        std::vector<LightEntry> m_entries; // m_entries[i] is packed into m_lightData[i]
         std::vector<bwxGLPackedLight> m_lightData;
-        bwxGLBuffer* m_lightUBO = nullptr;
+
+        size_t m_dirtyFirst = 0;
+        size_t m_dirtyLast = 0; // Exclusive, empty when equal to m_dirtyFirst
     };
 
 } // namespace bwx_sdk
@@ -0,0 +1,58 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_lod.h
+// Purpose:     BWX_SDK Library; OpenGL Mesh level of detail chain
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_LOD_H_
+#define _BWX_GL_LOD_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <memory>
+#include <vector>
+
+#include "bwx_gl_mesh.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_LOD_SCREEN_SIZE 0.25f  // Screen size (bounds diameter / viewport height) below which LOD 1 starts
+#define bwxGL_LOD_HYSTERESIS 0.15f   // Relative band around every threshold
+
+struct bwxGLLODLevel {
+    std::shared_ptr<bwxGLMesh> mesh;
+    float screenSize;  ///< Smallest screen size this level is used for
+};
+
+/**
+ * @brief Meshes of one object from full detail (level 0) down, each used above its screen size.
+ */
+class bwxGLLODChain {
+public:
+    bwxGLLODChain() = default;
+
+    // Levels must go from the finest to the coarsest, with decreasing screen sizes
+    void AddLevel(std::shared_ptr<bwxGLMesh> mesh, float screenSize);
+
+    // Level for the given screen size; leaves current only once past a threshold by the hysteresis band
+    size_t Select(float screenSize, size_t current) const;
+
+    inline size_t GetLevelCount() const { return m_levels.size(); }
+    inline const bwxGLLODLevel& GetLevel(size_t level) const { return m_levels[level]; }
+
+    inline void SetHysteresis(float hysteresis) { m_hysteresis = hysteresis; }
+    inline float GetHysteresis() const { return m_hysteresis; }
+
+private:
+    std::vector<bwxGLLODLevel> m_levels;
+    float m_hysteresis = bwxGL_LOD_HYSTERESIS;
+};
+
+}  // namespace bwx_sdk
+
+#endif
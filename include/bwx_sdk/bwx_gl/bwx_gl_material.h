@@ -30,6 +30,7 @@
 #define bwxGL_MATERIAL_IOR_AMETHYST 1.532
 #define bwxGL_MATERIAL_IOR_GOLD 0.470
 
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -43,6 +44,21 @@
 
 namespace bwx_sdk {
 
+/**
+ * @brief Material uniforms as one std140 block, mirrored by the MaterialParams block of the shaders.
+ *
+ * All members are vec4, so the C++ layout matches std140 without padding.
+ */
+struct bwxGLMaterialParams {
+    glm::vec4 ambient;
+    glm::vec4 diffuse;
+    glm::vec4 specular;
+    glm::vec4 emissive;
+    glm::vec4 transparent;
+    glm::vec4 reflectivity;
+    glm::vec4 params;  ///< shininess, reflection, refraction, opacity
+};
+
 class bwxGLMaterial : public bwxGLResource {
 public:
     bwxGLMaterial();
@@ -51,7 +67,10 @@ public:
 
     void Clean();
 
-    void ApplyToShader(bwxGLShaderProgram& shader) const;
+    void ApplyToShader(bwxGLShaderProgram& shader) const;  ///< Individual uniforms, for programs without MaterialParams
+    bwxGLMaterialParams GetParams() const;
+    // Parameters, flags and texture paths; equal for materials that render the same (name and slots aside)
+    uint64_t GetContentHash() const;
 
     void Bind() const;
     void Unbind() const;
@@ -94,6 +113,21 @@ public:
     void SetID(unsigned int id) { m_id = id; }
     unsigned int GetID() const { return m_id; }
 
+    // Slot in the material SSBO (bwxGLMaterialManager::UploadMaterialTable()), -1 before the first upload.
+    // Resident materials reach all textures without a bind and may share batches with other materials
+    void SetTableIndex(GLint index, bool resident) { m_tableIndex = index; m_tableResident = resident; }
+    GLint GetTableIndex() const { return m_tableIndex; }
+    bool IsTableResident() const { return m_tableIndex >= 0 && m_tableResident; }
+
+    // Slot in the material UBO (bwxGLMaterialManager::UploadMaterialBlocks()), -1 before the first upload
+    void SetBlockIndex(GLint index) { m_blockIndex = index; m_blockDirty = false; }
+    GLint GetBlockIndex() const { return m_blockIndex; }
+    bool IsBlockDirty() const { return m_blockDirty; }  ///< Parameters changed since the last upload
+
+    // Stable for the material's lifetime, given by bwxGLMaterialManager; 0 for unmanaged materials
+    void SetSortKey(uint16_t key) { m_sortKey = key; }
+    uint16_t GetSortKey() const { return m_sortKey; }
+
     void SetTransparent(bool transparent) { m_isTransparent = transparent; }
     bool IsTransparent() const { return m_isTransparent; }
     void SetEmissive(bool emissive) { m_isEmissive = emissive; }
@@ -121,6 +155,11 @@ private:
     std::string m_name;
 
     unsigned int m_id;
+    GLint m_tableIndex = -1;
+    bool m_tableResident = false;
+    GLint m_blockIndex = -1;
+    bool m_blockDirty = true;
+    uint16_t m_sortKey = 0;
 
     bool m_isTransparent;
     bool m_isEmissive;
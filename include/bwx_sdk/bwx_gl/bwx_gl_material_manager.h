@@ -14,16 +14,38 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <string>
 #include <iostream>
+#include <vector>
 
+#include "bwx_gl_buffer.h"
 #include "bwx_gl_material.h"
 #include "bwx_gl_resource_manager.h"
 
 namespace bwx_sdk {
 
+#define bwxGL_MATERIAL_NO_TEXTURE -1
+#define bwxGL_MATERIAL_BOUND_TEXTURE -2  // Not resident, sampled from the diffuseMap bound by bwxGLMaterial::Bind()
+
+	/**
+	 * @brief One entry of the material SSBO (std430), mirrored by the MaterialBlock of the generated shaders.
+	 *
+	 * The diffuse texture is reached either by a bindless handle or by an array/layer pair from
+	 * bwxGLTextureManager::BuildTextureArrays(); the shader tries them in that order.
+	 */
+	struct bwxGLPackedMaterial {
+		glm::vec4 diffuse;
+		glm::vec4 specular;
+		glm::vec4 emissive;
+		glm::vec4 params;          ///< shininess, opacity, reflection, refraction
+		glm::uvec2 diffuseHandle;  ///< Low and high 32 bits, 0 without bindless
+		GLint diffuseArray;        ///< Array index, bwxGL_MATERIAL_NO_TEXTURE or bwxGL_MATERIAL_BOUND_TEXTURE
+		GLint diffuseLayer;
+	};
+
 	class bwxGLMaterialManager : public bwxGLResourceManager<bwxGLMaterial>
     {
     public:
@@ -31,19 +53,57 @@ namespace bwx_sdk {
         std::shared_ptr<bwxGLMaterial> GetMaterial(const std::string& name) const;
 		std::shared_ptr<bwxGLMaterial> GetMaterial(const unsigned int& id) const;
         std::shared_ptr<bwxGLMaterial> CreateMaterial(const std::string& name);
+        // Registers the material under a name made of its GetContentHash(), or returns the one registered
+        // before with the same parameters and textures - imports get one object (and sort key) per look.
+        // The material must not be changed afterwards, other meshes may share it
+        std::shared_ptr<bwxGLMaterial> ShareMaterial(std::shared_ptr<bwxGLMaterial> material);
+
+        // Any thread; creation and setup run in ProcessLoadRequests() on the GL thread.
+        // GetMaterial() is safe from any thread in concurrent mode, CreateMaterial() is not
+        bool RequestMaterial(const std::string& name, std::function<void(bwxGLMaterial&)> setup);
         void ReleaseMaterial(const std::string& name);
 		void ReleaseMaterial(const int& id);
         void CleanupUnusedMaterials();
         void ClearAllMaterials();
 
+        // Packs every material into the SSBO at bwxGL_MATERIAL_SSBO_BINDING and sets its table index.
+        // Returns the number of resident materials (all textures reachable without a bind)
+        size_t UploadMaterialTable();
+        void BindMaterialTable() const;
+        // Bumped when a material is added or removed; the table is stale once it differs from the uploaded one
+        inline uint64_t GetTableVersion() const { return m_tableVersion; }
+        static bool IsMaterialTableSupported();
+
+        // One std140 bwxGLMaterialParams per material in a single UBO, each at an aligned offset.
+        // Re-uploads only when a material was added, removed or changed; returns the number of blocks
+        size_t UploadMaterialBlocks();
+        bool BindMaterialBlock(const bwxGLMaterial& material) const;  ///< One glBindBufferRange at bwxGL_MATERIAL_UBO_BINDING
+
     private:
-        bwxGLMaterialManager() = default;
+        bwxGLMaterialManager() { EnableMetrics("gl.materials"); }
         ~bwxGLMaterialManager() = default;
 
         bwxGLMaterialManager(const bwxGLMaterialManager&) = delete;
         bwxGLMaterialManager& operator=(const bwxGLMaterialManager&) = delete;
 
         //std::unordered_map<std::string, std::weak_ptr<bwxGLMaterial>> m_materials;
+
+        uint16_t AllocateSortKey();
+        void FreeSortKey(const std::shared_ptr<bwxGLMaterial>& material);
+        void UpdateMemoryMetric();  ///< "gl.materials.ram_bytes": materials and the CPU copies of the table and blocks
+
+        std::unique_ptr<bwxGLBuffer> m_tableBuffer;
+        std::vector<bwxGLPackedMaterial> m_table;
+
+        std::unique_ptr<bwxGLBuffer> m_blockBuffer;
+        std::vector<unsigned char> m_blockData;
+        GLsizeiptr m_blockStride = 0;
+        size_t m_blockCount = 0;
+        bool m_blocksDirty = true;  ///< A material was added or removed
+        uint64_t m_tableVersion = 0;
+
+        uint16_t m_nextSortKey = 1;  ///< 0 stays for unmanaged materials
+        std::vector<uint16_t> m_freeSortKeys;
     };
 
 } // namespace bwx_sdk
@@ -25,10 +25,18 @@
 #include <GL/glew.h>
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "bwx_gl_bounds.h"
 #include "bwx_gl_buffer.h"
+#include "bwx_gl_geometry_pool.h"
+#include "bwx_gl_mesh_optimizer.h"
+#include "bwx_gl_vertex_layout.h"
 
 namespace bwx_sdk {
 
@@ -38,51 +46,109 @@ namespace bwx_sdk {
 #define bwxGL_MESH_BITANGENT 0x00000008
 #define bwxGL_MESH_COLOR 0x00000010
 #define bwxGL_MESH_UV 0x00000020
+#define bwxGL_MESH_SKINNED 0x00000040  // Bone indices and weights for GPU skinning
 
 #define bwxGL_MESH_INDICES 0x00001000
+#define bwxGL_MESH_COMPACT 0x00002000  // Half-float UVs, 10:10:10:2 normals/tangents, unorm8 colours
+#define bwxGL_MESH_NO_OPTIMIZE 0x00004000  // Keep the index/vertex order as given
+#define bwxGL_MESH_POOLED 0x00008000       // Suballocate from the layout's shared bwxGLGeometryPool
 #define bwxGL_MESH_DEFAULT bwxGL_MESH_NORMAL | bwxGL_MESH_TEX_COORD
 
-struct bwxGLVertex {
-    glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 texCoord;
-    glm::vec3 tangent;
-    glm::vec3 bitangent;
-    glm::vec3 color;
-    glm::vec3 uv;
-};
-
 class bwxGLMesh {
 public:
     bwxGLMesh(int style);
     virtual ~bwxGLMesh();
 
     void Render();
+    void Draw() const;
+    void DrawInstanced(GLsizei instances) const;
     void Delete();
 
     inline void AddVertex(const bwxGLVertex& v) { m_vertices.push_back(v); }
     inline void SetVertices(const std::vector<bwxGLVertex>& v) { m_vertices = v; }
+    inline void SetVertices(std::vector<bwxGLVertex>&& v) { m_vertices = std::move(v); }
+
+    inline const std::vector<bwxGLVertex>& GetVertices() const { return m_vertices; }
 
     inline void AddIndice(GLuint i) { m_indices.push_back(i); }
     inline void SetIndices(const std::vector<GLuint>& i) { m_indices = i; }
+    inline void SetIndices(std::vector<GLuint>&& i) { m_indices = std::move(i); }
+    inline const std::vector<GLuint>& GetIndices() const { return m_indices; }
+
+    inline int GetFormat() const { return m_inputDataFormat; }
 
     void ConvertVerticesTableToVector(GLfloat v[], GLuint size);
     void ConvertIndicesTableToVector(GLfloat i[], GLuint size);
 
-    void SetupMesh();
+    // CPU half of SetupMesh(layout) - optimisation and bounds, no GL calls, so it may run on a worker.
+    // The next SetupMesh(layout) then only encodes and uploads
+    void Prepare();
 
-    inline bwxGLBuffer* GetVBO() { return m_vbo; }
-    inline bwxGLBuffer* GetEBO() { return m_ebo; }
+    void SetupMesh();
+    // Uploads only the attributes listed in the layout, written straight into the mapped VBO
+    void SetupMesh(const bwxGLVertexLayout& layout);
+    // Vertices already encoded in the layout (e.g. from a cooked scene), copied to the GPU as they are.
+    // The mesh keeps no CPU copy, so LODs cannot be generated from it
+    void SetupMesh(const bwxGLVertexLayout& layout, const void* vertexData, GLsizei vertexCount, const void* indexData,
+                   GLsizei indexCount, GLenum indexType, const bwxGLBoundingBox& bounds);
+
+    // The blobs the GPU got from SetupMesh(layout); needs the CPU data. False before the mesh was set up
+    bool GetEncodedData(std::vector<unsigned char>& vertexData, std::vector<unsigned char>& indexData) const;
+
+    inline const bwxGLVertexLayout& GetLayout() const { return m_layout; }
+    inline GLsizei GetVertexCount() const { return m_vertexCount; }
+    inline GLsizei GetIndexCount() const { return m_indexCount; }
+    inline GLenum GetIndexType() const { return m_indexType; }
+    inline const bwxGLMeshOptimizerStats& GetOptimizerStats() const { return m_optimizerStats; }
+
+    // Pooled meshes return the pool's buffers, which may be replaced when the pool grows
+    inline bwxGLBuffer* GetVBO() { return m_pool ? m_pool->GetVBO() : m_vbo; }
+    inline bwxGLBuffer* GetEBO() { return m_pool ? m_pool->GetEBO() : m_ebo; }
     inline GLuint GetVAO() const { return m_vao; }
 
+    inline bool IsPooled() const { return m_pool != nullptr; }
+    inline GLint GetBaseVertex() const { return m_pool ? m_allocation.baseVertex : 0; }
+    inline const void* GetIndexOffset() const {
+        return reinterpret_cast<const void*>(static_cast<intptr_t>(m_pool ? m_allocation.indexOffset : 0));
+    }
+    // Index offset in elements of GetIndexType(), as indirect draw commands take it
+    inline GLuint GetFirstIndex() const {
+        if (!m_pool) return 0;
+        return static_cast<GLuint>(m_allocation.indexOffset / (m_indexType == GL_UNSIGNED_SHORT ? 2 : 4));
+    }
+    inline bool IsIndexed() const { return (m_inputDataFormat & bwxGL_MESH_INDICES) != 0; }
+
+    inline const bwxGLBoundingBox& GetBounds() const { return m_bounds; }
+
 private:
+    void CalculateBounds();
+    void WriteVertices(unsigned char* dst, const void* encoded) const;
+    void Upload(const void* encodedVertices, const void* indexData, GLsizeiptr indexBytes);
+    void SetupPooled(const void* encodedVertices, const void* indexData, GLsizeiptr indexBytes);
+    void ReleaseBuffers();
+
     std::vector<bwxGLVertex> m_vertices;
     std::vector<GLuint> m_indices;
     int m_inputDataFormat;
 
+    bwxGLBoundingBox m_bounds;
+
     bwxGLBuffer* m_vbo = nullptr;
     bwxGLBuffer* m_ebo = nullptr;
     GLuint m_vao = 0;
+
+    bwxGLVertexLayout m_layout;
+    GLsizei m_vertexCount = 0;
+    GLsizei m_indexCount = 0;
+    GLenum m_indexType = GL_UNSIGNED_INT;
+    bwxGLMeshOptimizerStats m_optimizerStats;
+    bool m_prepared = false;
+
+    std::shared_ptr<bwxGLGeometryPool> m_pool;  ///< Shared, so the pool outlives bwxGLBufferManager::Clear()
+    bwxGLGeometryAllocation m_allocation;
+
+    std::string m_vboKey;
+    std::string m_eboKey;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_mesh_optimizer.h
+// Purpose:     BWX_SDK Library; OpenGL Mesh vertex cache, overdraw and fetch optimizer
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_MESH_OPTIMIZER_H_
+#define _BWX_GL_MESH_OPTIMIZER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "bwx_gl_vertex_layout.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_MESH_OPTIMIZER_CACHE_SIZE 32     // Forsyth scoring cache
+#define bwxGL_MESH_OPTIMIZER_FIFO_SIZE 16      // Simulated post-transform cache for ACMR
+#define bwxGL_MESH_OPTIMIZER_OVERDRAW 1.05f    // Accepted ACMR growth for overdraw reordering
+
+struct bwxGLMeshOptimizerStats {
+    float acmrBefore = 0.0f;  ///< Average cache miss ratio (transformed vertices per triangle)
+    float acmrAfter = 0.0f;
+    size_t verticesBefore = 0;
+    size_t verticesAfter = 0;  ///< Unreferenced vertices are dropped by the fetch remap
+    bool optimized = false;
+};
+
+/**
+ * @brief Reorders indexed triangle lists for the post-transform cache (Forsyth), then triangle
+ * clusters front-to-back against overdraw, then vertices in first-use order for fetch locality.
+ */
+class bwxGLMeshOptimizer {
+public:
+    static bwxGLMeshOptimizerStats Optimize(std::vector<bwxGLVertex>& vertices, std::vector<GLuint>& indices);
+
+    static void OptimizeVertexCache(std::vector<GLuint>& indices, size_t vertexCount);
+    static void OptimizeOverdraw(std::vector<GLuint>& indices, const std::vector<bwxGLVertex>& vertices,
+                                 float threshold = bwxGL_MESH_OPTIMIZER_OVERDRAW);
+    static void OptimizeVertexFetch(std::vector<bwxGLVertex>& vertices, std::vector<GLuint>& indices);
+
+    static float ComputeACMR(const std::vector<GLuint>& indices, size_t vertexCount,
+                             unsigned int cacheSize = bwxGL_MESH_OPTIMIZER_FIFO_SIZE);
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,40 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_mesh_simplifier.h
+// Purpose:     BWX_SDK Library; OpenGL Mesh edge-collapse simplification
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_MESH_SIMPLIFIER_H_
+#define _BWX_GL_MESH_SIMPLIFIER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "bwx_gl_vertex_layout.h"
+
+namespace bwx_sdk {
+
+/**
+ * @brief Quadric error metric edge collapse (Garland-Heckbert), one endpoint kept per collapse.
+ *
+ * Vertices are never moved or created, so the simplified index list stays valid for the original
+ * vertex array. Borders and attribute seams (several vertices at one position) are locked.
+ */
+class bwxGLMeshSimplifier {
+public:
+    // targetError: largest allowed deviation as a fraction of the mesh bounding box diagonal
+    static std::vector<GLuint> Simplify(const std::vector<bwxGLVertex>& vertices, const std::vector<GLuint>& indices,
+                                        size_t targetIndexCount, float targetError = 0.01f);
+};
+
+}  // namespace bwx_sdk
+
+#endif
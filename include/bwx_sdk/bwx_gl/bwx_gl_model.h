@@ -27,8 +27,11 @@
 #include <memory>
 #include <vector>
 
+#include "bwx_gl_animation.h"
+#include "bwx_gl_lod.h"
 #include "bwx_gl_mesh.h"
 #include "bwx_gl_shader.h"
+#include "bwx_gl_skeleton.h"
 
 namespace bwx_sdk {
 
@@ -47,7 +50,10 @@ public:
 
     void Clean();
 
-    inline void AddMesh(std::shared_ptr<bwxGLMesh> mesh) { this->m_meshes.push_back(mesh); }
+    inline void AddMesh(std::shared_ptr<bwxGLMesh> mesh) {
+        this->m_meshes.push_back(mesh);
+        m_boundsDirty = true;
+    }
 
     // To verify
     void Render(glm::mat4* model);
@@ -57,10 +63,42 @@ public:
     inline bwxGL_MODEL_TYPE GetType() { return m_type; }
 
     inline int GetMeshesCount() { return m_meshes.size(); }
+    inline std::shared_ptr<bwxGLMesh> GetMesh(size_t index) const { return m_meshes[index]; }
+
+    // Program drawing a mesh; variants from bwxGLShaderGenerator::GetProgram() are shared across models
+    void SetShaderProgram(size_t index, std::shared_ptr<bwxGLShaderProgram> program);
+    inline std::shared_ptr<bwxGLShaderProgram> GetShaderProgram(size_t index) const {
+        return index < m_shaderPrograms.size() ? m_shaderPrograms[index] : nullptr;
+    }
+
+    // Edge-collapse LODs for every indexed mesh, each keeping ~reduction of the previous triangles.
+    // Needs the CPU data (before bwxGLMesh::Delete); meshes already uploaded get uploaded LODs.
+    void GenerateLODs(int levels = 3, float reduction = 0.5f, float targetError = 0.01f);
+    inline std::shared_ptr<bwxGLLODChain> GetLODChain(size_t index) const {
+        return index < m_lodChains.size() ? m_lodChains[index] : nullptr;
+    }
+
+    const bwxGLBoundingBox& GetBounds();
+
+    // Shared by all skinned meshes of the model; nullptr for static models
+    inline void SetSkeleton(std::shared_ptr<bwxGLSkeleton> skeleton) { m_skeleton = skeleton; }
+    inline const std::shared_ptr<bwxGLSkeleton>& GetSkeleton() const { return m_skeleton; }
+
+    // Clips are bound to the bone indices of GetSkeleton()
+    inline void AddAnimation(std::shared_ptr<bwxGLAnimationClip> clip) { m_animations.push_back(clip); }
+    inline const std::vector<std::shared_ptr<bwxGLAnimationClip>>& GetAnimations() const { return m_animations; }
+    std::shared_ptr<bwxGLAnimationClip> FindAnimation(const std::string& name) const;
 
 private:
     bwxGL_MODEL_TYPE m_type;
     std::vector<std::shared_ptr<bwxGLMesh>> m_meshes;
+    std::vector<std::shared_ptr<bwxGLLODChain>> m_lodChains;  ///< Parallel to m_meshes
+    std::vector<std::shared_ptr<bwxGLShaderProgram>> m_shaderPrograms;  ///< Parallel to m_meshes
+    std::shared_ptr<bwxGLSkeleton> m_skeleton;
+    std::vector<std::shared_ptr<bwxGLAnimationClip>> m_animations;
+
+    bwxGLBoundingBox m_bounds;
+    bool m_boundsDirty = true;
 };
 
 }  // namespace bwx_sdk
@@ -61,6 +61,8 @@ namespace bwx_sdk {
         virtual void ProcessMovement(bwxGLNode& node, const bwxGL_MOVEMENT_TYPE& type, float delta) = 0;
     };
 
+    class bwxGLMovementSystem; // Forward declaration
+
     class bwxGLMovementComponent : public bwxGLComponent {
     public:
         using MovementCallback = std::function<void(bwxGLNode&, float)>;
@@ -72,6 +74,9 @@ namespace bwx_sdk {
         void SetVelocity(const glm::vec3& velocity);
         glm::vec3 GetVelocity() const;
 
+        void SetAcceleration(const glm::vec3& acceleration);
+        glm::vec3 GetAcceleration() const;
+
         void SetRotationSpeed(float speed);
         float GetRotationSpeed() const;
 
@@ -87,13 +92,21 @@ namespace bwx_sdk {
         void SetMovementStrategy(std::unique_ptr<bwxGLMovementStrategy> strategy);
         bool HasMovementStrategy() const;
 
+        // Integrates velocity and acceleration, unless bwxGLMovementSystem does it for this component
         void Update(float deltaTime) override;
 
+        inline bool IsBatched() const { return m_batched; }
+
     private:
-        std::weak_ptr<bwxGLNode> m_node;
+        friend class bwxGLMovementSystem;
+
         glm::vec3 m_velocity;
+        glm::vec3 m_acceleration;
         float m_rotationSpeed;
 
+        unsigned int m_version = 0; ///< Bumped by SetVelocity/SetAcceleration
+        bool m_batched = false;
+
         std::unordered_map<bwxGL_MOVEMENT_TYPE, MovementCallback> m_movementCallbacks; ///< Callbacks for movement
         std::unique_ptr<bwxGLMovementStrategy> m_movementStrategy; ///< Movement strategy
     };
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_movement_system.h
+// Purpose:     BWX_SDK Library; Batched movement integration system (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_MOVEMENT_SYSTEM_H_
+#define _BWX_GL_MOVEMENT_SYSTEM_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "bwx_gl_node.h"
+#include "bwx_gl_movement_component.h"
+#include "bwx_gl_transform_component.h"
+
+#define bwxGL_MOVEMENT_JOB_GRAIN 1024     // Entries integrated per job; fewer than this stay on the calling thread
+#define bwxGL_MOVEMENT_MAX_STEPS 8        // Fixed steps per Update() at most; the rest of a long frame is dropped
+
+namespace bwx_sdk {
+
+    /**
+     * @brief Velocities, accelerations and positions of all movement components under a root, as flat arrays.
+     *
+     * Replaces the per-component bwxGLMovementComponent::Update(): one pass integrates every entry
+     * (SSE over the packed floats, split across bwxJobSystem workers for large counts) and a second
+     * writes the positions that changed back to the transform components, before bwxGLTransformSystem
+     * runs. Nodes need both components. Velocities set on a component and positions set on its
+     * transform by anyone else (control components, gameplay code) are picked up on the next Update().
+     *
+     * With a fixed timestep the simulation advances in whole steps; interpolation then places the
+     * transforms between the last two steps by the remaining fraction, so motion stays smooth when
+     * the frame rate and the step do not match.
+     *
+     * Each bwxGLScene owns one for its root. Hierarchy changes anywhere rebuild the arrays, but
+     * entries that survive keep their simulated state and the accumulated time is not lost.
+     */
+    class bwxGLMovementSystem {
+    public:
+        bwxGLMovementSystem() = default;
+        ~bwxGLMovementSystem() { Clear(); }
+
+        bwxGLMovementSystem(const bwxGLMovementSystem&) = delete;
+        bwxGLMovementSystem& operator=(const bwxGLMovementSystem&) = delete;
+
+        void Update(const std::shared_ptr<bwxGLNode>& root, float deltaTime);
+        void Clear();
+
+        // Seconds per step, 0 integrates the whole frame delta at once (the default)
+        void SetFixedTimestep(float step);
+        inline float GetFixedTimestep() const { return m_fixedStep; }
+
+        // Fixed timestep only
+        inline void SetInterpolation(bool enable) { m_interpolate = enable; }
+        inline bool IsInterpolating() const { return m_interpolate; }
+
+        inline size_t GetCount() const { return m_movements.size(); }
+        inline size_t GetUpdatedCount() const { return m_updatedCount; }  ///< Transforms written by the last Update()
+
+    private:
+        void Rebuild(const std::shared_ptr<bwxGLNode>& root);
+        void Gather();
+        void Integrate(float step);
+
+        // Structure of arrays, index = entry
+        std::vector<glm::vec3> m_velocity;
+        std::vector<glm::vec3> m_acceleration;
+        std::vector<glm::vec3> m_position;        ///< Simulated
+        std::vector<glm::vec3> m_previous;        ///< Before the last fixed step
+        std::vector<glm::vec3> m_output;          ///< Last written to the transform
+        std::vector<unsigned int> m_movementVersion;
+        std::vector<unsigned int> m_transformVersion;
+        std::vector<bwxGLMovementComponent*> m_movements;
+        std::vector<bwxGLTransformComponent*> m_transforms;
+
+        // Keep the raw pointers alive
+        std::vector<std::shared_ptr<bwxGLMovementComponent>> m_movementOwners;
+        std::vector<std::shared_ptr<bwxGLTransformComponent>> m_transformOwners;
+        std::weak_ptr<bwxGLNode> m_root;
+        unsigned int m_hierarchyVersion = 0;
+        bool m_built = false;
+
+        float m_fixedStep = 0.0f;
+        float m_accumulator = 0.0f;
+        bool m_interpolate = true;
+        size_t m_updatedCount = 0;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_MOVEMENT_SYSTEM_H_
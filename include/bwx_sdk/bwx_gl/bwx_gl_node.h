@@ -23,6 +23,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -31,57 +32,128 @@
 #include <iostream>
 #include <memory>
 #include <string>
-#include <typeindex>
-#include <unordered_map>
 #include <vector>
 
 #include "bwx_gl_component.h"
+#include "bwx_gl_pool_allocator.h"
+#include "bwx_gl_registry.h"
 
 namespace bwx_sdk {
 
 class bwxGLNode : public std::enable_shared_from_this<bwxGLNode> {
 public:
-    bwxGLNode() = default;
-    virtual ~bwxGLNode() = default;
+    bwxGLNode() : m_entity(bwxGLRegistry::GetInstance().CreateEntity()) {}
+    virtual ~bwxGLNode() { bwxGLRegistry::GetInstance().DestroyEntity(m_entity); }
 
+    bwxGLNode(const bwxGLNode&) = delete;
+    bwxGLNode& operator=(const bwxGLNode&) = delete;
+
+    // Node and its reference counts in one bwxGLSlabPool block; large hierarchies should be built this way
+    template <typename T = bwxGLNode, typename... Args>
+    static std::shared_ptr<T> Create(Args&&... args) {
+        static_assert(std::is_base_of<bwxGLNode, T>::value, "T must derive from bwxGLNode");
+        return bwxGLMakePooled<T>(std::forward<Args>(args)...);
+    }
+
+    // Facade over bwxGLRegistry: the node owns its components, the registry packs them per type
     template <typename T, typename... Args>
     std::shared_ptr<T> AddComponent(Args&&... args) {
         static_assert(std::is_base_of<bwxGLComponent, T>::value, "T must derive from bwxGLComponent");
-        auto component = std::make_shared<T>(std::forward<Args>(args)...);
-        m_components[typeid(T)] = component;
+        auto component = bwxGLMakePooled<T>(std::forward<Args>(args)...);  // Components of a type share a pool
+        component->SetNode(weak_from_this().lock());
+
+        const bwxGLComponentTypeId id = bwxGLComponentType::Get<T>();
+        if (id >= m_components.size()) m_components.resize(id + 1);
+        m_components[id] = component;
+
+        bwxGLRegistry::GetInstance().GetPool<T>().Add(m_entity, this, component.get());
+        ++s_hierarchyVersion;
         return component;
     }
 
     template <typename T>
-    std::shared_ptr<T> GetComponent() {
-        auto it = m_components.find(typeid(T));
-        return (it != m_components.end()) ? std::static_pointer_cast<T>(it->second) : nullptr;
+    std::shared_ptr<T> GetComponent() const {
+        const bwxGLComponentTypeId id = bwxGLComponentType::Get<T>();
+        return id < m_components.size() ? std::static_pointer_cast<T>(m_components[id]) : nullptr;
     }
 
+    // No shared_ptr copy, for hot paths
     template <typename T>
-    bool HasComponent() {
-        return m_components.find(typeid(T)) != m_components.end();
+    T* GetComponentPtr() const {
+        const bwxGLComponentTypeId id = bwxGLComponentType::Get<T>();
+        return id < m_components.size() ? static_cast<T*>(m_components[id].get()) : nullptr;
+    }
+
+    template <typename T>
+    bool HasComponent() const {
+        const bwxGLComponentTypeId id = bwxGLComponentType::Get<T>();
+        return id < m_components.size() && m_components[id] != nullptr;
     }
 
     template <typename T>
     void RemoveComponent() {
-        m_components.erase(typeid(T));
+        const bwxGLComponentTypeId id = bwxGLComponentType::Get<T>();
+        if (id >= m_components.size() || !m_components[id]) return;
+
+        bwxGLRegistry::GetInstance().GetPool<T>().Remove(m_entity);
+        m_components[id].reset();
+        ++s_hierarchyVersion;
     }
 
+    inline bwxGLEntity GetEntity() const { return m_entity; }
+
+    void AddChild(std::shared_ptr<bwxGLNode> child) {
+        if (!child || child.get() == this) return;
+        if (auto oldParent = child->GetParent()) oldParent->RemoveChild(child);
+        child->m_parent = weak_from_this();
+        m_children.push_back(std::move(child));
+        ++s_hierarchyVersion;
+    }
+
+    void RemoveChild(const std::shared_ptr<bwxGLNode>& child) {
+        auto it = std::find(m_children.begin(), m_children.end(), child);
+        if (it == m_children.end()) return;
+        (*it)->m_parent.reset();
+        m_children.erase(it);
+        ++s_hierarchyVersion;
+    }
+
+    inline const std::vector<std::shared_ptr<bwxGLNode>>& GetChildren() const { return m_children; }
+    inline std::shared_ptr<bwxGLNode> GetParent() const { return m_parent.lock(); }
+
+    // Bumped by any structural change (children, components) in any node
+    static inline unsigned int GetHierarchyVersion() { return s_hierarchyVersion.load(std::memory_order_relaxed); }
+
+    // Whole subtree, serially
     void Update(float deltaTime) {
-        for (auto& [type, component] : m_components) {
-            component->Update(deltaTime);
+        for (auto& component : m_components) {
+            if (component) component->Update(deltaTime);
+        }
+        for (auto& child : m_children) {
+            child->Update(deltaTime);
+        }
+    }
+
+    // This node only; components with IsMainThreadOnly() == mainThreadOnly
+    void UpdateComponents(float deltaTime, bool mainThreadOnly) {
+        for (auto& component : m_components) {
+            if (component && component->IsMainThreadOnly() == mainThreadOnly) component->Update(deltaTime);
         }
     }
 
     void Render() {
-        for (auto& [type, component] : m_components) {
-            component->Render();
+        for (auto& component : m_components) {
+            if (component) component->Render();
         }
     }
 
 private:
-    std::unordered_map<std::type_index, std::shared_ptr<bwxGLComponent>> m_components;
+    std::vector<std::shared_ptr<bwxGLComponent>> m_components; ///< Indexed by bwxGLComponentType id
+    bwxGLEntity m_entity;
+    std::vector<std::shared_ptr<bwxGLNode>> m_children;
+    std::weak_ptr<bwxGLNode> m_parent;
+
+    static inline std::atomic<unsigned int> s_hierarchyVersion{0};
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_occlusion.h
+// Purpose:     BWX_SDK Library; OpenGL Occlusion culling with bounding-box queries (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_OCCLUSION_H_
+#define _BWX_GL_OCCLUSION_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bwx_gl_bounds.h"
+#include "bwx_gl_buffer.h"
+
+#define bwxGL_OCCLUSION_KEEP_FRAMES 120  // Entries of objects not seen for this long are dropped with their query
+
+namespace bwx_sdk {
+
+    class bwxGLShaderProgram; // Forward declaration
+
+    /**
+     * @brief Skips objects whose bounding box was hidden behind the depth buffer in an earlier frame.
+     *
+     * After the opaque pass IssueQueries() draws the boxes of the tested objects, without colour or
+     * depth writes, each inside a GL_ANY_SAMPLES_PASSED query. IsVisible() only reads results the GPU
+     * already has, so nothing ever waits; an object keeps its last known state until a newer result
+     * arrives. Objects just entering the view, and those whose box holds the camera, count as visible.
+     * Hidden objects are still tested every frame, so they reappear one frame after they come into view.
+     */
+    class bwxGLOcclusionCuller {
+    public:
+        bwxGLOcclusionCuller() = default;
+        ~bwxGLOcclusionCuller();
+
+        static bool IsSupported();  ///< GL 3.3 or ARB_occlusion_query2
+
+        void BeginFrame();
+
+        // Call for every object that passed frustum culling; nearPlane keeps boxes cut by the near plane visible
+        bool IsVisible(const void* object, const bwxGLBoundingBox& box, const glm::vec3& cameraPosition, float nearPlane);
+
+        // After the opaque pass, with its depth buffer still bound; changes the bound program and VAO
+        void IssueQueries(const glm::mat4& viewProjection);
+
+        void Release();
+
+        inline size_t GetOccludedCount() const { return m_occludedCount; }  ///< Skipped in the current frame
+        inline size_t GetTestedCount() const { return m_tests.size(); }
+
+    private:
+        struct Entry {
+            GLuint query = 0;
+            bwxGLBoundingBox box;
+            uint64_t lastFrame = 0;
+            bool pending = false;
+            bool stale = false;     ///< The pending result is from before the object left the view
+            bool visible = true;
+        };
+
+        bool CreateResources();
+
+        std::unordered_map<const void*, Entry> m_entries;
+        std::vector<Entry*> m_tests;  ///< Queried this frame; map nodes do not move
+
+        std::unique_ptr<bwxGLShaderProgram> m_program;
+        std::unique_ptr<bwxGLBuffer> m_vertices;
+        std::unique_ptr<bwxGLBuffer> m_indices;
+        GLuint m_vao = 0;
+
+        uint64_t m_frame = 0;
+        size_t m_occludedCount = 0;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_OCCLUSION_H_
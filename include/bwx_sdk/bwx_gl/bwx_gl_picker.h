@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_picker.h
+// Purpose:     BWX_SDK Library; OpenGL Object picking with an ID render target (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_PICKER_H_
+#define _BWX_GL_PICKER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bwx_gl_render_queue.h"
+
+#define bwxGL_PICK_READBACKS 3  // Picks in flight at once; further requests wait for a free slot
+
+namespace bwx_sdk {
+
+    class bwxGLNode; // Forward declaration
+    class bwxGLShaderProgram; // Forward declaration
+
+    /**
+     * @brief Finds the node under a pixel by drawing object IDs instead of testing rays against meshes.
+     *
+     * Render() draws the frame's render queue into a 1x1 GL_R32UI target through a projection zoomed
+     * onto the requested pixel, so only that pixel is shaded, and copies it into a pixel buffer. Poll()
+     * reads the buffer once its fence has signalled, usually a frame or two later, and reports the
+     * node - nothing waits for the GPU. Skinned meshes are tested in their bind pose.
+     */
+    class bwxGLPicker {
+    public:
+        using Callback = std::function<void(std::shared_ptr<bwxGLNode>)>;  ///< nullptr when nothing was hit
+
+        bwxGLPicker() = default;
+        ~bwxGLPicker();
+
+        static bool IsSupported();  ///< GL 3.3 (integer targets and fence sync)
+
+        // Window coordinates with the origin at the bottom left (bwxGLUtils::GetWindowCoordinates)
+        void RequestPick(int x, int y, Callback callback);
+        inline bool IsPickRequested() const { return m_requested; }
+        inline bool IsPending() const { return m_requested || m_inFlight > 0; }
+
+        // After the frame's passes; viewport is the one the queue was drawn with.
+        // Changes the bound program and VAO, restores the framebuffer and the viewport
+        void Render(const bwxGLRenderQueue& queue, const glm::mat4& viewProjection, const glm::ivec4& viewport);
+
+        // Delivers finished picks; once per frame
+        void Poll();
+
+        void Release();
+
+    private:
+        struct Readback {
+            GLuint pbo = 0;
+            GLsync fence = nullptr;
+            Callback callback;
+            std::vector<std::weak_ptr<bwxGLNode>> nodes;  ///< ID - 1, as drawn in that frame
+        };
+
+        bool CreateResources();
+        void DrawEntries(const bwxGLRenderQueue& queue, const std::vector<bwxGLRenderQueue::SortEntry>& entries,
+            const glm::mat4& pickProjection, Readback& readback);
+
+        std::unique_ptr<bwxGLShaderProgram> m_program;
+        GLuint m_framebuffer = 0;
+        GLuint m_colorTarget = 0;
+        GLuint m_depthTarget = 0;
+
+        Readback m_readbacks[bwxGL_PICK_READBACKS];
+        size_t m_inFlight = 0;
+
+        bool m_requested = false;
+        int m_x = 0;
+        int m_y = 0;
+        Callback m_callback;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_PICKER_H_
@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_pool_allocator.h
+// Purpose:     BWX_SDK Library; OpenGL Fixed-size block pools for nodes and components
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_POOL_ALLOCATOR_H_
+#define _BWX_GL_POOL_ALLOCATOR_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#define bwxGL_POOL_CHUNK_SIZE (64 * 1024)  // Bytes per chunk; a chunk holds at least one block
+
+namespace bwx_sdk {
+
+/**
+ * @brief Blocks of one size and alignment, carved one after another from large chunks.
+ *
+ * Objects created one after another sit next to each other, so walking a freshly built hierarchy
+ * touches few cache lines. Freed blocks go to a free list and are reused first; chunks are kept
+ * until ReleaseUnused() finds no live block, then they are all returned at once - after a scene is
+ * torn down that is one free per chunk instead of one per object.
+ *
+ * One pool per size/alignment pair, shared by every type of that size. Pools live until the process
+ * ends (never destroyed, so objects released during static destruction stay valid).
+ */
+class bwxGLSlabPool {
+public:
+    template <size_t Size, size_t Align>
+    static bwxGLSlabPool& Get();
+
+    bwxGLSlabPool(const bwxGLSlabPool&) = delete;
+    bwxGLSlabPool& operator=(const bwxGLSlabPool&) = delete;
+
+    void* Allocate();
+    void Deallocate(void* block) noexcept;
+
+    size_t ReleaseUnused();     ///< Frees the chunks when no block is live; returns the bytes freed
+    static size_t ReleaseAllUnused();  ///< ReleaseUnused() of every pool
+
+    size_t GetLiveCount() const;
+    size_t GetCapacity() const;  ///< Blocks in the chunks held
+    inline size_t GetBlockSize() const { return m_blockSize; }
+
+private:
+    bwxGLSlabPool(size_t blockSize, size_t alignment);
+
+    static std::mutex& GetPoolsMutex();
+    static std::vector<bwxGLSlabPool*>& GetPools();
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    const size_t m_blockSize;
+    const size_t m_alignment;
+    const size_t m_chunkBlocks;
+
+    mutable std::mutex m_mutex;  ///< The last reference may be dropped on any thread
+    std::vector<void*> m_chunks;
+    FreeBlock* m_free = nullptr;
+    unsigned char* m_bump = nullptr;     ///< Next never used block of the newest chunk
+    unsigned char* m_bumpEnd = nullptr;
+    size_t m_live = 0;
+};
+
+template <size_t Size, size_t Align>
+inline bwxGLSlabPool& bwxGLSlabPool::Get() {
+    static bwxGLSlabPool* pool = [] {
+        bwxGLSlabPool* created = new bwxGLSlabPool(Size, Align);
+        std::lock_guard<std::mutex> lock(GetPoolsMutex());
+        GetPools().push_back(created);
+        return created;
+    }();
+    return *pool;
+}
+
+/**
+ * @brief Standard allocator over bwxGLSlabPool, for std::allocate_shared.
+ *
+ * allocate_shared puts the object and its reference counts in one block, so a pooled shared_ptr
+ * costs one pool block and no heap call. Arrays fall back to the heap.
+ */
+template <typename T>
+class bwxGLPoolAllocator {
+public:
+    using value_type = T;
+
+    bwxGLPoolAllocator() noexcept = default;
+    template <typename U>
+    bwxGLPoolAllocator(const bwxGLPoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count != 1) return std::allocator<T>().allocate(count);
+        return static_cast<T*>(bwxGLSlabPool::Get<sizeof(T), alignof(T)>().Allocate());
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (count != 1) {
+            std::allocator<T>().deallocate(pointer, count);
+            return;
+        }
+        bwxGLSlabPool::Get<sizeof(T), alignof(T)>().Deallocate(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const bwxGLPoolAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const bwxGLPoolAllocator<U>&) const noexcept { return false; }
+};
+
+// std::make_shared with the object and its control block in a pool block
+template <typename T, typename... Args>
+inline std::shared_ptr<T> bwxGLMakePooled(Args&&... args) {
+    return std::allocate_shared<T>(bwxGLPoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_profiler.h
+// Purpose:     BWX_SDK Library; OpenGL CPU/GPU frame profiler
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_PROFILER_H_
+#define _BWX_GL_PROFILER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bwx_sdk {
+
+#define bwxGL_PROFILER_FRAME_LATENCY 3  // Frames in flight before GPU timings of a frame are given up
+
+struct bwxGLProfileCounters {
+    uint64_t drawCalls = 0;
+    uint64_t stateChanges = 0;   ///< Program, material and VAO switches
+    uint64_t uploadedBytes = 0;  ///< Buffer data sent to the GPU
+};
+
+struct bwxGLProfileEntry {
+    const char* name;  ///< Must outlive the report - use literals
+    uint32_t depth;
+    int32_t parent;    ///< Index of the enclosing entry, -1 for the frame itself
+    double cpuMs;
+    double gpuMs;      ///< Negative when the GPU result was not available in time
+};
+
+/**
+ * @brief Timings of one frame in scope order (parents before their children).
+ */
+struct bwxGLProfileReport {
+    uint64_t frame = 0;
+    std::vector<bwxGLProfileEntry> entries;
+    bwxGLProfileCounters counters;
+
+    inline double GetCPUFrameTime() const { return entries.empty() ? 0.0 : entries.front().cpuMs; }
+    inline double GetGPUFrameTime() const { return entries.empty() ? -1.0 : entries.front().gpuMs; }
+
+    std::string ToString() const;  ///< Indented, one scope per line
+};
+
+/**
+ * @brief Scoped CPU and GPU timing markers with a per-frame hierarchical report.
+ *
+ * Each scope writes two GL_TIMESTAMP queries, so scopes nest freely (GL_TIME_ELAPSED queries
+ * cannot). Query sets rotate over bwxGL_PROFILER_FRAME_LATENCY frames; results are only read once
+ * GL_QUERY_RESULT_AVAILABLE says so, so the profiler never waits for the GPU and GetReport() lags
+ * a frame or two behind. Disabled by default; while disabled the markers cost a branch.
+ */
+class bwxGLProfiler {
+public:
+    static bwxGLProfiler& GetInstance();
+
+    bwxGLProfiler(const bwxGLProfiler&) = delete;
+    bwxGLProfiler& operator=(const bwxGLProfiler&) = delete;
+
+    void SetEnabled(bool enabled);
+    inline bool IsEnabled() const { return m_enabled; }
+    static bool IsGPUTimingSupported();
+
+    void BeginFrame();
+    void EndFrame();
+
+    void BeginScope(const char* name);
+    void EndScope();
+
+    inline void AddDrawCalls(uint64_t count = 1) { if (m_inFrame) m_counters.drawCalls += count; }
+    inline void AddStateChanges(uint64_t count = 1) { if (m_inFrame) m_counters.stateChanges += count; }
+    inline void AddUploadedBytes(uint64_t bytes) { if (m_inFrame) m_counters.uploadedBytes += bytes; }
+
+    // Latest frame with resolved timings
+    inline const bwxGLProfileReport& GetReport() const { return m_report; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        bwxGLProfileReport report;
+        std::vector<Clock::time_point> starts;
+        std::vector<GLuint> queries;  ///< Begin/end timestamp pair per entry, reused between frames
+        bool pending = false;
+        bool timed = false;           ///< Queries were written for this frame
+    };
+
+    bwxGLProfiler() = default;
+    ~bwxGLProfiler() = default;
+
+    bool IsAvailable(const Frame& frame) const;
+    void Resolve(Frame& frame, bool gpu);
+    void ReleaseQueries();  ///< Needs the context, so done when disabling rather than at exit
+
+    bool m_enabled = false;
+    bool m_inFrame = false;
+    bool m_gpu = false;
+    uint64_t m_frameIndex = 0;
+    size_t m_current = 0;
+    Frame m_frames[bwxGL_PROFILER_FRAME_LATENCY];
+    std::vector<int32_t> m_stack;
+    bwxGLProfileCounters m_counters;
+    bwxGLProfileReport m_report;
+};
+
+class bwxGLProfileScope {
+public:
+    explicit bwxGLProfileScope(const char* name) { bwxGLProfiler::GetInstance().BeginScope(name); }
+    ~bwxGLProfileScope() { bwxGLProfiler::GetInstance().EndScope(); }
+
+    bwxGLProfileScope(const bwxGLProfileScope&) = delete;
+    bwxGLProfileScope& operator=(const bwxGLProfileScope&) = delete;
+};
+
+#define bwxGL_PROFILE_CONCAT_(a, b) a##b
+#define bwxGL_PROFILE_CONCAT(a, b) bwxGL_PROFILE_CONCAT_(a, b)
+#define bwxGL_PROFILE_SCOPE(name) bwx_sdk::bwxGLProfileScope bwxGL_PROFILE_CONCAT(bwxGLProfileScope_, __LINE__)(name)
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_program_cache.h
+// Purpose:     BWX_SDK Library; OpenGL On-disk shader program binary cache
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_PROGRAM_CACHE_H_
+#define _BWX_GL_PROGRAM_CACHE_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bwx_gl_shader.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_PROGRAM_CACHE_VERSION 1
+#define bwxGL_PROGRAM_CACHE_EXT ".bwxprog"
+
+/**
+ * @brief Linked program binaries kept on disk, so later runs skip compiling and linking GLSL.
+ *
+ * The key hashes the shader sources (with their stages) together with the GL vendor, renderer and
+ * version strings, so a driver update or another GPU simply misses. A binary the driver refuses
+ * anyway is deleted and the caller compiles from source. Disabled until SetDirectory() is called;
+ * bwxGLShaderProgramManager uses it for every program created from sources or files.
+ */
+class bwxGLProgramBinaryCache {
+public:
+    static bwxGLProgramBinaryCache& GetInstance();
+
+    bwxGLProgramBinaryCache(const bwxGLProgramBinaryCache&) = delete;
+    bwxGLProgramBinaryCache& operator=(const bwxGLProgramBinaryCache&) = delete;
+
+    // Empty path disables the cache; the directory is created when missing
+    bool SetDirectory(const std::string& directory);
+    inline const std::string& GetDirectory() const { return m_directory; }
+
+    bool IsEnabled() const;     ///< Directory set and binaries supported by the driver
+    static bool IsSupported();  ///< Needs a current context
+
+    // 0 when the cache is disabled
+    uint64_t GetKey(const std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& sources) const;
+
+    bool Load(bwxGLShaderProgram& program, uint64_t key);
+    bool Store(const bwxGLShaderProgram& program, uint64_t key) const;
+
+    void Clear();  ///< Deletes all cached binaries in the directory
+
+    inline size_t GetHitCount() const { return m_hits; }
+    inline size_t GetMissCount() const { return m_misses; }
+
+private:
+    bwxGLProgramBinaryCache() = default;
+    ~bwxGLProgramBinaryCache() = default;
+
+    std::string GetPath(uint64_t key) const;
+    uint64_t GetDriverHash() const;
+
+    std::string m_directory;
+    mutable uint64_t m_driverHash = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+
+}  // namespace bwx_sdk
+
+#endif
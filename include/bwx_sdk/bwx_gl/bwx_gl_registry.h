@@ -0,0 +1,157 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_registry.h
+// Purpose:     BWX_SDK Library; Component registry with packed per-type storage (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_REGISTRY_H_
+#define _BWX_GL_REGISTRY_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "bwx_gl_component.h"
+
+namespace bwx_sdk {
+
+    class bwxGLNode; // Forward declaration
+
+    using bwxGLEntity = uint32_t;
+    using bwxGLComponentTypeId = uint32_t;
+
+    // Dense component type IDs (0, 1, 2, ...) assigned on first use of each type
+    class bwxGLComponentType {
+    public:
+        template <typename T>
+        static bwxGLComponentTypeId Get() {
+            static const bwxGLComponentTypeId id = s_next.fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+
+    private:
+        static inline std::atomic<bwxGLComponentTypeId> s_next{ 0 };
+    };
+
+    class bwxGLComponentPoolBase {
+    public:
+        virtual ~bwxGLComponentPoolBase() = default;
+        virtual void Remove(bwxGLEntity entity) = 0;
+    };
+
+    /**
+     * @brief Packed array of one component type. The owning node keeps the shared_ptr,
+     * the pool only raw pointers, so iterating it costs no refcount traffic.
+     */
+    template <typename T>
+    class bwxGLComponentPool : public bwxGLComponentPoolBase {
+    public:
+        void Add(bwxGLEntity entity, bwxGLNode* node, T* component) {
+            if (entity >= m_sparse.size()) m_sparse.resize(entity + 1, 0);
+
+            if (m_sparse[entity]) {
+                m_components[m_sparse[entity] - 1] = component;
+                return;
+            }
+
+            m_components.push_back(component);
+            m_nodes.push_back(node);
+            m_entities.push_back(entity);
+            m_sparse[entity] = static_cast<uint32_t>(m_components.size());
+        }
+
+        void Remove(bwxGLEntity entity) override {
+            if (!Has(entity)) return;
+
+            // Swap with the last one to keep the array packed
+            const uint32_t index = m_sparse[entity] - 1;
+            const uint32_t last = static_cast<uint32_t>(m_components.size() - 1);
+            if (index != last) {
+                m_components[index] = m_components[last];
+                m_nodes[index] = m_nodes[last];
+                m_entities[index] = m_entities[last];
+                m_sparse[m_entities[index]] = index + 1;
+            }
+
+            m_components.pop_back();
+            m_nodes.pop_back();
+            m_entities.pop_back();
+            m_sparse[entity] = 0;
+        }
+
+        inline bool Has(bwxGLEntity entity) const { return entity < m_sparse.size() && m_sparse[entity] != 0; }
+        inline T* Get(bwxGLEntity entity) const { return Has(entity) ? m_components[m_sparse[entity] - 1] : nullptr; }
+
+        inline size_t Size() const { return m_components.size(); }
+        inline T* At(size_t index) const { return m_components[index]; }
+        inline bwxGLNode* NodeAt(size_t index) const { return m_nodes[index]; }
+        inline bwxGLEntity EntityAt(size_t index) const { return m_entities[index]; }
+
+    private:
+        std::vector<T*> m_components;
+        std::vector<bwxGLNode*> m_nodes;
+        std::vector<bwxGLEntity> m_entities;
+        std::vector<uint32_t> m_sparse; ///< entity -> dense index + 1, 0 = none
+    };
+
+    /**
+     * @brief Owns the entity IDs of all nodes and one packed pool per component type.
+     *
+     * bwxGLNode::AddComponent/RemoveComponent keep it in sync. Not thread safe: add and
+     * remove components outside of parallel updates.
+     *
+     * @code
+     * registry.Each<bwxGLLightComponent, bwxGLTransformComponent>(
+     *     [](bwxGLNode& node, bwxGLLightComponent& light, bwxGLTransformComponent& transform) { ... });
+     * @endcode
+     */
+    class bwxGLRegistry {
+    public:
+        static bwxGLRegistry& GetInstance();
+
+        bwxGLEntity CreateEntity();
+        void DestroyEntity(bwxGLEntity entity);
+
+        template <typename T>
+        bwxGLComponentPool<T>& GetPool() {
+            const bwxGLComponentTypeId id = bwxGLComponentType::Get<T>();
+            if (id >= m_pools.size()) m_pools.resize(id + 1);
+            if (!m_pools[id]) m_pools[id] = std::make_unique<bwxGLComponentPool<T>>();
+            return static_cast<bwxGLComponentPool<T>&>(*m_pools[id]);
+        }
+
+        // Calls func(node, first, rest...) for every entity that has all the listed components
+        template <typename First, typename... Rest, typename Func>
+        void Each(Func&& func) {
+            auto& first = GetPool<First>();
+            [&](auto&... rest) {
+                for (size_t i = 0; i < first.Size(); ++i) {
+                    const bwxGLEntity entity = first.EntityAt(i);
+                    if ((rest.Has(entity) && ...)) {
+                        func(*first.NodeAt(i), *first.At(i), *rest.Get(entity)...);
+                    }
+                }
+            }(GetPool<Rest>()...);
+        }
+
+    private:
+        bwxGLRegistry() = default;
+        ~bwxGLRegistry() = default;
+
+        std::vector<std::unique_ptr<bwxGLComponentPoolBase>> m_pools;
+        std::vector<bwxGLEntity> m_freeEntities;
+        bwxGLEntity m_nextEntity = 0;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_REGISTRY_H_
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_render_queue.h
+// Purpose:     BWX_SDK Library; OpenGL Render queue with sorted draw keys (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_RENDER_QUEUE_H_
+#define _BWX_GL_RENDER_QUEUE_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace bwx_sdk {
+
+    class bwxGLRenderableComponent; // Forward declaration
+    class bwxGLMaterial; // Forward declaration
+
+    /**
+     * @brief Single draw submitted to the render queue.
+     *
+     * The item keeps the real state objects; the sort key only holds their
+     * per-frame slots, so state changes are always detected on real values.
+     */
+    struct bwxGLDrawItem {
+        bwxGLRenderableComponent* renderable;
+        GLuint program;
+        const bwxGLMaterial* material;
+        GLuint vao;
+        glm::mat4 model;
+        bool instanced; // Program reads the model matrix from per-instance attributes
+        GLint materialIndex; // Material SSBO slot, -1 when the program does not read the table
+        bool sharedMaterial; // Resident in the table - batches with other materials, nothing to bind
+        GLint boneBase; // First matrix in the bone palette, -1 for meshes without a skeleton
+    };
+
+    /**
+     * @brief Run of consecutive sorted entries sharing program, material and mesh.
+     *
+     * Items read from the material table share one material slot, so only program and mesh split them.
+     */
+    struct bwxGLDrawBatch {
+        uint32_t first;         ///< Index into the sorted entry list
+        uint32_t count;
+        int32_t instanceOffset; ///< First matrix in the instance data, -1 for per-draw uniforms
+    };
+
+    /**
+     * @brief Per-frame draw list sorted by compact 64-bit keys.
+     *
+     * Opaque key:      program(12) | material(16) | mesh(16) | depth(20), front-to-back.
+     * Transparent key: ~depth(24) | program(12) | material(16) | mesh(12), back-to-front.
+     * Front-to-back opaque key (SetOpaqueFrontToBack): depth(20) | program(12) | material(16) | mesh(16),
+     * for the most early-z rejection at the cost of state changes and batching.
+     * The material field is bwxGLMaterial::GetSortKey(), stable across frames; materials without
+     * one get a per-frame slot.
+     */
+    class bwxGLRenderQueue {
+    public:
+        struct SortEntry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        void Clear();
+
+        inline void SetOpaqueFrontToBack(bool enable) { m_opaqueFrontToBack = enable; }  ///< Before Push()
+        inline bool IsOpaqueFrontToBack() const { return m_opaqueFrontToBack; }
+
+        void Push(bwxGLRenderableComponent* renderable, GLuint program, const bwxGLMaterial* material,
+                  GLuint vao, const glm::mat4& model, float viewDepth, bool transparent, bool instanced = false,
+                  GLint materialIndex = -1, bool sharedMaterial = false, GLint boneBase = -1);
+
+        void Sort();
+
+        // Groups sorted entries into batches and packs instance matrices; call after Sort()
+        void BuildBatches();
+
+        inline const std::vector<SortEntry>& GetOpaque() const { return m_opaque; }
+        inline const std::vector<SortEntry>& GetTransparent() const { return m_transparent; }
+        inline const bwxGLDrawItem& GetItem(const SortEntry& entry) const { return m_items[entry.index]; }
+
+        inline const std::vector<bwxGLDrawBatch>& GetOpaqueBatches() const { return m_opaqueBatches; }
+        inline const std::vector<bwxGLDrawBatch>& GetTransparentBatches() const { return m_transparentBatches; }
+        inline const std::vector<glm::mat4>& GetInstanceData() const { return m_instanceData; }
+
+        inline size_t GetSize() const { return m_items.size(); }
+
+    private:
+        uint32_t GetSlot(std::unordered_map<uintptr_t, uint32_t>& slots, uintptr_t value);
+
+        static uint32_t QuantizeDepth(float viewDepth, int bits);
+        static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+        void BuildBatches(const std::vector<SortEntry>& entries, std::vector<bwxGLDrawBatch>& batches);
+
+        std::vector<bwxGLDrawItem> m_items;
+        std::vector<SortEntry> m_opaque;
+        std::vector<SortEntry> m_transparent;
+        std::vector<SortEntry> m_scratch;
+
+        std::vector<bwxGLDrawBatch> m_opaqueBatches;
+        std::vector<bwxGLDrawBatch> m_transparentBatches;
+        std::vector<glm::mat4> m_instanceData;
+
+        std::unordered_map<uintptr_t, uint32_t> m_programSlots;
+        std::unordered_map<uintptr_t, uint32_t> m_materialSlots;
+        std::unordered_map<uintptr_t, uint32_t> m_meshSlots;
+        bool m_opaqueFrontToBack = false;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_RENDER_QUEUE_H_
@@ -16,18 +16,60 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_set>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "bwx_gl_camera_component.h"
+#include "bwx_gl_command_buffer.h"
 #include "bwx_gl_light_system.h"
 #include "bwx_gl_buffer.h"
+#include "bwx_gl_ring_buffer.h"
+#include "bwx_gl_bounds.h"
+#include "bwx_gl_bvh.h"
+#include "bwx_gl_dynamic_resolution.h"
+#include "bwx_gl_render_queue.h"
+#include "bwx_gl_light_clusters.h"
+#include "bwx_gl_occlusion.h"
+#include "bwx_gl_picker.h"
+#include "bwx_gl_shader.h"
+#include "bwx_gl_skeleton.h"
+#include "bwx_gl_skybox.h"
 
 namespace bwx_sdk {
 
 	class bwxGLRenderableComponent; // Forward declaration
+
+    // FrameBlock (binding bwxGL_FRAME_UBO_BINDING), uploaded once per frame; std140 layout
+    struct bwxGLFrameUniforms {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProjection;
+        glm::vec4 cameraPosition;   // xyz = world position, w = unused
+    };
+
+    // Layouts fixed by GL for glMultiDrawElementsIndirect / glMultiDrawArraysIndirect
+    struct bwxGLDrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+    struct bwxGLDrawArraysIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint first;
+        GLuint baseInstance;
+    };
+
+    // DrawDataBlock entry (binding bwxGL_DRAW_DATA_SSBO_BINDING), one per indirect draw; std430 layout
+    struct bwxGLDrawData {
+        glm::mat4 model;
+        glm::uvec4 info;            // x = renderable index in the queue, y = material table index, z = first bone palette matrix, w = reserved
+    };
 	class bwxGLCameraComponent; // Forward declaration
 
     class bwxGLRenderSystem {
@@ -44,23 +86,181 @@ namespace bwx_sdk {
 
         void RenderAll();
 
+        // RenderAll() split for bwxGLRenderThread: the scene (camera, lights, transforms, skeleton poses, culling)
+        // is read now, on the recording thread, and the GL part is recorded - the scene may change as soon as this
+        // returns. What the render thread dereferences is not copied: registering, unregistering or releasing
+        // renderables and changing their mesh, shader, material or LOD chain needs bwxGLRenderThread::Flush() first.
+        // bwxGLProfiler is not thread-safe either - record its BeginFrame()/EndFrame() too
+        void Record(bwxGLCommandBuffer& commands);
+
         void SetActiveCamera(std::shared_ptr<bwxGLCameraComponent> m_activeCamera);
         std::shared_ptr<bwxGLCameraComponent> GetActiveCamera() const;
 
         void SetLightSystem(std::shared_ptr<bwxGLLightSystem> system);
         std::shared_ptr<bwxGLLightSystem> GetLightSystem() const;
 
+        // Shaders must come from GetFragmentShader(..., useClusteredLights = true)
+        inline void SetClusteredLighting(bool enable) { m_clusteredLighting = enable; }
+        inline bool IsClusteredLighting() const { return m_clusteredLighting; }
+        inline const bwxGLLightClusters& GetLightClusters() const { return m_lightClusters; }
+
+        // Batches of IsIndirect() programs go out as one glMultiDrawElementsIndirect; needs GL 4.3 class hardware.
+        // Without it (or when disabled) every mesh is drawn on its own, as on GL 3.3
+        inline void SetMultiDrawIndirect(bool enable) { m_multiDrawIndirect = enable; }
+        inline bool IsMultiDrawIndirect() const { return m_multiDrawIndirect; }
+        static bool IsMultiDrawIndirectSupported();
+
+        // Opaque draws of UsesDepthPrePass() programs first write depth only (bwxGLShaderGenerator::GetDepthVertexShader),
+        // then shade with GL_EQUAL - every covered pixel is lit once. Pays off with expensive lighting and overdraw
+        inline void SetDepthPrePass(bool enable) { m_depthPrePass = enable; }
+        inline bool IsDepthPrePass() const { return m_depthPrePass; }
+
+        // Drawn between the opaque and the transparent pass, where the depth buffer hides all covered sky
+        inline void SetSkyBox(std::shared_ptr<bwxGLSkyBox> skyBox) { m_skyBox = std::move(skyBox); }
+        inline std::shared_ptr<bwxGLSkyBox> GetSkyBox() const { return m_skyBox; }
+
+        // Opaque draws sorted by depth before state (bwxGLRenderQueue::SetOpaqueFrontToBack)
+        inline void SetOpaqueFrontToBack(bool enable) { m_renderQueue.SetOpaqueFrontToBack(enable); }
+        inline bool IsOpaqueFrontToBack() const { return m_renderQueue.IsOpaqueFrontToBack(); }
+
+        // Programs with UsesMaterialTable() batch across resident materials. The table is re-packed on the next
+        // frame after this call and whenever async textures finish (new bindless handles)
+        inline void InvalidateMaterialTable() { m_materialTableDirty = true; }
+
+        // Reports the on-screen size of textured objects to bwxGLTextureStreamer and lets it evict mips
+        // to stay within its VRAM budget (bwxGLTextureStreamer::SetBudget)
+        inline void SetTextureStreaming(bool enable) { m_textureStreaming = enable; }
+        inline bool IsTextureStreaming() const { return m_textureStreaming; }
+
+        // Objects whose bounding box was hidden in an earlier frame are skipped (bwxGLOcclusionCuller).
+        // Pays off in interiors and dense cities; open scenes only pay for the box queries
+        inline void SetOcclusionCulling(bool enable) { m_occlusionCulling = enable; }
+        inline bool IsOcclusionCulling() const { return m_occlusionCulling; }
+        inline const bwxGLOcclusionCuller& GetOcclusionCuller() const { return m_occlusion; }
+
+        // Frustum culling walks this tree (bwxGLScene::GetSpatialIndex()) instead of every registered
+        // renderable; renderables missing from it are not drawn, except the unbounded ones
+        // (bwxGLScene::GetUnboundedRenderables()), which are always candidates. nullptr tests all of them
+        inline void SetSpatialIndex(const bwxGLBVH* index, const std::vector<bwxGLRenderableComponent*>* unbounded = nullptr) {
+            m_spatialIndex = index;
+            m_spatialUnbounded = unbounded;
+        }
+        inline const bwxGLBVH* GetSpatialIndex() const { return m_spatialIndex; }
+
+        // The node under a pixel (window coordinates, bwxGLUtils::GetWindowCoordinates), from an ID pass
+        // drawn with the next frame; the callback runs in a later RenderAll() once the GPU has the result
+        inline void RequestPick(int x, int y, bwxGLPicker::Callback callback) { m_picker.RequestPick(x, y, std::move(callback)); }
+        inline const bwxGLPicker& GetPicker() const { return m_picker; }
+
+        // The scene is drawn at a scale that holds a GPU frame time, then stretched to the viewport;
+        // whatever is drawn after RenderAll() (text, UI) stays at native resolution. Needs bwxGLProfiler enabled
+        inline bwxGLDynamicResolution& GetDynamicResolution() { return m_dynamicResolution; }
+
         glm::mat4 GetViewMatrix() const;
         glm::mat4 GetProjectionMatrix() const;
 
+        inline size_t GetCulledCount() const { return m_culledCount; }  ///< Outside the frustum (as of the last extracted frame)
+        inline size_t GetOccludedCount() const { return m_occlusionCulling ? m_occlusion.GetOccludedCount() : 0; }
+        inline size_t GetSubmittedCount() const { return m_renderQueue.GetSize(); }
+        inline size_t GetIndirectDrawCount() const { return m_indirectDrawCount; }
+
     private:
         bwxGLRenderSystem() = default;
         ~bwxGLRenderSystem() = default;
 
+        // Frustum-visible renderable with its world state as of Extract()
+        struct FrameItem {
+            bwxGLRenderableComponent* renderable;
+            glm::mat4 model;
+            bwxGLBoundingBox bounds;
+            GLint boneBase;         // First matrix in the frame's bone palette, -1 when not skinned
+        };
+
+        // Everything a frame takes from the scene; one per frame in flight, vectors keep their capacity
+        struct FrameSnapshot {
+            glm::mat4 view = glm::mat4(1.0f);
+            glm::mat4 projection = glm::mat4(1.0f);
+            float nearPlane = 0.1f;
+            float farPlane = 100.0f;
+            std::vector<FrameItem> items;
+
+            bool lights = false;    // A light system is set
+            std::vector<bwxGLPackedLight> packedLights;
+            bool lightsChanged = false;
+            size_t lightsFirst = 0;
+            size_t lightsCount = 0;
+
+            bwxGLBonePalette bonePalette;
+        };
+
+        FrameSnapshot& Extract();   // Scene side
+        void Render(FrameSnapshot& frame);  // GL side
+
+        void BuildQueue(FrameSnapshot& frame);
+        void UploadFrameUniforms(const glm::mat4& view, const glm::mat4& projection);
+        void UploadLights(const FrameSnapshot& frame);
+        void UploadInstanceData();
+        void DrawQueue(const std::vector<bwxGLRenderQueue::SortEntry>& entries, const std::vector<bwxGLDrawBatch>& batches,
+            const glm::mat4& view, const glm::mat4& projection);
+        void BindInstanceAttributes(GLint firstInstance);
+        void PrepareIndirectBuffers();
+        bool DrawIndirect(const std::vector<bwxGLRenderQueue::SortEntry>& entries, const bwxGLDrawBatch& batch);
+        void SubmitIndirect(bool indexed, GLenum indexType);
+        void BindDrawData(const glm::mat4& model, uint32_t index, GLint materialIndex, GLint boneBase);
+        bool DrawDepthPrePass(const std::vector<bwxGLRenderQueue::SortEntry>& entries, const std::vector<bwxGLDrawBatch>& batches);
+        bwxGLShaderProgram* GetDepthProgram(bool instanced, bool indirect, bool skinned);
+
         std::vector<std::shared_ptr<bwxGLRenderableComponent>> m_renderables;
+        std::unordered_set<const bwxGLRenderableComponent*> m_registered;
+        const bwxGLBVH* m_spatialIndex = nullptr;
+        const std::vector<bwxGLRenderableComponent*>* m_spatialUnbounded = nullptr;
+        std::vector<void*> m_spatialResults;
+        std::vector<bwxGLRenderableComponent*> m_candidates;
 		std::shared_ptr<bwxGLCameraComponent> m_activeCamera;
         std::shared_ptr<bwxGLLightSystem> m_lightSystem;
-		bwxGLBuffer* m_lightUBO;
+		bwxGLBuffer* m_lightUBO = nullptr;
+        bwxGLBuffer* m_frameUBO = nullptr;
+        bwxGLRingBuffer* m_instanceVBO = nullptr;
+        GLintptr m_instanceBase = 0;
+
+        bool m_multiDrawIndirect = true;
+        bool m_indirectActive = false;      // Supported and enabled this frame
+        bwxGLRingBuffer* m_indirectBuffer = nullptr;
+        bwxGLRingBuffer* m_drawDataSSBO = nullptr;
+        std::vector<bwxGLDrawElementsIndirectCommand> m_elementCommands;
+        std::vector<bwxGLDrawArraysIndirectCommand> m_arrayCommands;
+        std::vector<bwxGLDrawData> m_drawData;
+        size_t m_indirectDrawCount = 0;
+        bool m_materialTableDirty = true;
+        uint64_t m_materialTableVersion = 0;  ///< bwxGLMaterialManager::GetTableVersion() at the last upload
+        bool m_textureStreaming = false;
+
+        bwxGLLightClusters m_lightClusters;
+        FrameSnapshot m_frames[bwxGL_RENDER_THREAD_FRAMES];
+        size_t m_frameIndex = 0;
+        bool m_clusteredLighting = false;
+
+        bwxGLRenderQueue m_renderQueue;
+        size_t m_culledCount = 0;
+
+        bwxGLOcclusionCuller m_occlusion;
+        bool m_occlusionCulling = false;
+
+        bwxGLPicker m_picker;
+        std::shared_ptr<bwxGLSkyBox> m_skyBox;
+        bwxGLDynamicResolution m_dynamicResolution;
+
+        bool m_depthPrePass = false;
+        bool m_depthPrePassActive = false;  // Depth laid down this frame, DrawQueue tests with GL_EQUAL
+        GLenum m_depthFunc = GL_LESS;       // For the programs outside the pre-pass
+        GLenum m_currentDepthFunc = GL_LESS;
+        std::unique_ptr<bwxGLShaderProgram> m_depthPrograms[8];  // instanced | indirect << 1 | skinned << 2
+        bool m_depthProgramFailed[8] = {};
+
+        // Currently bound state, reset every frame
+        GLuint m_currentProgram = 0;
+        const bwxGLMaterial* m_currentMaterial = nullptr;
+        GLuint m_currentVAO = 0;
     };
 
 } // namespace bwx_sdk
@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_render_thread.h
+// Purpose:     BWX_SDK Library; OpenGL Render thread replaying recorded frames
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_RENDER_THREAD_H_
+#define _BWX_GL_RENDER_THREAD_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <wx/glcanvas.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "bwx_gl_command_buffer.h"
+
+namespace bwx_sdk {
+
+/**
+ * @brief Thread that owns the GL context and replays the frames recorded on the UI thread.
+ *
+ * The UI thread records frame N+1 into one command buffer while this thread replays frame N from
+ * the other, so event handling and simulation no longer wait for GL submission. BeginFrame() blocks
+ * only when both buffers are still in use. Anything else needing the context (resource creation in
+ * the managers, bwxGLText::Flush, ...) goes through Post() or Invoke(), or is recorded into the frame.
+ *
+ * The context must not be current on any other thread when Start() is called: create it, but do not
+ * call SetCurrent() on the UI thread. Under X11 call XInitThreads() before the wxApp is created.
+ *
+ * @code
+ * renderThread.Start(canvas, context);
+ * renderThread.Invoke([] { glewExperimental = GL_TRUE; glewInit(); });
+ * ...
+ * // Every frame (timer or idle handler)
+ * scene.Update(dt);                                      // overlaps the replay of the previous frame
+ * bwxGLCommandBuffer& commands = renderThread.BeginFrame();
+ * commands.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+ * bwxGLRenderSystem::GetInstance().Record(commands);
+ * renderThread.EndFrame();                               // replayed and swapped on the render thread
+ * @endcode
+ */
+class bwxGLRenderThread {
+public:
+    bwxGLRenderThread();
+    ~bwxGLRenderThread();
+
+    bwxGLRenderThread(const bwxGLRenderThread&) = delete;
+    bwxGLRenderThread& operator=(const bwxGLRenderThread&) = delete;
+
+    // The thread makes the context current on the canvas and keeps it until Stop()
+    bool Start(wxGLCanvas* canvas, wxGLContext* context);
+    // Runs everything already submitted, then joins the thread
+    void Stop();
+    inline bool IsRunning() const { return m_thread.joinable(); }
+
+    // Buffer for the next frame, empty; waits while the render thread still uses it
+    bwxGLCommandBuffer& BeginFrame();
+    // Queues the frame recorded since BeginFrame(); present swaps the canvas buffers after the replay
+    void EndFrame(bool present = true);
+
+    // Runs on the render thread after everything submitted before
+    void Post(std::function<void()> task);
+    // As Post(), and waits for it; runs at once when called on the render thread
+    void Invoke(const std::function<void()>& task);
+    // Waits until everything submitted so far has run
+    void Flush();
+
+    bool IsRenderThread() const;
+
+    inline uint64_t GetSubmittedFrames() const { return m_submittedFrames; }
+    inline uint64_t GetCompletedFrames() const { return m_completedFrames.load(std::memory_order_acquire); }
+    inline double GetLastReplayMs() const { return m_lastReplayMs.load(std::memory_order_relaxed); }  ///< Replay and swap of the last frame
+
+private:
+    struct Item {
+        std::function<void()> task;            ///< Empty for a frame
+        bwxGLCommandBuffer* frame = nullptr;
+        bool present = false;
+        uint64_t sequence = 0;
+    };
+
+    void ThreadLoop();
+    uint64_t Enqueue(Item item);
+    void WaitFor(uint64_t sequence);
+
+    wxGLCanvas* m_canvas = nullptr;
+    wxGLContext* m_context = nullptr;
+    std::thread m_thread;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;  ///< Render thread: new item or stop
+    std::condition_variable m_done;  ///< Waiting threads: an item has run
+    std::deque<Item> m_queue;
+    uint64_t m_enqueued = 0;
+    uint64_t m_executed = 0;
+    bool m_stopping = false;
+    bool m_started = false;
+    bool m_startOK = false;
+
+    bwxGLCommandBuffer m_buffers[bwxGL_RENDER_THREAD_FRAMES];
+    uint64_t m_bufferSequence[bwxGL_RENDER_THREAD_FRAMES] = {};  ///< Item that last replayed the buffer
+    size_t m_recording = 0;
+    bool m_inFrame = false;
+
+    uint64_t m_submittedFrames = 0;
+    std::atomic<uint64_t> m_completedFrames{0};
+    std::atomic<double> m_lastReplayMs{0.0};
+};
+
+}  // namespace bwx_sdk
+
+#endif
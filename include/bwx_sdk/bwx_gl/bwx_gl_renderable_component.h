@@ -20,6 +20,10 @@
 #include "bwx_gl_component.h"
 #include "bwx_gl_material.h"
 #include "bwx_gl_buffer.h"
+#include "bwx_gl_mesh.h"
+#include "bwx_gl_lod.h"
+#include "bwx_gl_shader.h"
+#include "bwx_gl_skeleton.h"
 #include "bwx_gl_render_system.h"
 
 namespace bwx_sdk {
@@ -34,6 +38,7 @@ namespace bwx_sdk {
 
         // Dodajemy komponent renderowania do wza
         std::shared_ptr<bwxGLRenderableComponent> renderComponent = node->AddComponent<bwxGLRenderableComponent>(material, buffer);
+        bwxGLRenderSystem::GetInstance().RegisterRenderable(renderComponent);
 
         // Aktualizacja i renderowanie
         node->Update(0.016f); // Przykadowe deltaTime
@@ -44,14 +49,10 @@ namespace bwx_sdk {
     public:
 
 		bwxGLRenderableComponent() = default;
+        // Not registered here: shared_from_this() is not usable in a constructor or destructor. Call
+        // bwxGLRenderSystem::RegisterRenderable(), which keeps the component alive until UnregisterRenderable()
         bwxGLRenderableComponent(std::shared_ptr<bwxGLMaterial> material, std::shared_ptr<bwxGLBuffer> buffer)
-            : m_material(material), m_buffer(buffer) {
-            bwxGLRenderSystem::GetInstance().RegisterRenderable(shared_from_this());
-        }
-
-        ~bwxGLRenderableComponent() {
-            bwxGLRenderSystem::GetInstance().UnregisterRenderable(shared_from_this());
-        }
+            : m_material(material), m_buffer(buffer) {}
 
         inline void SetMaterial(std::shared_ptr<bwxGLMaterial> material) { m_material = material; }
         inline std::shared_ptr<bwxGLMaterial> GetMaterial() const { return m_material; }
@@ -59,11 +60,55 @@ namespace bwx_sdk {
         inline void SetBuffer(std::shared_ptr<bwxGLBuffer> buffer) { m_buffer = buffer; }
         inline std::shared_ptr<bwxGLBuffer> GetBuffer() const { return m_buffer; }
 
+        inline void SetMesh(std::shared_ptr<bwxGLMesh> mesh) { m_mesh = mesh; m_worldBoundsDirty = true; }
+        inline std::shared_ptr<bwxGLMesh> GetMesh() const { return m_mesh; }
+
+        // Level 0 of the chain becomes the mesh when none is set
+        void SetLODChain(std::shared_ptr<bwxGLLODChain> chain);
+        inline std::shared_ptr<bwxGLLODChain> GetLODChain() const { return m_lodChain; }
+        void SelectLOD(float screenSize);
+        inline size_t GetLODLevel() const { return m_lodLevel; }
+
+        // Mesh drawn this frame: the selected LOD, or the mesh itself
+        bwxGLMesh* GetActiveMesh() const;
+
+        inline void SetShaderProgram(std::shared_ptr<bwxGLShaderProgram> shader) { m_shader = shader; }
+        inline std::shared_ptr<bwxGLShaderProgram> GetShaderProgram() const { return m_shader; }
+
+        // Skinned meshes: the render system packs the skeleton's palette for the skinning shader
+        inline void SetSkeleton(std::shared_ptr<bwxGLSkeleton> skeleton) { m_skeleton = skeleton; }
+        inline const std::shared_ptr<bwxGLSkeleton>& GetSkeleton() const { return m_skeleton; }
+
+        GLuint GetVAO() const;
+        inline bool HasGeometry() const { return m_mesh || m_lodChain || m_buffer; }  ///< Without touching GL or the LOD state
+        glm::mat4 GetModelMatrix() const;
+
+        // Refreshes cached world matrix and bounds (bounds only when the transform changed)
+        void UpdateWorldState();
+        inline const glm::mat4& GetWorldMatrix() const { return m_worldMatrix; }
+        inline const bwxGLBoundingBox& GetWorldBounds() const { return m_worldBounds; }
+
         void Render() override;
+        void Draw() const; // Draw call only, state is bound by the render queue
+        void DrawInstanced(GLsizei instances) const;
+
+        // True when the shader takes the model matrix from instance attributes
+        inline bool IsInstanced() const { return m_mesh && m_shader && m_shader->IsInstanced(); }
 
     private:
         std::shared_ptr<bwxGLMaterial> m_material;
         std::shared_ptr<bwxGLBuffer> m_buffer;
+        std::shared_ptr<bwxGLMesh> m_mesh;
+        std::shared_ptr<bwxGLShaderProgram> m_shader;
+        std::shared_ptr<bwxGLSkeleton> m_skeleton;
+
+        std::shared_ptr<bwxGLLODChain> m_lodChain;
+        size_t m_lodLevel = 0;
+
+        glm::mat4 m_worldMatrix = glm::mat4(1.0f);
+        bwxGLBoundingBox m_worldBounds;
+        unsigned int m_worldBoundsVersion = 0;
+        bool m_worldBoundsDirty = true;
     };
 
 } // namespace bwx_sdk
@@ -20,12 +20,23 @@
 #include <wx/wx.h>
 #endif
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <string>
 #include <chrono>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include <bwx_sdk/bwx_core/bwx_file_watcher.h>
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
 
 namespace bwx_sdk {
 
@@ -43,6 +54,37 @@ namespace bwx_sdk {
         virtual bool LoadFromFile(const std::string& filename) { return false; } // optional override
     };
 
+#define bwxGL_HANDLE_INDEX_BITS 20  // Up to ~1M live resources per manager; the rest is the generation
+#define bwxGL_HANDLE_INDEX_MASK ((1u << bwxGL_HANDLE_INDEX_BITS) - 1u)
+#define bwxGL_HANDLE_GENERATION_MASK ((1u << (32 - bwxGL_HANDLE_INDEX_BITS)) - 1u)
+
+    /**
+     * @brief 32-bit slot index + generation into a bwxGLResourceManager.
+     *
+     * Resolve the name once with GetHandle() and keep the handle; Resolve() is then an array
+     * access with no hashing or reference counting. Deleting the resource bumps the slot's
+     * generation, so an old handle resolves to nullptr instead of to whatever reuses the slot.
+     */
+    struct bwxGLResourceHandle {
+        uint32_t value = 0;  ///< 0 is the null handle
+
+        inline bool IsValid() const { return value != 0; }
+        inline uint32_t GetIndex() const { return value & bwxGL_HANDLE_INDEX_MASK; }
+        inline uint32_t GetGeneration() const { return value >> bwxGL_HANDLE_INDEX_BITS; }
+
+        bool operator==(const bwxGLResourceHandle& other) const { return value == other.value; }
+        bool operator!=(const bwxGLResourceHandle& other) const { return value != other.value; }
+    };
+
+    /**
+     * @brief Managed resources by name, optionally with shared ownership, expiry and hot reload.
+     *
+     * Concurrent mode (SetConcurrent) lets worker threads look resources up and ask for loads.
+     * Everything that changes the manager still runs on the owner thread - the one that enabled
+     * the mode, normally the GL thread - so the owner reads without locking and only takes the
+     * exclusive lock for its own writes. Lookups from other threads take the shared lock. A load
+     * asked for off the owner thread is queued and done by ProcessLoadRequests().
+     */
     template <typename bwxGLResourceType>
     class bwxGLResourceManager {
     public:
@@ -55,16 +97,85 @@ namespace bwx_sdk {
         }
 
         virtual ~bwxGLResourceManager() {
+            // Singleton managers die after wxApp::OnExit() shut the watcher down
+            if (!bwxFileWatcher::GetInstance().IsShutDown()) bwxFileWatcher::GetInstance().UnwatchAll(this);
             Clear();
         }
 
+        /*
+            Files are watched by bwxFileWatcher when it is available; then CheckHotReload() only
+            reloads the files reported as changed. Before the event loop runs, the manager
+            falls back to comparing write times of every file.
+        */
         void EnableHotReload(bool enabled) {
+            if (enabled == m_enableHotReload) return;
             m_enableHotReload = enabled;
+            m_pollHotReload = false;
+
+            if (!enabled) {
+                bwxFileWatcher::GetInstance().UnwatchAll(this);
+                return;
+            }
+            for (const auto& [name, path] : m_filenames) {
+                WatchFile(name, path);
+            }
+        }
+
+        bool IsHotReloadEnabled() const {
+            return m_enableHotReload;
+        }
+
+        // Call on the owner thread before any worker uses the manager
+        void SetConcurrent(bool enabled) {
+            m_ownerThread = std::this_thread::get_id();
+            m_concurrent = enabled;
+        }
+
+        bool IsConcurrent() const {
+            return m_concurrent;
+        }
+
+        bool IsOwnerThread() const {
+            return !m_concurrent || std::this_thread::get_id() == m_ownerThread;
+        }
+
+        // Any thread; a name already loaded or queued is not queued again
+        void RequestLoad(const std::string& name, const std::string& filename) {
+            QueueRequest(name, [this, name, filename]() { Load(name, filename); });
+        }
+
+        // Owner thread, once per frame; returns the number of requests done
+        size_t ProcessLoadRequests(size_t maxCount = SIZE_MAX) {
+            std::vector<std::pair<std::string, std::function<void()>>> requests;
+            {
+                std::lock_guard<std::mutex> lock(m_requestMutex);
+                while (!m_requests.empty() && requests.size() < maxCount) {
+                    requests.push_back(std::move(m_requests.front()));
+                    m_requests.pop_front();
+                }
+            }
+
+            // Removed from the set only after the load, so Has() or the set covers the name meanwhile
+            for (auto& [name, load] : requests) {
+                load();
+                std::lock_guard<std::mutex> lock(m_requestMutex);
+                m_requested.erase(name);
+            }
+            return requests.size();
+        }
+
+        size_t GetPendingLoadCount() const {
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            return m_requests.size();
         }
 
+        // Call at a safe point of the frame, on the GL thread
         void CheckHotReload() {
             if (!m_enableHotReload) return;
 
+            bwxFileWatcher::GetInstance().Dispatch(this);
+            if (!m_pollHotReload) return;
+
             for (const auto& [name, path] : m_filenames) {
                 auto lastWriteTime = std::filesystem::last_write_time(path);
                 if (m_fileWriteTimes[name] != lastWriteTime) {
@@ -76,6 +187,10 @@ namespace bwx_sdk {
         }
 
         bwxGLResourcePtr Load(const std::string& name, const std::string& filename) {
+            if (!IsOwnerThread()) {
+                return GetOrLoad(name, filename);
+            }
+
             CleanUp();
 
             if (auto existing = Get(name)) {
@@ -83,16 +198,20 @@ namespace bwx_sdk {
             }
 
             bwxGLResourcePtr resource = std::make_shared<bwxGLResourceType>();
-            if (!resource->LoadFromFile(filename)) {
+            const auto loadStart = Clock::now();
+            const bool loaded = resource->LoadFromFile(filename);
+            RecordTime(m_metricLoadTime, loadStart);
+            if (!loaded) {
                 wxLogError("[ResourceManager] Failed to load resource: %s", filename);
                 return nullptr;
             }
 
             if (m_useSharedOwnership || m_autoExpireSeconds >= 0) {
-                m_resources[name] = resource;
+                StoreResource(name, resource);
                 m_timestamps[name] = Clock::now();
                 m_filenames[name] = filename;
                 m_fileWriteTimes[name] = std::filesystem::last_write_time(filename);
+                if (m_enableHotReload) WatchFile(name, filename);
             }
 
             return resource;
@@ -100,8 +219,15 @@ namespace bwx_sdk {
 
         bwxGLResourcePtr GetOrLoad(const std::string& name, const std::string& filename) {
             if (auto res = Get(name)) {
+                CountLookup(true);
                 return res;
             }
+            CountLookup(false);
+            if (!IsOwnerThread()) {
+                // Get() again once ProcessLoadRequests() has run
+                RequestLoad(name, filename);
+                return nullptr;
+            }
             return Load(name, filename);
         }
 
@@ -110,12 +236,15 @@ namespace bwx_sdk {
             if (it == m_filenames.end()) return false;
 
             bwxGLResourcePtr resource = std::make_shared<bwxGLResourceType>();
-            if (!resource->LoadFromFile(it->second)) {
+            const auto loadStart = Clock::now();
+            const bool loaded = resource->LoadFromFile(it->second);
+            RecordTime(m_metricReloadTime, loadStart);
+            if (!loaded) {
                 wxLogError("[ResourceManager] Failed to reload resource: %s", name);
                 return false;
             }
 
-            m_resources[name] = resource;
+            StoreResource(name, resource);
             m_timestamps[name] = Clock::now();
             m_fileWriteTimes[name] = std::filesystem::last_write_time(it->second);
             return true;
@@ -128,6 +257,13 @@ namespace bwx_sdk {
         }
 
         bwxGLResourcePtr Acquire(const std::string& name) {
+            if (!IsOwnerThread()) {
+                // No clean-up and no expiry reset from here, both write
+                auto lock = ReadLock();
+                auto it = m_resources.find(name);
+                return it != m_resources.end() ? it->second : nullptr;
+            }
+
             CleanUp();
             auto it = m_resources.find(name);
             if (it != m_resources.end()) {
@@ -144,6 +280,7 @@ namespace bwx_sdk {
         }
 
         bool Has(const std::string& name) const {
+            auto lock = ReadLock();
             return m_resources.find(name) != m_resources.end();
         }
 
@@ -152,7 +289,7 @@ namespace bwx_sdk {
         }
 
         void KeepAlive(const std::string& name, bwxGLResourcePtr resource) {
-            m_resources[name] = resource;
+            StoreResource(name, resource);
             m_timestamps[name] = Clock::now();
         }
 
@@ -182,8 +319,9 @@ namespace bwx_sdk {
                 if (it->second) {
                     it->second->Unload();
                 }
-                m_resources.erase(it);
+                EraseResource(it);
                 m_timestamps.erase(name);
+                UnwatchFile(name);
                 m_filenames.erase(name);
                 m_fileWriteTimes.erase(name);
             }
@@ -195,8 +333,11 @@ namespace bwx_sdk {
                     resource->Unload();
                 }
             }
-            m_resources.clear();
+            ClearResources();
             m_timestamps.clear();
+            for (const auto& [name, path] : m_filenames) {
+                bwxFileWatcher::GetInstance().Unwatch(path, this);
+            }
             m_filenames.clear();
             m_fileWriteTimes.clear();
         }
@@ -209,6 +350,7 @@ namespace bwx_sdk {
         }
 
         int GetCount() const {
+            auto lock = ReadLock();
             return static_cast<int>(m_resources.size());
         }
 
@@ -236,7 +378,91 @@ namespace bwx_sdk {
             return m_resetOnAccess;
         }
 
+        // Handles: string lookup once, array indexing afterwards
+
+        // Off the owner thread only handles that already exist are returned
+        bwxGLResourceHandle GetHandle(const std::string& name) {
+            if (!IsOwnerThread()) {
+                auto lock = ReadLock();
+                auto slot = m_slotByName.find(name);
+                return slot != m_slotByName.end() ? MakeHandle(slot->second) : bwxGLResourceHandle();
+            }
+
+            auto it = m_resources.find(name);
+            if (it == m_resources.end()) return bwxGLResourceHandle();
+
+            auto slot = m_slotByName.find(name);
+            if (slot != m_slotByName.end()) return MakeHandle(slot->second);
+
+            auto lock = WriteLock();
+            uint32_t index;
+            if (!m_freeSlots.empty()) {
+                index = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            else {
+                if (m_slots.size() > bwxGL_HANDLE_INDEX_MASK) {
+                    wxLogError("[ResourceManager] Out of handle slots for: %s", name);
+                    return bwxGLResourceHandle();
+                }
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
+            }
+
+            m_slots[index].resource = it->second;
+            m_slots[index].name = name;
+            m_slotByName.emplace(name, index);
+            return MakeHandle(index);
+        }
+
+        // No reference is taken; keep the handle, not the pointer, across frames
+        bwxGLResourceType* Resolve(bwxGLResourceHandle handle) const {
+            auto lock = ReadLock();
+            const uint32_t index = handle.GetIndex();
+            if (!handle.IsValid() || index >= m_slots.size() || m_slots[index].generation != handle.GetGeneration()) return nullptr;
+            return m_slots[index].resource.get();
+        }
+
+        bwxGLResourcePtr Acquire(bwxGLResourceHandle handle) const {
+            auto lock = ReadLock();
+            const uint32_t index = handle.GetIndex();
+            if (!handle.IsValid() || index >= m_slots.size() || m_slots[index].generation != handle.GetGeneration()) return nullptr;
+            return m_slots[index].resource;
+        }
+
+        bool IsAlive(bwxGLResourceHandle handle) const {
+            return Resolve(handle) != nullptr;
+        }
+
+        void Bind(bwxGLResourceHandle handle) {
+            if (auto resource = Resolve(handle)) {
+                resource->Bind();
+            }
+        }
+
     protected:
+        /*
+            Publishes <prefix>.hits / .misses (GetOrLoad), .load_ms / .reload_ms and .count
+            through bwxMetrics; called once from the derived manager's constructor.
+        */
+        void EnableMetrics(const std::string& prefix) {
+            bwxMetrics& metrics = bwxMetrics::GetInstance();
+            m_metricHits = &metrics.GetCounter(prefix + ".hits");
+            m_metricMisses = &metrics.GetCounter(prefix + ".misses");
+            m_metricLoadTime = &metrics.GetHistogram(prefix + ".load_ms");
+            m_metricReloadTime = &metrics.GetHistogram(prefix + ".reload_ms");
+            m_metricCount = &metrics.GetGauge(prefix + ".count");
+        }
+
+        void CountLookup(bool hit) {
+            bwxMetricCounter* counter = hit ? m_metricHits : m_metricMisses;
+            if (counter) counter->Add();
+        }
+
+        void RecordTime(bwxMetricHistogram* histogram, TimePoint start) {
+            if (histogram) histogram->Record(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+
         void CleanUp() {
             auto now = Clock::now();
 
@@ -246,7 +472,9 @@ namespace bwx_sdk {
 
                 bool remove = false;
 
-                if (!m_useSharedOwnership && (!res || res.use_count() == 1)) {
+                // A handle slot holds the second reference
+                const long owners = m_slotByName.count(name) ? 2 : 1;
+                if (!m_useSharedOwnership && (!res || res.use_count() <= owners)) {
                     remove = true;
                 }
 
@@ -261,9 +489,10 @@ namespace bwx_sdk {
                 }
 
                 if (remove) {
-                    it = m_resources.erase(it);
+                    UnwatchFile(name);
                     m_timestamps.erase(name);
                     m_filenames.erase(name);
+                    it = EraseResource(it);
                     m_fileWriteTimes.erase(name);
                 }
                 else {
@@ -272,6 +501,75 @@ namespace bwx_sdk {
             }
         }
 
+        // Derived managers change m_resources through these, so handles follow replacements and removals
+
+        void StoreResource(const std::string& name, bwxGLResourcePtr resource) {
+            auto lock = WriteLock();
+            m_resources[name] = resource;
+            auto slot = m_slotByName.find(name);
+            if (slot != m_slotByName.end()) m_slots[slot->second].resource = resource;
+            if (m_metricCount) m_metricCount->Set(static_cast<int64_t>(m_resources.size()));
+        }
+
+        typename std::unordered_map<std::string, bwxGLResourcePtr>::iterator EraseResource(
+            typename std::unordered_map<std::string, bwxGLResourcePtr>::iterator it) {
+            auto lock = WriteLock();
+            FreeSlot(it->first);
+            auto next = m_resources.erase(it);
+            if (m_metricCount) m_metricCount->Set(static_cast<int64_t>(m_resources.size()));
+            return next;
+        }
+
+        void EraseResource(const std::string& name) {
+            auto it = m_resources.find(name);
+            if (it != m_resources.end()) EraseResource(it);
+        }
+
+        void ClearResources() {
+            auto lock = WriteLock();
+            for (const auto& [name, index] : m_slotByName) {
+                ReleaseSlot(index);
+            }
+            m_slotByName.clear();
+            m_resources.clear();
+            if (m_metricCount) m_metricCount->Set(0);
+        }
+
+        void WatchFile(const std::string& name, const std::string& path) {
+            // The name is captured, Reload() finds the path again in case it was changed meanwhile
+            if (!bwxFileWatcher::GetInstance().Watch(path, this, [this, name](const std::string&) {
+                    if (Reload(name)) wxLogMessage("[ResourceManager] Hot reloaded resource: %s", name);
+                })) {
+                m_pollHotReload = true;
+            }
+        }
+
+        void UnwatchFile(const std::string& name) {
+            auto it = m_filenames.find(name);
+            if (it != m_filenames.end()) bwxFileWatcher::GetInstance().Unwatch(it->second, this);
+        }
+
+        // The owner thread writes; it reads unlocked, other threads share the lock
+        std::shared_lock<std::shared_mutex> ReadLock() const {
+            if (IsOwnerThread()) return std::shared_lock<std::shared_mutex>();
+            return std::shared_lock<std::shared_mutex>(m_mutex);
+        }
+
+        std::unique_lock<std::shared_mutex> WriteLock() {
+            if (!m_concurrent) return std::unique_lock<std::shared_mutex>();
+            return std::unique_lock<std::shared_mutex>(m_mutex);
+        }
+
+        // Any thread; load runs on the owner thread in ProcessLoadRequests(). False if the name is known already
+        bool QueueRequest(const std::string& name, std::function<void()> load) {
+            if (Has(name)) return false;
+
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            if (!m_requested.insert(name).second) return false;
+            m_requests.emplace_back(name, std::move(load));
+            return true;
+        }
+
         std::unordered_map<std::string, bwxGLResourcePtr> m_resources;
         std::unordered_map<std::string, TimePoint> m_timestamps;
         std::unordered_map<std::string, std::string> m_filenames;
@@ -280,6 +578,56 @@ namespace bwx_sdk {
         int m_autoExpireSeconds;
         bool m_resetOnAccess;
         bool m_enableHotReload;
+        bool m_pollHotReload = false;  ///< Some file could not be watched, CheckHotReload() compares write times
+
+        std::atomic<bool> m_concurrent{ false };
+        std::thread::id m_ownerThread;
+        mutable std::shared_mutex m_mutex;  ///< Guards m_resources and the handle slots in concurrent mode
+
+        mutable std::mutex m_requestMutex;
+        std::deque<std::pair<std::string, std::function<void()>>> m_requests;
+        std::unordered_set<std::string> m_requested;  ///< Queued or being loaded
+
+        // Null until EnableMetrics(); owned by bwxMetrics
+        bwxMetricCounter* m_metricHits = nullptr;
+        bwxMetricCounter* m_metricMisses = nullptr;
+        bwxMetricHistogram* m_metricLoadTime = nullptr;
+        bwxMetricHistogram* m_metricReloadTime = nullptr;
+        bwxMetricGauge* m_metricCount = nullptr;
+
+    private:
+        struct Slot {
+            bwxGLResourcePtr resource;
+            std::string name;
+            uint32_t generation = 1;
+        };
+
+        bwxGLResourceHandle MakeHandle(uint32_t index) const {
+            bwxGLResourceHandle handle;
+            handle.value = (m_slots[index].generation << bwxGL_HANDLE_INDEX_BITS) | index;
+            return handle;
+        }
+
+        void ReleaseSlot(uint32_t index) {
+            Slot& slot = m_slots[index];
+            slot.resource.reset();
+            slot.name.clear();
+            // Generation 0 is skipped, so a live handle is never 0
+            slot.generation = (slot.generation + 1) & bwxGL_HANDLE_GENERATION_MASK;
+            if (slot.generation == 0) slot.generation = 1;
+            m_freeSlots.push_back(index);
+        }
+
+        void FreeSlot(const std::string& name) {
+            auto it = m_slotByName.find(name);
+            if (it == m_slotByName.end()) return;
+            ReleaseSlot(it->second);
+            m_slotByName.erase(it);
+        }
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::unordered_map<std::string, uint32_t> m_slotByName;
     };
 
 } // namespace bwx_sdk
@@ -0,0 +1,84 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_ring_buffer.h
+// Purpose:     BWX_SDK Library; OpenGL Persistent-mapped ring buffer
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_RING_BUFFER_H_
+#define _BWX_GL_RING_BUFFER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "bwx_gl_buffer.h"
+
+#define bwxGL_RING_BUFFER_REGIONS 3
+
+namespace bwx_sdk {
+
+/**
+ * @brief Streaming buffer split into regions written by the CPU while the GPU reads older ones.
+ *
+ * Uses glBufferStorage with a persistent, coherent mapping. A fence closes every region,
+ * so a region is only overwritten after the GPU is done with it. Without
+ * GL_ARB_buffer_storage it falls back to a staging copy and glBufferSubData on Commit().
+ *
+ * @code
+ * GLintptr offset;
+ * void* dst = ring.Allocate(size, alignment, offset);
+ * memcpy(dst, src, size);
+ * ring.Commit(offset, size);
+ * ring.BindRange(GL_UNIFORM_BUFFER, 0, offset, size);
+ * ...
+ * ring.Advance(); // once per frame
+ * @endcode
+ */
+class bwxGLRingBuffer : public bwxGLBuffer {
+public:
+    bwxGLRingBuffer(GLenum target, GLsizeiptr regionSize, GLuint regions = bwxGL_RING_BUFFER_REGIONS);
+    bwxGLRingBuffer(GLenum target, GLsizeiptr regionSize, GLsizei stride, const std::vector<GLint>& layout,
+                    GLuint regions = bwxGL_RING_BUFFER_REGIONS);
+    virtual ~bwxGLRingBuffer();
+
+    void Release() override;
+
+    void* Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset);
+    void Commit(GLintptr offset, GLsizeiptr size);
+
+    GLintptr Write(const void* data, GLsizeiptr size, GLsizeiptr alignment = 1);
+
+    void BindRange(GLenum target, GLuint index, GLintptr offset, GLsizeiptr size) const;
+
+    void Advance();
+
+    inline GLsizeiptr GetRegionSize() const { return m_regionSize; }
+    inline bool IsPersistent() const { return m_persistent; }
+
+    static GLsizeiptr GetUniformAlignment();
+
+private:
+    void Init(GLsizeiptr regionSize, GLuint regions);
+    void WaitForRegion(GLuint region);
+
+    GLsizeiptr m_regionSize = 0;
+    GLuint m_regionCount = 0;
+    GLuint m_region = 0;
+    GLsizeiptr m_head = 0;
+
+    bool m_persistent = false;
+    unsigned char* m_mapped = nullptr;
+    std::vector<unsigned char> m_staging;  ///< Fallback storage (no GL_ARB_buffer_storage)
+    std::vector<GLsync> m_fences;
+};
+
+}  // namespace bwx_sdk
+
+#endif
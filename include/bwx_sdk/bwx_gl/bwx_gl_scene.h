@@ -22,16 +22,22 @@
 
 // #include "bwx_gl_camera.h"
 // #include "bwx_gl_light.h"
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "bwx_gl_bvh.h"
 #include "bwx_gl_mesh.h"
 #include "bwx_gl_model.h"
+#include "bwx_gl_movement_system.h"
 #include "bwx_gl_node.h"
 
 namespace bwx_sdk {
 
+class bwxGLRenderableComponent;  // Forward declaration
+
 class bwxGLScene {
 public:
     bwxGLScene();
@@ -57,7 +63,43 @@ public:
     inline void SetRoot(std::shared_ptr<bwxGLNode> root) { m_root = root; }
     inline std::shared_ptr<bwxGLNode> GetRoot() const { return m_root; }
 
+    // Main-thread-only components first, then independent subtrees on bwxJobSystem workers,
+    // then movement (bwxGLMovementSystem) and world matrices (bwxGLTransformSystem)
+    void Update(float deltaTime, bool parallel = true);
+
+    // Fixed timestep and interpolation of this scene's movement components
+    inline bwxGLMovementSystem& GetMovementSystem() { return m_movementSystem; }
+
+    // Renderables under the root in a bwxGLBVH, refreshed at the end of Update(); only objects whose
+    // bounds left their fat box are reinserted. Pass it to bwxGLRenderSystem::SetSpatialIndex() for culling
+    void SetSpatialIndexing(bool enable);
+    inline bool IsSpatialIndexing() const { return m_spatialIndexing; }
+    inline const bwxGLBVH& GetSpatialIndex() const { return m_bvh; }
+    // Renderables without valid bounds yet; never culled, pass them to SetSpatialIndex() along with the tree
+    inline const std::vector<bwxGLRenderableComponent*>& GetUnboundedRenderables() const { return m_unbounded; }
+    void UpdateSpatialIndex();
+
+    // Queries against the boxes of the renderables (as of the last Update()); results are appended
+    void QueryFrustum(const bwxGLFrustum& frustum, std::vector<bwxGLRenderableComponent*>& out) const;
+    void QueryBox(const bwxGLBoundingBox& box, std::vector<bwxGLRenderableComponent*>& out) const;
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<bwxGLRenderableComponent*>& out) const;
+
+    // Nearest renderable whose world box the ray hits, nullptr if none
+    bwxGLRenderableComponent* Pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                   float* distance = nullptr) const;
+
 private:
+    struct SpatialProxy {
+        int32_t proxy;
+        uint64_t pass;  ///< Last UpdateSpatialIndex() that found the renderable
+    };
+
+    void IndexSubtree(const std::shared_ptr<bwxGLNode>& node);
+    static void ToRenderables(const std::vector<void*>& items, std::vector<bwxGLRenderableComponent*>& out);
+
+    void UpdateMainThread(const std::shared_ptr<bwxGLNode>& node, float deltaTime);
+    void UpdateSubtree(const std::shared_ptr<bwxGLNode>& node, float deltaTime, bool parallel);
+
     // std::vector<std::shared_ptr<bwxGLCamera>> m_cameras;
     // std::vector<std::shared_ptr<bwxGLLight>> m_lights;
     std::vector<std::shared_ptr<bwxGLModel>> m_models;
@@ -66,6 +108,13 @@ private:
     int m_activeCameraIndex = 0;
 
     std::shared_ptr<bwxGLNode> m_root;
+    bwxGLMovementSystem m_movementSystem;
+
+    bool m_spatialIndexing = true;
+    bwxGLBVH m_bvh;
+    std::unordered_map<bwxGLRenderableComponent*, SpatialProxy> m_proxies;
+    std::vector<bwxGLRenderableComponent*> m_unbounded;
+    uint64_t m_indexPass = 0;
 };
 
 }  // namespace bwx_sdk
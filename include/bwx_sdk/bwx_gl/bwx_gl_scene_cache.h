@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_scene_cache.h
+// Purpose:     BWX_SDK Library; OpenGL Cooked binary scene cache
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_SCENE_CACHE_H_
+#define _BWX_GL_SCENE_CACHE_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bwx_gl_bounds.h"
+#include "bwx_gl_mesh.h"
+#include "bwx_gl_texture.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_SCENE_CACHE_VERSION 1         // Bump whenever the file layout or the vertex encodings change
+#define bwxGL_SCENE_CACHE_EXT ".bwxscene"
+
+/**
+ * @brief Processed scene written after an import, so that later loads skip Assimp entirely.
+ *
+ * The file holds the node hierarchy, the material table and, per mesh, the vertex and index blobs
+ * exactly as bwxGLMesh uploads them. Open() memory-maps it; mesh blobs then point into the mapping
+ * and go to bwxGLMesh::SetupMesh(layout, data, ...) without any conversion. The header stores the
+ * format version, a hash of the source file and the loader/Assimp flags - any mismatch makes
+ * Open() fail, and the caller imports the source again.
+ */
+class bwxGLSceneCache {
+public:
+    struct Texture {
+        bwxGL_TEXTURE_TYPE type;
+        std::string path;
+    };
+
+    struct Material {
+        glm::vec4 ambient = glm::vec4(0.0f);
+        glm::vec4 diffuse = glm::vec4(0.0f);
+        glm::vec4 specular = glm::vec4(0.0f);
+        float shininess = 0.0f;
+        std::vector<Texture> textures;
+    };
+
+    struct Node {
+        std::string name;
+        int32_t parent = -1;  ///< Index into GetNodes(), -1 for children of the scene root
+        glm::mat4 transform = glm::mat4(1.0f);
+        uint32_t firstMesh = 0;
+        uint32_t meshCount = 0;
+    };
+
+    struct Mesh {
+        int style = 0;  ///< bwxGLMesh style; the layout is rebuilt from it
+        uint32_t material = 0;
+        GLsizei vertexCount = 0;
+        GLsizei indexCount = 0;
+        GLenum indexType = GL_UNSIGNED_INT;
+        GLsizei stride = 0;
+        bwxGLBoundingBox bounds;
+        const unsigned char* vertices = nullptr;  ///< Into the mapping after Open(), into the blobs below when cooking
+        const unsigned char* indices = nullptr;
+        std::vector<unsigned char> vertexBlob;
+        std::vector<unsigned char> indexBlob;
+    };
+
+    bwxGLSceneCache();
+    ~bwxGLSceneCache();
+
+    bwxGLSceneCache(const bwxGLSceneCache&) = delete;
+    bwxGLSceneCache& operator=(const bwxGLSceneCache&) = delete;
+
+    static std::string GetCachePath(const std::string& source);  ///< Source path + bwxGL_SCENE_CACHE_EXT
+    static uint64_t HashFile(const std::string& path);           ///< 0 if the file cannot be read
+
+    // Reading
+    bool Open(const std::string& path, uint64_t sourceHash, unsigned int loaderFlags, unsigned int assimpFlags);
+    void Close();
+
+    // Cooking; meshes go to the node added last
+    void Clear();
+    uint32_t AddNode(const std::string& name, int32_t parent, const glm::mat4& transform);
+    bool AddMesh(const bwxGLMesh& mesh, uint32_t material);
+    uint32_t AddMaterial(const Material& material);
+    bool Write(const std::string& path, uint64_t sourceHash, unsigned int loaderFlags, unsigned int assimpFlags) const;
+
+    inline const std::vector<Node>& GetNodes() const { return m_nodes; }
+    inline const std::vector<Mesh>& GetMeshes() const { return m_meshes; }
+    inline const std::vector<Material>& GetMaterials() const { return m_materials; }
+
+private:
+    class MappedFile;
+
+    std::unique_ptr<MappedFile> m_file;
+    std::vector<Node> m_nodes;
+    std::vector<Mesh> m_meshes;
+    std::vector<Material> m_materials;
+};
+
+}  // namespace bwx_sdk
+
+#endif
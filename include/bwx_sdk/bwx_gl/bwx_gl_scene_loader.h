@@ -14,10 +14,12 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <functional>
 #include <vector>
 #include <iostream>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
@@ -31,7 +33,11 @@
 //#include "bwx_gl_camera.h"
 //#include "bwx_gl_light.h"
 #include "bwx_gl_scene.h"
+#include "bwx_gl_scene_cache.h"
+#include "bwx_gl_skeleton.h"
+#include "bwx_gl_animation.h"
 #include "bwx_gl_material.h"
+#include "bwx_gl_shader_generator.h"
 
 namespace bwx_sdk
 {
@@ -42,6 +48,7 @@ namespace bwx_sdk
 #define bwxGL_SCENE_LOADER_ANIMATIONS 0x00000008 ///< Load animations
 
 #define bwxGL_SCENE_LOADER_GEN_SHADERS 0x00080000 ///< Generate shaders
+#define bwxGL_SCENE_LOADER_CACHE 0x00100000 ///< Load from / write to the cooked binary cache (bwxGLSceneCache)
 #define bwxGL_SCENE_LOADER_CONV_BLENDER_COORDS 0x80000000 ///< Convert Blender coordinates
 
 	/**
@@ -71,6 +78,24 @@ namespace bwx_sdk
 		 * @return false if failed
 		 */
 		bool Load(const std::string& file, std::shared_ptr<bwxGLScene> scene, unsigned int flags = bwxGL_SCENE_LOADER_MODELS);
+
+		/**
+		 * @brief Reload a scene file whenever it changes
+		 *
+		 * The file is loaded into a new scene from bwxFileWatcher::Dispatch(), and the callback
+		 * swaps it in; a failed load leaves the current scene alone.
+		 *
+		 * @param file File path
+		 * @param flags Flags passed to Load()
+		 * @param onReloaded Receives the freshly loaded scene
+		 * @return false if the file cannot be watched
+		 */
+		static bool WatchScene(const std::string& file, unsigned int flags, std::function<void(std::shared_ptr<bwxGLScene>)> onReloaded);
+
+		/**
+		 * @brief Stop reloading a scene file
+		 */
+		static void UnwatchScene(const std::string& file);
 		
 		/**
 		 * @brief Load cameras from file
@@ -150,6 +175,19 @@ namespace bwx_sdk
 		 */
 		bool GetGenerateShaders() { return m_generateShaders; }
 
+		/**
+		 * @brief Set shader variant features used with the generate shaders flag
+		 *
+		 * Added to the normals, texcoords and skinning of each mesh (bwxGL_SHADER_VARIANT_LIGHTING by default);
+		 * meshes with the same combination share one program from bwxGLShaderGenerator::GetProgram().
+		 */
+		void SetShaderFeatures(uint32_t features) { this->m_shaderFeatures = features; }
+
+		/**
+		 * @brief Get shader variant features used with the generate shaders flag
+		 */
+		uint32_t GetShaderFeatures() const { return m_shaderFeatures; }
+
 		/**
 		 * @brief Set convert Blender coordinates flag
 		 */
@@ -202,6 +240,29 @@ namespace bwx_sdk
 		inline void SetPresetTargetRealtimeMaxQuality() { this->m_assimpFlags |= aiProcessPreset_TargetRealtime_MaxQuality; } ///< Default postprocess configuration optimizing the data for real-time rendering.
 
 	private:
+		/**
+		 * @brief Assimp mesh waiting for conversion (CPU phase) and upload (GL phase)
+		 */
+		struct PendingMesh
+		{
+			aiMesh* source = nullptr;
+			std::shared_ptr<bwxGLMesh> mesh; ///< Converted and prepared by ConvertMesh()
+			std::shared_ptr<const bwxGLSkeleton> skeleton; ///< Bone indices are resolved against it, nullptr for static meshes
+		};
+
+		/**
+		 * @brief Node that becomes a model, its meshes are a range of the pending meshes
+		 */
+		struct PendingNode
+		{
+			aiNode* source = nullptr;
+			glm::mat4 transform = glm::mat4(1.0f);
+			size_t firstMesh = 0;
+			size_t meshCount = 0;
+			std::shared_ptr<bwxGLSkeleton> skeleton; ///< Shared by the node's skinned meshes
+			std::vector<std::shared_ptr<bwxGLAnimationClip>> animations; ///< Scene animations bound to the skeleton
+		};
+
 		/**
 		 * @brief Process cameras
 		 *
@@ -225,7 +286,7 @@ namespace bwx_sdk
 		void ProcessModels(std::shared_ptr<bwxGLScene> scene, bool animation);
 
 		/**
-		 * @brief Process Assimp nodes
+		 * @brief Process Assimp nodes - collects the node and its meshes for the conversion jobs
 		 *
 		 * @param scene Scene object
 		 * @param parent Parent node
@@ -234,6 +295,40 @@ namespace bwx_sdk
 		 */
 		void ProcessAssimpNodes(std::shared_ptr<bwxGLScene> scene, std::shared_ptr<bwxGLNode> parent, aiNode* node, bool animation);
 
+		/**
+		 * @brief Convert Assimp mesh into a prepared bwxGLMesh; no GL calls, runs on the job system
+		 *
+		 * @param pending Pending mesh
+		 */
+		void ConvertMesh(PendingMesh& pending) const;
+
+		/**
+		 * @brief Build the skeleton of the bones referenced by the node's meshes
+		 *
+		 * Bone nodes and their ancestors are added in hierarchy order, so parents precede children.
+		 *
+		 * @param node Assimp node with skinned meshes
+		 * @return Skeleton, or nullptr when no mesh of the node has bones
+		 */
+		std::shared_ptr<bwxGLSkeleton> BuildSkeleton(const aiNode* node);
+
+		/**
+		 * @brief Convert the scene animations into clips for the given skeleton
+		 *
+		 * Channels of nodes outside the skeleton are skipped; animations without any remaining track are dropped.
+		 *
+		 * @param skeleton Skeleton the clip tracks refer to
+		 * @return Clips, in the order of the scene animations
+		 */
+		std::vector<std::shared_ptr<bwxGLAnimationClip>> BuildAnimations(const bwxGLSkeleton& skeleton) const;
+
+		/**
+		 * @brief Upload the converted meshes and create models and materials (GL thread)
+		 *
+		 * @param scene Scene object
+		 */
+		void BuildModels(std::shared_ptr<bwxGLScene> scene);
+
 		/**
 		 * @brief Process Assimp meshes
 		 *
@@ -253,11 +348,41 @@ namespace bwx_sdk
 		 */
 		void ProcessTexture(bwxGL_TEXTURE_TYPE type, std::shared_ptr<bwxGLMaterial> material, std::shared_ptr<bwxGLModel> model, const std::string& file);
 
+		/**
+		 * @brief Build models from a cooked scene
+		 *
+		 * @param cache Opened cache
+		 * @param scene Scene object
+		 * @return false if the cache does not fit the current vertex layouts
+		 */
+		bool LoadFromCache(const bwxGLSceneCache& cache, std::shared_ptr<bwxGLScene> scene);
+
+		/**
+		 * @brief Give the last mesh added to the model the shared program of its shader variant
+		 *
+		 * @param model Model the mesh was added to
+		 * @param mesh The mesh
+		 */
+		void AssignShaderProgram(std::shared_ptr<bwxGLModel> model, const bwxGLMesh& mesh);
+
+		/**
+		 * @brief Create material from a cooked material record
+		 */
+		std::shared_ptr<bwxGLMaterial> CreateMaterial(const bwxGLSceneCache::Material& cooked, std::shared_ptr<bwxGLModel> model);
+
 		const aiScene* m_assimpScene; ///< Assimp scene
 		unsigned int m_assimpFlags; ///< Assimp flags
 
 		bool m_generateShaders; ///< Generate shaders flag
+		uint32_t m_shaderFeatures = bwxGL_SHADER_VARIANT_LIGHTING; ///< Variant features on top of the mesh format
 		bool m_convertBlenderCoords; ///< Convert Blender coordinates flag
+		std::string m_directory; ///< Directory of the loaded file, texture paths are relative to it
+
+		std::vector<PendingNode> m_pendingNodes; ///< Models in ProcessModels()
+		std::vector<PendingMesh> m_pendingMeshes; ///< Meshes of all pending nodes
+
+		bwxGLSceneCache* m_cooking = nullptr; ///< Records the import while bwxGL_SCENE_LOADER_CACHE is set
+		std::unordered_map<unsigned int, uint32_t> m_cookedMaterials; ///< Assimp material index -> cache material
 	};
 }
 
@@ -22,11 +22,13 @@
 
 #include <GL/glew.h>
 
+#include <cstdint>
 #include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -35,8 +37,56 @@
 #define bwxGL_SHADER_EMPTY 0
 #define bwxGL_SHADER_PROGRAM_EMPTY 0
 
+// Per-instance model matrix (mat4 takes 4 consecutive locations)
+#define bwxGL_INSTANCE_MATRIX_ATTRIB "aInstanceModel"
+#define bwxGL_INSTANCE_MATRIX_LOCATION 6
+
+// Shared per-frame constants (view, projection, camera), see bwxGLFrameUniforms
+#define bwxGL_FRAME_UBO_BLOCK "FrameBlock"
+#define bwxGL_FRAME_UBO_BINDING 0
+#define bwxGL_LIGHTS_UBO_BLOCK "LightBlock"
+#define bwxGL_LIGHTS_UBO_BINDING 2
+
+// Parameters of the drawn material (std140), one range of the material UBO, see bwxGLMaterialParams
+#define bwxGL_MATERIAL_UBO_BLOCK "MaterialParams"
+#define bwxGL_MATERIAL_UBO_BINDING 1
+
+// Per-draw data of multi-draw-indirect batches, indexed by gl_DrawIDARB (std430), see bwxGLDrawData
+#define bwxGL_DRAW_DATA_SSBO_BLOCK "DrawDataBlock"
+#define bwxGL_DRAW_DATA_SSBO_BINDING 3
+
+// Packed materials indexed by bwxGLDrawData::info.y (std430), see bwxGLPackedMaterial
+#define bwxGL_MATERIAL_SSBO_BLOCK "MaterialBlock"
+#define bwxGL_MATERIAL_SSBO_BINDING 4
+#define bwxGL_TEXTURE_ARRAYS_UNIFORM "textureArrays"
+#define bwxGL_TEXTURE_ARRAY_FIRST_UNIT 8  // Texture arrays go to consecutive units from here
+#define bwxGL_MAX_TEXTURE_ARRAYS 4
+
+// Skinning matrices of all skeletons drawn in a frame (std430), see bwxGLBonePalette
+#define bwxGL_BONE_PALETTE_SSBO_BLOCK "BonePaletteBlock"
+#define bwxGL_BONE_PALETTE_SSBO_BINDING 5
+#define bwxGL_BONE_BASE_UNIFORM "boneBase"  // First palette matrix of the drawn skeleton (non-indirect draws)
+
 namespace bwx_sdk {
 
+// FNV-1a, constexpr so that literal uniform names are hashed at compile time
+constexpr uint64_t bwxGLHashName(std::string_view name) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+struct bwxGLUniformName {
+    constexpr bwxGLUniformName(const char* name) : str(name), hash(bwxGLHashName(name)) {}
+    bwxGLUniformName(const std::string& name) : str(name), hash(bwxGLHashName(name)) {}
+
+    std::string_view str;
+    uint64_t hash;
+};
+
 enum bwxGL_SHADER_TYPE : GLenum {
     SHADER_VERTEX,
     SHADER_TESS_CONTROL,
@@ -53,6 +103,12 @@ public:
     ~bwxGLShader();
 
     bool LoadShader(bwxGL_SHADER_TYPE type, const std::string& source, bool fromFile = false);
+
+    // Non-blocking compile: SubmitShader() only queues the work, CheckCompileStatus() waits for it.
+    // With GL_KHR_parallel_shader_compile IsCompileComplete() tells when the wait is free.
+    bool SubmitShader(bwxGL_SHADER_TYPE type, const std::string& source, bool fromFile = false);
+    bool IsCompileComplete() const;
+    bool CheckCompileStatus() const;
     void AttachToProgram(GLuint program);
 
     void Bind() const override;
@@ -123,6 +179,16 @@ public:
 
     bool Link();
 
+    // Non-blocking link, as for bwxGLShader: SubmitLink(), poll IsLinkComplete(), then FinishLink()
+    void SubmitLink();
+    bool IsLinkComplete() const;
+    bool FinishLink();
+
+    // Program binaries (GL_ARB_get_program_binary), see bwxGLProgramBinaryCache
+    void SetBinaryRetrievable(bool retrievable);  ///< Before Link()
+    bool GetBinary(GLenum& format, std::vector<unsigned char>& data) const;
+    bool LoadBinary(GLenum format, const void* data, GLsizei length);  ///< Instead of attaching and linking; false if the driver rejects it
+
     void Bind() const override;
     void Unbind() const override;
     void Delete() override;
@@ -131,6 +197,21 @@ public:
 
     GLuint GetProgram() const { return m_program; }
 
+    // Driver's program binary size (GL_PROGRAM_BINARY_LENGTH), counted in "gl.shaders.program_bytes";
+    // 0 without GL_ARB_get_program_binary. An estimate: drivers keep more than the binary per program
+    inline size_t GetMemoryBytes() const { return m_memoryBytes; }
+
+    bool IsInstanced() const { return m_instanced; }
+    bool HasFrameBlock() const { return m_frameBlock; }
+    bool IsIndirect() const { return m_indirect; }  ///< Reads the model matrix from the DrawDataBlock
+    bool UsesMaterialTable() const { return m_materialTable; }  ///< Reads material and textures from the MaterialBlock
+    bool HasMaterialParams() const { return m_materialParams; }  ///< Reads the material from the MaterialParams block
+
+    // The vertex shader computes gl_Position like bwxGLShaderGenerator (invariant, FrameBlock viewProjection),
+    // so the depth pre-pass may lay down its depth and the main pass can test it with GL_EQUAL
+    void SetDepthPrePass(bool enable) { m_depthPrePass = enable; }
+    bool UsesDepthPrePass() const { return m_depthPrePass && m_frameBlock; }
+
     void AddUniform(const std::string& name);
     void AddUniforms(const std::vector<std::string>& names);
     void AddAttribute(const std::string& name);
@@ -143,13 +224,13 @@ public:
     std::unordered_map<std::string, GLint> GetProgramAttributes();
 
     template <typename... Args>
-    void SetUniform(const std::string& name, Args... args) {
+    void SetUniform(bwxGLUniformName name, Args... args) {
         GLint location = GetUniformLocation(name);
         if (location != -1) {
             if (m_program != 0) {
                 glUniformHelper(location, args...);
             } else {
-                std::cerr << "Error: Cannot set uniform '" << name << "' because no shader program is in use."
+                std::cerr << "Error: Cannot set uniform '" << name.str << "' because no shader program is in use."
                           << std::endl;
             }
         }
@@ -185,12 +266,23 @@ public:
     GLuint CreateUBO(GLsizeiptr size, GLuint bindingPoint, const void* data = nullptr);
 
 private:
-    GLint GetUniformLocation(const std::string& name);
+    void OnLinked();
+    void SetMemoryBytes(size_t bytes);
+    void CacheUniforms();
+    GLint GetUniformLocation(const bwxGLUniformName& name);
     GLint GetAttributeLocation(const std::string& name);
     std::unordered_map<std::string, GLint> m_uniformCache;
+    std::unordered_map<uint64_t, GLint> m_uniformLocations;  ///< Hot path, keyed by bwxGLHashName()
     std::unordered_map<std::string, GLint> m_attributeCache;
 
     GLuint m_program;
+    bool m_instanced = false;
+    bool m_frameBlock = false;
+    bool m_indirect = false;
+    bool m_materialTable = false;
+    bool m_materialParams = false;
+    bool m_depthPrePass = false;
+    size_t m_memoryBytes = 0;
 };
 
 }  // namespace bwx_sdk
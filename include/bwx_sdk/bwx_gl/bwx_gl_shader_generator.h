@@ -20,32 +20,85 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+// Shader variant features; a combination of them is the key of one generated program (see GetProgram())
+#define bwxGL_SHADER_VARIANT_NORMALS 0x00000001
+#define bwxGL_SHADER_VARIANT_TEXCOORDS 0x00000002  // Also samples the diffuse texture
+#define bwxGL_SHADER_VARIANT_LIGHTING 0x00000004
+#define bwxGL_SHADER_VARIANT_SKINNING 0x00000008
+#define bwxGL_SHADER_VARIANT_INSTANCING 0x00000010
+#define bwxGL_SHADER_VARIANT_CLUSTERED_LIGHTS 0x00000020
+#define bwxGL_SHADER_VARIANT_INDIRECT 0x00000040
+#define bwxGL_SHADER_VARIANT_MATERIAL_TABLE 0x00000080
+#define bwxGL_SHADER_VARIANT_FRAGMENT 0x80000000  // Source cache only, marks the fragment stage
+
 namespace bwx_sdk {
 
+class bwxGLShaderProgram;
+
 class bwxGLShaderGenerator {
 public:
-    static std::string GetVertexShader(bool useNormals = true, bool useTexCoords = true, bool useLighting = true);
-    static std::string GetFragmentShader(bool useTextures = true, bool useLighting = true);
+    // One program per feature combination, generated and linked (through bwxGLProgramBinaryCache) on the first
+    // request and shared by every mesh and material asking for the same variant afterwards, so the render
+    // queue can sort by it. Kept by bwxGLShaderProgramManager under GetProgramName(); GL thread only.
+    // Returns nullptr when the variant does not compile, without trying again for the next mesh
+    static std::shared_ptr<bwxGLShaderProgram> GetProgram(uint32_t features);
+    static std::string GetProgramName(uint32_t features);
+
+    // Drops combinations that would generate the same program: lighting needs normals, clustered lights
+    // need lighting, the material table needs indirect drawing and instancing replaces indirect drawing
+    static uint32_t NormalizeFeatures(uint32_t features);
+    // Normals, texcoords and skinning of a bwxGL_MESH_* format; the rest comes from the caller
+    static uint32_t GetMeshFeatures(int meshFormat);
+
+    // useSkinning blends bwxGL_MAX_BONE_INFLUENCES palette matrices per vertex (bwxGL_MESH_SKINNED meshes)
+    static std::string GetVertexShader(bool useNormals = true, bool useTexCoords = true, bool useLighting = true,
+                                       bool useInstancing = false, bool useIndirect = false, bool useSkinning = false);
+    // useMaterialTable reads colours and the diffuse texture from the MaterialBlock by the index the indirect
+    // vertex shader passes on, so one batch can span materials
+    static std::string GetFragmentShader(bool useTextures = true, bool useLighting = true, bool useClusteredLights = false,
+                                         bool useMaterialTable = false);
+
+    // Position-only program for the depth pre-pass; same position math as GetVertexShader() with the same
+    // instancing, indirect and skinning flags, so GL_EQUAL holds in the main pass
+    static std::string GetDepthVertexShader(bool useInstancing = false, bool useIndirect = false, bool useSkinning = false);
+    static std::string GetDepthFragmentShader();
 
     static std::string GetDefaultSkyboxVertexShader();
     static std::string GetDefaultSkyboxFragmentShader();
     static std::string GetDefaultTTFVertexShader();
     static std::string GetDefaultTTFFragmentShader();
+    static std::string GetSDFTTFFragmentShader();
+
+    // Instanced solid rectangles: per instance vec4 (x, y, width, height) at 0 and vec4 colour at 1
+    static std::string GetRectVertexShader();
+    static std::string GetRectFragmentShader();
+
+    static std::string GetFrameBlock();
 
     // LIGHTS
     static std::string GetLightStructBlock();
     static std::string GetLightCalculationFunction();
+    static std::string GetClusteredLightBlock();
+
+    static std::string GetMaterialTableBlock(bool useBindless);
+    static std::string GetBonePaletteBlock(bool useIndirect);
 
 private:
-    static std::unordered_map<std::string, std::string> m_shaderCache;
-    static std::string GenerateVertexShader(bool useNormals, bool useTexCoords, bool useLighting);
-    static std::string GenerateFragmentShader(bool useTextures, bool useLighting);
+    static std::unordered_map<uint32_t, std::string> m_shaderCache;  ///< Sources by stage features
+    static std::unordered_set<uint32_t> m_failedPrograms;
+    static std::string GenerateVertexShader(bool useNormals, bool useTexCoords, bool useLighting, bool useInstancing,
+                                            bool useIndirect, bool useSkinning);
+    static std::string GenerateFragmentShader(bool useTextures, bool useLighting, bool useClusteredLights,
+                                              bool useMaterialTable);
 };
 
 }  // namespace bwx_sdk
@@ -28,6 +28,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "bwx_gl_resource_manager.h"
 #include "bwx_gl_shader.h"
@@ -46,6 +48,7 @@ public:
     static bwxGLShaderManager& GetInstance();
 
     void AddShader(const std::string& name, bwxGLShader& shader);
+    void AddShader(const std::string& name, std::shared_ptr<bwxGLShader> shader);
 
     GLuint LoadShader(const std::string& name, const std::string& source, bwxGL_SHADER_TYPE type,
                       bool fromFile = false);
@@ -78,7 +81,10 @@ public:
                                 const std::string& tessControl, const std::string& tessEval,
                                 const std::string& geometry);
 
-    GLuint GetShaderID(const std::string& name) { return m_resources[name]->GetID(); }
+    GLuint GetShaderID(const std::string& name) {
+        auto it = m_resources.find(name);
+        return it != m_resources.end() && it->second ? it->second->GetID() : bwxGL_SHADER_EMPTY;
+    }
     bwxGLShader GetShader(const std::string& name);
     std::shared_ptr<bwxGLShader> GetShaderPtr(const std::string& name);
 
@@ -93,7 +99,7 @@ public:
     static void SetOverwrite(bool overwrite) { m_overwrite = overwrite; }
 
 private:
-    bwxGLShaderManager() = default;
+    bwxGLShaderManager() { EnableMetrics("gl.shaders"); }
     ~bwxGLShaderManager();
 
     std::string m_currentShader;
@@ -150,7 +156,28 @@ public:
                                         const std::string& tessEval, const std::string& geometry,
                                         bool addToShaderManager = true);
 
-    GLuint GetShaderProgramID(const std::string& name) { return m_resources[name]->GetProgram(); }
+    /*
+            Asynchronous variant for large sets of programs: everything is submitted up front and
+            the driver compiles in the background (GL_KHR_parallel_shader_compile). Call
+            UpdatePendingPrograms() once per frame; until a program is ready, GetShaderProgramPtr()
+            returns the fallback program. Without the extension one program is built per update.
+            While bwxGLUploadWorker runs, programs are compiled and linked on its shared context
+            instead and stored by its Update().
+            Pending programs do not add their shaders to the shader manager.
+    */
+    bool CreateShaderProgramAsync(const std::string& programName,
+                                  const std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& shaders,
+                                  bool fromFile = false);
+    size_t UpdatePendingPrograms();  ///< Returns the number of programs still pending
+    bool IsShaderProgramPending(const std::string& name) const;
+    inline size_t GetPendingProgramCount() const { return m_pending.size(); }
+    inline void SetFallbackShaderProgram(const std::string& name) { m_fallbackProgram = name; }
+    static bool IsParallelCompileSupported();
+
+    GLuint GetShaderProgramID(const std::string& name) {
+        auto program = GetShaderProgramPtr(name);
+        return program ? program->GetProgram() : bwxGL_SHADER_PROGRAM_EMPTY;
+    }
     bwxGLShaderProgram GetShaderProgram(const std::string& name);
     std::shared_ptr<bwxGLShaderProgram> GetShaderProgramPtr(const std::string& name);
 
@@ -158,16 +185,47 @@ public:
     std::vector<std::string> GetShaderProgramNames() const;
 
     void UseShaderProgram(const std::string& programName);
+    void UseShaderProgram(bwxGLResourceHandle handle);  ///< Per-frame variant, see GetHandle()
     void UnuseShaderProgram();
     void ReleaseShaderProgram(const std::string& programName);
 
+    // Programs created from files are rebuilt when one of their files changes (see CheckHotReload()).
+    // A rebuild that fails to compile keeps the previous program.
+    void EnableHotReload(bool enabled);
+    bool ReloadShaderProgram(const std::string& programName);
+
     void Clear();
 
 private:
-    bwxGLShaderProgramManager() = default;
+    bwxGLShaderProgramManager() { EnableMetrics("gl.programs"); }
     ~bwxGLShaderProgramManager();
 
+    // Shared by the FromStrings/FromFiles overloads. Goes through bwxGLProgramBinaryCache; a program
+    // restored from a cached binary compiles no shaders, so none are added to the shader manager.
+    GLuint CreateShaderProgramFromSources(const std::string& programName,
+                                          const std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& shaders,
+                                          bool fromFile, bool addToShaderManager);
+
+    struct PendingProgram {
+        std::string name;
+        std::shared_ptr<bwxGLShaderProgram> program;
+        std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>> sources;
+        std::vector<std::shared_ptr<bwxGLShader>> shaders;
+        uint64_t key = 0;
+        bool submitted = false;
+        bool onWorker = false;  ///< Built by bwxGLUploadWorker; only name and program are set
+    };
+
+    bool LoadSources(std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& sources) const;
+    bool SubmitPendingProgram(PendingProgram& pending);
+    bool CheckPendingProgram(PendingProgram& pending);  ///< No manager state touched, safe on the upload worker
+    bool FinishPendingProgram(PendingProgram& pending);
+    void WatchProgram(const std::string& programName);
+
     std::string m_currentShaderProgram;
+    std::string m_fallbackProgram;
+    std::vector<PendingProgram> m_pending;
+    std::unordered_map<std::string, std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>> m_programFiles;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_skeleton.h
+// Purpose:     BWX_SDK Library; OpenGL Flat skeleton and GPU bone palette
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_SKELETON_H_
+#define _BWX_GL_SKELETON_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bwx_gl_ring_buffer.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_MAX_BONE_INFLUENCES 4  // Bone weights per vertex (bwxGLVertex::boneIndices/boneWeights)
+
+/**
+ * @brief Bone hierarchy stored as flat arrays addressed by bone index.
+ *
+ * Parents always precede their children, so Update() resolves every global transform in one
+ * forward pass over the arrays. Names are only looked up when setting things up; animation code
+ * writes local transforms by index (GetLocalTransforms()). The palette (global * offset) is what
+ * bwxGLBonePalette sends to the skinning shaders.
+ */
+class bwxGLSkeleton {
+public:
+    // parent must be an index already added, or -1 for a root; local is also kept as the bind pose
+    int32_t AddBone(const std::string& name, int32_t parent, const glm::mat4& offset,
+                    const glm::mat4& local = glm::mat4(1.0f));
+
+    int32_t FindBone(const std::string& name) const;  ///< -1 if there is no such bone
+
+    inline size_t GetBoneCount() const { return m_parents.size(); }
+    inline bool IsEmpty() const { return m_parents.empty(); }
+
+    inline const std::string& GetBoneName(size_t bone) const { return m_names[bone]; }
+    inline const std::vector<int32_t>& GetParents() const { return m_parents; }
+
+    inline void SetLocalTransform(size_t bone, const glm::mat4& transform) { m_local[bone] = transform; }
+    inline const glm::mat4& GetLocalTransform(size_t bone) const { return m_local[bone]; }
+    inline std::vector<glm::mat4>& GetLocalTransforms() { return m_local; }
+    inline const std::vector<glm::mat4>& GetLocalTransforms() const { return m_local; }
+
+    inline const glm::mat4& GetGlobalTransform(size_t bone) const { return m_global[bone]; }
+    inline const glm::mat4& GetOffset(size_t bone) const { return m_offsets[bone]; }
+    inline const glm::mat4& GetBindPose(size_t bone) const { return m_bindPose[bone]; }
+
+    void ResetToBindPose();
+
+    // Globals and palette from the current local transforms
+    void Update();
+
+    inline const std::vector<glm::mat4>& GetPalette() const { return m_palette; }
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<int32_t> m_parents;
+    std::vector<glm::mat4> m_offsets;   ///< Mesh space -> bone space (inverse bind matrix)
+    std::vector<glm::mat4> m_bindPose;
+    std::vector<glm::mat4> m_local;
+    std::vector<glm::mat4> m_global;
+    std::vector<glm::mat4> m_palette;
+    std::unordered_map<std::string, int32_t> m_lookup;
+};
+
+/**
+ * @brief Palettes of every skeleton drawn in a frame, packed into one SSBO.
+ *
+ * Add() copies a skeleton's palette once per frame and returns the index of its first matrix, which
+ * the skinning shader adds to the vertex bone indices (uniform boneBase, or DrawData::info.z on the
+ * indirect path). Upload() writes the frame's matrices at bwxGL_BONE_PALETTE_SSBO_BINDING.
+ */
+class bwxGLBonePalette {
+public:
+    void Begin();
+
+    GLint Add(const bwxGLSkeleton& skeleton);
+
+    bool Upload();
+
+    inline size_t GetMatrixCount() const { return m_matrices.size(); }
+
+    static bool IsSupported();
+
+private:
+    std::vector<glm::mat4> m_matrices;
+    std::unordered_map<const bwxGLSkeleton*, GLint> m_bases;
+    std::unique_ptr<bwxGLRingBuffer> m_ring;
+};
+
+}  // namespace bwx_sdk
+
+#endif
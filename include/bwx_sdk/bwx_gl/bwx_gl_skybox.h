@@ -23,6 +23,7 @@
 #include <GL/glew.h>
 
 #include <glm/glm.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,11 @@
 
 namespace bwx_sdk {
 
+enum class bwxGL_SKYBOX_GEOMETRY {
+    CUBE,                 ///< 36 vertices around the camera
+    FULLSCREEN_TRIANGLE   ///< One triangle, view rays reconstructed from the inverse view-projection
+};
+
 class bwxGLSkyBox {
 public:
     bwxGLSkyBox();
@@ -39,19 +45,32 @@ public:
     virtual ~bwxGLSkyBox();
 
     void Init(GLfloat size);
+    // Plain images, or .dds/.ktx2 faces uploaded with their stored mip chains (bwxGLCompressedImage)
     void LoadCube(std::vector<std::string> faces);
 
+    inline void SetGeometry(bwxGL_SKYBOX_GEOMETRY geometry) { m_geometry = geometry; }
+    inline bwxGL_SKYBOX_GEOMETRY GetGeometry() const { return m_geometry; }
+
     void Render(glm::mat4* PV);
+    // After the opaque pass: drawn at depth = far with GL_LEQUAL, so early-z rejects every covered pixel
+    void Render(const glm::mat4& view, const glm::mat4& projection);
 
     static const char* DefaultSkyBoxVertexShader();
     static const char* DefaultSkyBoxFragmentShader();
+    static const char* FullScreenSkyBoxVertexShader();
+    static const char* FullScreenSkyBoxFragmentShader();
 
     void UseDefaultSkyBoxShader();
 
 private:
+    bool LoadCompressedFace(GLenum target, const std::string& file, GLint& levels);
+    std::unique_ptr<bwxGLShaderProgram> CreateProgram(const char* vertex, const char* fragment);
+
     GLuint VAO, VBO;
-    GLuint textureID;
-    // bwxGLShader* shader;
+    GLuint textureID = 0;
+    bwxGL_SKYBOX_GEOMETRY m_geometry = bwxGL_SKYBOX_GEOMETRY::CUBE;
+    std::unique_ptr<bwxGLShaderProgram> m_program;
+    std::unique_ptr<bwxGLShaderProgram> m_triangleProgram;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_text_view_renderer.h
+// Purpose:     BWX_SDK Library; OpenGL Full View renderer for bwxTextEditor
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_TEXT_VIEW_RENDERER_H_
+#define _BWX_GL_TEXT_VIEW_RENDERER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+#include <wx/glcanvas.h>
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_buffer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_ttf.h>
+#include <bwx_sdk/bwx_gui/bwx_text_renderer.h>
+
+#define bwxGL_TEXT_VIEW_ATLAS_PIXELS 32  // Pixel height distance-field atlases are rasterized at; every size is scaled from it
+#define bwxGL_TEXT_VIEW_RECT_FLOATS 8    // Rect (x, y, width, height) + colour per instance
+
+namespace bwx_sdk {
+
+/**
+ * @brief Full View of bwxTextEditor drawn with OpenGL instead of wxDC.
+ *
+ * Layout, hit testing and caret/selection geometry are FullViewRenderer's; only drawing changes.
+ * Glyphs come from distance-field bwxGLTTF atlases (one per font file, every size, filled on first
+ * use) and go out in one bwxGLText batch per font; highlights, selection, underlines and the caret
+ * are instanced rects. Glyphs sit on the layout's character edges, so what is hit-tested is what
+ * is drawn even where FreeType and the platform disagree on advances.
+ *
+ * Attach() puts a wxGLCanvas over the editor; mouse events go on to the editor, focus is handed to it.
+ * Faces are TTF/OTF files - map the document's font names with SetFontFile(). Before Attach(), or
+ * when OpenGL 4.5 is not available, rendering falls back to wxDC.
+ *
+ * @code
+ * editor->SetRendererFactory([](bwxTextEditor::ViewMode mode) -> std::unique_ptr<ITextRenderer> {
+ *     if (mode != bwxTextEditor::VIEW_FULL) return nullptr;
+ *     auto renderer = std::make_unique<bwxGLTextViewRenderer>();
+ *     renderer->SetDefaultFontFile("fonts/DejaVuSans.ttf");
+ *     return renderer;
+ * });
+ * @endcode
+ */
+class bwxGLTextViewRenderer : public gui::FullViewRenderer {
+public:
+    bwxGLTextViewRenderer() = default;
+    ~bwxGLTextViewRenderer();
+
+    void Attach(wxWindow* host) override;
+    void Detach() override;
+    wxWindow* GetSurface() const override { return m_canvas; }
+
+    void RenderArea(wxDC& dc, const wxRect& clientRect, int scrollY, const wxRect& updateRect) override;
+    wxRect UpdateLayout(int scrollY, const wxRect& clientRect) override;
+    void OnResize(int width, int height) override;
+    void SetDocument(gui::bwxTextDocument* doc) override;
+
+    // Font file for a face name of the document (case-insensitive); bold/italic fall back to the regular file
+    void SetFontFile(const wxString& faceName, const std::string& path, bool bold = false, bool italic = false);
+    // For every face without a file of its own
+    void SetDefaultFontFile(const std::string& path);
+
+private:
+    struct Font {
+        std::unique_ptr<bwxGLTTF> ttf;
+        std::unique_ptr<bwxGLText> text;
+    };
+
+    bool MakeCurrent();
+    void Draw();
+    void ReleaseGL();
+    void ResetStyleFonts();
+
+    Font* GetStyleFont(int styleId);
+    Font* LoadFont(const std::string& path);
+
+    void QueueLine(const ParagraphLayout& layout, const LayoutLine& line, int paragraphStart, int yPos);
+    void QueueRect(std::vector<GLfloat>& rects, const wxRect& rect, const glm::vec4& color) const;  ///< Client coords, y down
+    void DrawRects(std::vector<GLfloat>& rects, const glm::mat4& projection);
+
+    void OnCanvasPaint(wxPaintEvent& event);
+    void OnCanvasMouse(wxMouseEvent& event);
+    void OnCanvasFocus(wxFocusEvent& event);
+
+    wxWindow* m_host = nullptr;
+    wxGLCanvas* m_canvas = nullptr;  ///< Child of m_host, destroyed by Detach()
+    std::unique_ptr<wxGLContext> m_context;
+    bool m_glReady = false;          ///< GLEW initialised for m_context
+
+    int m_scrollY = 0;               ///< Last scroll position the editor laid out for
+    int m_surfaceHeight = 0;         ///< Canvas height while drawing (GL y is up)
+
+    std::unordered_map<std::string, std::string> m_fontFiles;  ///< "face|bold|italic" -> file
+    std::string m_defaultFontFile;
+    std::unordered_map<std::string, std::unique_ptr<Font>> m_fonts;  ///< By file; nullptr if it failed to load
+    std::vector<Font*> m_styleFonts;      ///< By style ID, resolved on first use
+    std::vector<bool> m_styleResolved;
+
+    std::shared_ptr<bwxGLShaderProgram> m_rectProgram;
+    std::unique_ptr<bwxGLBuffer> m_rectBuffer;  ///< Per-instance rects, refilled every batch
+    std::vector<GLfloat> m_underlay;            ///< Highlights and selection, below the text
+    std::vector<GLfloat> m_overlay;             ///< Underlines and caret, above the text
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -24,6 +24,7 @@
 #include <GL/glew.h>
 #endif
 
+#include "bwx_gl_compressed_image.h"
 #include "bwx_gl_resource_manager.h"
 
 namespace bwx_sdk {
@@ -58,6 +59,17 @@ enum bwxGL_TEXTURE_TYPE {
     TEXTUE_UNKNOWN = -1
 };
 
+#define bwxGL_TEXTURE_PLACEHOLDER_COLOR 0xFF808080  // ABGR of the 1x1 texel shown until an async upload is done
+
+struct bwxGLTextureParams {
+    GLint wrapS = GL_REPEAT;
+    GLint wrapT = GL_REPEAT;
+    GLint filterMin = GL_LINEAR;
+    GLint filterMag = GL_LINEAR;
+    bool mipmaps = true;
+    bool srgb = false;
+};
+
 struct bwxGLTexture2DData {
     GLuint textureID = 0;
     wxString name = wxEmptyString;
@@ -76,6 +88,12 @@ public:
     void Create(const wxString& file, GLint wrapS, GLint wrapT, GLint filterMin, GLint filterMag, bool mipmaps = true,
                 bool srgb = false);
 
+    // Asynchronous loading (see bwxGLTextureLoader): the texture name is valid at once and shows a placeholder,
+    // Upload() later replaces its contents while the name stays the same (bwxGLUploadWorker swaps in a new name instead)
+    void CreatePlaceholder(const wxString& file, const bwxGLTextureParams& params);
+    void Upload(int width, int height, bool alpha, const void* pixels);  ///< pixels may be an offset into a bound PBO
+    bool Upload(const bwxGLCompressedImage& image);  ///< Stored mip chain; false when the driver lacks the format
+
     void Bind(int index = 0);
 
     void Bind() const override;
@@ -90,9 +108,21 @@ public:
     inline const wxString& GetPath() const { return m_data.path; }
     inline const wxString& GetName() const { return m_data.name; }
     inline bwxGLTexture2DData GetData() const { return m_data; }
+    inline const bwxGLTextureParams& GetParams() const { return m_params; }
+    inline bool IsPending() const { return m_pending; }
+    inline size_t GetMemoryBytes() const { return m_memoryBytes; }  ///< Estimated VRAM, counted in "gl.textures.vram_bytes"
 
 private:
+    friend class bwxGLTextureLoader;
+    friend class bwxGLTextureStreamer;
+
+    void ApplyParameters() const;
+    void SetMemoryBytes(size_t bytes);
+
     bwxGLTexture2DData m_data;
+    bwxGLTextureParams m_params;
+    bool m_pending = false;
+    size_t m_memoryBytes = 0;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_array.h
+// Purpose:     BWX_SDK Library; OpenGL Texture array of same-size textures
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_TEXTURE_ARRAY_H_
+#define _BWX_GL_TEXTURE_ARRAY_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include "bwx_gl_texture.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_TEXTURE_ARRAY_LAYERS 16  // Initial layer capacity, doubled when full
+
+/**
+ * @brief GL_TEXTURE_2D_ARRAY for textures that share size, internal format and mip count.
+ *
+ * Layers are copied from existing 2D textures on the GPU (glCopyImageSubData), so the array can be
+ * built after loading without decoding anything again. One bind serves every material in the array.
+ */
+class bwxGLTextureArray {
+public:
+    bwxGLTextureArray(GLsizei width, GLsizei height, GLenum internalFormat, GLsizei levels,
+                      GLsizei capacity = bwxGL_TEXTURE_ARRAY_LAYERS);
+    ~bwxGLTextureArray();
+
+    bwxGLTextureArray(const bwxGLTextureArray&) = delete;
+    bwxGLTextureArray& operator=(const bwxGLTextureArray&) = delete;
+
+    static bool IsSupported();  ///< GL 4.3, or ARB_copy_image + ARB_texture_storage
+
+    // Size, format and mip count of a 2D texture as the array needs them; false for an empty texture
+    static bool Describe(const bwxGLTexture2D& texture, GLsizei& width, GLsizei& height, GLenum& internalFormat,
+                         GLsizei& levels);
+
+    bool Matches(GLsizei width, GLsizei height, GLenum internalFormat, GLsizei levels) const;
+
+    GLint AddLayer(const bwxGLTexture2D& texture, const bwxGLTextureParams& params);  ///< New layer or -1
+
+    void Bind(int unit) const;
+
+    inline GLuint GetID() const { return m_texture; }
+    inline GLsizei GetLayerCount() const { return m_layers; }
+
+private:
+    GLuint Allocate(GLsizei capacity, const bwxGLTextureParams& params) const;
+
+    GLuint m_texture = 0;
+    GLsizei m_width;
+    GLsizei m_height;
+    GLenum m_format;
+    GLsizei m_levels;
+    GLsizei m_capacity;
+    GLsizei m_layers = 0;
+};
+
+}  // namespace bwx_sdk
+
+#endif
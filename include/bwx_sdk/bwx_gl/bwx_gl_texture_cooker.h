@@ -0,0 +1,44 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_cooker.h
+// Purpose:     BWX_SDK Library; OpenGL Offline texture compression to DDS
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_TEXTURE_COOKER_H_
+#define _BWX_GL_TEXTURE_COOKER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+#include <wx/string.h>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Turns the images bwxGLImgLoader reads into BC1 (opaque) or BC3 (alpha) DDS files with a full
+ * mip chain.
+ *
+ * Needs no GL context, so it can run from a build step or a tool. bwxGLTextureManager picks the cooked
+ * file over its source whenever IsUpToDate() says so.
+ */
+class bwxGLTextureCooker {
+public:
+    // target defaults to GetCookedPath(source)
+    static bool Cook(const wxString& source, const wxString& target = wxEmptyString, bool mipmaps = true);
+
+    static wxString GetCookedPath(const wxString& source);  ///< Source with the .dds extension
+    static bool IsUpToDate(const wxString& source);         ///< Cooked file exists and is not older than the source
+
+    // One 4x4 block of RGBA8 texels, row by row
+    static void EncodeBC1Block(const GLubyte rgba[64], unsigned char out[8]);
+    static void EncodeBC3Block(const GLubyte rgba[64], unsigned char out[16]);
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_loader.h
+// Purpose:     BWX_SDK Library; OpenGL Asynchronous texture loading
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_TEXTURE_LOADER_H_
+#define _BWX_GL_TEXTURE_LOADER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
+
+#include "bwx_gl_buffer.h"
+#include "bwx_gl_image_loader.h"
+#include "bwx_gl_texture.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_TEXTURE_UPLOAD_BUDGET (8 * 1024 * 1024)  // Bytes of pixel buffers mapped per Update()
+
+/**
+ * @brief Decodes images on the job system and uploads them through pixel buffer objects.
+ *
+ * The texture gets a placeholder immediately (bwxGLTexture2D::CreatePlaceholder). Decoding runs on
+ * worker threads. Update() runs once per frame on the GL thread and maps PBOs for at most the byte
+ * budget; a worker then writes the pixels, rotated and in GL row order, straight into the mapping
+ * (bwxGLImgLoader::CopyTo), so no intermediate copy of the image exists. When the copy is done,
+ * glTexImage2D takes the data from the PBO without stalling the CPU.
+ * KTX2/DDS files, and cooked versions of sources (bwxGLTextureCooker), are parsed on the worker and
+ * uploaded with their stored mip chain.
+ * While bwxGLUploadWorker runs, decoded images are uploaded on its shared context into a new texture
+ * instead, with no byte budget; its Update() swaps that texture's name in for the placeholder's, so the
+ * ID changes once - look it up per use (bwxGLTextureManager::GetTextureID) rather than keeping it.
+ */
+class bwxGLTextureLoader {
+public:
+    static bwxGLTextureLoader& GetInstance();
+
+    ~bwxGLTextureLoader();
+
+    bwxGLTextureLoader(const bwxGLTextureLoader&) = delete;
+    bwxGLTextureLoader& operator=(const bwxGLTextureLoader&) = delete;
+
+    // GL thread; the texture must already hold its placeholder
+    void Enqueue(const std::shared_ptr<bwxGLTexture2D>& texture,
+                 bwxGL_IMG_ROTATE_MODE rotate = bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0);
+
+    // GL thread, once per frame; returns the number of textures completed
+    size_t Update(size_t byteBudget = bwxGL_TEXTURE_UPLOAD_BUDGET);
+
+    // Blocks (running Update) until every queued texture is uploaded or failed
+    void Flush();
+
+    size_t GetPendingCount() const;
+
+private:
+    bwxGLTextureLoader();
+
+    struct Decoded {
+        std::weak_ptr<bwxGLTexture2D> texture;
+        wxString path;
+        bwxGL_IMG_ROTATE_MODE rotate = bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0;
+        std::shared_ptr<bwxGLImgLoader> source;            ///< Opened, not yet copied (bwxGLImgLoader::Open)
+        std::shared_ptr<bwxGLCompressedImage> compressed;  ///< KTX2/DDS (or cooked) source, uploaded as is
+        int width = 0;
+        int height = 0;
+        bool alpha = false;
+        bool ok = false;
+    };
+
+    struct CopyJob {
+        bwxJobCounter counter;
+        bool ok = false;
+    };
+    struct Upload {
+        Decoded image;
+        bwxGLBuffer* pbo = nullptr;
+        unsigned char* mapped = nullptr;
+        std::shared_ptr<CopyJob> copy;  ///< Worker writing into the mapping
+    };
+
+    void UploadOnWorker(Decoded image, const bwxGLTextureParams& params);
+    bool Step(Upload& upload, size_t& budget);
+    void Finish(Upload& upload);
+    void Discard(Upload& upload);
+
+    mutable std::mutex m_mutex;
+    std::vector<Decoded> m_decoded;  ///< Filled by workers, guarded by m_mutex
+    size_t m_inFlight = 0;           ///< Scheduled, not decoded yet; guarded by m_mutex
+    size_t m_onWorker = 0;           ///< Submitted to bwxGLUploadWorker, not swapped in yet; guarded by m_mutex
+    bwxJobCounter m_jobs;
+
+    std::deque<Upload> m_uploads;    ///< GL thread only
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -16,10 +16,13 @@
 #ifndef _BWX_GL_TEXTURE_MANAGER_H_
 #define _BWX_GL_TEXTURE_MANAGER_H_
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #if defined(__APPLE__)
 #error OpenGL functionality is not available for macOS.
@@ -29,29 +32,74 @@
 
 #include "bwx_gl_image_loader.h"
 #include "bwx_gl_resource_manager.h"
+#include "bwx_gl_shader.h"
 #include "bwx_gl_texture.h"
+#include "bwx_gl_texture_array.h"
+#include "bwx_gl_texture_loader.h"
 
 namespace bwx_sdk {
 
+// Where a texture can be sampled without binding it by itself
+struct bwxGLTextureLocation {
+    GLint array = -1;     ///< Index of its bwxGLTextureArray, -1 when it is not in one
+    GLint layer = -1;
+    GLuint64 handle = 0;  ///< Resident bindless handle, 0 without GL_ARB_bindless_texture
+};
+
 class bwxGLTextureManager : public bwxGLResourceManager<bwxGLTexture2D> {
 public:
     static bwxGLTextureManager& GetInstance();
 
-    GLuint LoadTexture(const std::string& filePath, bool generateMipmaps = true);
+    // async: returns at once with a placeholder; the ID stays the same once the image is uploaded
+    // (with bwxGLUploadWorker running it changes once, when the uploaded texture is swapped in).
+    // In concurrent mode a worker thread gets 0 and the texture is loaded asynchronously by ProcessUploads()
+    GLuint LoadTexture(const std::string& filePath, bool generateMipmaps = true, bool async = false);
+    size_t ProcessUploads(size_t byteBudget = bwxGL_TEXTURE_UPLOAD_BUDGET);  ///< Once per frame, GL thread
+
+    // Key to load and look up a file by: its canonical path, or the key of a file with the same content seen
+    // before (copies, other relative paths, links), so one image is decoded and uploaded once. Each new path
+    // is read once to hash it; GL thread
+    std::string ResolveTexturePath(const std::string& filePath);
 
     void BindTexture(const std::string& filePath, int textureUnit = 0);
     void UnbindTexture(int textureUnit = 0);
 
     void DeleteTexture(const std::string& filePath);
 
+    // Watches every loaded texture file; a changed file is decoded again through the async loader
+    void EnableHotReload(bool enabled);
+    bool ReloadTexture(const std::string& filePath);
+
+    // Any thread in concurrent mode
     std::shared_ptr<bwxGLTexture2D> GetTexturePtr(const std::string& filePath);
     GLuint GetTextureID(const std::string& filePath);
 
+    // Atlas mode: copies loaded textures of equal size/format/mips into GL_TEXTURE_2D_ARRAY layers.
+    // Groups smaller than minLayers stay separate. Returns the number of textures placed in arrays
+    size_t BuildTextureArrays(size_t minLayers = 2);
+    void BindTextureArrays(int firstUnit = bwxGL_TEXTURE_ARRAY_FIRST_UNIT) const;
+    inline size_t GetTextureArrayCount() const { return m_arrays.size(); }
+
+    static bool IsBindlessSupported();
+    GLuint64 GetBindlessHandle(const std::string& filePath);  ///< Made resident on first use; 0 if unsupported
+
+    const bwxGLTextureLocation* GetLocation(const std::string& filePath) const;
+
     void Clear();
 
 private:
-    bwxGLTextureManager() = default;
+    bwxGLTextureManager() { EnableMetrics("gl.textures"); }
     ~bwxGLTextureManager();
+
+    void ReleaseLocation(const std::string& filePath);
+    void WatchTexture(const std::string& filePath);
+    void ForgetContent(const std::string& filePath);  ///< Drops the resolved paths and hash leading to it
+
+    std::vector<std::unique_ptr<bwxGLTextureArray>> m_arrays;
+    std::unordered_map<std::string, bwxGLTextureLocation> m_locations;
+    std::unordered_set<std::string> m_watched;
+    std::unordered_map<std::string, std::string> m_resolvedPaths;  ///< Requested path -> key
+    std::unordered_map<uint64_t, std::string> m_contentKeys;       ///< Content hash -> key
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_streamer.h
+// Purpose:     BWX_SDK Library; OpenGL Texture mip streaming within a VRAM budget
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_TEXTURE_STREAMER_H_
+#define _BWX_GL_TEXTURE_STREAMER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bwx_gl_texture.h"
+
+namespace bwx_sdk {
+
+#define bwxGL_TEXTURE_STREAMING_BUDGET (256 * 1024 * 1024)  // Default VRAM budget for streamed textures, bytes
+#define bwxGL_TEXTURE_STREAMING_RESTORES 2                  // Full reloads started per Update()
+
+/**
+ * @brief Keeps textures of bwxGLTextureManager within a VRAM budget by dropping their largest mips.
+ *
+ * Every frame the renderer reports the on-screen size of each textured object (Request()), which
+ * gives the finest mip the texture needs. Update() then evicts mips, least recently used textures
+ * first, until the resident total fits the budget: levels below the new GL_TEXTURE_BASE_LEVEL are
+ * shrunk to a single texel, so the texture name, and everything that refers to it, stays valid.
+ * When an evicted texture needs its detail back and the budget allows, it is reloaded through
+ * bwxGLTextureLoader and keeps drawing its remaining mips until the upload is done.
+ *
+ * Textures with a bindless handle are left alone, their state is frozen by the handle.
+ */
+class bwxGLTextureStreamer {
+public:
+    static bwxGLTextureStreamer& GetInstance();
+
+    bwxGLTextureStreamer(const bwxGLTextureStreamer&) = delete;
+    bwxGLTextureStreamer& operator=(const bwxGLTextureStreamer&) = delete;
+
+    // screenPixels: size of the surface the texture covers, in pixels (about one texel per pixel is kept)
+    void Request(const std::string& filePath, float screenPixels);
+
+    // GL thread, once per frame after all Request() calls; returns the number of mips evicted
+    size_t Update();
+
+    inline void SetBudget(size_t bytes) { m_budget = bytes; }
+    inline size_t GetBudget() const { return m_budget; }
+    inline size_t GetResidentBytes() const { return m_residentBytes; }
+    inline size_t GetTrackedCount() const { return m_textures.size(); }
+
+    GLint GetResidentMip(const std::string& filePath) const;  ///< Finest resident level, -1 if not tracked
+
+    void Clear();
+
+private:
+    bwxGLTextureStreamer() = default;
+    ~bwxGLTextureStreamer() = default;
+
+    struct Entry {
+        std::weak_ptr<bwxGLTexture2D> texture;
+        GLuint id = 0;                  ///< Detects a texture recreated under the same path
+        std::vector<size_t> levelBytes; ///< Full chain, measured on registration
+        GLint size = 0;                 ///< Larger side of level 0
+        GLint residentBase = 0;         ///< Finest resident level (GL_TEXTURE_BASE_LEVEL)
+        GLint requiredMip = 0;          ///< Finest level asked for in the last requesting frame
+        uint64_t lastUsedFrame = 0;
+        bool restoring = false;         ///< Reload through bwxGLTextureLoader in flight
+    };
+
+    bool Register(Entry& entry, const std::string& filePath, const std::shared_ptr<bwxGLTexture2D>& texture) const;
+    size_t GetResidentBytes(const Entry& entry) const;
+    void Evict(Entry& entry, GLint base);
+    bool Restore(Entry& entry, const std::shared_ptr<bwxGLTexture2D>& texture);
+
+    std::unordered_map<std::string, Entry> m_textures;
+    size_t m_budget = bwxGL_TEXTURE_STREAMING_BUDGET;
+    size_t m_residentBytes = 0;
+    uint64_t m_frame = 1;
+    bool m_overBudgetLogged = false;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_thumbnail_renderer.h
+// Purpose:     BWX_SDK Library; OpenGL Batch offscreen thumbnails of models and materials
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_THUMBNAIL_RENDERER_H_
+#define _BWX_GL_THUMBNAIL_RENDERER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bwx_gl_bounds.h"
+
+#define bwxGL_THUMBNAIL_SIZE 128             // Edge of one thumbnail in pixels, RGBA8
+#define bwxGL_THUMBNAIL_ATLAS_TILES 4        // Thumbnails per atlas row and column
+#define bwxGL_THUMBNAIL_ATLASES 2            // Atlases in the pool; a batch waits while all are being read back
+#define bwxGL_THUMBNAIL_TIME_SLICE_MS 2.0    // Default CPU time Render() may spend per frame
+#define bwxGL_THUMBNAIL_CACHE_VERSION 1      // Bump whenever the framing, the lights or the file layout change
+#define bwxGL_THUMBNAIL_CACHE_EXT ".bwxthumb"
+
+namespace bwx_sdk {
+
+    class bwxGLBuffer; // Forward declaration
+    class bwxGLMaterial; // Forward declaration
+    class bwxGLMesh; // Forward declaration
+    class bwxGLModel; // Forward declaration
+
+    /**
+     * @brief Preview images of models and materials for asset browsers, drawn a few per frame.
+     *
+     * Requests are queued and Render() draws as many as fit in its time slice into the tiles of a
+     * pooled atlas framebuffer, then copies the atlas into a pixel buffer; Poll() hands the tiles out
+     * once the fence has signalled, so neither side waits for the GPU. Every item is scaled into the
+     * unit sphere from its bounds, which lets one camera and one set of lights serve all of them.
+     * Materials are shown on a sphere, models in their bind pose with their mesh formats' generated
+     * programs. With a cache directory set, finished thumbnails are stored under their key and later
+     * requests for the same key are answered from disk without drawing anything.
+     */
+    class bwxGLThumbnailRenderer {
+    public:
+        // bwxGL_THUMBNAIL_SIZE^2 RGBA8 pixels, top row first; empty when the item could not be drawn
+        using Callback = std::function<void(const std::vector<unsigned char>& pixels)>;
+
+        bwxGLThumbnailRenderer() = default;
+        ~bwxGLThumbnailRenderer();
+
+        static bool IsSupported();  ///< GL 3.3 (uniform blocks and fence sync)
+
+        // Empty to disable the disk cache; the directory is created on the first write
+        void SetCacheDirectory(const std::string& directory) { m_cacheDirectory = directory; }
+        inline const std::string& GetCacheDirectory() const { return m_cacheDirectory; }
+
+        // key identifies the asset's content (e.g. bwxGLSceneCache source hash); 0 never touches the cache.
+        // A cached thumbnail is delivered before the call returns
+        void RequestModel(std::shared_ptr<bwxGLModel> model, uint64_t key, Callback callback);
+        // Keyed by bwxGLMaterial::GetContentHash()
+        void RequestMaterial(std::shared_ptr<bwxGLMaterial> material, Callback callback);
+
+        inline size_t GetQueuedCount() const { return m_queue.size(); }
+        inline bool IsPending() const { return !m_queue.empty() || m_inFlight > 0; }
+
+        // Once per frame on the GL thread; at least one item is drawn whatever the budget.
+        // Changes the bound program and VAO, restores the framebuffer, the viewport, depth state
+        // and the frame and light uniform blocks
+        void Render(double budgetMs = bwxGL_THUMBNAIL_TIME_SLICE_MS);
+
+        // Delivers finished thumbnails; once per frame
+        void Poll();
+
+        void Release();
+
+    private:
+        struct Request {
+            std::shared_ptr<bwxGLModel> model;
+            std::shared_ptr<bwxGLMaterial> material;
+            uint64_t key = 0;
+            Callback callback;
+        };
+
+        struct Tile {
+            uint64_t key = 0;
+            bool drawn = false;
+            Callback callback;
+        };
+
+        struct Atlas {
+            GLuint framebuffer = 0;
+            GLuint colorTarget = 0;
+            GLuint depthTarget = 0;
+            GLuint pbo = 0;
+            GLsync fence = nullptr;
+            std::vector<Tile> tiles;  ///< Row-major from the bottom left, as drawn in that batch
+        };
+
+        bool CreateResources();
+        void CreateSphere();
+
+        bool DrawModel(bwxGLModel& model);
+        bool DrawMaterial(const bwxGLMaterial& material);
+        static glm::mat4 GetFramingMatrix(const bwxGLBoundingBox& bounds);  ///< Bounds into the unit sphere at the origin
+
+        void Deliver(const Atlas& atlas, const unsigned char* data);
+        std::string GetCachePath(uint64_t key) const;
+        bool LoadCached(uint64_t key, std::vector<unsigned char>& pixels) const;
+        void StoreCached(uint64_t key, const std::vector<unsigned char>& pixels) const;
+
+        std::deque<Request> m_queue;
+        std::string m_cacheDirectory;
+
+        Atlas m_atlases[bwxGL_THUMBNAIL_ATLASES];
+        size_t m_inFlight = 0;
+
+        std::unique_ptr<bwxGLBuffer> m_frameUBO;  ///< Fixed camera, written once
+        std::unique_ptr<bwxGLBuffer> m_lightUBO;  ///< Fixed key, fill and rim lights, written once
+        std::unique_ptr<bwxGLMesh> m_sphere;      ///< Material preview surface
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_THUMBNAIL_RENDERER_H_
@@ -31,18 +31,18 @@ namespace bwx_sdk {
 		{
 		}
 
-		inline void SetPosition(const glm::vec3& pos) { m_position = pos; m_transformDirty = true; }
+		inline void SetPosition(const glm::vec3& pos) { m_position = pos; MarkDirty(); }
 		inline void SetPosition(float x, float y, float z) { SetPosition(glm::vec3(x, y, z)); }
 		
-		inline void SetRotation(const glm::quat& rot) { m_rotation = rot; m_transformDirty = true; }
-		inline void SetRotation(const glm::vec3& angles) { m_rotation = glm::quat(angles); m_transformDirty = true; }
+		inline void SetRotation(const glm::quat& rot) { m_rotation = rot; MarkDirty(); }
+		inline void SetRotation(const glm::vec3& angles) { m_rotation = glm::quat(angles); MarkDirty(); }
 		inline void SetRotation(float pitch, float yaw, float roll) { SetRotation(glm::vec3(pitch, yaw, roll)); }
-		inline void SetYaw(float angle) { m_rotation = glm::rotate(m_rotation, angle, glm::vec3(0.0f, 1.0f, 0.0f)); m_transformDirty = true; }
-		inline void SetPitch(float angle) { m_rotation = glm::rotate(m_rotation, angle, glm::vec3(1.0f, 0.0f, 0.0f)); m_transformDirty = true; }
-		inline void SetRoll(float angle) { m_rotation = glm::rotate(m_rotation, angle, glm::vec3(0.0f, 0.0f, 1.0f)); m_transformDirty = true; }
+		inline void SetYaw(float angle) { m_rotation = glm::rotate(m_rotation, angle, glm::vec3(0.0f, 1.0f, 0.0f)); MarkDirty(); }
+		inline void SetPitch(float angle) { m_rotation = glm::rotate(m_rotation, angle, glm::vec3(1.0f, 0.0f, 0.0f)); MarkDirty(); }
+		inline void SetRoll(float angle) { m_rotation = glm::rotate(m_rotation, angle, glm::vec3(0.0f, 0.0f, 1.0f)); MarkDirty(); }
 		
 		inline void SetScale(float scale) { SetScale(glm::vec3(scale)); }
-		inline void SetScale(const glm::vec3& scale) { m_scale = scale; m_transformDirty = true; }
+		inline void SetScale(const glm::vec3& scale) { m_scale = scale; MarkDirty(); }
 
 		inline glm::vec3 GetPosition() const { return m_position; }
 
@@ -56,7 +56,17 @@ namespace bwx_sdk {
 
 		glm::mat4 GetTransformMatrix();
 
+		// Incremented on every change; lets dependants cache derived data
+		inline unsigned int GetVersion() const { return m_version; }
+
+		// Parent * local, kept by bwxGLTransformSystem; the local matrix for nodes it does not manage
+		glm::mat4 GetWorldMatrix();
+		inline unsigned int GetWorldVersion() const { return m_worldManaged ? m_worldVersion : m_version; }
+
 	private:
+		friend class bwxGLTransformSystem;
+
+		inline void MarkDirty() { m_transformDirty = true; ++m_version; }
 		void RecalculateMatrix();
 
 		glm::vec3 m_position;
@@ -65,6 +75,11 @@ namespace bwx_sdk {
 		glm::mat4 m_transform;
 
 		bool m_transformDirty;
+		unsigned int m_version = 0;
+
+		glm::mat4 m_worldMatrix = glm::mat4(1.0f);
+		unsigned int m_worldVersion = 0;
+		bool m_worldManaged = false;
 	};
 
 } // namespace bwx_sdk
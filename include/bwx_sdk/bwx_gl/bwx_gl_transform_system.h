@@ -0,0 +1,70 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_transform_system.h
+// Purpose:     BWX_SDK Library; World transform hierarchy system (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_TRANSFORM_SYSTEM_H_
+#define _BWX_GL_TRANSFORM_SYSTEM_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "bwx_gl_node.h"
+#include "bwx_gl_transform_component.h"
+
+namespace bwx_sdk {
+
+    /**
+     * @brief World matrices of a node hierarchy, stored as flat arrays ordered by depth.
+     *
+     * Parents always come before their children, so one linear pass is enough: an entry is
+     * recomputed only when its local transform or anything above it changed. Nodes without
+     * a transform component are skipped, their children attach to the nearest ancestor.
+     */
+    class bwxGLTransformSystem {
+    public:
+        static bwxGLTransformSystem& GetInstance() {
+            static bwxGLTransformSystem instance;
+            return instance;
+        }
+
+        void Update(const std::shared_ptr<bwxGLNode>& root);
+        void Clear();
+
+        inline size_t GetCount() const { return m_components.size(); }
+        inline size_t GetUpdatedCount() const { return m_updatedCount; }
+
+    private:
+        bwxGLTransformSystem() = default;
+        ~bwxGLTransformSystem() = default;
+
+        void Rebuild(const std::shared_ptr<bwxGLNode>& root);
+
+        // Structure of arrays, index = position in depth order
+        std::vector<glm::mat4> m_local;
+        std::vector<glm::mat4> m_world;
+        std::vector<int32_t> m_parent;            ///< -1 for top-level transforms
+        std::vector<uint8_t> m_dirty;             ///< World matrix recomputed in this pass
+        std::vector<unsigned int> m_localVersion;
+        std::vector<bwxGLTransformComponent*> m_components;
+
+        std::vector<std::shared_ptr<bwxGLTransformComponent>> m_owners; // Keeps m_components alive
+        std::weak_ptr<bwxGLNode> m_root;
+        unsigned int m_hierarchyVersion = 0;
+        bool m_built = false;
+        size_t m_updatedCount = 0;
+    };
+
+} // namespace bwx_sdk
+
+#endif // _BWX_GL_TRANSFORM_SYSTEM_H_
@@ -23,37 +23,79 @@
 #include <GL/glew.h>
 
 #include <bwx_sdk/bwx_gl/bwx_gl_buffer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_ring_buffer.h>
 #include <glm/glm.hpp>
-#include <map>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "bwx_gl_shader.h"
 
+// Glyph quads streamed per ring region (6 vertices x bwxGL_TEXT_VERTEX_FLOATS each)
+#define bwxGL_TEXT_RING_GLYPHS 1024
+// Position + UV (vec4), colour (vec4), atlas page (float)
+#define bwxGL_TEXT_VERTEX_FLOATS 9
+
+// Side of a square atlas page, in texels
+#define bwxGL_TTF_ATLAS_SIZE 1024
+// Empty texels kept around every glyph, so linear filtering does not bleed into neighbours
+#define bwxGL_TTF_GLYPH_PADDING 1
+// Distance, in atlas texels, covered by a distance field on each side of the outline
+#define bwxGL_TTF_SDF_SPREAD 6
+
+struct FT_LibraryRec_;
+struct FT_FaceRec_;
+
 namespace bwx_sdk {
 
+enum class bwxGL_TTF_MODE {
+    TTF_BITMAP,  ///< Coverage bitmaps, sharp at the loaded pixel height only
+    TTF_SDF      ///< Signed distance fields, one atlas for every size (needs FreeType 2.11+)
+};
+
 class bwxGLTTF {
 public:
     struct bwxGLTTFGlyph {
-        glm::ivec2 size;
-        glm::ivec2 bearing;
-        GLuint advance;
-        glm::vec2 uvTopLeft;
-        glm::vec2 uvBottomRight;
+        glm::ivec2 size = glm::ivec2(0);
+        glm::ivec2 bearing = glm::ivec2(0);
+        GLuint advance = 0;
+        glm::vec2 uvTopLeft = glm::vec2(0.0f);
+        glm::vec2 uvBottomRight = glm::vec2(0.0f);
+        GLint page = 0;  ///< Layer of the atlas texture array
     };
 
-    bool LoadFromFile(const std::string& filepath, int pixelHeight = 48);
+    bwxGLTTF() = default;
+
+    ~bwxGLTTF();
 
+    bwxGLTTF(const bwxGLTTF&) = delete;
+    bwxGLTTF& operator=(const bwxGLTTF&) = delete;
+
+    // Keeps the face open; the charset is rasterized up front, anything else on first use
+    // For TTF_SDF a small pixelHeight (~32) is enough, bwxGLText scales it up without blur
+    bool LoadFromFile(const std::string& filepath, int pixelHeight = 48,
+                      bwxGL_TTF_MODE mode = bwxGL_TTF_MODE::TTF_BITMAP);
+
+    inline bwxGL_TTF_MODE GetMode() const { return m_mode; }
+
+    // GL_TEXTURE_2D_ARRAY with one layer per page; a new name each time a page is added
     GLuint GetTextureAtlas() const;
 
+    inline GLsizei GetAtlasPages() const { return m_pageCount; }
+
+    // Rasterized and packed on first use (GL thread); references stay valid until the next LoadFromFile()
     bwxGLTTFGlyph& GetGlyph(wchar_t c);
 
-    std::map<GLchar, bwxGLTTF::bwxGLTTFGlyph>& GetGlyphs();
+    const bwxGLTTFGlyph* FindGlyph(wchar_t c) const;  ///< nullptr if not rasterized yet
+
+    inline size_t GetGlyphCount() const { return m_glyphs.size(); }
 
-    int GetGlyphHeight(wchar_t c) const;
+    int GetGlyphHeight(wchar_t c);
 
-    int GetGlyphWidth(wchar_t c) const;
+    int GetGlyphWidth(wchar_t c);
 
     void SetCharset(const std::wstring& charset);
 
@@ -76,8 +118,31 @@ private:
         L" !\"#$%&'()*+,-./0123456789:;<=>?@"
         L"ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
 
-    GLuint m_textureAtlas;
-    std::map<GLchar, bwxGLTTFGlyph> m_glyphs;
+    struct Shelf {
+        GLint page;
+        int y;
+        int height;
+        int x;  ///< Next free column
+    };
+
+    void Release();
+    uint32_t Lookup(uint32_t code) const;  ///< Index + 1 into m_glyphs, 0 if not rasterized
+    bool Rasterize(uint32_t code, bwxGLTTFGlyph& glyph);
+    bool Reserve(int width, int height, glm::ivec2& origin, GLint& page);
+    void AddPage();
+
+    bwxGL_TTF_MODE m_mode = bwxGL_TTF_MODE::TTF_BITMAP;
+    FT_LibraryRec_* m_library = nullptr;
+    FT_FaceRec_* m_face = nullptr;
+
+    GLuint m_textureAtlas = 0;
+    GLsizei m_pageCount = 0;
+    int m_pageTop = 0;  ///< First row above the last shelf of the last page
+    std::vector<Shelf> m_shelves;
+
+    std::deque<bwxGLTTFGlyph> m_glyphs;
+    std::vector<uint16_t> m_bmp;                      ///< Direct-mapped BMP code point -> index + 1
+    std::unordered_map<uint32_t, uint32_t> m_extended;  ///< Beyond the BMP, or past 65535 glyphs
 };
 
 class bwxGLText {
@@ -90,19 +155,42 @@ public:
 
     int GetFontHeight();
 
+    // Queues the string and flushes at once (anything queued before is drawn in the same call)
     void Render(const std::wstring& text, const glm::mat4& orth, const glm::vec2& pos, GLfloat scale,
                 const glm::vec4& color);
 
+    // Lays the string out into the batch; nothing is drawn until Flush()
+    void Queue(const std::wstring& text, const glm::vec2& pos, GLfloat scale, const glm::vec4& color);
+
+    // One glyph with its origin (baseline) at pos, for callers placing glyphs themselves; returns its advance
+    GLfloat QueueGlyph(wchar_t c, const glm::vec2& pos, GLfloat scale, const glm::vec4& color);
+
+    // Draws every queued glyph with one call per ring region
+    void Flush(const glm::mat4& orth);
+
+    inline size_t GetQueuedGlyphs() const { return m_batch.size() / (6 * bwxGL_TEXT_VERTEX_FLOATS); }
+
     // void SetEffectParams(const EffectParams& params);
 
     void SetShaderProgram(std::shared_ptr<bwxGLShaderProgram> shader);
 
+    // The program matching the font's mode
     void SetDefaultShaderProgram();
 
+    // Distance-field program, for fonts loaded with TTF_SDF
+    void SetSDFShaderProgram();
+
+    // Outline around distance-field glyphs; width in distance units (0 - 0.5, 0 disables it)
+    void SetOutline(GLfloat width, const glm::vec4& color);
+
 private:
-    bwxGLTTF& m_font;
+    bwxGLTTF* m_font;
     std::shared_ptr<bwxGLShaderProgram> m_shaderProgram;
-    std::shared_ptr<bwxGLBuffer> m_dynamicBuffer;
+    std::shared_ptr<bwxGLRingBuffer> m_dynamicBuffer;
+    std::vector<GLfloat> m_batch;  ///< Queued vertices, bwxGL_TEXT_VERTEX_FLOATS each
+    bool m_distanceField = false;  ///< m_shaderProgram is the SDF one
+    GLfloat m_outlineWidth = 0.0f;
+    glm::vec4 m_outlineColor = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,114 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_upload_worker.h
+// Purpose:     BWX_SDK Library; OpenGL Background resource creation on a shared context
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_UPLOAD_WORKER_H_
+#define _BWX_GL_UPLOAD_WORKER_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <wx/glcanvas.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bwx_sdk {
+
+/**
+ * @brief Thread with its own context, shared with the main one, that creates GL resources off the GL thread.
+ *
+ * Buffers, textures and programs are shared between the contexts; vertex arrays and framebuffers are not,
+ * so those stay on the GL thread. A job creates a new object on the worker and ends with a fence; Update()
+ * hands the object over once the fence has signalled, so the main context never waits for the transfer and
+ * never sees an object that is still being filled. The managers swap the new object in at that point:
+ * bwxGLBufferManager::RequestVBO/RequestEBO, bwxGLShaderProgramManager::CreateShaderProgramAsync and the
+ * texture loader (bwxGLTextureManager::LoadTexture with async) use the worker while it runs.
+ *
+ * The canvas may be the one the main context draws to; the worker never draws. Under X11 call
+ * XInitThreads() before the wxApp is created. Call Stop() before the canvas is destroyed; the
+ * destructor runs after wx has shut down and makes no wx or GL calls.
+ *
+ * @code
+ * auto& worker = bwxGLUploadWorker::GetInstance();
+ * worker.Start(canvas, context, 4, 5);     // same version as the main context
+ * ...
+ * // Every frame, GL thread
+ * worker.Update();
+ * bwxGLTextureManager::GetInstance().ProcessUploads();
+ * ...
+ * // Closing the frame, before the canvas goes
+ * worker.Stop();
+ * @endcode
+ */
+class bwxGLUploadWorker {
+public:
+    static bwxGLUploadWorker& GetInstance();
+
+    ~bwxGLUploadWorker();
+
+    bwxGLUploadWorker(const bwxGLUploadWorker&) = delete;
+    bwxGLUploadWorker& operator=(const bwxGLUploadWorker&) = delete;
+
+    // GL thread; creates the shared context through bwxGLUtils::CreateSharedContext
+    bool Start(wxGLCanvas* canvas, const wxGLContext* shareWith, int major = 3, int minor = 3);
+    // Runs the queued jobs, then joins the thread; finished jobs are still handed over by Update().
+    // Required before the canvas passed to Start() is destroyed
+    void Stop();
+    bool IsRunning() const;
+
+    // Any thread. create runs on the worker with the shared context current and returns success;
+    // ready(ok) runs on the GL thread in Update() once the GPU is done with what create issued.
+    // While the worker is not running both run in Update()
+    void Submit(std::function<bool()> create, std::function<void(bool)> ready);
+
+    // GL thread, once per frame; returns the number of jobs handed over
+    size_t Update();
+    // GL thread; blocks (running Update) until every submitted job is handed over
+    void Flush();
+
+    size_t GetPendingCount() const;
+
+private:
+    bwxGLUploadWorker() = default;
+
+    struct Job {
+        std::function<bool()> create;
+        std::function<void(bool)> ready;
+        GLsync fence = nullptr;
+        bool ok = false;
+    };
+
+    void ThreadLoop();
+
+    wxGLCanvas* m_canvas = nullptr;
+    std::unique_ptr<wxGLContext> m_context;
+    std::thread m_thread;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;     ///< Worker: new job or stop
+    std::condition_variable m_started;
+    std::deque<Job> m_queue;            ///< Guarded by m_mutex
+    std::vector<Job> m_finished;        ///< Created, waiting for the fence; guarded by m_mutex
+    size_t m_running = 0;               ///< Taken by the worker, not finished yet; guarded by m_mutex
+    bool m_stopping = false;
+    bool m_startDone = false;
+    bool m_startOK = false;
+};
+
+}  // namespace bwx_sdk
+
+#endif
@@ -23,8 +23,11 @@
 #include <GL/glew.h>
 #include <wx/glcanvas.h>
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <glm/glm.hpp>
+#include <memory>
 #include <string>
 
 namespace bwx_sdk {
@@ -41,6 +44,10 @@ public:
 
     static wxGLContextAttrs GetDefaultContextAttrs(int major = 3, int minor = 3);
 
+    // Context sharing objects with other (same version as other, see bwxGLUploadWorker); nullptr on failure
+    static std::unique_ptr<wxGLContext> CreateSharedContext(wxGLCanvas* canvas, const wxGLContext* other, int major = 3,
+                                                            int minor = 3);
+
     static wxGLAttributes GetDefaultCanvasAttrs(int depth = 24);
 
     static std::string GetErrorString(int err);
@@ -51,6 +58,13 @@ public:
     static std::vector<float> GenerateSimpleCubeVertices(bool textured = false);
 };
 
+#define bwxGL_FRAME_TIME_SAMPLES 120  // Frames kept for GetFrameTimeVariance()
+
+enum class bwxGL_FRAME_PACING {
+    FRAME_PACING_SLEEP,   ///< Remaining frame time slept off, then spun; every frame measured from StartFrame()
+    FRAME_PACING_PRECISE  ///< Absolute deadlines (no drift), adaptive coarse sleep and a yielding spin
+};
+
 class bwxGLFPSMonitor {
 public:
     bwxGLFPSMonitor();
@@ -59,6 +73,18 @@ public:
 
     void LimitFPS(int targetFPS);
 
+    inline void SetPacing(bwxGL_FRAME_PACING pacing) { m_pacing = pacing; m_deadlineSet = false; }
+    inline bwxGL_FRAME_PACING GetPacing() const { return m_pacing; }
+
+    // Precise pacing: the frame period becomes a whole number of refresh intervals (0 turns it off)
+    inline void SetRefreshRate(double hz) { m_refreshRate = hz; m_deadlineSet = false; }
+    inline double GetRefreshRate() const { return m_refreshRate; }
+    bool AlignToDisplay(const wxWindow* window);  ///< Refresh rate of the display showing window; false if unknown
+
+    // Seconds^2 and seconds, over the last bwxGL_FRAME_TIME_SAMPLES deltas of StartFrame()
+    GLfloat GetFrameTimeVariance() const;
+    GLfloat GetFrameTimeStdDev() const;
+
     GLfloat GetDelta() const;
 
     GLfloat GetFPS(int refresh_ms = 500);
@@ -68,6 +94,8 @@ public:
     GLfloat GetElapsedTime() const;
 
 private:
+    void WaitUntil(std::chrono::steady_clock::time_point deadline);
+
     std::chrono::steady_clock::time_point m_lastUpdate;
     std::chrono::steady_clock::time_point m_startTime;
     std::chrono::steady_clock::time_point m_frameStart;
@@ -75,6 +103,22 @@ private:
     GLfloat m_lastDelta;
     GLint m_frames;
     GLfloat m_fps;
+
+    bwxGL_FRAME_PACING m_pacing = bwxGL_FRAME_PACING::FRAME_PACING_SLEEP;
+    double m_refreshRate = 0.0;
+    std::chrono::steady_clock::time_point m_deadline;  ///< End of the current frame in precise pacing
+    bool m_deadlineSet = false;
+    int m_deadlineFPS = 0;
+
+    // Observed length of a 1 ms sleep (running mean and variance), so sleeping never overshoots the deadline
+    double m_sleepEstimate = 0.005;
+    double m_sleepMean = 0.005;
+    double m_sleepM2 = 0.0;
+    uint64_t m_sleepCount = 1;
+
+    std::array<GLfloat, bwxGL_FRAME_TIME_SAMPLES> m_frameTimes{};
+    size_t m_frameTimeCount = 0;
+    size_t m_frameTimeNext = 0;
 };
 
 }  // namespace bwx_sdk
@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_vertex_layout.h
+// Purpose:     BWX_SDK Library; OpenGL Interleaved vertex layout descriptor
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BWX_GL_VERTEX_LAYOUT_H_
+#define _BWX_GL_VERTEX_LAYOUT_H_
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bwx_sdk {
+
+// Attribute locations used by bwxGLMesh and bwxGLShaderGenerator
+#define bwxGL_ATTRIB_POSITION 0
+#define bwxGL_ATTRIB_NORMAL 1
+#define bwxGL_ATTRIB_TEX_COORD 2
+#define bwxGL_ATTRIB_TANGENT 3
+#define bwxGL_ATTRIB_BITANGENT 4
+#define bwxGL_ATTRIB_COLOR 5
+#define bwxGL_ATTRIB_BONE_INDICES 10  // After the instance matrix (6-9)
+#define bwxGL_ATTRIB_BONE_WEIGHTS 11
+
+// How float source data is stored in the vertex buffer
+enum bwxGLVertexEncoding {
+    bwxGL_ENCODING_FLOAT,          ///< 32-bit floats
+    bwxGL_ENCODING_HALF,           ///< 16-bit floats, padded to 4 bytes
+    bwxGL_ENCODING_SNORM_10_10_10, ///< Signed normalized 10:10:10:2 in 4 bytes (unit vectors)
+    bwxGL_ENCODING_UNORM8,         ///< Unsigned normalized bytes in 4 bytes (colours, alpha = 1)
+    bwxGL_ENCODING_UINT16          ///< Integer attribute, 16 bits per component (bone indices)
+};
+
+struct bwxGLVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+    glm::vec3 tangent;
+    glm::vec3 bitangent;
+    glm::vec3 color;
+    glm::vec3 uv;
+    glm::vec4 boneIndices;  ///< Up to bwxGL_MAX_BONE_INFLUENCES bones, as floats on the CPU side
+    glm::vec4 boneWeights;  ///< Sum to 1 for skinned vertices
+};
+
+struct bwxGLVertexAttribute {
+    GLuint location;
+    GLint components;      ///< Components passed to GL (packed encodings always use 4)
+    GLint sourceComponents;
+    GLenum type;
+    GLboolean normalized;
+    bwxGLVertexEncoding encoding;
+    GLuint offset;        ///< Byte offset inside the interleaved vertex
+    size_t sourceOffset;  ///< Byte offset of the float data inside bwxGLVertex
+};
+
+/**
+ * @brief Interleaved vertex format: attributes, their offsets and the stride, computed once.
+ */
+class bwxGLVertexLayout {
+public:
+    bwxGLVertexLayout() = default;
+
+    // Layout of the given bwxGL_MESH_* flags, position always first; bwxGL_MESH_COMPACT quantizes
+    static bwxGLVertexLayout FromMeshFormat(int format);
+
+    void Add(GLuint location, GLint components, size_t sourceOffset,
+             bwxGLVertexEncoding encoding = bwxGL_ENCODING_FLOAT);
+
+    // Encodes one source vertex (float data at sourceOffset) into dst
+    void Write(const void* source, unsigned char* dst) const;
+
+    // Expects the VAO and the vertex buffer to be bound
+    void Apply() const;
+
+    inline GLsizei GetStride() const { return m_stride; }
+    inline const std::vector<bwxGLVertexAttribute>& GetAttributes() const { return m_attributes; }
+    inline bool IsEmpty() const { return m_attributes.empty(); }
+
+    // Equal for layouts with the same GPU format (source offsets ignored)
+    uint64_t GetSignature() const;
+
+private:
+    std::vector<bwxGLVertexAttribute> m_attributes;
+    GLsizei m_stride = 0;
+};
+
+}  // namespace bwx_sdk
+
+#endif
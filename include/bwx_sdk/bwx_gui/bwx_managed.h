@@ -175,6 +175,12 @@ protected:
         (void)themeName;  // Suppress unused parameter warning
     }
 
+    /// @brief Get window of this control (implements bwxReactive)
+    ///
+    /// Lets broadcast freeze the top-level window during the pass and
+    /// lay it out once afterwards (no Layout() per control here).
+    wxWindow* getReactiveWindow() override { return this; }
+
 private:
     /// @brief Configuration flags (per-instance granular control)
     bool m_enableFontChange = true;   ///< React to font scale broadcasts?
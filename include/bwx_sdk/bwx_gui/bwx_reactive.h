@@ -12,6 +12,8 @@
 #include <vector>
 #include <string>
 
+class wxWindow;
+
 namespace bwx {
 namespace gui {
 
@@ -38,8 +40,13 @@ namespace gui {
 /// };
 /// ```
 ///
-/// **Thread Safety:** Single-threaded (GUI thread only) for MVP.
-/// Future: Add mutex for multi-threaded safety if needed.
+/// **Coalescing:** Broadcasts only record the new value. All changes made
+/// within one event-loop tick are delivered in a single pass (latest value wins),
+/// with each affected top-level window frozen during the pass and laid out once after it.
+///
+/// **Thread Safety:** Single-threaded (GUI thread only). Controls may be created
+/// or destroyed by handlers during a pass - registry slots are cleared, not erased,
+/// until the pass ends, so no lock or registry copy is needed.
 class bwxReactive {
 public:
     // ========================================================================
@@ -49,17 +56,29 @@ public:
     /// @brief Broadcast font scale change to all registered controls
     /// @param scale New font scaling factor (0.8 - 2.0 recommended range)
     ///
-    /// Iterates through all registered controls and calls onFontScaleChanged().
-    /// Controls can opt-out by checking enable flags in their implementation.
+    /// Calls onFontScaleChanged() of all registered controls on next event-loop tick
+    /// (immediately if there is no wxApp). Controls can opt-out by checking enable
+    /// flags in their implementation.
     static void broadcastFontScaleChange(double scale);
 
     /// @brief Broadcast theme change to all registered controls
     /// @param themeName New theme name ("Light", "Dark", "Custom", etc.)
     ///
-    /// Iterates through all registered controls and calls onThemeChanged().
-    /// Allows dynamic theme switching without application restart.
+    /// Calls onThemeChanged() of all registered controls on next event-loop tick
+    /// (immediately if there is no wxApp). Allows dynamic theme switching
+    /// without application restart.
     static void broadcastThemeChange(const std::string& themeName);
 
+    /// @brief Deliver pending broadcasts now (instead of on next event-loop tick)
+    ///
+    /// **Usage:** When the caller needs updated controls right away
+    /// ```cpp
+    /// bwxReactive::broadcastFontScaleChange(1.5);
+    /// bwxReactive::flushBroadcasts();
+    /// wxSize size = dialog->GetBestSize();  // Already uses new fonts
+    /// ```
+    static void flushBroadcasts();
+
     /// @brief Get number of registered reactive controls (diagnostics)
     /// @return Number of controls in static registry
     ///
@@ -84,18 +103,23 @@ protected:
     /// @brief Constructor - registers control in static registry
     ///
     /// Automatically called when control is created.
-    /// Adds `this` pointer to static registry vector.
+    /// Adds `this` pointer to static registry vector and remembers its slot.
     bwxReactive();
 
     /// @brief Destructor - unregisters control from static registry
     ///
     /// Automatically called when control is destroyed.
-    /// Removes `this` pointer from static registry vector.
+    /// Removes `this` pointer from static registry vector in O(1)
+    /// (last control moves into the freed slot).
     ///
     /// **Important:** Derived classes must call this destructor properly.
     /// Multiple inheritance is safe: wxButton dtor → bwxReactive dtor.
     virtual ~bwxReactive();
 
+    /// @brief Not copyable - registry slot belongs to one object
+    bwxReactive(const bwxReactive&) = delete;
+    bwxReactive& operator=(const bwxReactive&) = delete;
+
     // ========================================================================
     // Event Handlers (pure virtual - subclasses must implement)
     // ========================================================================
@@ -147,7 +171,23 @@ protected:
     /// ```
     virtual void onThemeChanged(const std::string& themeName) = 0;
 
+    /// @brief Get window of this control (for freezing and laying out its top-level window)
+    /// @return Window, or nullptr if control is not a window (default)
+    virtual wxWindow* getReactiveWindow() { return nullptr; }
+
+    /// @brief Called after broadcast pass, once the top-level window was laid out
+    ///
+    /// Only called for controls that are top-level windows themselves
+    /// (e.g. resize dialog to fit new content). Default: does nothing.
+    virtual void onLayoutUpdated() {}
+
 private:
+    /// @brief Queue delivery of pending changes for next event-loop tick (once)
+    static void scheduleDelivery();
+
+    /// @brief Deliver pending changes to all registered controls (one pass per change kind)
+    static void deliverPending();
+
     /// @brief Static registry of all live reactive controls
     ///
     /// **Implementation notes:**
@@ -155,11 +195,20 @@ private:
     /// - Controls auto-register on construction, auto-unregister on destruction
     /// - Broadcast iterates this vector to notify all controls
     ///
-    /// **Future improvement (if needed):**
-    /// - Use std::weak_ptr for safer lifetime management
-    /// - Add mutex for thread-safety
-    /// - Copy vector before iteration (prevents iterator invalidation)
+    /// - Each control knows its slot (m_registryIndex) - unregistration is swap-and-pop
+    /// - Controls destroyed during a pass leave nullptr slots, compacted after the pass
+    /// - Controls created during a pass are appended and notified in the same pass
     static std::vector<bwxReactive*> s_controls;
+
+    static int s_passDepth;                 ///< Nested delivery passes running (> 0: do not erase)
+    static bool s_hasEmptySlots;            ///< Registry has nullptr slots to compact
+    static bool s_deliveryScheduled;        ///< Delivery queued for next event-loop tick?
+    static bool s_hasPendingScale;          ///< Font scale change pending?
+    static double s_pendingScale;           ///< Latest requested font scale
+    static bool s_hasPendingTheme;          ///< Theme change pending?
+    static std::string s_pendingTheme;      ///< Latest requested theme
+
+    size_t m_registryIndex;                 ///< Slot of this control in s_controls
 };
 
 } // namespace gui
@@ -82,29 +82,25 @@ protected:
     /// @brief Handle font scale change (implements bwxReactive)
     /// @param scale New font scaling factor
     ///
-    /// **Automatic behavior:**
-    /// 1. Invalidate cached best sizes (forces sizer recalculation)
-    /// 2. Recalculate layout (respects new font sizes)
-    /// 3. Send size event (propagates to nested sizers)
-    /// 4. Resize dialog if needed (only grow, never shrink)
-    ///
-    /// **Why this works:**
-    /// - InvalidateBestSize() clears wxWindow's cached size
-    /// - Layout() triggers sizer recalculation
-    /// - SendSizeEvent() ensures nested wxStaticBoxSizer updates
-    /// - Only grows to prevent UI from becoming unusable
+    /// Only clears cached best size (critical for wxStaticBoxSizer!) - child
+    /// controls may not have their new fonts yet. Broadcast lays out the
+    /// dialog once after all controls changed, then calls onLayoutUpdated().
     void onFontScaleChanged(double /*scale*/) override {
-        // Step 1: Clear cached sizes (critical for wxStaticBoxSizer!)
         InvalidateBestSize();
+    }
 
-        // Step 2: Recalculate layout with new font sizes
-        Layout();
-
-        // Step 3: Propagate size event to all nested sizers
+    /// @brief Adjust dialog to new layout (implements bwxReactive)
+    ///
+    /// **Automatic behavior (after broadcast laid out the dialog):**
+    /// 1. Send size event (propagates to nested sizers)
+    /// 2. Resize dialog if needed (only grow, never shrink)
+    /// 3. Refresh
+    void onLayoutUpdated() override {
+        // Step 1: Propagate size event to all nested sizers
         // wxSEND_EVENT_POST ensures it happens after current event processing
         SendSizeEvent(wxSEND_EVENT_POST);
 
-        // Step 4: Resize dialog if content needs more space
+        // Step 2: Resize dialog if content needs more space
         // Only grow, never shrink (prevents dialog from becoming too small)
         wxSize currentSize = GetSize();
         wxSize bestSize = GetBestSize();
@@ -118,10 +114,13 @@ protected:
             SetSize(finalSize);
         }
 
-        // Step 5: Visual refresh
+        // Step 3: Visual refresh
         Refresh();
     }
 
+    /// @brief Get window of this control (implements bwxReactive)
+    wxWindow* getReactiveWindow() override { return this; }
+
     /// @brief Handle theme change (implements bwxReactive)
     /// @param themeName New theme name
     ///
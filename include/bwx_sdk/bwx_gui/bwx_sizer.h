@@ -47,6 +47,9 @@ class bwxBoxSizer : public wxBoxSizer {
 public:
     bwxBoxSizer(int orientation = wxVERTICAL);
 
+    // Applies the margins of items added since the last layout (adding items does not lay out)
+    wxSize CalcMin() override;
+
     wxSizerItem* Add(wxWindow* w, int prop, int flags, int marg);
 
     wxSizerItem* Add(wxSizer* s, int prop, int flags, int marg);
@@ -144,6 +147,8 @@ public:
     }
 
 private:
+    bool m_marginsDirty;
+
     void RecalculateMargins();
 
     wxSizerItem* Add_(wxWindow* w, int prop = 1, int flags = 0, int marg = bwxSIZER_DEFAULT_MARGIN);
@@ -16,9 +16,15 @@
 #endif
 
 #include <wx/datetime.h>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <deque>
+#include <string>
+
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
 
 namespace bwx_sdk {
 namespace gui {
@@ -82,13 +88,14 @@ struct FormatRun
 	int startPos;       ///< Start position (inclusive)
 	int endPos;         ///< End position (exclusive)
 	TextFormat format;  ///< Formatting for this range
+	int styleId;        ///< Interned style ID of format (-1 = not interned yet)
 
 	/// Default constructor
-	FormatRun() : startPos(0), endPos(0) { }
+	FormatRun() : startPos(0), endPos(0), styleId(-1) { }
 
 	/// Full constructor
-	FormatRun(int start, int end, const TextFormat& fmt)
-		: startPos(start), endPos(end), format(fmt) { }
+	FormatRun(int start, int end, const TextFormat& fmt, int style = -1)
+		: startPos(start), endPos(end), format(fmt), styleId(style) { }
 
 	/// Check if position is within this run
 	bool Contains(int pos) const { return pos >= startPos && pos < endPos; }
@@ -97,6 +104,122 @@ struct FormatRun
 	int GetLength() const { return endPos - startPos; }
 };
 
+/// Style span - run stored as length + style ID only (compact, for undo)
+struct StyleSpan
+{
+	int length;   ///< Number of characters
+	int styleId;  ///< Interned style ID
+};
+
+// ============================================================================
+// Text Style Table - interned formats
+// ============================================================================
+
+/// Interned text formats - every distinct TextFormat is stored once and
+/// referred to by a small integer style ID
+///
+/// IDs are dense (0..GetCount()-1) and never change or get reused, so
+/// renderers can cache fonts and metrics in a flat vector indexed by ID.
+/// Style 0 is always the default TextFormat.
+class TextStyleTable
+{
+public:
+	/// Default style ID
+	static constexpr int DefaultStyle = 0;
+
+	TextStyleTable();
+
+	/// Get ID of format, adding it to the table if new - O(1) average
+	int Intern(const TextFormat& format);
+
+	/// Get format of style ID (default format for unknown IDs)
+	const TextFormat& Get(int styleId) const;
+
+	/// Number of styles
+	int GetCount() const { return static_cast<int>(m_styles.size()); }
+
+private:
+	/// Hash of all format attributes
+	static size_t Hash(const TextFormat& format);
+
+	std::vector<TextFormat> m_styles;                   ///< Formats by style ID
+	std::unordered_multimap<size_t, int> m_index;       ///< Format hash -> style ID
+};
+
+// ============================================================================
+// Format Run Tree - balanced storage of format runs
+// ============================================================================
+
+/// Format runs covering the document back to back, kept in a treap
+///
+/// Nodes store run lengths instead of positions and every node knows the
+/// length of its subtree, so a position is found by descending from the root
+/// and an edit only resizes one run - the runs after it move implicitly.
+/// Runs hold interned style IDs (see TextStyleTable), so joining adjacent
+/// runs compares integers. Adjacent runs never share a style; they are
+/// joined when they meet.
+///
+/// Operations:
+/// - Lookup by position: O(log n)
+/// - Range query: O(log n + k) for k runs in range
+/// - Insert / delete text: O(log n)
+/// - Assign format to range: O(log n + k)
+class FormatRunTree
+{
+public:
+	/// Style run visitor - receives runs clipped to the queried range
+	using Visitor = std::function<void(int startPos, int endPos, int styleId)>;
+
+	FormatRunTree();
+	~FormatRunTree();
+
+	/// Replace all runs with one default style run of given length
+	void Reset(int length);
+
+	/// Text inserted at pos - the run containing pos grows, a run ending there
+	/// only if it is the last one
+	void InsertText(int pos, int length);
+
+	/// Text in range [startPos, endPos) deleted - runs shrink or disappear
+	void DeleteText(int startPos, int endPos);
+
+	/// Give range [startPos, endPos) one style
+	void Assign(int startPos, int endPos, int styleId);
+
+	/// Replace range [startPos, endPos) with runs (sorted and interned; gaps get default style)
+	void Assign(int startPos, int endPos, const std::vector<FormatRun>& runs);
+
+	/// Get style of run containing pos, -1 past the end
+	int Find(int pos) const;
+
+	/// Visit runs intersecting range [startPos, endPos), in order
+	void Visit(int startPos, int endPos, const Visitor& visitor) const;
+
+	/// Total length covered by runs
+	int GetLength() const;
+
+	/// Number of runs
+	int GetCount() const;
+
+private:
+	struct Node;
+
+	/// Create single run node with random priority
+	std::unique_ptr<Node> MakeNode(int styleId, int length);
+
+	/// Split tree into first pos characters (left) and the rest (right)
+	void Split(std::unique_ptr<Node> node, int pos, std::unique_ptr<Node>& left, std::unique_ptr<Node>& right);
+
+	/// Merge two trees (all of left comes before all of right)
+	static std::unique_ptr<Node> Merge(std::unique_ptr<Node> left, std::unique_ptr<Node> right);
+
+	/// Merge two trees, joining the runs where they meet if styles match
+	std::unique_ptr<Node> Join(std::unique_ptr<Node> left, std::unique_ptr<Node> right);
+
+	std::unique_ptr<Node> m_root;  ///< Treap root (nullptr for empty document)
+	uint32_t m_seed;               ///< Priority generator state
+};
+
 // ============================================================================
 // Cursor Structure
 // ============================================================================
@@ -153,6 +276,13 @@ struct Selection
 	bool IsEmpty() const { return !active || startPos == endPos; }
 };
 
+/// Text range [startPos, endPos) (search results, highlights)
+struct TextRange
+{
+	int startPos;  ///< Start position (inclusive)
+	int endPos;    ///< End position (exclusive)
+};
+
 // ============================================================================
 // Document Metadata
 // ============================================================================
@@ -179,6 +309,19 @@ struct DocumentMetadata
 	}
 };
 
+// ============================================================================
+// Document Snapshot
+// ============================================================================
+
+/// Immutable copy of document content, written by a background save
+struct DocumentSnapshot
+{
+	std::wstring text;               ///< Flat copy of text
+	std::vector<TextFormat> styles;  ///< Styles in use, renumbered densely
+	std::vector<StyleSpan> spans;    ///< Runs (style IDs index styles)
+	DocumentMetadata metadata;       ///< Metadata at snapshot time
+};
+
 // ============================================================================
 // Document Observer Interface
 // ============================================================================
@@ -200,6 +343,15 @@ public:
 
 	/// Called when formatting changes
 	virtual void OnFormatChanged() = 0;
+
+	/// Called before OnTextChanged() with the edited range
+	/// @param pos Start of edit
+	/// @param removedLength Number of characters removed at pos
+	/// @param insertedLength Number of characters inserted at pos
+	virtual void OnTextRangeChanged(int /*pos*/, int /*removedLength*/, int /*insertedLength*/) { }
+
+	/// Called before OnFormatChanged() with the reformatted range [startPos, endPos)
+	virtual void OnFormatRangeChanged(int /*startPos*/, int /*endPos*/) { }
 };
 
 // ============================================================================
@@ -225,6 +377,9 @@ public:
 	/// Merge another command into this one
 	virtual void Merge(ITextCommand* /*other*/) { }
 
+	/// Get approximate memory held by this command (bytes, for undo budget)
+	virtual size_t GetMemorySize() const { return sizeof(ITextCommand); }
+
 	/// Get command type name (for debugging)
 	virtual wxString GetTypeName() const = 0;
 };
@@ -233,8 +388,12 @@ public:
 // Text Storage Interface (Strategy Pattern)
 // ============================================================================
 
+/// Chunk visitor - receives consecutive pieces of stored text (no copies)
+/// The pointer is valid only during the call.
+using TextChunkVisitor = std::function<void(const wxChar* chars, int length)>;
+
 /// Text storage interface - allows swapping storage implementation
-/// (MVP: Gap Buffer; Future: Rope or Piece Table if profiling shows issues)
+/// (Gap Buffer by default, Piece Table for large documents)
 class ITextStorage
 {
 public:
@@ -263,8 +422,30 @@ public:
 
 	/// Clear all text
 	virtual void Clear() = 0;
+
+	/// Visit text in range [startPos, endPos) as contiguous chunks, in order
+	virtual void ForEachChunk(int startPos, int endPos, const TextChunkVisitor& visitor) const = 0;
+
+	/// Get number of lines (newlines + 1)
+	virtual int GetLineCount() const = 0;
+
+	/// Get position of first character of line (0-based line)
+	virtual int GetLineStart(int line) const = 0;
+
+	/// Get line containing position (number of newlines before it)
+	virtual int GetLineFromPosition(int pos) const = 0;
 };
 
+/// Available text storage implementations
+enum class TextStorageType
+{
+	GapBuffer,   ///< Contiguous buffer with a gap - O(1) edits at the cursor, O(n) jumps
+	PieceTable   ///< Balanced tree of pieces - O(log n) edits and lookups anywhere
+};
+
+/// Create text storage of given type
+std::unique_ptr<ITextStorage> CreateTextStorage(TextStorageType type);
+
 // ============================================================================
 // Main Document Class
 // ============================================================================
@@ -272,7 +453,7 @@ public:
 /// Text document model - manages text content, formatting, cursor, undo/redo
 ///
 /// This class is independent of how the text is displayed (View).
-/// It uses Strategy Pattern for text storage (Gap Buffer by default).
+/// It uses Strategy Pattern for text storage (Gap Buffer by default, see TextStorageType).
 /// It uses Command Pattern for undo/redo operations.
 /// It uses Observer Pattern to notify UI of changes.
 class bwxTextDocument
@@ -282,8 +463,8 @@ public:
 	// Construction / Destruction
 	// ========================================================================
 
-	/// Default constructor - creates empty document
-	bwxTextDocument();
+	/// Constructor - creates empty document using given storage
+	explicit bwxTextDocument(TextStorageType storageType = TextStorageType::GapBuffer);
 
 	/// Destructor
 	~bwxTextDocument();
@@ -305,7 +486,8 @@ public:
 	void InsertText(int pos, const wxString& text);
 
 	/// Delete text in range [startPos, endPos) (creates undo command)
-	void DeleteText(int startPos, int endPos);
+	/// keystroke: single character removed by Backspace/Delete - consecutive ones undo together
+	void DeleteText(int startPos, int endPos, bool keystroke = false);
 
 	/// Get character at position
 	wxChar GetChar(int pos) const;
@@ -316,6 +498,12 @@ public:
 	/// Clear all text (clears undo history)
 	void Clear();
 
+	/// Get storage implementation in use
+	TextStorageType GetStorageType() const { return m_storageType; }
+
+	/// Switch storage implementation (keeps text, formatting and undo history)
+	void SetStorageType(TextStorageType type);
+
 	// ========================================================================
 	// Formatting Operations
 	// ========================================================================
@@ -326,18 +514,79 @@ public:
 	/// Get formatting at position
 	TextFormat GetFormatAt(int pos) const;
 
-	/// Get all format runs (for rendering)
-	const std::vector<FormatRun>& GetFormatRuns() const { return m_formatRuns; }
+	/// Get all format runs
+	std::vector<FormatRun> GetFormatRuns() const { return GetFormatRuns(0, GetLength()); }
 
 	/// Get format runs that intersect range [startPos, endPos)
 	std::vector<FormatRun> GetFormatRuns(int startPos, int endPos) const;
 
+	/// Visit style runs that intersect range [startPos, endPos), without copying them out
+	void ForEachFormatRun(int startPos, int endPos, const FormatRunTree::Visitor& visitor) const;
+
+	/// Get style ID at position
+	int GetStyleIdAt(int pos) const;
+
+	/// Get format of style ID
+	const TextFormat& GetStyle(int styleId) const { return m_styles.Get(styleId); }
+
+	/// Get number of interned styles (style IDs are 0..count-1)
+	int GetStyleCount() const { return m_styles.GetCount(); }
+
+	/// Get number of format runs
+	int GetFormatRunCount() const { return m_formatRuns.GetCount(); }
+
 	/// Clear all formatting (reset to default)
 	void ClearFormatting();
 
 	/// Clear formatting in range [startPos, endPos) (creates undo command)
 	void ClearFormatting(int startPos, int endPos);
 
+	// ========================================================================
+	// Lines & Chunks (no full-text copies)
+	// ========================================================================
+
+	/// Get number of lines (paragraphs separated by '\n')
+	int GetLineCount() const;
+
+	/// Get position of first character of line
+	int GetLineStart(int line) const;
+
+	/// Get end position of line (exclusive, without the '\n')
+	int GetLineEnd(int line) const;
+
+	/// Get line containing position
+	int GetLineFromPosition(int pos) const;
+
+	/// Get text of line (without the '\n')
+	wxString GetLineText(int line) const;
+
+	/// Visit text in range [startPos, endPos) as contiguous chunks of storage
+	void ForEachChunk(int startPos, int endPos, const TextChunkVisitor& visitor) const;
+
+	// ========================================================================
+	// Search (chunk by chunk, no full-text copies)
+	// ========================================================================
+
+	/// Find first occurrence of text at or after startPos
+	/// @param text Text to find
+	/// @param startPos Position to start from
+	/// @param matchCase Case-sensitive search?
+	/// @return Position of match, or -1 if not found
+	int Find(const wxString& text, int startPos = 0, bool matchCase = true) const;
+
+	/// Find all (non-overlapping) occurrences of text within [startPos, endPos)
+	/// A limited range lets callers search the visible part first.
+	/// @param text Text to find
+	/// @param matchCase Case-sensitive search?
+	/// @param startPos Start of searched range
+	/// @param endPos End of searched range (-1 = end of document)
+	/// @return Ranges of matches, ascending
+	std::vector<TextRange> FindAll(const wxString& text, bool matchCase = true, int startPos = 0, int endPos = -1) const;
+
+	/// Replace all occurrences of text - one undo step, one notification
+	/// @return Number of replacements
+	int ReplaceAll(const wxString& text, const wxString& replacement, bool matchCase = true);
+
 	// ========================================================================
 	// Cursor & Selection
 	// ========================================================================
@@ -403,16 +652,71 @@ public:
 	/// Get maximum undo stack size
 	int GetMaxUndoStack() const { return m_maxUndoStack; }
 
+	/// Set memory budget of undo/redo history in bytes (default: 16 MB)
+	/// Oldest steps are dropped first; the newest step is always kept.
+	void SetMaxUndoMemory(size_t bytes);
+
+	/// Get memory budget of undo/redo history in bytes
+	size_t GetMaxUndoMemory() const { return m_maxUndoMemory; }
+
+	/// Get approximate memory held by undo/redo history in bytes
+	size_t GetUndoMemory() const { return m_undoMemory + m_redoMemory; }
+
+	// ========================================================================
+	// Batches
+	// ========================================================================
+
+	/// Start batch - edits until the matching EndBatch() become one undo step,
+	/// and observers get one merged notification per change kind (batches nest)
+	void BeginBatch();
+
+	/// End batch - commit its undo step and send merged notifications
+	void EndBatch();
+
+	/// Check if a batch is open
+	bool IsInBatch() const { return m_batchDepth > 0; }
+
 	// ========================================================================
 	// File I/O
 	// ========================================================================
 
-	/// Load document from .ktxt file (JSON format)
+	/// Load document from .ktxt file (JSON format, streamed - no JSON tree)
+	/// Document is left unchanged if the file cannot be read or is invalid.
 	bool LoadFromFile(const wxString& path);
 
-	/// Save document to .ktxt file (JSON format)
+	/// Open UTF-8 plain text file without reading it in (memory-mapped, decoded on demand)
+	/// Switches to Piece Table storage with the file as its read-only original buffer;
+	/// edits go to the added buffer, so memory grows with edits, not with file size.
+	/// The file must not be changed by other programs while the document uses it.
+	/// "\r\n" reads as "\n". Document is left unchanged if the file cannot be opened.
+	bool OpenTextFile(const wxString& path);
+
+	/// Save document to .ktxt file (JSON format, streamed from storage chunks)
+	/// Written through a temporary file, so a failed save keeps the old file.
 	bool SaveToFile(const wxString& path);
 
+	/// Save document to .ktxt file on a worker thread
+	/// Only the snapshot is taken here; encoding and disk I/O run in the background.
+	/// Waits for a previous background save first.
+	/// @param path File path
+	/// @param onDone Called on the worker thread with the result (optional)
+	void SaveToFileAsync(const wxString& path, std::function<void(bool)> onDone = nullptr);
+
+	/// Check if a background save is running
+	bool IsSaving() const { return !m_saveJobs.IsDone(); }
+
+	/// Wait until background save finishes
+	void WaitForSave();
+
+	/// Take immutable copy of text, styles and metadata (for background save)
+	std::shared_ptr<const DocumentSnapshot> CreateSnapshot() const;
+
+	/// Write snapshot to .ktxt file (safe on any thread)
+	static bool SaveSnapshot(const DocumentSnapshot& snapshot, const wxString& path);
+
+	/// Get change counter - grows with every text or format change (for autosave)
+	unsigned int GetChangeCount() const { return m_changeCount; }
+
 	// ========================================================================
 	// Metadata
 	// ========================================================================
@@ -455,9 +759,15 @@ public:
 	/// Apply format without creating undo command (called by ApplyFormatCommand)
 	void ApplyFormatInternal(int startPos, int endPos, const TextFormat& format);
 
-	/// Restore format runs (used by ApplyFormatCommand::Undo)
+	/// Restore format runs
 	void RestoreFormatRuns(int startPos, int endPos, const std::vector<FormatRun>& runs);
 
+	/// Get styles of range as compact spans (used by ApplyFormatCommand)
+	std::vector<StyleSpan> GetStyleSpans(int startPos, int endPos) const;
+
+	/// Restore styles from compact spans (used by ApplyFormatCommand::Undo)
+	void RestoreStyleSpans(int startPos, const std::vector<StyleSpan>& spans);
+
 private:
 	// ========================================================================
 	// Private Methods
@@ -466,9 +776,28 @@ private:
 	/// Add command to undo stack
 	void AddCommand(std::unique_ptr<ITextCommand> cmd);
 
+	/// Drop redo history (new action invalidates redo)
+	void ClearRedoStack();
+
+	/// Drop oldest undo steps over count limit or memory budget
+	void TrimUndoHistory();
+
+	/// Report matches of text in [startPos, endPos) until onMatch returns false
+	void Search(const wxString& text, bool matchCase, int startPos, int endPos,
+	            const std::function<bool(int pos)>& onMatch) const;
+
+	/// Collect styles in use (renumbered densely) and runs referring to them
+	void GetFileStyles(std::vector<TextFormat>& styles, std::vector<StyleSpan>& spans) const;
+
 	/// Notify observers that text changed
 	void NotifyTextChanged();
 
+	/// Notify observers of edited range (followed by NotifyTextChanged)
+	void NotifyTextRangeChanged(int pos, int removedLength, int insertedLength);
+
+	/// Notify observers of reformatted range (followed by NotifyFormatChanged)
+	void NotifyFormatRangeChanged(int startPos, int endPos);
+
 	/// Notify observers that cursor moved
 	void NotifyCursorMoved();
 
@@ -481,18 +810,32 @@ private:
 	/// Update cursor line/column from position
 	void UpdateCursorLineColumn();
 
-	/// Merge format runs if possible (called after ApplyFormat)
-	void MergeAdjacentRuns();
+	/// Count words starting in range [startPos, endPos)
+	/// (a word running into the range from before startPos is not counted)
+	int CountWords(int startPos, int endPos) const;
 
-	/// Split format run at position (called before ApplyFormat)
-	void SplitRunAt(int pos);
+	/// Changes collected during a batch (sent as one notification per kind)
+	struct BatchChanges
+	{
+		bool text = false;       ///< Text edited?
+		int textStart = 0;       ///< Start of merged edit
+		int textEnd = 0;         ///< End of merged edit (current positions)
+		int textDelta = 0;       ///< Length change of merged edit
+		bool format = false;     ///< Formatting changed?
+		int formatStart = 0;     ///< Start of merged reformatted range
+		int formatEnd = 0;       ///< End of merged reformatted range
+		bool cursor = false;     ///< Cursor moved?
+		bool selection = false;  ///< Selection changed?
+	};
 
 	// ========================================================================
 	// Member Variables
 	// ========================================================================
 
-	std::unique_ptr<ITextStorage> m_storage;              ///< Text storage (Gap Buffer)
-	std::vector<FormatRun> m_formatRuns;                  ///< Formatting runs
+	std::unique_ptr<ITextStorage> m_storage;              ///< Text storage
+	TextStorageType m_storageType;                         ///< Storage implementation in use
+	TextStyleTable m_styles;                              ///< Interned formats
+	FormatRunTree m_formatRuns;                           ///< Formatting runs (style IDs)
 	Cursor m_cursor;                                       ///< Current cursor
 	Selection m_selection;                                 ///< Current selection
 	DocumentMetadata m_metadata;                           ///< Metadata (word count, etc.)
@@ -500,8 +843,45 @@ private:
 	std::deque<std::unique_ptr<ITextCommand>> m_undoStack; ///< Undo stack
 	std::deque<std::unique_ptr<ITextCommand>> m_redoStack; ///< Redo stack
 	int m_maxUndoStack;                                    ///< Maximum undo stack size
+	size_t m_maxUndoMemory;                                ///< Memory budget of undo/redo history
+	size_t m_undoMemory;                                   ///< Memory held by undo stack
+	size_t m_redoMemory;                                   ///< Memory held by redo stack
+
+	int m_batchDepth;                                      ///< Nesting depth of open batches
+	std::vector<std::unique_ptr<ITextCommand>> m_batchCommands; ///< Commands of open batch
+	BatchChanges m_batchChanges;                           ///< Notifications held back by open batch
 
 	std::vector<IDocumentObserver*> m_observers;           ///< Registered observers
+
+	unsigned int m_changeCount;                            ///< Text/format changes so far
+	bwxJobCounter m_saveJobs;                              ///< Background save in flight
+};
+
+// ============================================================================
+// Text Batch - RAII batch scope
+// ============================================================================
+
+/// Batch scope - BeginBatch() on construction, EndBatch() on destruction
+///
+/// Usage:
+/// @code
+/// {
+///     TextBatch batch(doc);
+///     doc.DeleteText(start, end);
+///     doc.InsertText(start, replacement);
+/// }   // one undo step, one layout and repaint
+/// @endcode
+class TextBatch
+{
+public:
+	explicit TextBatch(bwxTextDocument& doc) : m_doc(doc) { m_doc.BeginBatch(); }
+	~TextBatch() { m_doc.EndBatch(); }
+
+	TextBatch(const TextBatch&) = delete;
+	TextBatch& operator=(const TextBatch&) = delete;
+
+private:
+	bwxTextDocument& m_doc;  ///< Batched document
 };
 
 } // namespace gui
@@ -16,7 +16,9 @@
 #endif
 
 #include <wx/timer.h>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include <bwx_sdk/bwx_gui/bwx_text_document.h>
 #include <bwx_sdk/bwx_gui/bwx_text_renderer.h>
@@ -35,7 +37,7 @@ namespace gui {
 /// - Formatting (bold, italic, underline, font, size, color)
 /// - Undo/Redo (Command pattern)
 /// - Clipboard (Copy, Cut, Paste)
-/// - Multiple view modes (MVP: Full View only)
+/// - Multiple view modes (Full View, Page View)
 /// - wxControl integration (standard wxWidgets widget)
 ///
 /// Architecture:
@@ -53,7 +55,7 @@ public:
 	enum ViewMode
 	{
 		VIEW_FULL = 0,       ///< Full View - continuous text, no pages (MVP)
-		VIEW_PAGE,           ///< Page View - MS Word-like (Task #00020)
+		VIEW_PAGE,           ///< Page View - MS Word-like (PageViewRenderer)
 		VIEW_TYPEWRITER,     ///< Typewriter Mode - immersive (Task #00021)
 		VIEW_PUBLISHER       ///< Publisher View - manuscript (Task #00022)
 	};
@@ -107,7 +109,7 @@ public:
 	// View Mode
 	// ========================================================================
 
-	/// Set view mode (MVP: only VIEW_FULL supported)
+	/// Set view mode (VIEW_FULL and VIEW_PAGE supported)
 	/// @param mode New view mode
 	void SetViewMode(ViewMode mode);
 
@@ -123,6 +125,16 @@ public:
 	/// Get renderer (const version)
 	const ITextRenderer* GetRenderer() const { return m_renderer.get(); }
 
+	/// Renderer factory - creates renderer for view mode (nullptr = built-in renderer)
+	using RendererFactory = std::function<std::unique_ptr<ITextRenderer>(ViewMode mode)>;
+
+	/// Set renderer factory (e.g. OpenGL renderer of bwx_gl) and recreate renderer
+	/// @param factory Factory (empty = built-in renderers only)
+	void SetRendererFactory(RendererFactory factory);
+
+	/// Refresh control (and renderer's own window, if it has one)
+	void Refresh(bool eraseBackground = true, const wxRect* rect = nullptr) override;
+
 	// ========================================================================
 	// Editing Operations
 	// ========================================================================
@@ -154,7 +166,26 @@ public:
 	bool CanRedo() const;
 
 	// ========================================================================
-	// File I/O (future - Days 11-12)
+	// Search
+	// ========================================================================
+
+	/// Highlight all occurrences of text (empty = clear highlight)
+	/// Matches are kept up to date while editing - only text around edits is searched again.
+	/// @param text Text to find
+	/// @param matchCase Case-sensitive search?
+	void SetSearchHighlight(const wxString& text, bool matchCase = true);
+
+	/// Get highlighted matches (ascending)
+	const std::vector<TextRange>& GetSearchMatches() const { return m_searchMatches; }
+
+	/// Select next occurrence after cursor (wraps around to the start)
+	/// @param text Text to find
+	/// @param matchCase Case-sensitive search?
+	/// @return true if found
+	bool FindNext(const wxString& text, bool matchCase = true);
+
+	// ========================================================================
+	// File I/O
 	// ========================================================================
 
 	/// Load document from .ktxt file
@@ -167,6 +198,12 @@ public:
 	/// @return true on success, false on error
 	bool SaveToFile(const wxString& path);
 
+	/// Enable periodic background save of changed document
+	/// A failed save is logged and tried again on the next tick.
+	/// @param path Autosave file path (empty = disable)
+	/// @param intervalMs Interval in milliseconds (<= 0 = disable)
+	void SetAutoSave(const wxString& path, int intervalMs);
+
 protected:
 	// ========================================================================
 	// wxControl Overrides
@@ -206,9 +243,15 @@ protected:
 	/// Caret timer event - toggle caret visibility
 	void OnCaretTimer(wxTimerEvent& event);
 
+	/// Autosave timer event - save changed document in background
+	void OnAutoSaveTimer(wxTimerEvent& event);
+
 	/// Mouse wheel event - scroll
 	void OnMouseWheel(wxMouseEvent& event);
 
+	/// Idle event - continue deferred layout
+	void OnIdle(wxIdleEvent& event);
+
 	// ========================================================================
 	// IDocumentObserver Implementation
 	// ========================================================================
@@ -225,6 +268,12 @@ protected:
 	/// Called when text formatting changes
 	void OnFormatChanged() override;
 
+	/// Called with edited range before OnTextChanged
+	void OnTextRangeChanged(int pos, int removedLength, int insertedLength) override;
+
+	/// Called with reformatted range before OnFormatChanged
+	void OnFormatRangeChanged(int startPos, int endPos) override;
+
 private:
 	// ========================================================================
 	// Initialization
@@ -269,6 +318,29 @@ private:
 	/// Stop caret blink timer
 	void StopCaretTimer();
 
+	// ========================================================================
+	// Partial Repaint
+	// ========================================================================
+
+	/// Refresh area given in document coords (converted to client coords)
+	void RefreshDocumentRect(const wxRect& rect);
+
+	/// Update layout and refresh what it changed, plus caret and selection
+	void RefreshLayoutChanges();
+
+	/// Refresh old and new caret rectangles
+	void RefreshCaret();
+
+	/// Refresh lines of old and new selection
+	void RefreshSelection();
+
+	// ========================================================================
+	// Search
+	// ========================================================================
+
+	/// Update highlighted matches after edit (same arguments as OnTextRangeChanged)
+	void UpdateSearchMatches(int pos, int removedLength, int insertedLength);
+
 	// ========================================================================
 	// Scrolling
 	// ========================================================================
@@ -283,6 +355,10 @@ private:
 	/// @param y Scroll position (pixels from top)
 	void ScrollTo(int y);
 
+	/// Set scroll position - moves existing pixels, repaints exposed strip only
+	/// @param y Scroll position (pixels from top, clamped)
+	void SetScrollPosition(int y);
+
 	// ========================================================================
 	// Member Variables
 	// ========================================================================
@@ -291,6 +367,7 @@ private:
 	bwxTextDocument m_document;                  ///< Document model
 	ViewMode m_viewMode;                         ///< Current view mode
 	std::unique_ptr<ITextRenderer> m_renderer;   ///< Current renderer (Strategy Pattern)
+	RendererFactory m_rendererFactory;           ///< Custom renderers (empty = built-in only)
 
 	// Caret
 	wxTimer m_caretTimer;                        ///< Caret blink timer
@@ -300,9 +377,24 @@ private:
 	// Scrolling
 	int m_scrollY;                               ///< Current scroll position (pixels)
 
+	// Autosave
+	wxTimer m_autoSaveTimer;                     ///< Autosave interval timer
+	wxString m_autoSavePath;                     ///< Autosave file path
+	unsigned int m_autoSaveChangeCount;          ///< Document change count at last save
+
+	// Partial repaint
+	wxRect m_caretRect;                          ///< Last painted caret (document coords)
+	int m_selectionStart;                        ///< Last painted selection start
+	int m_selectionEnd;                          ///< Last painted selection end (== start: none)
+
 	// Mouse Selection
 	bool m_isSelecting;                          ///< Is user currently selecting with mouse?
 
+	// Search highlight
+	wxString m_searchText;                       ///< Highlighted text (empty = none)
+	bool m_searchMatchCase;                      ///< Case-sensitive highlight?
+	std::vector<TextRange> m_searchMatches;      ///< Highlighted matches (ascending)
+
 	// ========================================================================
 	// Event Table
 	// ========================================================================
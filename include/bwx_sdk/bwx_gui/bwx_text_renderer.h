@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        bwx_text_renderer.h
-// Purpose:     Text renderer interface and Full View renderer
+// Purpose:     Text renderer interface, Full View and Page View renderers
 // Author:      Kalahari Team
 // Created:     2025-11-04
 // Copyright:   (c) 2025 Kalahari Project
@@ -16,10 +16,15 @@
 #endif
 
 #include <wx/graphics.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <vector>
 #include <memory>
-#include <map>
+#include <unordered_map>
+#include <string>
 
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
 #include <bwx_sdk/bwx_gui/bwx_text_document.h>
 
 namespace bwx_sdk {
@@ -45,6 +50,26 @@ public:
 	/// @param scrollY Vertical scroll position
 	virtual void Render(wxDC& dc, const wxRect& clientRect, int scrollY) = 0;
 
+	/// Render only part of the viewport (partial repaint)
+	/// @param dc Device context to render to (content outside updateRect may be left as is)
+	/// @param clientRect Client area rectangle
+	/// @param scrollY Vertical scroll position
+	/// @param updateRect Area to repaint (client coords)
+	virtual void RenderArea(wxDC& dc, const wxRect& clientRect, int scrollY, const wxRect& /*updateRect*/) { Render(dc, clientRect, scrollY); }
+
+	/// Bring layout of viewport up to date and get area it changed since last call
+	/// @param scrollY Vertical scroll position
+	/// @param clientRect Client area rectangle
+	/// @return Changed area (client coords), empty if nothing changed
+	virtual wxRect UpdateLayout(int /*scrollY*/, const wxRect& clientRect) { return clientRect; }
+
+	/// Show or hide cursor (caret blink, focus)
+	virtual void SetCursorVisible(bool /*visible*/) { }
+
+	/// Set ranges to highlight (e.g. search matches, ascending, non-overlapping)
+	/// Caller refreshes the control - highlights do not add layout damage.
+	virtual void SetHighlights(const std::vector<TextRange>& /*ranges*/) { }
+
 	/// Hit test - convert screen coordinates to document position
 	/// @param x X coordinate (client coords)
 	/// @param y Y coordinate (client coords)
@@ -71,6 +96,21 @@ public:
 	/// Invalidate layout (forces recalculation on next render)
 	virtual void InvalidateLayout() = 0;
 
+	/// Notify renderer of text edit (lays out affected text only, if supported)
+	/// @param pos Start of edit
+	/// @param removedLength Number of characters removed at pos
+	/// @param insertedLength Number of characters inserted at pos
+	virtual void OnTextEdited(int /*pos*/, int /*removedLength*/, int /*insertedLength*/) { InvalidateLayout(); }
+
+	/// Invalidate layout of range [startPos, endPos) only (e.g. after formatting)
+	virtual void InvalidateRange(int /*startPos*/, int /*endPos*/) { InvalidateLayout(); }
+
+	/// Continue deferred layout work (call from idle handler)
+	/// @param maxMilliseconds Time budget for this call
+	/// @param scrollY Scroll position - adjusted so visible content stays in place
+	/// @return True if more work remains
+	virtual bool LayoutIdle(int /*maxMilliseconds*/, int& /*scrollY*/) { return false; }
+
 	/// Get total content height (for scrollbar)
 	/// @return Total height in pixels
 	virtual int GetTotalHeight() const = 0;
@@ -78,6 +118,17 @@ public:
 	/// Set document reference
 	/// @param doc Document to render
 	virtual void SetDocument(bwxTextDocument* doc) = 0;
+
+	/// Create own drawing window (e.g. OpenGL canvas) as child of host, covering its client area
+	/// Called once host window exists; input events of the window go to host.
+	virtual void Attach(wxWindow* /*host*/) { }
+
+	/// Destroy window created by Attach (renderer is being replaced or host destroyed)
+	virtual void Detach() { }
+
+	/// Get window renderer draws into (nullptr = host itself, through wxDC)
+	/// Host repaints it whole - no pixel scrolling, no partial repaint.
+	virtual wxWindow* GetSurface() const { return nullptr; }
 };
 
 // ============================================================================
@@ -91,14 +142,17 @@ public:
 /// - No page boundaries
 /// - Vertical scrolling only
 /// - Efficient viewport culling (render visible lines only)
-/// - Layout caching (recalculate only on text/size change)
+/// - Layout caching per paragraph (edits re-wrap only affected paragraphs)
+/// - Optional lazy layout: estimated heights off-screen, precise layout near viewport
+/// - Background layout: off-screen paragraphs wrapped by worker thread (lazy layout)
+/// - Damage tracking: layout changes report the area to repaint (partial repaint)
 class FullViewRenderer : public ITextRenderer
 {
 public:
 	/// Constructor
 	FullViewRenderer();
 
-	/// Destructor
+	/// Destructor (waits for running layout job)
 	~FullViewRenderer();
 
 	// ========================================================================
@@ -106,11 +160,18 @@ public:
 	// ========================================================================
 
 	void Render(wxDC& dc, const wxRect& clientRect, int scrollY) override;
+	void RenderArea(wxDC& dc, const wxRect& clientRect, int scrollY, const wxRect& updateRect) override;
+	wxRect UpdateLayout(int scrollY, const wxRect& clientRect) override;
+	void SetCursorVisible(bool visible) override { m_cursorVisible = visible; }
+	void SetHighlights(const std::vector<TextRange>& ranges) override { m_highlights = ranges; }
 	int HitTest(int x, int y, int scrollY) const override;
 	wxRect GetCursorRect(int position) const override;
 	std::vector<wxRect> GetSelectionRects(int startPos, int endPos) const override;
 	void OnResize(int width, int height) override;
 	void InvalidateLayout() override;
+	void OnTextEdited(int pos, int removedLength, int insertedLength) override;
+	void InvalidateRange(int startPos, int endPos) override;
+	bool LayoutIdle(int maxMilliseconds, int& scrollY) override;
 	int GetTotalHeight() const override;
 	void SetDocument(bwxTextDocument* doc) override;
 
@@ -121,12 +182,23 @@ public:
 	/// Set left margin
 	void SetMarginLeft(int margin) { m_marginLeft = margin; InvalidateLayout(); }
 
+	/// Set top margin (space above first paragraph)
+	void SetMarginTop(int margin) { m_marginTop = margin; InvalidateLayout(); }
+
 	/// Set right margin
 	void SetMarginRight(int margin) { m_marginRight = margin; InvalidateLayout(); }
 
 	/// Set line spacing multiplier (1.0 = single spacing, 1.5 = 1.5x, 2.0 = double)
 	void SetLineSpacing(double spacing) { m_lineSpacing = spacing; InvalidateLayout(); }
 
+	/// Enable lazy layout - paragraphs away from viewport get estimated heights,
+	/// refined by LayoutIdle() (constant time to first paint on large documents)
+	void SetLazyLayout(bool lazy) { m_lazyLayout = lazy; InvalidateLayout(); }
+
+	/// Wrap off-screen paragraphs on worker thread (lazy layout only, default on)
+	/// UI thread then lays out only viewport and paragraphs the worker could not measure.
+	void SetBackgroundLayout(bool background) { m_backgroundLayout = background; }
+
 	/// Set selection color
 	/// @param color RGB color for selection background
 	void SetSelectionColor(const wxColour& color) { m_selectionColor = color; }
@@ -135,71 +207,271 @@ public:
 	/// @param opacity Alpha value (0-255, where 0 = transparent, 255 = opaque)
 	void SetSelectionOpacity(int opacity) { m_selectionOpacity = opacity; }
 
+	/// Set highlight color (search matches, drawn with selection opacity)
+	void SetHighlightColor(const wxColour& color) { m_highlightColor = color; }
+
 	/// Get left margin
 	int GetMarginLeft() const { return m_marginLeft; }
 
+	/// Get top margin
+	int GetMarginTop() const { return m_marginTop; }
+
 	/// Get right margin
 	int GetMarginRight() const { return m_marginRight; }
 
 	/// Get line spacing
 	double GetLineSpacing() const { return m_lineSpacing; }
 
+	/// Check if lazy layout is enabled
+	bool IsLazyLayout() const { return m_lazyLayout; }
+
+	/// Check if background layout is enabled
+	bool IsBackgroundLayout() const { return m_backgroundLayout; }
+
 	/// Get selection color
 	wxColour GetSelectionColor() const { return m_selectionColor; }
 
 	/// Get selection opacity
 	int GetSelectionOpacity() const { return m_selectionOpacity; }
 
-private:
+	/// Get highlight color
+	wxColour GetHighlightColor() const { return m_highlightColor; }
+
+protected:
 	// ========================================================================
 	// Layout Structures
 	// ========================================================================
 
-	/// Single character position info (for hit testing)
-	struct CharInfo
-	{
-		int x;          ///< X position in line
-		int width;      ///< Character width
-	};
-
 	/// Layout line - single line of wrapped text
+	/// (positions and y are relative to the paragraph, so edits elsewhere never touch it)
 	struct LayoutLine
 	{
-		int startPos;                   ///< Start position in document
-		int endPos;                     ///< End position in document (exclusive)
-		int y;                          ///< Y position (top of line)
+		int startPos;                   ///< Start position in paragraph
+		int endPos;                     ///< End position in paragraph (exclusive)
+		int y;                          ///< Y position (top of line, from top of paragraph)
 		int height;                     ///< Line height (max font height in line)
-		std::vector<CharInfo> charInfo; ///< Character positions (for hit testing)
+		int edgeOffset;                 ///< First character edge in ParagraphLayout::edges
 
-		/// Check if document position is in this line
+		/// Check if paragraph position is in this line
 		bool Contains(int pos) const { return pos >= startPos && pos < endPos; }
+
+		/// Get number of characters in line
+		int GetLength() const { return endPos - startPos; }
+	};
+
+	/// Paragraph layout - wrapped lines of one '\n' separated paragraph
+	///
+	/// Character positions (for hit testing) are kept once per paragraph:
+	/// for every character, the x of its right edge relative to the left
+	/// margin, as cumulative advances. Lines index into this array, so a line
+	/// costs no allocation and a character two bytes.
+	struct ParagraphLayout
+	{
+		std::vector<LayoutLine> lines;  ///< Wrapped lines (empty until measured)
+		std::vector<uint16_t> edges;    ///< Right edge of each character, per line from 0
+		int height;                     ///< Sum of line heights (estimate until measured)
+		bool measured;                  ///< Laid out precisely?
+		int pageY;                      ///< Offset of paragraph top within its page (page view)
+
+		ParagraphLayout() : height(0), measured(false), pageY(0) { }
+
+		/// Get x (relative to left margin) before character index of line (0..length)
+		int GetEdge(const LayoutLine& line, int index) const
+		{
+			index = std::min(index, line.GetLength());
+			return index > 0 ? edges[line.edgeOffset + index - 1] : 0;
+		}
+
+		/// Get character of line at x (relative to left margin) - binary search
+		/// @return Character index, or line length if x is past the last character
+		int FindChar(const LayoutLine& line, int x) const;
+
+		/// Drop lines and character positions
+		void Clear() { lines.clear(); edges.clear(); }
+	};
+
+	/// Font, metrics and glyph advances of one document style (indexed by style ID)
+	struct StyleCache
+	{
+		/// Code points below this are direct-mapped
+		static constexpr int DirectAdvances = 256;
+
+		wxFont font;                    ///< Font created from style format
+		int height;                     ///< Text height ("M" extent)
+		int ascent;                     ///< Ascent (height minus descent)
+		int descent;                    ///< Descent below baseline
+		bool valid;                     ///< Filled in yet?
+		std::vector<int> directAdvances;              ///< Advance by code point (-1 = not measured)
+		std::unordered_map<wxChar, int> otherAdvances; ///< Advances of other code points
+
+		StyleCache() : height(0), ascent(0), descent(0), valid(false) { }
+	};
+
+	/// Paragraph heights with prefix sums (Fenwick tree)
+	/// Y of paragraph, paragraph at Y and height change are O(log n).
+	class HeightIndex
+	{
+	public:
+		/// Rebuild from paragraph layouts - O(n)
+		void Assign(const std::vector<ParagraphLayout>& paragraphs);
+
+		/// Change height of paragraph - O(log n)
+		void Set(int index, int height);
+
+		/// Get sum of heights of paragraphs before index - O(log n)
+		int GetOffset(int index) const;
+
+		/// Get paragraph containing offset (clamped to last paragraph) - O(log n)
+		int FindIndex(int offset) const;
+
+		/// Get sum of all heights
+		int GetTotal() const { return m_total; }
+
+		/// Get number of paragraphs
+		int GetCount() const { return static_cast<int>(m_heights.size()); }
+
+		/// Remove all paragraphs
+		void Clear() { m_tree.clear(); m_heights.clear(); m_total = 0; }
+
+	private:
+		std::vector<int> m_tree;     ///< Fenwick tree (1-based)
+		std::vector<int> m_heights;  ///< Paragraph heights
+		int m_total = 0;             ///< Sum of heights
 	};
 
 	// ========================================================================
 	// Layout Calculation
 	// ========================================================================
 
-	/// Calculate layout (word wrap, line breaks)
+	/// Calculate layout (whole document, or dirty paragraphs only)
 	void CalculateLayout();
 
+	/// Calculate layout for single paragraph
+	void LayoutParagraph(int paragraph, wxDC& dc);
+
 	/// Calculate layout for single line (word wrap)
-	void CalculateLine(const wxString& text, int startPos, wxDC& dc, int& yPos);
+	void CalculateLine(const wxString& text, int startPos, wxDC& dc, ParagraphLayout& layout, int& yPos);
+
+	/// Pack words into lines of width (no DC - also used by layout worker)
+	/// @param text Paragraph text
+	/// @param length Text length
+	/// @param advances Advance of each character
+	/// @param width Column width
+	/// @param lineHeight Line height
+	/// @param layout Layout to add lines and edges to (positions paragraph-relative)
+	/// @param yPos Y of first line, advanced past last line
+	static void WrapLines(const wxChar* text, size_t length, const std::vector<int>& advances,
+		int width, int lineHeight, ParagraphLayout& layout, int& yPos);
+
+	/// Mark paragraphs [first, last] for layout on next render
+	void MarkDirty(int first, int last);
+
+	/// Record changed area [top, bottom) in document coords (bottom INT_MAX = to the end)
+	void AddDamage(int top, int bottom);
+
+	/// Record damage of paragraph just laid out (everything below if its height changed)
+	void AddParagraphDamage(int paragraph, int oldHeight);
+
+	/// Lazy layout: turn dirty paragraphs into estimated ones
+	void DeferDirtyParagraphs();
+
+	/// Lazy layout: measure paragraphs in and just below viewport
+	void LayoutVisible(wxDC& dc, int scrollY, int clientHeight);
 
-	/// Measure text extent with formatting
-	wxSize MeasureText(const wxString& text, const TextFormat& format, wxDC& dc);
+	/// Lazy layout: measure average character width and line height
+	void MeasureAverages(wxDC& dc);
 
-	/// Get or create font from format
-	wxFont GetFont(const TextFormat& format);
+	/// Lazy layout: estimate paragraph height from its length
+	int EstimateHeight(int paragraph) const;
+
+	/// Get Y position of paragraph top
+	int GetParagraphY(int paragraph) const { return m_marginTop + m_heights.GetOffset(paragraph); }
+
+	/// Measure text extent with style
+	wxSize MeasureText(const wxString& text, int styleId, wxDC& dc);
+
+	/// Get or create font and metrics of style (selects its font into dc)
+	/// Measurement DC keeps its font - selected again only when style changes.
+	StyleCache& SelectStyle(wxDC& dc, int styleId);
+
+	/// Get persistent DC for text measurement (1x1 bitmap, created on first use)
+	wxDC& GetMeasureDC();
+
+	/// Get advance width of character in style (dc must have style font selected)
+	/// Measured through dc on first use only.
+	int GetAdvance(StyleCache& style, wxChar ch, wxDC& dc);
+
+	/// Measure advances of word characters (cached, or through dc for complex scripts)
+	/// @return Word width
+	int MeasureWord(StyleCache& style, const wxString& word, wxDC& dc, std::vector<int>& advances);
 
 	/// Check if layout is valid
 	bool IsLayoutValid() const { return m_layoutValid; }
 
+	// ========================================================================
+	// Background Layout
+	// ========================================================================
+
+	/// Advance table of one style, copied for the worker (fonts and DCs stay on UI thread)
+	struct AdvanceTable
+	{
+		int height;                                   ///< Text height
+		std::vector<int> directAdvances;              ///< Advance by code point (-1 = not measured)
+		std::unordered_map<wxChar, int> otherAdvances; ///< Advances of other code points
+
+		AdvanceTable() : height(0) { }
+	};
+
+	/// Batch of paragraphs for worker - input copied on UI thread, results
+	/// published when job counter drops to zero
+	struct LayoutJob
+	{
+		unsigned int generation;        ///< Layout generation at start (results stale if changed)
+		int first;                      ///< First paragraph of batch
+		int width;                      ///< Column width
+		double lineSpacing;             ///< Line spacing multiplier
+		std::vector<std::wstring> texts;               ///< Paragraph texts
+		std::vector<int> styleIds;                     ///< Style at paragraph start
+		std::unordered_map<int, AdvanceTable> styles;  ///< Advance tables of styles used
+		std::vector<ParagraphLayout> results;          ///< Layouts (unmeasured = left to UI thread)
+
+		LayoutJob() : generation(0), first(0), width(1), lineSpacing(1.0) { }
+	};
+
+	/// Copy paragraphs from m_idleNext and schedule their layout on worker
+	void StartLayoutJob();
+
+	/// Take results of finished layout job (if not stale)
+	void ApplyLayoutJob();
+
+	/// Add advance table of style to job (if style was measured on UI thread yet)
+	void CopyAdvanceTable(LayoutJob& job, int styleId) const;
+
+	/// Worker thread: wrap paragraphs whose characters all have cached advances
+	static void RunLayoutJob(LayoutJob& job);
+
+	/// Drop results of running layout job and of worker batch (layout changed)
+	void DiscardLayoutJob();
+
+	// ========================================================================
+	// Extension Points (derived renderers, e.g. page view)
+	// ========================================================================
+
+	/// Called after paragraphs [first, last] were laid out and their heights stored
+	/// (derived renderers may move lines, e.g. to page breaks, and update m_heights)
+	virtual void OnParagraphsLaidOut(int /*first*/, int /*last*/) { }
+
+	/// Clear background of repainted area (client coords)
+	virtual void RenderBackground(wxDC& dc, int scrollY, const wxRect& updateRect);
+
 	// ========================================================================
 	// Rendering Helpers
 	// ========================================================================
 
-	/// Render single line
-	void RenderLine(wxDC& dc, const LayoutLine& line, int scrollY);
+	/// Render single line of paragraph
+	/// @param paragraphStart Document position of paragraph
+	/// @param yPos Screen Y of paragraph top
+	void RenderLine(wxDC& dc, const LayoutLine& line, int paragraphStart, int yPos);
 
 	/// Render cursor
 	void RenderCursor(wxDC& dc, int scrollY);
@@ -207,31 +479,133 @@ private:
 	/// Render selection
 	void RenderSelection(wxDC& dc, int scrollY);
 
-	/// Apply text format to DC (font, color)
-	void ApplyFormat(wxDC& dc, const TextFormat& format);
+	/// Render highlights within document range [startPos, endPos)
+	void RenderHighlights(wxDC& dc, int scrollY, int startPos, int endPos);
+
+	/// Apply text style to DC (font, color)
+	void ApplyStyle(wxDC& dc, int styleId);
 
-	/// Get visible line range (for viewport culling)
-	void GetVisibleLineRange(int scrollY, int clientHeight, int& firstLine, int& lastLine) const;
+	/// Get visible paragraph range (for viewport culling)
+	void GetVisibleParagraphRange(int scrollY, int clientHeight, int& firstParagraph, int& lastParagraph) const;
 
 	// ========================================================================
 	// Member Variables
 	// ========================================================================
 
 	bwxTextDocument* m_document;        ///< Document reference
-	std::vector<LayoutLine> m_lines;    ///< Layout lines
+	std::vector<ParagraphLayout> m_paragraphs; ///< Layout per paragraph
+	HeightIndex m_heights;              ///< Paragraph heights (prefix sums)
+	int m_dirtyFirst;                   ///< First paragraph to lay out (-1 = none)
+	int m_dirtyLast;                    ///< Last paragraph to lay out
 	int m_clientWidth;                  ///< Client width
 	int m_clientHeight;                 ///< Client height
 	int m_marginLeft;                   ///< Left margin
+	int m_marginTop;                    ///< Top margin
 	int m_marginRight;                  ///< Right margin
 	double m_lineSpacing;               ///< Line spacing multiplier
-	bool m_layoutValid;                 ///< Is layout up-to-date?
+	bool m_layoutValid;                 ///< Is layout up-to-date (apart from dirty paragraphs)?
+	int m_damageTop;                    ///< Changed area top, document coords (-1 = none)
+	int m_damageBottom;                 ///< Changed area bottom (INT_MAX = to the end)
+	bool m_cursorVisible;               ///< Draw cursor?
+
+	// Lazy layout
+	bool m_lazyLayout;                  ///< Estimate off-screen paragraphs?
+	int m_idleNext;                     ///< First paragraph that may be unmeasured (-1 = all measured)
+
+	// Background layout
+	bool m_backgroundLayout;            ///< Wrap off-screen paragraphs on worker thread?
+	std::shared_ptr<LayoutJob> m_layoutJob; ///< Scheduled layout job (nullptr = none)
+	bwxJobCounter m_layoutJobs;         ///< Running layout jobs
+	unsigned int m_layoutGeneration;    ///< Incremented when layout changes (stale job detection)
+	int m_layoutEnd;                    ///< End of last worker batch - UI thread finishes paragraphs before it
+	int m_averageCharWidth;             ///< Estimated character width
+	int m_averageLineHeight;            ///< Estimated line height
 
 	// Selection appearance (Task #00019 Settings)
 	wxColour m_selectionColor;          ///< Selection background color
 	int m_selectionOpacity;             ///< Selection opacity (0-255)
 
-	// Font cache (expensive to create, so reuse)
-	std::map<wxString, wxFont> m_fontCache; ///< Font cache (key = fontName-size-bold-italic-underline)
+	// Highlights (search matches)
+	std::vector<TextRange> m_highlights; ///< Highlighted ranges (ascending)
+	wxColour m_highlightColor;          ///< Highlight background color
+
+	// Style cache (fonts are expensive to create, so reuse)
+	std::vector<StyleCache> m_styleCache; ///< Font and metrics by document style ID
+
+	// Measurement (DC setup is expensive on HiDPI, so reuse across layouts)
+	wxBitmap m_measureBitmap;           ///< 1x1 bitmap selected into m_measureDC
+	std::unique_ptr<wxMemoryDC> m_measureDC; ///< Measurement DC (nullptr until first layout)
+	int m_measureStyle;                 ///< Style whose font is selected into m_measureDC (-1 = none)
+};
+
+// ============================================================================
+// PageViewRenderer - Page View (MS Word-like)
+// ============================================================================
+
+/// Page View renderer - text flows through fixed-size pages on a gray desk
+///
+/// Features:
+/// - Fixed column width (page width minus margins) - window resize never re-wraps
+/// - Lines crossing page bottom move to next page (paragraph height includes gap)
+/// - Incremental pagination: after edit, pages are re-flowed from edited paragraph
+///   only until page breaks are back where they were
+/// - Lazy layout: estimated paragraphs are not split into pages until measured
+class PageViewRenderer : public FullViewRenderer
+{
+public:
+	/// Constructor (A4 at 96 DPI, 1 inch margins)
+	PageViewRenderer();
+
+	// ========================================================================
+	// ITextRenderer Implementation
+	// ========================================================================
+
+	void OnResize(int width, int height) override;
+	int GetTotalHeight() const override;
+
+	// ========================================================================
+	// Configuration
+	// ========================================================================
+
+	/// Set page size in pixels
+	void SetPageSize(const wxSize& size);
+
+	/// Set page margins in pixels (left/right and top/bottom)
+	void SetPageMargins(int horizontal, int vertical);
+
+	/// Get page size in pixels
+	wxSize GetPageSize() const { return m_pageSize; }
+
+	/// Get number of pages
+	int GetPageCount() const;
+
+protected:
+	// ========================================================================
+	// FullViewRenderer Overrides
+	// ========================================================================
+
+	void OnParagraphsLaidOut(int first, int last) override;
+	void RenderBackground(wxDC& dc, int scrollY, const wxRect& updateRect) override;
+
+private:
+	/// Move lines of measured paragraph to page breaks
+	/// @param layout Paragraph layout
+	/// @param pageY Offset of paragraph top within page text area
+	void PaginateParagraph(ParagraphLayout& layout, int pageY);
+
+	/// Update horizontal margins - center page in client area
+	void UpdateColumn();
+
+	/// Distance between tops of two consecutive pages
+	int GetPageStride() const { return m_pageSize.GetHeight() + m_pageGap; }
+
+	/// Height of page text area
+	int GetPageTextHeight() const { return std::max(m_pageSize.GetHeight() - 2 * m_pageMarginV, 1); }
+
+	wxSize m_pageSize;                  ///< Page size (pixels)
+	int m_pageMarginH;                  ///< Page left/right margin
+	int m_pageMarginV;                  ///< Page top/bottom margin
+	int m_pageGap;                      ///< Gap between pages (and above first page)
 };
 
 } // namespace gui
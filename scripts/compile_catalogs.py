@@ -0,0 +1,144 @@
+'''
+BWX_SDK Library
+Tool for compiling .mo translation catalogs into memory-mapped .bwxcat files (bwxCatalog)
+Copyright 2026 by Bartosz Warzocha (bartosz.warzocha@gmail.com)
+wxWidgets licence
+'''
+
+import os
+import struct
+import argparse
+
+MASK64 = (1 << 64) - 1
+MAGIC = b'BWXCAT1\0'
+KEYS_PER_BUCKET = 4
+
+def mix(h):
+    # splitmix64 finalizer - must match bwx_catalog.cpp
+    h ^= h >> 30
+    h = (h * 0xbf58476d1ce4e5b9) & MASK64
+    h ^= h >> 27
+    h = (h * 0x94d049bb133111eb) & MASK64
+    h ^= h >> 31
+    return h
+
+def catalog_hash(data, seed):
+    # FNV-1a 64 - must match bwx_catalog.cpp
+    h = (0xcbf29ce484222325 ^ seed) & MASK64
+    for byte in data:
+        h ^= byte
+        h = (h * 0x100000001b3) & MASK64
+    return h
+
+def read_mo(file_path):
+    with open(file_path, 'rb') as file:
+        data = file.read()
+
+    magic = struct.unpack_from('<I', data, 0)[0]
+    if magic == 0x950412de:
+        order = '<'
+    elif magic == 0xde120495:
+        order = '>'
+    else:
+        raise ValueError(f'{file_path}: not a .mo file')
+
+    count, originals, translations = struct.unpack_from(order + 'III', data, 8)
+    messages = []
+    for i in range(count):
+        key_length, key_offset = struct.unpack_from(order + 'II', data, originals + i * 8)
+        value_length, value_offset = struct.unpack_from(order + 'II', data, translations + i * 8)
+        key = data[key_offset:key_offset + key_length]
+        value = data[value_offset:value_offset + value_length]
+
+        # Plural entries are looked up by the singular msgid
+        key = key.split(b'\0', 1)[0]
+        if key and value.strip(b'\0'):
+            messages.append((key, value))
+    return messages
+
+def build_index(keys, seed):
+    count = len(keys)
+    bucket_count = max(1, (count + KEYS_PER_BUCKET - 1) // KEYS_PER_BUCKET)
+
+    hashes = []
+    buckets = [[] for _ in range(bucket_count)]
+    for index, key in enumerate(keys):
+        h = catalog_hash(key, seed)
+        h1 = mix(h ^ 0x9e3779b97f4a7c15)
+        h2 = mix(h ^ 0xc2b2ae3d27d4eb4f)
+        hashes.append((h1, h2))
+        buckets[mix(h) % bucket_count].append(index)
+
+    # Hash and displace: largest buckets first, slot = (h1 + d0 * h2 + d1) % count
+    displacements = [0] * bucket_count
+    slots = [None] * count
+    for bucket in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        members = buckets[bucket]
+        if not members:
+            continue
+
+        d = 0
+        while True:
+            if d > 0xffffffff:
+                return None
+            d0, d1 = divmod(d, count)
+            taken = [((hashes[i][0] + d0 * hashes[i][1] + d1) & MASK64) % count for i in members]
+            if len(set(taken)) == len(taken) and all(slots[s] is None for s in taken):
+                break
+            d += 1
+
+        displacements[bucket] = d
+        for member, slot in zip(members, taken):
+            slots[slot] = member
+
+    return displacements, slots
+
+def compile_catalog(mo_files, output_path):
+    messages = {}
+    for mo_file in mo_files:
+        for key, value in read_mo(mo_file):
+            # The first catalog wins for duplicated messages
+            messages.setdefault(key, value)
+
+    keys = list(messages.keys())
+    seed = 0
+    index = build_index(keys, seed) if keys else ([], [])
+    while index is None:
+        seed += 1
+        index = build_index(keys, seed)
+    displacements, slots = index
+
+    strings = bytearray()
+    entries = []
+    for slot in slots:
+        key = keys[slot]
+        value = messages[key]
+        entries.append((len(strings), len(key), len(strings) + len(key), len(value)))
+        strings += key + value
+
+    with open(output_path, 'wb') as file:
+        file.write(MAGIC)
+        file.write(struct.pack('<IIII', len(keys), len(displacements), seed, len(strings)))
+        file.write(struct.pack(f'<{len(displacements)}I', *displacements))
+        for entry in entries:
+            file.write(struct.pack('<IIII', *entry))
+        file.write(strings)
+
+    print(f'{output_path}: {len(keys)} messages')
+
+def compile_locale_folder(locale_dir):
+    for language in sorted(os.listdir(locale_dir)):
+        language_dir = os.path.join(locale_dir, language)
+        if not os.path.isdir(language_dir):
+            continue
+
+        mo_files = sorted(os.path.join(language_dir, name) for name in os.listdir(language_dir) if name.endswith('.mo'))
+        if mo_files:
+            compile_catalog(mo_files, os.path.join(language_dir, language + '.bwxcat'))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Compile .mo catalogs of every <language> folder into <language>/<language>.bwxcat')
+    parser.add_argument('locale_dir', nargs='?', default='locale', help='Folder with one subfolder per language')
+    args = parser.parse_args()
+
+    compile_locale_folder(args.locale_dir)
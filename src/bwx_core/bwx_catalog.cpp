@@ -0,0 +1,235 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_catalog.cpp
+// Purpose:     BWX_SDK Library; Memory-mapped, pre-indexed translation catalog
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_catalog.cpp
+ * @brief Implements lookups in compiled (.bwxcat) translation catalogs.
+ *
+ * File layout (little-endian): "BWXCAT1\0", count, bucket count, seed, strings size (uint32),
+ * bucket displacements (uint32[bucket count]), entries in slot order (uint32 key offset,
+ * key length, value offset, value length) and the UTF-8 string pool. Keys follow the .mo
+ * conventions: "context\x04msgid", plural values are "\0"-separated forms.
+ */
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+#include <bwx_sdk/bwx_core/bwx_catalog.h>
+
+namespace bwx_sdk {
+
+	namespace {
+
+		constexpr char CATALOG_MAGIC[8] = { 'B', 'W', 'X', 'C', 'A', 'T', '1', '\0' };
+		constexpr size_t CATALOG_HEADER_SIZE = 24;
+
+		// Must match scripts/compile_catalogs.py
+		inline uint64_t CatalogMix(uint64_t h)
+		{
+			h ^= h >> 30;
+			h *= 0xbf58476d1ce4e5b9ULL;
+			h ^= h >> 27;
+			h *= 0x94d049bb133111ebULL;
+			h ^= h >> 31;
+			return h;
+		}
+
+		inline uint64_t CatalogHash(uint64_t h, std::string_view data)
+		{
+			for (unsigned char byte : data)
+			{
+				h ^= byte;
+				h *= 0x100000001b3ULL;
+			}
+			return h;
+		}
+
+		inline uint32_t ReadUInt32(const char* data)
+		{
+			const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+			return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+				| (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+		}
+
+	}
+
+	/// Read-only mapping of the catalog file
+	struct bwxCatalog::File
+	{
+		~File()
+		{
+#if defined(_WIN32)
+			if (data) UnmapViewOfFile(data);
+			if (mapping) CloseHandle(mapping);
+			if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+			if (data) munmap(const_cast<char*>(data), size);
+			if (fd >= 0) close(fd);
+#endif
+		}
+
+		bool Open(const wxString& filename)
+		{
+#if defined(_WIN32)
+			file = CreateFileW(filename.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) return false;
+
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return false;
+			size = static_cast<size_t>(fileSize.QuadPart);
+
+			mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping) data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+			fd = open(filename.fn_str(), O_RDONLY);
+			if (fd < 0) return false;
+
+			struct stat info;
+			if (fstat(fd, &info) != 0 || info.st_size == 0) return false;
+			size = static_cast<size_t>(info.st_size);
+
+			void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped != MAP_FAILED) data = static_cast<const char*>(mapped);
+#endif
+			return data != nullptr;
+		}
+
+#if defined(_WIN32)
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+#else
+		int fd = -1;
+#endif
+		const char* data = nullptr;
+		size_t size = 0;
+	};
+
+	bwxCatalog::bwxCatalog() = default;
+
+	bwxCatalog::~bwxCatalog() = default;
+
+	std::shared_ptr<const bwxCatalog> bwxCatalog::Load(const wxString& filename, wxString* error)
+	{
+		auto fail = [&](const char* message) -> std::shared_ptr<const bwxCatalog> {
+			if (error) *error = wxString::Format("%s: %s", filename, message);
+			return nullptr;
+		};
+
+		std::shared_ptr<bwxCatalog> catalog(new bwxCatalog());
+		catalog->m_file = std::make_unique<File>();
+		if (!catalog->m_file->Open(filename)) return fail("cannot open file");
+
+		const char* data = catalog->m_file->data;
+		const size_t size = catalog->m_file->size;
+		if (size < CATALOG_HEADER_SIZE || std::memcmp(data, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) != 0)
+			return fail("not a compiled catalog");
+
+		const uint64_t count = ReadUInt32(data + 8);
+		const uint64_t bucketCount = ReadUInt32(data + 12);
+		const uint64_t stringsSize = ReadUInt32(data + 20);
+		const uint64_t entriesOffset = CATALOG_HEADER_SIZE + bucketCount * 4;
+		const uint64_t stringsOffset = entriesOffset + count * sizeof(Entry);
+		if (stringsOffset + stringsSize > size || (count > 0 && bucketCount == 0))
+			return fail("truncated catalog");
+
+		// The file is produced little-endian; entries are read in place
+		static_assert(sizeof(Entry) == 16, "Unexpected catalog entry layout");
+		const uint16_t probe = 1;
+		if (*reinterpret_cast<const uint8_t*>(&probe) != 1) return fail("big-endian hosts are not supported");
+
+		catalog->m_count = static_cast<uint32_t>(count);
+		catalog->m_bucketCount = static_cast<uint32_t>(bucketCount);
+		catalog->m_seed = ReadUInt32(data + 16);
+		catalog->m_displacements = reinterpret_cast<const uint32_t*>(data + CATALOG_HEADER_SIZE);
+		catalog->m_entries = reinterpret_cast<const Entry*>(data + entriesOffset);
+		catalog->m_strings = data + stringsOffset;
+
+		// Validated once, so lookups need no bounds checks
+		for (uint32_t i = 0; i < catalog->m_count; ++i)
+		{
+			const Entry& entry = catalog->m_entries[i];
+			if (uint64_t(entry.keyOffset) + entry.keyLength > stringsSize || uint64_t(entry.valueOffset) + entry.valueLength > stringsSize)
+				return fail("corrupted catalog entry");
+		}
+
+		return catalog;
+	}
+
+	const bwxCatalog::Entry* bwxCatalog::FindEntry(std::string_view context, std::string_view msgid) const
+	{
+		if (m_count == 0) return nullptr;
+
+		uint64_t h = 0xcbf29ce484222325ULL ^ m_seed;
+		if (!context.empty())
+		{
+			h = CatalogHash(h, context);
+			h = CatalogHash(h, std::string_view("\x04", 1));
+		}
+		h = CatalogHash(h, msgid);
+
+		const uint32_t displacement = m_displacements[CatalogMix(h) % m_bucketCount];
+		const uint64_t h1 = CatalogMix(h ^ 0x9e3779b97f4a7c15ULL);
+		const uint64_t h2 = CatalogMix(h ^ 0xc2b2ae3d27d4eb4fULL);
+		const Entry& entry = m_entries[(h1 + (displacement / m_count) * h2 + displacement % m_count) % m_count];
+
+		// Any string maps to some slot - the key decides
+		const size_t keyLength = context.empty() ? msgid.size() : context.size() + 1 + msgid.size();
+		if (entry.keyLength != keyLength) return nullptr;
+
+		const char* key = m_strings + entry.keyOffset;
+		if (!context.empty())
+		{
+			if (std::memcmp(key, context.data(), context.size()) != 0 || key[context.size()] != '\x04') return nullptr;
+			key += context.size() + 1;
+		}
+		return std::memcmp(key, msgid.data(), msgid.size()) == 0 ? &entry : nullptr;
+	}
+
+	std::string_view bwxCatalog::Find(std::string_view msgid) const
+	{
+		return FindPlural(msgid, 0);
+	}
+
+	std::string_view bwxCatalog::Find(std::string_view context, std::string_view msgid) const
+	{
+		const Entry* entry = FindEntry(context, msgid);
+		if (!entry) return std::string_view();
+
+		std::string_view value(m_strings + entry->valueOffset, entry->valueLength);
+		return value.substr(0, value.find('\0'));
+	}
+
+	std::string_view bwxCatalog::FindPlural(std::string_view msgid, size_t form) const
+	{
+		const Entry* entry = FindEntry(std::string_view(), msgid);
+		if (!entry) return std::string_view();
+
+		std::string_view value(m_strings + entry->valueOffset, entry->valueLength);
+		for (; form > 0; --form)
+		{
+			const size_t end = value.find('\0');
+			if (end == std::string_view::npos) return std::string_view();
+			value.remove_prefix(end + 1);
+		}
+		return value.substr(0, value.find('\0'));
+	}
+
+}
@@ -0,0 +1,305 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_config_store.cpp
+// Purpose:     BWX_SDK Library; Typed config store with lazy load and background write-back
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_config_store.cpp
+ * @brief Implements the typed config store used for settings read in hot paths.
+ */
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <wx/stdpaths.h>
+
+#include <wx/fileconf.h>
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_globals.h>
+#include <bwx_sdk/bwx_core/bwx_config_store.h>
+
+namespace bwx_sdk {
+
+	bwxConfigStore& bwxConfigStore::GetInstance()
+	{
+		static bwxConfigStore instance;
+		return instance;
+	}
+
+	bwxConfigStore::bwxConfigStore(const wxString& filename)
+		: m_filename(filename)
+	{
+		// Same file as bwxSetFileConf(), so both APIs see the same settings
+		if (m_filename.IsEmpty()) m_filename = wxStandardPaths::Get().GetUserDataDir() + "\\config.conf";
+	}
+
+	bwxConfigStore::~bwxConfigStore()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_writeMutex);
+			m_running = false;
+		}
+		m_writeWake.notify_all();
+
+		if (m_writer.joinable()) m_writer.join();
+
+		Flush();
+	}
+
+	bwxConfigKey<wxString> bwxConfigStore::AddString(const wxString& path, const wxString& defaultValue)
+	{
+		return bwxConfigKey<wxString>(Add(path, CONFIG_ENTRY_TYPE_STRING, 0, defaultValue));
+	}
+
+	bwxConfigKey<int> bwxConfigStore::AddInt(const wxString& path, int defaultValue)
+	{
+		return bwxConfigKey<int>(Add(path, CONFIG_ENTRY_TYPE_INT, static_cast<uint64_t>(static_cast<int64_t>(defaultValue)), _ES_));
+	}
+
+	bwxConfigKey<float> bwxConfigStore::AddFloat(const wxString& path, float defaultValue)
+	{
+		return bwxConfigKey<float>(Add(path, CONFIG_ENTRY_TYPE_FLOAT, std::bit_cast<uint64_t>(static_cast<double>(defaultValue)), _ES_));
+	}
+
+	bwxConfigKey<double> bwxConfigStore::AddDouble(const wxString& path, double defaultValue)
+	{
+		return bwxConfigKey<double>(Add(path, CONFIG_ENTRY_TYPE_DOUBLE, std::bit_cast<uint64_t>(defaultValue), _ES_));
+	}
+
+	bwxConfigKey<bool> bwxConfigStore::AddBool(const wxString& path, bool defaultValue)
+	{
+		return bwxConfigKey<bool>(Add(path, CONFIG_ENTRY_TYPE_BOOLEAN, defaultValue ? 1 : 0, _ES_));
+	}
+
+	uint32_t bwxConfigStore::Add(const wxString& path, bwxConfigEntryType type, uint64_t defaultBits, const wxString& defaultString)
+	{
+		// The writer thread walks m_slots under the same lock
+		std::lock_guard<std::mutex> lock(m_fileMutex);
+
+		auto it = m_ids.find(path);
+		if (it != m_ids.end())
+		{
+			return m_slots[it->second].type == type ? it->second : UINT32_MAX;
+		}
+
+		Slot& slot = m_slots.emplace_back();
+		slot.type = type;
+		slot.path = path;
+		slot.defaultBits = defaultBits;
+		slot.defaultString = defaultString;
+		slot.bits.store(defaultBits, std::memory_order_relaxed);
+		slot.string = defaultString;
+
+		const uint32_t id = static_cast<uint32_t>(m_slots.size() - 1);
+		m_ids[path] = id;
+		return id;
+	}
+
+	wxString bwxConfigStore::Get(bwxConfigKey<wxString> key)
+	{
+		wxCHECK_MSG(key.m_id < m_slots.size(), _ES_, "Invalid bwxConfigStore key");
+		Slot& slot = m_slots[key.m_id];
+		if (!slot.loaded.load(std::memory_order_acquire)) LoadSlot(slot);
+
+		std::lock_guard<std::mutex> lock(m_stringMutex);
+		return slot.string;
+	}
+
+	void bwxConfigStore::Set(bwxConfigKey<wxString> key, const wxString& value)
+	{
+		wxCHECK_RET(key.m_id < m_slots.size(), "Invalid bwxConfigStore key");
+		Slot& slot = m_slots[key.m_id];
+		if (!slot.loaded.load(std::memory_order_acquire))
+		{
+			// Set before the first read - the value in the file is not needed any more
+			std::lock_guard<std::mutex> fileLock(m_fileMutex);
+			std::lock_guard<std::mutex> lock(m_stringMutex);
+			slot.string = value;
+			slot.loaded.store(true, std::memory_order_release);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(m_stringMutex);
+			if (slot.string == value) return;
+			slot.string = value;
+		}
+
+		MarkDirty(slot);
+	}
+
+	void bwxConfigStore::Store(uint32_t id, uint64_t bits)
+	{
+		wxCHECK_RET(id < m_slots.size(), "Invalid bwxConfigStore key");
+		Slot& slot = m_slots[id];
+		if (!slot.loaded.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(m_fileMutex);
+			slot.bits.store(bits, std::memory_order_relaxed);
+			slot.loaded.store(true, std::memory_order_release);
+		}
+		else if (slot.bits.exchange(bits, std::memory_order_relaxed) == bits)
+		{
+			return;
+		}
+
+		MarkDirty(slot);
+	}
+
+	void bwxConfigStore::LoadSlot(Slot& slot)
+	{
+		std::lock_guard<std::mutex> lock(m_fileMutex);
+		if (slot.loaded.load(std::memory_order_relaxed)) return;
+
+		OpenConfig();
+
+		switch (slot.type)
+		{
+		case CONFIG_ENTRY_TYPE_STRING:
+		{
+			wxString value = m_config->Read(slot.path, slot.defaultString);
+			std::lock_guard<std::mutex> stringLock(m_stringMutex);
+			slot.string = value;
+			break;
+		}
+
+		case CONFIG_ENTRY_TYPE_INT:
+		{
+			const long value = m_config->ReadLong(slot.path, static_cast<long>(static_cast<int64_t>(slot.defaultBits)));
+			slot.bits.store(static_cast<uint64_t>(static_cast<int64_t>(static_cast<int>(value))), std::memory_order_relaxed);
+			break;
+		}
+
+		case CONFIG_ENTRY_TYPE_FLOAT:
+		case CONFIG_ENTRY_TYPE_DOUBLE:
+			slot.bits.store(std::bit_cast<uint64_t>(m_config->ReadDouble(slot.path, std::bit_cast<double>(slot.defaultBits))), std::memory_order_relaxed);
+			break;
+
+		case CONFIG_ENTRY_TYPE_BOOLEAN:
+			slot.bits.store(m_config->ReadBool(slot.path, slot.defaultBits != 0) ? 1 : 0, std::memory_order_relaxed);
+			break;
+		}
+
+		slot.loaded.store(true, std::memory_order_release);
+	}
+
+	void bwxConfigStore::MarkDirty(Slot& slot)
+	{
+		slot.dirty.store(true, std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> lock(m_writeMutex);
+			const auto now = std::chrono::steady_clock::now();
+			if (!m_writePending)
+			{
+				m_writePending = true;
+				m_firstChange = now;
+			}
+			m_lastChange = now;
+
+			if (m_running && !m_writer.joinable()) m_writer = std::thread(&bwxConfigStore::WriterLoop, this);
+		}
+		m_writeWake.notify_one();
+	}
+
+	void bwxConfigStore::SetWriteDelay(std::chrono::milliseconds delay, std::chrono::milliseconds maxDelay)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_writeMutex);
+			m_delay = delay;
+			m_maxDelay = std::max(delay, maxDelay);
+		}
+		m_writeWake.notify_one();
+	}
+
+	bool bwxConfigStore::Flush()
+	{
+		std::lock_guard<std::mutex> lock(m_fileMutex);
+
+		bool written = false;
+		for (Slot& slot : m_slots)
+		{
+			// Cleared before the value is read - a concurrent Set() marks the entry again
+			if (!slot.dirty.exchange(false, std::memory_order_acq_rel)) continue;
+
+			// Fresh copy of the file for the first dirty entry, so a stale snapshot never
+			// overwrites what bwxConfigUtils::SaveConfig() wrote since
+			if (!written)
+			{
+				m_config.reset();
+				OpenConfig();
+			}
+
+			switch (slot.type)
+			{
+			case CONFIG_ENTRY_TYPE_STRING:
+			{
+				wxString value;
+				{
+					std::lock_guard<std::mutex> stringLock(m_stringMutex);
+					value = slot.string;
+				}
+				m_config->Write(slot.path, value);
+				break;
+			}
+
+			case CONFIG_ENTRY_TYPE_INT:
+				m_config->Write(slot.path, static_cast<long>(static_cast<int64_t>(slot.bits.load(std::memory_order_relaxed))));
+				break;
+
+			case CONFIG_ENTRY_TYPE_FLOAT:
+			case CONFIG_ENTRY_TYPE_DOUBLE:
+				m_config->Write(slot.path, std::bit_cast<double>(slot.bits.load(std::memory_order_relaxed)));
+				break;
+
+			case CONFIG_ENTRY_TYPE_BOOLEAN:
+				m_config->Write(slot.path, slot.bits.load(std::memory_order_relaxed) != 0);
+				break;
+			}
+			written = true;
+		}
+
+		// wxFileConfig writes a temporary file and renames it over the old one
+		return !written || m_config->Flush();
+	}
+
+	void bwxConfigStore::OpenConfig()
+	{
+		if (m_config) return;
+		m_config = std::make_unique<wxFileConfig>(_ES_, _ES_, m_filename, _ES_, wxCONFIG_USE_LOCAL_FILE | wxCONFIG_USE_GLOBAL_FILE);
+	}
+
+	void bwxConfigStore::WriterLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+		while (true)
+		{
+			m_writeWake.wait(lock, [this]() { return !m_running || m_writePending; });
+
+			// Debounce: wait for a quiet period, but not longer than the maximum delay
+			while (m_running)
+			{
+				const auto due = std::min(m_lastChange + m_delay, m_firstChange + m_maxDelay);
+				if (std::chrono::steady_clock::now() >= due) break;
+				m_writeWake.wait_until(lock, due);
+			}
+
+			// The destructor writes the rest
+			if (!m_running) break;
+
+			m_writePending = false;
+			lock.unlock();
+			Flush();
+			lock.lock();
+		}
+	}
+
+}
@@ -20,15 +20,19 @@
 
 #include <bwx_sdk/bwx_globals.h>
 #include <bwx_sdk/bwx_core/bwx_config_utils.h>
+#include <bwx_sdk/bwx_core/bwx_log.h>
+#include <bwx_sdk/bwx_core/bwx_startup_trace.h>
 
 namespace bwx_sdk {
 
 	bwxPropertyMap<wxString, bwxConfigEntry> bwxConfigUtils::m_configEntries;
+	bool bwxConfigUtils::m_logOnLoad = false;
 
 	void bwxConfigUtils::LoadConfig()
 	{
 		//bwxConfigUtils::ClearConfigEntryMap();
 
+		BWX_STARTUP_PHASE("config.load");
 		bwxSetFileConf();
 
 		wxLogMessage("Load app cofiguration to memory...");
@@ -66,7 +70,7 @@ namespace bwx_sdk {
 			}
 		}
 
-		bwxConfigUtils::ShowInLog();
+		if (m_logOnLoad) bwxConfigUtils::ShowInLog();
 	}
 
 	void bwxConfigUtils::SaveConfig()
@@ -109,39 +113,39 @@ namespace bwx_sdk {
 
 	void bwxConfigUtils::Set(const wxString& key, wxAny val)
 	{
-		wxLogInfo("Value: %s", val.As<wxString>().c_str());
+		BWX_LOG_INFO("Value: %s", val.As<wxString>());
 		bwxConfigUtils::m_configEntries[key].SetValue(val);
-		wxLogDebug("Saved value: %s", bwxConfigUtils::m_configEntries[key].GetValue().As<wxString>());
+		BWX_LOG_DEBUG("Saved value: %s", bwxConfigUtils::m_configEntries[key].GetValue().As<wxString>());
 	}
 
 	void bwxConfigUtils::Get(const wxString& key, wxString* val)
 	{
-		wxLogDebug("Get config entry: %s", key.c_str());
+		BWX_LOG_DEBUG("Get config entry: %s", key);
 		*val = bwxConfigUtils::m_configEntries[key].GetValue().As<wxString>();
 	}
 
 	void bwxConfigUtils::Get(const wxString& key, int* val)
 	{
-		wxLogDebug("Get config entry: %s", key.c_str());
+		BWX_LOG_DEBUG("Get config entry: %s", key);
 		*val = bwxConfigUtils::m_configEntries[key].GetValue().As<int>();
 	}
 
 	void bwxConfigUtils::Get(const wxString& key, float* val)
 	{
-		wxLogDebug("Get config entry: %s", key.c_str());
+		BWX_LOG_DEBUG("Get config entry: %s", key);
 		*val = bwxConfigUtils::m_configEntries[key].GetValue().As<float>();
 	}
 
 	void bwxConfigUtils::Get(const wxString& key, bool* val)
 	{
-		wxLogDebug("Get config entry: %s", key.c_str());
+		BWX_LOG_DEBUG("Get config entry: %s", key);
 		*val = bwxConfigUtils::m_configEntries[key].GetValue().As<bool>();
 	}
 
 	bool bwxConfigUtils::Get(const wxString& key, wxColour* val)
 	{
 		bool ret = false;
-		wxLogDebug("Get config entry: %s", key.c_str());
+		BWX_LOG_DEBUG("Get config entry: %s", key);
 		ret = wxFromString(bwxConfigUtils::m_configEntries[key].GetValue().As<wxString>(), val);
 		if (!ret) *val = wxColour(128, 128, 128);
 		return ret;
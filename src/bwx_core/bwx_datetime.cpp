@@ -15,6 +15,9 @@
 #include <bwx_sdk/bwx_core/bwx_datetime.h>
 #include <bwx_sdk/bwx_core/bwx_math.h>
 
+#include <cstring>
+#include <memory>
+
 namespace bwx_sdk {
     namespace dt {
 
@@ -387,200 +390,322 @@ namespace bwx_sdk {
             return bwxHourStr(span.GetHours()) + wxT(", ") + bwxMinuteStr(span.GetMinutes()) + _(" and ") + bwxSecondStr((int)span.GetSeconds().ToLong());
         }
 
-        wxString bwxFormatDateTime(const wxDateTime& dt, const wxString& format)
-        {
-            int Y = dt.GetYear();
-            int M = bwxDT2IntMonth(dt.GetMonth());
-            int D = dt.GetDay();
-            int h = dt.GetHour();
-            int m = dt.GetMinute();
-            int s = dt.GetSecond();
+        namespace {
+
+            struct BufferSink
+            {
+                char* data;
+                size_t size;
+                size_t length = 0;
+
+                inline void Append(const char* text, size_t count)
+                {
+                    if (length < size) std::memcpy(data + length, text, std::min(count, size - length));
+                    length += count;
+                }
+            };
+
+            struct StringSink
+            {
+                std::string& out;
 
-            int tmp;
+                inline void Append(const char* text, size_t count) { out.append(text, count); }
+            };
 
-            wxString res = _ES_;
-            wxString tmp_str = _ES_;
-            wxChar c;
+            template <typename Sink>
+            inline void AppendChar(Sink& sink, char c)
+            {
+                sink.Append(&c, 1);
+            }
 
-            wxString format_tmp = format;
-            format_tmp += ("_____"); // Protection against reading beyond memory when i+n is out of string range
-            for (size_t i = 0; i < format_tmp.Len(); i++)
+            template <typename Sink>
+            void AppendNumber(Sink& sink, int value, int minDigits)
             {
-                c = format_tmp.GetChar(i);
-                if (c == '$')
+                char digits[16];
+                char* end = digits + sizeof(digits);
+                char* p = end;
+
+                unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+                do
                 {
-                    switch ((char)format_tmp.GetChar((size_t)(i + 1)))
-                    {
-                    case 'Y': // YEAR
-                        if (format_tmp.GetChar((size_t)(i + 2)) == 'Y' && format_tmp.GetChar((size_t)(i + 3)) == 'Y' && format_tmp.GetChar((size_t)(i + 4)) == 'Y') // YYYY
-                        {
-                            res += (_SF(_("A.D. %d"), Y));
-                            i += 4;
-                        }
-                        else if (format_tmp.GetChar((size_t)(i + 2)) == 'Y' && format_tmp.GetChar((size_t)(i + 3)) == 'Y') // YYY
-                        {
-                            res += (_SF(_("%d y."), Y));
-                            i += 3;
-                        }
-                        else if (format_tmp.GetChar((size_t)(i + 2)) == 'Y') // YY
-                        {
-                            res += (_SF(wxT("%d"), Y));
-                            i += 2;
-                        }
-                        else // Y
-                        {
-                            res += (_SF(wxT("%d"), (Y % 1000)));
-                            i += 1;
-                        }
-                        break;
+                    *--p = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                } while (magnitude != 0);
+                while (end - p < minDigits) *--p = '0';
+                if (value < 0) *--p = '-';
 
-                    case 'M': // MONTH
-                        if (format_tmp.GetChar((size_t)(i + 2)) == 'M' && format_tmp.GetChar((size_t)(i + 3)) == 'M' && format_tmp.GetChar((size_t)(i + 4)) == 'M') // MMMM
-                        {
-                            tmp_str = bwxGetMonthName(M);
-                            tmp_str.LowerCase();
-                            res += tmp_str;
-                            i += 4;
-                        }
-                        else if (format_tmp.GetChar((size_t)(i + 2)) == 'M' && format_tmp.GetChar((size_t)(i + 3)) == 'M') // MMM
-                        {
-                            tmp_str = bwxGetMonthName(M, false, BWX_ACCUSATIVE);
-                            tmp_str.LowerCase();
-                            res += tmp_str;
-                            i += 3;
-                        }
-                        else if (format_tmp.GetChar((size_t)(i + 2)) == 'M') // MM
-                        {
-                            res += bwxGetMonthName(M, true);
-                            i += 2;
-                        }
-                        else // M
-                        {
-                            if (M < 10) res += wxT("0");
-                            res += (_SF(wxT("%d"), M));
-                            i += 1;
-                        }
-                        break;
+                sink.Append(p, static_cast<size_t>(end - p));
+            }
 
-                    case 'D': // DAY
-                        if (format_tmp.GetChar((size_t)(i + 2)) == 'D') // DD
-                        {
-                            tmp = dt.GetDayOfYear();
-                            if (tmp < 10) res += wxT("00");
-                            else if (tmp < 100) res += wxT("0");
-                            res += (_SF(wxT("%d"), tmp));
-                            i += 2;
-                        }
-                        else // D
-                        {
-                            if (D < 10) res += wxT("0");
-                            res += (_SF(wxT("%d"), D));
-                            i += 1;
-                        }
-                        break;
-
-                    case 'W':
-                        tmp = dt.GetWeekOfYear();
-                        if (tmp < 10) res += wxT("0");
-                        res += _SF(wxT("%d"), tmp);
-                        i += 1;
-                        break;
-
-                    case 'w':
-                        tmp = dt.GetWeekOfMonth();
-                        if (tmp < 10) res += wxT("0");
-                        res += _SF(wxT("%d"), tmp);
-                        i += 1;
-                        break;
-
-                    case 'd':
-                        if (format_tmp.GetChar((size_t)(i + 2)) == 'd') // dd
-                        {
-                            tmp = bwxGetWeekDay(dt);
-                            tmp_str = bwxGetWeekDayName(tmp);
-                            tmp_str.LowerCase();
-                            res += tmp_str;
-                            i += 2;
-                        }
-                        else // d
-                        {
-                            tmp = bwxGetWeekDay(dt);
-                            tmp_str = bwxGetWeekDayName(tmp, true);
-                            res += tmp_str;
-                            i += 1;
-                        }
-                        break;
+            template <typename Sink>
+            void AppendText(Sink& sink, const wxString& text)
+            {
+                const wxScopedCharBuffer utf8 = text.utf8_str();
+                sink.Append(utf8.data(), utf8.length());
+            }
 
-                    case 'h':
-                        if (format_tmp.GetChar((size_t)(i + 2)) == 'h' && format_tmp.GetChar((size_t)(i + 3)) == 'h') // hhh
-                        {
-                            if (h > 12) tmp = h - 12;
-                            else tmp = h;
-                            if (tmp < 10) res += wxT("0");
-                            res += (_SF(wxT("%d"), tmp) + ((h > 12) ? (wxT(" PM")) : (wxT(" AM"))));
-                            i += 3;
-                        }
-                        else if (format_tmp.GetChar((size_t)(i + 2)) == 'h') // hh
-                        {
-                            if (h > 12) tmp = h - 12;
-                            else tmp = h;
-                            if (tmp < 10) res += wxT("0");
-                            res += _SF(wxT("%d"), tmp);
-                            i += 2;
-                        }
-                        else // h
-                        {
-                            if (h < 10) res += wxT("0");
-                            res += _SF(wxT("%d"), h);
-                            i += 1;
-                        }
-                        break;
+            int DayOfYear(int d, int m, int y)
+            {
+                static const int days[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+                return days[m - 1] + d + ((m > 2 && wxDateTime::IsLeapYear(y)) ? 1 : 0);
+            }
 
-                    case 'm':
-                        if (m < 10) res += wxT("0");
-                        res += _SF(wxT("%d"), m);
-                        i += 1;
-                        break;
+        }
 
-                    case 's':
-                        if (format_tmp.GetChar((size_t)(i + 2)) == 's') // ss
-                        {
-                            tmp = dt.GetMillisecond();
-                            if (tmp < 10) res += wxT("00");
-                            else if (tmp < 100) res += wxT("0");
-                            res += _SF(wxT("%d"), tmp);
-                            i += 2;
-                        }
-                        else // s
-                        {
-                            if (s < 10) res += wxT("0");
-                            res += _SF(wxT("%d"), s);
-                            i += 1;
-                        }
-                        break;
+        bwxDateTimeFormat::bwxDateTimeFormat(const wxString& format)
+            : m_format(format)
+        {
+            const size_t length = format.Len();
+            auto count = [&](size_t i, wxChar c, size_t max) {
+                size_t n = 0;
+                while (n < max && i + n < length && format.GetChar(i + n) == c) n++;
+                return n;
+            };
 
-                    case 'Z':
-                    case 'z':
-                        res += bwxZodiacName(dt);
-                        i += 1;
-                        break;
+            wxString text = _ES_;
+            auto addField = [&](Field field) {
+                if (!text.IsEmpty())
+                {
+                    const wxScopedCharBuffer utf8 = text.utf8_str();
+                    m_tokens.push_back({ FIELD_TEXT, static_cast<uint32_t>(m_text.size()), static_cast<uint32_t>(utf8.length()) });
+                    m_text.append(utf8.data(), utf8.length());
+                    text.Clear();
+                }
+                if (field != FIELD_TEXT) m_tokens.push_back({ field, 0, 0 });
+            };
 
-                    default:
-                        break;
-                    }
+            static const Field years[] = { FIELD_YEAR_SHORT, FIELD_YEAR, FIELD_YEAR_SUFFIX, FIELD_YEAR_AD };
+            static const Field months[] = { FIELD_MONTH, FIELD_MONTH_SHORT, FIELD_MONTH_GENITIVE, FIELD_MONTH_NAME };
+            static const Field days[] = { FIELD_DAY, FIELD_DAY_OF_YEAR };
+            static const Field weekDays[] = { FIELD_WEEK_DAY_SHORT, FIELD_WEEK_DAY_NAME };
+            static const Field hours[] = { FIELD_HOUR, FIELD_HOUR_12, FIELD_HOUR_12_AM_PM };
+            static const Field seconds[] = { FIELD_SECOND, FIELD_MILLISECOND };
+
+            for (size_t i = 0; i < length; i++)
+            {
+                const wxChar c = format.GetChar(i);
+                if (c != '$')
+                {
+                    text += c;
+                    continue;
                 }
-                else
+
+                // An unknown or missing field letter drops the '$', as bwxFormatDateTime() always did
+                if (i + 1 >= length) break;
+
+                size_t n = 1;
+                switch ((char)format.GetChar(i + 1))
                 {
-                    res += format_tmp.GetChar(i);
+                case 'Y': n = count(i + 1, 'Y', 4); addField(years[n - 1]); break;
+                case 'M': n = count(i + 1, 'M', 4); addField(months[n - 1]); break;
+                case 'D': n = count(i + 1, 'D', 2); addField(days[n - 1]); break;
+                case 'W': addField(FIELD_WEEK_OF_YEAR); break;
+                case 'w': addField(FIELD_WEEK_OF_MONTH); break;
+                case 'd': n = count(i + 1, 'd', 2); addField(weekDays[n - 1]); break;
+                case 'h': n = count(i + 1, 'h', 3); addField(hours[n - 1]); break;
+                case 'm': addField(FIELD_MINUTE); break;
+                case 's': n = count(i + 1, 's', 2); addField(seconds[n - 1]); break;
+                case 'Z':
+                case 'z': addField(FIELD_ZODIAC); break;
+                default: n = 0; break;
                 }
+                i += n;
             }
+            addField(FIELD_TEXT);
+        }
+
+        template <typename Sink>
+        void bwxDateTimeFormat::Write(const wxDateTime& dt, Sink& sink) const
+        {
+            // One broken-down time for all fields (each wxDateTime getter computes it again)
+            const wxDateTime::Tm tm = dt.GetTm();
+            const int Y = tm.year;
+            const int M = bwxDT2IntMonth(tm.mon);
+            const int D = tm.mday;
+            const int h = tm.hour;
+
+            wxString tmp_str;
+            for (const Token& token : m_tokens)
+            {
+                switch (token.field)
+                {
+                case FIELD_TEXT: sink.Append(m_text.data() + token.offset, token.length); break;
+                case FIELD_YEAR_AD: AppendText(sink, _SF(_("A.D. %d"), Y)); break;
+                case FIELD_YEAR_SUFFIX: AppendText(sink, _SF(_("%d y."), Y)); break;
+                case FIELD_YEAR: AppendNumber(sink, Y, 1); break;
+                case FIELD_YEAR_SHORT: AppendNumber(sink, Y % 1000, 1); break;
+
+                case FIELD_MONTH_NAME:
+                    tmp_str = bwxGetMonthName(M);
+                    AppendText(sink, tmp_str.LowerCase());
+                    break;
+
+                case FIELD_MONTH_GENITIVE:
+                    tmp_str = bwxGetMonthName(M, false, BWX_ACCUSATIVE);
+                    AppendText(sink, tmp_str.LowerCase());
+                    break;
+
+                case FIELD_MONTH_SHORT: AppendText(sink, bwxGetMonthName(M, true)); break;
+                case FIELD_MONTH: AppendNumber(sink, M, 2); break;
+                case FIELD_DAY_OF_YEAR: AppendNumber(sink, DayOfYear(D, M, Y), 3); break;
+                case FIELD_DAY: AppendNumber(sink, D, 2); break;
+                case FIELD_WEEK_OF_YEAR: AppendNumber(sink, dt.GetWeekOfYear(), 2); break;
+                case FIELD_WEEK_OF_MONTH: AppendNumber(sink, dt.GetWeekOfMonth(), 2); break;
+
+                case FIELD_WEEK_DAY_NAME:
+                    tmp_str = bwxGetWeekDayName(bwxGetWeekDay(D, M, Y, 1));
+                    AppendText(sink, tmp_str.LowerCase());
+                    break;
+
+                case FIELD_WEEK_DAY_SHORT: AppendText(sink, bwxGetWeekDayName(bwxGetWeekDay(D, M, Y, 1), true)); break;
+
+                case FIELD_HOUR_12_AM_PM:
+                    AppendNumber(sink, (h > 12) ? h - 12 : h, 2);
+                    sink.Append((h > 12) ? " PM" : " AM", 3);
+                    break;
+
+                case FIELD_HOUR_12: AppendNumber(sink, (h > 12) ? h - 12 : h, 2); break;
+                case FIELD_HOUR: AppendNumber(sink, h, 2); break;
+                case FIELD_MINUTE: AppendNumber(sink, tm.min, 2); break;
+                case FIELD_MILLISECOND: AppendNumber(sink, tm.msec, 3); break;
+                case FIELD_SECOND: AppendNumber(sink, tm.sec, 2); break;
+                case FIELD_ZODIAC: AppendText(sink, bwxZodiacName(dt)); break;
+                }
+            }
+        }
+
+        size_t bwxDateTimeFormat::FormatTo(const wxDateTime& dt, char* buffer, size_t size) const
+        {
+            BufferSink sink{ buffer, size };
+            Write(dt, sink);
+            return sink.length;
+        }
+
+        void bwxDateTimeFormat::FormatTo(const wxDateTime& dt, std::string& out) const
+        {
+            StringSink sink{ out };
+            Write(dt, sink);
+        }
+
+        wxString bwxDateTimeFormat::Format(const wxDateTime& dt) const
+        {
+            char buffer[128];
+            const size_t length = FormatTo(dt, buffer, sizeof(buffer));
+            if (length <= sizeof(buffer)) return wxString::FromUTF8(buffer, length);
+
+            std::string text;
+            text.reserve(length);
+            FormatTo(dt, text);
+            return wxString::FromUTF8(text.data(), text.size());
+        }
 
-            return res.SubString(0, (res.Len() - 1) - 5);
+        wxString bwxFormatDateTime(const wxDateTime& dt, const wxString& format)
+        {
+            // Callers mostly repeat one format - keep it parsed
+            thread_local std::unique_ptr<bwxDateTimeFormat> parsed;
+            if (!parsed || parsed->GetFormat() != format) parsed = std::make_unique<bwxDateTimeFormat>(format);
+            return parsed->Format(dt);
+        }
+
+        size_t bwxFormatISO8601(const wxDateTime& date, char* buffer, bool milliseconds)
+        {
+            if (!date.IsValid()) return 0;
+
+            const wxDateTime::Tm tm = date.GetTm();
+            BufferSink sink{ buffer, BWX_ISO8601_MAX_LENGTH };
+            AppendNumber(sink, tm.year, 4);
+            AppendChar(sink, '-');
+            AppendNumber(sink, bwxDT2IntMonth(tm.mon), 2);
+            AppendChar(sink, '-');
+            AppendNumber(sink, tm.mday, 2);
+            AppendChar(sink, 'T');
+            AppendNumber(sink, tm.hour, 2);
+            AppendChar(sink, ':');
+            AppendNumber(sink, tm.min, 2);
+            AppendChar(sink, ':');
+            AppendNumber(sink, tm.sec, 2);
+            if (milliseconds)
+            {
+                AppendChar(sink, '.');
+                AppendNumber(sink, tm.msec, 3);
+            }
+            return sink.length;
         }
 
         std::string bwxToISO8601(wxDateTime date)
         {
-            return std::string(date.FormatISOCombined().utf8_str());
+            char buffer[BWX_ISO8601_MAX_LENGTH];
+            return std::string(buffer, bwxFormatISO8601(date, buffer));
+        }
+
+        bool bwxParseISO8601(std::string_view text, wxDateTime& date)
+        {
+            size_t pos = 0;
+            auto isDigit = [&]() { return pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; };
+            auto number = [&](size_t digits, int& value) {
+                value = 0;
+                for (size_t i = 0; i < digits; i++, pos++)
+                {
+                    if (!isDigit()) return false;
+                    value = value * 10 + (text[pos] - '0');
+                }
+                return true;
+            };
+            auto expect = [&](char c) {
+                if (pos >= text.size() || text[pos] != c) return false;
+                pos++;
+                return true;
+            };
+
+            int y = 0, mo = 0, d = 0, h = 0, mi = 0, s = 0, ms = 0;
+            if (!number(4, y) || !expect('-') || !number(2, mo) || !expect('-') || !number(2, d)) return false;
+            if (mo < 1 || mo > 12 || d < 1 || d > wxDateTime::GetNumberOfDays(bwxInt2DTMonth(mo), y)) return false;
+
+            if (expect('T') || expect(' '))
+            {
+                if (!number(2, h) || !expect(':') || !number(2, mi)) return false;
+                if (expect(':'))
+                {
+                    if (!number(2, s)) return false;
+                    if (expect('.') || expect(','))
+                    {
+                        // Fraction rounded down to milliseconds
+                        int digits = 0;
+                        for (; isDigit(); pos++, digits++)
+                        {
+                            if (digits < 3) ms = ms * 10 + (text[pos] - '0');
+                        }
+                        if (digits == 0) return false;
+                        for (; digits < 3; digits++) ms *= 10;
+                    }
+                }
+                if (h > 23 || mi > 59 || s > 59) return false;
+            }
+
+            bool zone = false;
+            long offset = 0;
+            if (expect('Z'))
+            {
+                zone = true;
+            }
+            else if (pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
+            {
+                const bool negative = text[pos++] == '-';
+                int oh = 0, om = 0;
+                if (!number(2, oh)) return false;
+                if ((expect(':') || pos < text.size()) && !number(2, om)) return false;
+                if (oh > 23 || om > 59) return false;
+
+                zone = true;
+                offset = (negative ? -1 : 1) * (oh * 3600L + om * 60L);
+            }
+
+            if (pos != text.size()) return false;
+
+            date.Set((wxDateTime::wxDateTime_t)d, bwxInt2DTMonth(mo), y, (wxDateTime::wxDateTime_t)h, (wxDateTime::wxDateTime_t)mi,
+                (wxDateTime::wxDateTime_t)s, (wxDateTime::wxDateTime_t)ms);
+            if (zone) date.MakeFromTimezone(wxDateTime::TimeZone::Make(offset));
+            return date.IsValid();
         }
 
         int bwxCalculateAge(wxDateTime birthDate, wxDateTime currentDate)
@@ -7,10 +7,37 @@
 namespace bwx {
 namespace core {
 
-std::string BwxException::formatMessage(const std::string& message, const char* file, int line) {
-    std::ostringstream oss;
-    oss << message << " (at " << file << ":" << line << ")";
-    return oss.str();
+const char* getCategoryName(ExceptionCategory category) noexcept {
+    switch (category) {
+        case ExceptionCategory::Layout:   return "Layout";
+        case ExceptionCategory::Widget:   return "Widget";
+        case ExceptionCategory::Window:   return "Window";
+        case ExceptionCategory::Resource: return "Resource";
+        case ExceptionCategory::Generic:
+        default:                          return "Application";
+    }
+}
+
+const char* BwxException::what() const noexcept {
+    if (!m_what.empty()) {
+        return m_what.c_str();
+    }
+
+    try {
+        std::ostringstream oss;
+        if (getCategory() != ExceptionCategory::Generic) {
+            oss << getCategoryName(getCategory()) << " Error: ";
+        }
+        oss << getMessage();
+        if (m_file) {
+            oss << " (at " << m_file << ":" << m_line << ")";
+        }
+        m_what = oss.str();
+    } catch (...) {
+        return getMessage();  // Out of memory - plain message
+    }
+
+    return m_what.c_str();
 }
 
 } // namespace core
@@ -9,22 +9,31 @@
 namespace bwx {
 namespace core {
 
+namespace {
+
+/// @brief Get exception as bwx exception (nullptr for other exceptions)
+const BwxException* asBwxException(const std::exception& e) {
+    return dynamic_cast<const BwxException*>(&e);
+}
+
+} // namespace
+
 std::string ExceptionHandler::formatException(const std::exception& e) {
     std::ostringstream oss;
 
-    // Try to identify bwx exception types
-    if (dynamic_cast<const LayoutException*>(&e)) {
-        oss << "[LAYOUT] ";
-    } else if (dynamic_cast<const WidgetException*>(&e)) {
-        oss << "[WIDGET] ";
-    } else if (dynamic_cast<const WindowException*>(&e)) {
-        oss << "[WINDOW] ";
-    } else if (dynamic_cast<const ResourceException*>(&e)) {
-        oss << "[RESOURCE] ";
-    } else if (dynamic_cast<const BwxException*>(&e)) {
-        oss << "[BWX] ";
-    } else {
+    // Tag by bwx exception category
+    const BwxException* bwx = asBwxException(e);
+    if (!bwx) {
         oss << "[C++] ";
+    } else {
+        switch (bwx->getCategory()) {
+            case ExceptionCategory::Layout:   oss << "[LAYOUT] "; break;
+            case ExceptionCategory::Widget:   oss << "[WIDGET] "; break;
+            case ExceptionCategory::Window:   oss << "[WINDOW] "; break;
+            case ExceptionCategory::Resource: oss << "[RESOURCE] "; break;
+            case ExceptionCategory::Generic:
+            default:                          oss << "[BWX] "; break;
+        }
     }
 
     oss << e.what();
@@ -32,29 +41,9 @@ std::string ExceptionHandler::formatException(const std::exception& e) {
 }
 
 ExceptionSeverity ExceptionHandler::getSeverity(const std::exception& e) {
-    // Layout exceptions are usually non-critical (can continue)
-    if (dynamic_cast<const LayoutException*>(&e)) {
-        return ExceptionSeverity::Warning;
-    }
-
-    // Widget exceptions might be non-critical
-    if (dynamic_cast<const WidgetException*>(&e)) {
-        return ExceptionSeverity::Warning;
-    }
-
-    // Window exceptions are more serious
-    if (dynamic_cast<const WindowException*>(&e)) {
-        return ExceptionSeverity::Error;
-    }
-
-    // Resource exceptions can be handled
-    if (dynamic_cast<const ResourceException*>(&e)) {
-        return ExceptionSeverity::Warning;
-    }
-
-    // Other bwx exceptions
-    if (dynamic_cast<const BwxException*>(&e)) {
-        return ExceptionSeverity::Error;
+    // bwx exceptions know their severity (layout/widget/resource: warning, window/other: error)
+    if (const BwxException* bwx = asBwxException(e)) {
+        return bwx->getSeverity();
     }
 
     // Unknown C++ exceptions are critical
@@ -93,20 +82,8 @@ void ExceptionHandler::logException(const std::exception& e, ExceptionLogCallbac
 }
 
 std::string ExceptionHandler::getErrorTitle(const std::exception& e) {
-    if (dynamic_cast<const LayoutException*>(&e)) {
-        return "Layout Error";
-    }
-    if (dynamic_cast<const WidgetException*>(&e)) {
-        return "Widget Error";
-    }
-    if (dynamic_cast<const WindowException*>(&e)) {
-        return "Window Error";
-    }
-    if (dynamic_cast<const ResourceException*>(&e)) {
-        return "Resource Error";
-    }
-    if (dynamic_cast<const BwxException*>(&e)) {
-        return "Application Error";
+    if (const BwxException* bwx = asBwxException(e)) {
+        return std::string(getCategoryName(bwx->getCategory())) + " Error";
     }
     return "Unexpected Error";
 }
@@ -114,6 +91,11 @@ std::string ExceptionHandler::getErrorTitle(const std::exception& e) {
 std::string ExceptionHandler::getTechnicalDetails(const std::exception& e) {
     std::ostringstream oss;
     oss << "Exception Type: " << typeid(e).name() << "\n";
+    if (const BwxException* bwx = asBwxException(e)) {
+        if (bwx->getFile()) {
+            oss << "Location: " << bwx->getFile() << ":" << bwx->getLine() << "\n";
+        }
+    }
     oss << "Message: " << e.what();
     return oss.str();
 }
@@ -0,0 +1,214 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_file_watcher.cpp
+// Purpose:     BWX_SDK Library; Event-driven file change notifications
+// Author:      Bartosz Warzocha
+// Created:     2026-10-14
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_file_watcher.cpp
+ * @brief Implements the file watcher that feeds hot reload of resources.
+ */
+
+#include <algorithm>
+
+#include <wx/evtloop.h>
+#include <wx/filename.h>
+
+#include <bwx_sdk/bwx_core/bwx_file_watcher.h>
+
+namespace bwx_sdk {
+
+	bwxFileWatcher& bwxFileWatcher::GetInstance()
+	{
+		// Never destroyed: managers unwatch from their own destructors during static destruction
+		static bwxFileWatcher* instance = new bwxFileWatcher();
+		return *instance;
+	}
+
+	bwxFileWatcher::~bwxFileWatcher() = default;
+
+	bool bwxFileWatcher::IsAvailable()
+	{
+		return wxEventLoopBase::GetActive() != nullptr;
+	}
+
+	std::string bwxFileWatcher::Normalize(const std::string& path)
+	{
+		wxFileName name(wxString::FromUTF8(path));
+		name.Normalize(wxPATH_NORM_DOTS | wxPATH_NORM_ABSOLUTE | wxPATH_NORM_LONG);
+		return std::string(name.GetFullPath().utf8_str());
+	}
+
+	std::string bwxFileWatcher::GetDirectory(const std::string& path)
+	{
+		return std::string(wxFileName(wxString::FromUTF8(path)).GetPath().utf8_str());
+	}
+
+	bool bwxFileWatcher::Watch(const std::string& path, const void* owner, Callback callback)
+	{
+		if (!callback || m_shutDown || !IsAvailable()) return false;
+
+		const std::string file = Normalize(path);
+		const std::string directory = GetDirectory(file);
+
+		if (!m_watcher)
+		{
+			m_watcher = std::make_unique<wxFileSystemWatcher>();
+			m_watcher->SetOwner(this);
+			Bind(wxEVT_FSWATCHER, &bwxFileWatcher::OnFileSystemEvent, this);
+		}
+
+		// Editors usually save through a temporary file and a rename, so creations and renames count too
+		if (m_directories[directory]++ == 0)
+		{
+			if (!m_watcher->Add(wxFileName::DirName(wxString::FromUTF8(directory)), wxFSW_EVENT_MODIFY | wxFSW_EVENT_CREATE | wxFSW_EVENT_RENAME))
+			{
+				wxLogWarning("FileWatcher: Cannot watch directory %s", wxString::FromUTF8(directory));
+				m_directories.erase(directory);
+				return false;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_listeners[file].push_back({ owner, std::move(callback) });
+		return true;
+	}
+
+	void bwxFileWatcher::Unwatch(const std::string& path, const void* owner)
+	{
+		const std::string file = Normalize(path);
+		size_t removed = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_listeners.find(file);
+			if (it == m_listeners.end()) return;
+
+			auto& listeners = it->second;
+			const size_t before = listeners.size();
+			listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+				[owner](const Listener& listener) { return listener.owner == owner; }), listeners.end());
+			removed = before - listeners.size();
+			if (listeners.empty()) m_listeners.erase(it);
+			m_changes.erase({ file, owner });
+		}
+
+		const std::string directory = GetDirectory(file);
+		for (size_t i = 0; i < removed; ++i) ReleaseDirectory(directory);
+	}
+
+	void bwxFileWatcher::UnwatchAll(const void* owner)
+	{
+		std::vector<std::string> directories;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (auto it = m_listeners.begin(); it != m_listeners.end();)
+			{
+				auto& listeners = it->second;
+				const size_t before = listeners.size();
+				listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+					[owner](const Listener& listener) { return listener.owner == owner; }), listeners.end());
+				directories.insert(directories.end(), before - listeners.size(), GetDirectory(it->first));
+				it = listeners.empty() ? m_listeners.erase(it) : std::next(it);
+			}
+
+			for (auto it = m_changes.begin(); it != m_changes.end();)
+			{
+				it = it->second == owner ? m_changes.erase(it) : std::next(it);
+			}
+		}
+
+		for (const auto& directory : directories) ReleaseDirectory(directory);
+	}
+
+	void bwxFileWatcher::ReleaseDirectory(const std::string& directory)
+	{
+		auto it = m_directories.find(directory);
+		if (it == m_directories.end() || --it->second > 0) return;
+
+		m_directories.erase(it);
+		if (m_watcher) m_watcher->Remove(wxFileName::DirName(wxString::FromUTF8(directory)));
+	}
+
+	bool bwxFileWatcher::IsWatching(const std::string& path) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_listeners.find(Normalize(path)) != m_listeners.end();
+	}
+
+	void bwxFileWatcher::OnFileSystemEvent(wxFileSystemWatcherEvent& event)
+	{
+		const int type = event.GetChangeType();
+		if (type & (wxFSW_EVENT_MODIFY | wxFSW_EVENT_CREATE)) QueueChange(std::string(event.GetPath().GetFullPath().utf8_str()));
+		if (type & wxFSW_EVENT_RENAME) QueueChange(std::string(event.GetNewPath().GetFullPath().utf8_str()));
+	}
+
+	void bwxFileWatcher::QueueChange(const std::string& path)
+	{
+		const std::string file = Normalize(path);
+
+		// Only files somebody asked for; the rest of the directory is ignored here
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_listeners.find(file);
+		if (it == m_listeners.end()) return;
+
+		for (const Listener& listener : it->second)
+		{
+			m_changes.emplace(file, listener.owner);
+		}
+	}
+
+	size_t bwxFileWatcher::Dispatch(const void* owner)
+	{
+		// Callbacks are copied out, as they may reload, watch or unwatch files themselves
+		std::vector<std::pair<std::string, Callback>> calls;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (auto it = m_changes.begin(); it != m_changes.end();)
+			{
+				if (owner && it->second != owner)
+				{
+					++it;
+					continue;
+				}
+
+				auto listeners = m_listeners.find(it->first);
+				if (listeners != m_listeners.end())
+				{
+					for (const Listener& listener : listeners->second)
+					{
+						if (listener.owner == it->second) calls.emplace_back(it->first, listener.callback);
+					}
+				}
+				it = m_changes.erase(it);
+			}
+		}
+
+		for (const auto& [path, callback] : calls)
+		{
+			callback(path);
+		}
+		return calls.size();
+	}
+
+	void bwxFileWatcher::Shutdown()
+	{
+		m_shutDown = true;
+
+		if (m_watcher)
+		{
+			m_watcher->RemoveAll();
+			m_watcher.reset();
+			Unbind(wxEVT_FSWATCHER, &bwxFileWatcher::OnFileSystemEvent, this);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_listeners.clear();
+		m_directories.clear();
+		m_changes.clear();
+	}
+
+} // namespace bwx_sdk
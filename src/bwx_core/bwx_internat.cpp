@@ -14,9 +14,11 @@
 #endif
 
 #include <bwx_sdk/bwx_core/bwx_internat.h>
+#include <bwx_sdk/bwx_core/bwx_startup_trace.h>
 
 namespace bwx_sdk {
 
+	std::atomic<const bwxCatalog*> bwxInternat::m_activeCatalog{ nullptr };
 	
 	bwxInternat::bwxInternat() : wxLocale() {
 		AddLanguageSystemDefault();
@@ -37,7 +39,31 @@ namespace bwx_sdk {
 		UseShortCatalogNames();
 	}
 
+	bwxInternat::~bwxInternat() {
+		WaitForCatalog();
+
+		std::lock_guard<std::mutex> lock(m_catalogMutex);
+		for (const auto& pair : m_compiledCatalogs) {
+			const bwxCatalog* catalog = pair.second.get();
+			m_activeCatalog.compare_exchange_strong(catalog, nullptr);
+		}
+	}
+
 	bool bwxInternat::Init(const wxString& shortName) {
+		return InitLanguage(shortName, false);
+	}
+
+	bool bwxInternat::InitAsync(const wxString& shortName) {
+		return InitLanguage(shortName, true);
+	}
+
+	void bwxInternat::WaitForCatalog() {
+		if (!m_catalogJobs.IsDone()) bwxJobSystem::GetInstance().Wait(m_catalogJobs);
+	}
+
+	bool bwxInternat::InitLanguage(const wxString& shortName, bool async) {
+		BWX_STARTUP_PHASE("internat.init", "internat");
+
 		wxLanguage tmp_lang = wxLANGUAGE_UNKNOWN;
 
 		if (shortName.IsEmpty()) {
@@ -62,16 +88,91 @@ namespace bwx_sdk {
 			return false;
 		}
 
-		return LoadCatalogs(lang_info);
+		const bool loaded = LoadCatalogs(lang_info);
+
+		// Compiled catalog is optional - without it Translate() returns source strings
+		wxString compiledName = lang_info->CanonicalName.SubString(0, 1);
+		if (!wxFileExists(CompiledCatalogPath(compiledName))) UseCompiledCatalog(wxString());
+		else if (async) LoadCompiledCatalogAsync(compiledName);
+		else UseCompiledCatalog(compiledName);
+
+		return loaded;
 	}
 
 	bool bwxInternat::InitByName(const wxString& name) {
-		for (const auto& pair : m_langMap) {
-			if (pair.second.GetName().IsSameAs(name)) {
-				return Init(pair.second.GetShortName());
+		auto it = m_langNames.find(name);
+		return it != m_langNames.end() && Init(it->second);
+	}
+
+	bool bwxInternat::UseCompiledCatalog(const wxString& shortName) {
+		std::lock_guard<std::mutex> lock(m_catalogMutex);
+		++m_catalogRequest;
+
+		if (shortName.IsEmpty()) {
+			m_activeCatalog.store(nullptr, std::memory_order_release);
+			return true;
+		}
+
+		auto& catalog = m_compiledCatalogs[shortName];
+		if (!catalog) {
+			BWX_STARTUP_PHASE("internat.catalog", "internat");
+			wxString error;
+			catalog = bwxCatalog::Load(CompiledCatalogPath(shortName), &error);
+			if (!catalog) {
+				m_compiledCatalogs.erase(shortName);
+				wxLogWarning("Failed to load compiled catalog: %s", error);
+				return false;
 			}
 		}
-		return false;
+
+		m_activeCatalog.store(catalog.get(), std::memory_order_release);
+		return true;
+	}
+
+	void bwxInternat::LoadCompiledCatalogAsync(const wxString& shortName) {
+		bwxJobSystem& jobs = bwxJobSystem::GetInstance();
+		bool loaded = false;
+		{
+			std::lock_guard<std::mutex> lock(m_catalogMutex);
+			loaded = m_compiledCatalogs.count(shortName) > 0;
+		}
+
+		// Already loaded, or no worker to load it on: switch right away
+		if (loaded || jobs.GetWorkerCount() == 0) {
+			UseCompiledCatalog(shortName);
+			return;
+		}
+
+		uint64_t request = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_catalogMutex);
+			request = ++m_catalogRequest;
+		}
+
+		const wxString path = CompiledCatalogPath(shortName);
+		jobs.Schedule([this, shortName, path, request]() {
+			BWX_STARTUP_PHASE("internat.catalog", "internat");
+			wxString error;
+			std::shared_ptr<const bwxCatalog> catalog = bwxCatalog::Load(path, &error);
+			if (!catalog) {
+				wxLogWarning("Failed to load compiled catalog: %s", error);
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(m_catalogMutex);
+			auto& slot = m_compiledCatalogs[shortName];
+			if (!slot) slot = catalog;
+			// A switch made meanwhile wins over this load
+			if (m_catalogRequest == request) m_activeCatalog.store(slot.get(), std::memory_order_release);
+		}, &m_catalogJobs);
+	}
+
+	wxString bwxInternat::CompiledCatalogPath(const wxString& shortName) const {
+		wxFileName path = wxFileName::DirName(wxGetCwd());
+		path.AppendDir(m_langFolder);
+		path.AppendDir(shortName);
+		path.SetFullName(shortName + ".bwxcat");
+		return path.GetFullPath();
 	}
 
 	void bwxInternat::SetDefaultAppLanguage(const wxString& shortName, const wxString& name, const wxString& uname, wxLanguage wxLangCode) noexcept {
@@ -80,10 +181,11 @@ namespace bwx_sdk {
 
 	void bwxInternat::AddLanguage(const bwxLanguage& l) {
 		m_langMap[l.GetShortName()] = l; // Replace emplace with direct assignment
+		m_langNames[l.GetName()] = l.GetShortName();
 	}
 
 	void bwxInternat::AddLanguage(const wxString& shortName, const wxString& name, const wxString& uname, wxLanguage wxLangCode) {
-		m_langMap[shortName] = bwxLanguage(shortName, name, uname, wxLangCode); // Assignment compatible with wxHashMap
+		AddLanguage(bwxLanguage(shortName, name, uname, wxLangCode));
 	}
 
 	void bwxInternat::AddLanguageSystemDefault() {
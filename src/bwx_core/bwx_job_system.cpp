@@ -0,0 +1,210 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_job_system.cpp
+// Purpose:     BWX_SDK Library; Work-stealing job system
+// Author:      Bartosz Warzocha
+// Created:     2026-10-14
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_job_system.cpp
+ * @brief Implements a small work-stealing thread pool used for parallel updates.
+ */
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
+
+namespace bwx_sdk {
+
+	namespace {
+		thread_local int t_queueIndex = -1; // Own queue of a worker thread, -1 elsewhere
+	}
+
+	bwxJobSystem& bwxJobSystem::GetInstance()
+	{
+		static bwxJobSystem instance;
+		return instance;
+	}
+
+	bwxJobSystem::bwxJobSystem(unsigned int workerCount)
+	{
+		if (workerCount == 0)
+		{
+			unsigned int hardware = std::thread::hardware_concurrency();
+			workerCount = hardware > 1 ? hardware - 1 : 1; // Calling thread helps in Wait()
+		}
+
+		for (unsigned int i = 0; i <= workerCount; ++i)
+		{
+			m_queues.push_back(std::make_unique<Queue>());
+		}
+
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			m_threads.emplace_back(&bwxJobSystem::WorkerLoop, this, i);
+		}
+	}
+
+	bwxJobSystem::~bwxJobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_running = false;
+		}
+		m_wake.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			if (thread.joinable()) thread.join();
+		}
+	}
+
+	void bwxJobSystem::Schedule(Job job, bwxJobCounter* counter)
+	{
+		if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+		// Workers push to their own queue, other threads to the shared last one
+		const unsigned int index = t_queueIndex >= 0 ? static_cast<unsigned int>(t_queueIndex)
+			: static_cast<unsigned int>(m_queues.size() - 1);
+
+		{
+			std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+			m_queues[index]->entries.push_back({ std::move(job), counter });
+		}
+		m_queued.fetch_add(1, std::memory_order_release);
+
+		// Empty critical section closes the gap between a worker's check and its wait
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+		}
+		m_wake.notify_one();
+	}
+
+	void bwxJobSystem::Wait(bwxJobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!RunOne(t_queueIndex))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void bwxJobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& func)
+	{
+		if (count == 0) return;
+
+		// A few chunks per thread keep stealing useful without flooding the queues
+		const size_t threads = m_threads.size() + 1;
+		const size_t chunk = std::max(std::max<size_t>(grainSize, 1), (count + threads * 4 - 1) / (threads * 4));
+
+		if (chunk >= count)
+		{
+			func(0, count);
+			return;
+		}
+
+		bwxJobCounter counter;
+		for (size_t begin = chunk; begin < count; begin += chunk)
+		{
+			const size_t end = std::min(begin + chunk, count);
+			Schedule([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+
+		func(0, chunk);
+		Wait(counter);
+	}
+
+	void bwxJobSystem::WorkerLoop(unsigned int index)
+	{
+		t_queueIndex = static_cast<int>(index);
+
+		while (true)
+		{
+			if (RunOne(t_queueIndex)) continue;
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_wake.wait(lock, [this]() { return !m_running || m_queued.load(std::memory_order_acquire) > 0; });
+
+			if (!m_running && m_queued.load(std::memory_order_acquire) == 0) break;
+		}
+	}
+
+	bool bwxJobSystem::RunOne(int preferredQueue)
+	{
+		Entry entry;
+
+		if (preferredQueue >= 0 && Pop(static_cast<unsigned int>(preferredQueue), entry))
+		{
+			Execute(entry);
+			return true;
+		}
+
+		const unsigned int thief = preferredQueue >= 0 ? static_cast<unsigned int>(preferredQueue)
+			: static_cast<unsigned int>(m_queues.size() - 1);
+		if (Steal(thief, entry))
+		{
+			Execute(entry);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool bwxJobSystem::Pop(unsigned int queue, Entry& entry)
+	{
+		Queue& q = *m_queues[queue];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (q.entries.empty()) return false;
+
+		// Newest first - its data is most likely still in this core's cache
+		entry = std::move(q.entries.back());
+		q.entries.pop_back();
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool bwxJobSystem::Steal(unsigned int thief, Entry& entry)
+	{
+		const unsigned int count = static_cast<unsigned int>(m_queues.size());
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			// Shared queue included, so outside jobs are picked up as well
+			Queue& q = *m_queues[(thief + i) % count];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (q.entries.empty()) continue;
+
+			entry = std::move(q.entries.front());
+			q.entries.pop_front();
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	void bwxJobSystem::Execute(Entry& entry)
+	{
+		try
+		{
+			entry.job();
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Error: Unhandled exception in job: " << e.what() << std::endl;
+		}
+		catch (...)
+		{
+			std::cerr << "Error: Unhandled exception in job." << std::endl;
+		}
+
+		if (entry.counter) entry.counter->m_pending.fetch_sub(1, std::memory_order_release);
+	}
+
+} // namespace bwx_sdk
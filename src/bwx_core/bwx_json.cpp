@@ -9,6 +9,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <bwx_sdk/bwx_core/bwx_json.h>
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
 
 #include <wx/log.h>
 #include <wx/file.h>
@@ -18,10 +19,277 @@
 
 #include <sstream>
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace bwx_sdk {
 
+    namespace {
+
+        // Nesting limit (recursive descent - keeps malformed input from overflowing the stack)
+        constexpr int JSON_MAX_DEPTH = 512;
+
+        // Stream read chunk size
+        constexpr size_t JSON_READ_CHUNK = 64 * 1024;
+
+        inline bool IsJsonSpace(char c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+        }
+
+        inline bool IsJsonNumberChar(char c)
+        {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        /// Recursive descent parser over UTF-8 bytes (no wide-char conversion of the whole text).
+        /// Strings and keys are kept raw (escape sequences unchanged), like the serializer writes them;
+        /// only their bytes are converted to wxString.
+        class bwxJsonUtf8Reader
+        {
+        public:
+            explicit bwxJsonUtf8Reader(std::string_view text) : m_text(text), m_pos(0) {}
+
+            bool ParseDocument(bwxJsonValue& root)
+            {
+                return ParseValue(root, 0);
+            }
+
+            size_t GetPosition() const { return m_pos; }
+
+            const wxString& GetError() const { return m_error; }
+
+        private:
+            std::string_view m_text;
+            size_t m_pos;
+            wxString m_error;
+
+            bool Fail(const char* message)
+            {
+                if (m_error.IsEmpty())
+                    m_error = wxString::Format(wxT("Parse JSON error at %zu: %s"), m_pos, message);
+                return false;
+            }
+
+            void SkipWhitespace()
+            {
+                const size_t size = m_text.size();
+                while (m_pos < size)
+                {
+                    const char c = m_text[m_pos];
+                    if (IsJsonSpace(c))
+                    {
+                        m_pos++;
+                        continue;
+                    }
+
+                    // Comments // and /* ... */
+                    if (c == '/' && m_pos + 1 < size && m_text[m_pos + 1] == '/')
+                    {
+                        size_t end = m_text.find('\n', m_pos + 2);
+                        m_pos = end == std::string_view::npos ? size : end;
+                        continue;
+                    }
+                    if (c == '/' && m_pos + 1 < size && m_text[m_pos + 1] == '*')
+                    {
+                        size_t end = m_text.find("*/", m_pos + 2);
+                        m_pos = end == std::string_view::npos ? size : end + 2;
+                        continue;
+                    }
+
+                    break;
+                }
+            }
+
+            bool Match(std::string_view word)
+            {
+                if (m_text.compare(m_pos, word.size(), word) != 0)
+                    return Fail("unknown literal");
+                m_pos += word.size();
+                return true;
+            }
+
+            bool ParseValue(bwxJsonValue& value, int depth)
+            {
+                SkipWhitespace();
+                if (m_pos >= m_text.size())
+                    return Fail("unexpected end of JSON");
+
+                const char c = m_text[m_pos];
+                if (c == '"')
+                {
+                    wxString text;
+                    if (!ParseString(text))
+                        return false;
+                    value = bwxJsonValue(std::move(text));
+                    return true;
+                }
+                if (c == '{') return ParseObject(value, depth + 1);
+                if (c == '[') return ParseArray(value, depth + 1);
+                if (c == '-' || (c >= '0' && c <= '9')) return ParseNumber(value);
+
+                if (c == 't' && Match("true")) { value = bwxJsonValue(true); return true; }
+                if (c == 'f' && Match("false")) { value = bwxJsonValue(false); return true; }
+                if (c == 'n' && Match("null")) { value = bwxJsonValue(); return true; }
+
+                return Fail("unexpected character");
+            }
+
+            bool ParseString(wxString& result)
+            {
+                // Closing quote is the first one not escaped by an odd run of backslashes;
+                // memchr jumps over string content (vectorized by the C library)
+                const size_t start = ++m_pos;
+                while (m_pos < m_text.size())
+                {
+                    const void* quote = std::memchr(m_text.data() + m_pos, '"', m_text.size() - m_pos);
+                    if (!quote)
+                        break;
+
+                    const size_t end = static_cast<const char*>(quote) - m_text.data();
+                    size_t backslashes = 0;
+                    while (end - backslashes > start && m_text[end - backslashes - 1] == '\\')
+                        backslashes++;
+
+                    m_pos = end + 1;
+                    if (backslashes % 2 == 0)
+                    {
+                        result = wxString::FromUTF8(m_text.data() + start, end - start);
+                        return true;
+                    }
+                }
+
+                m_pos = m_text.size();
+                return Fail("missing closing `\"`");
+            }
+
+            bool ParseNumber(bwxJsonValue& value)
+            {
+                const size_t start = m_pos;
+                bool isDouble = false;
+                while (m_pos < m_text.size() && IsJsonNumberChar(m_text[m_pos]))
+                {
+                    const char c = m_text[m_pos];
+                    isDouble = isDouble || c == '.' || c == 'e' || c == 'E';
+                    m_pos++;
+                }
+
+                const char* first = m_text.data() + start;
+                const char* last = m_text.data() + m_pos;
+
+                // Integers: smallest type that holds them (int, int64_t, uint64_t), double beyond that
+                if (!isDouble)
+                {
+                    int64_t number = 0;
+                    auto result = std::from_chars(first, last, number);
+                    if (result.ec == std::errc() && result.ptr == last)
+                    {
+                        if (number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max())
+                            value = bwxJsonValue(static_cast<int>(number));
+                        else
+                            value = bwxJsonValue(number);
+                        return true;
+                    }
+
+                    uint64_t unsignedNumber = 0;
+                    result = std::from_chars(first, last, unsignedNumber);
+                    if (result.ec == std::errc() && result.ptr == last)
+                    {
+                        value = bwxJsonValue(unsignedNumber);
+                        return true;
+                    }
+                }
+
+                double number = 0.0;
+                auto result = std::from_chars(first, last, number);
+                if (result.ec != std::errc() || result.ptr != last)
+                {
+                    m_pos = start;
+                    return Fail("invalid number");
+                }
+
+                value = bwxJsonValue(number);
+                return true;
+            }
+
+            bool ParseObject(bwxJsonValue& value, int depth)
+            {
+                if (depth > JSON_MAX_DEPTH)
+                    return Fail("nesting too deep");
+
+                auto jsonObject = std::make_shared<bwxJSON>();
+                m_pos++;
+
+                for (;;)
+                {
+                    SkipWhitespace();
+                    if (m_pos >= m_text.size())
+                        return Fail("unexpected end of JSON - missing closing `}`");
+                    if (m_text[m_pos] == '}')
+                        break;
+                    if (m_text[m_pos] != '"')
+                        return Fail("expected string key");
+
+                    wxString key;
+                    if (!ParseString(key))
+                        return false;
+
+                    SkipWhitespace();
+                    if (m_pos >= m_text.size() || m_text[m_pos] != ':')
+                        return Fail("expected `:` after key");
+                    m_pos++;
+
+                    // Parse straight into the map slot (no copy of nested values)
+                    if (!ParseValue((*jsonObject)[key], depth))
+                        return false;
+
+                    SkipWhitespace();
+                    if (m_pos < m_text.size() && m_text[m_pos] == ',')
+                        m_pos++;
+                }
+
+                m_pos++;
+                value = bwxJsonValue(std::move(jsonObject));
+                return true;
+            }
+
+            bool ParseArray(bwxJsonValue& value, int depth)
+            {
+                if (depth > JSON_MAX_DEPTH)
+                    return Fail("nesting too deep");
+
+                std::vector<bwxJsonValueHelper> jsonArray;
+                m_pos++;
+
+                for (;;)
+                {
+                    SkipWhitespace();
+                    if (m_pos >= m_text.size())
+                        return Fail("unexpected end of JSON - missing closing `]`");
+                    if (m_text[m_pos] == ']')
+                        break;
+
+                    jsonArray.emplace_back();
+                    if (!ParseValue(jsonArray.back().value, depth))
+                        return false;
+
+                    SkipWhitespace();
+                    if (m_pos < m_text.size() && m_text[m_pos] == ',')
+                        m_pos++;
+                }
+
+                m_pos++;
+                value = bwxJsonValue(std::move(jsonArray));
+                return true;
+            }
+        };
+
+    }
+
     bwxJSON::bwxJSON(const wxString& jsonText)
     {
         ParseFromString(jsonText);
@@ -31,7 +299,7 @@ namespace bwx_sdk {
     {
         if (defaultValue.has_value())
         {
-            m_data["default"] = defaultValue;
+            MutableData()["default"] = defaultValue;
         }
     }
     
@@ -43,16 +311,21 @@ namespace bwx_sdk {
 
     bool bwxJSON::LoadFromFile(const wxString& filename)
     {
-        wxTextFile file;
+        wxFile file;
         if (!file.Open(filename))
             return false;
 
-        wxString jsonText;
-        for (size_t i = 0; i < file.GetLineCount(); ++i)
-            jsonText += file.GetLine(i);
+        // Raw UTF-8 bytes in one read - parsed without conversion to wxString
+        wxFileOffset length = file.Length();
+        if (length < 0)
+            return false;
+
+        std::string jsonText(static_cast<size_t>(length), '\0');
+        if (length > 0 && file.Read(jsonText.data(), jsonText.size()) != static_cast<ssize_t>(jsonText.size()))
+            return false;
 
         file.Close();
-        return ParseFromString(jsonText);
+        return ParseFromUtf8(jsonText);
     }
 
     bool bwxJSON::SaveToFile(const wxString& filename) const
@@ -61,67 +334,89 @@ namespace bwx_sdk {
         if (!file.Open(filename, wxFile::write))
             return false;
 
-        wxString jsonText = SerializeToString();
-        file.Write(jsonText);
+        std::string jsonText;
+        SerializeToUtf8(jsonText);
+        const bool written = file.Write(jsonText.data(), jsonText.size()) == jsonText.size();
         file.Close();
-        return true;
+        return written;
     }
 
     bool bwxJSON::LoadFromStream(wxInputStream& stream)
     {
-        wxTextInputStream textStream(stream);
-        wxString jsonText;
+        std::string jsonText;
+        std::vector<char> buffer(JSON_READ_CHUNK);
 
-        while (!stream.Eof())
+        do
         {
-            jsonText += textStream.ReadLine();
-        }
+            stream.Read(buffer.data(), buffer.size());
+            jsonText.append(buffer.data(), stream.LastRead());
+        } while (stream.LastRead() > 0);
 
-        return ParseFromString(jsonText);
+        return ParseFromUtf8(jsonText);
     }
 
     bool bwxJSON::SaveToStream(wxOutputStream& stream) const
     {
-        wxTextOutputStream textStream(stream);
-        textStream << SerializeToString();
-        return true;
+        std::string jsonText;
+        SerializeToUtf8(jsonText);
+        stream.Write(jsonText.data(), jsonText.size());
+        return stream.LastWrite() == jsonText.size();
     }
 
     bool bwxJSON::ParseFromString(const wxString& jsonText)
     {
-        size_t pos = 0;
-        m_data.clear();
+        const wxScopedCharBuffer utf8 = jsonText.utf8_str();
+        return ParseFromUtf8(std::string_view(utf8.data(), utf8.length()));
+    }
+
+    bool bwxJSON::ParseFromUtf8(std::string_view jsonText)
+    {
+        BWX_METRIC_SCOPE_TIME("core.json.parse_ms");
+
+        m_data.reset();
         m_lastError.Clear();
 
-        pos = SkipWhitespace(jsonText, pos);
+        // UTF-8 BOM
+        if (jsonText.size() >= 3 && std::memcmp(jsonText.data(), "\xEF\xBB\xBF", 3) == 0)
+            jsonText.remove_prefix(3);
+
+        bwxJsonUtf8Reader reader(jsonText);
+        bwxJsonValue parsedValue;
+        if (!reader.ParseDocument(parsedValue))
+        {
+            m_lastError = reader.GetError();
+            return false;
+        }
 
-        bwxJsonValue parsedValue = ParseValue(jsonText, pos);
         if (parsedValue.has_value() && std::holds_alternative<std::shared_ptr<bwxJSON>>(*parsedValue))
         {
-            *this = *std::get<std::shared_ptr<bwxJSON>>(*parsedValue);
+            m_data = std::move(std::get<std::shared_ptr<bwxJSON>>(*parsedValue)->m_data);
             return true;
         }
 
-        m_lastError = wxString::Format(wxT("Parse JSON error at %zu: wrong structure"), pos);
+        m_lastError = wxString::Format(wxT("Parse JSON error at %zu: wrong structure"), reader.GetPosition());
         return false;
     }
 
     wxString bwxJSON::SerializeToString() const
     {
-        wxString jsonText = "{";
-
-        for (const auto& [key, value] : m_data)
-        {
-            jsonText += "\"" + key + "\":" + JsonValueToString(value) + ",";
-        }
-
-        if (jsonText.EndsWith(","))
-            jsonText.RemoveLast();
+        std::string jsonText;
+        SerializeToUtf8(jsonText);
+        return wxString::FromUTF8(jsonText.data(), jsonText.size());
+    }
 
-        jsonText += "}";
+    std::string bwxJSON::SerializeToUtf8(int indent) const
+    {
+        std::string jsonText;
+        SerializeToUtf8(jsonText, indent);
         return jsonText;
     }
 
+    void bwxJSON::SerializeToUtf8(std::string& out, int indent) const
+    {
+        WriteUtf8(out, std::max(indent, 0), 0);
+    }
+
     wxString bwxJSON::SerializeCompact() const
     {
         return SerializeToString();
@@ -129,53 +424,72 @@ namespace bwx_sdk {
 
     bool bwxJSON::HasKey(const wxString& key) const
     {
-        return m_data.find(key) != m_data.end();
+        return Data().find(key) != Data().end();
     }
 
     void bwxJSON::RemoveKey(const wxString& key)
     {
-        m_data.erase(key);
+        if (HasKey(key))
+            MutableData().erase(key);
     }
 
     std::vector<wxString> bwxJSON::GetKeys() const
     {
         std::vector<wxString> keys;
-        for (const auto& [key, _] : m_data)
+        for (const auto& [key, _] : Data())
             keys.push_back(key);
         return keys;
     }
 
     void bwxJSON::SetValue(const wxString& key, const bwxJsonValue& value)
     {
-        m_data[key] = value;
+        MutableData()[key] = value;
     }
 
     bwxJsonValue bwxJSON::GetValue(const wxString& key, const bwxJsonValue& defaultValue) const
     {
-        auto it = m_data.find(key);
-        return (it != m_data.end()) ? it->second : defaultValue;
+        auto it = Data().find(key);
+        return (it != Data().end()) ? it->second : defaultValue;
+    }
+
+    const bwxJsonValue* bwxJSON::GetValuePtr(const wxString& key) const
+    {
+        auto it = Data().find(key);
+        return (it != Data().end()) ? &it->second : nullptr;
+    }
+
+    bwxJSON* bwxJSON::GetObjectForWrite(const wxString& key)
+    {
+        const bwxJsonValue* value = GetValuePtr(key);
+        if (!value || !value->has_value() || !std::holds_alternative<std::shared_ptr<bwxJSON>>(**value) ||
+            !std::get<std::shared_ptr<bwxJSON>>(**value))
+            return nullptr;
+
+        return &MutableObject(std::get<std::shared_ptr<bwxJSON>>(*MutableData()[key]));
     }
 
     void bwxJSON::AppendToArray(const wxString& key, const bwxJsonValue& value)
     {
-        if (!m_data[key].has_value())
+        bwxJsonValue& target = MutableData()[key];
+        if (!target.has_value())
         {
-            m_data[key].emplace(std::vector<bwxJsonValueHelper>());
+            target.emplace(std::vector<bwxJsonValueHelper>());
         }
 
-        if (std::holds_alternative<std::vector<bwxJsonValueHelper>>(*m_data[key]))
+        if (std::holds_alternative<std::vector<bwxJsonValueHelper>>(*target))
         {
-            std::get<std::vector<bwxJsonValueHelper>>(*m_data[key]).emplace_back(bwxJsonValueHelper{ value });
+            std::get<std::vector<bwxJsonValueHelper>>(*target).emplace_back(bwxJsonValueHelper{ value });
         }
     }
 
     std::vector<bwxJsonValue> bwxJSON::GetArray(const wxString& key) const
     {
-        if (!HasKey(key) || !m_data.at(key).has_value() || !std::holds_alternative<std::vector<bwxJsonValueHelper>>(*m_data.at(key)))
+        const bwxJsonValue* value = GetValuePtr(key);
+        if (!value || !value->has_value() || !std::holds_alternative<std::vector<bwxJsonValueHelper>>(**value))
             return {};
 
         std::vector<bwxJsonValue> result;
-        for (const auto& val : std::get<std::vector<bwxJsonValueHelper>>(*m_data.at(key)))
+        for (const auto& val : std::get<std::vector<bwxJsonValueHelper>>(**value))
         {
             result.push_back(val.value);
         }
@@ -184,12 +498,13 @@ namespace bwx_sdk {
 
     void bwxJSON::RemoveFromArray(const wxString& key, size_t index)
     {
-        if (!HasKey(key) || !std::holds_alternative<std::vector<bwxJsonValueHelper>>(*m_data[key]))
+        const bwxJsonValue* value = GetValuePtr(key);
+        if (!value || !value->has_value() || !std::holds_alternative<std::vector<bwxJsonValueHelper>>(**value) ||
+            index >= std::get<std::vector<bwxJsonValueHelper>>(**value).size())
             return;
 
-        auto& arr = std::get<std::vector<bwxJsonValueHelper>>(*m_data[key]);
-        if (index < arr.size())
-            arr.erase(arr.begin() + index);
+        auto& arr = std::get<std::vector<bwxJsonValueHelper>>(*MutableData()[key]);
+        arr.erase(arr.begin() + index);
     }
 
     bwxJsonValue bwxJSON::FindValue(const wxString& key) const
@@ -197,7 +512,7 @@ namespace bwx_sdk {
         if (HasKey(key))
             return GetValue(key);
 
-        for (const auto& [_, v] : m_data)
+        for (const auto& [_, v] : Data())
         {
             if (v.has_value() && std::holds_alternative<std::shared_ptr<bwxJSON>>(*v))
             {
@@ -213,7 +528,7 @@ namespace bwx_sdk {
     {
         std::vector<std::pair<wxString, bwxJsonValue>> sortedData;
 
-        for (const auto& [key, value] : m_data)
+        for (const auto& [key, value] : Data())
         {
             sortedData.emplace_back(key, value);
         }
@@ -221,16 +536,17 @@ namespace bwx_sdk {
         std::sort(sortedData.begin(), sortedData.end(),
             [](const auto& a, const auto& b) { return a.first < b.first; });
 
-        m_data.clear();
+        bwxJsonMap& data = MutableData();
+        data.clear();
         for (const auto& [key, value] : sortedData)
         {
-            m_data.emplace(key, value);
+            data.emplace(key, value);
         }
     }
 
     bool bwxJSON::operator==(const bwxJSON& other) const
     {
-        return m_data == other.m_data;
+        return m_data == other.m_data || Data() == other.Data();
     }
 
     bool bwxJSON::operator!=(const bwxJSON& other) const
@@ -240,13 +556,13 @@ namespace bwx_sdk {
 
     bwxJsonValue& bwxJSON::operator[](const wxString& key)
     {
-        return m_data[key];
+        return MutableData()[key];
     }
 
     const bwxJsonValue& bwxJSON::operator[](const wxString& key) const
     {
-        auto it = m_data.find(key);
-        if (it != m_data.end())
+        auto it = Data().find(key);
+        if (it != Data().end())
             return it->second;
 
         static bwxJsonValue emptyValue = std::nullopt;
@@ -255,281 +571,172 @@ namespace bwx_sdk {
 
     bool bwxJSON::IsValid() const
     {
-        return !m_data.empty();
+        return !Data().empty();
     }
 
     size_t bwxJSON::GetSize() const
 	{
-		return m_data.size();
+		return Data().size();
 	}
 
     wxString bwxJSON::GetKey(size_t index) const
 	{
-		if (index >= m_data.size()) return wxString();
-		auto it = m_data.begin();
+		if (index >= Data().size()) return wxString();
+		auto it = Data().begin();
 		std::advance(it, index);
 		return it->first;
 	}
 
-    wxString bwxJSON::EscapeString(const wxString& str) const
-    {
-        wxString escaped;
-        for (auto ch : str)
-        {
-            switch (ch.GetValue())
-            {
-            case '\"': escaped += "\\\""; break;
-            case '\\': escaped += "\\\\"; break;
-            case '\b': escaped += "\\b"; break;
-            case '\f': escaped += "\\f"; break;
-            case '\n': escaped += "\\n"; break;
-            case '\r': escaped += "\\r"; break;
-            case '\t': escaped += "\\t"; break;
-            default: escaped += ch; break;
-            }
-        }
-        return "\"" + escaped + "\"";
-    }
-
-    wxString bwxJSON::JsonValueToString(const bwxJsonValue& value) const
-    {
-        if (!value.has_value()) return wxString("null");
-
-        return std::visit([this](auto&& arg) -> wxString {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, std::nullptr_t>) return wxString("null");
-            else if constexpr (std::is_same_v<T, int>) return wxString::Format("%d", arg);
-            else if constexpr (std::is_same_v<T, int64_t>) return wxString::Format("%lld", arg);
-            else if constexpr (std::is_same_v<T, uint64_t>) return wxString::Format("%llu", arg);
-            else if constexpr (std::is_same_v<T, double>) return wxString::Format("%g", arg);
-            else if constexpr (std::is_same_v<T, bool>) return wxString(arg ? "true" : "false");
-            else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, wxString>) return "\"" + wxString(arg) + "\"";
-            else if constexpr (std::is_same_v<T, std::shared_ptr<bwxJSON>>) return arg ? arg->SerializeToString() : wxString("null");
-            else { // std::vector<bwxJsonValueHelper>
-                wxString jsonArray = "[";
-                for (const auto& val : arg) {
-                    jsonArray += JsonValueToString(val.value) + ",";
-                }
-                if (jsonArray.EndsWith(",")) jsonArray.RemoveLast();
-                jsonArray += "]";
-                return jsonArray;
-            }
-            }, *value);
-    }
-
-    size_t bwxJSON::SkipWhitespace(const wxString& text, size_t start) const
+    void bwxJSON::EscapeUtf8(std::string_view text, std::string& out)
     {
-        while (start < text.Length())
+        // Per byte: 0 - copied, 'u' - \u00XX, other - character after the backslash
+        static constexpr auto escapes = [] {
+            std::array<char, 256> table{};
+            for (int c = 0; c < 0x20; ++c) table[c] = 'u';
+            table['\b'] = 'b';
+            table['\f'] = 'f';
+            table['\n'] = 'n';
+            table['\r'] = 'r';
+            table['\t'] = 't';
+            table['"'] = '"';
+            table['\\'] = '\\';
+            return table;
+        }();
+        static const char hex[] = "0123456789abcdef";
+
+        // Runs of plain bytes are appended at once
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); ++i)
         {
-            // SKip whitaspaces
-            if (std::isspace(text[start].GetValue()))
-            {
-                start++;
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+            const char escape = escapes[c];
+            if (!escape)
                 continue;
-            }
 
-            // Comments //
-            if (text[start] == '/' && start + 1 < text.Length() && text[start + 1] == '/')
+            out.append(text.data() + start, i - start);
+            start = i + 1;
+            out += '\\';
+            if (escape == 'u')
             {
-                while (start < text.Length() && text[start] != '\n')
-                    start++;
-                continue;
+                out += "u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
             }
-
-            // Comments /* ... */
-            if (text[start] == '/' && start + 1 < text.Length() && text[start + 1] == '*')
+            else
             {
-                start += 2; // Skip begin `/*`
-                while (start + 1 < text.Length() && !(text[start] == '*' && text[start + 1] == '/'))
-                    start++;
-                if (start + 1 < text.Length()) start += 2; // Skip end `*/`
-                continue;
+                out += escape;
             }
-
-			// If not whitespace or comment, break loop...
-            break;
         }
-
-        return start;
+        out.append(text.data() + start, text.size() - start);
     }
 
-    bwxJsonValue bwxJSON::ParseValue(const wxString& text, size_t& pos)
+    void bwxJSON::WriteUtf8(std::string& out, int indent, int level) const
     {
-        pos = SkipWhitespace(text, pos);
-
-        if (text[pos] == '"') return ParseString(text, pos);
-        if (text[pos] == '{') return ParseObject(text, pos);
-        if (text[pos] == '[') return ParseArray(text, pos);
-        if (std::isdigit(text[pos].GetValue()) || text[pos] == '-') return ParseNumber(text, pos);
-
-        if (text.Mid(pos, 4) == "true") { pos += 4; return bwxJsonValue(true); }
-        if (text.Mid(pos, 5) == "false") { pos += 5; return bwxJsonValue(false); }
-        if (text.Mid(pos, 4) == "null") { pos += 4; return bwxJsonValue(); }
-
-        return bwxJsonValue();
-    }
-
-    wxString bwxJSON::ParseString(const wxString& text, size_t& pos)
-    {
-        pos++;
-        size_t start = pos;
-        while (pos < text.Length() && text[pos] != '"')
+        if (Data().empty())
         {
-            if (text[pos] == '\\') pos++;
-            pos++;
+            out += "{}";
+            return;
         }
-        wxString result = text.Mid(start, pos - start);
-        pos++;
-        return result;
-    }
-
-    bwxJsonValue bwxJSON::ParseNumber(const wxString& text, size_t& pos)
-    {
-        size_t start = pos;
-        while (pos < text.Length() && (std::isdigit(text[pos].GetValue()) || text[pos] == '.' || text[pos] == '-'))
-            pos++;
 
-        wxString numberStr = text.Mid(start, pos - start);
-        if (numberStr.Contains(".")) return bwxJsonValue(std::stod(numberStr.ToStdString()));
-        return bwxJsonValue(std::stoi(numberStr.ToStdString()));
-    }
-
-    bwxJsonValue bwxJSON::ParseObject(const wxString& text, size_t& pos)
-    {
-        auto jsonObject = std::make_shared<bwxJSON>();
-        pos++;
-
-        while (pos < text.Length() && text[pos] != '}')
+        // Indentation appended in place (no indent strings built)
+        out += '{';
+        bool first = true;
+        for (const auto& [key, value] : Data())
         {
-            pos = SkipWhitespace(text, pos);
-            if (pos >= text.Length()) {
-                m_lastError = wxString::Format("Unexpected end of JSON at position %zu - missing closing `}`", pos);
-                return std::nullopt;
-            }
-
-            wxString key = ParseString(text, pos);
-            pos = SkipWhitespace(text, pos);
+            if (!first)
+                out += ',';
+            first = false;
 
-            if (text[pos] != ':') {
-                m_lastError = wxString::Format("JSON syntax error at position %zu: Expected `:` after key", pos);
-                return std::nullopt;
+            if (indent > 0)
+            {
+                out += '\n';
+                out.append(static_cast<size_t>(indent) * (level + 1), ' ');
             }
-            pos++;
-
-            bwxJsonValue value = ParseValue(text, pos);
-            jsonObject->SetValue(key, value);
 
-            pos = SkipWhitespace(text, pos);
-            if (text[pos] == ',') pos++;
+            const wxScopedCharBuffer utf8 = key.utf8_str();
+            out += '"';
+            out.append(utf8.data(), utf8.length());
+            out += indent > 0 ? "\": " : "\":";
+            WriteValueUtf8(out, value, indent, level + 1);
         }
 
-        if (pos >= text.Length()) {
-            m_lastError = wxString::Format("Unexpected end of JSON at position %zu - missing closing `}`", pos);
-            return std::nullopt;
+        if (indent > 0)
+        {
+            out += '\n';
+            out.append(static_cast<size_t>(indent) * level, ' ');
         }
-
-        pos++;
-        return bwxJsonValue(jsonObject);
+        out += '}';
     }
 
-    bwxJsonValue bwxJSON::ParseArray(const wxString& text, size_t& pos)
+    void bwxJSON::WriteValueUtf8(std::string& out, const bwxJsonValue& value, int indent, int level)
     {
-        std::vector<bwxJsonValueHelper> jsonArray;
-        pos++;
-
-        while (pos < text.Length() && text[pos] != ']')
+        if (!value.has_value())
         {
-            pos = SkipWhitespace(text, pos);
-            if (pos >= text.Length()) {
-                m_lastError = wxString::Format("Unexpected end of JSON at position %zu - missing closing `]`", pos);
-                return std::nullopt;
-            }
-
-            jsonArray.push_back(bwxJsonValueHelper{ ParseValue(text, pos) });
-            pos = SkipWhitespace(text, pos);
-            if (text[pos] == ',') pos++;
-        }
-
-        if (pos >= text.Length()) {
-            m_lastError = wxString::Format("Unexpected end of JSON at position %zu - missing closing `]`", pos);
-            return std::nullopt;
+            out += "null";
+            return;
         }
 
-        pos++;
-        return bwxJsonValue(jsonArray);
-    }
-
-    wxString bwxJSON::SerializePretty(int indentLevel) const
-    {
-        wxString jsonText;
-        int currentIndent = 0;
-
-        auto addIndent = [&]() {
-            jsonText += wxString(' ', currentIndent);
-            };
-
-        std::function<void(const bwxJsonValue&, int)> serialize = [&](const bwxJsonValue& value, int level) {
-            if (!value.has_value()) {
-                jsonText += "null";
-                return;
+        std::visit([&](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            char number[32];
+            if constexpr (std::is_same_v<T, std::nullptr_t>) out += "null";
+            else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>) {
+                out.append(number, std::to_chars(number, number + sizeof(number), arg).ptr);
             }
-
-            std::visit([&](auto&& arg) {
-                using T = std::decay_t<decltype(arg)>;
-
-                if constexpr (std::is_same_v<T, std::nullptr_t>) {
-                    jsonText += "null";
-                }
-                else if constexpr (std::is_same_v<T, int>) {
-                    jsonText += wxString::Format("%d", arg);
+            else if constexpr (std::is_same_v<T, double>) {
+                // Shortest round-trip form; integral values keep ".0" so they parse back as double
+                if (!std::isfinite(arg)) {
+                    out += "null";
+                    return;
                 }
-                else if constexpr (std::is_same_v<T, double>) {
-                    jsonText += wxString::Format("%g", arg);
-                }
-                else if constexpr (std::is_same_v<T, bool>) {
-                    jsonText += arg ? "true" : "false";
-                }
-                else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, wxString>) {
-                    jsonText += "\"" + wxString(arg) + "\"";
-                }
-                else if constexpr (std::is_same_v<T, std::shared_ptr<bwxJSON>>) {
-                    if (arg) jsonText += arg->SerializePretty(indentLevel);
-                    else jsonText += "null";
+                char* end = std::to_chars(number, number + sizeof(number), arg).ptr;
+                out.append(number, end);
+                if (std::find_if(number, end, [](char c) { return c == '.' || c == 'e'; }) == end) out += ".0";
+            }
+            else if constexpr (std::is_same_v<T, bool>) out += arg ? "true" : "false";
+            else if constexpr (std::is_same_v<T, std::string>) {
+                out += '"';
+                out += arg;
+                out += '"';
+            }
+            else if constexpr (std::is_same_v<T, wxString>) {
+                const wxScopedCharBuffer utf8 = arg.utf8_str();
+                out += '"';
+                out.append(utf8.data(), utf8.length());
+                out += '"';
+            }
+            else if constexpr (std::is_same_v<T, std::shared_ptr<bwxJSON>>) {
+                if (arg) arg->WriteUtf8(out, indent, level);
+                else out += "null";
+            }
+            else { // std::vector<bwxJsonValueHelper>
+                if (arg.empty()) {
+                    out += "[]";
+                    return;
                 }
-                else if constexpr (std::is_same_v<T, std::vector<bwxJsonValueHelper>>) {
-                    jsonText += "[\n";
-                    currentIndent += indentLevel;
-                    for (size_t i = 0; i < arg.size(); ++i) {
-                        addIndent();
-                        serialize(arg[i].value, level + 1);
-                        if (i < arg.size() - 1) jsonText += ",";
-                        jsonText += "\n";
+                out += '[';
+                for (size_t i = 0; i < arg.size(); ++i) {
+                    if (i > 0) out += ',';
+                    if (indent > 0) {
+                        out += '\n';
+                        out.append(static_cast<size_t>(indent) * (level + 1), ' ');
                     }
-                    currentIndent -= indentLevel;
-                    addIndent();
-                    jsonText += "]";
+                    WriteValueUtf8(out, arg[i].value, indent, level + 1);
                 }
-                }, *value);
-            };
-
-        jsonText += "{\n";
-        currentIndent += indentLevel;
-        size_t count = m_data.size();
-        size_t index = 0;
-
-        for (const auto& [key, value] : m_data) {
-            addIndent();
-            jsonText += "\"" + key + "\": ";
-            serialize(value, 1);
-            if (index++ < count - 1) jsonText += ",";
-            jsonText += "\n";
-        }
-
-        currentIndent -= indentLevel;
-        addIndent();
-        jsonText += "}";
+                if (indent > 0) {
+                    out += '\n';
+                    out.append(static_cast<size_t>(indent) * level, ' ');
+                }
+                out += ']';
+            }
+            }, *value);
+    }
 
-        return jsonText;
+    wxString bwxJSON::SerializePretty(int indentLevel) const
+    {
+        std::string jsonText;
+        SerializeToUtf8(jsonText, std::max(indentLevel, 1));
+        return wxString::FromUTF8(jsonText.data(), jsonText.size());
     }
 
 	// As* functions
@@ -630,22 +837,45 @@ namespace bwx_sdk {
     // Iterators
     bwxJSON::iterator bwxJSON::begin()
     {
-        return m_data.begin();
+        return MutableData().begin();
     }
 
     bwxJSON::iterator bwxJSON::end()
     {
-        return m_data.end();
+        return MutableData().end();
     }
 
     bwxJSON::const_iterator bwxJSON::begin() const
     {
-        return m_data.begin();
+        return Data().begin();
     }
 
     bwxJSON::const_iterator bwxJSON::end() const
     {
-        return m_data.end();
+        return Data().end();
+    }
+
+    // Copy-on-write
+    const bwxJSON::bwxJsonMap& bwxJSON::Data() const
+    {
+        static const bwxJsonMap emptyData;
+        return m_data ? *m_data : emptyData;
+    }
+
+    bwxJSON::bwxJsonMap& bwxJSON::MutableData()
+    {
+        if (!m_data)
+            m_data = std::make_shared<bwxJsonMap>();
+        else if (m_data.use_count() > 1)
+            m_data = std::make_shared<bwxJsonMap>(*m_data); // Values copied, nested objects still shared
+        return *m_data;
+    }
+
+    bwxJSON& bwxJSON::MutableObject(std::shared_ptr<bwxJSON>& object)
+    {
+        if (object.use_count() > 1)
+            object = std::make_shared<bwxJSON>(*object); // O(1) - its map is detached on write
+        return *object;
     }
 
     //
@@ -660,7 +890,7 @@ namespace bwx_sdk {
     std::shared_ptr<bwxJSON> bwxJSON::Clone() const
     {
         auto copy = std::make_shared<bwxJSON>();
-		copy->m_data = m_data; // Copy whole map of values
+		copy->m_data = m_data; // Shared until either side is modified
         return copy;
     }
 
@@ -676,16 +906,24 @@ namespace bwx_sdk {
     //
     void bwxJSON::Merge(const bwxJSON& other, bool overwriteExisting)
     {
-        for (const auto& [key, value] : other.m_data)
+        // Merged values share subtrees with `other`; nested objects are copied only on the modified paths
+        if (other.Data().empty() || m_data == other.m_data)
+            return;
+
+        const std::shared_ptr<bwxJsonMap> source = other.m_data; // Kept alive if `other` is a child of this
+        bwxJsonMap& data = MutableData();
+        for (const auto& [key, value] : *source)
         {
-            if (!HasKey(key) || overwriteExisting)
+            auto it = data.find(key);
+            if (it == data.end() || overwriteExisting)
             {
-                m_data[key] = value;
+                data[key] = value;
             }
-            else if (std::holds_alternative<std::shared_ptr<bwxJSON>>(*m_data[key]) &&
+            else if (it->second.has_value() && value.has_value() &&
+                std::holds_alternative<std::shared_ptr<bwxJSON>>(*it->second) &&
                 std::holds_alternative<std::shared_ptr<bwxJSON>>(*value))
             {
-                std::get<std::shared_ptr<bwxJSON>>(*m_data[key])->Merge(*std::get<std::shared_ptr<bwxJSON>>(*value), overwriteExisting);
+                MutableObject(std::get<std::shared_ptr<bwxJSON>>(*it->second)).Merge(*std::get<std::shared_ptr<bwxJSON>>(*value), overwriteExisting);
             }
         }
     }
@@ -695,7 +933,7 @@ namespace bwx_sdk {
         bwxJSON diffResult;
 
         // Checking keys present in `this` but not in `other`
-        for (const auto& [key, value] : m_data)
+        for (const auto& [key, value] : Data())
         {
             if (!other.HasKey(key))
             {
@@ -708,7 +946,7 @@ namespace bwx_sdk {
         }
 
         // Checking keys present in `other` but not in `this`
-        for (const auto& [key, value] : other.m_data)
+        for (const auto& [key, value] : other.Data())
         {
             if (!HasKey(key))
             {
@@ -721,15 +959,20 @@ namespace bwx_sdk {
 
     void bwxJSON::Patch(const bwxJSON& patchData)
     {
-        for (const auto& [key, value] : patchData.m_data)
+        if (patchData.Data().empty())
+            return;
+
+        const std::shared_ptr<bwxJsonMap> source = patchData.m_data; // Kept alive if `patchData` is a child of this
+        bwxJsonMap& data = MutableData();
+        for (const auto& [key, value] : *source)
         {
             if (value.has_value())
             {
-				m_data[key] = value; // Update or add new value
+				data[key] = value; // Update or add new value (subtrees shared with the patch)
             }
             else
             {
-				m_data.erase(key); // Remove value
+				data.erase(key); // Remove value
             }
         }
     }
@@ -741,7 +984,7 @@ namespace bwx_sdk {
         std::function<void(const wxString&, const bwxJSON&, bwxJSON&)> flattenHelper =
             [&](const wxString& prefix, const bwxJSON& obj, bwxJSON& result)
             {
-                for (const auto& [key, value] : obj.m_data)
+                for (const auto& [key, value] : obj.Data())
                 {
                     wxString newKey = prefix.IsEmpty() ? key : prefix + separator + key;
 
@@ -764,7 +1007,7 @@ namespace bwx_sdk {
     {
         bwxJSON unflattenedJson;
 
-        for (const auto& [flatKey, value] : flatJson.m_data)
+        for (const auto& [flatKey, value] : flatJson.Data())
         {
             wxString key = flatKey;
             bwxJSON* current = &unflattenedJson;
@@ -774,13 +1017,15 @@ namespace bwx_sdk {
                 wxString parentKey = key.BeforeFirst(separator[0]);
                 wxString restKey = key.AfterFirst(separator[0]);
 
-                if (!current->HasKey(parentKey) || !current->GetValue(parentKey).has_value() ||
-                    !std::holds_alternative<std::shared_ptr<bwxJSON>>(*current->GetValue(parentKey)))
+                bwxJsonValue& parent = current->MutableData()[parentKey];
+                if (!parent.has_value() || !std::holds_alternative<std::shared_ptr<bwxJSON>>(*parent) ||
+                    !std::get<std::shared_ptr<bwxJSON>>(*parent))
                 {
-                    current->SetValue(parentKey, std::make_shared<bwxJSON>());
+                    parent = std::make_shared<bwxJSON>();
                 }
 
-                current = std::get<std::shared_ptr<bwxJSON>>(*current->GetValue(parentKey)).get();
+                // Objects taken from `flatJson` are copied before they are extended
+                current = &MutableObject(std::get<std::shared_ptr<bwxJSON>>(*parent));
                 key = restKey;
             }
 
@@ -797,7 +1042,7 @@ namespace bwx_sdk {
         std::function<void(const wxString&, const bwxJSON&, std::vector<wxString>&)> searchHelper =
             [&](const wxString& prefix, const bwxJSON& obj, std::vector<wxString>& results)
             {
-                for (const auto& [currentKey, value] : obj.m_data)
+                for (const auto& [currentKey, value] : obj.Data())
                 {
                     wxString newPath = prefix.IsEmpty() ? currentKey : prefix + "." + currentKey;
 
@@ -824,7 +1069,7 @@ namespace bwx_sdk {
         std::function<void(const wxString&, const bwxJSON&, std::vector<wxString>&)> searchHelper =
             [&](const wxString& prefix, const bwxJSON& obj, std::vector<wxString>& results)
             {
-                for (const auto& [currentKey, value] : obj.m_data)
+                for (const auto& [currentKey, value] : obj.Data())
                 {
                     wxString newPath = prefix.IsEmpty() ? currentKey : prefix + "." + currentKey;
 
@@ -848,7 +1093,7 @@ namespace bwx_sdk {
     {
         bwxJSON filteredJson;
 
-        for (const auto& [key, value] : m_data)
+        for (const auto& [key, value] : Data())
         {
             if (predicate(key, value))
             {
@@ -857,9 +1102,9 @@ namespace bwx_sdk {
             else if (value.has_value() && std::holds_alternative<std::shared_ptr<bwxJSON>>(*value))
             {
                 auto nested = std::get<std::shared_ptr<bwxJSON>>(*value)->Filter(predicate);
-                if (!nested.m_data.empty())
+                if (!nested.Data().empty())
                 {
-                    filteredJson.SetValue(key, std::make_shared<bwxJSON>(nested));
+                    filteredJson.SetValue(key, std::make_shared<bwxJSON>(std::move(nested)));
                 }
             }
         }
@@ -869,21 +1114,23 @@ namespace bwx_sdk {
 
     void bwxJSON::Transform(std::function<void(wxString&, bwxJsonValue&)> rule)
     {
-        std::unordered_map<wxString, bwxJsonValue> newData;
+        auto newData = std::make_shared<bwxJsonMap>();
 
-        for (auto& [key, value] : m_data)
+        for (const auto& [key, value] : Data())
         {
             wxString newKey = key;
             bwxJsonValue newValue = value;
 
             rule(newKey, newValue);
 
-            if (newValue.has_value() && std::holds_alternative<std::shared_ptr<bwxJSON>>(*newValue))
+            // Nested objects still shared with the old map (or snapshots) are copied first
+            if (newValue.has_value() && std::holds_alternative<std::shared_ptr<bwxJSON>>(*newValue) &&
+                std::get<std::shared_ptr<bwxJSON>>(*newValue))
             {
-                std::get<std::shared_ptr<bwxJSON>>(*newValue)->Transform(rule);
+                MutableObject(std::get<std::shared_ptr<bwxJSON>>(*newValue)).Transform(rule);
             }
 
-            newData[newKey] = newValue;
+            (*newData)[newKey] = std::move(newValue);
         }
 
         m_data = std::move(newData);
@@ -893,12 +1140,12 @@ namespace bwx_sdk {
     {
         bwxJSON mappedJson;
 
-        for (const auto& [key, value] : m_data)
+        for (const auto& [key, value] : Data())
         {
             if (value.has_value() && std::holds_alternative<std::shared_ptr<bwxJSON>>(*value))
             {
                 auto mappedNested = std::get<std::shared_ptr<bwxJSON>>(*value)->Map(transform);
-                mappedJson.SetValue(key, std::make_shared<bwxJSON>(mappedNested));
+                mappedJson.SetValue(key, std::make_shared<bwxJSON>(std::move(mappedNested)));
             }
             else
             {
@@ -0,0 +1,813 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_document.cpp
+// Purpose:     BWX_SDK Library; Compact arena-allocated JSON DOM
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_json_document.cpp
+ * @brief Implements bwxJsonDocument - 16-byte nodes in a monotonic arena, parsed from UTF-8.
+ */
+
+#include <wx/file.h>
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include <bwx_sdk/bwx_core/bwx_json_document.h>
+
+namespace bwx_sdk {
+
+	namespace {
+		constexpr int JSON_MAX_DEPTH = 512;                 // Nesting limit of recursive descent
+		constexpr uint32_t NO_KEY = std::numeric_limits<uint32_t>::max();
+
+		const bwxJsonNode s_nullNode;
+
+		inline bool IsJsonSpace(char c)
+		{
+			return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+		}
+
+		inline bool IsJsonNumberChar(char c)
+		{
+			return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+		}
+	}
+
+	// ========================================================================
+	// bwxJsonNode
+	// ========================================================================
+
+	bool bwxJsonNode::AsBool(bool defaultValue) const
+	{
+		switch (m_type)
+		{
+		case TYPE_BOOL: return m_value.b;
+		case TYPE_INT: return m_value.i != 0;
+		case TYPE_UINT: return m_value.u != 0;
+		case TYPE_DOUBLE: return m_value.d != 0.0;
+		default: return defaultValue;
+		}
+	}
+
+	int bwxJsonNode::AsInt(int defaultValue) const
+	{
+		return IsNumber() ? static_cast<int>(AsInt64()) : defaultValue;
+	}
+
+	int64_t bwxJsonNode::AsInt64(int64_t defaultValue) const
+	{
+		switch (m_type)
+		{
+		case TYPE_INT: return m_value.i;
+		case TYPE_UINT: return static_cast<int64_t>(m_value.u);
+		case TYPE_DOUBLE: return static_cast<int64_t>(m_value.d);
+		default: return defaultValue;
+		}
+	}
+
+	uint64_t bwxJsonNode::AsUInt64(uint64_t defaultValue) const
+	{
+		switch (m_type)
+		{
+		case TYPE_INT: return static_cast<uint64_t>(m_value.i);
+		case TYPE_UINT: return m_value.u;
+		case TYPE_DOUBLE: return static_cast<uint64_t>(m_value.d);
+		default: return defaultValue;
+		}
+	}
+
+	double bwxJsonNode::AsDouble(double defaultValue) const
+	{
+		switch (m_type)
+		{
+		case TYPE_INT: return static_cast<double>(m_value.i);
+		case TYPE_UINT: return static_cast<double>(m_value.u);
+		case TYPE_DOUBLE: return m_value.d;
+		default: return defaultValue;
+		}
+	}
+
+	std::string_view bwxJsonNode::AsString(std::string_view defaultValue) const
+	{
+		return m_type == TYPE_STRING ? std::string_view(m_value.str, m_size) : defaultValue;
+	}
+
+	wxString bwxJsonNode::AsWxString(const wxString& defaultValue) const
+	{
+		return m_type == TYPE_STRING ? wxString::FromUTF8(m_value.str, m_size) : defaultValue;
+	}
+
+	const bwxJsonNode& bwxJsonNode::operator[](size_t index) const
+	{
+		return (m_type == TYPE_ARRAY && index < m_size) ? m_value.items[index] : s_nullNode;
+	}
+
+	bwxJsonNode* bwxJsonNode::GetItem(size_t index)
+	{
+		return (m_type == TYPE_ARRAY && index < m_size) ? &m_value.items[index] : nullptr;
+	}
+
+	const bwxJsonMember* bwxJsonNode::GetMember(size_t index) const
+	{
+		return (m_type == TYPE_OBJECT && index < m_size) ? &m_value.members[index] : nullptr;
+	}
+
+	bwxJsonMember* bwxJsonNode::GetMember(size_t index)
+	{
+		return (m_type == TYPE_OBJECT && index < m_size) ? &m_value.members[index] : nullptr;
+	}
+
+	void bwxJsonNode::SetNull()
+	{
+		*this = bwxJsonNode();
+	}
+
+	void bwxJsonNode::SetBool(bool value)
+	{
+		*this = bwxJsonNode();
+		m_type = TYPE_BOOL;
+		m_value.b = value;
+	}
+
+	void bwxJsonNode::SetInt(int64_t value)
+	{
+		*this = bwxJsonNode();
+		m_type = TYPE_INT;
+		m_value.i = value;
+	}
+
+	void bwxJsonNode::SetUInt(uint64_t value)
+	{
+		*this = bwxJsonNode();
+		m_type = TYPE_UINT;
+		m_value.u = value;
+	}
+
+	void bwxJsonNode::SetDouble(double value)
+	{
+		*this = bwxJsonNode();
+		m_type = TYPE_DOUBLE;
+		m_value.d = value;
+	}
+
+	// ========================================================================
+	// bwxJsonDocument - lifetime, arena, keys
+	// ========================================================================
+
+	/// Parser position plus scratch stacks - items and members of open containers
+	/// are collected here and copied to the arena once their count is known
+	struct bwxJsonDocument::ParseState
+	{
+		std::string_view text;
+		size_t pos = 0;
+		size_t base = 0;                    // Added to positions in error messages
+		std::vector<bwxJsonNode> items;
+		std::vector<bwxJsonMember> members;
+		wxString error;
+
+		bool Fail(const char* message)
+		{
+			if (error.IsEmpty())
+				error = wxString::Format(wxT("Parse JSON error at %zu: %s"), base + pos, message);
+			return false;
+		}
+
+		void SkipWhitespace()
+		{
+			const size_t size = text.size();
+			while (pos < size)
+			{
+				const char c = text[pos];
+				if (IsJsonSpace(c))
+				{
+					pos++;
+					continue;
+				}
+
+				// Comments // and /* ... */ (accepted like bwxJSON does)
+				if (c == '/' && pos + 1 < size && text[pos + 1] == '/')
+				{
+					const size_t end = text.find('\n', pos + 2);
+					pos = end == std::string_view::npos ? size : end;
+					continue;
+				}
+				if (c == '/' && pos + 1 < size && text[pos + 1] == '*')
+				{
+					const size_t end = text.find("*/", pos + 2);
+					pos = end == std::string_view::npos ? size : end + 2;
+					continue;
+				}
+
+				break;
+			}
+		}
+	};
+
+	bwxJsonDocument::bwxJsonDocument() = default;
+
+	bwxJsonDocument::~bwxJsonDocument() = default;
+
+	void bwxJsonDocument::Clear()
+	{
+		m_root = bwxJsonNode();
+		m_keys.clear();
+		m_keyIds.clear();
+		m_blocks.clear();
+		m_blockStart = m_blockPos = m_blockEnd = nullptr;
+		m_arenaSize = 0;
+		m_source.clear();
+		m_lastError.Clear();
+	}
+
+	void bwxJsonDocument::Reset()
+	{
+		// The current block is the largest regular one - the next parse starts in it
+		std::unique_ptr<char[]> kept;
+		for (auto& block : m_blocks)
+		{
+			if (block.get() == m_blockStart)
+			{
+				kept = std::move(block);
+				break;
+			}
+		}
+		const size_t keptSize = kept ? static_cast<size_t>(m_blockEnd - m_blockStart) : 0;
+
+		Clear();
+		if (kept)
+		{
+			m_blockStart = m_blockPos = kept.get();
+			m_blockEnd = m_blockStart + keptSize;
+			m_arenaSize = keptSize;
+			m_blocks.push_back(std::move(kept));
+		}
+	}
+
+	void* bwxJsonDocument::Allocate(size_t size, size_t alignment)
+	{
+		auto align = [alignment](char* pointer) {
+			const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+			return reinterpret_cast<char*>((address + alignment - 1) & ~(uintptr_t(alignment) - 1));
+		};
+
+		if (m_blockPos)
+		{
+			char* result = align(m_blockPos);
+			if (result + size <= m_blockEnd)
+			{
+				m_blockPos = result + size;
+				return result;
+			}
+		}
+
+		// Blocks grow with the document (64 KB up to 2 MB), so big files need few of them
+		const size_t blockSize = ARENA_BLOCK_SIZE << std::min<size_t>(m_blocks.size(), 5);
+		const size_t needed = size + alignment;
+		m_blocks.emplace_back(new char[std::max(blockSize, needed)]);
+		m_arenaSize += std::max(blockSize, needed);
+
+		char* start = m_blocks.back().get();
+		char* result = align(start);
+
+		// Oversized request gets a block of its own - current block stays in use
+		if (needed > blockSize)
+			return result;
+
+		m_blockStart = start;
+		m_blockPos = result + size;
+		m_blockEnd = start + blockSize;
+		return result;
+	}
+
+	uint32_t bwxJsonDocument::FindKey(std::string_view key) const
+	{
+		auto it = m_keyIds.find(key);
+		return it != m_keyIds.end() ? it->second : NO_KEY;
+	}
+
+	uint32_t bwxJsonDocument::InternKey(std::string_view key, bool copy)
+	{
+		auto it = m_keyIds.find(key);
+		if (it != m_keyIds.end()) return it->second;
+
+		// Keys from the source are viewed in place, keys added later live in the arena
+		if (copy && !key.empty())
+		{
+			char* text = AllocateArray<char>(key.size());
+			std::memcpy(text, key.data(), key.size());
+			key = std::string_view(text, key.size());
+		}
+
+		const uint32_t id = static_cast<uint32_t>(m_keys.size());
+		m_keys.push_back(key);
+		m_keyIds.emplace(key, id);
+		return id;
+	}
+
+	void bwxJsonDocument::Reserve(bwxJsonNode& node, uint32_t needed)
+	{
+		const uint32_t capacity = node.m_capacityShift ? (1u << (node.m_capacityShift - 1)) : node.m_size;
+		if (needed <= capacity) return;
+
+		// Old block stays in the arena (monotonic)
+		const uint32_t newCapacity = std::bit_ceil(std::max<uint32_t>(needed, 4));
+		if (node.m_type == bwxJsonNode::TYPE_ARRAY)
+		{
+			bwxJsonNode* items = AllocateArray<bwxJsonNode>(newCapacity);
+			std::uninitialized_copy_n(node.m_value.items, node.m_size, items);
+			node.m_value.items = items;
+		}
+		else
+		{
+			bwxJsonMember* members = AllocateArray<bwxJsonMember>(newCapacity);
+			std::uninitialized_copy_n(node.m_value.members, node.m_size, members);
+			node.m_value.members = members;
+		}
+		node.m_capacityShift = static_cast<uint8_t>(std::countr_zero(newCapacity) + 1);
+	}
+
+	// ========================================================================
+	// bwxJsonDocument - access and modification
+	// ========================================================================
+
+	const bwxJsonNode* bwxJsonDocument::Find(const bwxJsonNode& object, std::string_view key) const
+	{
+		if (!object.IsObject()) return nullptr;
+
+		const uint32_t id = FindKey(key);
+		if (id == NO_KEY) return nullptr;
+
+		for (uint32_t i = 0; i < object.m_size; ++i)
+		{
+			if (object.m_value.members[i].key == id) return &object.m_value.members[i].value;
+		}
+		return nullptr;
+	}
+
+	bwxJsonNode* bwxJsonDocument::Find(bwxJsonNode& object, std::string_view key)
+	{
+		return const_cast<bwxJsonNode*>(static_cast<const bwxJsonDocument*>(this)->Find(static_cast<const bwxJsonNode&>(object), key));
+	}
+
+	void bwxJsonDocument::SetString(bwxJsonNode& node, std::string_view text)
+	{
+		char* copy = text.empty() ? nullptr : AllocateArray<char>(text.size());
+		if (copy) std::memcpy(copy, text.data(), text.size());
+
+		node = bwxJsonNode();
+		node.m_type = bwxJsonNode::TYPE_STRING;
+		node.m_size = static_cast<uint32_t>(text.size());
+		node.m_value.str = copy;
+	}
+
+	void bwxJsonDocument::SetArray(bwxJsonNode& node, uint32_t capacity)
+	{
+		node = bwxJsonNode();
+		node.m_type = bwxJsonNode::TYPE_ARRAY;
+		node.m_value.items = nullptr;
+		if (capacity > 0) Reserve(node, capacity);
+	}
+
+	void bwxJsonDocument::SetObject(bwxJsonNode& node, uint32_t capacity)
+	{
+		node = bwxJsonNode();
+		node.m_type = bwxJsonNode::TYPE_OBJECT;
+		node.m_value.members = nullptr;
+		if (capacity > 0) Reserve(node, capacity);
+	}
+
+	bwxJsonNode& bwxJsonDocument::Append(bwxJsonNode& array)
+	{
+		if (!array.IsArray()) SetArray(array);
+
+		Reserve(array, array.m_size + 1);
+		bwxJsonNode* item = new (&array.m_value.items[array.m_size]) bwxJsonNode();
+		array.m_size++;
+		return *item;
+	}
+
+	bwxJsonNode& bwxJsonDocument::SetMember(bwxJsonNode& object, std::string_view key)
+	{
+		if (!object.IsObject()) SetObject(object);
+
+		if (bwxJsonNode* existing = Find(object, key)) return *existing;
+
+		const uint32_t id = InternKey(key, true);
+		Reserve(object, object.m_size + 1);
+		bwxJsonMember* member = new (&object.m_value.members[object.m_size]) bwxJsonMember{ id, bwxJsonNode() };
+		object.m_size++;
+		return member->value;
+	}
+
+	// ========================================================================
+	// bwxJsonDocument - parsing
+	// ========================================================================
+
+	bool bwxJsonDocument::Parse(std::string jsonText)
+	{
+		Clear();
+		m_source = std::move(jsonText);
+
+		ParseState state;
+		state.text = m_source;
+
+		// UTF-8 BOM
+		if (state.text.size() >= 3 && std::memcmp(state.text.data(), "\xEF\xBB\xBF", 3) == 0) state.pos = 3;
+
+		if (!ParseValue(state, m_root, 0))
+		{
+			m_lastError = state.error;
+			m_root = bwxJsonNode();
+			return false;
+		}
+		return true;
+	}
+
+	size_t bwxJsonDocument::ParseLines(std::string_view text, size_t baseOffset, std::vector<size_t>* recordOffsets)
+	{
+		Reset();
+		m_source.assign(text.data(), text.size());
+		if (recordOffsets) recordOffsets->clear();
+
+		ParseState state;
+		state.base = baseOffset;
+
+		// UTF-8 BOM
+		size_t lineStart = 0;
+		if (m_source.size() >= 3 && std::memcmp(m_source.data(), "\xEF\xBB\xBF", 3) == 0) lineStart = 3;
+
+		// Records are collected at the bottom of the item stack; each line is parsed with the
+		// text cut at its end, so a record cannot run into the next line
+		size_t invalid = 0;
+		while (lineStart < m_source.size())
+		{
+			const size_t newline = m_source.find('\n', lineStart);
+			const size_t lineEnd = newline == std::string::npos ? m_source.size() : newline;
+			state.text = std::string_view(m_source.data(), lineEnd);
+			state.pos = lineStart;
+			lineStart = lineEnd + 1;
+
+			state.SkipWhitespace();
+			if (state.pos >= lineEnd) continue;
+
+			const size_t recordStart = state.pos;
+			const size_t recordCount = state.items.size();
+			bwxJsonNode record;
+			bool valid = ParseValue(state, record, 0);
+			if (valid)
+			{
+				state.SkipWhitespace();
+				if (state.pos < lineEnd) valid = state.Fail("unexpected data after the record");
+			}
+			if (!valid)
+			{
+				state.items.resize(recordCount);
+				state.members.clear();
+				invalid++;
+				continue;
+			}
+
+			state.items.push_back(record);
+			if (recordOffsets) recordOffsets->push_back(baseOffset + recordStart);
+		}
+
+		const size_t count = std::min<size_t>(state.items.size(), std::numeric_limits<uint32_t>::max());
+		m_root.m_type = bwxJsonNode::TYPE_ARRAY;
+		m_root.m_size = static_cast<uint32_t>(count);
+		m_root.m_value.items = count ? AllocateArray<bwxJsonNode>(count) : nullptr;
+		std::uninitialized_copy_n(state.items.begin(), count, m_root.m_value.items);
+
+		m_lastError = state.error;
+		return invalid;
+	}
+
+	bool bwxJsonDocument::LoadFromFile(const wxString& filename)
+	{
+		wxFile file;
+		if (!file.Open(filename)) return false;
+
+		const wxFileOffset length = file.Length();
+		if (length < 0) return false;
+
+		std::string jsonText(static_cast<size_t>(length), '\0');
+		if (length > 0 && file.Read(jsonText.data(), jsonText.size()) != static_cast<ssize_t>(jsonText.size())) return false;
+
+		return Parse(std::move(jsonText));
+	}
+
+	bool bwxJsonDocument::ParseValue(ParseState& state, bwxJsonNode& node, int depth)
+	{
+		state.SkipWhitespace();
+		if (state.pos >= state.text.size()) return state.Fail("unexpected end of JSON");
+
+		const char c = state.text[state.pos];
+		switch (c)
+		{
+		case '"':
+		{
+			std::string_view text;
+			if (!ParseString(state, text)) return false;
+			node.m_type = bwxJsonNode::TYPE_STRING;
+			node.m_size = static_cast<uint32_t>(text.size());
+			node.m_value.str = text.data();
+			return true;
+		}
+		case '{': return ParseObject(state, node, depth + 1);
+		case '[': return ParseArray(state, node, depth + 1);
+		case 't':
+		case 'f':
+		case 'n':
+		{
+			const std::string_view word = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+			if (state.text.compare(state.pos, word.size(), word) != 0) return state.Fail("unknown literal");
+			state.pos += word.size();
+			if (c == 'n') node.SetNull();
+			else node.SetBool(c == 't');
+			return true;
+		}
+		default:
+			if (c == '-' || (c >= '0' && c <= '9')) return ParseNumber(state, node);
+			return state.Fail("unexpected character");
+		}
+	}
+
+	bool bwxJsonDocument::ParseString(ParseState& state, std::string_view& text)
+	{
+		// Closing quote is the first one not escaped by an odd run of backslashes;
+		// memchr jumps over string content (vectorized by the C library)
+		const std::string_view& source = state.text;
+		const size_t start = ++state.pos;
+		while (state.pos < source.size())
+		{
+			const void* quote = std::memchr(source.data() + state.pos, '"', source.size() - state.pos);
+			if (!quote) break;
+
+			const size_t end = static_cast<const char*>(quote) - source.data();
+			size_t backslashes = 0;
+			while (end - backslashes > start && source[end - backslashes - 1] == '\\') backslashes++;
+
+			state.pos = end + 1;
+			if (backslashes % 2 == 0)
+			{
+				if (end - start > std::numeric_limits<uint32_t>::max()) return state.Fail("string too long");
+				text = source.substr(start, end - start);
+				return true;
+			}
+		}
+
+		state.pos = source.size();
+		return state.Fail("missing closing `\"`");
+	}
+
+	bool bwxJsonDocument::ParseNumber(ParseState& state, bwxJsonNode& node)
+	{
+		const size_t start = state.pos;
+		bool isDouble = false;
+		while (state.pos < state.text.size() && IsJsonNumberChar(state.text[state.pos]))
+		{
+			const char c = state.text[state.pos];
+			isDouble = isDouble || c == '.' || c == 'e' || c == 'E';
+			state.pos++;
+		}
+
+		const char* first = state.text.data() + start;
+		const char* last = state.text.data() + state.pos;
+
+		// Integers as int64, uint64 above its range, double beyond that
+		if (!isDouble)
+		{
+			int64_t number = 0;
+			auto result = std::from_chars(first, last, number);
+			if (result.ec == std::errc() && result.ptr == last)
+			{
+				node.SetInt(number);
+				return true;
+			}
+
+			uint64_t unsignedNumber = 0;
+			result = std::from_chars(first, last, unsignedNumber);
+			if (result.ec == std::errc() && result.ptr == last)
+			{
+				node.SetUInt(unsignedNumber);
+				return true;
+			}
+		}
+
+		double number = 0.0;
+		auto result = std::from_chars(first, last, number);
+		if (result.ec != std::errc() || result.ptr != last)
+		{
+			state.pos = start;
+			return state.Fail("invalid number");
+		}
+
+		node.SetDouble(number);
+		return true;
+	}
+
+	bool bwxJsonDocument::ParseArray(ParseState& state, bwxJsonNode& node, int depth)
+	{
+		if (depth > JSON_MAX_DEPTH) return state.Fail("nesting too deep");
+
+		const size_t base = state.items.size();
+		state.pos++;
+
+		for (;;)
+		{
+			state.SkipWhitespace();
+			if (state.pos >= state.text.size()) return state.Fail("unexpected end of JSON - missing closing `]`");
+			if (state.text[state.pos] == ']') break;
+
+			// Parsed into a local - nested containers push onto the same stack
+			bwxJsonNode item;
+			if (!ParseValue(state, item, depth)) return false;
+			state.items.push_back(item);
+
+			state.SkipWhitespace();
+			if (state.pos < state.text.size() && state.text[state.pos] == ',') state.pos++;
+		}
+		state.pos++;
+
+		const size_t count = state.items.size() - base;
+		if (count > std::numeric_limits<uint32_t>::max()) return state.Fail("array too large");
+
+		node = bwxJsonNode();
+		node.m_type = bwxJsonNode::TYPE_ARRAY;
+		node.m_size = static_cast<uint32_t>(count);
+		node.m_value.items = count ? AllocateArray<bwxJsonNode>(count) : nullptr;
+		std::uninitialized_copy(state.items.begin() + base, state.items.end(), node.m_value.items);
+		state.items.resize(base);
+		return true;
+	}
+
+	bool bwxJsonDocument::ParseObject(ParseState& state, bwxJsonNode& node, int depth)
+	{
+		if (depth > JSON_MAX_DEPTH) return state.Fail("nesting too deep");
+
+		const size_t base = state.members.size();
+		state.pos++;
+
+		for (;;)
+		{
+			state.SkipWhitespace();
+			if (state.pos >= state.text.size()) return state.Fail("unexpected end of JSON - missing closing `}`");
+			if (state.text[state.pos] == '}') break;
+			if (state.text[state.pos] != '"') return state.Fail("expected string key");
+
+			std::string_view key;
+			if (!ParseString(state, key)) return false;
+
+			state.SkipWhitespace();
+			if (state.pos >= state.text.size() || state.text[state.pos] != ':') return state.Fail("expected `:` after key");
+			state.pos++;
+
+			// Duplicate keys are kept - Find() returns the first one
+			bwxJsonMember member{ InternKey(key, false), bwxJsonNode() };
+			if (!ParseValue(state, member.value, depth)) return false;
+			state.members.push_back(member);
+
+			state.SkipWhitespace();
+			if (state.pos < state.text.size() && state.text[state.pos] == ',') state.pos++;
+		}
+		state.pos++;
+
+		const size_t count = state.members.size() - base;
+		if (count > std::numeric_limits<uint32_t>::max()) return state.Fail("object too large");
+
+		node = bwxJsonNode();
+		node.m_type = bwxJsonNode::TYPE_OBJECT;
+		node.m_size = static_cast<uint32_t>(count);
+		node.m_value.members = count ? AllocateArray<bwxJsonMember>(count) : nullptr;
+		std::uninitialized_copy(state.members.begin() + base, state.members.end(), node.m_value.members);
+		state.members.resize(base);
+		return true;
+	}
+
+	// ========================================================================
+	// bwxJsonDocument - output
+	// ========================================================================
+
+	std::string bwxJsonDocument::SerializeToUtf8() const
+	{
+		std::string out;
+		out.reserve(m_source.size());
+		SerializeNode(m_root, out);
+		return out;
+	}
+
+	bool bwxJsonDocument::SaveToFile(const wxString& filename) const
+	{
+		wxFile file;
+		if (!file.Open(filename, wxFile::write)) return false;
+
+		const std::string jsonText = SerializeToUtf8();
+		return file.Write(jsonText.data(), jsonText.size()) == jsonText.size();
+	}
+
+	void bwxJsonDocument::SerializeNode(const bwxJsonNode& node, std::string& out) const
+	{
+		char number[32];
+		switch (node.m_type)
+		{
+		case bwxJsonNode::TYPE_NULL: out += "null"; break;
+		case bwxJsonNode::TYPE_BOOL: out += node.m_value.b ? "true" : "false"; break;
+		case bwxJsonNode::TYPE_INT: out.append(number, std::to_chars(number, number + sizeof(number), node.m_value.i).ptr); break;
+		case bwxJsonNode::TYPE_UINT: out.append(number, std::to_chars(number, number + sizeof(number), node.m_value.u).ptr); break;
+		case bwxJsonNode::TYPE_DOUBLE:
+		{
+			// Shortest round-trip form, kept recognizable as a double when re-parsed
+			char* end = std::to_chars(number, number + sizeof(number), node.m_value.d).ptr;
+			out.append(number, end);
+			if (std::find_if(number, end, [](char c) { return c == '.' || c == 'e' || c == 'n'; }) == end) out += ".0";
+			break;
+		}
+		case bwxJsonNode::TYPE_STRING:
+			// Raw contents - escapes were kept when parsing
+			out += '"';
+			out.append(node.m_value.str, node.m_size);
+			out += '"';
+			break;
+		case bwxJsonNode::TYPE_ARRAY:
+			out += '[';
+			for (uint32_t i = 0; i < node.m_size; ++i)
+			{
+				if (i > 0) out += ',';
+				SerializeNode(node.m_value.items[i], out);
+			}
+			out += ']';
+			break;
+		case bwxJsonNode::TYPE_OBJECT:
+			out += '{';
+			for (uint32_t i = 0; i < node.m_size; ++i)
+			{
+				if (i > 0) out += ',';
+				out += '"';
+				out += m_keys[node.m_value.members[i].key];
+				out += "\":";
+				SerializeNode(node.m_value.members[i].value, out);
+			}
+			out += '}';
+			break;
+		}
+	}
+
+	bwxJSON bwxJsonDocument::ToJSON() const
+	{
+		bwxJSON json;
+		if (!m_root.IsObject()) return json;
+
+		for (uint32_t i = 0; i < m_root.m_size; ++i)
+		{
+			const bwxJsonMember& member = m_root.m_value.members[i];
+			const std::string_view key = m_keys[member.key];
+			json[wxString::FromUTF8(key.data(), key.size())] = ToJsonValue(member.value);
+		}
+		return json;
+	}
+
+	bwxJsonValue bwxJsonDocument::ToJsonValue(const bwxJsonNode& node) const
+	{
+		// Same value types as bwxJSON::ParseFromUtf8() produces
+		switch (node.m_type)
+		{
+		case bwxJsonNode::TYPE_BOOL: return bwxJsonValue(node.m_value.b);
+		case bwxJsonNode::TYPE_INT:
+			if (node.m_value.i >= std::numeric_limits<int>::min() && node.m_value.i <= std::numeric_limits<int>::max())
+				return bwxJsonValue(static_cast<int>(node.m_value.i));
+			return bwxJsonValue(node.m_value.i);
+		case bwxJsonNode::TYPE_UINT: return bwxJsonValue(node.m_value.u);
+		case bwxJsonNode::TYPE_DOUBLE: return bwxJsonValue(node.m_value.d);
+		case bwxJsonNode::TYPE_STRING: return bwxJsonValue(wxString::FromUTF8(node.m_value.str, node.m_size));
+		case bwxJsonNode::TYPE_ARRAY:
+		{
+			std::vector<bwxJsonValueHelper> array;
+			array.reserve(node.m_size);
+			for (uint32_t i = 0; i < node.m_size; ++i) array.push_back(bwxJsonValueHelper{ ToJsonValue(node.m_value.items[i]) });
+			return bwxJsonValue(std::move(array));
+		}
+		case bwxJsonNode::TYPE_OBJECT:
+		{
+			auto object = std::make_shared<bwxJSON>();
+			for (uint32_t i = 0; i < node.m_size; ++i)
+			{
+				const bwxJsonMember& member = node.m_value.members[i];
+				const std::string_view key = m_keys[member.key];
+				(*object)[wxString::FromUTF8(key.data(), key.size())] = ToJsonValue(member.value);
+			}
+			return bwxJsonValue(std::move(object));
+		}
+		default: return bwxJsonValue();
+		}
+	}
+
+}  // namespace bwx_sdk
@@ -0,0 +1,607 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_lazy.cpp
+// Purpose:     BWX_SDK Library; Lazy (index-first) JSON reader
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <bwx_sdk/bwx_core/bwx_json_lazy.h>
+
+#include <wx/file.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        // Nesting limit (same as the bwxJSON parser)
+        constexpr size_t JSON_MAX_DEPTH = 512;
+
+        inline bool IsJsonSpace(char c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+        }
+
+        inline bool IsScalarEnd(char c)
+        {
+            return IsJsonSpace(c) || c == ',' || c == ':' || c == ']' || c == '}' || c == '/';
+        }
+
+        /// Numeric/boolean conversion with the rules of bwxJSON::As*()
+        template <typename T>
+        T ConvertValue(const bwxJsonValue& value, T defaultValue)
+        {
+            if (!value.has_value()) return defaultValue;
+
+            return std::visit([defaultValue](auto&& arg) -> T {
+                using V = std::decay_t<decltype(arg)>;
+                if constexpr (std::is_same_v<V, bool>) {
+                    if constexpr (std::is_same_v<T, bool>) return arg;
+                    else return defaultValue;
+                }
+                else if constexpr (std::is_arithmetic_v<V>) return static_cast<T>(arg);
+                else return defaultValue;
+                }, *value);
+        }
+
+    }
+
+    bool bwxJsonLazy::Parse(std::string jsonText)
+    {
+        Clear();
+        m_text = std::move(jsonText);
+        return BuildTape();
+    }
+
+    bool bwxJsonLazy::LoadFromFile(const wxString& filename)
+    {
+        wxFile file;
+        if (!file.Open(filename))
+            return false;
+
+        wxFileOffset length = file.Length();
+        if (length < 0)
+            return false;
+
+        std::string jsonText(static_cast<size_t>(length), '\0');
+        if (length > 0 && file.Read(jsonText.data(), jsonText.size()) != static_cast<ssize_t>(jsonText.size()))
+            return false;
+
+        return Parse(std::move(jsonText));
+    }
+
+    void bwxJsonLazy::Clear()
+    {
+        m_text.clear();
+        m_tape.clear();
+        m_decoded.clear();
+        m_lastError.Clear();
+    }
+
+    bool bwxJsonLazy::Fail(size_t offset, const char* message)
+    {
+        m_lastError = wxString::Format(wxT("Parse JSON error at %zu: %s"), offset, message);
+        m_tape.clear();
+        return false;
+    }
+
+    bool bwxJsonLazy::BuildTape()
+    {
+        const char* data = m_text.data();
+        const size_t size = m_text.size();
+        if (size >= std::numeric_limits<uint32_t>::max())
+            return Fail(0, "document too large");
+
+        size_t pos = 0;
+
+        // UTF-8 BOM
+        if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+            pos = 3;
+
+        struct Open
+        {
+            uint32_t tape;
+            uint32_t children;
+            bool object;
+        };
+        std::vector<Open> stack;
+        bool rootDone = false;
+
+        // Rough guess of one token per 16 bytes - saves most regrowth of the tape
+        m_tape.reserve(size / 16);
+
+        // Only structure is checked here: brackets, string ends, keys in objects;
+        // scalars are validated when decoded
+        auto addChild = [&](char c) {
+            if (stack.empty())
+            {
+                if (rootDone) return Fail(pos, "unexpected data after root object");
+                if (c != '{') return Fail(pos, "wrong structure");
+                return true;
+            }
+
+            Open& open = stack.back();
+            if (open.object && open.children % 2 == 0 && c != '"')
+                return Fail(pos, "expected string key");
+            open.children++;
+            return true;
+        };
+
+        while (pos < size)
+        {
+            const char c = data[pos];
+            switch (c)
+            {
+            case ',':
+            case ':':
+                pos++;
+                break;
+            case '{':
+            case '[':
+                if (!addChild(c))
+                    return false;
+                if (stack.size() >= JSON_MAX_DEPTH)
+                    return Fail(pos, "nesting too deep");
+                stack.push_back({ static_cast<uint32_t>(m_tape.size()), 0, c == '{' });
+                m_tape.push_back({ static_cast<uint32_t>(pos), 0 });
+                pos++;
+                break;
+            case '}':
+            case ']':
+            {
+                if (stack.empty() || stack.back().object != (c == '}'))
+                    return Fail(pos, c == '}' ? "unexpected `}`" : "unexpected `]`");
+
+                const Open open = stack.back();
+                if (open.object && open.children % 2 != 0)
+                    return Fail(pos, "expected value after key");
+                stack.pop_back();
+
+                m_tape[open.tape].end = static_cast<uint32_t>(m_tape.size());
+                m_tape.push_back({ static_cast<uint32_t>(pos), open.tape });
+                pos++;
+                rootDone = stack.empty();
+                break;
+            }
+            case '"':
+            {
+                if (!addChild(c))
+                    return false;
+
+                // Closing quote is the first one not escaped by an odd run of backslashes
+                const size_t start = pos;
+                size_t end = std::string_view::npos;
+                size_t search = pos + 1;
+                while (search < size)
+                {
+                    const void* quote = std::memchr(data + search, '"', size - search);
+                    if (!quote)
+                        break;
+
+                    const size_t candidate = static_cast<const char*>(quote) - data;
+                    size_t backslashes = 0;
+                    while (candidate - backslashes > start + 1 && data[candidate - backslashes - 1] == '\\')
+                        backslashes++;
+
+                    search = candidate + 1;
+                    if (backslashes % 2 == 0)
+                    {
+                        end = candidate + 1;
+                        break;
+                    }
+                }
+                if (end == std::string_view::npos)
+                    return Fail(start, "missing closing `\"`");
+
+                m_tape.push_back({ static_cast<uint32_t>(start), static_cast<uint32_t>(end) });
+                pos = end;
+                break;
+            }
+            case '/':
+            {
+                // Comments // and /* ... */ (accepted like bwxJSON does)
+                if (pos + 1 < size && data[pos + 1] == '/')
+                {
+                    const void* newline = std::memchr(data + pos, '\n', size - pos);
+                    pos = newline ? static_cast<const char*>(newline) - data : size;
+                }
+                else if (pos + 1 < size && data[pos + 1] == '*')
+                {
+                    const size_t end = m_text.find("*/", pos + 2);
+                    if (end == std::string::npos)
+                        return Fail(pos, "unterminated comment");
+                    pos = end + 2;
+                }
+                else
+                {
+                    return Fail(pos, "unexpected character");
+                }
+                break;
+            }
+            default:
+                if (IsJsonSpace(c))
+                {
+                    pos++;
+                    break;
+                }
+                if (c != '-' && (c < '0' || c > '9') && c != 't' && c != 'f' && c != 'n')
+                    return Fail(pos, "unexpected character");
+                if (!addChild(c))
+                    return false;
+
+                const size_t start = pos;
+                while (pos < size && !IsScalarEnd(data[pos]))
+                    pos++;
+                m_tape.push_back({ static_cast<uint32_t>(start), static_cast<uint32_t>(pos) });
+                break;
+            }
+        }
+
+        if (!stack.empty())
+            return Fail(size, stack.back().object ? "unexpected end of JSON - missing closing `}`" : "unexpected end of JSON - missing closing `]`");
+        if (!rootDone)
+            return Fail(size, "wrong structure");
+        return true;
+    }
+
+    std::string_view bwxJsonLazy::RawString(size_t index) const
+    {
+        const Entry& entry = m_tape[index];
+        return std::string_view(m_text.data() + entry.begin + 1, entry.end - entry.begin - 2);
+    }
+
+    size_t bwxJsonLazy::FindMember(size_t object, std::string_view key) const
+    {
+        const size_t end = m_tape[object].end;
+        for (size_t i = object + 1; i < end;)
+        {
+            const size_t value = i + 1;
+            if (RawString(i) == key)
+                return value;
+            i = Next(value);
+        }
+        return NPOS;
+    }
+
+    size_t bwxJsonLazy::FindPath(const wxString& path) const
+    {
+        if (m_tape.empty())
+            return NPOS;
+
+        const wxScopedCharBuffer utf8 = path.utf8_str();
+        const std::string_view fullPath(utf8.data(), utf8.length());
+
+        // Root key as a whole first (keys may contain the separator)
+        size_t index = FindMember(0, fullPath);
+        if (index != NPOS || m_separator.IsEmpty())
+            return index;
+
+        const wxScopedCharBuffer separatorUtf8 = m_separator.utf8_str();
+        const std::string_view separator(separatorUtf8.data(), separatorUtf8.length());
+
+        index = 0;
+        size_t start = 0;
+        for (;;)
+        {
+            const size_t split = fullPath.find(separator, start);
+            const std::string_view part = fullPath.substr(start, split == std::string_view::npos ? std::string_view::npos : split - start);
+
+            const char c = m_text[m_tape[index].begin];
+            if (c == '{')
+            {
+                index = FindMember(index, part);
+            }
+            else if (c == '[')
+            {
+                size_t item = 0;
+                auto result = std::from_chars(part.data(), part.data() + part.size(), item);
+                if (result.ec != std::errc() || result.ptr != part.data() + part.size())
+                    return NPOS;
+
+                const size_t end = m_tape[index].end;
+                size_t i = index + 1;
+                for (; item > 0 && i < end; --item)
+                    i = Next(i);
+                index = i < end ? i : NPOS;
+            }
+            else
+            {
+                return NPOS;
+            }
+
+            if (index == NPOS || split == std::string_view::npos)
+                return index;
+            start = split + separator.size();
+        }
+    }
+
+    bwxJsonValue bwxJsonLazy::Decode(size_t index) const
+    {
+        const Entry& entry = m_tape[index];
+        const char* first = m_text.data() + entry.begin;
+
+        switch (*first)
+        {
+        case '"':
+        {
+            const std::string_view text = RawString(index);
+            return bwxJsonValue(wxString::FromUTF8(text.data(), text.size()));
+        }
+        case '{':
+        {
+            auto jsonObject = std::make_shared<bwxJSON>();
+            for (size_t i = index + 1; i < entry.end;)
+            {
+                const std::string_view key = RawString(i);
+                (*jsonObject)[wxString::FromUTF8(key.data(), key.size())] = Decode(i + 1);
+                i = Next(i + 1);
+            }
+            return bwxJsonValue(std::move(jsonObject));
+        }
+        case '[':
+        {
+            std::vector<bwxJsonValueHelper> jsonArray;
+            for (size_t i = index + 1; i < entry.end; i = Next(i))
+                jsonArray.push_back(bwxJsonValueHelper{ Decode(i) });
+            return bwxJsonValue(std::move(jsonArray));
+        }
+        default:
+            break;
+        }
+
+        const std::string_view scalar(first, entry.end - entry.begin);
+        if (scalar == "true") return bwxJsonValue(true);
+        if (scalar == "false") return bwxJsonValue(false);
+        if (scalar == "null") return bwxJsonValue();
+
+        // Numbers as bwxJSON parses them: int, int64_t, uint64_t, double beyond that
+        const char* last = first + scalar.size();
+        if (scalar.find_first_of(".eE") == std::string_view::npos)
+        {
+            int64_t number = 0;
+            auto result = std::from_chars(first, last, number);
+            if (result.ec == std::errc() && result.ptr == last)
+            {
+                if (number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max())
+                    return bwxJsonValue(static_cast<int>(number));
+                return bwxJsonValue(number);
+            }
+
+            uint64_t unsignedNumber = 0;
+            result = std::from_chars(first, last, unsignedNumber);
+            if (result.ec == std::errc() && result.ptr == last)
+                return bwxJsonValue(unsignedNumber);
+        }
+
+        double number = 0.0;
+        auto result = std::from_chars(first, last, number);
+        if (result.ec != std::errc() || result.ptr != last)
+            return std::nullopt;
+        return bwxJsonValue(number);
+    }
+
+    bool bwxJsonLazy::HasKey(const wxString& path) const
+    {
+        return FindPath(path) != NPOS;
+    }
+
+    bwxJsonValue bwxJsonLazy::GetValue(const wxString& path, const bwxJsonValue& defaultValue) const
+    {
+        const size_t index = FindPath(path);
+        if (index == NPOS)
+            return defaultValue;
+
+        const char c = m_text[m_tape[index].begin];
+        if (c != '{' && c != '[')
+            return Decode(index);
+
+        // Containers are decoded once
+        auto it = m_decoded.find(index);
+        if (it == m_decoded.end())
+            it = m_decoded.emplace(index, Decode(index)).first;
+        return it->second;
+    }
+
+    std::vector<wxString> bwxJsonLazy::GetKeys() const
+    {
+        std::vector<wxString> keys;
+        if (m_tape.empty())
+            return keys;
+
+        for (size_t i = 1; i < m_tape[0].end; i = Next(i + 1))
+        {
+            const std::string_view key = RawString(i);
+            keys.push_back(wxString::FromUTF8(key.data(), key.size()));
+        }
+        return keys;
+    }
+
+    size_t bwxJsonLazy::GetSize() const
+    {
+        size_t count = 0;
+        if (!m_tape.empty())
+        {
+            for (size_t i = 1; i < m_tape[0].end; i = Next(i + 1))
+                count++;
+        }
+        return count;
+    }
+
+    int bwxJsonLazy::AsInt(const wxString& path, int defaultValue) const
+    {
+        return ConvertValue<int>(GetValue(path), defaultValue);
+    }
+
+    int64_t bwxJsonLazy::AsInt64(const wxString& path, int64_t defaultValue) const
+    {
+        return ConvertValue<int64_t>(GetValue(path), defaultValue);
+    }
+
+    uint64_t bwxJsonLazy::AsUInt64(const wxString& path, uint64_t defaultValue) const
+    {
+        return ConvertValue<uint64_t>(GetValue(path), defaultValue);
+    }
+
+    double bwxJsonLazy::AsDouble(const wxString& path, double defaultValue) const
+    {
+        return ConvertValue<double>(GetValue(path), defaultValue);
+    }
+
+    bool bwxJsonLazy::AsBool(const wxString& path, bool defaultValue) const
+    {
+        return ConvertValue<bool>(GetValue(path), defaultValue);
+    }
+
+    wxString bwxJsonLazy::AsWxString(const wxString& path, const wxString& defaultValue) const
+    {
+        const size_t index = FindPath(path);
+        if (index == NPOS || m_text[m_tape[index].begin] != '"')
+            return defaultValue;
+
+        const std::string_view text = RawString(index);
+        return wxString::FromUTF8(text.data(), text.size());
+    }
+
+    std::string bwxJsonLazy::AsStdString(const wxString& path, const std::string& defaultValue) const
+    {
+        const size_t index = FindPath(path);
+        if (index == NPOS || m_text[m_tape[index].begin] != '"')
+            return defaultValue;
+
+        return std::string(RawString(index));
+    }
+
+    bool bwxJsonLazy::IsNull(const wxString& path) const
+    {
+        const size_t index = FindPath(path);
+        if (index == NPOS)
+            return false;
+
+        const Entry& entry = m_tape[index];
+        return std::string_view(m_text.data() + entry.begin, entry.end - entry.begin) == "null";
+    }
+
+    void bwxJsonLazy::Walk(size_t index, size_t depth, const std::vector<const bwxJsonPath*>& paths, const std::vector<size_t>& active,
+                           std::vector<std::vector<bwxJsonValue>>& results) const
+    {
+        // All active paths are at the same depth; every container is scanned once for all of them
+        std::vector<size_t> pending;
+        bool wildcard = false;
+        size_t keys = 0;
+        size_t lastIndex = 0;
+        for (size_t path : active)
+        {
+            const auto& segments = paths[path]->GetSegments();
+            if (depth == segments.size())
+            {
+                results[path].push_back(Decode(index));
+                continue;
+            }
+
+            pending.push_back(path);
+            wildcard = wildcard || segments[depth].type == bwxJsonPath::Segment::ANY;
+            keys += segments[depth].type == bwxJsonPath::Segment::KEY;
+            if (segments[depth].type == bwxJsonPath::Segment::INDEX)
+                lastIndex = std::max(lastIndex, segments[depth].index);
+        }
+        if (pending.empty())
+            return;
+
+        const char c = m_text[m_tape[index].begin];
+        const size_t end = m_tape[index].end;
+        std::vector<size_t> child;
+
+        if (c == '{')
+        {
+            // Without wildcards the scan stops once every key was found (first match, like HasKey)
+            std::vector<bool> found(pending.size(), false);
+            for (size_t i = index + 1; i < end && (wildcard || keys > 0); i = Next(i + 1))
+            {
+                const std::string_view key = RawString(i);
+                child.clear();
+                for (size_t p = 0; p < pending.size(); ++p)
+                {
+                    const bwxJsonPath::Segment& segment = paths[pending[p]]->GetSegments()[depth];
+                    if (segment.type == bwxJsonPath::Segment::ANY)
+                    {
+                        child.push_back(pending[p]);
+                    }
+                    else if (segment.type == bwxJsonPath::Segment::KEY && !found[p] && segment.keyUtf8 == key)
+                    {
+                        child.push_back(pending[p]);
+                        found[p] = true;
+                        keys--;
+                    }
+                }
+                if (!child.empty())
+                    Walk(i + 1, depth + 1, paths, child, results);
+            }
+        }
+        else if (c == '[')
+        {
+            size_t item = 0;
+            for (size_t i = index + 1; i < end && (wildcard || item <= lastIndex); i = Next(i), ++item)
+            {
+                child.clear();
+                for (size_t path : pending)
+                {
+                    const bwxJsonPath::Segment& segment = paths[path]->GetSegments()[depth];
+                    if (segment.type == bwxJsonPath::Segment::ANY || (segment.type == bwxJsonPath::Segment::INDEX && segment.index == item))
+                        child.push_back(path);
+                }
+                if (!child.empty())
+                    Walk(i, depth + 1, paths, child, results);
+            }
+        }
+    }
+
+    std::vector<bwxJsonValue> bwxJsonLazy::Select(const bwxJsonPath& path) const
+    {
+        std::vector<std::vector<bwxJsonValue>> results(1);
+        if (path.IsValid() && !m_tape.empty())
+            Walk(0, 0, { &path }, { 0 }, results);
+        return std::move(results[0]);
+    }
+
+    std::vector<std::vector<bwxJsonValue>> bwxJsonLazy::Extract(const std::vector<bwxJsonPath>& paths) const
+    {
+        std::vector<std::vector<bwxJsonValue>> results(paths.size());
+
+        std::vector<const bwxJsonPath*> pathPointers;
+        std::vector<size_t> active;
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            pathPointers.push_back(&paths[i]);
+            if (paths[i].IsValid())
+                active.push_back(i);
+        }
+
+        if (!active.empty() && !m_tape.empty())
+            Walk(0, 0, pathPointers, active, results);
+        return results;
+    }
+
+    bwxJSON bwxJsonLazy::ToJSON() const
+    {
+        bwxJSON json;
+        if (m_tape.empty())
+            return json;
+
+        for (size_t i = 1; i < m_tape[0].end; i = Next(i + 1))
+        {
+            const std::string_view key = RawString(i);
+            json[wxString::FromUTF8(key.data(), key.size())] = Decode(i + 1);
+        }
+        return json;
+    }
+
+}
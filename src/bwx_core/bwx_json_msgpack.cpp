@@ -0,0 +1,541 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_msgpack.cpp
+// Purpose:     BWX_SDK Library; MessagePack encoding of bwxJSON values
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <bwx_sdk/bwx_core/bwx_json_msgpack.h>
+
+#include <wx/file.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        // Nesting limit (same as the bwxJSON parser)
+        constexpr int MSGPACK_MAX_DEPTH = 512;
+
+        // Stream read chunk size
+        constexpr size_t MSGPACK_READ_CHUNK = 64 * 1024;
+
+    }
+
+    // ========================================================================
+    // bwxMsgPackWriter
+    // ========================================================================
+
+    bwxMsgPackWriter::bwxMsgPackWriter(std::vector<uint8_t>& out)
+        : m_out(&out)
+    {
+    }
+
+    bwxMsgPackWriter::bwxMsgPackWriter(wxOutputStream& stream, size_t bufferSize)
+        : m_out(&m_ownBuffer), m_stream(&stream), m_bufferSize(std::max<size_t>(bufferSize, 16))
+    {
+        m_ownBuffer.reserve(m_bufferSize + 16);
+    }
+
+    bwxMsgPackWriter::~bwxMsgPackWriter()
+    {
+        Flush();
+    }
+
+    bool bwxMsgPackWriter::Flush()
+    {
+        if (m_stream && !m_ownBuffer.empty())
+        {
+            m_stream->Write(m_ownBuffer.data(), m_ownBuffer.size());
+            if (m_stream->LastWrite() != m_ownBuffer.size())
+                m_ok = false;
+            m_ownBuffer.clear();
+        }
+        return m_ok;
+    }
+
+    void bwxMsgPackWriter::FlushIfFull()
+    {
+        if (m_stream && m_ownBuffer.size() >= m_bufferSize)
+            Flush();
+    }
+
+    void bwxMsgPackWriter::PutBigEndian(uint64_t value, int bytes)
+    {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8)
+            Put(static_cast<uint8_t>(value >> shift));
+    }
+
+    void bwxMsgPackWriter::MapHeader(uint32_t count)
+    {
+        if (count < 16) Put(static_cast<uint8_t>(0x80 | count));
+        else if (count <= 0xFFFF) { Put(0xDE); PutBigEndian(count, 2); }
+        else { Put(0xDF); PutBigEndian(count, 4); }
+    }
+
+    void bwxMsgPackWriter::ArrayHeader(uint32_t count)
+    {
+        if (count < 16) Put(static_cast<uint8_t>(0x90 | count));
+        else if (count <= 0xFFFF) { Put(0xDC); PutBigEndian(count, 2); }
+        else { Put(0xDD); PutBigEndian(count, 4); }
+    }
+
+    void bwxMsgPackWriter::String(std::string_view utf8)
+    {
+        const size_t size = utf8.size();
+        if (size > std::numeric_limits<uint32_t>::max())
+        {
+            m_ok = false;
+            return;
+        }
+
+        if (size < 32) Put(static_cast<uint8_t>(0xA0 | size));
+        else if (size <= 0xFF) { Put(0xD9); PutBigEndian(size, 1); }
+        else if (size <= 0xFFFF) { Put(0xDA); PutBigEndian(size, 2); }
+        else { Put(0xDB); PutBigEndian(size, 4); }
+
+        m_out->insert(m_out->end(), utf8.begin(), utf8.end());
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::String(const wxString& text)
+    {
+        const wxScopedCharBuffer utf8 = text.utf8_str();
+        String(std::string_view(utf8.data(), utf8.length()));
+    }
+
+    void bwxMsgPackWriter::Binary(const void* data, uint32_t size)
+    {
+        if (size <= 0xFF) { Put(0xC4); PutBigEndian(size, 1); }
+        else if (size <= 0xFFFF) { Put(0xC5); PutBigEndian(size, 2); }
+        else { Put(0xC6); PutBigEndian(size, 4); }
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_out->insert(m_out->end(), bytes, bytes + size);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::Int(int64_t value)
+    {
+        if (value >= 0)
+        {
+            UInt(static_cast<uint64_t>(value));
+            return;
+        }
+
+        if (value >= -32) Put(static_cast<uint8_t>(value));
+        else if (value >= std::numeric_limits<int8_t>::min()) { Put(0xD0); PutBigEndian(static_cast<uint64_t>(value), 1); }
+        else if (value >= std::numeric_limits<int16_t>::min()) { Put(0xD1); PutBigEndian(static_cast<uint64_t>(value), 2); }
+        else if (value >= std::numeric_limits<int32_t>::min()) { Put(0xD2); PutBigEndian(static_cast<uint64_t>(value), 4); }
+        else Int64(value);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::UInt(uint64_t value)
+    {
+        if (value < 0x80) Put(static_cast<uint8_t>(value));
+        else if (value <= 0xFF) { Put(0xCC); PutBigEndian(value, 1); }
+        else if (value <= 0xFFFF) { Put(0xCD); PutBigEndian(value, 2); }
+        else if (value <= 0xFFFFFFFF) { Put(0xCE); PutBigEndian(value, 4); }
+        else UInt64(value);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::Int64(int64_t value)
+    {
+        Put(0xD3);
+        PutBigEndian(static_cast<uint64_t>(value), 8);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::UInt64(uint64_t value)
+    {
+        Put(0xCF);
+        PutBigEndian(value, 8);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::Double(double value)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Put(0xCB);
+        PutBigEndian(bits, 8);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::Bool(bool value)
+    {
+        Put(value ? 0xC3 : 0xC2);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::Null()
+    {
+        Put(0xC0);
+        FlushIfFull();
+    }
+
+    void bwxMsgPackWriter::Value(const bwxJsonValue& value)
+    {
+        if (!value.has_value())
+        {
+            Null();
+            return;
+        }
+
+        std::visit([this](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, std::nullptr_t>) Null();
+            else if constexpr (std::is_same_v<T, int>) Int(arg);
+            else if constexpr (std::is_same_v<T, int64_t>) Int64(arg);
+            else if constexpr (std::is_same_v<T, uint64_t>) UInt64(arg);
+            else if constexpr (std::is_same_v<T, double>) Double(arg);
+            else if constexpr (std::is_same_v<T, bool>) Bool(arg);
+            else if constexpr (std::is_same_v<T, std::string>) String(std::string_view(arg));
+            else if constexpr (std::is_same_v<T, wxString>) String(arg);
+            else if constexpr (std::is_same_v<T, std::shared_ptr<bwxJSON>>) {
+                if (arg) Value(*arg);
+                else Null();
+            }
+            else { // std::vector<bwxJsonValueHelper>
+                ArrayHeader(static_cast<uint32_t>(arg.size()));
+                for (const auto& item : arg) Value(item.value);
+            }
+            }, *value);
+    }
+
+    void bwxMsgPackWriter::Value(const bwxJSON& object)
+    {
+        MapHeader(static_cast<uint32_t>(object.GetSize()));
+        for (const auto& [key, value] : object)
+        {
+            String(key);
+            Value(value);
+        }
+    }
+
+    // ========================================================================
+    // bwxMsgPackReader
+    // ========================================================================
+
+    bwxMsgPackReader::bwxMsgPackReader(const void* data, size_t size)
+        : m_data(static_cast<const uint8_t*>(data)), m_size(size)
+    {
+    }
+
+    bwxMsgPackReader::Token bwxMsgPackReader::Fail(const char* message)
+    {
+        m_lastError = wxString::Format(wxT("Parse MessagePack error at %zu: %s"), m_pos, message);
+        m_token = TOKEN_ERROR;
+        return TOKEN_ERROR;
+    }
+
+    bool bwxMsgPackReader::Need(size_t bytes)
+    {
+        if (m_size - m_pos >= bytes)
+            return true;
+        Fail("unexpected end of data");
+        return false;
+    }
+
+    uint64_t bwxMsgPackReader::GetBigEndian(int bytes)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i)
+            value = (value << 8) | m_data[m_pos++];
+        return value;
+    }
+
+    bwxMsgPackReader::Token bwxMsgPackReader::Next()
+    {
+        if (m_token == TOKEN_ERROR) return m_token;
+        if (m_pos >= m_size) return m_token = TOKEN_END;
+
+        const uint8_t type = m_data[m_pos++];
+
+        // Fixed-size forms
+        if (type <= 0x7F) { m_int = type; m_uint = type; return m_token = TOKEN_INT; }
+        if (type >= 0xE0) { m_int = static_cast<int8_t>(type); m_uint = static_cast<uint64_t>(m_int); return m_token = TOKEN_INT; }
+        if ((type & 0xF0) == 0x80) { m_count = type & 0x0F; return m_token = TOKEN_MAP; }
+        if ((type & 0xF0) == 0x90) { m_count = type & 0x0F; return m_token = TOKEN_ARRAY; }
+
+        int lengthBytes = 0;
+        Token token = TOKEN_STRING;
+        if ((type & 0xE0) == 0xA0)
+        {
+            m_count = type & 0x1F;
+        }
+        else
+        {
+            switch (type)
+            {
+            case 0xC0: return m_token = TOKEN_NULL;
+            case 0xC2:
+            case 0xC3: m_bool = type == 0xC3; return m_token = TOKEN_BOOL;
+            case 0xC4: lengthBytes = 1; token = TOKEN_BINARY; break;
+            case 0xC5: lengthBytes = 2; token = TOKEN_BINARY; break;
+            case 0xC6: lengthBytes = 4; token = TOKEN_BINARY; break;
+            case 0xCA:
+            {
+                if (!Need(4)) return TOKEN_ERROR;
+                const uint32_t bits = static_cast<uint32_t>(GetBigEndian(4));
+                float value = 0.0f;
+                std::memcpy(&value, &bits, sizeof(value));
+                m_double = value;
+                return m_token = TOKEN_DOUBLE;
+            }
+            case 0xCB:
+            {
+                if (!Need(8)) return TOKEN_ERROR;
+                const uint64_t bits = GetBigEndian(8);
+                std::memcpy(&m_double, &bits, sizeof(m_double));
+                return m_token = TOKEN_DOUBLE;
+            }
+            case 0xCC:
+            case 0xCD:
+            case 0xCE:
+            {
+                const int bytes = 1 << (type - 0xCC);
+                if (!Need(bytes)) return TOKEN_ERROR;
+                m_uint = GetBigEndian(bytes);
+                m_int = static_cast<int64_t>(m_uint);
+                return m_token = TOKEN_INT;
+            }
+            case 0xCF:
+                if (!Need(8)) return TOKEN_ERROR;
+                m_uint = GetBigEndian(8);
+                m_int = static_cast<int64_t>(m_uint);
+                return m_token = TOKEN_UINT64;
+            case 0xD0:
+            case 0xD1:
+            case 0xD2:
+            case 0xD3:
+            {
+                const int bytes = 1 << (type - 0xD0);
+                if (!Need(bytes)) return TOKEN_ERROR;
+                const uint64_t raw = GetBigEndian(bytes);
+
+                // Sign extension of the shorter forms
+                const int shift = 64 - bytes * 8;
+                m_int = static_cast<int64_t>(raw << shift) >> shift;
+                m_uint = static_cast<uint64_t>(m_int);
+                return m_token = type == 0xD3 ? TOKEN_INT64 : TOKEN_INT;
+            }
+            case 0xD9: lengthBytes = 1; break;
+            case 0xDA: lengthBytes = 2; break;
+            case 0xDB: lengthBytes = 4; break;
+            case 0xDC:
+            case 0xDD:
+            case 0xDE:
+            case 0xDF:
+            {
+                const int bytes = (type == 0xDC || type == 0xDE) ? 2 : 4;
+                if (!Need(bytes)) return TOKEN_ERROR;
+                m_count = static_cast<uint32_t>(GetBigEndian(bytes));
+                return m_token = (type <= 0xDD ? TOKEN_ARRAY : TOKEN_MAP);
+            }
+            default:
+                m_pos--;
+                return Fail("unsupported type (extension)");
+            }
+
+            if (!Need(lengthBytes)) return TOKEN_ERROR;
+            m_count = static_cast<uint32_t>(GetBigEndian(lengthBytes));
+        }
+
+        // String/binary payload stays in place
+        if (!Need(m_count)) return TOKEN_ERROR;
+        m_text = std::string_view(reinterpret_cast<const char*>(m_data + m_pos), m_count);
+        m_pos += m_count;
+        return m_token = token;
+    }
+
+    bool bwxMsgPackReader::SkipChildren(int depth)
+    {
+        if (m_token != TOKEN_MAP && m_token != TOKEN_ARRAY) return IsOk();
+        if (depth > MSGPACK_MAX_DEPTH)
+        {
+            Fail("nesting too deep");
+            return false;
+        }
+
+        const uint64_t children = m_token == TOKEN_MAP ? uint64_t(m_count) * 2 : m_count;
+        for (uint64_t i = 0; i < children; ++i)
+        {
+            const Token token = Next();
+            if (token == TOKEN_END)
+            {
+                Fail("unexpected end of data");
+                return false;
+            }
+            if (token == TOKEN_ERROR || !SkipChildren(depth + 1)) return false;
+        }
+        return true;
+    }
+
+    bool bwxMsgPackReader::Skip()
+    {
+        return SkipChildren(0);
+    }
+
+    bool bwxMsgPackReader::ReadChildren(bwxJsonValue& value, int depth)
+    {
+        if (depth > MSGPACK_MAX_DEPTH)
+        {
+            Fail("nesting too deep");
+            return false;
+        }
+
+        switch (m_token)
+        {
+        case TOKEN_MAP:
+        {
+            auto jsonObject = std::make_shared<bwxJSON>();
+            const uint32_t count = m_count;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (Next() != TOKEN_STRING)
+                {
+                    if (IsOk()) Fail("expected string key");
+                    return false;
+                }
+
+                // Parse straight into the map slot (no copy of nested values)
+                bwxJsonValue& slot = (*jsonObject)[GetString()];
+                if (Next() == TOKEN_END) Fail("unexpected end of data");
+                if (!IsOk() || !ReadChildren(slot, depth + 1)) return false;
+            }
+            value = bwxJsonValue(std::move(jsonObject));
+            return true;
+        }
+        case TOKEN_ARRAY:
+        {
+            std::vector<bwxJsonValueHelper> jsonArray;
+            const uint32_t count = m_count;
+
+            // Count comes from the data - reserve only what can be there
+            jsonArray.reserve(std::min<size_t>(count, m_size - m_pos));
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (Next() == TOKEN_END) Fail("unexpected end of data");
+                jsonArray.emplace_back();
+                if (!IsOk() || !ReadChildren(jsonArray.back().value, depth + 1)) return false;
+            }
+            value = bwxJsonValue(std::move(jsonArray));
+            return true;
+        }
+        case TOKEN_STRING: value = bwxJsonValue(GetString()); return true;
+        case TOKEN_BINARY: value = bwxJsonValue(std::string(m_text)); return true;
+        case TOKEN_INT:
+            if (m_int >= std::numeric_limits<int>::min() && m_int <= std::numeric_limits<int>::max())
+                value = bwxJsonValue(static_cast<int>(m_int));
+            else
+                value = bwxJsonValue(m_int);
+            return true;
+        case TOKEN_INT64: value = bwxJsonValue(m_int); return true;
+        case TOKEN_UINT64: value = bwxJsonValue(m_uint); return true;
+        case TOKEN_DOUBLE: value = bwxJsonValue(m_double); return true;
+        case TOKEN_BOOL: value = bwxJsonValue(m_bool); return true;
+        case TOKEN_NULL: value = bwxJsonValue(); return true;
+        default: return false;
+        }
+    }
+
+    bool bwxMsgPackReader::ReadValue(bwxJsonValue& value)
+    {
+        return ReadChildren(value, 0);
+    }
+
+    // ========================================================================
+    // bwxJSON - MessagePack form
+    // ========================================================================
+
+    void bwxJSON::SerializeToMsgPack(std::vector<uint8_t>& out) const
+    {
+        bwxMsgPackWriter writer(out);
+        writer.Value(*this);
+    }
+
+    bool bwxJSON::ParseFromMsgPack(const void* data, size_t size)
+    {
+        m_data.reset();
+        m_lastError.Clear();
+
+        bwxMsgPackReader reader(data, size);
+        bwxJsonValue parsedValue;
+        if (reader.Next() != bwxMsgPackReader::TOKEN_MAP)
+        {
+            m_lastError = reader.IsOk() ? wxString::Format(wxT("Parse MessagePack error at 0: wrong structure")) : reader.GetLastError();
+            return false;
+        }
+        if (!reader.ReadValue(parsedValue))
+        {
+            m_lastError = reader.GetLastError();
+            return false;
+        }
+
+        m_data = std::move(std::get<std::shared_ptr<bwxJSON>>(*parsedValue)->m_data);
+        return true;
+    }
+
+    bool bwxJSON::SaveToMsgPackFile(const wxString& filename) const
+    {
+        wxFile file;
+        if (!file.Open(filename, wxFile::write))
+            return false;
+
+        std::vector<uint8_t> data;
+        SerializeToMsgPack(data);
+        const bool written = file.Write(data.data(), data.size()) == data.size();
+        file.Close();
+        return written;
+    }
+
+    bool bwxJSON::LoadFromMsgPackFile(const wxString& filename)
+    {
+        wxFile file;
+        if (!file.Open(filename))
+            return false;
+
+        wxFileOffset length = file.Length();
+        if (length < 0)
+            return false;
+
+        std::vector<uint8_t> data(static_cast<size_t>(length));
+        if (length > 0 && file.Read(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+            return false;
+
+        file.Close();
+        return ParseFromMsgPack(data.data(), data.size());
+    }
+
+    bool bwxJSON::SaveToMsgPackStream(wxOutputStream& stream) const
+    {
+        bwxMsgPackWriter writer(stream);
+        writer.Value(*this);
+        return writer.Flush();
+    }
+
+    bool bwxJSON::LoadFromMsgPackStream(wxInputStream& stream)
+    {
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> buffer(MSGPACK_READ_CHUNK);
+
+        do
+        {
+            stream.Read(buffer.data(), buffer.size());
+            data.insert(data.end(), buffer.data(), buffer.data() + stream.LastRead());
+        } while (stream.LastRead() > 0);
+
+        return ParseFromMsgPack(data.data(), data.size());
+    }
+
+}
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_ndjson.cpp
+// Purpose:     BWX_SDK Library; Parallel NDJSON (JSON Lines) reader
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <bwx_sdk/bwx_core/bwx_json_ndjson.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        // Chunks in flight per job system thread (parsed ahead of delivery)
+        constexpr size_t NDJSON_CHUNKS_PER_THREAD = 2;
+
+        /// Read-only mapping of a whole file (empty files map to no data)
+        class bwxNdjsonMappedFile
+        {
+        public:
+            ~bwxNdjsonMappedFile() { Close(); }
+
+            bool Open(const wxString& filename)
+            {
+                Close();
+#if defined(_WIN32)
+                m_file = CreateFileW(filename.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (m_file == INVALID_HANDLE_VALUE)
+                    return false;
+
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(m_file, &size))
+                {
+                    Close();
+                    return false;
+                }
+                m_size = static_cast<size_t>(size.QuadPart);
+                if (m_size == 0)
+                    return true;
+
+                m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mapping)
+                    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+                m_fd = open(filename.fn_str(), O_RDONLY);
+                if (m_fd < 0)
+                    return false;
+
+                struct stat info;
+                if (fstat(m_fd, &info) != 0)
+                {
+                    Close();
+                    return false;
+                }
+                m_size = static_cast<size_t>(info.st_size);
+                if (m_size == 0)
+                    return true;
+
+                void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+                if (data != MAP_FAILED)
+                {
+                    m_data = static_cast<const char*>(data);
+                    madvise(data, m_size, MADV_SEQUENTIAL);
+                }
+#endif
+                if (!m_data)
+                {
+                    Close();
+                    return false;
+                }
+                return true;
+            }
+
+            void Close()
+            {
+#if defined(_WIN32)
+                if (m_data)
+                    UnmapViewOfFile(m_data);
+                if (m_mapping)
+                    CloseHandle(m_mapping);
+                if (m_file != INVALID_HANDLE_VALUE)
+                    CloseHandle(m_file);
+                m_mapping = nullptr;
+                m_file = INVALID_HANDLE_VALUE;
+#else
+                if (m_data)
+                    munmap(const_cast<char*>(m_data), m_size);
+                if (m_fd >= 0)
+                    close(m_fd);
+                m_fd = -1;
+#endif
+                m_data = nullptr;
+                m_size = 0;
+            }
+
+            inline std::string_view GetText() const { return m_data ? std::string_view(m_data, m_size) : std::string_view(); }
+
+        private:
+#if defined(_WIN32)
+            HANDLE m_file = INVALID_HANDLE_VALUE;
+            HANDLE m_mapping = nullptr;
+#else
+            int m_fd = -1;
+#endif
+            const char* m_data = nullptr;
+            size_t m_size = 0;
+        };
+
+    }
+
+    /// Slot of the chunk ring - the document (arena) and buffers are reused by later chunks
+    struct bwxNdjsonReader::Chunk
+    {
+        bwxJobCounter counter;
+        bwxJsonDocument document;
+        std::vector<size_t> offsets;  ///< Offset of each record in the input
+        std::string_view text;
+        size_t offset = 0;
+        size_t errors = 0;
+        size_t delivered = 0;         ///< UNORDERED: records passed to the callback
+    };
+
+    bwxNdjsonReader::bwxNdjsonReader(bwxJobSystem& jobSystem)
+        : m_jobSystem(jobSystem)
+    {
+    }
+
+    bool bwxNdjsonReader::ParseFile(const wxString& filename, const Callback& callback)
+    {
+        m_recordCount = 0;
+        m_errorCount = 0;
+        m_lastError.Clear();
+
+        bwxNdjsonMappedFile file;
+        if (!file.Open(filename))
+        {
+            m_lastError = wxString::Format(wxT("Cannot open file %s"), filename);
+            return false;
+        }
+        return Parse(file.GetText(), callback);
+    }
+
+    bool bwxNdjsonReader::Parse(std::string_view text, const Callback& callback)
+    {
+        m_recordCount = 0;
+        m_errorCount = 0;
+        m_lastError.Clear();
+        m_stop = false;
+
+        const size_t slotCount = NDJSON_CHUNKS_PER_THREAD * (m_jobSystem.GetWorkerCount() + 1);
+        std::vector<std::unique_ptr<Chunk>> slots;
+        for (size_t i = 0; i < slotCount; ++i)
+            slots.push_back(std::make_unique<Chunk>());
+
+        // Chunks end after a newline (or at the end of the input)
+        size_t splitPos = 0;
+        size_t scheduled = 0;
+        size_t collected = 0;
+        while (collected < scheduled || (splitPos < text.size() && !m_stop))
+        {
+            while (splitPos < text.size() && scheduled - collected < slotCount && !m_stop)
+            {
+                size_t end = std::min(splitPos + m_chunkSize, text.size());
+                if (end < text.size())
+                {
+                    const size_t newline = text.find('\n', end);
+                    end = newline == std::string_view::npos ? text.size() : newline + 1;
+                }
+
+                Chunk& chunk = *slots[scheduled % slotCount];
+                chunk.text = text.substr(splitPos, end - splitPos);
+                chunk.offset = splitPos;
+                m_jobSystem.Schedule([this, &chunk, &callback] { ParseChunk(chunk, callback); }, &chunk.counter);
+
+                splitPos = end;
+                scheduled++;
+            }
+
+            // Oldest chunk first - the slot is free for the next one afterwards
+            Chunk& chunk = *slots[collected % slotCount];
+            m_jobSystem.Wait(chunk.counter);
+            Collect(chunk, callback);
+            collected++;
+        }
+
+        return m_errorCount == 0;
+    }
+
+    void bwxNdjsonReader::ParseChunk(Chunk& chunk, const Callback& callback)
+    {
+        chunk.errors = 0;
+        chunk.delivered = 0;
+        chunk.offsets.clear();
+        if (m_stop)
+            return;
+
+        chunk.errors = chunk.document.ParseLines(chunk.text, chunk.offset, &chunk.offsets);
+        if (m_order != UNORDERED)
+            return;
+
+        const bwxJsonNode& records = chunk.document.GetRoot();
+        for (size_t i = 0; i < chunk.offsets.size() && !m_stop; ++i)
+        {
+            chunk.delivered++;
+            if (!callback(bwxNdjsonRecord{ chunk.offsets[i], chunk.document, records[i] }))
+                m_stop = true;
+        }
+    }
+
+    void bwxNdjsonReader::Collect(Chunk& chunk, const Callback& callback)
+    {
+        if (m_order == UNORDERED)
+            m_recordCount += chunk.delivered;
+
+        // Chunks parsed ahead of a stop are not reported
+        if (m_stop)
+            return;
+
+        // Chunks are collected in input order, so the first error is the earliest one
+        m_errorCount += chunk.errors;
+        if (chunk.errors && m_lastError.IsEmpty())
+            m_lastError = chunk.document.GetLastError();
+
+        if (m_order == UNORDERED)
+            return;
+
+        const bwxJsonNode& records = chunk.document.GetRoot();
+        for (size_t i = 0; i < chunk.offsets.size() && !m_stop; ++i)
+        {
+            m_recordCount++;
+            if (!callback(bwxNdjsonRecord{ chunk.offsets[i], chunk.document, records[i] }))
+                m_stop = true;
+        }
+    }
+
+}
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_path.cpp
+// Purpose:     BWX_SDK Library; Compiled JSON path queries
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <bwx_sdk/bwx_core/bwx_json_path.h>
+
+#include <charconv>
+#include <string_view>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        /// Walks a bwxJSON tree once for a set of paths; all active paths are at the same depth
+        class bwxJsonTreeWalker
+        {
+        public:
+            bwxJsonTreeWalker(const std::vector<const bwxJsonPath*>& paths, std::vector<std::vector<const bwxJsonValue*>>& results)
+                : m_paths(paths), m_results(results)
+            {
+            }
+
+            void VisitObject(const bwxJSON& object, size_t depth, const std::vector<size_t>& active)
+            {
+                if (HasWildcard(depth, active))
+                {
+                    std::vector<size_t> child;
+                    for (const auto& [key, value] : object)
+                    {
+                        child.clear();
+                        for (size_t path : active)
+                        {
+                            const bwxJsonPath::Segment& segment = Segment(path, depth);
+                            if (segment.type == bwxJsonPath::Segment::ANY || (segment.type == bwxJsonPath::Segment::KEY && segment.key == key))
+                                child.push_back(path);
+                        }
+                        if (!child.empty())
+                            Visit(&value, depth + 1, child);
+                    }
+                    return;
+                }
+
+                // One hash lookup per distinct key
+                std::vector<bool> done(active.size(), false);
+                for (size_t i = 0; i < active.size(); ++i)
+                {
+                    const bwxJsonPath::Segment& segment = Segment(active[i], depth);
+                    if (done[i] || segment.type != bwxJsonPath::Segment::KEY)
+                        continue;
+
+                    std::vector<size_t> child{ active[i] };
+                    for (size_t j = i + 1; j < active.size(); ++j)
+                    {
+                        const bwxJsonPath::Segment& other = Segment(active[j], depth);
+                        if (!done[j] && other.type == bwxJsonPath::Segment::KEY && other.key == segment.key)
+                        {
+                            child.push_back(active[j]);
+                            done[j] = true;
+                        }
+                    }
+
+                    if (const bwxJsonValue* value = object.GetValuePtr(segment.key))
+                        Visit(value, depth + 1, child);
+                }
+            }
+
+        private:
+            const bwxJsonPath::Segment& Segment(size_t path, size_t depth) const
+            {
+                return m_paths[path]->GetSegments()[depth];
+            }
+
+            bool HasWildcard(size_t depth, const std::vector<size_t>& active) const
+            {
+                for (size_t path : active)
+                {
+                    if (Segment(path, depth).type == bwxJsonPath::Segment::ANY)
+                        return true;
+                }
+                return false;
+            }
+
+            void Visit(const bwxJsonValue* value, size_t depth, const std::vector<size_t>& active)
+            {
+                std::vector<size_t> pending;
+                for (size_t path : active)
+                {
+                    if (depth == m_paths[path]->GetSegments().size())
+                        m_results[path].push_back(value);
+                    else
+                        pending.push_back(path);
+                }
+                if (pending.empty() || !value->has_value())
+                    return;
+
+                if (const auto* object = std::get_if<std::shared_ptr<bwxJSON>>(&**value))
+                {
+                    if (*object)
+                        VisitObject(**object, depth, pending);
+                }
+                else if (const auto* array = std::get_if<std::vector<bwxJsonValueHelper>>(&**value))
+                {
+                    VisitArray(*array, depth, pending);
+                }
+            }
+
+            void VisitArray(const std::vector<bwxJsonValueHelper>& array, size_t depth, const std::vector<size_t>& active)
+            {
+                if (HasWildcard(depth, active))
+                {
+                    std::vector<size_t> child;
+                    for (size_t item = 0; item < array.size(); ++item)
+                    {
+                        child.clear();
+                        for (size_t path : active)
+                        {
+                            const bwxJsonPath::Segment& segment = Segment(path, depth);
+                            if (segment.type == bwxJsonPath::Segment::ANY || (segment.type == bwxJsonPath::Segment::INDEX && segment.index == item))
+                                child.push_back(path);
+                        }
+                        if (!child.empty())
+                            Visit(&array[item].value, depth + 1, child);
+                    }
+                    return;
+                }
+
+                for (size_t path : active)
+                {
+                    const bwxJsonPath::Segment& segment = Segment(path, depth);
+                    if (segment.type == bwxJsonPath::Segment::INDEX && segment.index < array.size())
+                        Visit(&array[segment.index].value, depth + 1, { path });
+                }
+            }
+
+            const std::vector<const bwxJsonPath*>& m_paths;
+            std::vector<std::vector<const bwxJsonValue*>>& m_results;
+        };
+
+    }
+
+    bool bwxJsonPath::Fail(size_t position, const char* message)
+    {
+        m_lastError = wxString::Format(wxT("JSON path error at %zu: %s"), position, message);
+        m_segments.clear();
+        m_valid = false;
+        return false;
+    }
+
+    bool bwxJsonPath::Compile(const wxString& path)
+    {
+        m_path = path;
+        m_segments.clear();
+        m_lastError.Clear();
+        m_valid = false;
+
+        const wxScopedCharBuffer utf8 = path.utf8_str();
+        const std::string_view text(utf8.data(), utf8.length());
+
+        size_t pos = 0;
+        if (pos < text.size() && text[pos] == '$')
+            pos++;
+
+        auto addKey = [this](std::string_view key) {
+            Segment segment;
+            segment.type = Segment::KEY;
+            segment.keyUtf8 = std::string(key);
+            segment.key = wxString::FromUTF8(key.data(), key.size());
+            m_segments.push_back(std::move(segment));
+        };
+
+        bool first = true;
+        while (pos < text.size())
+        {
+            const char c = text[pos];
+
+            // [index], [*], ["key"] or ['key']
+            if (c == '[')
+            {
+                pos++;
+                if (pos >= text.size())
+                    return Fail(pos, "unexpected end of path");
+
+                const char open = text[pos];
+                if (open == '"' || open == '\'')
+                {
+                    const size_t close = text.find(open, pos + 1);
+                    if (close == std::string_view::npos)
+                        return Fail(pos, "missing closing quote");
+                    addKey(text.substr(pos + 1, close - pos - 1));
+                    pos = close + 1;
+                }
+                else if (open == '*')
+                {
+                    m_segments.push_back(Segment{ Segment::ANY });
+                    pos++;
+                }
+                else
+                {
+                    Segment segment;
+                    segment.type = Segment::INDEX;
+                    auto result = std::from_chars(text.data() + pos, text.data() + text.size(), segment.index);
+                    if (result.ec != std::errc())
+                        return Fail(pos, "expected array index, `*` or quoted key");
+                    pos = result.ptr - text.data();
+                    m_segments.push_back(std::move(segment));
+                }
+
+                if (pos >= text.size() || text[pos] != ']')
+                    return Fail(pos, "expected `]`");
+                pos++;
+                first = false;
+                continue;
+            }
+
+            if (c == '.')
+                pos++;
+            else if (!first)
+                return Fail(pos, "expected `.` or `[`");
+
+            // Dotted key or `*`
+            size_t end = text.find_first_of(".[", pos);
+            if (end == std::string_view::npos)
+                end = text.size();
+            if (end == pos)
+                return Fail(pos, "empty key");
+
+            const std::string_view key = text.substr(pos, end - pos);
+            if (key == "*")
+                m_segments.push_back(Segment{ Segment::ANY });
+            else
+                addKey(key);
+
+            pos = end;
+            first = false;
+        }
+
+        if (m_segments.empty())
+            return Fail(pos, "empty path");
+
+        m_valid = true;
+        return true;
+    }
+
+    std::vector<const bwxJsonValue*> bwxJsonPath::Select(const bwxJSON& root) const
+    {
+        std::vector<std::vector<const bwxJsonValue*>> results(1);
+        if (m_valid)
+        {
+            const std::vector<const bwxJsonPath*> paths{ this };
+            bwxJsonTreeWalker(paths, results).VisitObject(root, 0, { 0 });
+        }
+        return std::move(results[0]);
+    }
+
+    const bwxJsonValue* bwxJsonPath::SelectFirst(const bwxJSON& root) const
+    {
+        // Wildcard-free paths are direct lookups
+        const bwxJsonValue* value = nullptr;
+        for (const Segment& segment : m_segments)
+        {
+            if (segment.type == Segment::ANY)
+            {
+                const auto matches = Select(root);
+                return matches.empty() ? nullptr : matches.front();
+            }
+
+            if (!value)
+            {
+                value = segment.type == Segment::KEY ? root.GetValuePtr(segment.key) : nullptr;
+            }
+            else if (!value->has_value())
+            {
+                return nullptr;
+            }
+            else if (const auto* object = std::get_if<std::shared_ptr<bwxJSON>>(&**value))
+            {
+                value = (segment.type == Segment::KEY && *object) ? (*object)->GetValuePtr(segment.key) : nullptr;
+            }
+            else if (const auto* array = std::get_if<std::vector<bwxJsonValueHelper>>(&**value))
+            {
+                value = (segment.type == Segment::INDEX && segment.index < array->size()) ? &(*array)[segment.index].value : nullptr;
+            }
+            else
+            {
+                return nullptr;
+            }
+
+            if (!value)
+                return nullptr;
+        }
+        return value;
+    }
+
+    std::vector<std::vector<const bwxJsonValue*>> bwxJsonPath::Extract(const bwxJSON& root, const std::vector<bwxJsonPath>& paths)
+    {
+        std::vector<std::vector<const bwxJsonValue*>> results(paths.size());
+
+        std::vector<const bwxJsonPath*> pathPointers;
+        std::vector<size_t> active;
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            pathPointers.push_back(&paths[i]);
+            if (paths[i].IsValid())
+                active.push_back(i);
+        }
+
+        if (!active.empty())
+            bwxJsonTreeWalker(pathPointers, results).VisitObject(root, 0, active);
+        return results;
+    }
+
+}
@@ -0,0 +1,737 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_json_stream.cpp
+// Purpose:     BWX_SDK Library; Streaming JSON reader and writer
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <bwx_sdk/bwx_core/bwx_json_stream.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        // Nesting limit (same as the bwxJSON parser)
+        constexpr size_t JSON_MAX_DEPTH = 512;
+
+        inline bool IsJsonSpace(int c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+        }
+
+        inline bool IsJsonNumberChar(int c)
+        {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        inline int HexDigit(char c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        bool ReadHex4(std::string_view text, size_t pos, unsigned long& value)
+        {
+            if (pos + 4 > text.size()) return false;
+
+            value = 0;
+            for (size_t i = pos; i < pos + 4; ++i)
+            {
+                const int digit = HexDigit(text[i]);
+                if (digit < 0) return false;
+                value = (value << 4) | static_cast<unsigned long>(digit);
+            }
+            return true;
+        }
+
+        void AppendUtf8(std::string& out, unsigned long cp)
+        {
+            if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+                cp = 0xFFFD;
+
+            if (cp < 0x80)
+            {
+                out += static_cast<char>(cp);
+            }
+            else if (cp < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+    }
+
+    // ========================================================================
+    // bwxJsonReader
+    // ========================================================================
+
+    bwxJsonReader::bwxJsonReader(wxInputStream& stream, size_t bufferSize)
+        : m_stream(stream), m_buffer(std::max<size_t>(bufferSize, 16))
+    {
+    }
+
+    int bwxJsonReader::Peek()
+    {
+        if (m_pos == m_end)
+        {
+            if (m_eof) return -1;
+
+            m_offset += m_end;
+            m_stream.Read(m_buffer.data(), m_buffer.size());
+            m_end = m_stream.LastRead();
+            m_pos = 0;
+            if (m_end == 0)
+            {
+                m_eof = true;
+                return -1;
+            }
+        }
+        return static_cast<unsigned char>(m_buffer[m_pos]);
+    }
+
+    bwxJsonReader::Token bwxJsonReader::Fail(const char* message)
+    {
+        m_lastError = wxString::Format("Parse JSON error at %llu: %s", static_cast<unsigned long long>(GetOffset()), message);
+        m_token = TOKEN_ERROR;
+        return TOKEN_ERROR;
+    }
+
+    bool bwxJsonReader::SkipWhitespace()
+    {
+        for (;;)
+        {
+            const int c = Peek();
+            if (IsJsonSpace(c))
+            {
+                m_pos++;
+                continue;
+            }
+            if (c != '/') return true;
+
+            // Comments // and /* ... */ (accepted like bwxJSON does)
+            m_pos++;
+            const int kind = Peek();
+            if (kind == '/')
+            {
+                int ch;
+                while ((ch = Peek()) >= 0 && ch != '\n')
+                    m_pos++;
+            }
+            else if (kind == '*')
+            {
+                m_pos++;
+                bool star = false;
+                for (;;)
+                {
+                    const int ch = Peek();
+                    if (ch < 0) return false;
+                    m_pos++;
+                    if (star && ch == '/') break;
+                    star = ch == '*';
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    void bwxJsonReader::EndValue()
+    {
+        m_needComma = !m_stack.empty();
+        m_afterKey = false;
+    }
+
+    bwxJsonReader::Token bwxJsonReader::Next()
+    {
+        if (m_token == TOKEN_ERROR || m_token == TOKEN_END) return m_token;
+
+        // UTF-8 BOM
+        if (m_token == TOKEN_NONE && Peek() == 0xEF && m_end - m_pos >= 3 && std::memcmp(m_buffer.data() + m_pos, "\xEF\xBB\xBF", 3) == 0)
+            m_pos += 3;
+
+        if (!SkipWhitespace()) return Fail("invalid comment");
+        int c = Peek();
+
+        // Root level - next value of the stream or end of input
+        if (m_stack.empty())
+        {
+            if (c < 0) return m_token = TOKEN_END;
+            return m_token = ReadValueToken(c);
+        }
+
+        const char close = m_stack.back() == '{' ? '}' : ']';
+        if (c < 0) return Fail(close == '}' ? "unexpected end of JSON - missing closing `}`" : "unexpected end of JSON - missing closing `]`");
+
+        if (m_afterKey) return m_token = ReadValueToken(c);
+
+        if (m_needComma && c != close)
+        {
+            if (c != ',') return Fail("expected `,`");
+            m_pos++;
+            if (!SkipWhitespace()) return Fail("invalid comment");
+            c = Peek();
+            if (c < 0) return Fail("unexpected end of JSON");
+        }
+
+        // Closing bracket (trailing comma tolerated)
+        if (c == close)
+        {
+            m_pos++;
+            m_stack.pop_back();
+            EndValue();
+            return m_token = (close == '}' ? TOKEN_END_OBJECT : TOKEN_END_ARRAY);
+        }
+
+        if (close == ']') return m_token = ReadValueToken(c);
+
+        if (c != '"') return Fail("expected string key");
+        if (!ReadString()) return TOKEN_ERROR;
+
+        if (!SkipWhitespace()) return Fail("invalid comment");
+        if (Peek() != ':') return Fail("expected `:` after key");
+        m_pos++;
+
+        m_afterKey = true;
+        return m_token = TOKEN_KEY;
+    }
+
+    bwxJsonReader::Token bwxJsonReader::ReadValueToken(int c)
+    {
+        m_afterKey = false;
+
+        switch (c)
+        {
+        case '{':
+        case '[':
+            if (m_stack.size() >= JSON_MAX_DEPTH) return Fail("nesting too deep");
+            m_pos++;
+            m_stack.push_back(static_cast<char>(c));
+            m_needComma = false;
+            return c == '{' ? TOKEN_START_OBJECT : TOKEN_START_ARRAY;
+        case '"':
+            if (!ReadString()) return TOKEN_ERROR;
+            EndValue();
+            return TOKEN_STRING;
+        case 't':
+        case 'f':
+            if (!ReadWord(c == 't' ? "true" : "false")) return Fail("unknown literal");
+            m_bool = c == 't';
+            EndValue();
+            return TOKEN_BOOL;
+        case 'n':
+            if (!ReadWord("null")) return Fail("unknown literal");
+            EndValue();
+            return TOKEN_NULL;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) return ReadNumber();
+            return Fail("unexpected character");
+        }
+    }
+
+    bool bwxJsonReader::ReadString()
+    {
+        // Raw contents - escape sequences are kept, only the closing quote is searched for
+        m_text.clear();
+        m_pos++;
+
+        for (;;)
+        {
+            if (Peek() < 0)
+            {
+                Fail("missing closing `\"`");
+                return false;
+            }
+
+            const char* begin = m_buffer.data() + m_pos;
+            const char* end = m_buffer.data() + m_end;
+            const char* p = begin;
+            while (p != end && *p != '"' && *p != '\\')
+                ++p;
+
+            m_text.append(begin, p);
+            m_pos += p - begin;
+            if (p == end) continue;
+
+            m_pos++;
+            if (*p == '"') return true;
+
+            // Escaped character is copied as well (may be a quote)
+            m_text += '\\';
+            const int escaped = Peek();
+            if (escaped < 0) continue;
+            m_text += static_cast<char>(escaped);
+            m_pos++;
+        }
+    }
+
+    bwxJsonReader::Token bwxJsonReader::ReadNumber()
+    {
+        m_text.clear();
+        bool isDouble = false;
+        int c;
+        while (IsJsonNumberChar(c = Peek()))
+        {
+            isDouble = isDouble || c == '.' || c == 'e' || c == 'E';
+            m_text += static_cast<char>(c);
+            m_pos++;
+        }
+
+        const char* first = m_text.data();
+        const char* last = m_text.data() + m_text.size();
+
+        // Integers as int64, uint64 above its range, double beyond that
+        if (!isDouble)
+        {
+            auto result = std::from_chars(first, last, m_int);
+            if (result.ec == std::errc() && result.ptr == last)
+            {
+                m_uint = static_cast<uint64_t>(m_int);
+                EndValue();
+                return TOKEN_INT;
+            }
+
+            result = std::from_chars(first, last, m_uint);
+            if (result.ec == std::errc() && result.ptr == last)
+            {
+                m_int = static_cast<int64_t>(m_uint);
+                EndValue();
+                return TOKEN_UINT;
+            }
+        }
+
+        auto result = std::from_chars(first, last, m_double);
+        if (result.ptr != last) return Fail("invalid number");
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            // Valid JSON beyond double: a negative exponent underflowed (1e-400), anything else overflowed
+            const bool underflow = m_text.find("e-") != std::string::npos || m_text.find("E-") != std::string::npos;
+            m_double = std::copysign(underflow ? 0.0 : std::numeric_limits<double>::infinity(), m_text[0] == '-' ? -1.0 : 1.0);
+        }
+        else if (result.ec != std::errc())
+        {
+            return Fail("invalid number");
+        }
+
+        // Casting a double outside the integer range is undefined - integer getters saturate instead
+        constexpr double INT64_END = 9223372036854775808.0;    // 2^63
+        constexpr double UINT64_END = 18446744073709551616.0;  // 2^64
+        if (m_double >= INT64_END) m_int = std::numeric_limits<int64_t>::max();
+        else if (m_double < -INT64_END) m_int = std::numeric_limits<int64_t>::min();
+        else m_int = static_cast<int64_t>(m_double);
+
+        if (m_double >= UINT64_END) m_uint = std::numeric_limits<uint64_t>::max();
+        else if (m_double <= -1.0) m_uint = 0;
+        else m_uint = static_cast<uint64_t>(m_double);
+        EndValue();
+        return TOKEN_DOUBLE;
+    }
+
+    bool bwxJsonReader::ReadWord(const char* word)
+    {
+        for (; *word; ++word)
+        {
+            if (Peek() != static_cast<unsigned char>(*word)) return false;
+            m_pos++;
+        }
+        return true;
+    }
+
+    double bwxJsonReader::GetDouble() const
+    {
+        switch (m_token)
+        {
+        case TOKEN_INT: return static_cast<double>(m_int);
+        case TOKEN_UINT: return static_cast<double>(m_uint);
+        default: return m_double;
+        }
+    }
+
+    std::string bwxJsonReader::GetUtf8() const
+    {
+        if (m_text.find('\\') == std::string::npos) return m_text;
+
+        std::string out;
+        out.reserve(m_text.size());
+        for (size_t i = 0; i < m_text.size(); ++i)
+        {
+            const char c = m_text[i];
+            if (c != '\\' || i + 1 >= m_text.size())
+            {
+                out += c;
+                continue;
+            }
+
+            const char escaped = m_text[++i];
+            switch (escaped)
+            {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u':
+            {
+                unsigned long cp = 0;
+                if (!ReadHex4(m_text, i + 1, cp))
+                {
+                    out += "\\u";
+                    break;
+                }
+                i += 4;
+
+                // High surrogate - combine with following \uDC00..\uDFFF
+                unsigned long low = 0;
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 2 < m_text.size() && m_text[i + 1] == '\\' &&
+                    m_text[i + 2] == 'u' && ReadHex4(m_text, i + 3, low) && low >= 0xDC00 && low <= 0xDFFF)
+                {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                AppendUtf8(out, cp);
+                break;
+            }
+            default: out += escaped; break;  // \" \\ \/
+            }
+        }
+        return out;
+    }
+
+    wxString bwxJsonReader::GetString() const
+    {
+        const std::string text = GetUtf8();
+        return wxString::FromUTF8(text.data(), text.size());
+    }
+
+    bool bwxJsonReader::Skip()
+    {
+        if (m_token != TOKEN_START_OBJECT && m_token != TOKEN_START_ARRAY) return IsOk();
+
+        const size_t depth = m_stack.size();
+        while (m_stack.size() >= depth)
+        {
+            if (Next() == TOKEN_ERROR) return false;
+        }
+        return true;
+    }
+
+    bool bwxJsonReader::ReadValue(bwxJsonValue& value)
+    {
+        // Member value of the current key
+        if (m_token == TOKEN_KEY && Next() == TOKEN_ERROR) return false;
+
+        switch (m_token)
+        {
+        case TOKEN_START_OBJECT:
+        {
+            auto jsonObject = std::make_shared<bwxJSON>();
+            for (;;)
+            {
+                const Token token = Next();
+                if (token == TOKEN_END_OBJECT) break;
+                if (token != TOKEN_KEY) return false;
+
+                const wxString key = wxString::FromUTF8(m_text.data(), m_text.size());
+                if (Next() == TOKEN_ERROR || !ReadValue((*jsonObject)[key])) return false;
+            }
+            value = bwxJsonValue(std::move(jsonObject));
+            return true;
+        }
+        case TOKEN_START_ARRAY:
+        {
+            std::vector<bwxJsonValueHelper> jsonArray;
+            for (;;)
+            {
+                const Token token = Next();
+                if (token == TOKEN_END_ARRAY) break;
+                if (token == TOKEN_ERROR) return false;
+
+                jsonArray.emplace_back();
+                if (!ReadValue(jsonArray.back().value)) return false;
+            }
+            value = bwxJsonValue(std::move(jsonArray));
+            return true;
+        }
+        case TOKEN_STRING: value = bwxJsonValue(wxString::FromUTF8(m_text.data(), m_text.size())); return true;
+        case TOKEN_INT:
+            if (m_int >= std::numeric_limits<int>::min() && m_int <= std::numeric_limits<int>::max())
+                value = bwxJsonValue(static_cast<int>(m_int));
+            else
+                value = bwxJsonValue(m_int);
+            return true;
+        case TOKEN_UINT: value = bwxJsonValue(m_uint); return true;
+        case TOKEN_DOUBLE: value = bwxJsonValue(m_double); return true;
+        case TOKEN_BOOL: value = bwxJsonValue(m_bool); return true;
+        case TOKEN_NULL: value = bwxJsonValue(); return true;
+        default: return false;
+        }
+    }
+
+    // ========================================================================
+    // bwxJsonWriter
+    // ========================================================================
+
+    bwxJsonWriter::bwxJsonWriter(wxOutputStream& stream, int indent, size_t bufferSize)
+        : m_stream(stream), m_bufferSize(std::max<size_t>(bufferSize, 16)), m_indent(std::max(indent, 0))
+    {
+        m_buffer.reserve(m_bufferSize + 64);
+    }
+
+    bwxJsonWriter::~bwxJsonWriter()
+    {
+        Flush();
+    }
+
+    bool bwxJsonWriter::Flush()
+    {
+        if (!m_buffer.empty())
+        {
+            m_stream.Write(m_buffer.data(), m_buffer.size());
+            if (m_stream.LastWrite() != m_buffer.size())
+                m_ok = false;
+            m_buffer.clear();
+        }
+        return m_ok;
+    }
+
+    void bwxJsonWriter::FlushIfFull()
+    {
+        if (m_buffer.size() >= m_bufferSize)
+            Flush();
+    }
+
+    void bwxJsonWriter::NewLine()
+    {
+        if (m_indent == 0) return;
+
+        m_buffer += '\n';
+        m_buffer.append(m_hasItems.size() * m_indent, ' ');
+    }
+
+    void bwxJsonWriter::BeforeValue()
+    {
+        if (m_afterKey)
+        {
+            m_afterKey = false;
+            return;
+        }
+
+        // Root values one per line
+        if (m_hasItems.empty())
+        {
+            if (m_rootWritten) m_buffer += '\n';
+            m_rootWritten = true;
+            return;
+        }
+
+        if (m_hasItems.back()) m_buffer += ',';
+        m_hasItems.back() = true;
+        NewLine();
+    }
+
+    void bwxJsonWriter::StartObject()
+    {
+        BeforeValue();
+        m_buffer += '{';
+        m_hasItems.push_back(false);
+    }
+
+    void bwxJsonWriter::EndContainer(char close)
+    {
+        if (m_hasItems.empty())
+        {
+            m_ok = false;
+            return;
+        }
+
+        const bool hadItems = m_hasItems.back();
+        m_hasItems.pop_back();
+        if (hadItems) NewLine();
+        m_buffer += close;
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::EndObject()
+    {
+        EndContainer('}');
+    }
+
+    void bwxJsonWriter::StartArray()
+    {
+        BeforeValue();
+        m_buffer += '[';
+        m_hasItems.push_back(false);
+    }
+
+    void bwxJsonWriter::EndArray()
+    {
+        EndContainer(']');
+    }
+
+    void bwxJsonWriter::Key(std::string_view utf8)
+    {
+        BeforeValue();
+        m_buffer += '"';
+        bwxJSON::EscapeUtf8(utf8, m_buffer);
+        m_buffer += m_indent ? "\": " : "\":";
+        m_afterKey = true;
+    }
+
+    void bwxJsonWriter::Key(const wxString& key)
+    {
+        const wxScopedCharBuffer utf8 = key.utf8_str();
+        Key(std::string_view(utf8.data(), utf8.length()));
+    }
+
+    void bwxJsonWriter::RawKey(std::string_view utf8)
+    {
+        BeforeValue();
+        m_buffer += '"';
+        m_buffer += utf8;
+        m_buffer += m_indent ? "\": " : "\":";
+        m_afterKey = true;
+    }
+
+    void bwxJsonWriter::String(std::string_view utf8)
+    {
+        BeforeValue();
+        m_buffer += '"';
+        bwxJSON::EscapeUtf8(utf8, m_buffer);
+        m_buffer += '"';
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::String(const wxString& text)
+    {
+        const wxScopedCharBuffer utf8 = text.utf8_str();
+        String(std::string_view(utf8.data(), utf8.length()));
+    }
+
+    void bwxJsonWriter::RawString(std::string_view utf8)
+    {
+        BeforeValue();
+        m_buffer += '"';
+        m_buffer += utf8;
+        m_buffer += '"';
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::Int(int64_t value)
+    {
+        char number[24];
+        BeforeValue();
+        m_buffer.append(number, std::to_chars(number, number + sizeof(number), value).ptr);
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::UInt(uint64_t value)
+    {
+        char number[24];
+        BeforeValue();
+        m_buffer.append(number, std::to_chars(number, number + sizeof(number), value).ptr);
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::Double(double value)
+    {
+        // JSON has no NaN/infinity
+        if (!std::isfinite(value))
+        {
+            Null();
+            return;
+        }
+
+        char number[32];
+        BeforeValue();
+        char* end = std::to_chars(number, number + sizeof(number), value).ptr;
+        m_buffer.append(number, end);
+        if (std::find_if(number, end, [](char c) { return c == '.' || c == 'e'; }) == end) m_buffer += ".0";
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::Bool(bool value)
+    {
+        BeforeValue();
+        m_buffer += value ? "true" : "false";
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::Null()
+    {
+        BeforeValue();
+        m_buffer += "null";
+        FlushIfFull();
+    }
+
+    void bwxJsonWriter::Value(const bwxJsonValue& value)
+    {
+        if (!value.has_value())
+        {
+            Null();
+            return;
+        }
+
+        std::visit([this](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, std::nullptr_t>) Null();
+            else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int64_t>) Int(arg);
+            else if constexpr (std::is_same_v<T, uint64_t>) UInt(arg);
+            else if constexpr (std::is_same_v<T, double>) Double(arg);
+            else if constexpr (std::is_same_v<T, bool>) Bool(arg);
+            else if constexpr (std::is_same_v<T, std::string>) RawString(arg);
+            else if constexpr (std::is_same_v<T, wxString>) {
+                const wxScopedCharBuffer utf8 = arg.utf8_str();
+                RawString(std::string_view(utf8.data(), utf8.length()));
+            }
+            else if constexpr (std::is_same_v<T, std::shared_ptr<bwxJSON>>) {
+                if (arg) Value(*arg);
+                else Null();
+            }
+            else { // std::vector<bwxJsonValueHelper>
+                StartArray();
+                for (const auto& item : arg) Value(item.value);
+                EndArray();
+            }
+            }, *value);
+    }
+
+    void bwxJsonWriter::Value(const bwxJSON& object)
+    {
+        StartObject();
+        for (const auto& [key, value] : object)
+        {
+            const wxScopedCharBuffer utf8 = key.utf8_str();
+            RawKey(std::string_view(utf8.data(), utf8.length()));
+            Value(value);
+        }
+        EndObject();
+    }
+
+}
@@ -0,0 +1,252 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_log.cpp
+// Purpose:     BWX_SDK Library; Asynchronous, rate-limited logging
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_log.cpp
+ * @brief Implements the lock-free record ring and the writer thread of bwxLogger.
+ *
+ * The ring is a bounded MPSC queue: each slot carries a sequence number telling whether it is
+ * free for the producer of a given position or ready for the writer, so producers only need one
+ * compare-and-swap on the enqueue position.
+ */
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <bwx_sdk/bwx_core/bwx_datetime.h>
+#include <bwx_sdk/bwx_core/bwx_log.h>
+
+namespace bwx_sdk {
+
+	namespace {
+
+		constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(50);
+
+		const char* LevelName(bwxLogLevel level)
+		{
+			switch (level)
+			{
+			case BWX_LOGLEVEL_TRACE: return "TRACE";
+			case BWX_LOGLEVEL_DEBUG: return "DEBUG";
+			case BWX_LOGLEVEL_INFO: return "INFO";
+			case BWX_LOGLEVEL_WARNING: return "WARNING";
+			case BWX_LOGLEVEL_ERROR: return "ERROR";
+			default: return "";
+			}
+		}
+
+		wxLogLevel WxLevel(bwxLogLevel level)
+		{
+			switch (level)
+			{
+			case BWX_LOGLEVEL_TRACE:
+			case BWX_LOGLEVEL_DEBUG: return wxLOG_Debug;
+			case BWX_LOGLEVEL_INFO: return wxLOG_Info;
+			case BWX_LOGLEVEL_WARNING: return wxLOG_Warning;
+			default: return wxLOG_Error;
+			}
+		}
+
+	}
+
+	bwxLogger& bwxLogger::GetInstance()
+	{
+		static bwxLogger instance;
+		return instance;
+	}
+
+	bwxLogger::bwxLogger()
+		: m_slots(std::make_unique<Slot[]>(CAPACITY))
+	{
+		for (size_t i = 0; i < CAPACITY; i++) m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		m_writer = std::thread(&bwxLogger::WriterLoop, this);
+	}
+
+	bwxLogger::~bwxLogger()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_running = false;
+		}
+		m_wake.notify_all();
+
+		if (m_writer.joinable()) m_writer.join();
+	}
+
+	int64_t bwxLogger::Now()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	void bwxLogger::SetTargets(int targets)
+	{
+		std::lock_guard<std::mutex> lock(m_targetMutex);
+		m_targets = targets;
+	}
+
+	bool bwxLogger::SetFile(const wxString& filename)
+	{
+		std::lock_guard<std::mutex> lock(m_targetMutex);
+		if (m_file.IsOpened()) m_file.Close();
+
+		if (!m_file.Open(filename, "ab"))
+		{
+			m_targets &= ~BWX_LOG_TO_FILE;
+			return false;
+		}
+
+		m_targets |= BWX_LOG_TO_FILE;
+		return true;
+	}
+
+	void bwxLogger::Flush()
+	{
+		const size_t target = m_enqueue.load(std::memory_order_acquire);
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wake.notify_one();
+		m_flushed.wait(lock, [&]() { return m_written.load(std::memory_order_acquire) >= target || !m_running; });
+	}
+
+	bwxLogger::Record* bwxLogger::Claim(size_t& position)
+	{
+		position = m_enqueue.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot& slot = m_slots[position & (CAPACITY - 1)];
+			const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (difference == 0)
+			{
+				if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) return &slot.record;
+			}
+			else if (difference < 0)
+			{
+				// Full - the writer is a whole ring behind
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			else
+			{
+				position = m_enqueue.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void bwxLogger::Publish(size_t position)
+	{
+		m_slots[position & (CAPACITY - 1)].sequence.store(position + 1, std::memory_order_release);
+
+		// The writer polls; wake it early once per half of the ring
+		if (((position + 1) & (CAPACITY / 2 - 1)) == 0) m_wake.notify_one();
+	}
+
+	void bwxLogger::WriterLoop()
+	{
+		while (true)
+		{
+			const bool wrote = Drain();
+
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			if (wrote) m_flushed.notify_all();
+
+			if (!m_running)
+			{
+				lock.unlock();
+				Drain();
+				m_flushed.notify_all();
+				break;
+			}
+
+			if (!wrote) m_wake.wait_for(lock, WRITER_INTERVAL);
+		}
+	}
+
+	bool bwxLogger::Drain()
+	{
+		std::string fileBatch;
+		size_t count = 0;
+
+		while (true)
+		{
+			Slot& slot = m_slots[m_dequeue & (CAPACITY - 1)];
+			if (slot.sequence.load(std::memory_order_acquire) != m_dequeue + 1) break;
+
+			WriteRecord(slot.record, fileBatch);
+			slot.record.destroyPayload(slot.record.payload);
+
+			slot.sequence.store(m_dequeue + CAPACITY, std::memory_order_release);
+			m_dequeue++;
+			count++;
+		}
+
+		if (count == 0) return false;
+
+		const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+		if (dropped != m_reportedDropped)
+		{
+			WriteMessage(BWX_LOGLEVEL_WARNING, Now(), __FILE__, __LINE__,
+				wxString::Format("bwxLogger: %llu records dropped (ring full)", static_cast<unsigned long long>(dropped - m_reportedDropped)), fileBatch);
+			m_reportedDropped = dropped;
+		}
+
+		if (!fileBatch.empty())
+		{
+			std::lock_guard<std::mutex> lock(m_targetMutex);
+			if (m_file.IsOpened())
+			{
+				m_file.Write(fileBatch.data(), fileBatch.size());
+				m_file.Flush();
+			}
+		}
+
+		m_written.store(m_dequeue, std::memory_order_release);
+		return true;
+	}
+
+	void bwxLogger::WriteRecord(Record& record, std::string& fileBatch)
+	{
+		wxString message;
+		record.formatPayload(record.format, record.payload, message);
+		if (record.suppressed > 0) message += wxString::Format(" (%u similar messages suppressed)", record.suppressed);
+
+		WriteMessage(record.site->GetLevel(), record.time, record.site->GetFile(), record.site->GetLine(), message, fileBatch);
+	}
+
+	void bwxLogger::WriteMessage(bwxLogLevel level, int64_t time, const char* file, int line, const wxString& message, std::string& fileBatch)
+	{
+		int targets;
+		{
+			std::lock_guard<std::mutex> lock(m_targetMutex);
+			targets = m_targets;
+		}
+
+		if (targets & BWX_LOG_TO_WXLOG) wxLogGeneric(WxLevel(level), "%s", message);
+
+		if (targets & BWX_LOG_TO_FILE)
+		{
+			static const dt::bwxDateTimeFormat timeFormat("$YY-$M-$D $h:$m:$s.$ss ");
+			timeFormat.FormatTo(wxDateTime(wxLongLong(time)), fileBatch);
+
+			fileBatch += LevelName(level);
+			fileBatch += " [";
+			fileBatch += file;
+			fileBatch += ':';
+			fileBatch += std::to_string(line);
+			fileBatch += "] ";
+			fileBatch += message.utf8_str().data();
+			fileBatch += '\n';
+		}
+	}
+
+}
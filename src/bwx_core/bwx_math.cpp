@@ -18,6 +18,9 @@
 #include <wx/wx.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <random>
 #include <bwx_sdk/bwx_core/bwx_math.h>
 
@@ -100,5 +103,186 @@ namespace bwx_sdk {
 			return 1.0f / y;
 		}
 
+		namespace {
+
+			struct ThreadRandom
+			{
+				bwxRandomGenerator generator;
+				uint64_t epoch = UINT64_MAX;  ///< Global seed the generator comes from
+			};
+
+			thread_local ThreadRandom threadRandom;
+
+			std::mutex seedMutex;
+			uint64_t globalSeed = 0;
+			bool globalSeeded = false;
+			uint64_t nextStream = 0;
+			std::atomic<uint64_t> seedEpoch{ 0 };
+
+			void ReseedThread(ThreadRandom& state)
+			{
+				std::lock_guard<std::mutex> lock(seedMutex);
+				if (!globalSeeded)
+				{
+					std::random_device device;
+					globalSeed = ((static_cast<uint64_t>(device()) << 32) | device()) ^ static_cast<uint64_t>(std::time(nullptr));
+					globalSeeded = true;
+				}
+
+				// Stream n = n jumps from the seed, so threads never share a sequence
+				state.generator.Seed(globalSeed);
+				for (uint64_t stream = nextStream++; stream > 0; --stream) state.generator.Jump();
+				state.epoch = seedEpoch.load(std::memory_order_relaxed);
+			}
+
+			/// Four xoshiro256** generators as a structure of arrays, so one step can use SIMD
+			struct LaneGenerator
+			{
+				static constexpr size_t LANES = 4;
+
+				explicit LaneGenerator(bwxRandomGenerator& source)
+				{
+					for (size_t lane = 0; lane < LANES; lane++)
+					{
+						bwxSplitMix64 mix(source());
+						s0[lane] = mix();
+						s1[lane] = mix();
+						s2[lane] = mix();
+						s3[lane] = mix();
+					}
+				}
+
+				inline void Next(uint64_t (&out)[LANES])
+				{
+					for (size_t lane = 0; lane < LANES; lane++)
+					{
+						const uint64_t x = s1[lane] * 5;
+						const uint64_t r = (x << 7) | (x >> 57);
+						out[lane] = r * 9;
+
+						const uint64_t t = s1[lane] << 17;
+						s2[lane] ^= s0[lane];
+						s3[lane] ^= s1[lane];
+						s1[lane] ^= s2[lane];
+						s0[lane] ^= s3[lane];
+						s2[lane] ^= t;
+						s3[lane] = (s3[lane] << 45) | (s3[lane] >> 19);
+					}
+				}
+
+				uint64_t s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+			};
+
+			template <typename T, typename Convert>
+			void FillLanes(std::span<T> values, bwxRandomGenerator& source, Convert convert)
+			{
+				constexpr size_t LANES = LaneGenerator::LANES;
+
+				size_t i = 0;
+				if (values.size() >= 4 * LANES)
+				{
+					LaneGenerator lanes(source);
+					uint64_t block[LANES];
+					for (; i + LANES <= values.size(); i += LANES)
+					{
+						lanes.Next(block);
+						for (size_t lane = 0; lane < LANES; lane++) values[i + lane] = convert(block[lane]);
+					}
+				}
+
+				for (; i < values.size(); i++) values[i] = convert(source());
+			}
+
+			template <typename T>
+			void FillIntegers(std::span<T> values, T min, T max)
+			{
+				using U = std::make_unsigned_t<T>;
+				if (max <= min)
+				{
+					std::fill(values.begin(), values.end(), min);
+					return;
+				}
+
+				// 32-bit Lemire: high half of (x >> 32) * range, rejecting the incomplete last interval
+				const uint64_t range = static_cast<uint64_t>(static_cast<U>(max) - static_cast<U>(min)) + 1;
+				const uint64_t threshold = ((1ULL << 32) - range) % range;
+
+				bwxRandomGenerator& source = bwxGetThreadRandom();
+				FillLanes(values, source, [&](uint64_t x) {
+					uint64_t product = (x >> 32) * range;
+					while ((product & 0xffffffffULL) < threshold) product = (source() >> 32) * range;
+					return static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(product >> 32)));
+				});
+			}
+
+		}
+
+		void bwxXoshiro256::Jump()
+		{
+			static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+			uint64_t state[4] = {};
+			for (uint64_t word : JUMP)
+			{
+				for (int bit = 0; bit < 64; bit++)
+				{
+					if (word & (1ULL << bit))
+					{
+						for (int i = 0; i < 4; i++) state[i] ^= m_state[i];
+					}
+					(*this)();
+				}
+			}
+
+			for (int i = 0; i < 4; i++) m_state[i] = state[i];
+		}
+
+		bwxRandomGenerator& bwxGetThreadRandom()
+		{
+			ThreadRandom& state = threadRandom;
+			if (state.epoch != seedEpoch.load(std::memory_order_acquire)) ReseedThread(state);
+			return state.generator;
+		}
+
+		void bwxSetRandomSeed(uint64_t seed)
+		{
+			std::lock_guard<std::mutex> lock(seedMutex);
+			globalSeed = seed;
+			globalSeeded = true;
+			nextStream = 1;
+
+			// The calling thread takes stream 0 now, the others on their next draw
+			threadRandom.generator.Seed(seed);
+			threadRandom.epoch = seedEpoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+		}
+
+		void bwxSetThreadRandomSeed(uint64_t seed)
+		{
+			threadRandom.generator.Seed(seed);
+			threadRandom.epoch = seedEpoch.load(std::memory_order_acquire);
+		}
+
+		void bwxFillRandom(std::span<int> values, int min, int max)
+		{
+			FillIntegers(values, min, max);
+		}
+
+		void bwxFillRandom(std::span<unsigned int> values, unsigned int min, unsigned int max)
+		{
+			FillIntegers(values, min, max);
+		}
+
+		void bwxFillRandom(std::span<float> values, float min, float max)
+		{
+			const float scale = (max - min) * 0x1.0p-24f;
+			FillLanes(values, bwxGetThreadRandom(), [=](uint64_t x) { return min + static_cast<float>(x >> 40) * scale; });
+		}
+
+		void bwxFillRandom(std::span<double> values, double min, double max)
+		{
+			const double scale = (max - min) * 0x1.0p-53;
+			FillLanes(values, bwxGetThreadRandom(), [=](uint64_t x) { return min + static_cast<double>(x >> 11) * scale; });
+		}
+
 	} // namespace math
 } // namespace bwx_sdk
@@ -0,0 +1,424 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_math_simd.cpp
+// Purpose:     BWX_SDK Library; Batch math kernels with run-time SIMD dispatch
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_math_simd.cpp
+ * @brief Implements the span versions of the bwx_math helpers.
+ *
+ * Every kernel has a scalar version (also used for the tail of the SIMD loops), an SSE2 and an
+ * AVX2 version on x86 and a NEON version on ARM64. AVX2 code is compiled with a target attribute,
+ * so the library needs no extra compiler flags; it runs only when the CPU and OS support it.
+ */
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <bwx_sdk/bwx_core/bwx_math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BWX_MATH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define BWX_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(BWX_MATH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BWX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BWX_TARGET_AVX2
+#endif
+
+namespace bwx_sdk {
+	namespace math {
+
+		namespace {
+
+			struct Kernels
+			{
+				const char* name;
+				void (*sqrt)(const float* in, float* out, size_t count);
+				void (*rsqrt)(const float* in, float* out, size_t count);
+				void (*distance)(const float* x1, const float* y1, const float* x2, const float* y2, float* out, size_t count);
+				void (*lerp)(const float* a, const float* b, float t, float* out, size_t count);
+				void (*clamp)(const float* in, float lo, float hi, float* out, size_t count);
+				void (*affine)(const float* in, float inOffset, float scale, float outOffset, float* out, size_t count);  ///< outOffset + (in - inOffset) * scale
+			};
+
+			// Scalar
+
+			void SqrtScalar(const float* in, float* out, size_t count)
+			{
+				for (size_t i = 0; i < count; i++) out[i] = std::sqrt(in[i]);
+			}
+
+			void RsqrtScalar(const float* in, float* out, size_t count)
+			{
+				for (size_t i = 0; i < count; i++) out[i] = 1.0f / std::sqrt(in[i]);
+			}
+
+			void DistanceScalar(const float* x1, const float* y1, const float* x2, const float* y2, float* out, size_t count)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					const float dx = x2[i] - x1[i];
+					const float dy = y2[i] - y1[i];
+					out[i] = std::sqrt(dx * dx + dy * dy);
+				}
+			}
+
+			void LerpScalar(const float* a, const float* b, float t, float* out, size_t count)
+			{
+				for (size_t i = 0; i < count; i++) out[i] = a[i] + t * (b[i] - a[i]);
+			}
+
+			void ClampScalar(const float* in, float lo, float hi, float* out, size_t count)
+			{
+				for (size_t i = 0; i < count; i++) out[i] = std::min(std::max(in[i], lo), hi);
+			}
+
+			void AffineScalar(const float* in, float inOffset, float scale, float outOffset, float* out, size_t count)
+			{
+				for (size_t i = 0; i < count; i++) out[i] = outOffset + (in[i] - inOffset) * scale;
+			}
+
+#if !defined(BWX_MATH_X86) && !defined(BWX_MATH_NEON)
+			const Kernels SCALAR_KERNELS = { "scalar", SqrtScalar, RsqrtScalar, DistanceScalar, LerpScalar, ClampScalar, AffineScalar };
+#endif
+
+#if defined(BWX_MATH_X86)
+			// SSE2 (always available on x86-64)
+
+			void SqrtSse2(const float* in, float* out, size_t count)
+			{
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_loadu_ps(in + i)));
+				SqrtScalar(in + i, out + i, count - i);
+			}
+
+			void RsqrtSse2(const float* in, float* out, size_t count)
+			{
+				const __m128 half = _mm_set1_ps(0.5f);
+				const __m128 threeHalves = _mm_set1_ps(1.5f);
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 x = _mm_loadu_ps(in + i);
+					const __m128 estimate = _mm_rsqrt_ps(x);
+
+					// One Newton-Raphson step: y * (1.5 - 0.5 * x * y * y); 0 and inf keep the estimate
+					const __m128 refined = _mm_mul_ps(estimate, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, x), _mm_mul_ps(estimate, estimate))));
+					const __m128 special = _mm_or_ps(_mm_cmpeq_ps(x, zero), _mm_cmpeq_ps(x, infinity));
+					_mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(special, estimate), _mm_andnot_ps(special, refined)));
+				}
+				RsqrtScalar(in + i, out + i, count - i);
+			}
+
+			void DistanceSse2(const float* x1, const float* y1, const float* x2, const float* y2, float* out, size_t count)
+			{
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x2 + i), _mm_loadu_ps(x1 + i));
+					const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y2 + i), _mm_loadu_ps(y1 + i));
+					_mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))));
+				}
+				DistanceScalar(x1 + i, y1 + i, x2 + i, y2 + i, out + i, count - i);
+			}
+
+			void LerpSse2(const float* a, const float* b, float t, float* out, size_t count)
+			{
+				const __m128 factor = _mm_set1_ps(t);
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 va = _mm_loadu_ps(a + i);
+					_mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(factor, _mm_sub_ps(_mm_loadu_ps(b + i), va))));
+				}
+				LerpScalar(a + i, b + i, t, out + i, count - i);
+			}
+
+			void ClampSse2(const float* in, float lo, float hi, float* out, size_t count)
+			{
+				const __m128 vlo = _mm_set1_ps(lo);
+				const __m128 vhi = _mm_set1_ps(hi);
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), vlo), vhi));
+				ClampScalar(in + i, lo, hi, out + i, count - i);
+			}
+
+			void AffineSse2(const float* in, float inOffset, float scale, float outOffset, float* out, size_t count)
+			{
+				const __m128 vin = _mm_set1_ps(inOffset);
+				const __m128 vscale = _mm_set1_ps(scale);
+				const __m128 vout = _mm_set1_ps(outOffset);
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) _mm_storeu_ps(out + i, _mm_add_ps(vout, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(in + i), vin), vscale)));
+				AffineScalar(in + i, inOffset, scale, outOffset, out + i, count - i);
+			}
+
+			const Kernels SSE2_KERNELS = { "SSE2", SqrtSse2, RsqrtSse2, DistanceSse2, LerpSse2, ClampSse2, AffineSse2 };
+
+			// AVX2
+
+			BWX_TARGET_AVX2 void SqrtAvx2(const float* in, float* out, size_t count)
+			{
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8) _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_loadu_ps(in + i)));
+				SqrtSse2(in + i, out + i, count - i);
+			}
+
+			BWX_TARGET_AVX2 void RsqrtAvx2(const float* in, float* out, size_t count)
+			{
+				const __m256 half = _mm256_set1_ps(0.5f);
+				const __m256 threeHalves = _mm256_set1_ps(1.5f);
+				const __m256 zero = _mm256_setzero_ps();
+				const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 x = _mm256_loadu_ps(in + i);
+					const __m256 estimate = _mm256_rsqrt_ps(x);
+					const __m256 refined = _mm256_mul_ps(estimate, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, x), _mm256_mul_ps(estimate, estimate))));
+					const __m256 special = _mm256_or_ps(_mm256_cmp_ps(x, zero, _CMP_EQ_OQ), _mm256_cmp_ps(x, infinity, _CMP_EQ_OQ));
+					_mm256_storeu_ps(out + i, _mm256_blendv_ps(refined, estimate, special));
+				}
+				RsqrtSse2(in + i, out + i, count - i);
+			}
+
+			BWX_TARGET_AVX2 void DistanceAvx2(const float* x1, const float* y1, const float* x2, const float* y2, float* out, size_t count)
+			{
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x2 + i), _mm256_loadu_ps(x1 + i));
+					const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y2 + i), _mm256_loadu_ps(y1 + i));
+					_mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))));
+				}
+				DistanceSse2(x1 + i, y1 + i, x2 + i, y2 + i, out + i, count - i);
+			}
+
+			BWX_TARGET_AVX2 void LerpAvx2(const float* a, const float* b, float t, float* out, size_t count)
+			{
+				const __m256 factor = _mm256_set1_ps(t);
+
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 va = _mm256_loadu_ps(a + i);
+					_mm256_storeu_ps(out + i, _mm256_add_ps(va, _mm256_mul_ps(factor, _mm256_sub_ps(_mm256_loadu_ps(b + i), va))));
+				}
+				LerpSse2(a + i, b + i, t, out + i, count - i);
+			}
+
+			BWX_TARGET_AVX2 void ClampAvx2(const float* in, float lo, float hi, float* out, size_t count)
+			{
+				const __m256 vlo = _mm256_set1_ps(lo);
+				const __m256 vhi = _mm256_set1_ps(hi);
+
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8) _mm256_storeu_ps(out + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(in + i), vlo), vhi));
+				ClampSse2(in + i, lo, hi, out + i, count - i);
+			}
+
+			BWX_TARGET_AVX2 void AffineAvx2(const float* in, float inOffset, float scale, float outOffset, float* out, size_t count)
+			{
+				const __m256 vin = _mm256_set1_ps(inOffset);
+				const __m256 vscale = _mm256_set1_ps(scale);
+				const __m256 vout = _mm256_set1_ps(outOffset);
+
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8) _mm256_storeu_ps(out + i, _mm256_add_ps(vout, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i), vin), vscale)));
+				AffineSse2(in + i, inOffset, scale, outOffset, out + i, count - i);
+			}
+
+			const Kernels AVX2_KERNELS = { "AVX2", SqrtAvx2, RsqrtAvx2, DistanceAvx2, LerpAvx2, ClampAvx2, AffineAvx2 };
+
+			bool HasAvx2()
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7) return false;
+
+				// AVX and OSXSAVE, then the OS must save the YMM registers (XCR0 bits 1 and 2)
+				__cpuid(info, 1);
+				if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+				if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+				__cpuidex(info, 7, 0);
+				return (info[1] & (1 << 5)) != 0;
+#else
+				// Checks the OS support of the YMM registers too
+				return __builtin_cpu_supports("avx2");
+#endif
+			}
+#endif
+
+#if defined(BWX_MATH_NEON)
+			// NEON (always available on ARM64)
+
+			void SqrtNeon(const float* in, float* out, size_t count)
+			{
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) vst1q_f32(out + i, vsqrtq_f32(vld1q_f32(in + i)));
+				SqrtScalar(in + i, out + i, count - i);
+			}
+
+			void RsqrtNeon(const float* in, float* out, size_t count)
+			{
+				const float32x4_t zero = vdupq_n_f32(0.0f);
+				const float32x4_t infinity = vdupq_n_f32(std::numeric_limits<float>::infinity());
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const float32x4_t x = vld1q_f32(in + i);
+					const float32x4_t estimate = vrsqrteq_f32(x);
+
+					// The NEON estimate has 8 bits - two Newton-Raphson steps; 0 and inf keep the estimate
+					float32x4_t refined = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(x, estimate), estimate));
+					refined = vmulq_f32(refined, vrsqrtsq_f32(vmulq_f32(x, refined), refined));
+					const uint32x4_t special = vorrq_u32(vceqq_f32(x, zero), vceqq_f32(x, infinity));
+					vst1q_f32(out + i, vbslq_f32(special, estimate, refined));
+				}
+				RsqrtScalar(in + i, out + i, count - i);
+			}
+
+			void DistanceNeon(const float* x1, const float* y1, const float* x2, const float* y2, float* out, size_t count)
+			{
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const float32x4_t dx = vsubq_f32(vld1q_f32(x2 + i), vld1q_f32(x1 + i));
+					const float32x4_t dy = vsubq_f32(vld1q_f32(y2 + i), vld1q_f32(y1 + i));
+					vst1q_f32(out + i, vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy))));
+				}
+				DistanceScalar(x1 + i, y1 + i, x2 + i, y2 + i, out + i, count - i);
+			}
+
+			void LerpNeon(const float* a, const float* b, float t, float* out, size_t count)
+			{
+				const float32x4_t factor = vdupq_n_f32(t);
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const float32x4_t va = vld1q_f32(a + i);
+					vst1q_f32(out + i, vaddq_f32(va, vmulq_f32(factor, vsubq_f32(vld1q_f32(b + i), va))));
+				}
+				LerpScalar(a + i, b + i, t, out + i, count - i);
+			}
+
+			void ClampNeon(const float* in, float lo, float hi, float* out, size_t count)
+			{
+				const float32x4_t vlo = vdupq_n_f32(lo);
+				const float32x4_t vhi = vdupq_n_f32(hi);
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) vst1q_f32(out + i, vminq_f32(vmaxq_f32(vld1q_f32(in + i), vlo), vhi));
+				ClampScalar(in + i, lo, hi, out + i, count - i);
+			}
+
+			void AffineNeon(const float* in, float inOffset, float scale, float outOffset, float* out, size_t count)
+			{
+				const float32x4_t vin = vdupq_n_f32(inOffset);
+				const float32x4_t vscale = vdupq_n_f32(scale);
+				const float32x4_t vout = vdupq_n_f32(outOffset);
+
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) vst1q_f32(out + i, vaddq_f32(vout, vmulq_f32(vsubq_f32(vld1q_f32(in + i), vin), vscale)));
+				AffineScalar(in + i, inOffset, scale, outOffset, out + i, count - i);
+			}
+
+			const Kernels NEON_KERNELS = { "NEON", SqrtNeon, RsqrtNeon, DistanceNeon, LerpNeon, ClampNeon, AffineNeon };
+#endif
+
+			const Kernels& SelectKernels()
+			{
+#if defined(BWX_MATH_X86)
+				return HasAvx2() ? AVX2_KERNELS : SSE2_KERNELS;
+#elif defined(BWX_MATH_NEON)
+				return NEON_KERNELS;
+#else
+				return SCALAR_KERNELS;
+#endif
+			}
+
+			inline const Kernels& GetKernels()
+			{
+				static const Kernels& kernels = SelectKernels();
+				return kernels;
+			}
+
+		}
+
+		void bwxSqrt(std::span<const float> values, std::span<float> out)
+		{
+			GetKernels().sqrt(values.data(), out.data(), std::min(values.size(), out.size()));
+		}
+
+		void bwxRsqrt(std::span<const float> values, std::span<float> out)
+		{
+			GetKernels().rsqrt(values.data(), out.data(), std::min(values.size(), out.size()));
+		}
+
+		void bwxDistance2D(std::span<const float> x1, std::span<const float> y1, std::span<const float> x2, std::span<const float> y2, std::span<float> out)
+		{
+			const size_t count = std::min({ x1.size(), y1.size(), x2.size(), y2.size(), out.size() });
+			GetKernels().distance(x1.data(), y1.data(), x2.data(), y2.data(), out.data(), count);
+		}
+
+		void bwxLerp(std::span<const float> a, std::span<const float> b, float t, std::span<float> out)
+		{
+			GetKernels().lerp(a.data(), b.data(), t, out.data(), std::min({ a.size(), b.size(), out.size() }));
+		}
+
+		void bwxClamp(std::span<const float> values, float minVal, float maxVal, std::span<float> out)
+		{
+			GetKernels().clamp(values.data(), minVal, maxVal, out.data(), std::min(values.size(), out.size()));
+		}
+
+		void bwxNormalize(std::span<const float> values, float minVal, float maxVal, std::span<float> out)
+		{
+			// Same result as the scalar bwxNormalize() for minVal == maxVal: 0
+			const float scale = (minVal == maxVal) ? 0.0f : 1.0f / (maxVal - minVal);
+			GetKernels().affine(values.data(), minVal, scale, 0.0f, out.data(), std::min(values.size(), out.size()));
+		}
+
+		void bwxRemap(std::span<const float> values, float inMin, float inMax, float outMin, float outMax, std::span<float> out)
+		{
+			const float scale = (inMin == inMax) ? 0.0f : (outMax - outMin) / (inMax - inMin);
+			GetKernels().affine(values.data(), inMin, scale, outMin, out.data(), std::min(values.size(), out.size()));
+		}
+
+		const char* bwxGetSimdLevel()
+		{
+			return GetKernels().name;
+		}
+
+	} // namespace math
+} // namespace bwx_sdk
@@ -0,0 +1,211 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_metrics.cpp
+// Purpose:     BWX_SDK Library; Runtime metrics: counters, gauges and histograms
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_metrics.cpp
+ * @brief Implements the histogram buckets, the metrics registry and its snapshots.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
+
+namespace bwx_sdk {
+
+	namespace {
+
+		// Bucket i holds values up to 2^(i + MIN_EXP); the last one everything above
+		size_t BucketIndex(double value)
+		{
+			if (!(value > 0.0)) return 0;
+			const int exponent = std::ilogb(value) + 1;  // value < 2^exponent
+			const int index = exponent - BWX_METRIC_HISTOGRAM_MIN_EXP;
+			return static_cast<size_t>(std::clamp(index, 0, BWX_METRIC_HISTOGRAM_BUCKETS - 1));
+		}
+
+		double BucketUpperBound(size_t index)
+		{
+			return std::ldexp(1.0, static_cast<int>(index) + BWX_METRIC_HISTOGRAM_MIN_EXP);
+		}
+
+	}
+
+	void bwxMetricHistogram::Record(double value)
+	{
+		if (value < 0.0 || std::isnan(value)) value = 0.0;
+
+		m_buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		m_sum.fetch_add(value, std::memory_order_relaxed);
+
+		double current = m_min.load(std::memory_order_relaxed);
+		while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+		current = m_max.load(std::memory_order_relaxed);
+		while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+
+		// Last, so a reader never sees a count without its bucket
+		m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	double bwxMetricHistogram::GetMin() const
+	{
+		return GetCount() ? m_min.load(std::memory_order_relaxed) : 0.0;
+	}
+
+	double bwxMetricHistogram::GetMax() const
+	{
+		return GetCount() ? m_max.load(std::memory_order_relaxed) : 0.0;
+	}
+
+	double bwxMetricHistogram::GetPercentile(double fraction) const
+	{
+		const uint64_t count = GetCount();
+		if (count == 0) return 0.0;
+
+		const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * count)));
+		uint64_t seen = 0;
+		for (size_t i = 0; i < m_buckets.size(); ++i)
+		{
+			seen += m_buckets[i].load(std::memory_order_relaxed);
+			if (seen >= rank) return std::clamp(BucketUpperBound(i), GetMin(), GetMax());
+		}
+		return GetMax();
+	}
+
+	void bwxMetricHistogram::Reset()
+	{
+		for (auto& bucket : m_buckets) bucket.store(0, std::memory_order_relaxed);
+		m_count.store(0, std::memory_order_relaxed);
+		m_sum.store(0.0, std::memory_order_relaxed);
+		m_min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+		m_max.store(0.0, std::memory_order_relaxed);
+	}
+
+	bwxMetrics& bwxMetrics::GetInstance()
+	{
+		// Never destroyed: static handles of other objects may be used during static destruction
+		static bwxMetrics* instance = new bwxMetrics();
+		return *instance;
+	}
+
+	bwxMetricCounter& bwxMetrics::GetCounter(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& metric = m_counters[name];
+		if (!metric) metric = std::make_unique<bwxMetricCounter>();
+		return *metric;
+	}
+
+	bwxMetricGauge& bwxMetrics::GetGauge(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& metric = m_gauges[name];
+		if (!metric) metric = std::make_unique<bwxMetricGauge>();
+		return *metric;
+	}
+
+	bwxMetricHistogram& bwxMetrics::GetHistogram(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& metric = m_histograms[name];
+		if (!metric) metric = std::make_unique<bwxMetricHistogram>();
+		return *metric;
+	}
+
+	std::vector<bwxMetricSnapshot> bwxMetrics::GetSnapshot() const
+	{
+		std::vector<bwxMetricSnapshot> snapshot;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		snapshot.reserve(m_counters.size() + m_gauges.size() + m_histograms.size());
+
+		for (const auto& [name, counter] : m_counters)
+		{
+			bwxMetricSnapshot entry;
+			entry.name = name;
+			entry.type = BWX_METRIC_COUNTER;
+			entry.value = static_cast<int64_t>(counter->Get());
+			snapshot.push_back(std::move(entry));
+		}
+		for (const auto& [name, gauge] : m_gauges)
+		{
+			bwxMetricSnapshot entry;
+			entry.name = name;
+			entry.type = BWX_METRIC_GAUGE;
+			entry.value = gauge->Get();
+			snapshot.push_back(std::move(entry));
+		}
+		for (const auto& [name, histogram] : m_histograms)
+		{
+			bwxMetricSnapshot entry;
+			entry.name = name;
+			entry.type = BWX_METRIC_HISTOGRAM;
+			entry.count = histogram->GetCount();
+			entry.sum = histogram->GetSum();
+			entry.min = histogram->GetMin();
+			entry.max = histogram->GetMax();
+			entry.p50 = histogram->GetPercentile(0.50);
+			entry.p95 = histogram->GetPercentile(0.95);
+			entry.p99 = histogram->GetPercentile(0.99);
+			snapshot.push_back(std::move(entry));
+		}
+
+		std::sort(snapshot.begin(), snapshot.end(), [](const bwxMetricSnapshot& a, const bwxMetricSnapshot& b) { return a.name < b.name; });
+		return snapshot;
+	}
+
+	bwxJSON bwxMetrics::ToJSON() const
+	{
+		auto counters = std::make_shared<bwxJSON>();
+		auto gauges = std::make_shared<bwxJSON>();
+		auto histograms = std::make_shared<bwxJSON>();
+
+		for (const bwxMetricSnapshot& entry : GetSnapshot())
+		{
+			const wxString name = wxString::FromUTF8(entry.name);
+			switch (entry.type)
+			{
+			case BWX_METRIC_COUNTER:
+				counters->SetValue(name, static_cast<uint64_t>(entry.value));
+				break;
+			case BWX_METRIC_GAUGE:
+				gauges->SetValue(name, entry.value);
+				break;
+			case BWX_METRIC_HISTOGRAM:
+			{
+				auto histogram = std::make_shared<bwxJSON>();
+				histogram->SetValue("count", entry.count);
+				histogram->SetValue("sum", entry.sum);
+				histogram->SetValue("min", entry.min);
+				histogram->SetValue("max", entry.max);
+				histogram->SetValue("mean", entry.count ? entry.sum / static_cast<double>(entry.count) : 0.0);
+				histogram->SetValue("p50", entry.p50);
+				histogram->SetValue("p95", entry.p95);
+				histogram->SetValue("p99", entry.p99);
+				histograms->SetValue(name, histogram);
+				break;
+			}
+			}
+		}
+
+		bwxJSON json;
+		json.SetValue("counters", counters);
+		json.SetValue("gauges", gauges);
+		json.SetValue("histograms", histograms);
+		return json;
+	}
+
+	void bwxMetrics::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& [name, counter] : m_counters) counter->Reset();
+		for (auto& [name, histogram] : m_histograms) histogram->Reset();
+	}
+
+}
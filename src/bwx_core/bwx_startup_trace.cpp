@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_startup_trace.cpp
+// Purpose:     BWX_SDK Library; Startup timeline of SDK init phases (Chrome trace format)
+// Author:      Bartosz Warzocha
+// Created:     2026-10-15
+// RCS-ID:
+// Copyright:   (c) Bartosz Warzocha (bartosz.warzocha@gmail.com)
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file bwx_startup_trace.cpp
+ * @brief Implements the startup event log and its Chrome trace export.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
+#include <bwx_sdk/bwx_core/bwx_startup_trace.h>
+
+namespace bwx_sdk {
+
+	namespace {
+
+		// Static initialisation of the library - as close to process start as the SDK gets
+		const std::chrono::steady_clock::time_point TRACE_ORIGIN = std::chrono::steady_clock::now();
+
+		void AppendEscaped(std::string& out, const std::string& text)
+		{
+			for (const char c : text)
+			{
+				switch (c)
+				{
+				case '"': out += "\\\""; break;
+				case '\\': out += "\\\\"; break;
+				case '\n': out += "\\n"; break;
+				case '\t': out += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						char code[8];
+						std::snprintf(code, sizeof(code), "\\u%04x", c);
+						out += code;
+					}
+					else out += c;
+				}
+			}
+		}
+
+	}
+
+	bwxStartupTrace& bwxStartupTrace::GetInstance()
+	{
+		// Never destroyed: workers may still finish a phase during static destruction
+		static bwxStartupTrace* instance = new bwxStartupTrace();
+		return *instance;
+	}
+
+	void bwxStartupTrace::Enable(bool enable)
+	{
+		if (enable)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			GetThreadIndex();
+		}
+		m_enabled.store(enable, std::memory_order_relaxed);
+	}
+
+	int64_t bwxStartupTrace::Now()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - TRACE_ORIGIN).count();
+	}
+
+	void bwxStartupTrace::Record(const std::string& name, const char* category, int64_t startUs, int64_t durationUs)
+	{
+		if (!IsEnabled()) return;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_events.size() >= BWX_STARTUP_TRACE_MAX_EVENTS) return;
+
+		bwxStartupEvent event;
+		event.name = name;
+		event.category = category ? category : "";
+		event.startUs = startUs;
+		event.durationUs = durationUs;
+		event.thread = GetThreadIndex();
+		m_events.push_back(std::move(event));
+	}
+
+	void bwxStartupTrace::Mark(const std::string& name, const char* category)
+	{
+		Record(name, category, Now(), -1);
+	}
+
+	void bwxStartupTrace::MarkInteractive()
+	{
+		const int64_t now = Now();
+		int64_t expected = -1;
+		if (!m_interactiveUs.compare_exchange_strong(expected, now, std::memory_order_relaxed)) return;
+
+		BWX_METRIC_GAUGE("core.startup.interactive_ms").Set(now / 1000);
+		Record("interactive", "startup", now, -1);
+	}
+
+	std::vector<bwxStartupEvent> bwxStartupTrace::GetEvents() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_events;
+	}
+
+	std::string bwxStartupTrace::ToChromeTrace() const
+	{
+		const std::vector<bwxStartupEvent> events = GetEvents();
+
+		std::string out = "{\"traceEvents\":[";
+		bool first = true;
+		for (const bwxStartupEvent& event : events)
+		{
+			if (!first) out += ",";
+			first = false;
+
+			out += "\n{\"name\":\"";
+			AppendEscaped(out, event.name);
+			out += "\",\"cat\":\"";
+			AppendEscaped(out, event.category);
+			out += event.durationUs < 0 ? "\",\"ph\":\"i\",\"s\":\"p\"" : "\",\"ph\":\"X\",\"dur\":" + std::to_string(event.durationUs);
+			out += ",\"ts\":" + std::to_string(event.startUs);
+			out += ",\"pid\":1,\"tid\":" + std::to_string(event.thread) + "}";
+		}
+
+		// Track names; thread 1 enabled the trace
+		uint32_t threads = 0;
+		for (const bwxStartupEvent& event : events) threads = std::max(threads, event.thread);
+		for (uint32_t thread = 1; thread <= threads; ++thread)
+		{
+			if (!first) out += ",";
+			first = false;
+			out += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(thread) + ",\"args\":{\"name\":\"";
+			out += thread == 1 ? "main" : "worker " + std::to_string(thread - 1);
+			out += "\"}}";
+		}
+
+		out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+		return out;
+	}
+
+	bool bwxStartupTrace::SaveChromeTrace(const std::string& path) const
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out) return false;
+
+		const std::string trace = ToChromeTrace();
+		out.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+		return static_cast<bool>(out);
+	}
+
+	void bwxStartupTrace::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_events.clear();
+		m_interactiveUs.store(-1, std::memory_order_relaxed);
+	}
+
+	uint32_t bwxStartupTrace::GetThreadIndex()
+	{
+		auto it = m_threads.find(std::this_thread::get_id());
+		if (it != m_threads.end()) return it->second;
+
+		const uint32_t index = static_cast<uint32_t>(m_threads.size()) + 1;
+		m_threads.emplace(std::this_thread::get_id(), index);
+		return index;
+	}
+
+}
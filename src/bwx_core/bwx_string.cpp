@@ -206,5 +206,148 @@ namespace bwx_sdk {
 			return converter.from_bytes(str);
 		}
 
+		void bwxRemoveChars(std::string& out, std::string_view str, const bwxCharFilter& filter)
+		{
+			out.reserve(out.size() + str.size());
+			for (char ch : str)
+			{
+				if (!filter.Contains(static_cast<unsigned char>(ch))) out.push_back(ch);
+			}
+		}
+
+		std::string bwxRemoveChars(std::string_view str, const bwxCharFilter& filter)
+		{
+			std::string result;
+			bwxRemoveChars(result, str, filter);
+			return result;
+		}
+
+		bwxMultiReplacer::bwxMultiReplacer(const std::vector<std::pair<std::string, std::string>>& replacements)
+		{
+			for (const auto& replacement : replacements) Add(replacement.first, replacement.second);
+		}
+
+		void bwxMultiReplacer::Add(std::string_view pattern, std::string_view replacement)
+		{
+			if (pattern.empty()) return;
+			m_patterns.push_back({ std::string(pattern), std::string(replacement) });
+			m_built = false;
+		}
+
+		void bwxMultiReplacer::Build() const
+		{
+			// Trie of the patterns
+			m_next.assign(256, -1);
+			m_match.assign(1, -1);
+			m_depth.assign(1, 0);
+			for (size_t p = 0; p < m_patterns.size(); ++p)
+			{
+				int32_t state = 0;
+				for (unsigned char byte : m_patterns[p].text)
+				{
+					if (m_next[state * 256 + byte] < 0)
+					{
+						m_next[state * 256 + byte] = static_cast<int32_t>(m_match.size());
+						m_next.resize(m_next.size() + 256, -1);
+						m_match.push_back(-1);
+						m_depth.push_back(m_depth[state] + 1);
+					}
+					state = m_next[state * 256 + byte];
+				}
+				// A duplicated pattern keeps its first replacement
+				if (m_match[state] < 0) m_match[state] = static_cast<int32_t>(p);
+			}
+
+			// Failure links in BFS order turn the trie into a complete automaton
+			std::vector<int32_t> fail(m_match.size(), 0);
+			std::vector<int32_t> queue;
+			queue.reserve(m_match.size());
+			for (int byte = 0; byte < 256; ++byte)
+			{
+				int32_t& child = m_next[byte];
+				if (child < 0) child = 0;
+				else queue.push_back(child);
+			}
+			for (size_t head = 0; head < queue.size(); ++head)
+			{
+				const int32_t state = queue[head];
+
+				// Longest pattern ending here: own one, else the one of the longest proper suffix
+				if (m_match[state] < 0) m_match[state] = m_match[fail[state]];
+
+				for (int byte = 0; byte < 256; ++byte)
+				{
+					int32_t& child = m_next[state * 256 + byte];
+					const int32_t fallback = m_next[fail[state] * 256 + byte];
+					if (child < 0)
+					{
+						child = fallback;
+					}
+					else
+					{
+						fail[child] = fallback;
+						queue.push_back(child);
+					}
+				}
+			}
+
+			m_built = true;
+		}
+
+		void bwxMultiReplacer::Replace(std::string& out, std::string_view str) const
+		{
+			out.reserve(out.size() + str.size());
+			if (m_patterns.empty())
+			{
+				out.append(str);
+				return;
+			}
+			if (!m_built) Build();
+
+			// Leftmost match found so far; it is final once the automaton can no longer
+			// be inside a match starting at or before its start
+			size_t copied = 0;
+			size_t matchStart = std::string_view::npos;
+			size_t matchEnd = 0;
+			int32_t matchPattern = -1;
+			int32_t state = 0;
+
+			for (size_t i = 0; i < str.size();)
+			{
+				state = m_next[state * 256 + static_cast<unsigned char>(str[i])];
+				++i;
+
+				const int32_t pattern = m_match[state];
+				if (pattern >= 0)
+				{
+					const size_t start = i - m_patterns[pattern].text.size();
+					if (matchStart == std::string_view::npos || start < matchStart || (start == matchStart && i > matchEnd))
+					{
+						matchStart = start;
+						matchEnd = i;
+						matchPattern = pattern;
+					}
+				}
+
+				if (matchStart != std::string_view::npos && (matchStart < i - m_depth[state] || i == str.size()))
+				{
+					out.append(str.substr(copied, matchStart - copied));
+					out.append(m_patterns[matchPattern].replacement);
+					copied = i = matchEnd;
+					matchStart = std::string_view::npos;
+					state = 0;
+				}
+			}
+
+			out.append(str.substr(copied));
+		}
+
+		std::string bwxMultiReplacer::Replace(std::string_view str) const
+		{
+			std::string result;
+			Replace(result, str);
+			return result;
+		}
+
 	} // namespace str
 } // namespace bwx_sdk
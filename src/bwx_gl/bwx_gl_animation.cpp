@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_animation.cpp
+// Purpose:     BWX_SDK Library; OpenGL Skeletal animation clips, sampling and blending
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_animation.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        constexpr float TIME_SCALE = 65535.0f;
+        constexpr float VALUE_SCALE = 65535.0f;
+        constexpr float ROTATION_SCALE = 32767.0f;
+
+        glm::quat Nlerp(const glm::quat& a, glm::quat b, float alpha) {
+            if (glm::dot(a, b) < 0.0f) b = -b;
+            return glm::normalize(a * (1.0f - alpha) + b * alpha);
+        }
+    }
+
+    // bwxGLPose
+
+    void bwxGLPose::FromBindPose(const bwxGLSkeleton& skeleton) {
+        const size_t count = skeleton.GetBoneCount();
+        translations.resize(count);
+        rotations.resize(count);
+        scales.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const glm::mat4& m = skeleton.GetBindPose(i);
+            glm::vec3 scale(glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2])));
+            scale = glm::max(scale, glm::vec3(1e-8f));
+
+            const glm::mat3 rotation(glm::vec3(m[0]) / scale.x, glm::vec3(m[1]) / scale.y, glm::vec3(m[2]) / scale.z);
+            translations[i] = glm::vec3(m[3]);
+            rotations[i] = glm::normalize(glm::quat_cast(rotation));
+            scales[i] = scale;
+        }
+    }
+
+    void bwxGLPose::Blend(const bwxGLPose& other, float alpha) {
+        const size_t count = std::min(GetBoneCount(), other.GetBoneCount());
+        for (size_t i = 0; i < count; ++i) {
+            translations[i] = glm::mix(translations[i], other.translations[i], alpha);
+            rotations[i] = Nlerp(rotations[i], other.rotations[i], alpha);
+            scales[i] = glm::mix(scales[i], other.scales[i], alpha);
+        }
+    }
+
+    void bwxGLPose::ToLocalTransforms(std::vector<glm::mat4>& locals) const {
+        const size_t count = std::min(GetBoneCount(), locals.size());
+        for (size_t i = 0; i < count; ++i) {
+            // T * R * S without the three matrix products
+            glm::mat4 m = glm::mat4_cast(rotations[i]);
+            m[0] *= scales[i].x;
+            m[1] *= scales[i].y;
+            m[2] *= scales[i].z;
+            m[3] = glm::vec4(translations[i], 1.0f);
+            locals[i] = m;
+        }
+    }
+
+    // bwxGLAnimationClip
+
+    bwxGLAnimationClip::bwxGLAnimationClip(const std::string& name, float duration)
+        : m_name(name), m_duration(std::max(duration, 0.0f)) {
+    }
+
+    uint16_t bwxGLAnimationClip::QuantizeTime(float time) const {
+        const float t = m_duration > 0.0f ? std::clamp(time / m_duration, 0.0f, 1.0f) : 0.0f;
+        return static_cast<uint16_t>(std::lround(t * TIME_SCALE));
+    }
+
+    bwxGLAnimationClip::Channel bwxGLAnimationClip::AddVectors(const std::vector<std::pair<float, glm::vec3>>& keys,
+        std::vector<uint16_t>& times, std::vector<glm::u16vec3>& values) {
+        Channel channel;
+        channel.first = static_cast<uint32_t>(values.size());
+        channel.count = static_cast<uint32_t>(keys.size());
+        if (keys.empty()) return channel;
+
+        glm::vec3 max = keys.front().second;
+        channel.min = max;
+        for (const auto& [time, value] : keys) {
+            channel.min = glm::min(channel.min, value);
+            max = glm::max(max, value);
+        }
+        channel.extent = max - channel.min;
+
+        for (const auto& [time, value] : keys) {
+            glm::u16vec3 q(0);
+            for (int c = 0; c < 3; ++c) {
+                if (channel.extent[c] > 0.0f) q[c] = static_cast<uint16_t>(std::lround((value[c] - channel.min[c]) / channel.extent[c] * VALUE_SCALE));
+            }
+            times.push_back(QuantizeTime(time));
+            values.push_back(q);
+        }
+        return channel;
+    }
+
+    void bwxGLAnimationClip::AddTrack(const Keys& keys) {
+        if (keys.bone < 0) return;
+
+        Track track;
+        track.bone = keys.bone;
+        track.translation = AddVectors(keys.translations, m_translationTimes, m_translations);
+        track.scale = AddVectors(keys.scales, m_scaleTimes, m_scales);
+
+        track.rotation.first = static_cast<uint32_t>(m_rotations.size());
+        track.rotation.count = static_cast<uint32_t>(keys.rotations.size());
+        glm::quat previous(1.0f, 0.0f, 0.0f, 0.0f);
+        for (const auto& [time, value] : keys.rotations) {
+            // q and -q are the same rotation - keep neighbours in one hemisphere for a short interpolation
+            glm::quat q = glm::normalize(value);
+            if (glm::dot(previous, q) < 0.0f) q = -q;
+            previous = q;
+
+            m_rotationTimes.push_back(QuantizeTime(time));
+            m_rotations.emplace_back(static_cast<int16_t>(std::lround(q.x * ROTATION_SCALE)), static_cast<int16_t>(std::lround(q.y * ROTATION_SCALE)),
+                static_cast<int16_t>(std::lround(q.z * ROTATION_SCALE)), static_cast<int16_t>(std::lround(q.w * ROTATION_SCALE)));
+        }
+
+        m_tracks.push_back(track);
+    }
+
+    uint32_t bwxGLAnimationClip::FindKey(const std::vector<uint16_t>& times, const Channel& channel, float time, float& alpha) {
+        alpha = 0.0f;
+        if (channel.count < 2) return channel.first;
+
+        const auto begin = times.begin() + channel.first;
+        const auto end = begin + channel.count;
+        const auto next = std::upper_bound(begin, end, time, [](float t, uint16_t key) { return t < static_cast<float>(key); });
+
+        if (next == begin) return channel.first;
+        if (next == end) {
+            alpha = 1.0f;
+            return channel.first + channel.count - 2;
+        }
+
+        const float t0 = static_cast<float>(*(next - 1));
+        const float t1 = static_cast<float>(*next);
+        alpha = (time - t0) / (t1 - t0);
+        return static_cast<uint32_t>(next - 1 - times.begin());
+    }
+
+    glm::vec3 bwxGLAnimationClip::SampleVector(const std::vector<uint16_t>& times, const std::vector<glm::u16vec3>& values,
+        const Channel& channel, float time) {
+        float alpha;
+        const uint32_t key = FindKey(times, channel, time, alpha);
+
+        glm::vec3 q(values[key]);
+        if (channel.count > 1) q = glm::mix(q, glm::vec3(values[key + 1]), alpha);
+        return channel.min + channel.extent * (q / VALUE_SCALE);
+    }
+
+    glm::quat bwxGLAnimationClip::SampleRotation(const Channel& channel, float time) const {
+        float alpha;
+        const uint32_t key = FindKey(m_rotationTimes, channel, time, alpha);
+
+        auto decode = [this](uint32_t index) {
+            const glm::vec4 v = glm::vec4(m_rotations[index]) / ROTATION_SCALE;
+            return glm::quat(v.w, v.x, v.y, v.z);
+        };
+
+        const glm::quat q0 = decode(key);
+        if (channel.count < 2) return glm::normalize(q0);
+        return Nlerp(q0, decode(key + 1), alpha);
+    }
+
+    void bwxGLAnimationClip::Sample(float time, bwxGLPose& pose) const {
+        const float key = m_duration > 0.0f ? std::clamp(time / m_duration, 0.0f, 1.0f) * TIME_SCALE : 0.0f;
+        const size_t bones = pose.GetBoneCount();
+
+        for (const Track& track : m_tracks) {
+            const size_t bone = static_cast<size_t>(track.bone);
+            if (bone >= bones) continue;
+
+            if (track.translation.count) pose.translations[bone] = SampleVector(m_translationTimes, m_translations, track.translation, key);
+            if (track.rotation.count) pose.rotations[bone] = SampleRotation(track.rotation, key);
+            if (track.scale.count) pose.scales[bone] = SampleVector(m_scaleTimes, m_scales, track.scale, key);
+        }
+    }
+
+    size_t bwxGLAnimationClip::GetMemorySize() const {
+        return m_tracks.size() * sizeof(Track) +
+            (m_translationTimes.size() + m_rotationTimes.size() + m_scaleTimes.size()) * sizeof(uint16_t) +
+            (m_translations.size() + m_scales.size()) * sizeof(glm::u16vec3) + m_rotations.size() * sizeof(glm::i16vec4);
+    }
+
+    // bwxGLAnimator
+
+    bwxGLAnimator::bwxGLAnimator(std::shared_ptr<bwxGLSkeleton> skeleton)
+        : m_skeleton(skeleton) {
+        if (m_skeleton) m_bindPose.FromBindPose(*m_skeleton);
+        m_pose = m_bindPose;
+        m_sample = m_bindPose;
+    }
+
+    bool bwxGLAnimator::Play(size_t layer, std::shared_ptr<const bwxGLAnimationClip> clip, float weight, bool loop) {
+        if (layer >= bwxGL_ANIMATION_MAX_LAYERS) return false;
+
+        Layer& l = m_layers[layer];
+        l.clip = clip;
+        l.time = 0.0f;
+        l.weight = weight;
+        l.loop = loop;
+        return true;
+    }
+
+    void bwxGLAnimator::Stop(size_t layer) {
+        if (layer < bwxGL_ANIMATION_MAX_LAYERS) m_layers[layer].clip.reset();
+    }
+
+    void bwxGLAnimator::Advance(float deltaTime) {
+        for (Layer& layer : m_layers) {
+            if (!layer.clip) continue;
+
+            const float duration = layer.clip->GetDuration();
+            layer.time += deltaTime * layer.speed;
+            if (layer.loop && duration > 0.0f) {
+                layer.time = std::fmod(layer.time, duration);
+                if (layer.time < 0.0f) layer.time += duration;
+            }
+            else {
+                layer.time = std::clamp(layer.time, 0.0f, duration);
+            }
+        }
+    }
+
+    void bwxGLAnimator::Evaluate() {
+        if (!m_skeleton || m_bindPose.GetBoneCount() != m_skeleton->GetBoneCount()) return;
+
+        m_pose = m_bindPose;
+
+        // Running normalisation: every layer moves the result by its share of the weight so far
+        float total = 0.0f;
+        for (const Layer& layer : m_layers) {
+            if (!layer.clip || layer.weight <= 0.0f) continue;
+
+            m_sample = m_bindPose;
+            layer.clip->Sample(layer.time, m_sample);
+
+            total += layer.weight;
+            m_pose.Blend(m_sample, layer.weight / total);
+        }
+
+        m_pose.ToLocalTransforms(m_skeleton->GetLocalTransforms());
+        m_skeleton->Update();
+    }
+
+    // bwxGLAnimationSystem
+
+    bwxGLAnimationSystem& bwxGLAnimationSystem::GetInstance() {
+        static bwxGLAnimationSystem instance;
+        return instance;
+    }
+
+    void bwxGLAnimationSystem::RegisterAnimator(std::shared_ptr<bwxGLAnimator> animator) {
+        if (animator) m_animators.push_back(animator);
+    }
+
+    void bwxGLAnimationSystem::UnregisterAnimator(std::shared_ptr<bwxGLAnimator> animator) {
+        m_animators.erase(std::remove(m_animators.begin(), m_animators.end(), animator), m_animators.end());
+    }
+
+    void bwxGLAnimationSystem::Clear() {
+        m_animators.clear();
+    }
+
+    void bwxGLAnimationSystem::Update(float deltaTime) {
+        // Animators own their skeletons, so they evaluate independently
+        bwxJobSystem::GetInstance().ParallelFor(m_animators.size(), bwxGL_ANIMATION_JOB_GRAIN, [this, deltaTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                m_animators[i]->Advance(deltaTime);
+                m_animators[i]->Evaluate();
+            }
+        });
+    }
+
+} // namespace bwx_sdk
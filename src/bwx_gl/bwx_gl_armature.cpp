@@ -15,10 +15,42 @@
 
 namespace bwx_sdk {
 	bwxGLArmature::bwxGLArmature()
+		: m_skeleton(std::make_shared<bwxGLSkeleton>())
+	{
+	}
+
+	bwxGLArmature::bwxGLArmature(std::shared_ptr<bwxGLSkeleton> skeleton)
+		: m_skeleton(skeleton)
 	{
 	}
 
 	bwxGLArmature::~bwxGLArmature() 
 	{
 	}
-} // namespace bwx_sdk
\ No newline at end of file
+
+	bool bwxGLArmature::SetBoneTransform(const std::string& name, const glm::mat4& transform)
+	{
+		const int32_t bone = m_skeleton ? m_skeleton->FindBone(name) : -1;
+		if (bone < 0) return false;
+
+		m_skeleton->SetLocalTransform(static_cast<size_t>(bone), transform);
+		return true;
+	}
+
+	glm::mat4 bwxGLArmature::GetBoneTransform(const std::string& name) const
+	{
+		const int32_t bone = m_skeleton ? m_skeleton->FindBone(name) : -1;
+		return bone < 0 ? glm::mat4(1.0f) : m_skeleton->GetLocalTransform(static_cast<size_t>(bone));
+	}
+
+	glm::mat4 bwxGLArmature::GetBoneOffset(const std::string& name) const
+	{
+		const int32_t bone = m_skeleton ? m_skeleton->FindBone(name) : -1;
+		return bone < 0 ? glm::mat4(1.0f) : m_skeleton->GetOffset(static_cast<size_t>(bone));
+	}
+
+	void bwxGLArmature::Update()
+	{
+		if (m_skeleton) m_skeleton->Update();
+	}
+} // namespace bwx_sdk
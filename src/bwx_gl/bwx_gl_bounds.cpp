@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_bounds.cpp
+// Purpose:     BWX_SDK Library; OpenGL Bounding volumes and view frustum
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <bwx_sdk/bwx_gl/bwx_gl_bounds.h>
+
+namespace bwx_sdk {
+
+    void bwxGLBoundingBox::Expand(const glm::vec3& point) {
+        if (!IsValid()) {
+            min = max = point;
+            return;
+        }
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void bwxGLBoundingBox::Expand(const bwxGLBoundingBox& box) {
+        if (!box.IsValid()) return;
+        Expand(box.min);
+        Expand(box.max);
+    }
+
+    bwxGLBoundingBox bwxGLBoundingBox::Transform(const glm::mat4& matrix) const {
+        if (!IsValid()) return *this;
+
+        // Center/extents form: one matrix-vector product instead of eight corners
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+        glm::vec3 extents = GetExtents();
+
+        glm::vec3 worldExtents(
+            glm::abs(matrix[0][0]) * extents.x + glm::abs(matrix[1][0]) * extents.y + glm::abs(matrix[2][0]) * extents.z,
+            glm::abs(matrix[0][1]) * extents.x + glm::abs(matrix[1][1]) * extents.y + glm::abs(matrix[2][1]) * extents.z,
+            glm::abs(matrix[0][2]) * extents.x + glm::abs(matrix[1][2]) * extents.y + glm::abs(matrix[2][2]) * extents.z);
+
+        bwxGLBoundingBox result;
+        result.min = center - worldExtents;
+        result.max = center + worldExtents;
+        return result;
+    }
+
+    void bwxGLFrustum::Update(const glm::mat4& m) {
+        // Gribb/Hartmann plane extraction (glm is column-major: m[column][row])
+        for (int i = 0; i < 3; ++i) {
+            for (int side = 0; side < 2; ++side) {
+                float sign = side == 0 ? 1.0f : -1.0f;
+                glm::vec4& plane = m_planes[i * 2 + side];
+                plane.x = m[0][3] + sign * m[0][i];
+                plane.y = m[1][3] + sign * m[1][i];
+                plane.z = m[2][3] + sign * m[2][i];
+                plane.w = m[3][3] + sign * m[3][i];
+
+                float length = glm::length(glm::vec3(plane));
+                if (length > 0.0f) plane /= length;
+            }
+        }
+    }
+
+    bool bwxGLFrustum::IsBoxVisible(const bwxGLBoundingBox& box) const {
+        if (!box.IsValid()) return true;
+
+        for (const auto& plane : m_planes) {
+            // Corner furthest along the plane normal
+            glm::vec3 p(
+                plane.x >= 0.0f ? box.max.x : box.min.x,
+                plane.y >= 0.0f ? box.max.y : box.min.y,
+                plane.z >= 0.0f ? box.max.z : box.min.z);
+
+            if (glm::dot(glm::vec3(plane), p) + plane.w < 0.0f) return false;
+        }
+        return true;
+    }
+
+    bool bwxGLFrustum::IsSphereVisible(const glm::vec3& center, float radius) const {
+        for (const auto& plane : m_planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+        }
+        return true;
+    }
+
+} // namespace bwx_sdk
@@ -11,6 +11,7 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_buffer.h>
 
 namespace bwx_sdk {
@@ -37,14 +38,9 @@ namespace bwx_sdk {
 
         Bind();
         glBufferData(m_target, data.size() * sizeof(float), data.data(), usage);
+        SetStorageSize(data.size() * sizeof(float));
 
-        GLsizei offset = 0;
-        for (GLuint index = 0; index < layout.size(); ++index) {
-            GLint size = layout[index];
-            glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(offset * sizeof(float)));
-            glEnableVertexAttribArray(index);
-            offset += size;
-        }
+        SetupLayout(stride, layout);
 
         glBindVertexArray(0);
         Unbind();
@@ -64,17 +60,44 @@ namespace bwx_sdk {
 
         Bind();
         glBufferData(m_target, size, nullptr, usage);
+        SetStorageSize(size);
+
+        SetupLayout(stride, layout);
+
+        glBindBuffer(m_target, 0);
+        glBindVertexArray(0);
+    }
+
+    bwxGLBuffer::bwxGLBuffer(const void* data, GLsizeiptr size, const bwxGLVertexLayout& layout, GLenum target, GLenum usage) {
+        Create(data, size, layout, target, usage);
+    }
+
+    void bwxGLBuffer::Create(const void* data, GLsizeiptr size, const bwxGLVertexLayout& layout, GLenum target, GLenum usage) {
+        m_target = target;
+
+        glGenBuffers(1, &m_bufferID);
+        glGenVertexArrays(1, &m_vaoID);
+
+        glBindVertexArray(m_vaoID);
+
+        Bind();
+        glBufferData(m_target, size, data, usage);
+        SetStorageSize(size);
 
+        layout.Apply();
+
+        glBindVertexArray(0);
+        Unbind();
+    }
+
+    void bwxGLBuffer::SetupLayout(GLsizei stride, const std::vector<GLint>& layout) {
         GLsizei offset = 0;
         for (GLuint index = 0; index < layout.size(); ++index) {
-            GLint sizeComp = layout[index];
-            glVertexAttribPointer(index, sizeComp, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(offset * sizeof(float)));
+            GLint size = layout[index];
+            glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(offset * sizeof(float)));
             glEnableVertexAttribArray(index);
-            offset += sizeComp;
+            offset += size;
         }
-
-        glBindBuffer(m_target, 0);
-        glBindVertexArray(0);
     }
 
     bwxGLBuffer::~bwxGLBuffer() {
@@ -94,6 +117,7 @@ namespace bwx_sdk {
             glDeleteBuffers(1, &m_bufferID);
             m_bufferID = 0;
         }
+        SetStorageSize(0);
         if (m_vaoID) {
             glDeleteVertexArrays(1, &m_vaoID);
             m_vaoID = 0;
@@ -111,6 +135,7 @@ namespace bwx_sdk {
     void bwxGLBuffer::SetData(const void* data, GLsizeiptr size, GLenum usage) {
         Bind();
         glBufferData(m_target, size, data, usage);
+        SetStorageSize(size);
         Unbind();
     }
 
@@ -118,4 +143,32 @@ namespace bwx_sdk {
         SetData(indices.data(), indices.size() * sizeof(GLuint), usage);
     }
 
+    void bwxGLBuffer::SetSubData(GLintptr offset, const void* data, GLsizeiptr size) {
+        Bind();
+        glBufferSubData(m_target, offset, size, data);
+        Unbind();
+    }
+
+    void* bwxGLBuffer::MapWrite(GLsizeiptr size, GLenum usage) {
+        Bind();
+        glBufferData(m_target, size, nullptr, usage);
+        SetStorageSize(size);
+        void* ptr = glMapBufferRange(m_target, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (!ptr) Unbind();
+        return ptr;
+    }
+
+    bool bwxGLBuffer::Unmap() {
+        // GL_FALSE means the storage got corrupted while mapped (e.g. mode switch)
+        const bool ok = glUnmapBuffer(m_target) == GL_TRUE;
+        Unbind();
+        return ok;
+    }
+
+    void bwxGLBuffer::SetStorageSize(GLsizeiptr size) {
+        if (size == m_storageSize) return;
+        BWX_METRIC_GAUGE("gl.buffers.vram_bytes").Add(static_cast<int64_t>(size) - static_cast<int64_t>(m_storageSize));
+        m_storageSize = size;
+    }
+
 } // namespace bwx_sdk
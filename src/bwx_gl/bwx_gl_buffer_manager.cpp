@@ -12,6 +12,7 @@
 #endif
 
 #include <bwx_sdk/bwx_gl/bwx_gl_buffer_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_upload_worker.h>
 
 namespace bwx_sdk {
 
@@ -62,6 +63,7 @@ namespace bwx_sdk {
 
     bwxGLBuffer* bwxGLBufferManager::GetOrCreateVBO(const std::string& key, const std::vector<float>& vertices) {
         auto it = m_resources.find(key);
+        CountLookup(it != m_resources.end());
         if (it != m_resources.end()) {
             it->second->refCount++;
             return it->second->VBO;
@@ -70,12 +72,28 @@ namespace bwx_sdk {
         bwxGLBuffer* vbo = new bwxGLBuffer(GL_ARRAY_BUFFER);
         vbo->SetData(vertices.data(), vertices.size() * sizeof(float), GL_STATIC_DRAW);
 
-		m_resources[key] = std::make_shared<bwxGLBufferData>(bwxGLBufferData { vbo, nullptr, nullptr, nullptr, nullptr });
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { vbo, nullptr, nullptr, nullptr, nullptr }));
+        return vbo;
+    }
+
+    bwxGLBuffer* bwxGLBufferManager::GetOrCreateVBO(const std::string& key, const void* data, GLsizeiptr size, GLenum usage) {
+        auto it = m_resources.find(key);
+        CountLookup(it != m_resources.end());
+        if (it != m_resources.end()) {
+            it->second->refCount++;
+            return it->second->VBO;
+        }
+
+        bwxGLBuffer* vbo = new bwxGLBuffer(GL_ARRAY_BUFFER);
+        vbo->SetData(data, size, usage);
+
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { vbo, nullptr, nullptr, nullptr, nullptr }));
         return vbo;
     }
 
     bwxGLBuffer* bwxGLBufferManager::GetOrCreateEBO(const std::string& key, const std::vector<unsigned int>& indices) {
         auto it = m_resources.find(key);
+        CountLookup(it != m_resources.end());
         if (it != m_resources.end()) {
             it->second->refCount++;
             return it->second->EBO;
@@ -84,12 +102,75 @@ namespace bwx_sdk {
         bwxGLBuffer* ebo = new bwxGLBuffer(GL_ELEMENT_ARRAY_BUFFER);
         ebo->SetData(indices.data(), indices.size() * sizeof(unsigned int), GL_STATIC_DRAW);
 
-		m_resources[key] = std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, ebo, nullptr, nullptr, nullptr });
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, ebo, nullptr, nullptr, nullptr }));
+        return ebo;
+    }
+
+    bwxGLBuffer* bwxGLBufferManager::GetOrCreateEBO(const std::string& key, const void* indices, GLsizeiptr size) {
+        auto it = m_resources.find(key);
+        CountLookup(it != m_resources.end());
+        if (it != m_resources.end()) {
+            it->second->refCount++;
+            return it->second->EBO;
+        }
+
+        bwxGLBuffer* ebo = new bwxGLBuffer(GL_ELEMENT_ARRAY_BUFFER);
+        ebo->SetData(indices, size, GL_STATIC_DRAW);
+
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, ebo, nullptr, nullptr, nullptr }));
         return ebo;
     }
 
+    bool bwxGLBufferManager::RequestVBO(const std::string& key, std::vector<float> vertices) {
+        if (bwxGLUploadWorker::GetInstance().IsRunning()) {
+            return RequestBuffer(key, GL_ARRAY_BUFFER, [vertices = std::move(vertices)](bwxGLBuffer& vbo) {
+                vbo.SetData(vertices.data(), vertices.size() * sizeof(float), GL_STATIC_DRAW);
+            });
+        }
+        return QueueRequest(key, [this, key, vertices = std::move(vertices)]() { GetOrCreateVBO(key, vertices); });
+    }
+
+    bool bwxGLBufferManager::RequestEBO(const std::string& key, std::vector<unsigned int> indices) {
+        if (bwxGLUploadWorker::GetInstance().IsRunning()) {
+            return RequestBuffer(key, GL_ELEMENT_ARRAY_BUFFER, [indices = std::move(indices)](bwxGLBuffer& ebo) {
+                ebo.SetData(indices.data(), indices.size() * sizeof(unsigned int), GL_STATIC_DRAW);
+            });
+        }
+        return QueueRequest(key, [this, key, indices = std::move(indices)]() { GetOrCreateEBO(key, indices); });
+    }
+
+    bool bwxGLBufferManager::RequestBuffer(const std::string& key, GLenum target, std::function<void(bwxGLBuffer&)> fill) {
+        if (Has(key)) return false;
+        {
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            if (!m_requested.insert(key).second) return false;
+        }
+
+        // Filled on the worker; stored on the GL thread once the fence says the data is on the GPU
+        auto buffer = std::make_shared<std::unique_ptr<bwxGLBuffer>>();
+        bwxGLUploadWorker::GetInstance().Submit(
+            [buffer, target, fill = std::move(fill)]() {
+                *buffer = std::make_unique<bwxGLBuffer>(target);
+                fill(**buffer);
+                return true;
+            },
+            [this, buffer, key, target](bool ok) {
+                if (ok && *buffer && !m_resources.count(key)) {
+                    bwxGLBuffer* created = buffer->release();
+                    const bool vbo = target == GL_ARRAY_BUFFER;
+                    StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { vbo ? created : nullptr, vbo ? nullptr : created, nullptr, nullptr, nullptr }));
+                }
+                buffer->reset();
+
+                std::lock_guard<std::mutex> lock(m_requestMutex);
+                m_requested.erase(key);
+            });
+        return true;
+    }
+
 	bwxGLBuffer* bwxGLBufferManager::GetOrCreateUBO(const std::string& key, const std::vector<float>& data) {
 		auto it = m_resources.find(key);
+		CountLookup(it != m_resources.end());
 		if (it != m_resources.end()) {
 			it->second->refCount++;
 			return it->second->UBO;
@@ -97,12 +178,13 @@ namespace bwx_sdk {
 		bwxGLBuffer* ubo = new bwxGLBuffer(GL_UNIFORM_BUFFER);
 		ubo->SetData(data.data(), data.size() * sizeof(float), GL_STATIC_DRAW);
 
-		m_resources[key] = std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, ubo, nullptr, nullptr });
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, ubo, nullptr, nullptr }));
 		return ubo;
 	}
 
 	bwxGLBuffer* bwxGLBufferManager::GetOrCreateTBO(const std::string& key, const std::vector<float>& data) {
 		auto it = m_resources.find(key);
+		CountLookup(it != m_resources.end());
 		if (it != m_resources.end()) {
 			it->second->refCount++;
 			return it->second->TBO;
@@ -110,12 +192,13 @@ namespace bwx_sdk {
 		bwxGLBuffer* tbo = new bwxGLBuffer(GL_TEXTURE_BUFFER);
 		tbo->SetData(data.data(), data.size() * sizeof(float), GL_STATIC_DRAW);
 
-		m_resources[key] = std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, nullptr, tbo, nullptr });
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, nullptr, tbo, nullptr }));
 		return tbo;
 	}
 
 	bwxGLBuffer* bwxGLBufferManager::GetOrCreateTFO(const std::string& key, const std::vector<float>& data) {
 		auto it = m_resources.find(key);
+		CountLookup(it != m_resources.end());
 		if (it != m_resources.end()) {
 			it->second->refCount++;
 			return it->second->TFO;
@@ -123,10 +206,26 @@ namespace bwx_sdk {
 		bwxGLBuffer* tfo = new bwxGLBuffer(GL_TRANSFORM_FEEDBACK_BUFFER);
 		tfo->SetData(data.data(), data.size() * sizeof(float), GL_STATIC_DRAW);
 		
-		m_resources[key] = std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, nullptr, nullptr, tfo });
+		StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, nullptr, nullptr, tfo }));
 		return tfo;
 	}
 
+	bwxGLRingBuffer* bwxGLBufferManager::GetOrCreateRingBuffer(const std::string& key, GLenum target, GLsizeiptr regionSize, GLuint regions) {
+		auto it = m_resources.find(key);
+		CountLookup(it != m_resources.end());
+		if (it != m_resources.end()) {
+			it->second->refCount++;
+			return static_cast<bwxGLRingBuffer*>(target == GL_UNIFORM_BUFFER ? it->second->UBO : it->second->VBO);
+		}
+		bwxGLRingBuffer* ring = new bwxGLRingBuffer(target, regionSize, regions);
+
+		if (target == GL_UNIFORM_BUFFER)
+			StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { nullptr, nullptr, ring, nullptr, nullptr }));
+		else
+			StoreResource(key, std::make_shared<bwxGLBufferData>(bwxGLBufferData { ring, nullptr, nullptr, nullptr, nullptr }));
+		return ring;
+	}
+
     void bwxGLBufferManager::ReleaseBuffer(const std::string& key) {
         auto it = m_resources.find(key);
         if (it != m_resources.end()) {
@@ -151,11 +250,17 @@ namespace bwx_sdk {
 					it->second->TFO->Release();
 					delete it->second->TFO;
 				}
-                m_resources.erase(it);
+                EraseResource(it);
             }
         }
     }
 
+    std::shared_ptr<bwxGLGeometryPool> bwxGLBufferManager::GetGeometryPool(const bwxGLVertexLayout& layout) {
+        auto& pool = m_geometryPools[layout.GetSignature()];
+        if (!pool) pool = std::make_shared<bwxGLGeometryPool>(layout);
+        return pool;
+    }
+
     void bwxGLBufferManager::Clear() {
         for (auto& [key, buffer] : m_resources) {
             if (buffer->VBO) {
@@ -179,7 +284,8 @@ namespace bwx_sdk {
 				delete buffer->TFO;
 			}
         }
-        m_resources.clear();
+        ClearResources();
+        m_geometryPools.clear(); // Pools with live allocations go away with their last mesh
     }
 
     bwxGLBufferManager::~bwxGLBufferManager() {
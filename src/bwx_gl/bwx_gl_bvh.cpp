@@ -0,0 +1,430 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_bvh.cpp
+// Purpose:     BWX_SDK Library; OpenGL Dynamic bounding volume hierarchy
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_bvh.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        constexpr size_t STACK_RESERVE = 64;  // Enough for a balanced tree of millions of leaves
+
+        bwxGLBoundingBox Combine(const bwxGLBoundingBox& a, const bwxGLBoundingBox& b) {
+            bwxGLBoundingBox box;
+            box.min = glm::min(a.min, b.min);
+            box.max = glm::max(a.max, b.max);
+            return box;
+        }
+
+        float SurfaceArea(const bwxGLBoundingBox& box) {
+            const glm::vec3 size = box.max - box.min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        bool Contains(const bwxGLBoundingBox& outer, const bwxGLBoundingBox& inner) {
+            return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+                inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+        }
+
+        bool Overlaps(const bwxGLBoundingBox& a, const bwxGLBoundingBox& b) {
+            return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+                a.min.z <= b.max.z && b.min.z <= a.max.z;
+        }
+
+        bwxGLBoundingBox Fatten(const bwxGLBoundingBox& box) {
+            // Objects without bounds become a point at the origin
+            bwxGLBoundingBox fat = box.IsValid() ? box : bwxGLBoundingBox{ glm::vec3(0.0f), glm::vec3(0.0f) };
+            const glm::vec3 margin = (fat.max - fat.min) * bwxGL_BVH_MARGIN + glm::vec3(1e-3f);
+            fat.min -= margin;
+            fat.max += margin;
+            return fat;
+        }
+    }
+
+    int32_t bwxGLBVH::Insert(const bwxGLBoundingBox& box, void* userData) {
+        const int32_t proxy = AllocateNode();
+        m_nodes[proxy].box = Fatten(box);
+        m_nodes[proxy].userData = userData;
+        m_nodes[proxy].height = 0;
+
+        InsertLeaf(proxy);
+        ++m_count;
+        return proxy;
+    }
+
+    void bwxGLBVH::Remove(int32_t proxy) {
+        if (proxy < 0 || proxy >= static_cast<int32_t>(m_nodes.size()) || !m_nodes[proxy].IsLeaf() || m_nodes[proxy].height < 0) return;
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --m_count;
+    }
+
+    bool bwxGLBVH::Move(int32_t proxy, const bwxGLBoundingBox& box) {
+        const bwxGLBoundingBox tight = box.IsValid() ? box : bwxGLBoundingBox{ glm::vec3(0.0f), glm::vec3(0.0f) };
+        if (Contains(m_nodes[proxy].box, tight)) return false;
+
+        RemoveLeaf(proxy);
+        m_nodes[proxy].box = Fatten(box);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void bwxGLBVH::Clear() {
+        m_nodes.clear();
+        m_root = bwxGL_BVH_NULL_NODE;
+        m_freeList = bwxGL_BVH_NULL_NODE;
+        m_count = 0;
+    }
+
+    int bwxGLBVH::GetHeight() const {
+        return m_root == bwxGL_BVH_NULL_NODE ? 0 : m_nodes[m_root].height;
+    }
+
+    int32_t bwxGLBVH::AllocateNode() {
+        if (m_freeList == bwxGL_BVH_NULL_NODE) {
+            m_nodes.emplace_back();
+            return static_cast<int32_t>(m_nodes.size() - 1);
+        }
+
+        const int32_t node = m_freeList;
+        m_freeList = m_nodes[node].parent;
+        m_nodes[node] = Node();
+        return node;
+    }
+
+    void bwxGLBVH::FreeNode(int32_t node) {
+        m_nodes[node] = Node();
+        m_nodes[node].parent = m_freeList;
+        m_freeList = node;
+    }
+
+    void bwxGLBVH::InsertLeaf(int32_t leaf) {
+        if (m_root == bwxGL_BVH_NULL_NODE) {
+            m_root = leaf;
+            m_nodes[leaf].parent = bwxGL_BVH_NULL_NODE;
+            return;
+        }
+
+        // Descend towards the cheapest sibling: the cost is the surface area added to the tree
+        const bwxGLBoundingBox box = m_nodes[leaf].box;
+        int32_t index = m_root;
+        while (!m_nodes[index].IsLeaf()) {
+            const Node& node = m_nodes[index];
+            const float area = SurfaceArea(node.box);
+            const float combined = SurfaceArea(Combine(node.box, box));
+
+            const float cost = 2.0f * combined;              // New parent of this node and the leaf
+            const float inheritance = 2.0f * (combined - area);  // Growth of every ancestor below here
+
+            auto childCost = [&](int32_t child) {
+                const float grown = SurfaceArea(Combine(m_nodes[child].box, box));
+                return (m_nodes[child].IsLeaf() ? grown : grown - SurfaceArea(m_nodes[child].box)) + inheritance;
+            };
+            const float costLeft = childCost(node.left);
+            const float costRight = childCost(node.right);
+
+            if (cost < costLeft && cost < costRight) break;
+            index = costLeft < costRight ? node.left : node.right;
+        }
+
+        const int32_t sibling = index;
+        const int32_t oldParent = m_nodes[sibling].parent;
+        const int32_t newParent = AllocateNode();
+        m_nodes[newParent].parent = oldParent;
+        m_nodes[newParent].box = Combine(box, m_nodes[sibling].box);
+        m_nodes[newParent].height = m_nodes[sibling].height + 1;
+        m_nodes[newParent].left = sibling;
+        m_nodes[newParent].right = leaf;
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        if (oldParent == bwxGL_BVH_NULL_NODE) {
+            m_root = newParent;
+        }
+        else if (m_nodes[oldParent].left == sibling) {
+            m_nodes[oldParent].left = newParent;
+        }
+        else {
+            m_nodes[oldParent].right = newParent;
+        }
+
+        Refit(m_nodes[leaf].parent);
+    }
+
+    void bwxGLBVH::RemoveLeaf(int32_t leaf) {
+        if (leaf == m_root) {
+            m_root = bwxGL_BVH_NULL_NODE;
+            return;
+        }
+
+        const int32_t parent = m_nodes[leaf].parent;
+        const int32_t grandParent = m_nodes[parent].parent;
+        const int32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+        // The sibling takes the parent's place
+        if (grandParent == bwxGL_BVH_NULL_NODE) {
+            m_root = sibling;
+            m_nodes[sibling].parent = bwxGL_BVH_NULL_NODE;
+            FreeNode(parent);
+        }
+        else {
+            if (m_nodes[grandParent].left == parent) m_nodes[grandParent].left = sibling;
+            else m_nodes[grandParent].right = sibling;
+            m_nodes[sibling].parent = grandParent;
+            FreeNode(parent);
+            Refit(grandParent);
+        }
+        m_nodes[leaf].parent = bwxGL_BVH_NULL_NODE;
+    }
+
+    void bwxGLBVH::Refit(int32_t index) {
+        while (index != bwxGL_BVH_NULL_NODE) {
+            index = Balance(index);
+
+            Node& node = m_nodes[index];
+            node.height = 1 + std::max(m_nodes[node.left].height, m_nodes[node.right].height);
+            node.box = Combine(m_nodes[node.left].box, m_nodes[node.right].box);
+            index = node.parent;
+        }
+    }
+
+    int32_t bwxGLBVH::Balance(int32_t iA) {
+        Node& A = m_nodes[iA];
+        if (A.IsLeaf() || A.height < 2) return iA;
+
+        const int32_t iB = A.left;
+        const int32_t iC = A.right;
+        Node& B = m_nodes[iB];
+        Node& C = m_nodes[iC];
+        const int balance = C.height - B.height;
+
+        // Rotations as in an AVL tree: the taller child moves up and A takes its shorter grandchild
+        if (balance > 1) {
+            const int32_t iF = C.left;
+            const int32_t iG = C.right;
+            Node& F = m_nodes[iF];
+            Node& G = m_nodes[iG];
+
+            C.left = iA;
+            C.parent = A.parent;
+            A.parent = iC;
+
+            if (C.parent == bwxGL_BVH_NULL_NODE) m_root = iC;
+            else if (m_nodes[C.parent].left == iA) m_nodes[C.parent].left = iC;
+            else m_nodes[C.parent].right = iC;
+
+            if (F.height > G.height) {
+                C.right = iF;
+                A.right = iG;
+                G.parent = iA;
+                A.box = Combine(B.box, G.box);
+                C.box = Combine(A.box, F.box);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            }
+            else {
+                C.right = iG;
+                A.right = iF;
+                F.parent = iA;
+                A.box = Combine(B.box, F.box);
+                C.box = Combine(A.box, G.box);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+            return iC;
+        }
+
+        if (balance < -1) {
+            const int32_t iD = B.left;
+            const int32_t iE = B.right;
+            Node& D = m_nodes[iD];
+            Node& E = m_nodes[iE];
+
+            B.left = iA;
+            B.parent = A.parent;
+            A.parent = iB;
+
+            if (B.parent == bwxGL_BVH_NULL_NODE) m_root = iB;
+            else if (m_nodes[B.parent].left == iA) m_nodes[B.parent].left = iB;
+            else m_nodes[B.parent].right = iB;
+
+            if (D.height > E.height) {
+                B.right = iD;
+                A.left = iE;
+                E.parent = iA;
+                A.box = Combine(C.box, E.box);
+                B.box = Combine(A.box, D.box);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            }
+            else {
+                B.right = iE;
+                A.left = iD;
+                D.parent = iA;
+                A.box = Combine(C.box, D.box);
+                B.box = Combine(A.box, E.box);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+            return iB;
+        }
+
+        return iA;
+    }
+
+    void bwxGLBVH::QueryFrustum(const bwxGLFrustum& frustum, std::vector<void*>& out) const {
+        if (m_root == bwxGL_BVH_NULL_NODE) return;
+
+        std::vector<int32_t> stack;
+        stack.reserve(STACK_RESERVE);
+        stack.push_back(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (!frustum.IsBoxVisible(node.box)) continue;
+
+            if (node.IsLeaf()) {
+                out.push_back(node.userData);
+                continue;
+            }
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    void bwxGLBVH::QueryBox(const bwxGLBoundingBox& box, std::vector<void*>& out) const {
+        if (m_root == bwxGL_BVH_NULL_NODE || !box.IsValid()) return;
+
+        std::vector<int32_t> stack;
+        stack.reserve(STACK_RESERVE);
+        stack.push_back(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (!Overlaps(node.box, box)) continue;
+
+            if (node.IsLeaf()) {
+                out.push_back(node.userData);
+                continue;
+            }
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    void bwxGLBVH::QuerySphere(const glm::vec3& center, float radius, std::vector<void*>& out) const {
+        if (m_root == bwxGL_BVH_NULL_NODE || radius < 0.0f) return;
+
+        const float radiusSquared = radius * radius;
+        std::vector<int32_t> stack;
+        stack.reserve(STACK_RESERVE);
+        stack.push_back(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            // Distance from the centre to the nearest point of the box
+            const glm::vec3 offset = center - glm::clamp(center, node.box.min, node.box.max);
+            if (glm::dot(offset, offset) > radiusSquared) continue;
+
+            if (node.IsLeaf()) {
+                out.push_back(node.userData);
+                continue;
+            }
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    bool bwxGLBVH::RayBox(const bwxGLBoundingBox& box, const glm::vec3& origin, const glm::vec3& inverse, float maxDistance, float& distance) const {
+        const glm::vec3 t1 = (box.min - origin) * inverse;
+        const glm::vec3 t2 = (box.max - origin) * inverse;
+        const glm::vec3 tNear = glm::min(t1, t2);
+        const glm::vec3 tFar = glm::max(t1, t2);
+
+        const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        if (enter > exit) return false;
+
+        distance = enter;
+        return true;
+    }
+
+    void bwxGLBVH::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+        std::vector<std::pair<void*, float>>& out) const {
+        const float length = glm::length(direction);
+        if (m_root == bwxGL_BVH_NULL_NODE || length <= 0.0f) return;
+
+        // Division by zero gives infinities, which the slab test handles
+        const glm::vec3 inverse = 1.0f / (direction / length);
+        const size_t first = out.size();
+
+        std::vector<int32_t> stack;
+        stack.reserve(STACK_RESERVE);
+        stack.push_back(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            float distance = 0.0f;
+            if (!RayBox(node.box, origin, inverse, maxDistance, distance)) continue;
+
+            if (node.IsLeaf()) {
+                out.emplace_back(node.userData, distance);
+                continue;
+            }
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+            [](const std::pair<void*, float>& a, const std::pair<void*, float>& b) { return a.second < b.second; });
+    }
+
+    void* bwxGLBVH::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float* distance) const {
+        const float length = glm::length(direction);
+        if (m_root == bwxGL_BVH_NULL_NODE || length <= 0.0f) return nullptr;
+
+        const glm::vec3 inverse = 1.0f / (direction / length);
+        float best = maxDistance;
+        void* hit = nullptr;
+
+        // The nearest hit so far shortens the ray, so boxes behind it are never entered
+        std::vector<int32_t> stack;
+        stack.reserve(STACK_RESERVE);
+        stack.push_back(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            float enter = 0.0f;
+            if (!RayBox(node.box, origin, inverse, best, enter)) continue;
+
+            if (node.IsLeaf()) {
+                if (!hit || enter < best) {
+                    best = enter;
+                    hit = node.userData;
+                }
+                continue;
+            }
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+
+        if (hit && distance) *distance = best;
+        return hit;
+    }
+
+} // namespace bwx_sdk
@@ -70,6 +70,14 @@ namespace bwx_sdk {
         return m_fov;
     }
 
+    float bwxGLCameraComponent::GetNearPlane() const {
+        return m_nearPlane;
+    }
+
+    float bwxGLCameraComponent::GetFarPlane() const {
+        return m_farPlane;
+    }
+
     void bwxGLCameraComponent::Update(float /*deltaTime*/) {
         RecalculateViewMatrix();
     }
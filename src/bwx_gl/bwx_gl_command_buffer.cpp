@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_command_buffer.cpp
+// Purpose:     BWX_SDK Library; OpenGL Recorded command list (linear arena)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cstdint>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_buffer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_command_buffer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+
+namespace bwx_sdk {
+
+    bwxGLCommandBuffer::bwxGLCommandBuffer(size_t blockSize) : m_blockSize(blockSize > 0 ? blockSize : bwxGL_COMMAND_BLOCK_SIZE) {}
+
+    bwxGLCommandBuffer::~bwxGLCommandBuffer() {
+        Reset();
+    }
+
+    void* bwxGLCommandBuffer::Allocate(size_t size, size_t alignment) {
+        // Current block first, then the following ones kept from earlier frames
+        for (; m_block < m_blocks.size(); ++m_block) {
+            Block& block = m_blocks[m_block];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            const uintptr_t start = (base + block.used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            if (start + size <= base + block.size) {
+                m_used += start + size - (base + block.used);
+                block.used = start + size - base;
+                return reinterpret_cast<void*>(start);
+            }
+        }
+
+        // Only while the frame is bigger than any before it
+        Block block;
+        block.size = std::max(m_blockSize, size + alignment);
+        block.data.reset(new unsigned char[block.size]);
+        m_blocks.push_back(std::move(block));
+        m_block = m_blocks.size() - 1;
+        return Allocate(size, alignment);
+    }
+
+    void bwxGLCommandBuffer::Append(Command* command) {
+        if (m_last) m_last->next = command;
+        else m_first = command;
+        m_last = command;
+        ++m_count;
+    }
+
+    void bwxGLCommandBuffer::UploadBuffer(bwxGLBuffer* buffer, GLintptr offset, const void* data, GLsizeiptr size) {
+        if (!buffer || size <= 0) return;
+
+        const void* copy = Copy(static_cast<const unsigned char*>(data), static_cast<size_t>(size));
+        Record([buffer, offset, copy, size] {
+            buffer->SetSubData(offset, copy, size);
+            bwxGLProfiler::GetInstance().AddUploadedBytes(static_cast<uint64_t>(size));
+        });
+    }
+
+    void bwxGLCommandBuffer::BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+        Record([target, index, buffer] { glBindBufferBase(target, index, buffer); });
+    }
+
+    void bwxGLCommandBuffer::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        Record([x, y, width, height] { glViewport(x, y, width, height); });
+    }
+
+    void bwxGLCommandBuffer::ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+        Record([r, g, b, a] { glClearColor(r, g, b, a); });
+    }
+
+    void bwxGLCommandBuffer::Clear(GLbitfield mask) {
+        Record([mask] { glClear(mask); });
+    }
+
+    void bwxGLCommandBuffer::Execute() {
+        for (Command* command = m_first; command; command = command->next) command->execute(command);
+    }
+
+    void bwxGLCommandBuffer::Reset() {
+        for (Command* command = m_first; command;) {
+            Command* next = command->next;
+            if (command->destroy) command->destroy(command);
+            command = next;
+        }
+
+        m_first = m_last = nullptr;
+        m_count = 0;
+        m_used = 0;
+        m_block = 0;
+        for (Block& block : m_blocks) block.used = 0;
+    }
+
+    size_t bwxGLCommandBuffer::GetCapacity() const {
+        size_t capacity = 0;
+        for (const Block& block : m_blocks) capacity += block.size;
+        return capacity;
+    }
+
+} // namespace bwx_sdk
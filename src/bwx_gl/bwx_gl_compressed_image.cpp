@@ -0,0 +1,420 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_compressed_image.cpp
+// Purpose:     BWX_SDK Library; OpenGL KTX2/DDS container loading
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <wx/filename.h>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_compressed_image.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+        constexpr uint32_t FourCC(char a, char b, char c, char d) {
+            return static_cast<uint32_t>(static_cast<unsigned char>(a)) | (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8) |
+                   (static_cast<uint32_t>(static_cast<unsigned char>(c)) << 16) | (static_cast<uint32_t>(static_cast<unsigned char>(d)) << 24);
+        }
+
+        // Both containers are little endian
+        inline uint32_t ReadU32(const unsigned char* p) {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        inline uint64_t ReadU64(const unsigned char* p) {
+            return static_cast<uint64_t>(ReadU32(p)) | (static_cast<uint64_t>(ReadU32(p + 4)) << 32);
+        }
+
+        // ASTC block footprints, in the order of the GL (and Vulkan) format enums
+        const int ASTC_BLOCKS[14][2] = {
+            { 4, 4 }, { 5, 4 }, { 5, 5 }, { 6, 5 }, { 6, 6 }, { 8, 5 }, { 8, 6 },
+            { 8, 8 }, { 10, 5 }, { 10, 6 }, { 10, 8 }, { 10, 10 }, { 12, 10 }, { 12, 12 }
+        };
+
+        inline bool IsASTC(GLenum format, int& index) {
+            if (format >= GL_COMPRESSED_RGBA_ASTC_4x4_KHR && format <= GL_COMPRESSED_RGBA_ASTC_12x12_KHR) {
+                index = static_cast<int>(format - GL_COMPRESSED_RGBA_ASTC_4x4_KHR);
+                return true;
+            }
+            if (format >= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR && format <= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR) {
+                index = static_cast<int>(format - GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR);
+                return true;
+            }
+            return false;
+        }
+
+        GLenum FromVkFormat(uint32_t vkFormat, bool& alpha) {
+            alpha = true;
+            if (vkFormat >= 157 && vkFormat <= 184) {
+                const GLenum index = (vkFormat - 157) / 2;
+                return (vkFormat - 157) % 2 ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR + index : GL_COMPRESSED_RGBA_ASTC_4x4_KHR + index;
+            }
+
+            switch (vkFormat) {
+            case 23: alpha = false; return GL_RGB8;
+            case 29: alpha = false; return GL_SRGB8;
+            case 37: return GL_RGBA8;
+            case 43: return GL_SRGB8_ALPHA8;
+            case 131: alpha = false; return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case 132: alpha = false; return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+            case 133: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case 134: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 135: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case 136: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 137: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case 138: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 139: alpha = false; return GL_COMPRESSED_RED_RGTC1;
+            case 140: alpha = false; return GL_COMPRESSED_SIGNED_RED_RGTC1;
+            case 141: alpha = false; return GL_COMPRESSED_RG_RGTC2;
+            case 142: alpha = false; return GL_COMPRESSED_SIGNED_RG_RGTC2;
+            case 143: alpha = false; return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+            case 144: alpha = false; return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+            case 145: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case 146: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+            case 147: alpha = false; return GL_COMPRESSED_RGB8_ETC2;
+            case 148: alpha = false; return GL_COMPRESSED_SRGB8_ETC2;
+            case 149: return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 150: return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 151: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+            case 152: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+            case 153: alpha = false; return GL_COMPRESSED_R11_EAC;
+            case 154: alpha = false; return GL_COMPRESSED_SIGNED_R11_EAC;
+            case 155: alpha = false; return GL_COMPRESSED_RG11_EAC;
+            case 156: alpha = false; return GL_COMPRESSED_SIGNED_RG11_EAC;
+            default: return 0;
+            }
+        }
+
+        GLenum FromDXGIFormat(uint32_t dxgiFormat, bool& alpha) {
+            alpha = true;
+            switch (dxgiFormat) {
+            case 28: return GL_RGBA8;
+            case 29: return GL_SRGB8_ALPHA8;
+            case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 80: alpha = false; return GL_COMPRESSED_RED_RGTC1;
+            case 81: alpha = false; return GL_COMPRESSED_SIGNED_RED_RGTC1;
+            case 83: alpha = false; return GL_COMPRESSED_RG_RGTC2;
+            case 84: alpha = false; return GL_COMPRESSED_SIGNED_RG_RGTC2;
+            case 95: alpha = false; return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+            case 96: alpha = false; return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+            case 98: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case 99: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+            default: return 0;
+            }
+        }
+    }
+
+    void bwxGLCompressedImage::Reset() {
+        m_data.clear();
+        m_levels.clear();
+        m_format = 0;
+        m_compressed = false;
+        m_alpha = false;
+    }
+
+    bool bwxGLCompressedImage::Load(const wxString& file) {
+        Reset();
+
+        std::ifstream in(file.fn_str(), std::ios::binary);
+        if (!in) return false;
+
+        std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        if (bytes.size() >= 4 && ReadU32(bytes.data()) == FourCC('D', 'D', 'S', ' ')) return LoadDDS(bytes.data(), bytes.size());
+        if (bytes.size() >= sizeof(KTX2_IDENTIFIER) && std::memcmp(bytes.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0) {
+            return LoadKTX2(bytes.data(), bytes.size());
+        }
+        return false;
+    }
+
+    bool bwxGLCompressedImage::IsContainer(const wxString& file) {
+        const wxString ext = wxFileName(file).GetExt().Lower();
+        return ext == "dds" || ext == "ktx2";
+    }
+
+    bool bwxGLCompressedImage::LoadDDS(const unsigned char* data, size_t size) {
+        Reset();
+        if (size < 128 || ReadU32(data) != FourCC('D', 'D', 'S', ' ')) return false;
+
+        const int height = static_cast<int>(ReadU32(data + 12));
+        const int width = static_cast<int>(ReadU32(data + 16));
+        const uint32_t mipCount = std::max<uint32_t>(ReadU32(data + 28), 1);
+        const uint32_t pfFlags = ReadU32(data + 80);
+        const uint32_t fourCC = ReadU32(data + 84);
+        const uint32_t bitCount = ReadU32(data + 88);
+        const uint32_t caps2 = ReadU32(data + 112);
+
+        if (width <= 0 || height <= 0) return false;
+        if (caps2 & 0x200) return false; // Cube maps are not 2D textures
+
+        size_t offset = 128;
+        GLenum format = 0;
+        bool alpha = false;
+
+        if (pfFlags & 0x4) { // DDPF_FOURCC
+            switch (fourCC) {
+            case FourCC('D', 'X', 'T', '1'): format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+            case FourCC('D', 'X', 'T', '3'): format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; alpha = true; break;
+            case FourCC('D', 'X', 'T', '5'): format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; alpha = true; break;
+            case FourCC('A', 'T', 'I', '1'):
+            case FourCC('B', 'C', '4', 'U'): format = GL_COMPRESSED_RED_RGTC1; break;
+            case FourCC('B', 'C', '4', 'S'): format = GL_COMPRESSED_SIGNED_RED_RGTC1; break;
+            case FourCC('A', 'T', 'I', '2'):
+            case FourCC('B', 'C', '5', 'U'): format = GL_COMPRESSED_RG_RGTC2; break;
+            case FourCC('B', 'C', '5', 'S'): format = GL_COMPRESSED_SIGNED_RG_RGTC2; break;
+            case FourCC('D', 'X', '1', '0'):
+                if (size < 148) return false;
+                if (ReadU32(data + 136) & 0x4) return false; // DDS_RESOURCE_MISC_TEXTURECUBE
+                format = FromDXGIFormat(ReadU32(data + 128), alpha);
+                offset = 148;
+                break;
+            default: break;
+            }
+        }
+        else if (pfFlags & 0x40) { // DDPF_RGB, only byte ordered R, G, B(, A)
+            const bool rgbaOrder = ReadU32(data + 92) == 0x000000FF && ReadU32(data + 96) == 0x0000FF00 && ReadU32(data + 100) == 0x00FF0000;
+            if (rgbaOrder && bitCount == 32) {
+                format = GL_RGBA8;
+                alpha = (pfFlags & 0x1) != 0;
+            }
+            else if (rgbaOrder && bitCount == 24) {
+                format = GL_RGB8;
+            }
+        }
+
+        if (!SetFormat(format, alpha)) return false;
+
+        int levelWidth = width, levelHeight = height;
+        for (uint32_t level = 0; level < mipCount; ++level) {
+            if (!AddLevel(levelWidth, levelHeight, data + offset, size - offset)) break;
+            offset += m_levels.back().size;
+            if (levelWidth == 1 && levelHeight == 1) break;
+            levelWidth = std::max(levelWidth / 2, 1);
+            levelHeight = std::max(levelHeight / 2, 1);
+        }
+
+        return !m_levels.empty();
+    }
+
+    bool bwxGLCompressedImage::LoadKTX2(const unsigned char* data, size_t size) {
+        Reset();
+        if (size < 80 || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) return false;
+
+        const uint32_t vkFormat = ReadU32(data + 12);
+        const int width = static_cast<int>(ReadU32(data + 20));
+        const int height = static_cast<int>(ReadU32(data + 24));
+        const uint32_t depth = ReadU32(data + 28);
+        const uint32_t layers = ReadU32(data + 32);
+        const uint32_t faces = ReadU32(data + 36);
+        const uint32_t levelCount = std::max<uint32_t>(ReadU32(data + 40), 1);
+        const uint32_t supercompression = ReadU32(data + 44);
+
+        // Plain 2D images only; Basis/zstd payloads would need a transcoder
+        if (width <= 0 || height <= 0 || depth > 1 || layers > 1 || faces != 1 || supercompression != 0) return false;
+        if (size < 80 + static_cast<size_t>(levelCount) * 24) return false;
+
+        bool alpha = false;
+        if (!SetFormat(FromVkFormat(vkFormat, alpha), alpha)) return false;
+
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            const unsigned char* entry = data + 80 + static_cast<size_t>(level) * 24;
+            const uint64_t byteOffset = ReadU64(entry);
+            const uint64_t byteLength = ReadU64(entry + 8);
+            if (byteOffset > size || byteLength > size - byteOffset) break;
+
+            const int levelWidth = std::max(width >> level, 1);
+            const int levelHeight = std::max(height >> level, 1);
+            if (!AddLevel(levelWidth, levelHeight, data + byteOffset, static_cast<size_t>(byteLength))) break;
+        }
+
+        return !m_levels.empty();
+    }
+
+    bool bwxGLCompressedImage::SetFormat(GLenum format, bool alpha) {
+        int blockWidth, blockHeight, blockBytes;
+        if (!GetBlockInfo(format, blockWidth, blockHeight, blockBytes)) return false;
+
+        m_format = format;
+        m_compressed = blockWidth > 1;
+        m_alpha = alpha;
+        return true;
+    }
+
+    bool bwxGLCompressedImage::AddLevel(int width, int height, const unsigned char* data, size_t available) {
+        int blockWidth, blockHeight, blockBytes;
+        GetBlockInfo(m_format, blockWidth, blockHeight, blockBytes);
+
+        const size_t size = static_cast<size_t>((width + blockWidth - 1) / blockWidth) *
+                            static_cast<size_t>((height + blockHeight - 1) / blockHeight) * static_cast<size_t>(blockBytes);
+        if (size > available) return false;
+
+        bwxGLImageLevel level;
+        level.width = width;
+        level.height = height;
+        level.offset = m_data.size();
+        level.size = size;
+
+        m_data.insert(m_data.end(), data, data + size);
+        m_levels.push_back(level);
+        return true;
+    }
+
+    size_t bwxGLCompressedImage::GetDataSize() const {
+        return m_data.size();
+    }
+
+    bool bwxGLCompressedImage::GetBlockInfo(GLenum format, int& blockWidth, int& blockHeight, int& blockBytes) {
+        blockWidth = blockHeight = 4;
+
+        int astc = 0;
+        if (IsASTC(format, astc)) {
+            blockWidth = ASTC_BLOCKS[astc][0];
+            blockHeight = ASTC_BLOCKS[astc][1];
+            blockBytes = 16;
+            return true;
+        }
+
+        switch (format) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_SIGNED_RED_RGTC1:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_SRGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_R11_EAC:
+        case GL_COMPRESSED_SIGNED_R11_EAC:
+            blockBytes = 8;
+            return true;
+
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RG_RGTC2:
+        case GL_COMPRESSED_SIGNED_RG_RGTC2:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+        case GL_COMPRESSED_RG11_EAC:
+        case GL_COMPRESSED_SIGNED_RG11_EAC:
+            blockBytes = 16;
+            return true;
+
+        case GL_RGBA8:
+        case GL_SRGB8_ALPHA8:
+            blockWidth = blockHeight = 1;
+            blockBytes = 4;
+            return true;
+
+        case GL_RGB8:
+        case GL_SRGB8:
+            blockWidth = blockHeight = 1;
+            blockBytes = 3;
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    bool bwxGLCompressedImage::IsFormatSupported(GLenum format) {
+        int astc = 0;
+        if (IsASTC(format, astc)) return GLEW_KHR_texture_compression_astc_ldr;
+
+        switch (format) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            return GLEW_EXT_texture_compression_s3tc;
+
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+            return GLEW_EXT_texture_compression_s3tc && GLEW_EXT_texture_sRGB;
+
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_SIGNED_RED_RGTC1:
+        case GL_COMPRESSED_RG_RGTC2:
+        case GL_COMPRESSED_SIGNED_RG_RGTC2:
+            return GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+            return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_SRGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+        case GL_COMPRESSED_R11_EAC:
+        case GL_COMPRESSED_SIGNED_R11_EAC:
+        case GL_COMPRESSED_RG11_EAC:
+        case GL_COMPRESSED_SIGNED_RG11_EAC:
+            return GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+
+        case GL_RGBA8:
+        case GL_SRGB8_ALPHA8:
+        case GL_RGB8:
+        case GL_SRGB8:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    GLenum bwxGLCompressedImage::ToSRGB(GLenum format) {
+        if (format >= GL_COMPRESSED_RGBA_ASTC_4x4_KHR && format <= GL_COMPRESSED_RGBA_ASTC_12x12_KHR) {
+            return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR + (format - GL_COMPRESSED_RGBA_ASTC_4x4_KHR);
+        }
+
+        switch (format) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+        case GL_COMPRESSED_RGB8_ETC2: return GL_COMPRESSED_SRGB8_ETC2;
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2: return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        case GL_COMPRESSED_RGBA8_ETC2_EAC: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+        case GL_RGBA8: return GL_SRGB8_ALPHA8;
+        case GL_RGB8: return GL_SRGB8;
+        default: return format;
+        }
+    }
+
+} // namespace bwx_sdk
@@ -0,0 +1,155 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_dynamic_resolution.cpp
+// Purpose:     BWX_SDK Library; OpenGL Dynamic resolution driven by GPU frame time
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_dynamic_resolution.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+
+namespace bwx_sdk {
+
+    void bwxGLDynamicResolution::SetEnabled(bool enabled) {
+        if (enabled == m_enabled) return;
+        m_enabled = enabled;
+        m_averageMs = -1.0;
+        if (!enabled) Release();
+    }
+
+    void bwxGLDynamicResolution::SetScaleLimits(float minScale, float maxScale) {
+        m_minScale = std::clamp(minScale, 0.1f, 2.0f);
+        m_maxScale = std::clamp(maxScale, m_minScale, 2.0f);
+        m_scale = std::clamp(m_scale, m_minScale, m_maxScale);
+    }
+
+    void bwxGLDynamicResolution::SetScale(float scale) {
+        m_scale = std::clamp(scale, m_minScale, m_maxScale);
+        m_averageMs = -1.0;
+    }
+
+    void bwxGLDynamicResolution::Adjust(double gpuMs) {
+        // Smoothed, so one slow frame does not move the scale
+        m_averageMs = m_averageMs < 0.0 ? gpuMs : m_averageMs * 0.8 + gpuMs * 0.2;
+
+        // Scale that would just hit the target if cost follows the pixel count
+        const double ideal = m_scale * std::sqrt(m_targetMs / std::max(m_averageMs, 0.01));
+
+        // Down as soon as the target is missed, up only with clear headroom - no oscillation around the target
+        float scale = m_scale;
+        if (ideal < m_scale) scale = std::max(m_scale - m_step, static_cast<float>(ideal));
+        else if (ideal > m_scale * 1.05) scale = std::min(m_scale + m_step, static_cast<float>(ideal / 1.05));
+        scale = std::clamp(scale, m_minScale, m_maxScale);
+
+        if (std::abs(scale - m_scale) < 0.005f) return;
+        m_scale = scale;
+        m_averageMs = -1.0;
+    }
+
+    bool bwxGLDynamicResolution::Begin() {
+        m_active = false;
+        if (!m_enabled) return false;
+
+        // Every resolved frame once; reports lag behind, so those still at an older scale are skipped
+        const bwxGLProfileReport& report = bwxGLProfiler::GetInstance().GetReport();
+        if (report.frame != m_lastReport) {
+            m_lastReport = report.frame;
+            const double gpuMs = report.GetGPUFrameTime();
+            if (gpuMs > 0.0 && report.frame >= m_settleUntil) {
+                const float previous = m_scale;
+                Adjust(gpuMs);
+                if (m_scale != previous) m_settleUntil = report.frame + bwxGL_PROFILER_FRAME_LATENCY + 1;
+            }
+        }
+
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        if (viewport[2] <= 0 || viewport[3] <= 0) return false;
+
+        // Sized for the largest scale, so changing the scale only changes the viewport
+        const glm::ivec2 targetSize(static_cast<int>(std::ceil(viewport[2] * m_maxScale)),
+            static_cast<int>(std::ceil(viewport[3] * m_maxScale)));
+        if (targetSize != m_targetSize && !CreateTarget(targetSize.x, targetSize.y)) return false;
+
+        m_native = glm::ivec4(viewport[0], viewport[1], viewport[2], viewport[3]);
+        m_size = glm::ivec2(std::clamp(static_cast<int>(std::lround(viewport[2] * m_scale)), 1, targetSize.x),
+            std::clamp(static_cast<int>(std::lround(viewport[3] * m_scale)), 1, targetSize.y));
+
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_previousFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+        glViewport(0, 0, m_size.x, m_size.y);
+
+        // With the application's clear colour, as the canvas got before RenderAll()
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+        m_active = true;
+        return true;
+    }
+
+    void bwxGLDynamicResolution::End() {
+        if (!m_active) return;
+        m_active = false;
+
+        // Linear blit: the cheapest upscale there is, done without a shader or a full-screen pass
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(m_previousFramebuffer));
+        glBlitFramebuffer(0, 0, m_size.x, m_size.y,
+            m_native.x, m_native.y, m_native.x + m_native.z, m_native.y + m_native.w,
+            GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_previousFramebuffer));
+        glViewport(m_native.x, m_native.y, m_native.z, m_native.w);
+    }
+
+    bool bwxGLDynamicResolution::CreateTarget(int width, int height) {
+        Release();
+
+        glGenRenderbuffers(1, &m_colorTarget);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_colorTarget);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glGenRenderbuffers(1, &m_depthTarget);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_depthTarget);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGenFramebuffers(1, &m_framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorTarget);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthTarget);
+        const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "DynamicResolution: scene framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+            Release();
+            return false;
+        }
+
+        m_targetSize = glm::ivec2(width, height);
+        return true;
+    }
+
+    void bwxGLDynamicResolution::Release() {
+        if (m_framebuffer) glDeleteFramebuffers(1, &m_framebuffer);
+        if (m_colorTarget) glDeleteRenderbuffers(1, &m_colorTarget);
+        if (m_depthTarget) glDeleteRenderbuffers(1, &m_depthTarget);
+        m_framebuffer = 0;
+        m_colorTarget = 0;
+        m_depthTarget = 0;
+        m_targetSize = glm::ivec2(0);
+        m_active = false;
+    }
+
+} // namespace bwx_sdk
@@ -0,0 +1,210 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_geometry_pool.cpp
+// Purpose:     BWX_SDK Library; OpenGL Shared vertex/index buffer suballocation
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_geometry_pool.h>
+
+namespace bwx_sdk {
+
+    bwxGLRangeAllocator::bwxGLRangeAllocator(GLsizeiptr capacity) {
+        Grow(capacity);
+    }
+
+    GLsizeiptr bwxGLRangeAllocator::Allocate(GLsizeiptr size, GLsizeiptr alignment) {
+        if (size <= 0) return INVALID;
+        if (alignment < 1) alignment = 1;
+
+        for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+            const GLsizeiptr blockStart = it->first;
+            const GLsizeiptr blockEnd = it->first + it->second;
+            const GLsizeiptr start = (blockStart + alignment - 1) / alignment * alignment;
+            if (start + size > blockEnd) continue;
+
+            // Split the block into the alignment gap, the allocation and the tail
+            m_free.erase(it);
+            if (start > blockStart) m_free[blockStart] = start - blockStart;
+            if (start + size < blockEnd) m_free[start + size] = blockEnd - (start + size);
+
+            m_used += size;
+            return start;
+        }
+
+        return INVALID;
+    }
+
+    void bwxGLRangeAllocator::Free(GLsizeiptr offset, GLsizeiptr size) {
+        if (offset < 0 || size <= 0) return;
+
+        m_used -= size;
+        auto it = m_free.emplace(offset, size).first;
+
+        // Merge with the following range
+        auto next = std::next(it);
+        if (next != m_free.end() && it->first + it->second == next->first) {
+            it->second += next->second;
+            m_free.erase(next);
+        }
+
+        // Merge with the preceding range
+        if (it != m_free.begin()) {
+            auto prev = std::prev(it);
+            if (prev->first + prev->second == it->first) {
+                prev->second += it->second;
+                m_free.erase(it);
+            }
+        }
+    }
+
+    void bwxGLRangeAllocator::Grow(GLsizeiptr capacity) {
+        if (capacity <= m_capacity) return;
+
+        const GLsizeiptr oldCapacity = m_capacity;
+        m_capacity = capacity;
+
+        // The new tail is free; Free() merges it with a free range at the old end
+        m_used += capacity - oldCapacity;
+        Free(oldCapacity, capacity - oldCapacity);
+    }
+
+    bwxGLGeometryPool::bwxGLGeometryPool(const bwxGLVertexLayout& layout, GLsizeiptr vertexBytes, GLsizeiptr indexBytes)
+        : m_layout(layout) {
+        const GLsizeiptr stride = std::max<GLsizeiptr>(m_layout.GetStride(), 1);
+        vertexBytes = std::max<GLsizeiptr>(vertexBytes / stride, 1) * stride;
+
+        m_vertexAllocator.Grow(vertexBytes);
+        m_indexAllocator.Grow(indexBytes);
+
+        // No VAO bound while the element buffer is created, it would capture the binding
+        glBindVertexArray(0);
+        m_vbo = new bwxGLBuffer(GL_ARRAY_BUFFER);
+        m_vbo->SetData(nullptr, vertexBytes, GL_STATIC_DRAW);
+        m_ebo = new bwxGLBuffer(GL_ELEMENT_ARRAY_BUFFER);
+        m_ebo->SetData(nullptr, indexBytes, GL_STATIC_DRAW);
+
+        glGenVertexArrays(1, &m_vao);
+        SetupVAO();
+    }
+
+    bwxGLGeometryPool::~bwxGLGeometryPool() {
+        if (m_vao) glDeleteVertexArrays(1, &m_vao);
+        delete m_vbo;
+        delete m_ebo;
+    }
+
+    void bwxGLGeometryPool::SetupVAO() {
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo->GetID());
+        m_layout.Apply();
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo->GetID());
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    bwxGLBuffer* bwxGLGeometryPool::Resize(bwxGLBuffer* buffer, GLenum target, GLsizeiptr oldSize, GLsizeiptr newSize) {
+        glBindVertexArray(0);
+        bwxGLBuffer* resized = new bwxGLBuffer(target);
+        resized->SetData(nullptr, newSize, GL_STATIC_DRAW);
+
+        // GPU side copy, the data never comes back to the CPU
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer->GetID());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, resized->GetID());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        delete buffer;
+        return resized;
+    }
+
+    bool bwxGLGeometryPool::Allocate(GLsizei vertexCount, GLsizeiptr indexBytes, bwxGLGeometryAllocation& allocation) {
+        const GLsizeiptr stride = m_layout.GetStride();
+        const GLsizeiptr vertexBytes = static_cast<GLsizeiptr>(vertexCount) * stride;
+        if (vertexBytes <= 0) return false;
+
+        GLsizeiptr vertexOffset = m_vertexAllocator.Allocate(vertexBytes, stride);
+        while (vertexOffset == bwxGLRangeAllocator::INVALID) {
+            const GLsizeiptr oldSize = m_vertexAllocator.GetCapacity();
+            const GLsizeiptr newSize = std::max(oldSize * 2, oldSize + vertexBytes) / stride * stride + stride;
+            m_vbo = Resize(m_vbo, GL_ARRAY_BUFFER, oldSize, newSize);
+            m_vertexAllocator.Grow(newSize);
+            SetupVAO();
+            vertexOffset = m_vertexAllocator.Allocate(vertexBytes, stride);
+        }
+
+        GLsizeiptr indexOffset = 0;
+        if (indexBytes > 0) {
+            indexOffset = m_indexAllocator.Allocate(indexBytes, 4);
+            while (indexOffset == bwxGLRangeAllocator::INVALID) {
+                const GLsizeiptr oldSize = m_indexAllocator.GetCapacity();
+                const GLsizeiptr newSize = std::max(oldSize * 2, oldSize + indexBytes + 4);
+                m_ebo = Resize(m_ebo, GL_ELEMENT_ARRAY_BUFFER, oldSize, newSize);
+                m_indexAllocator.Grow(newSize);
+                SetupVAO();
+                indexOffset = m_indexAllocator.Allocate(indexBytes, 4);
+            }
+        }
+
+        allocation.vertexOffset = vertexOffset;
+        allocation.vertexSize = vertexBytes;
+        allocation.indexOffset = indexOffset;
+        allocation.indexSize = indexBytes;
+        allocation.baseVertex = static_cast<GLint>(vertexOffset / stride);
+        return true;
+    }
+
+    void bwxGLGeometryPool::Free(bwxGLGeometryAllocation& allocation) {
+        if (!allocation.IsValid()) return;
+
+        m_vertexAllocator.Free(allocation.vertexOffset, allocation.vertexSize);
+        if (allocation.indexSize > 0) m_indexAllocator.Free(allocation.indexOffset, allocation.indexSize);
+
+        allocation = bwxGLGeometryAllocation();
+    }
+
+    void* bwxGLGeometryPool::MapVertices(const bwxGLGeometryAllocation& allocation) {
+        if (!allocation.IsValid()) return nullptr;
+
+        m_vbo->Bind();
+        void* ptr = glMapBufferRange(GL_ARRAY_BUFFER, allocation.vertexOffset, allocation.vertexSize,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        m_mapped = ptr != nullptr;
+
+        if (!m_mapped) {
+            m_vbo->Unbind();
+            m_staging.resize(static_cast<size_t>(allocation.vertexSize));
+            ptr = m_staging.data();
+        }
+        return ptr;
+    }
+
+    bool bwxGLGeometryPool::UnmapVertices(const bwxGLGeometryAllocation& allocation) {
+        if (m_mapped) {
+            m_mapped = false;
+            return m_vbo->Unmap();
+        }
+
+        m_vbo->SetSubData(allocation.vertexOffset, m_staging.data(), allocation.vertexSize);
+        m_staging.clear();
+        return true;
+    }
+
+    void bwxGLGeometryPool::WriteIndices(const bwxGLGeometryAllocation& allocation, const void* data) {
+        if (!allocation.IsValid() || allocation.indexSize <= 0) return;
+
+        // Not through the shared VAO: the SetSubData bind/unbind would detach its EBO
+        glBindVertexArray(0);
+        m_ebo->SetSubData(allocation.indexOffset, data, allocation.indexSize);
+    }
+
+} // namespace bwx_sdk
@@ -13,6 +13,7 @@
 
 #include <bwx_sdk/bwx_gl/bwx_gl_image_loader.h>
 #include <wx/image.h>
+#include <cstring>
 #include <iostream>
 
 #include <bwx_sdk/bwx_globals.h>
@@ -27,90 +28,95 @@ namespace bwx_sdk {
     }
 
     bool bwxGLImgLoader::Load(const wxString& file, bwxGL_IMG_ROTATE_MODE rotate, bool forcePowerOf2) {
-        if (!LoadFile(file)) return false;
-
-        m_width = GetWidth();
-        m_height = GetHeight();
-
-        // Rotate before transformations
-        RotateImage(rotate);
-
         // Sprawdzenie, czy OpenGL wymaga tekstur o potdze 2
         GLint textureCompression;
         glGetIntegerv(GL_TEXTURE_COMPRESSION_HINT, &textureCompression);
         bool openglRequiresPowerOf2 = (textureCompression == GL_NICEST);
 
-        // Skalowanie do wielokrotnoci 2, jeli wymagane
-        if (forcePowerOf2 || openglRequiresPowerOf2) {
-            bool rescale = false;
-            int newWidth = m_width;
-            int newHeight = m_height;
+        return Decode(file, rotate, forcePowerOf2 || openglRequiresPowerOf2);
+    }
 
-            if (!math::bwxIsPower2(m_width)) {
-                newWidth = math::bwxNextPower2(m_width);
-                rescale = true;
-            }
+    bool bwxGLImgLoader::Decode(const wxString& file, bwxGL_IMG_ROTATE_MODE rotate, bool powerOf2) {
+        if (!Open(file, rotate, powerOf2)) return false;
 
-            if (!math::bwxIsPower2(m_height)) {
-                newHeight = math::bwxNextPower2(m_height);
-                rescale = true;
-            }
+        m_data.resize(GetDataSize());
+        return CopyTo(m_data.data(), m_data.size());
+    }
 
-            if (rescale) {
-                Rescale(newWidth, newHeight, wxIMAGE_QUALITY_HIGH);
-                m_width = newWidth;
-                m_height = newHeight;
-            }
+    bool bwxGLImgLoader::Open(const wxString& file, bwxGL_IMG_ROTATE_MODE rotate, bool powerOf2) {
+        m_data.clear();
+        if (!LoadFile(file)) return false;
+
+        // Skalowanie do wielokrotnoci 2, jeli wymagane (przed obrotem - wymiary potgi 2 zamieniaj si tylko miejscami)
+        if (powerOf2) {
+            const int width = GetWidth();
+            const int height = GetHeight();
+            const int newWidth = math::bwxIsPower2(width) ? width : math::bwxNextPower2(width);
+            const int newHeight = math::bwxIsPower2(height) ? height : math::bwxNextPower2(height);
+            if (newWidth != width || newHeight != height) Rescale(newWidth, newHeight, wxIMAGE_QUALITY_HIGH);
         }
 
-        // Bytes Per Pixel
-        int bpp = HasAlpha() ? 4 : 3;
-        m_data.resize(m_width * m_height * bpp);
+        m_rotate = rotate;
+        m_alpha = wxImage::HasAlpha();
 
-        GLubyte* bitmap = GetData();
-        const GLubyte* alpha = HasAlpha() ? GetAlpha() : nullptr;
+        // Obrt o 90 stopni zamienia wymiary; same piksele obraca dopiero CopyTo()
+        const bool swapped = rotate == bwxGL_IMG_ROTATE_MODE::IMG_ROTATE90 || rotate == bwxGL_IMG_ROTATE_MODE::IMG_ROTATE270;
+        m_width = swapped ? GetHeight() : GetWidth();
+        m_height = swapped ? GetWidth() : GetHeight();
+        return true;
+    }
 
-        // Copy data to OpenGL format
-        int mod = m_height - 1;
-        for (int y = 0; y < m_height; y++) {
-            for (int x = 0; x < m_width; x++) {
-                int srcIdx = (x + (mod - y) * m_width) * 3;
-                int dstIdx = (x + y * m_width) * bpp;
+    bool bwxGLImgLoader::CopyTo(GLubyte* destination, size_t size) {
+        if (!IsOk() || !destination || size < GetDataSize()) return false;
 
-                m_data[dstIdx + 0] = bitmap[srcIdx + 0]; // Red
-                m_data[dstIdx + 1] = bitmap[srcIdx + 1]; // Green
-                m_data[dstIdx + 2] = bitmap[srcIdx + 2]; // Blue
+        const int srcWidth = GetWidth();
+        const int srcHeight = GetHeight();
+        const int bpp = GetBytesPerPixel();
+        const GLubyte* bitmap = GetData();
+        const GLubyte* alpha = m_alpha ? GetAlpha() : nullptr;
 
-                if (bpp == 4) {
-                    m_data[dstIdx + 3] = alpha ? alpha[x + (mod - y) * m_width] : 255;
-                }
+        // Dane w kolejnoci OpenGL (od dolnego wiersza) - bez obrotu i kanau alfa wiersz to jedno memcpy
+        if (m_rotate == bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0 && bpp == 3) {
+            const size_t row = static_cast<size_t>(srcWidth) * 3;
+            for (int y = 0; y < m_height; y++) {
+                std::memcpy(destination + y * row, bitmap + (m_height - 1 - y) * row, row);
             }
         }
-        return true;
-    }
+        else {
+            // Dla kadego wiersza wyjcia: pierwszy piksel rda i krok w rdle
+            for (int y = 0; y < m_height; y++) {
+                int sx = 0, sy = 0, dx = 0, dy = 0;
+                switch (m_rotate) {
+                case bwxGL_IMG_ROTATE_MODE::IMG_ROTATE90:   // Przeciwnie do ruchu wskazwek zegara
+                    sx = y; sy = 0; dy = 1;
+                    break;
+                case bwxGL_IMG_ROTATE_MODE::IMG_ROTATE180:
+                    sx = srcWidth - 1; sy = y; dx = -1;
+                    break;
+                case bwxGL_IMG_ROTATE_MODE::IMG_ROTATE270:  // Zgodnie z ruchem wskazwek zegara
+                    sx = srcWidth - 1 - y; sy = srcHeight - 1; dy = -1;
+                    break;
+                default:
+                    sx = 0; sy = m_height - 1 - y; dx = 1;
+                    break;
+                }
 
-    void bwxGLImgLoader::RotateImage(bwxGL_IMG_ROTATE_MODE rotate) {
-        if (rotate == bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0) return;
-
-        wxImage rotated;
-        switch (rotate) {
-        case bwxGL_IMG_ROTATE_MODE::IMG_ROTATE90:
-            rotated = Rotate90(false);
-            break;
-        case bwxGL_IMG_ROTATE_MODE::IMG_ROTATE180:
-            rotated = Rotate180();
-            break;
-        case bwxGL_IMG_ROTATE_MODE::IMG_ROTATE270:
-            rotated = Rotate90(true);
-            break;
-        default:
-            return;
-        }
+                ptrdiff_t src = static_cast<ptrdiff_t>(sy) * srcWidth + sx;
+                const ptrdiff_t step = static_cast<ptrdiff_t>(dy) * srcWidth + dx;
+                GLubyte* dst = destination + static_cast<size_t>(y) * m_width * bpp;
 
-        wxImage::operator=(rotated);
+                for (int x = 0; x < m_width; x++, src += step, dst += bpp) {
+                    dst[0] = bitmap[src * 3 + 0]; // Red
+                    dst[1] = bitmap[src * 3 + 1]; // Green
+                    dst[2] = bitmap[src * 3 + 2]; // Blue
+                    if (bpp == 4) dst[3] = alpha ? alpha[src] : 255;
+                }
+            }
+        }
 
-        m_width = GetWidth();
-        m_height = GetHeight();
+        // Obraz wxImage nie jest ju potrzebny - zwolnienie przed wysaniem do GPU obnia szczytowe zuycie pamici
+        Destroy();
+        return true;
     }
 
     const std::vector<GLubyte>& bwxGLImgLoader::Data() const {
@@ -118,7 +124,7 @@ namespace bwx_sdk {
     }
 
     int bwxGLImgLoader::GetBytesPerPixel() const {
-        return HasAlpha() ? 4 : 3;
+        return m_alpha ? 4 : 3;
     }
 
 } // namespace bwx_sdk
@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_light_clusters.cpp
+// Purpose:     BWX_SDK Library; Clustered forward light assignment (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_light_clusters.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_light_component.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        constexpr int bwxGL_CLUSTER_COUNT = bwxGL_CLUSTER_X * bwxGL_CLUSTER_Y * bwxGL_CLUSTER_Z;
+        static_assert(sizeof(bwxGLPackedLight) == bwxGL_CLUSTER_LIGHT_TEXELS * sizeof(glm::vec4), "Light texel count mismatch");
+
+        bool IsLocalLight(const bwxGLPackedLight& light) {
+            const auto type = static_cast<bwxGL_LIGHT_TYPE>(static_cast<int>(light.position.w));
+            const bool hasVolume = type == bwxGL_LIGHT_TYPE::LIGHT_POINT || type == bwxGL_LIGHT_TYPE::LIGHT_SPOT ||
+                type == bwxGL_LIGHT_TYPE::LIGHT_AREA;
+            return hasVolume && light.ambient.w > 0.0f;
+        }
+
+        // Point on the ray through (ndcX, ndcY) at view-space depth -depth
+        glm::vec3 UnprojectAtDepth(const glm::mat4& inverseProjection, float ndcX, float ndcY, float depth) {
+            glm::vec4 nearPoint = inverseProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+            glm::vec4 farPoint = inverseProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+            glm::vec3 a = glm::vec3(nearPoint) / nearPoint.w;
+            glm::vec3 b = glm::vec3(farPoint) / farPoint.w;
+
+            const float dz = b.z - a.z;
+            const float t = dz != 0.0f ? (-depth - a.z) / dz : 0.0f;
+            return a + (b - a) * t;
+        }
+    }
+
+    bwxGLLightClusters::~bwxGLLightClusters() {
+        Release();
+    }
+
+    void bwxGLLightClusters::Build(const std::vector<bwxGLPackedLight>& lights, const glm::mat4& view, const glm::mat4& projection,
+        float nearPlane, float farPlane, const glm::ivec4& viewport) {
+        m_viewport = viewport;
+
+        if (nearPlane != m_near || farPlane != m_far || projection != m_boxesProjection) {
+            m_near = std::max(nearPlane, 1e-4f);
+            m_far = std::max(farPlane, m_near * 1.001f);
+
+            // slice = log(depth) * scale + bias, exactly as in the generated shader
+            const float logRatio = std::log(m_far / m_near);
+            m_sliceScale = bwxGL_CLUSTER_Z / logRatio;
+            m_sliceBias = -bwxGL_CLUSTER_Z * std::log(m_near) / logRatio;
+
+            BuildClusterBoxes(projection);
+        }
+
+        m_pairs.clear();
+        m_globalLights.clear();
+
+        m_lightCount = std::min(lights.size(), static_cast<size_t>(bwxGL_CLUSTER_MAX_LIGHTS));
+        for (uint32_t i = 0; i < m_lightCount; ++i) {
+            const bwxGLPackedLight& light = lights[i];
+            if (light.diffuse.w == 0.0f) continue; // No power - contributes nothing
+
+            if (!IsLocalLight(light)) {
+                m_globalLights.push_back(i);
+                continue;
+            }
+            AssignLocal(light, i, view, projection);
+        }
+
+        // Counting sort of (cluster, light) pairs into contiguous per-cluster lists
+        m_grid.assign(bwxGL_CLUSTER_COUNT, glm::uvec2(0));
+        for (const auto& pair : m_pairs) {
+            ++m_grid[pair.x].y;
+        }
+
+        m_globalCount = m_globalLights.size();
+        uint32_t offset = static_cast<uint32_t>(m_globalCount);
+        for (auto& cell : m_grid) {
+            cell.x = offset;
+            offset += cell.y;
+            cell.y = 0;
+        }
+
+        m_indices.resize(offset);
+        std::copy(m_globalLights.begin(), m_globalLights.end(), m_indices.begin());
+        for (const auto& pair : m_pairs) {
+            glm::uvec2& cell = m_grid[pair.x];
+            m_indices[cell.x + cell.y++] = pair.y;
+        }
+    }
+
+    void bwxGLLightClusters::AssignLocal(const bwxGLPackedLight& light, uint32_t index, const glm::mat4& view, const glm::mat4& projection) {
+        const glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(light.position), 1.0f));
+        const float radius = light.ambient.w;
+
+        const float depthMin = -center.z - radius;
+        const float depthMax = -center.z + radius;
+        if (depthMax < m_near || depthMin > m_far) return;
+
+        const int sliceMin = GetSlice(depthMin);
+        const int sliceMax = GetSlice(depthMax);
+
+        // Screen-space tile range from the projected bounding box of the sphere
+        int tileMinX = 0, tileMaxX = bwxGL_CLUSTER_X - 1;
+        int tileMinY = 0, tileMaxY = bwxGL_CLUSTER_Y - 1;
+
+        if (depthMin > m_near) {
+            glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+            for (int corner = 0; corner < 8; ++corner) {
+                glm::vec3 p = center + glm::vec3(
+                    (corner & 1) ? radius : -radius,
+                    (corner & 2) ? radius : -radius,
+                    (corner & 4) ? radius : -radius);
+                glm::vec4 clip = projection * glm::vec4(p, 1.0f);
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+
+            if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) return;
+
+            auto toTile = [](float ndc, int count) {
+                return std::clamp(static_cast<int>((ndc * 0.5f + 0.5f) * count), 0, count - 1);
+            };
+            tileMinX = toTile(ndcMin.x, bwxGL_CLUSTER_X);
+            tileMaxX = toTile(ndcMax.x, bwxGL_CLUSTER_X);
+            tileMinY = toTile(ndcMin.y, bwxGL_CLUSTER_Y);
+            tileMaxY = toTile(ndcMax.y, bwxGL_CLUSTER_Y);
+        }
+
+        const float radiusSq = radius * radius;
+
+        for (int z = sliceMin; z <= sliceMax; ++z) {
+            for (int y = tileMinY; y <= tileMaxY; ++y) {
+                for (int x = tileMinX; x <= tileMaxX; ++x) {
+                    const uint32_t cluster = static_cast<uint32_t>((z * bwxGL_CLUSTER_Y + y) * bwxGL_CLUSTER_X + x);
+                    const ClusterBox& box = m_boxes[cluster];
+
+                    // Sphere vs cluster AABB
+                    const glm::vec3 closest = glm::clamp(center, box.min, box.max);
+                    const glm::vec3 d = closest - center;
+                    if (glm::dot(d, d) > radiusSq) continue;
+
+                    m_pairs.push_back(glm::uvec2(cluster, index));
+                }
+            }
+        }
+    }
+
+    void bwxGLLightClusters::BuildClusterBoxes(const glm::mat4& projection) {
+        m_boxesProjection = projection;
+        m_boxes.resize(bwxGL_CLUSTER_COUNT);
+
+        const glm::mat4 inverseProjection = glm::inverse(projection);
+
+        for (int z = 0; z < bwxGL_CLUSTER_Z; ++z) {
+            const float sliceNear = m_near * std::pow(m_far / m_near, static_cast<float>(z) / bwxGL_CLUSTER_Z);
+            const float sliceFar = m_near * std::pow(m_far / m_near, static_cast<float>(z + 1) / bwxGL_CLUSTER_Z);
+
+            for (int y = 0; y < bwxGL_CLUSTER_Y; ++y) {
+                const float y0 = -1.0f + 2.0f * y / bwxGL_CLUSTER_Y;
+                const float y1 = -1.0f + 2.0f * (y + 1) / bwxGL_CLUSTER_Y;
+
+                for (int x = 0; x < bwxGL_CLUSTER_X; ++x) {
+                    const float x0 = -1.0f + 2.0f * x / bwxGL_CLUSTER_X;
+                    const float x1 = -1.0f + 2.0f * (x + 1) / bwxGL_CLUSTER_X;
+
+                    ClusterBox box{ glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+                    for (int corner = 0; corner < 8; ++corner) {
+                        glm::vec3 p = UnprojectAtDepth(inverseProjection,
+                            (corner & 1) ? x1 : x0,
+                            (corner & 2) ? y1 : y0,
+                            (corner & 4) ? sliceFar : sliceNear);
+                        box.min = glm::min(box.min, p);
+                        box.max = glm::max(box.max, p);
+                    }
+
+                    m_boxes[(z * bwxGL_CLUSTER_Y + y) * bwxGL_CLUSTER_X + x] = box;
+                }
+            }
+        }
+    }
+
+    int bwxGLLightClusters::GetSlice(float depth) const {
+        if (depth <= m_near) return 0;
+        const int slice = static_cast<int>(std::log(depth) * m_sliceScale + m_sliceBias);
+        return std::clamp(slice, 0, bwxGL_CLUSTER_Z - 1);
+    }
+
+    void bwxGLLightClusters::Upload(const std::vector<bwxGLPackedLight>& lights, bool lightsChanged) {
+        if (!m_lightBuffer) {
+            CreateTexture(m_lightBuffer, m_lightTexture, GL_RGBA32F);
+            CreateTexture(m_gridBuffer, m_gridTexture, GL_RG32UI);
+            CreateTexture(m_indexBuffer, m_indexTexture, GL_R32UI);
+            lightsChanged = true;
+        }
+
+        static GLint maxTexels = 0;
+        if (maxTexels == 0) {
+            glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+            if (maxTexels <= 0) maxTexels = 65536;
+        }
+
+        if (m_indices.size() > static_cast<size_t>(maxTexels)) {
+            std::cerr << "Warning: Light cluster index list truncated to " << maxTexels << " entries." << std::endl;
+            m_indices.resize(static_cast<size_t>(maxTexels));
+            for (auto& cell : m_grid) {
+                cell.x = std::min(cell.x, static_cast<GLuint>(maxTexels));
+                cell.y = std::min(cell.y, static_cast<GLuint>(maxTexels) - cell.x);
+            }
+        }
+
+        // Light data changes far less often than the per-frame cluster lists
+        if (lightsChanged) {
+            m_lightBuffer->SetData(m_lightCount ? lights.data() : nullptr,
+                std::max<GLsizeiptr>(static_cast<GLsizeiptr>(m_lightCount * sizeof(bwxGLPackedLight)), sizeof(bwxGLPackedLight)),
+                GL_DYNAMIC_DRAW);
+        }
+
+        m_gridBuffer->SetData(m_grid.data(), static_cast<GLsizeiptr>(m_grid.size() * sizeof(glm::uvec2)), GL_STREAM_DRAW);
+
+        const uint32_t none = 0;
+        m_indexBuffer->SetData(m_indices.empty() ? &none : m_indices.data(),
+            static_cast<GLsizeiptr>(std::max<size_t>(m_indices.size(), 1) * sizeof(uint32_t)), GL_STREAM_DRAW);
+    }
+
+    void bwxGLLightClusters::Bind() const {
+        if (!m_lightTexture) return;
+
+        const GLuint textures[3] = { m_lightTexture, m_gridTexture, m_indexTexture };
+        for (int i = 0; i < 3; ++i) {
+            glActiveTexture(GL_TEXTURE0 + bwxGL_CLUSTER_TEXTURE_UNIT + i);
+            glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void bwxGLLightClusters::ApplyToShader(bwxGLShaderProgram& shader) const {
+        shader.SetUniform("clusterLightData", bwxGL_CLUSTER_TEXTURE_UNIT);
+        shader.SetUniform("clusterGrid", bwxGL_CLUSTER_TEXTURE_UNIT + 1);
+        shader.SetUniform("clusterIndices", bwxGL_CLUSTER_TEXTURE_UNIT + 2);
+        shader.SetUniform("clusterGlobalCount", static_cast<GLint>(m_globalCount));
+        shader.SetUniform("clusterDepth", glm::vec2(m_sliceScale, m_sliceBias));
+        shader.SetUniform("clusterViewport", glm::vec4(m_viewport));
+    }
+
+    void bwxGLLightClusters::Release() {
+        GLuint textures[3] = { m_lightTexture, m_gridTexture, m_indexTexture };
+        if (m_lightTexture) glDeleteTextures(3, textures);
+        m_lightTexture = m_gridTexture = m_indexTexture = 0;
+
+        m_lightBuffer.reset();
+        m_gridBuffer.reset();
+        m_indexBuffer.reset();
+    }
+
+    void bwxGLLightClusters::CreateTexture(std::unique_ptr<bwxGLBuffer>& buffer, GLuint& texture, GLenum format) {
+        buffer = std::make_unique<bwxGLBuffer>(GL_TEXTURE_BUFFER);
+
+        // Texture buffer needs a data store before glTexBuffer
+        buffer->SetData(nullptr, sizeof(glm::vec4), GL_DYNAMIC_DRAW);
+
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, buffer->GetID());
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+} // namespace bwx_sdk
@@ -22,6 +22,7 @@ namespace bwx_sdk {
 
     void bwxGLLightComponent::SetObjectColor(const glm::vec3& color) {
         m_objectColor = color;
+        MarkDirty();
     }
 
     glm::vec3 bwxGLLightComponent::GetObjectColor() const {
@@ -30,6 +31,7 @@ namespace bwx_sdk {
 
     void bwxGLLightComponent::SetLightColor(const glm::vec3& color) {
         m_diffuse = color * m_power;
+        MarkDirty();
     }
 
     glm::vec3 bwxGLLightComponent::GetLightColor() const {
@@ -46,6 +48,7 @@ namespace bwx_sdk {
 
     void bwxGLLightComponent::SetAmbient(const glm::vec3& color) {
         m_ambient = color;
+        MarkDirty();
     }
 
     glm::vec3 bwxGLLightComponent::GetAmbient() const {
@@ -54,6 +57,7 @@ namespace bwx_sdk {
 
     void bwxGLLightComponent::SetSpecular(const glm::vec3& color) {
         m_specular = color;
+        MarkDirty();
     }
 
     glm::vec3 bwxGLLightComponent::GetSpecular() const {
@@ -74,6 +78,7 @@ namespace bwx_sdk {
         m_linear = 4.5f / m_range;
         m_quadratic = 75.0f / (m_range * m_range);
         m_constant = 1.0f;
+        MarkDirty();
     }
 
     float bwxGLLightComponent::GetRange() const {
@@ -82,14 +87,17 @@ namespace bwx_sdk {
 
     void bwxGLLightComponent::SetAttenuationConstant(float value) {
         m_constant = value;
+        MarkDirty();
     }
 
     void bwxGLLightComponent::SetAttenuationLinear(float value) {
         m_linear = value;
+        MarkDirty();
     }
 
     void bwxGLLightComponent::SetAttenuationQuadratic(float value) {
         m_quadratic = value;
+        MarkDirty();
     }
 
     float bwxGLLightComponent::GetAttenuationConstant() const {
@@ -106,10 +114,12 @@ namespace bwx_sdk {
 
     void bwxGLLightComponent::SetInnerCone(float angle) {
         m_innerCone = angle;
+        MarkDirty();
     }
 
     void bwxGLLightComponent::SetOuterCone(float angle) {
         m_outerCone = angle;
+        MarkDirty();
     }
 
     float bwxGLLightComponent::GetInnerCone() const {
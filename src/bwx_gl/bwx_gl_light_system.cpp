@@ -10,6 +10,8 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <algorithm>
+
 #include <bwx_sdk/bwx_gl/bwx_gl_light_system.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_transform_component.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_light_component.h>
@@ -18,60 +20,67 @@
 namespace bwx_sdk {
 
     void bwxGLLightSystem::Register(std::shared_ptr<bwxGLNode> node) {
-        if (node && node->HasComponent<bwxGLLightComponent>()) {
-            m_registeredNodes.push_back(node);
+        // Both components or nothing: every entry owns a packed slot, and shaders stop at the first
+        // slot without power, so an unpackable entry would hide all lights after it
+        if (!node || !node->HasComponent<bwxGLLightComponent>() || !node->HasComponent<bwxGLTransformComponent>()) return;
+
+        for (const auto& entry : m_entries) {
+            if (entry.node.lock() == node) return;
         }
+
+        // Components are looked up once here instead of on every Update()
+        LightEntry entry;
+        entry.node = node;
+        entry.light = node->GetComponent<bwxGLLightComponent>();
+        entry.transform = node->GetComponent<bwxGLTransformComponent>();
+
+        m_entries.push_back(entry);
+        m_lightData.push_back(bwxGLPackedLight{});
+        MarkDirty(m_entries.size() - 1);
+    }
+
+    void bwxGLLightSystem::RegisterAll() {
+        bwxGLRegistry::GetInstance().Each<bwxGLLightComponent, bwxGLTransformComponent>(
+            [this](bwxGLNode& node, bwxGLLightComponent&, bwxGLTransformComponent&) {
+                Register(node.shared_from_this());
+            });
     }
 
     void bwxGLLightSystem::Unregister(std::shared_ptr<bwxGLNode> node) {
-        m_registeredNodes.erase(std::remove_if(
-            m_registeredNodes.begin(), m_registeredNodes.end(),
-            [&](const std::weak_ptr<bwxGLNode>& weak)
-            {
-                auto shared = weak.lock();
-                return !shared || shared == node;
-            }),
-            m_registeredNodes.end());
+        for (size_t i = 0; i < m_entries.size();) {
+            auto shared = m_entries[i].node.lock();
+            if (!shared || shared == node) {
+                Remove(i);
+                continue;
+            }
+            ++i;
+        }
     }
 
     void bwxGLLightSystem::Clear() {
-        m_registeredNodes.clear();
+        if (!m_entries.empty()) {
+            MarkDirty(0);
+        }
+        m_entries.clear();
         m_lightData.clear();
     }
 
     void bwxGLLightSystem::Update(float /*deltaTime*/) {
-        m_lightData.clear();
-
-        for (auto it = m_registeredNodes.begin(); it != m_registeredNodes.end();) {
-            auto node = it->lock();
-            if (!node) {
-                it = m_registeredNodes.erase(it);
+        for (size_t i = 0; i < m_entries.size();) {
+            LightEntry& entry = m_entries[i];
+            if (entry.node.expired()) {
+                Remove(i);
                 continue;
             }
 
-            auto light = node->GetComponent<bwxGLLightComponent>();
-            auto transform = node->GetComponent<bwxGLTransformComponent>();
-            if (!light || !transform) {
-                ++it;
-                continue;
+            // Only lights whose component or world transform (own or any parent's) changed since the last pack
+            if (entry.light->GetVersion() != entry.lightVersion || entry.transform->GetWorldVersion() != entry.transformVersion) {
+                entry.lightVersion = entry.light->GetVersion();
+                entry.transformVersion = entry.transform->GetWorldVersion();
+                Pack(entry, m_lightData[i]);
+                MarkDirty(i);
             }
-
-            bwxGLPackedLight packed;
-
-            packed.position = glm::vec4(transform->GetPosition(), static_cast<float>(light->GetType()));
-            packed.direction = glm::vec4(transform->GetRotation() * glm::vec3(0, 0, -1), light->GetInnerCone());
-            packed.diffuse = glm::vec4(light->GetDiffuse(), light->GetPower());
-            packed.ambient = glm::vec4(light->GetAmbient(), light->GetRange());
-            packed.specular = glm::vec4(light->GetSpecular(), light->GetOuterCone());
-            packed.attenuation = glm::vec4(
-                light->GetAttenuationConstant(),
-                light->GetAttenuationLinear(),
-                light->GetAttenuationQuadratic(),
-                0.0f
-            );
-
-            m_lightData.push_back(packed);
-            ++it;
+            ++i;
         }
     }
 
@@ -79,4 +88,68 @@ namespace bwx_sdk {
         return m_lightData;
     }
 
+    bool bwxGLLightSystem::GetDirtyRange(size_t& first, size_t& count) const {
+        if (m_dirtyLast <= m_dirtyFirst) return false;
+
+        first = m_dirtyFirst;
+        count = m_dirtyLast - m_dirtyFirst;
+        return true;
+    }
+
+    void bwxGLLightSystem::ClearDirty() {
+        m_dirtyFirst = m_dirtyLast = 0;
+    }
+
+    void bwxGLLightSystem::MarkAllDirty() {
+        m_dirtyFirst = 0;
+        m_dirtyLast = m_lightData.size() + 1;
+    }
+
+    void bwxGLLightSystem::Pack(const LightEntry& entry, bwxGLPackedLight& packed) const {
+        const auto& light = entry.light;
+        const auto& transform = entry.transform;
+
+        // World space, so lights attached to child nodes follow their parents
+        const glm::mat4 world = transform->GetWorldMatrix();
+        const glm::vec3 forward = -glm::vec3(world[2]);
+        const float length = glm::length(forward);
+
+        packed.position = glm::vec4(glm::vec3(world[3]), static_cast<float>(light->GetType()));
+        packed.direction = glm::vec4(length > 0.0f ? forward / length : glm::vec3(0, 0, -1), light->GetInnerCone());
+        packed.diffuse = glm::vec4(light->GetDiffuse(), light->GetPower());
+        packed.ambient = glm::vec4(light->GetAmbient(), light->GetRange());
+        packed.specular = glm::vec4(light->GetSpecular(), light->GetOuterCone());
+        packed.attenuation = glm::vec4(
+            light->GetAttenuationConstant(),
+            light->GetAttenuationLinear(),
+            light->GetAttenuationQuadratic(),
+            0.0f
+        );
+    }
+
+    void bwxGLLightSystem::Remove(size_t index) {
+        // Swap with the last one - only two slots change instead of the whole tail
+        const size_t last = m_entries.size() - 1;
+        if (index != last) {
+            m_entries[index] = std::move(m_entries[last]);
+            m_lightData[index] = m_lightData[last];
+        }
+        m_entries.pop_back();
+        m_lightData.pop_back();
+
+        // Old last slot becomes the terminator
+        MarkDirty(index);
+        MarkDirty(last);
+    }
+
+    void bwxGLLightSystem::MarkDirty(size_t index) {
+        if (m_dirtyLast <= m_dirtyFirst) {
+            m_dirtyFirst = index;
+            m_dirtyLast = index + 1;
+            return;
+        }
+        m_dirtyFirst = std::min(m_dirtyFirst, index);
+        m_dirtyLast = std::max(m_dirtyLast, index + 1);
+    }
+
 } // namespace bwx_sdk
@@ -0,0 +1,39 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_lod.cpp
+// Purpose:     BWX_SDK Library; OpenGL Mesh level of detail chain
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_lod.h>
+
+namespace bwx_sdk {
+
+    void bwxGLLODChain::AddLevel(std::shared_ptr<bwxGLMesh> mesh, float screenSize) {
+        m_levels.push_back({ std::move(mesh), screenSize });
+    }
+
+    size_t bwxGLLODChain::Select(float screenSize, size_t current) const {
+        if (m_levels.empty()) return 0;
+
+        const size_t last = m_levels.size() - 1;
+        size_t level = std::min(current, last);
+
+        // Finer: the object has to grow clearly above the threshold of the finer level
+        while (level > 0 && screenSize >= m_levels[level - 1].screenSize * (1.0f + m_hysteresis)) --level;
+
+        // Coarser: the object has to shrink clearly below the threshold of the current level
+        while (level < last && screenSize < m_levels[level].screenSize * (1.0f - m_hysteresis)) ++level;
+
+        return level;
+    }
+
+} // namespace bwx_sdk
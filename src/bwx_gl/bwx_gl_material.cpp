@@ -11,6 +11,9 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <algorithm>
+#include <cstring>
+
 #include <bwx_sdk/bwx_gl/bwx_gl_material.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_texture_manager.h>
 
@@ -24,16 +27,23 @@ namespace bwx_sdk {
 	{
 		m_isEmissive = false;
 		m_isTransparent = false;
+		m_isReflection = false;
+		m_isRefraction = false;
+		m_isTwoSided = false;
 
 		m_ambient = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 		m_diffuse = glm::vec4(0.8f, 0.8f, 0.8f, 1.0f);
 		m_specular = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
 		m_emissive = glm::vec4(0.0f);
 		m_transparent = glm::vec4(0.0f);
+		m_reflectivity = glm::vec4(0.0f);
 		m_shininess = 0.5f * 128;
+		m_reflection = 0.0f;
 		m_refraction = 0.0f;
+		m_opacity = 1.0f;
 
 		m_textures.clear();
+		m_blockDirty = true;
 	}
 
     void bwxGLMaterial::Bind() const {
@@ -88,6 +98,48 @@ namespace bwx_sdk {
         shader.SetUniform("material.opacity", m_opacity);
     }
 
+    bwxGLMaterialParams bwxGLMaterial::GetParams() const {
+        bwxGLMaterialParams params;
+        params.ambient = m_ambient;
+        params.diffuse = m_diffuse;
+        params.specular = m_specular;
+        params.emissive = m_emissive;
+        params.transparent = m_transparent;
+        params.reflectivity = m_reflectivity;
+        params.params = glm::vec4(m_shininess, m_reflection, m_refraction, m_opacity);
+        return params;
+    }
+
+    uint64_t bwxGLMaterial::GetContentHash() const {
+        // FNV-1a; the parameter block is all vec4, so there is no padding to hash
+        uint64_t hash = 14695981039346656037ull;
+        auto add = [&hash](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        const bwxGLMaterialParams params = GetParams();
+        add(&params, sizeof(params));
+
+        const unsigned char flags[] = { m_isTransparent, m_isEmissive, m_isReflection, m_isRefraction, m_isTwoSided };
+        add(flags, sizeof(flags));
+
+        // The map has no stable order
+        std::vector<std::pair<bwxGL_TEXTURE_TYPE, const std::string*>> textures;
+        for (const auto& [type, path] : m_textures) textures.emplace_back(type, &path);
+        std::sort(textures.begin(), textures.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [type, path] : textures) {
+            const int32_t t = static_cast<int32_t>(type);
+            add(&t, sizeof(t));
+            add(path->data(), path->size() + 1);  // With the terminator, so path boundaries count
+        }
+
+        return hash;
+    }
+
 	void bwxGLMaterial::AddTexture(bwxGL_TEXTURE_TYPE type, const std::string& path) {
 		m_textures[type] = path;
 	}
@@ -110,42 +162,52 @@ namespace bwx_sdk {
 
 	void bwxGLMaterial::SetAmbient(const glm::vec4& ambient) {
 		m_ambient = ambient;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetDiffuse(const glm::vec4& diffuse) {
 		m_diffuse = diffuse;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetSpecular(const glm::vec4& specular) {
 		m_specular = specular;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetEmissive(const glm::vec4& emissive) {
 		m_emissive = emissive;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetTransparent(const glm::vec4& transparent) {
 		m_transparent = transparent;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetReflectivity(const glm::vec4& reflectivity) {
 		m_reflectivity = reflectivity;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetShininess(GLfloat shininess) {
 		m_shininess = shininess;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetReflection(GLfloat reflection) {
 		m_reflection = reflection;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetRefraction(GLfloat refraction) {
 		m_refraction = refraction;
+		m_blockDirty = true;
 	}
 
 	void bwxGLMaterial::SetOpacity(GLfloat opacity) {
 		m_opacity = opacity;
+		m_blockDirty = true;
 	}
 
 	const glm::vec4& bwxGLMaterial::GetAmbient() const {
@@ -11,7 +11,13 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <cstdio>
+#include <cstring>
+
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_material_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_manager.h>
 
 namespace bwx_sdk {
 
@@ -22,6 +28,7 @@ namespace bwx_sdk {
     }
 
     std::shared_ptr<bwxGLMaterial> bwxGLMaterialManager::GetMaterial(const std::string& name) const {
+        auto lock = ReadLock();
         auto it = m_resources.find(name);
         if (it != m_resources.end()) {
 			return it->second; // Return ptr to material if exists
@@ -30,6 +37,7 @@ namespace bwx_sdk {
     }
 
 	std::shared_ptr<bwxGLMaterial> bwxGLMaterialManager::GetMaterial(const unsigned int& id) const {
+		auto lock = ReadLock();
 		for (auto it = m_resources.begin(); it != m_resources.end(); ++it) {
 			if (it->second->GetID() == id) {
 				return it->second;
@@ -45,21 +53,67 @@ namespace bwx_sdk {
         }
 
         auto newMaterial = std::make_shared<bwxGLMaterial>(name);
-        m_resources[name] = newMaterial;
+        newMaterial->SetSortKey(AllocateSortKey());
+        StoreResource(name, newMaterial);
+        m_blocksDirty = true;
+        ++m_tableVersion;
         return newMaterial;
     }
 
+    std::shared_ptr<bwxGLMaterial> bwxGLMaterialManager::ShareMaterial(std::shared_ptr<bwxGLMaterial> material) {
+        if (!material) return nullptr;
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "bwxGL_shared_%016llx", static_cast<unsigned long long>(material->GetContentHash()));
+        if (auto existing = GetMaterial(name)) return existing;
+
+        material->SetName(name);
+        material->SetSortKey(AllocateSortKey());
+        StoreResource(name, material);
+        m_blocksDirty = true;
+        ++m_tableVersion;
+        return material;
+    }
+
+    uint16_t bwxGLMaterialManager::AllocateSortKey() {
+        // Keys of released materials are reused first, so they stay within 16 bits
+        if (!m_freeSortKeys.empty()) {
+            uint16_t key = m_freeSortKeys.back();
+            m_freeSortKeys.pop_back();
+            return key;
+        }
+        if (m_nextSortKey == 0) return 0;  // All 65535 in use; such materials sort together
+        return m_nextSortKey++;
+    }
+
+    void bwxGLMaterialManager::FreeSortKey(const std::shared_ptr<bwxGLMaterial>& material) {
+        m_blocksDirty = true;
+        ++m_tableVersion;
+        if (!material || material->GetSortKey() == 0) return;
+        m_freeSortKeys.push_back(material->GetSortKey());
+        material->SetSortKey(0);
+    }
+
+    bool bwxGLMaterialManager::RequestMaterial(const std::string& name, std::function<void(bwxGLMaterial&)> setup) {
+        return QueueRequest(name, [this, name, setup = std::move(setup)]() {
+            auto material = CreateMaterial(name);
+            if (setup) setup(*material);
+        });
+    }
+
     void bwxGLMaterialManager::ReleaseMaterial(const std::string& name) {
         auto it = m_resources.find(name);
         if (it != m_resources.end() && it->second) {
-            m_resources.erase(it);
+            FreeSortKey(it->second);
+            EraseResource(it);
         }
     }
 
 	void bwxGLMaterialManager::ReleaseMaterial(const int& id) {
 		for (auto it = m_resources.begin(); it != m_resources.end(); ++it) {
 			if (it->second->GetID() == id) {
-				m_resources.erase(it);
+				FreeSortKey(it->second);
+				EraseResource(it);
 				break;
 			}
 		}
@@ -68,7 +122,8 @@ namespace bwx_sdk {
     void bwxGLMaterialManager::CleanupUnusedMaterials() {
         for (auto it = m_resources.begin(); it != m_resources.end();) {
             if (it->second) {
-                it = m_resources.erase(it);
+                FreeSortKey(it->second);
+                it = EraseResource(it);
             }
             else {
                 ++it;
@@ -77,7 +132,126 @@ namespace bwx_sdk {
     }
 
     void bwxGLMaterialManager::ClearAllMaterials() {
-        m_resources.clear();
+        for (auto& [name, material] : m_resources) {
+            FreeSortKey(material);
+        }
+        ClearResources();
+        m_table.clear();
+        m_tableBuffer.reset();
+        m_blockData.clear();
+        m_blockBuffer.reset();
+        m_blockCount = 0;
+        m_nextSortKey = 1;
+        m_freeSortKeys.clear();
+        UpdateMemoryMetric();
+    }
+
+    void bwxGLMaterialManager::UpdateMemoryMetric() {
+        const size_t bytes = m_resources.size() * sizeof(bwxGLMaterial) + m_table.capacity() * sizeof(bwxGLPackedMaterial) + m_blockData.capacity();
+        BWX_METRIC_GAUGE("gl.materials.ram_bytes").Set(static_cast<int64_t>(bytes));
+    }
+
+    bool bwxGLMaterialManager::IsMaterialTableSupported() {
+        return GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_program_interface_query;
+    }
+
+    size_t bwxGLMaterialManager::UploadMaterialTable() {
+        if (!IsMaterialTableSupported()) return 0;
+
+        auto& textures = bwxGLTextureManager::GetInstance();
+        m_table.clear();
+        size_t resident = 0;
+
+        for (auto& [name, material] : m_resources) {
+            bwxGLPackedMaterial packed{};
+            packed.diffuse = material->GetDiffuse();
+            packed.specular = material->GetSpecular();
+            packed.emissive = material->GetEmissive();
+            packed.params = glm::vec4(material->GetShininess(), material->GetOpacity(), material->GetReflection(), material->GetRefraction());
+            packed.diffuseArray = bwxGL_MATERIAL_NO_TEXTURE;
+            packed.diffuseLayer = -1;
+
+            // Every texture has to be reachable, otherwise the material still needs its own bind
+            bool reachable = true;
+            for (const auto& [type, path] : material->GetTextures()) {
+                const GLuint64 handle = textures.GetBindlessHandle(path);
+                const bwxGLTextureLocation* location = textures.GetLocation(path);
+                const bool inArray = location && location->array >= 0;
+                if (!handle && !inArray) reachable = false;
+
+                if (type != TEXTURE_DIFFUSE) continue;
+                if (!handle && !inArray) {
+                    packed.diffuseArray = bwxGL_MATERIAL_BOUND_TEXTURE;
+                    continue;
+                }
+                packed.diffuseHandle = glm::uvec2(static_cast<GLuint>(handle & 0xFFFFFFFFu), static_cast<GLuint>(handle >> 32));
+                if (inArray) {
+                    packed.diffuseArray = location->array;
+                    packed.diffuseLayer = location->layer;
+                }
+            }
+            if (reachable) ++resident;
+
+            material->SetTableIndex(static_cast<GLint>(m_table.size()), reachable);
+            m_table.push_back(packed);
+        }
+        UpdateMemoryMetric();
+
+        if (m_table.empty()) return 0;
+
+        if (!m_tableBuffer) m_tableBuffer = std::make_unique<bwxGLBuffer>(GL_SHADER_STORAGE_BUFFER);
+        m_tableBuffer->SetData(m_table.data(), static_cast<GLsizeiptr>(m_table.size() * sizeof(bwxGLPackedMaterial)), GL_DYNAMIC_DRAW);
+        BindMaterialTable();
+
+        return resident;
+    }
+
+    void bwxGLMaterialManager::BindMaterialTable() const {
+        if (m_tableBuffer) glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bwxGL_MATERIAL_SSBO_BINDING, m_tableBuffer->GetID());
+    }
+
+    size_t bwxGLMaterialManager::UploadMaterialBlocks() {
+        bool dirty = m_blocksDirty;
+        for (const auto& [name, material] : m_resources) {
+            if (material->IsBlockDirty() || material->GetBlockIndex() < 0) dirty = true;
+        }
+        if (!dirty) return m_blockCount;
+
+        // glBindBufferRange offsets must be multiples of the driver's alignment
+        if (m_blockStride == 0) {
+            GLint alignment = 0;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            const GLsizeiptr size = static_cast<GLsizeiptr>(sizeof(bwxGLMaterialParams));
+            m_blockStride = alignment > 0 ? (size + alignment - 1) / alignment * alignment : size;
+        }
+
+        m_blockData.assign(m_resources.size() * static_cast<size_t>(m_blockStride), 0);
+        GLint index = 0;
+        for (auto& [name, material] : m_resources) {
+            const bwxGLMaterialParams params = material->GetParams();
+            std::memcpy(m_blockData.data() + static_cast<size_t>(index) * m_blockStride, &params, sizeof(params));
+            material->SetBlockIndex(index++);
+        }
+        m_blockCount = m_resources.size();
+        m_blocksDirty = false;
+        UpdateMemoryMetric();
+
+        if (m_blockData.empty()) return 0;
+
+        if (!m_blockBuffer) m_blockBuffer = std::make_unique<bwxGLBuffer>(GL_UNIFORM_BUFFER);
+        m_blockBuffer->SetData(m_blockData.data(), static_cast<GLsizeiptr>(m_blockData.size()), GL_DYNAMIC_DRAW);
+        bwxGLProfiler::GetInstance().AddUploadedBytes(m_blockData.size());
+
+        return m_blockCount;
+    }
+
+    bool bwxGLMaterialManager::BindMaterialBlock(const bwxGLMaterial& material) const {
+        const GLint index = material.GetBlockIndex();
+        if (!m_blockBuffer || index < 0 || static_cast<size_t>(index) >= m_blockCount) return false;
+
+        glBindBufferRange(GL_UNIFORM_BUFFER, bwxGL_MATERIAL_UBO_BINDING, m_blockBuffer->GetID(),
+            static_cast<GLintptr>(index) * m_blockStride, static_cast<GLsizeiptr>(sizeof(bwxGLMaterialParams)));
+        return true;
     }
 
 }
\ No newline at end of file
@@ -11,6 +11,10 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
 #include <bwx_sdk/bwx_gl/bwx_gl_buffer_manager.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_mesh.h>
 
@@ -19,95 +23,191 @@ namespace bwx_sdk {
     bwxGLMesh::bwxGLMesh(int style) : m_inputDataFormat(style) {}
 
     void bwxGLMesh::SetupMesh() {
-        //if (!m_buffer) {
-        //    m_buffer = std::make_shared<bwxGLBuffer>();
-        //}
+        SetupMesh(bwxGLVertexLayout::FromMeshFormat(m_inputDataFormat));
+    }
 
-        std::vector<float> vertexData;
-        for (const auto& v : m_vertices) {
-            vertexData.push_back(v.position.x);
-            vertexData.push_back(v.position.y);
-            vertexData.push_back(v.position.z);
+    void bwxGLMesh::Prepare() {
+        if (m_prepared) return;
 
-            if (m_inputDataFormat & bwxGL_MESH_NORMAL) {
-                vertexData.push_back(v.normal.x);
-                vertexData.push_back(v.normal.y);
-                vertexData.push_back(v.normal.z);
-            }
-            if (m_inputDataFormat & bwxGL_MESH_TEX_COORD) {
-                vertexData.push_back(v.texCoord.x);
-                vertexData.push_back(v.texCoord.y);
-            }
-            if (m_inputDataFormat & bwxGL_MESH_TANGENT) {
-                vertexData.push_back(v.tangent.x);
-                vertexData.push_back(v.tangent.y);
-                vertexData.push_back(v.tangent.z);
-            }
-            if (m_inputDataFormat & bwxGL_MESH_BITANGENT) {
-                vertexData.push_back(v.bitangent.x);
-                vertexData.push_back(v.bitangent.y);
-                vertexData.push_back(v.bitangent.z);
-            }
-            if (m_inputDataFormat & bwxGL_MESH_COLOR) {
-                vertexData.push_back(v.color.r);
-                vertexData.push_back(v.color.g);
-                vertexData.push_back(v.color.b);
-            }
+        // Reordering and welding needs an index buffer; glDrawArrays relies on the original vertex order
+        if ((m_inputDataFormat & bwxGL_MESH_INDICES) && !(m_inputDataFormat & bwxGL_MESH_NO_OPTIMIZE)) {
+            m_optimizerStats = bwxGLMeshOptimizer::Optimize(m_vertices, m_indices);
+        }
+
+        CalculateBounds();
+        m_prepared = true;
+    }
+
+    void bwxGLMesh::SetupMesh(const bwxGLVertexLayout& layout) {
+        ReleaseBuffers();
+
+        Prepare();
+        m_prepared = false;
+
+        m_layout = layout;
+        m_vertexCount = static_cast<GLsizei>(m_vertices.size());
+        m_indexCount = static_cast<GLsizei>(m_indices.size());
+
+        // Every index fits in 16 bits below 65536 vertices - half the index bandwidth
+        std::vector<uint16_t> shortIndices;
+        const void* indexData = m_indices.data();
+        GLsizeiptr indexBytes = static_cast<GLsizeiptr>(m_indices.size() * sizeof(GLuint));
+        m_indexType = GL_UNSIGNED_INT;
+
+        if (!m_indices.empty() && m_vertexCount <= 0xFFFF) {
+            shortIndices.assign(m_indices.begin(), m_indices.end());
+            indexData = shortIndices.data();
+            indexBytes = static_cast<GLsizeiptr>(shortIndices.size() * sizeof(uint16_t));
+            m_indexType = GL_UNSIGNED_SHORT;
+        }
+
+        Upload(nullptr, indexData, indexBytes);
+    }
+
+    void bwxGLMesh::SetupMesh(const bwxGLVertexLayout& layout, const void* vertexData, GLsizei vertexCount, const void* indexData,
+        GLsizei indexCount, GLenum indexType, const bwxGLBoundingBox& bounds) {
+        ReleaseBuffers();
+
+        m_vertices.clear();
+        m_indices.clear();
+        m_bounds = bounds;
+        m_layout = layout;
+        m_vertexCount = vertexCount;
+        m_indexCount = indexCount;
+        m_indexType = indexType;
+
+        const GLsizeiptr indexBytes = static_cast<GLsizeiptr>(indexCount) * (indexType == GL_UNSIGNED_SHORT ? 2 : 4);
+        Upload(vertexData, indexCount > 0 ? indexData : nullptr, indexCount > 0 ? indexBytes : 0);
+    }
+
+    bool bwxGLMesh::GetEncodedData(std::vector<unsigned char>& vertexData, std::vector<unsigned char>& indexData) const {
+        if (!m_vao || m_vertices.size() != static_cast<size_t>(m_vertexCount)) return false;
+
+        vertexData.resize(static_cast<size_t>(m_layout.GetStride()) * m_vertices.size());
+        WriteVertices(vertexData.data(), nullptr);
+
+        // Same index width as the upload picked
+        indexData.clear();
+        if (m_indexType == GL_UNSIGNED_SHORT) {
+            std::vector<uint16_t> shortIndices(m_indices.begin(), m_indices.end());
+            indexData.resize(shortIndices.size() * sizeof(uint16_t));
+            if (!indexData.empty()) std::memcpy(indexData.data(), shortIndices.data(), indexData.size());
+        }
+        else {
+            indexData.resize(m_indices.size() * sizeof(GLuint));
+            if (!indexData.empty()) std::memcpy(indexData.data(), m_indices.data(), indexData.size());
+        }
+        return true;
+    }
+
+    void bwxGLMesh::Upload(const void* encodedVertices, const void* indexData, GLsizeiptr indexBytes) {
+        if (m_inputDataFormat & bwxGL_MESH_POOLED) {
+            SetupPooled(encodedVertices, indexData, indexBytes);
+            return;
+        }
+
+        // Every mesh owns its buffers; a shared key would hand out the first mesh's data
+        static std::atomic<unsigned int> s_meshCounter{ 0 };
+        const std::string id = std::to_string(s_meshCounter.fetch_add(1, std::memory_order_relaxed));
+        m_vboKey = "mesh_vbo_" + id;
+
+        const GLsizeiptr size = static_cast<GLsizeiptr>(m_layout.GetStride()) * m_vertexCount;
+        m_vbo = bwxGLBufferManager::GetInstance().GetOrCreateVBO(m_vboKey, nullptr, 0);
+
+        bool uploaded = false;
+        if (void* mapped = size > 0 ? m_vbo->MapWrite(size) : nullptr) {
+            WriteVertices(static_cast<unsigned char*>(mapped), encodedVertices);
+            uploaded = m_vbo->Unmap();
         }
 
-        m_vbo = bwxGLBufferManager::GetInstance().GetOrCreateVBO("mesh_vbo", vertexData);
-        m_ebo = bwxGLBufferManager::GetInstance().GetOrCreateEBO("mesh_ebo", m_indices);
+        // Mapping failed or the storage was lost while mapped - go through a staging copy
+        if (!uploaded && size > 0) {
+            std::vector<unsigned char> staging(static_cast<size_t>(size));
+            WriteVertices(staging.data(), encodedVertices);
+            m_vbo->SetData(staging.data(), size, GL_STATIC_DRAW);
+        }
 
         glGenVertexArrays(1, &m_vao);
         glBindVertexArray(m_vao);
         glBindBuffer(GL_ARRAY_BUFFER, m_vbo->GetID());
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo->GetID());
 
-        int stride = 3;
-        if (m_inputDataFormat & bwxGL_MESH_NORMAL) stride += 3;
-        if (m_inputDataFormat & bwxGL_MESH_TEX_COORD) stride += 2;
-        if (m_inputDataFormat & bwxGL_MESH_TANGENT) stride += 3;
-        if (m_inputDataFormat & bwxGL_MESH_BITANGENT) stride += 3;
-        if (m_inputDataFormat & bwxGL_MESH_COLOR) stride += 3;
-        stride *= sizeof(float);
+        if (indexData && indexBytes > 0) {
+            m_eboKey = "mesh_ebo_" + id;
+            m_ebo = bwxGLBufferManager::GetInstance().GetOrCreateEBO(m_eboKey, indexData, indexBytes);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo->GetID());
+        }
 
-        int offset = 0;
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
-        glEnableVertexAttribArray(0);
-        offset += 3 * sizeof(float);
+        m_layout.Apply();
+
+        glBindVertexArray(0);
+    }
+
+    void bwxGLMesh::SetupPooled(const void* encodedVertices, const void* indexData, GLsizeiptr indexBytes) {
+        std::shared_ptr<bwxGLGeometryPool> pool = bwxGLBufferManager::GetInstance().GetGeometryPool(m_layout);
+        if (!pool->Allocate(m_vertexCount, indexData ? indexBytes : 0, m_allocation)) {
+            std::cerr << "Error: Geometry pool allocation failed for a mesh of " << m_vertexCount << " vertices." << std::endl;
+            return;
+        }
+        m_pool = std::move(pool);
+
+        // Second attempt only when the mapped storage got lost
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            void* dst = m_pool->MapVertices(m_allocation);
+            if (!dst) break;
+            WriteVertices(static_cast<unsigned char*>(dst), encodedVertices);
+            if (m_pool->UnmapVertices(m_allocation)) break;
+        }
 
-        if (m_inputDataFormat & bwxGL_MESH_NORMAL) {
-            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
-            glEnableVertexAttribArray(1);
-            offset += 3 * sizeof(float);
+        if (indexData && indexBytes > 0) m_pool->WriteIndices(m_allocation, indexData);
+
+        m_vao = m_pool->GetVAO();
+    }
+
+    void bwxGLMesh::WriteVertices(unsigned char* dst, const void* encoded) const {
+        const size_t stride = static_cast<size_t>(m_layout.GetStride());
+
+        // Already in the layout - nothing to convert
+        if (encoded) {
+            std::memcpy(dst, encoded, stride * static_cast<size_t>(m_vertexCount));
+            return;
         }
-        if (m_inputDataFormat & bwxGL_MESH_TEX_COORD) {
-            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
-            glEnableVertexAttribArray(2);
-            offset += 2 * sizeof(float);
+
+        for (const auto& v : m_vertices) {
+            m_layout.Write(&v, dst);
+            dst += stride;
+        }
+    }
+
+    void bwxGLMesh::ReleaseBuffers() {
+        if (m_pool) {
+            // The VAO belongs to the pool
+            m_pool->Free(m_allocation);
+            m_pool.reset();
+            m_vao = 0;
         }
-        if (m_inputDataFormat & bwxGL_MESH_TANGENT) {
-            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
-            glEnableVertexAttribArray(3);
-            offset += 3 * sizeof(float);
+        if (m_vao) {
+            glDeleteVertexArrays(1, &m_vao);
+            m_vao = 0;
         }
-        if (m_inputDataFormat & bwxGL_MESH_BITANGENT) {
-            glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
-            glEnableVertexAttribArray(4);
-            offset += 3 * sizeof(float);
+        if (m_vbo) {
+            bwxGLBufferManager::GetInstance().ReleaseBuffer(m_vboKey);
+            m_vbo = nullptr;
         }
-        if (m_inputDataFormat & bwxGL_MESH_COLOR) {
-            glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
-            glEnableVertexAttribArray(5);
+        if (m_ebo) {
+            bwxGLBufferManager::GetInstance().ReleaseBuffer(m_eboKey);
+            m_ebo = nullptr;
         }
+    }
 
-        glBindVertexArray(0);
+    void bwxGLMesh::CalculateBounds() {
+        m_bounds.Reset();
+        for (const auto& v : m_vertices) {
+            m_bounds.Expand(v.position);
+        }
     }
 
     bwxGLMesh::~bwxGLMesh() {
-        bwxGLBufferManager::GetInstance().ReleaseBuffer("mesh_vbo");
-        bwxGLBufferManager::GetInstance().ReleaseBuffer("mesh_ebo");
-        glDeleteVertexArrays(1, &m_vao);
+        ReleaseBuffers();
 		Delete();
     }
 
@@ -115,20 +215,43 @@ namespace bwx_sdk {
         //if (!m_material || !m_buffer) return;
         //m_material->Bind();
         glBindVertexArray(m_vao);
+        Draw();
+        glBindVertexArray(0);
+    }
 
+    void bwxGLMesh::Draw() const {
         if (m_inputDataFormat & bwxGL_MESH_INDICES) {
-            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), GL_UNSIGNED_INT, 0);
+            if (m_pool) {
+                glDrawElementsBaseVertex(GL_TRIANGLES, m_indexCount, m_indexType, GetIndexOffset(), m_allocation.baseVertex);
+            }
+            else {
+                glDrawElements(GL_TRIANGLES, m_indexCount, m_indexType, 0);
+            }
         }
         else {
-            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size()));
+            glDrawArrays(GL_TRIANGLES, GetBaseVertex(), m_vertexCount);
         }
+    }
 
-        glBindVertexArray(0);
+    void bwxGLMesh::DrawInstanced(GLsizei instances) const {
+        if (m_inputDataFormat & bwxGL_MESH_INDICES) {
+            if (m_pool) {
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m_indexCount, m_indexType, GetIndexOffset(), instances,
+                    m_allocation.baseVertex);
+            }
+            else {
+                glDrawElementsInstanced(GL_TRIANGLES, m_indexCount, m_indexType, 0, instances);
+            }
+        }
+        else {
+            glDrawArraysInstanced(GL_TRIANGLES, GetBaseVertex(), m_vertexCount, instances);
+        }
     }
 
     void bwxGLMesh::Delete() {
-        m_vertices.clear();
-        m_indices.clear();
+        // Frees the CPU copy; the GPU buffers and draw counts stay valid
+        std::vector<bwxGLVertex>().swap(m_vertices);
+        std::vector<GLuint>().swap(m_indices);
     }
 
     void bwxGLMesh::ConvertVerticesTableToVector(GLfloat v[], GLuint size)
@@ -0,0 +1,298 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_mesh_optimizer.cpp
+// Purpose:     BWX_SDK Library; OpenGL Mesh vertex cache, overdraw and fetch optimizer
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh_optimizer.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        constexpr int CACHE_SIZE = bwxGL_MESH_OPTIMIZER_CACHE_SIZE;
+        constexpr size_t MIN_CLUSTER = 16; // Triangles; smaller clusters only reshuffle noise
+
+        float ForsythVertexScore(int cachePosition, uint32_t remaining) {
+            if (remaining == 0) return -1.0f;
+
+            float score = 0.0f;
+            if (cachePosition >= 0) {
+                if (cachePosition < 3) {
+                    score = 0.75f; // The last triangle's vertices - no bonus for reusing them right away
+                }
+                else {
+                    const float scale = 1.0f / (CACHE_SIZE - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scale, 1.5f);
+                }
+            }
+
+            // Vertices with few triangles left get a boost, so they are finished off early
+            score += 2.0f / std::sqrt(static_cast<float>(remaining));
+            return score;
+        }
+    }
+
+    bwxGLMeshOptimizerStats bwxGLMeshOptimizer::Optimize(std::vector<bwxGLVertex>& vertices, std::vector<GLuint>& indices) {
+        bwxGLMeshOptimizerStats stats;
+        stats.verticesBefore = vertices.size();
+        stats.verticesAfter = vertices.size();
+
+        if (indices.size() < 3 || indices.size() % 3 != 0 || vertices.empty()) return stats;
+
+        // Out of range indices would corrupt the per-vertex tables - leave such meshes alone
+        for (GLuint index : indices) {
+            if (index >= vertices.size()) return stats;
+        }
+
+        stats.acmrBefore = ComputeACMR(indices, vertices.size());
+
+        OptimizeVertexCache(indices, vertices.size());
+        OptimizeOverdraw(indices, vertices);
+        OptimizeVertexFetch(vertices, indices);
+
+        stats.acmrAfter = ComputeACMR(indices, vertices.size());
+        stats.verticesAfter = vertices.size();
+        stats.optimized = true;
+        return stats;
+    }
+
+    void bwxGLMeshOptimizer::OptimizeVertexCache(std::vector<GLuint>& indices, size_t vertexCount) {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0) return;
+
+        // Vertex -> triangles adjacency in one flat array
+        std::vector<uint32_t> remaining(vertexCount, 0);
+        for (GLuint index : indices) ++remaining[index];
+
+        std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v) adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v) vertexScore[v] = ForsythVertexScore(-1, remaining[v]);
+
+        auto triangleScore = [&](size_t t) {
+            return vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        };
+
+        std::vector<uint8_t> emitted(triangleCount, 0);
+
+        // Live triangles of a vertex are kept at the front of its adjacency range
+        auto removeTriangle = [&](GLuint v, uint32_t t) {
+            const uint32_t begin = adjacencyOffset[v];
+            const uint32_t end = begin + remaining[v];
+            for (uint32_t i = begin; i < end; ++i) {
+                if (adjacency[i] == t) {
+                    std::swap(adjacency[i], adjacency[end - 1]);
+                    break;
+                }
+            }
+            --remaining[v];
+        };
+
+        std::vector<GLuint> output;
+        output.reserve(indices.size());
+
+        std::vector<GLuint> cache;
+        std::vector<GLuint> nextCache;
+        cache.reserve(CACHE_SIZE + 3);
+        nextCache.reserve(CACHE_SIZE + 3);
+
+        size_t scanCursor = 0;
+        int64_t best = 0;
+        float bestScore = triangleScore(0);
+        for (size_t t = 1; t < triangleCount; ++t) {
+            const float score = triangleScore(t);
+            if (score > bestScore) {
+                bestScore = score;
+                best = static_cast<int64_t>(t);
+            }
+        }
+
+        for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+            if (best < 0) {
+                // Nothing in the cache has work left - continue with the next unused triangle
+                while (emitted[scanCursor]) ++scanCursor;
+                best = static_cast<int64_t>(scanCursor);
+            }
+
+            const size_t t = static_cast<size_t>(best);
+            emitted[t] = 1;
+
+            nextCache.clear();
+            for (int k = 0; k < 3; ++k) {
+                const GLuint v = indices[t * 3 + k];
+                output.push_back(v);
+                removeTriangle(v, static_cast<uint32_t>(t));
+                nextCache.push_back(v);
+            }
+            for (GLuint v : cache) {
+                if (v != nextCache[0] && v != nextCache[1] && v != nextCache[2]) nextCache.push_back(v);
+            }
+
+            // Vertices pushed out of the cache lose their position score
+            for (size_t i = CACHE_SIZE; i < nextCache.size(); ++i) {
+                cachePosition[nextCache[i]] = -1;
+                vertexScore[nextCache[i]] = ForsythVertexScore(-1, remaining[nextCache[i]]);
+            }
+            if (nextCache.size() > static_cast<size_t>(CACHE_SIZE)) nextCache.resize(CACHE_SIZE);
+            cache.swap(nextCache);
+
+            for (size_t i = 0; i < cache.size(); ++i) {
+                cachePosition[cache[i]] = static_cast<int>(i);
+            }
+
+            // Rescore affected triangles; the winner must reference a cached vertex
+            best = -1;
+            bestScore = -1.0f;
+            for (GLuint v : cache) {
+                vertexScore[v] = ForsythVertexScore(cachePosition[v], remaining[v]);
+            }
+            for (GLuint v : cache) {
+                const uint32_t begin = adjacencyOffset[v];
+                const uint32_t end = begin + remaining[v];
+                for (uint32_t i = begin; i < end; ++i) {
+                    const uint32_t candidate = adjacency[i];
+                    const float score = triangleScore(candidate);
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = candidate;
+                    }
+                }
+            }
+        }
+
+        indices.swap(output);
+    }
+
+    void bwxGLMeshOptimizer::OptimizeOverdraw(std::vector<GLuint>& indices, const std::vector<bwxGLVertex>& vertices, float threshold) {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount < MIN_CLUSTER * 2) return;
+
+        const float acmrBefore = ComputeACMR(indices, vertices.size());
+
+        // Cluster boundaries where the FIFO cache misses all three vertices: reordering whole
+        // clusters keeps most of the cache ordering intact
+        std::vector<size_t> clusterStart{ 0 };
+        {
+            std::vector<uint32_t> stamp(vertices.size(), 0);
+            uint32_t time = bwxGL_MESH_OPTIMIZER_FIFO_SIZE + 1;
+            for (size_t t = 0; t < triangleCount; ++t) {
+                int misses = 0;
+                for (int k = 0; k < 3; ++k) {
+                    const GLuint v = indices[t * 3 + k];
+                    if (time - stamp[v] > bwxGL_MESH_OPTIMIZER_FIFO_SIZE) {
+                        stamp[v] = time++;
+                        ++misses;
+                    }
+                }
+                if (misses == 3 && t - clusterStart.back() >= MIN_CLUSTER) clusterStart.push_back(t);
+            }
+        }
+        if (clusterStart.size() < 2) return;
+
+        glm::vec3 meshCenter(0.0f);
+        for (const auto& v : vertices) meshCenter += v.position;
+        meshCenter /= static_cast<float>(vertices.size());
+
+        // Clusters facing away from the centre are likely visible first - draw them first
+        const size_t clusterCount = clusterStart.size();
+        std::vector<float> sortKey(clusterCount, 0.0f);
+        for (size_t c = 0; c < clusterCount; ++c) {
+            const size_t begin = clusterStart[c];
+            const size_t end = c + 1 < clusterCount ? clusterStart[c + 1] : triangleCount;
+
+            glm::vec3 center(0.0f);
+            glm::vec3 normal(0.0f);
+            float area = 0.0f;
+
+            for (size_t t = begin; t < end; ++t) {
+                const glm::vec3& a = vertices[indices[t * 3]].position;
+                const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+                const glm::vec3& d = vertices[indices[t * 3 + 2]].position;
+
+                const glm::vec3 cross = glm::cross(b - a, d - a); // Length = 2 * area
+                const float triangleArea = glm::length(cross);
+                center += (a + b + d) * (triangleArea / 3.0f);
+                normal += cross;
+                area += triangleArea;
+            }
+
+            if (area <= 0.0f) continue;
+            center /= area;
+            const float normalLength = glm::length(normal);
+            if (normalLength > 0.0f) sortKey[c] = glm::dot(center - meshCenter, normal / normalLength);
+        }
+
+        std::vector<size_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+        std::vector<GLuint> sorted;
+        sorted.reserve(indices.size());
+        for (size_t c : order) {
+            const size_t begin = clusterStart[c] * 3;
+            const size_t end = (c + 1 < clusterCount ? clusterStart[c + 1] : triangleCount) * 3;
+            sorted.insert(sorted.end(), indices.begin() + begin, indices.begin() + end);
+        }
+
+        if (ComputeACMR(sorted, vertices.size()) <= acmrBefore * threshold) indices.swap(sorted);
+    }
+
+    void bwxGLMeshOptimizer::OptimizeVertexFetch(std::vector<bwxGLVertex>& vertices, std::vector<GLuint>& indices) {
+        constexpr GLuint UNUSED = ~GLuint(0);
+
+        std::vector<GLuint> remap(vertices.size(), UNUSED);
+        std::vector<bwxGLVertex> reordered;
+        reordered.reserve(vertices.size());
+
+        for (GLuint& index : indices) {
+            if (remap[index] == UNUSED) {
+                remap[index] = static_cast<GLuint>(reordered.size());
+                reordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices.swap(reordered);
+    }
+
+    float bwxGLMeshOptimizer::ComputeACMR(const std::vector<GLuint>& indices, size_t vertexCount, unsigned int cacheSize) {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0) return 0.0f;
+
+        // FIFO cache: a vertex is a hit while fewer than cacheSize misses happened since it was loaded
+        std::vector<uint32_t> stamp(vertexCount, 0);
+        uint32_t time = cacheSize + 1;
+        size_t misses = 0;
+
+        for (GLuint index : indices) {
+            if (index >= vertexCount) continue;
+            if (time - stamp[index] > cacheSize) {
+                stamp[index] = time++;
+                ++misses;
+            }
+        }
+
+        return static_cast<float>(misses) / static_cast<float>(triangleCount);
+    }
+
+} // namespace bwx_sdk
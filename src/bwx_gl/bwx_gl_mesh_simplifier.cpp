@@ -0,0 +1,242 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_mesh_simplifier.cpp
+// Purpose:     BWX_SDK Library; OpenGL Mesh edge-collapse simplification
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh_simplifier.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_bounds.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        // Symmetric 4x4 plane quadric, upper triangle
+        struct Quadric {
+            double a2 = 0, ab = 0, ac = 0, ad = 0;
+            double b2 = 0, bc = 0, bd = 0;
+            double c2 = 0, cd = 0;
+            double d2 = 0;
+
+            static Quadric FromPlane(double a, double b, double c, double d, double weight) {
+                Quadric q;
+                q.a2 = a * a * weight; q.ab = a * b * weight; q.ac = a * c * weight; q.ad = a * d * weight;
+                q.b2 = b * b * weight; q.bc = b * c * weight; q.bd = b * d * weight;
+                q.c2 = c * c * weight; q.cd = c * d * weight;
+                q.d2 = d * d * weight;
+                return q;
+            }
+
+            inline void Add(const Quadric& q) {
+                a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+                b2 += q.b2; bc += q.bc; bd += q.bd;
+                c2 += q.c2; cd += q.cd;
+                d2 += q.d2;
+            }
+
+            inline double Error(const glm::vec3& p) const {
+                const double x = p.x, y = p.y, z = p.z;
+                return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x +
+                       b2 * y * y + 2 * bc * y * z + 2 * bd * y +
+                       c2 * z * z + 2 * cd * z + d2;
+            }
+        };
+
+        struct Collapse {
+            double cost;
+            GLuint from;
+            GLuint to;
+            uint32_t fromStamp; ///< Vertex stamps when the cost was computed
+            uint32_t toStamp;
+
+            inline bool operator>(const Collapse& other) const { return cost > other.cost; }
+        };
+
+        inline uint64_t EdgeKey(GLuint a, GLuint b) {
+            if (a > b) std::swap(a, b);
+            return (static_cast<uint64_t>(a) << 32) | b;
+        }
+
+        struct PositionHash {
+            size_t operator()(const glm::vec3& p) const {
+                uint32_t bits[3];
+                std::memcpy(bits, &p, sizeof(bits));
+                return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+            }
+        };
+    }
+
+    std::vector<GLuint> bwxGLMeshSimplifier::Simplify(const std::vector<bwxGLVertex>& vertices, const std::vector<GLuint>& indices,
+        size_t targetIndexCount, float targetError) {
+        std::vector<GLuint> result(indices);
+
+        const size_t triangleCount = indices.size() / 3;
+        const size_t vertexCount = vertices.size();
+        if (triangleCount == 0 || indices.size() <= targetIndexCount) return result;
+
+        for (GLuint index : indices) {
+            if (index >= vertexCount) return result;
+        }
+
+        bwxGLBoundingBox bounds;
+        for (const auto& v : vertices) bounds.Expand(v.position);
+        const double diagonal = glm::length(bounds.max - bounds.min);
+        const double maxError = (targetError * diagonal) * (targetError * diagonal);
+
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+        std::vector<uint8_t> triangleAlive(triangleCount, 1);
+        std::vector<uint8_t> locked(vertexCount, 0);
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const GLuint i0 = result[t * 3], i1 = result[t * 3 + 1], i2 = result[t * 3 + 2];
+            const glm::vec3& p0 = vertices[i0].position;
+
+            const glm::vec3 n = glm::cross(vertices[i1].position - p0, vertices[i2].position - p0);
+            const double length = glm::length(n);
+            if (length > 0.0) {
+                const double a = n.x / length, b = n.y / length, c = n.z / length;
+                const double d = -(a * p0.x + b * p0.y + c * p0.z);
+                const Quadric q = Quadric::FromPlane(a, b, c, d, length * 0.5); // Area weighted
+                quadrics[i0].Add(q);
+                quadrics[i1].Add(q);
+                quadrics[i2].Add(q);
+            }
+
+            for (int k = 0; k < 3; ++k) {
+                vertexTriangles[result[t * 3 + k]].push_back(static_cast<uint32_t>(t));
+                ++edgeUse[EdgeKey(result[t * 3 + k], result[t * 3 + (k + 1) % 3])];
+            }
+        }
+
+        // Open borders and attribute seams would tear - those vertices stay where they are
+        for (const auto& [key, count] : edgeUse) {
+            if (count == 1) {
+                locked[static_cast<GLuint>(key >> 32)] = 1;
+                locked[static_cast<GLuint>(key & 0xFFFFFFFFu)] = 1;
+            }
+        }
+        {
+            std::unordered_map<glm::vec3, uint32_t, PositionHash> positionUse;
+            for (const auto& v : vertices) ++positionUse[v.position];
+            for (size_t v = 0; v < vertexCount; ++v) {
+                if (positionUse[vertices[v].position] > 1) locked[v] = 1;
+            }
+        }
+
+        std::vector<uint32_t> stamp(vertexCount, 0);
+        std::vector<uint8_t> removed(vertexCount, 0);
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+
+        auto pushEdge = [&](GLuint a, GLuint b) {
+            Quadric q = quadrics[a];
+            q.Add(quadrics[b]);
+
+            // Cheaper direction among the allowed ones
+            const double costToB = locked[a] ? HUGE_VAL : q.Error(vertices[b].position);
+            const double costToA = locked[b] ? HUGE_VAL : q.Error(vertices[a].position);
+            if (costToB == HUGE_VAL && costToA == HUGE_VAL) return;
+
+            if (costToB <= costToA) queue.push({ costToB, a, b, stamp[a], stamp[b] });
+            else queue.push({ costToA, b, a, stamp[b], stamp[a] });
+        };
+
+        for (const auto& [key, count] : edgeUse) {
+            pushEdge(static_cast<GLuint>(key >> 32), static_cast<GLuint>(key & 0xFFFFFFFFu));
+        }
+
+        size_t liveIndices = result.size();
+
+        while (liveIndices > targetIndexCount && !queue.empty()) {
+            const Collapse collapse = queue.top();
+            queue.pop();
+
+            if (collapse.cost > maxError) break;
+            if (removed[collapse.from] || removed[collapse.to]) continue;
+            if (stamp[collapse.from] != collapse.fromStamp || stamp[collapse.to] != collapse.toStamp) continue;
+
+            const GLuint from = collapse.from;
+            const GLuint to = collapse.to;
+            const glm::vec3& target = vertices[to].position;
+
+            // Reject collapses that flip a surviving triangle
+            bool flips = false;
+            bool connected = false;
+            for (uint32_t t : vertexTriangles[from]) {
+                if (!triangleAlive[t]) continue;
+
+                GLuint* tri = &result[t * 3];
+                if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                    connected = true;
+                    continue;
+                }
+
+                glm::vec3 before[3], after[3];
+                for (int k = 0; k < 3; ++k) {
+                    before[k] = vertices[tri[k]].position;
+                    after[k] = tri[k] == from ? target : before[k];
+                }
+                const glm::vec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const glm::vec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+                if (glm::dot(n0, n1) <= 0.0f) {
+                    flips = true;
+                    break;
+                }
+            }
+            if (flips || !connected) continue;
+
+            for (uint32_t t : vertexTriangles[from]) {
+                if (!triangleAlive[t]) continue;
+
+                GLuint* tri = &result[t * 3];
+                if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                    triangleAlive[t] = 0;
+                    liveIndices -= 3;
+                    continue;
+                }
+
+                for (int k = 0; k < 3; ++k) {
+                    if (tri[k] == from) tri[k] = to;
+                }
+                vertexTriangles[to].push_back(t);
+            }
+
+            removed[from] = 1;
+            quadrics[to].Add(quadrics[from]);
+            ++stamp[to];
+
+            // Drop dead triangles from the survivor's list and requeue its edges
+            auto& list = vertexTriangles[to];
+            list.erase(std::remove_if(list.begin(), list.end(), [&](uint32_t t) { return !triangleAlive[t]; }), list.end());
+
+            for (uint32_t t : list) {
+                const GLuint* tri = &result[t * 3];
+                for (int k = 0; k < 3; ++k) {
+                    if (tri[k] != to) pushEdge(to, tri[k]);
+                }
+            }
+        }
+
+        std::vector<GLuint> simplified;
+        simplified.reserve(liveIndices);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (triangleAlive[t]) simplified.insert(simplified.end(), result.begin() + t * 3, result.begin() + t * 3 + 3);
+        }
+        return simplified;
+    }
+
+} // namespace bwx_sdk
@@ -12,6 +12,7 @@
 #endif
 
 #include <bwx_sdk/bwx_gl/bwx_gl_model.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh_simplifier.h>
 
 namespace bwx_sdk {
 
@@ -33,6 +34,83 @@ namespace bwx_sdk {
 	void bwxGLModel::Clean()
 	{
 		this->m_meshes.clear();
+		this->m_lodChains.clear();
+		this->m_shaderPrograms.clear();
+		this->m_skeleton.reset();
+		this->m_animations.clear();
+		m_bounds.Reset();
+		m_boundsDirty = true;
+	}
+
+	void bwxGLModel::SetShaderProgram(size_t index, std::shared_ptr<bwxGLShaderProgram> program)
+	{
+		if (index >= m_meshes.size()) return;
+		if (m_shaderPrograms.size() < m_meshes.size()) m_shaderPrograms.resize(m_meshes.size());
+		m_shaderPrograms[index] = program;
+	}
+
+	void bwxGLModel::GenerateLODs(int levels, float reduction, float targetError)
+	{
+		m_lodChains.assign(m_meshes.size(), nullptr);
+
+		for (size_t i = 0; i < m_meshes.size(); ++i)
+		{
+			const auto& mesh = m_meshes[i];
+			if (!mesh || mesh->GetIndices().empty()) continue;
+
+			std::vector<std::shared_ptr<bwxGLMesh>> lods{ mesh };
+			std::vector<GLuint> indices = mesh->GetIndices();
+
+			for (int level = 1; level < levels; ++level)
+			{
+				const size_t target = static_cast<size_t>(indices.size() * reduction) / 3 * 3;
+				std::vector<GLuint> simplified = bwxGLMeshSimplifier::Simplify(mesh->GetVertices(), indices, target, targetError * level);
+
+				// Error bound reached - a further level would look the same
+				if (simplified.size() > indices.size() * 0.9f) break;
+
+				auto lod = std::make_shared<bwxGLMesh>(mesh->GetFormat() | bwxGL_MESH_INDICES);
+				lod->SetVertices(mesh->GetVertices());
+				lod->SetIndices(simplified);
+				if (mesh->GetVAO()) lod->SetupMesh(); // Drops the vertices the simplified mesh no longer uses
+
+				lods.push_back(lod);
+				indices.swap(simplified);
+			}
+
+			if (lods.size() < 2) continue;
+
+			// Thresholds halve with every level; the coarsest one covers everything below
+			auto chain = std::make_shared<bwxGLLODChain>();
+			float screenSize = bwxGL_LOD_SCREEN_SIZE;
+			for (size_t l = 0; l < lods.size(); ++l)
+			{
+				chain->AddLevel(lods[l], l + 1 < lods.size() ? screenSize : 0.0f);
+				screenSize *= 0.5f;
+			}
+
+			m_lodChains[i] = chain;
+		}
+	}
+
+	std::shared_ptr<bwxGLAnimationClip> bwxGLModel::FindAnimation(const std::string& name) const
+	{
+		for (const auto& clip : m_animations)
+		{
+			if (clip && clip->GetName() == name) return clip;
+		}
+		return nullptr;
+	}
+
+	const bwxGLBoundingBox& bwxGLModel::GetBounds()
+	{
+		if (m_boundsDirty)
+		{
+			m_bounds.Reset();
+			for (const auto& m : this->m_meshes) { if (m) m_bounds.Expand(m->GetBounds()); }
+			m_boundsDirty = false;
+		}
+		return m_bounds;
 	}
 
 }
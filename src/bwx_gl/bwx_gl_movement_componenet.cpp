@@ -17,17 +17,27 @@
 namespace bwx_sdk {
 
 	bwxGLMovementComponent::bwxGLMovementComponent()
-		: m_velocity(0.0f), m_rotationSpeed(1.0f) {
+		: m_velocity(0.0f), m_acceleration(0.0f), m_rotationSpeed(1.0f) {
 	}
 
 	void bwxGLMovementComponent::SetVelocity(const glm::vec3& velocity) {
 		m_velocity = velocity;
+		++m_version;
 	}
 
 	glm::vec3 bwxGLMovementComponent::GetVelocity() const {
 		return m_velocity;
 	}
 
+	void bwxGLMovementComponent::SetAcceleration(const glm::vec3& acceleration) {
+		m_acceleration = acceleration;
+		++m_version;
+	}
+
+	glm::vec3 bwxGLMovementComponent::GetAcceleration() const {
+		return m_acceleration;
+	}
+
 	void bwxGLMovementComponent::SetRotationSpeed(float speed) {
 		m_rotationSpeed = speed;
 	}
@@ -173,7 +183,13 @@ namespace bwx_sdk {
 	}
 
 	void bwxGLMovementComponent::Update(float deltaTime) {
-		if (glm::length(m_velocity) > 0.0f) {
+		if (m_batched) return;
+
+		if (m_acceleration != glm::vec3(0.0f)) {
+			Translate(m_velocity * deltaTime + 0.5f * m_acceleration * deltaTime * deltaTime);
+			m_velocity += m_acceleration * deltaTime;
+		}
+		else if (m_velocity != glm::vec3(0.0f)) {
 			Translate(m_velocity * deltaTime);
 		}
 	}
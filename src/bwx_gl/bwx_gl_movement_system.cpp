@@ -0,0 +1,268 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_movement_system.cpp
+// Purpose:     BWX_SDK Library; Batched movement integration system (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define bwxGL_MOVEMENT_SSE
+#endif
+
+#include <bwx_sdk/bwx_gl/bwx_gl_movement_system.h>
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        // p += v * dt + a * dt^2 / 2; v += a * dt over floats [begin, end) of the packed vec3 arrays
+        inline void IntegrateRange(float* p, float* v, const float* a, size_t begin, size_t end, float dt) {
+            const float halfDt2 = 0.5f * dt * dt;
+            size_t i = begin;
+
+#if defined(bwxGL_MOVEMENT_SSE)
+            const __m128 vDt = _mm_set1_ps(dt);
+            const __m128 vHalfDt2 = _mm_set1_ps(halfDt2);
+
+            for (; i + 4 <= end; i += 4) {
+                const __m128 pos = _mm_loadu_ps(p + i);
+                const __m128 vel = _mm_loadu_ps(v + i);
+                const __m128 acc = _mm_loadu_ps(a + i);
+
+                _mm_storeu_ps(p + i, _mm_add_ps(pos, _mm_add_ps(_mm_mul_ps(vel, vDt), _mm_mul_ps(acc, vHalfDt2))));
+                _mm_storeu_ps(v + i, _mm_add_ps(vel, _mm_mul_ps(acc, vDt)));
+            }
+#endif
+            for (; i < end; ++i) {
+                p[i] += v[i] * dt + a[i] * halfDt2;
+                v[i] += a[i] * dt;
+            }
+        }
+    }
+
+    void bwxGLMovementSystem::Update(const std::shared_ptr<bwxGLNode>& root, float deltaTime) {
+        if (!root) {
+            Clear();
+            return;
+        }
+
+        if (!m_built || m_root.lock() != root || m_hierarchyVersion != bwxGLNode::GetHierarchyVersion()) {
+            Rebuild(root);
+        }
+
+        m_updatedCount = 0;
+        const size_t count = m_movements.size();
+        if (count == 0) return;
+
+        Gather();
+
+        float alpha = 1.0f;
+        if (m_fixedStep > 0.0f) {
+            m_accumulator += deltaTime;
+
+            int steps = 0;
+            while (m_accumulator >= m_fixedStep && steps < bwxGL_MOVEMENT_MAX_STEPS) {
+                if (m_interpolate) std::copy(m_position.begin(), m_position.end(), m_previous.begin());
+                Integrate(m_fixedStep);
+                m_accumulator -= m_fixedStep;
+                ++steps;
+            }
+
+            // Too far behind (a stall or a breakpoint): skip instead of spiralling
+            if (m_accumulator >= m_fixedStep) m_accumulator = std::fmod(m_accumulator, m_fixedStep);
+
+            if (m_interpolate) alpha = m_accumulator / m_fixedStep;
+        }
+        else {
+            Integrate(deltaTime);
+        }
+
+        // One pass back into the components; untouched entries keep their transform versions
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3 output = alpha < 1.0f ? glm::mix(m_previous[i], m_position[i], alpha) : m_position[i];
+
+            if (output != m_output[i]) {
+                m_output[i] = output;
+                m_transforms[i]->SetPosition(output);
+                m_transformVersion[i] = m_transforms[i]->GetVersion();
+                ++m_updatedCount;
+            }
+
+            // Accelerated entries changed speed; the component version stays, it only tracks outside writes
+            if (m_acceleration[i] != glm::vec3(0.0f)) {
+                m_movements[i]->m_velocity = m_velocity[i];
+            }
+        }
+    }
+
+    void bwxGLMovementSystem::SetFixedTimestep(float step) {
+        m_fixedStep = std::max(step, 0.0f);
+        m_accumulator = 0.0f;
+        std::copy(m_position.begin(), m_position.end(), m_previous.begin());
+    }
+
+    void bwxGLMovementSystem::Clear() {
+        for (auto& owner : m_movementOwners) {
+            owner->m_batched = false; // Back to per-component updates
+        }
+
+        m_velocity.clear();
+        m_acceleration.clear();
+        m_position.clear();
+        m_previous.clear();
+        m_output.clear();
+        m_movementVersion.clear();
+        m_transformVersion.clear();
+        m_movements.clear();
+        m_transforms.clear();
+        m_movementOwners.clear();
+        m_transformOwners.clear();
+        m_root.reset();
+        m_built = false;
+        m_accumulator = 0.0f;
+        m_updatedCount = 0;
+    }
+
+    void bwxGLMovementSystem::Rebuild(const std::shared_ptr<bwxGLNode>& root) {
+        // The old state moves aside; its owners keep the components alive, so an address found
+        // again below is the same component and not a new one at a reused address
+        std::unordered_map<const bwxGLMovementComponent*, size_t> survivors;
+        for (size_t i = 0; i < m_movements.size(); ++i) {
+            survivors.emplace(m_movements[i], i);
+        }
+
+        std::vector<glm::vec3> velocity, acceleration, position, previous, output;
+        std::vector<unsigned int> movementVersion, transformVersion;
+        std::vector<std::shared_ptr<bwxGLMovementComponent>> movementOwners;
+        std::vector<std::shared_ptr<bwxGLTransformComponent>> transformOwners;
+        velocity.swap(m_velocity);
+        acceleration.swap(m_acceleration);
+        position.swap(m_position);
+        previous.swap(m_previous);
+        output.swap(m_output);
+        movementVersion.swap(m_movementVersion);
+        transformVersion.swap(m_transformVersion);
+        movementOwners.swap(m_movementOwners);
+        transformOwners.swap(m_transformOwners);
+
+        for (auto& owner : movementOwners) {
+            owner->m_batched = false;
+        }
+        m_movements.clear();
+        m_transforms.clear();
+
+        m_root = root;
+        m_hierarchyVersion = bwxGLNode::GetHierarchyVersion();
+        m_built = true;
+
+        std::vector<bwxGLNode*> stack{ root.get() };
+        while (!stack.empty()) {
+            bwxGLNode* node = stack.back();
+            stack.pop_back();
+
+            auto movement = node->GetComponent<bwxGLMovementComponent>();
+            auto transform = movement ? node->GetComponent<bwxGLTransformComponent>() : nullptr;
+
+            if (movement && transform) {
+                movement->m_batched = true;
+
+                m_movements.push_back(movement.get());
+                m_transforms.push_back(transform.get());
+                m_movementOwners.push_back(movement);
+                m_transformOwners.push_back(transform);
+            }
+
+            for (const auto& child : node->GetChildren()) {
+                stack.push_back(child.get());
+            }
+        }
+
+        const size_t count = m_movements.size();
+        m_velocity.resize(count);
+        m_acceleration.resize(count);
+        m_position.resize(count);
+        m_previous.resize(count);
+        m_output.resize(count);
+        m_movementVersion.resize(count);
+        m_transformVersion.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            auto it = survivors.find(m_movements[i]);
+            if (it != survivors.end() && transformOwners[it->second].get() == m_transforms[i]) {
+                // The transform holds the interpolated output; the simulation continues from its own state
+                const size_t j = it->second;
+                m_velocity[i] = velocity[j];
+                m_acceleration[i] = acceleration[j];
+                m_position[i] = position[j];
+                m_previous[i] = previous[j];
+                m_output[i] = output[j];
+                m_movementVersion[i] = movementVersion[j];
+                m_transformVersion[i] = transformVersion[j];
+                continue;
+            }
+
+            const glm::vec3 start = m_transforms[i]->GetPosition();
+            m_velocity[i] = glm::vec3(0.0f);
+            m_acceleration[i] = glm::vec3(0.0f);
+            m_position[i] = start;
+            m_previous[i] = start;
+            m_output[i] = start;
+            m_transformVersion[i] = m_transforms[i]->GetVersion();
+            m_movementVersion[i] = m_movements[i]->m_version - 1; // Never matches - the first Gather() reads it
+        }
+    }
+
+    void bwxGLMovementSystem::Gather() {
+        const size_t count = m_movements.size();
+
+        for (size_t i = 0; i < count; ++i) {
+            const bwxGLMovementComponent* movement = m_movements[i];
+            if (movement->m_version != m_movementVersion[i]) {
+                m_velocity[i] = movement->m_velocity;
+                m_acceleration[i] = movement->m_acceleration;
+                m_movementVersion[i] = movement->m_version;
+            }
+
+            const bwxGLTransformComponent* transform = m_transforms[i];
+            if (transform->GetVersion() != m_transformVersion[i]) {
+                // A rotation or scale change leaves the simulated position alone; a moved one is a teleport
+                const glm::vec3 position = transform->GetPosition();
+                if (position != m_output[i]) {
+                    m_position[i] = position;
+                    m_previous[i] = position;
+                    m_output[i] = position;
+                }
+                m_transformVersion[i] = transform->GetVersion();
+            }
+        }
+    }
+
+    void bwxGLMovementSystem::Integrate(float step) {
+        const size_t count = m_movements.size();
+        float* p = &m_position[0].x;
+        float* v = &m_velocity[0].x;
+        const float* a = &m_acceleration[0].x;
+
+        if (count < 2 * bwxGL_MOVEMENT_JOB_GRAIN || bwxJobSystem::GetInstance().GetWorkerCount() == 0) {
+            IntegrateRange(p, v, a, 0, count * 3, step);
+            return;
+        }
+
+        // Entries are independent, so chunks never share a float
+        bwxJobSystem::GetInstance().ParallelFor(count, bwxGL_MOVEMENT_JOB_GRAIN, [p, v, a, step](size_t begin, size_t end) {
+            IntegrateRange(p, v, a, begin * 3, end * 3, step);
+        });
+    }
+
+} // namespace bwx_sdk
@@ -0,0 +1,196 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_occlusion.cpp
+// Purpose:     BWX_SDK Library; OpenGL Occlusion culling with bounding-box queries (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_occlusion.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        const char* BOX_VERTEX_SHADER =
+            "#version 330 core\n"
+            "layout(location = 0) in vec3 aPos;\n"
+            "uniform mat4 boxMatrix;\n"
+            "void main() { gl_Position = boxMatrix * vec4(aPos, 1.0); }\n";
+
+        const char* BOX_FRAGMENT_SHADER =
+            "#version 330 core\n"
+            "void main() {}\n";
+
+        const GLfloat BOX_VERTICES[] = {
+            -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,
+            -1.0f, -1.0f,  1.0f,   1.0f, -1.0f,  1.0f,   1.0f,  1.0f,  1.0f,  -1.0f,  1.0f,  1.0f
+        };
+
+        const GLuint BOX_INDICES[] = {
+            0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+            3, 6, 2, 3, 7, 6,   0, 4, 7, 0, 7, 3,   1, 2, 6, 1, 6, 5
+        };
+
+        constexpr GLsizei BOX_INDEX_COUNT = sizeof(BOX_INDICES) / sizeof(BOX_INDICES[0]);
+    }
+
+    bwxGLOcclusionCuller::~bwxGLOcclusionCuller() {
+        Release();
+    }
+
+    bool bwxGLOcclusionCuller::IsSupported() {
+        return GLEW_VERSION_3_3 || GLEW_ARB_occlusion_query2;
+    }
+
+    void bwxGLOcclusionCuller::BeginFrame() {
+        ++m_frame;
+        m_occludedCount = 0;
+        m_tests.clear();
+
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (it->second.lastFrame + bwxGL_OCCLUSION_KEEP_FRAMES < m_frame) {
+                if (it->second.query) glDeleteQueries(1, &it->second.query);
+                it = m_entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    bool bwxGLOcclusionCuller::IsVisible(const void* object, const bwxGLBoundingBox& box, const glm::vec3& cameraPosition, float nearPlane) {
+        Entry& entry = m_entries[object];
+
+        // Out of view last frame - whatever was measured back then says nothing now
+        if (entry.lastFrame + 1 < m_frame) {
+            entry.visible = true;
+            entry.stale = entry.pending;
+        }
+        entry.lastFrame = m_frame;
+
+        if (entry.pending) {
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(entry.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint samples = 0;
+                glGetQueryObjectuiv(entry.query, GL_QUERY_RESULT, &samples);
+                if (!entry.stale) entry.visible = samples != 0;
+                entry.pending = false;
+                entry.stale = false;
+            }
+        }
+
+        // The near plane would clip the faces of a box around the camera and nothing would pass
+        const glm::vec3 margin(std::max(nearPlane, 0.0f) * 2.0f);
+        const glm::vec3 low = box.min - margin;
+        const glm::vec3 high = box.max + margin;
+        if (cameraPosition.x >= low.x && cameraPosition.y >= low.y && cameraPosition.z >= low.z &&
+            cameraPosition.x <= high.x && cameraPosition.y <= high.y && cameraPosition.z <= high.z) {
+            entry.visible = true;
+            return true;
+        }
+
+        if (!entry.pending) {
+            entry.box = box;
+            m_tests.push_back(&entry);
+        }
+
+        if (!entry.visible) ++m_occludedCount;
+        return entry.visible;
+    }
+
+    void bwxGLOcclusionCuller::IssueQueries(const glm::mat4& viewProjection) {
+        if (m_tests.empty() || !CreateResources()) return;
+
+        GLboolean colorMask[4];
+        GLboolean depthMask = GL_TRUE;
+        glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+        const GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+
+        // Tested against the opaque depth only, nothing written
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+        glDisable(GL_CULL_FACE);
+
+        m_program->Bind();
+        glBindVertexArray(m_vao);
+
+        for (Entry* entry : m_tests) {
+            if (!entry->query) glGenQueries(1, &entry->query);
+
+            const glm::vec3 extents = glm::max(entry->box.GetExtents(), glm::vec3(1e-4f));
+            const glm::mat4 boxMatrix = viewProjection * glm::scale(glm::translate(glm::mat4(1.0f), entry->box.GetCenter()), extents);
+            m_program->SetUniform("boxMatrix", boxMatrix);
+
+            glBeginQuery(GL_ANY_SAMPLES_PASSED, entry->query);
+            glDrawElements(GL_TRIANGLES, BOX_INDEX_COUNT, GL_UNSIGNED_INT, nullptr);
+            glEndQuery(GL_ANY_SAMPLES_PASSED);
+            entry->pending = true;
+        }
+
+        glBindVertexArray(0);
+        glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
+        glDepthMask(depthMask);
+        if (cullFace) glEnable(GL_CULL_FACE);
+    }
+
+    bool bwxGLOcclusionCuller::CreateResources() {
+        if (m_vao) return true;
+        if (!IsSupported()) return false;
+
+        bwxGLShader vertex(bwxGL_SHADER_TYPE::SHADER_VERTEX, BOX_VERTEX_SHADER);
+        bwxGLShader fragment(bwxGL_SHADER_TYPE::SHADER_FRAGMENT, BOX_FRAGMENT_SHADER);
+        m_program = std::make_unique<bwxGLShaderProgram>();
+        m_program->AttachShader(vertex);
+        m_program->AttachShader(fragment);
+        if (!m_program->Link()) {
+            m_program.reset();
+            return false;
+        }
+
+        // The index buffer binding is VAO state: create it inside our own VAO, never in whatever
+        // mesh VAO the caller left bound
+        glGenVertexArrays(1, &m_vao);
+        glBindVertexArray(m_vao);
+
+        m_vertices = std::make_unique<bwxGLBuffer>(GL_ARRAY_BUFFER);
+        m_vertices->SetData(BOX_VERTICES, sizeof(BOX_VERTICES));
+        m_indices = std::make_unique<bwxGLBuffer>(GL_ELEMENT_ARRAY_BUFFER);
+        m_indices->SetData(BOX_INDICES, sizeof(BOX_INDICES));
+
+        m_vertices->Bind();
+        m_indices->Bind();
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), nullptr);
+        glBindVertexArray(0);
+        m_vertices->Unbind();
+
+        return true;
+    }
+
+    void bwxGLOcclusionCuller::Release() {
+        for (auto& [object, entry] : m_entries) {
+            if (entry.query) glDeleteQueries(1, &entry.query);
+        }
+        m_entries.clear();
+        m_tests.clear();
+
+        if (m_vao) glDeleteVertexArrays(1, &m_vao);
+        m_vao = 0;
+        m_vertices.reset();
+        m_indices.reset();
+        m_program.reset();
+    }
+
+} // namespace bwx_sdk
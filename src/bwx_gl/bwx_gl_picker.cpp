@@ -0,0 +1,227 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_picker.cpp
+// Purpose:     BWX_SDK Library; OpenGL Object picking with an ID render target (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <iostream>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_node.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_picker.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_renderable_component.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        const char* ID_VERTEX_SHADER =
+            "#version 330 core\n"
+            "layout(location = 0) in vec3 aPos;\n"
+            "uniform mat4 pickMatrix;\n"
+            "void main() { gl_Position = pickMatrix * vec4(aPos, 1.0); }\n";
+
+        const char* ID_FRAGMENT_SHADER =
+            "#version 330 core\n"
+            "uniform int objectId;\n"
+            "layout(location = 0) out uint fragId;\n"
+            "void main() { fragId = uint(objectId); }\n";
+    }
+
+    bwxGLPicker::~bwxGLPicker() {
+        Release();
+    }
+
+    bool bwxGLPicker::IsSupported() {
+        return GLEW_VERSION_3_3;
+    }
+
+    void bwxGLPicker::RequestPick(int x, int y, Callback callback) {
+        // Only the latest click matters - an earlier one not yet drawn is replaced
+        m_requested = true;
+        m_x = x;
+        m_y = y;
+        m_callback = std::move(callback);
+    }
+
+    void bwxGLPicker::Render(const bwxGLRenderQueue& queue, const glm::mat4& viewProjection, const glm::ivec4& viewport) {
+        if (!m_requested || !CreateResources()) return;
+
+        Readback* readback = nullptr;
+        for (Readback& slot : m_readbacks) {
+            if (!slot.fence) {
+                readback = &slot;
+                break;
+            }
+        }
+        if (!readback) return; // All slots busy - the request waits for the next frame
+
+        m_requested = false;
+        readback->callback = std::move(m_callback);
+        readback->nodes.clear();
+        m_callback = nullptr;
+
+        // Post-projection zoom: the requested pixel covers the whole 1x1 target, everything else is clipped
+        const glm::vec2 size = glm::max(glm::vec2(viewport.z, viewport.w), glm::vec2(1.0f));
+        const glm::vec2 center = (glm::vec2(m_x - viewport.x, m_y - viewport.y) + 0.5f) / size * 2.0f - 1.0f;
+        const glm::mat4 pickProjection = glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f)) *
+            glm::translate(glm::mat4(1.0f), glm::vec3(-center, 0.0f)) * viewProjection;
+
+        GLint previousFramebuffer = 0;
+        GLint previousViewport[4];
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+        GLboolean depthMask = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+        glViewport(0, 0, 1, 1);
+        glDepthMask(GL_TRUE);
+
+        const GLuint clearId[4] = { 0, 0, 0, 0 };
+        glClearBufferuiv(GL_COLOR, 0, clearId);
+        glClear(GL_DEPTH_BUFFER_BIT);
+
+        m_program->Bind();
+        DrawEntries(queue, queue.GetOpaque(), pickProjection, *readback);
+        DrawEntries(queue, queue.GetTransparent(), pickProjection, *readback);
+
+        // Copied into the pixel buffer on the GPU; the fence tells Poll() when it can be read
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbo);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        ++m_inFlight;
+
+        glBindVertexArray(0);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+        glDepthMask(depthMask);
+    }
+
+    void bwxGLPicker::DrawEntries(const bwxGLRenderQueue& queue, const std::vector<bwxGLRenderQueue::SortEntry>& entries,
+        const glm::mat4& pickProjection, Readback& readback) {
+        GLuint currentVAO = 0;
+        for (const auto& entry : entries) {
+            const bwxGLDrawItem& item = queue.GetItem(entry);
+
+            readback.nodes.push_back(item.renderable->GetNode());
+            m_program->SetUniform("objectId", static_cast<GLint>(readback.nodes.size()));
+            m_program->SetUniform("pickMatrix", pickProjection * item.model);
+
+            if (item.vao != currentVAO) {
+                glBindVertexArray(item.vao);
+                currentVAO = item.vao;
+            }
+            item.renderable->Draw();
+        }
+    }
+
+    void bwxGLPicker::Poll() {
+        if (!m_inFlight) return;
+
+        for (Readback& readback : m_readbacks) {
+            if (!readback.fence) continue;
+
+            const GLenum status = glClientWaitSync(readback.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+
+            GLuint id = 0;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+            if (const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint), GL_MAP_READ_BIT)) {
+                id = *static_cast<const GLuint*>(data);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+            --m_inFlight;
+
+            // The node may have been removed from the scene since - then nothing was hit
+            std::shared_ptr<bwxGLNode> node;
+            if (id > 0 && id <= readback.nodes.size()) node = readback.nodes[id - 1].lock();
+            readback.nodes.clear();
+
+            Callback callback = std::move(readback.callback);
+            readback.callback = nullptr;
+            if (callback) callback(node);
+        }
+    }
+
+    bool bwxGLPicker::CreateResources() {
+        if (m_framebuffer) return true;
+        if (!IsSupported()) return false;
+
+        bwxGLShader vertex(bwxGL_SHADER_TYPE::SHADER_VERTEX, ID_VERTEX_SHADER);
+        bwxGLShader fragment(bwxGL_SHADER_TYPE::SHADER_FRAGMENT, ID_FRAGMENT_SHADER);
+        m_program = std::make_unique<bwxGLShaderProgram>();
+        m_program->AttachShader(vertex);
+        m_program->AttachShader(fragment);
+        if (!m_program->Link()) {
+            m_program.reset();
+            return false;
+        }
+
+        glGenRenderbuffers(1, &m_colorTarget);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_colorTarget);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, 1, 1);
+        glGenRenderbuffers(1, &m_depthTarget);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_depthTarget);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 1, 1);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGenFramebuffers(1, &m_framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorTarget);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthTarget);
+        const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Picker: ID framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+            Release();
+            return false;
+        }
+
+        for (Readback& readback : m_readbacks) {
+            glGenBuffers(1, &readback.pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        return true;
+    }
+
+    void bwxGLPicker::Release() {
+        for (Readback& readback : m_readbacks) {
+            if (readback.fence) glDeleteSync(readback.fence);
+            if (readback.pbo) glDeleteBuffers(1, &readback.pbo);
+            readback = Readback();
+        }
+        m_inFlight = 0;
+        m_requested = false;
+        m_callback = nullptr;
+
+        if (m_framebuffer) glDeleteFramebuffers(1, &m_framebuffer);
+        if (m_colorTarget) glDeleteRenderbuffers(1, &m_colorTarget);
+        if (m_depthTarget) glDeleteRenderbuffers(1, &m_depthTarget);
+        m_framebuffer = 0;
+        m_colorTarget = 0;
+        m_depthTarget = 0;
+        m_program.reset();
+    }
+
+} // namespace bwx_sdk
@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_pool_allocator.cpp
+// Purpose:     BWX_SDK Library; OpenGL Fixed-size block pools for nodes and components
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_pool_allocator.h>
+
+namespace bwx_sdk {
+
+    bwxGLSlabPool::bwxGLSlabPool(size_t blockSize, size_t alignment)
+        : m_blockSize(std::max((blockSize + alignment - 1) / alignment * alignment, sizeof(FreeBlock))),
+          m_alignment(std::max(alignment, alignof(FreeBlock))),
+          m_chunkBlocks(std::max<size_t>(1, bwxGL_POOL_CHUNK_SIZE / m_blockSize)) {}
+
+    std::mutex& bwxGLSlabPool::GetPoolsMutex() {
+        static std::mutex* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    std::vector<bwxGLSlabPool*>& bwxGLSlabPool::GetPools() {
+        static std::vector<bwxGLSlabPool*>* pools = new std::vector<bwxGLSlabPool*>();
+        return *pools;
+    }
+
+    void* bwxGLSlabPool::Allocate() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_free) {
+            FreeBlock* block = m_free;
+            m_free = block->next;
+            ++m_live;
+            return block;
+        }
+
+        if (m_bump == m_bumpEnd) {
+            // Rounded up to the alignment, every block of the chunk is aligned too
+            void* chunk = ::operator new(m_chunkBlocks * m_blockSize, std::align_val_t(m_alignment));
+            m_chunks.push_back(chunk);
+            m_bump = static_cast<unsigned char*>(chunk);
+            m_bumpEnd = m_bump + m_chunkBlocks * m_blockSize;
+        }
+
+        void* block = m_bump;
+        m_bump += m_blockSize;
+        ++m_live;
+        return block;
+    }
+
+    void bwxGLSlabPool::Deallocate(void* block) noexcept {
+        if (!block) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->next = m_free;
+        m_free = freed;
+        --m_live;
+    }
+
+    size_t bwxGLSlabPool::ReleaseUnused() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_live > 0 || m_chunks.empty()) return 0;
+
+        for (void* chunk : m_chunks) ::operator delete(chunk, std::align_val_t(m_alignment));
+        const size_t bytes = m_chunks.size() * m_chunkBlocks * m_blockSize;
+        m_chunks.clear();
+        m_free = nullptr;
+        m_bump = nullptr;
+        m_bumpEnd = nullptr;
+        return bytes;
+    }
+
+    size_t bwxGLSlabPool::ReleaseAllUnused() {
+        std::lock_guard<std::mutex> lock(GetPoolsMutex());
+        size_t bytes = 0;
+        for (bwxGLSlabPool* pool : GetPools()) bytes += pool->ReleaseUnused();
+        return bytes;
+    }
+
+    size_t bwxGLSlabPool::GetLiveCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_live;
+    }
+
+    size_t bwxGLSlabPool::GetCapacity() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_chunks.size() * m_chunkBlocks;
+    }
+
+} // namespace bwx_sdk
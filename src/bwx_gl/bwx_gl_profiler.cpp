@@ -0,0 +1,165 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_profiler.cpp
+// Purpose:     BWX_SDK Library; OpenGL CPU/GPU frame profiler
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <iomanip>
+#include <sstream>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        constexpr size_t QUERY_CHUNK = 32;  // Timestamp queries generated at once
+    }
+
+    std::string bwxGLProfileReport::ToString() const {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "Frame " << frame << ": " << counters.drawCalls << " draws, " << counters.stateChanges
+            << " state changes, " << counters.uploadedBytes << " bytes uploaded\n";
+
+        for (const bwxGLProfileEntry& entry : entries) {
+            out << std::string(entry.depth * 2, ' ') << entry.name << "  cpu " << entry.cpuMs << " ms";
+            if (entry.gpuMs >= 0.0) out << "  gpu " << entry.gpuMs << " ms";
+            out << '\n';
+        }
+        return out.str();
+    }
+
+    bwxGLProfiler& bwxGLProfiler::GetInstance() {
+        static bwxGLProfiler instance;
+        return instance;
+    }
+
+    bool bwxGLProfiler::IsGPUTimingSupported() {
+        return GLEW_ARB_timer_query;
+    }
+
+    void bwxGLProfiler::SetEnabled(bool enabled) {
+        if (enabled == m_enabled) return;
+
+        if (!enabled) {
+            EndFrame();
+            ReleaseQueries();
+        }
+        m_enabled = enabled;
+    }
+
+    void bwxGLProfiler::BeginFrame() {
+        if (!m_enabled) return;
+        if (m_inFrame) EndFrame();
+
+        m_gpu = IsGPUTimingSupported();
+        m_current = (m_current + 1) % bwxGL_PROFILER_FRAME_LATENCY;
+
+        // Oldest first, so reports come out in frame order; the slot about to be reused cannot wait
+        for (size_t k = 0; k < bwxGL_PROFILER_FRAME_LATENCY; ++k) {
+            Frame& frame = m_frames[(m_current + k) % bwxGL_PROFILER_FRAME_LATENCY];
+            if (!frame.pending) continue;
+
+            if (IsAvailable(frame)) Resolve(frame, true);
+            else if (k == 0) Resolve(frame, false);
+            else break;
+        }
+
+        Frame& frame = m_frames[m_current];
+        frame.report.frame = m_frameIndex++;
+        frame.report.entries.clear();
+        frame.starts.clear();
+        frame.timed = m_gpu;
+
+        m_counters = bwxGLProfileCounters();
+        m_stack.clear();
+        m_inFrame = true;
+
+        BeginScope("Frame");
+    }
+
+    void bwxGLProfiler::EndFrame() {
+        if (!m_inFrame) return;
+
+        // Also closes the frame scope and anything left open
+        while (!m_stack.empty()) EndScope();
+
+        Frame& frame = m_frames[m_current];
+        frame.report.counters = m_counters;
+        frame.pending = true;
+        m_inFrame = false;
+
+        if (!frame.timed) Resolve(frame, false);
+    }
+
+    void bwxGLProfiler::BeginScope(const char* name) {
+        if (!m_inFrame) return;
+
+        Frame& frame = m_frames[m_current];
+        const size_t index = frame.report.entries.size();
+        const int32_t parent = m_stack.empty() ? -1 : m_stack.back();
+        frame.report.entries.push_back({ name, static_cast<uint32_t>(m_stack.size()), parent, 0.0, -1.0 });
+        frame.starts.push_back(Clock::now());
+
+        if (frame.timed) {
+            if (frame.queries.size() < (index + 1) * 2) {
+                const size_t old = frame.queries.size();
+                frame.queries.resize(old + QUERY_CHUNK * 2);
+                glGenQueries(static_cast<GLsizei>(QUERY_CHUNK * 2), frame.queries.data() + old);
+            }
+            glQueryCounter(frame.queries[index * 2], GL_TIMESTAMP);
+        }
+
+        m_stack.push_back(static_cast<int32_t>(index));
+    }
+
+    void bwxGLProfiler::EndScope() {
+        if (!m_inFrame || m_stack.empty()) return;
+
+        Frame& frame = m_frames[m_current];
+        const size_t index = static_cast<size_t>(m_stack.back());
+        m_stack.pop_back();
+
+        if (frame.timed) glQueryCounter(frame.queries[index * 2 + 1], GL_TIMESTAMP);
+        frame.report.entries[index].cpuMs = std::chrono::duration<double, std::milli>(Clock::now() - frame.starts[index]).count();
+    }
+
+    bool bwxGLProfiler::IsAvailable(const Frame& frame) const {
+        if (!frame.timed || frame.report.entries.empty()) return true;
+
+        // The frame scope ends last and queries complete in order
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(frame.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        return available == GL_TRUE;
+    }
+
+    void bwxGLProfiler::Resolve(Frame& frame, bool gpu) {
+        if (gpu && frame.timed) {
+            for (size_t i = 0; i < frame.report.entries.size(); ++i) {
+                GLuint64 begin = 0, end = 0;
+                glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+                frame.report.entries[i].gpuMs = end > begin ? static_cast<double>(end - begin) / 1.0e6 : 0.0;
+            }
+        }
+
+        frame.pending = false;
+        m_report = frame.report;
+    }
+
+    void bwxGLProfiler::ReleaseQueries() {
+        for (Frame& frame : m_frames) {
+            if (!frame.queries.empty()) glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+            frame.queries.clear();
+            frame.pending = false;
+        }
+    }
+
+} // namespace bwx_sdk
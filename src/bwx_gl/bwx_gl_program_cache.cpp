@@ -0,0 +1,198 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_program_cache.cpp
+// Purpose:     BWX_SDK Library; OpenGL On-disk shader program binary cache
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_program_cache.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_utils.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        const char CACHE_MAGIC[4] = { 'B', 'W', 'X', 'P' };
+
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t key;
+            uint32_t format;
+            uint32_t length;
+        };
+
+        uint64_t Mix(uint64_t hash, const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+            return hash;
+        }
+
+        uint64_t Mix(uint64_t hash, const std::string& value) {
+            // The terminator keeps "ab" + "c" apart from "a" + "bc"
+            return Mix(hash, value.c_str(), value.size() + 1);
+        }
+    }
+
+    bwxGLProgramBinaryCache& bwxGLProgramBinaryCache::GetInstance() {
+        static bwxGLProgramBinaryCache instance;
+        return instance;
+    }
+
+    bool bwxGLProgramBinaryCache::SetDirectory(const std::string& directory) {
+        m_directory.clear();
+        if (directory.empty()) return true;
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            std::cerr << "Program cache directory error: " << directory << " (" << error.message() << ")" << std::endl;
+            return false;
+        }
+
+        m_directory = directory;
+        return true;
+    }
+
+    bool bwxGLProgramBinaryCache::IsEnabled() const {
+        return !m_directory.empty() && IsSupported();
+    }
+
+    bool bwxGLProgramBinaryCache::IsSupported() {
+        if (!GLEW_ARB_get_program_binary) return false;
+
+        // Drivers may expose the extension with no binary formats at all
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }
+
+    uint64_t bwxGLProgramBinaryCache::GetDriverHash() const {
+        if (m_driverHash == 0) {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            hash = Mix(hash, bwxGLUtils::GetVendor());
+            hash = Mix(hash, bwxGLUtils::GetRenderer());
+            hash = Mix(hash, bwxGLUtils::GetVersion());
+            m_driverHash = hash ? hash : 1;
+        }
+        return m_driverHash;
+    }
+
+    uint64_t bwxGLProgramBinaryCache::GetKey(const std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& sources) const {
+        if (!IsEnabled()) return 0;
+
+        uint64_t hash = GetDriverHash();
+        const uint32_t version = bwxGL_PROGRAM_CACHE_VERSION;
+        hash = Mix(hash, &version, sizeof(version));
+        for (const auto& [type, source] : sources) {
+            const int32_t stage = static_cast<int32_t>(type);
+            hash = Mix(hash, &stage, sizeof(stage));
+            hash = Mix(hash, source);
+        }
+        return hash ? hash : 1;
+    }
+
+    std::string bwxGLProgramBinaryCache::GetPath(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(m_directory) / (std::string(name) + bwxGL_PROGRAM_CACHE_EXT)).string();
+    }
+
+    bool bwxGLProgramBinaryCache::Load(bwxGLShaderProgram& program, uint64_t key) {
+        if (key == 0 || m_directory.empty()) return false;
+
+        const std::string path = GetPath(key);
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            ++m_misses;
+            return false;
+        }
+
+        FileHeader header{};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        bool valid = in && std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+            header.version == bwxGL_PROGRAM_CACHE_VERSION && header.key == key && header.length > 0;
+
+        std::vector<unsigned char> data;
+        if (valid) {
+            data.resize(header.length);
+            in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            valid = static_cast<bool>(in);
+        }
+        in.close();
+
+        if (valid && program.LoadBinary(static_cast<GLenum>(header.format), data.data(), static_cast<GLsizei>(data.size()))) {
+            ++m_hits;
+            return true;
+        }
+
+        // Stale or damaged - the next compile writes a fresh one
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        ++m_misses;
+        return false;
+    }
+
+    bool bwxGLProgramBinaryCache::Store(const bwxGLShaderProgram& program, uint64_t key) const {
+        if (key == 0 || m_directory.empty()) return false;
+
+        GLenum format = 0;
+        std::vector<unsigned char> data;
+        if (!program.GetBinary(format, data)) return false;
+
+        FileHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = bwxGL_PROGRAM_CACHE_VERSION;
+        header.key = key;
+        header.format = static_cast<uint32_t>(format);
+        header.length = static_cast<uint32_t>(data.size());
+
+        // Written aside and renamed, so a crash never leaves a truncated binary behind
+        const std::string path = GetPath(key);
+        const std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!out) {
+                std::cerr << "Failed to write program cache: " << path << std::endl;
+                out.close();
+                std::error_code error;
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::cerr << "Failed to write program cache: " << path << " (" << error.message() << ")" << std::endl;
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+    void bwxGLProgramBinaryCache::Clear() {
+        if (m_directory.empty()) return;
+
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+            if (entry.path().extension() == bwxGL_PROGRAM_CACHE_EXT) std::filesystem::remove(entry.path(), error);
+        }
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+} // namespace bwx_sdk
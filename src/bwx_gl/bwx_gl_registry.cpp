@@ -0,0 +1,40 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_registry.cpp
+// Purpose:     BWX_SDK Library; Component registry with packed per-type storage (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <bwx_sdk/bwx_gl/bwx_gl_registry.h>
+
+namespace bwx_sdk {
+
+    bwxGLRegistry& bwxGLRegistry::GetInstance() {
+        // Never destroyed: nodes held by other statics may still unregister at exit
+        static bwxGLRegistry* instance = new bwxGLRegistry();
+        return *instance;
+    }
+
+    bwxGLEntity bwxGLRegistry::CreateEntity() {
+        if (!m_freeEntities.empty()) {
+            bwxGLEntity entity = m_freeEntities.back();
+            m_freeEntities.pop_back();
+            return entity;
+        }
+        return m_nextEntity++;
+    }
+
+    void bwxGLRegistry::DestroyEntity(bwxGLEntity entity) {
+        for (auto& pool : m_pools) {
+            if (pool) pool->Remove(entity);
+        }
+        m_freeEntities.push_back(entity);
+    }
+
+} // namespace bwx_sdk
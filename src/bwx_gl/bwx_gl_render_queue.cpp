@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_render_queue.cpp
+// Purpose:     BWX_SDK Library; OpenGL Render queue with sorted draw keys (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <cstring>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_material.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_render_queue.h>
+
+namespace bwx_sdk {
+
+    void bwxGLRenderQueue::Clear() {
+        m_items.clear();
+        m_opaque.clear();
+        m_transparent.clear();
+        m_opaqueBatches.clear();
+        m_transparentBatches.clear();
+        m_instanceData.clear();
+        m_programSlots.clear();
+        m_materialSlots.clear();
+        m_meshSlots.clear();
+    }
+
+    void bwxGLRenderQueue::Push(bwxGLRenderableComponent* renderable, GLuint program, const bwxGLMaterial* material,
+                                GLuint vao, const glm::mat4& model, float viewDepth, bool transparent, bool instanced,
+                                GLint materialIndex, bool sharedMaterial, GLint boneBase) {
+        // Shared items sort as one material, the shader picks theirs by index
+        const bwxGLMaterial* batchMaterial = sharedMaterial ? nullptr : material;
+
+        const uint64_t programSlot = GetSlot(m_programSlots, program);
+        // Managed materials keep their key between frames, so equal scenes sort the same way every frame
+        const uint64_t materialSlot = batchMaterial && batchMaterial->GetSortKey()
+            ? batchMaterial->GetSortKey()
+            : GetSlot(m_materialSlots, reinterpret_cast<uintptr_t>(batchMaterial));
+        const uint64_t meshSlot = GetSlot(m_meshSlots, vao);
+
+        SortEntry entry;
+        entry.index = static_cast<uint32_t>(m_items.size());
+
+        if (transparent) {
+            // Far objects first, state only as a tie-breaker
+            const uint64_t depth = 0xFFFFFF - QuantizeDepth(viewDepth, 24);
+            entry.key = (depth << 40) | ((programSlot & 0xFFF) << 28) | ((materialSlot & 0xFFFF) << 12) | (meshSlot & 0xFFF);
+            m_transparent.push_back(entry);
+        }
+        else if (m_opaqueFrontToBack) {
+            // Near objects first, state only as a tie-breaker
+            const uint64_t depth = QuantizeDepth(viewDepth, 20);
+            entry.key = (depth << 44) | ((programSlot & 0xFFF) << 32) | ((materialSlot & 0xFFFF) << 16) | (meshSlot & 0xFFFF);
+            m_opaque.push_back(entry);
+        }
+        else {
+            // State first, near objects first inside a bucket (early-z)
+            const uint64_t depth = QuantizeDepth(viewDepth, 20);
+            entry.key = ((programSlot & 0xFFF) << 52) | ((materialSlot & 0xFFFF) << 36) | ((meshSlot & 0xFFFF) << 20) | depth;
+            m_opaque.push_back(entry);
+        }
+
+        m_items.push_back({ renderable, program, material, vao, model, instanced, materialIndex, sharedMaterial, boneBase });
+    }
+
+    void bwxGLRenderQueue::Sort() {
+        RadixSort(m_opaque, m_scratch);
+        RadixSort(m_transparent, m_scratch);
+    }
+
+    void bwxGLRenderQueue::BuildBatches() {
+        m_opaqueBatches.clear();
+        m_transparentBatches.clear();
+        m_instanceData.clear();
+
+        BuildBatches(m_opaque, m_opaqueBatches);
+        BuildBatches(m_transparent, m_transparentBatches);
+    }
+
+    void bwxGLRenderQueue::BuildBatches(const std::vector<SortEntry>& entries, std::vector<bwxGLDrawBatch>& batches) {
+        const uint32_t count = static_cast<uint32_t>(entries.size());
+
+        for (uint32_t first = 0; first < count;) {
+            const bwxGLDrawItem& head = m_items[entries[first].index];
+
+            // Sorting already placed equal state next to each other (for transparent ones only
+            // when they are also adjacent in depth, so the back-to-front order is kept)
+            uint32_t last = first + 1;
+            while (last < count) {
+                const bwxGLDrawItem& item = m_items[entries[last].index];
+                const bool sameMaterial = item.sharedMaterial ? head.sharedMaterial : !head.sharedMaterial && item.material == head.material;
+                if (item.program != head.program || !sameMaterial || item.vao != head.vao ||
+                    item.instanced != head.instanced) break;
+                // One instanced draw has a single boneBase uniform
+                if (head.instanced && item.boneBase != head.boneBase) break;
+                ++last;
+            }
+
+            bwxGLDrawBatch batch;
+            batch.first = first;
+            batch.count = last - first;
+            batch.instanceOffset = -1;
+
+            if (head.instanced) {
+                batch.instanceOffset = static_cast<int32_t>(m_instanceData.size());
+                for (uint32_t i = first; i < last; ++i) {
+                    m_instanceData.push_back(m_items[entries[i].index].model);
+                }
+            }
+
+            batches.push_back(batch);
+            first = last;
+        }
+    }
+
+    uint32_t bwxGLRenderQueue::GetSlot(std::unordered_map<uintptr_t, uint32_t>& slots, uintptr_t value) {
+        auto it = slots.find(value);
+        if (it != slots.end()) return it->second;
+
+        uint32_t slot = static_cast<uint32_t>(slots.size());
+        slots.emplace(value, slot);
+        return slot;
+    }
+
+    uint32_t bwxGLRenderQueue::QuantizeDepth(float viewDepth, int bits) {
+        if (!(viewDepth > 0.0f)) return 0;
+
+        // Bit pattern of a positive float grows monotonically with its value
+        uint32_t raw;
+        std::memcpy(&raw, &viewDepth, sizeof(raw));
+        return raw >> (32 - bits);
+    }
+
+    void bwxGLRenderQueue::RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch) {
+        const size_t count = entries.size();
+        if (count < 2) return;
+
+        scratch.resize(count);
+
+        for (int shift = 0; shift < 64; shift += 8) {
+            size_t histogram[256] = {};
+            for (const auto& e : entries) {
+                ++histogram[(e.key >> shift) & 0xFF];
+            }
+
+            // All keys share this byte - pass would not change the order
+            if (histogram[(entries[0].key >> shift) & 0xFF] == count) continue;
+
+            size_t offset = 0;
+            for (size_t& h : histogram) {
+                size_t c = h;
+                h = offset;
+                offset += c;
+            }
+
+            for (const auto& e : entries) {
+                scratch[histogram[(e.key >> shift) & 0xFF]++] = e;
+            }
+
+            entries.swap(scratch);
+        }
+    }
+
+} // namespace bwx_sdk
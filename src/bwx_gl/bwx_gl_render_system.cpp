@@ -13,20 +13,31 @@
 
 #include <algorithm>
 
+#include <bwx_sdk/bwx_core/bwx_log.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_render_system.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_renderable_component.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_camera_component.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_light_system.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_buffer_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_material.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_material_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader_generator.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_streamer.h>
 
 namespace bwx_sdk {
 
     void bwxGLRenderSystem::RegisterRenderable(std::shared_ptr<bwxGLRenderableComponent> renderable) {
+        if (renderable) m_registered.insert(renderable.get());
         m_renderables.push_back(renderable);
     }
 
     void bwxGLRenderSystem::UnregisterRenderable(std::shared_ptr<bwxGLRenderableComponent> renderable) {
         m_renderables.erase(std::remove(m_renderables.begin(), m_renderables.end(), renderable), m_renderables.end());
+        m_registered.erase(renderable.get());
     }
 
     void bwxGLRenderSystem::Clear() {
@@ -55,11 +66,9 @@ namespace bwx_sdk {
     void bwxGLRenderSystem::SetLightSystem(std::shared_ptr<bwxGLLightSystem> system) {
         m_lightSystem = std::move(system);
 
-        // Przy pierwszym przypisaniu zainicjalizuj UBO
-        if (!m_lightUBO) {
-            auto& bufferManager = bwxGLBufferManager::GetInstance();
-            m_lightUBO = bufferManager.GetOrCreateUBO("LightsUBO", {});
-            glBindBufferBase(GL_UNIFORM_BUFFER, 2, m_lightUBO->GetID()); // binding 2
+        // UBO tworzony w Render() - tutaj moe nie by kontekstu GL (wtek renderujcy)
+        if (m_lightSystem) {
+            m_lightSystem->MarkAllDirty();
         }
     }
 
@@ -67,32 +76,697 @@ namespace bwx_sdk {
         return m_lightSystem;
     }
 
+    void bwxGLRenderSystem::UploadFrameUniforms(const glm::mat4& view, const glm::mat4& projection) {
+        if (!m_frameUBO) {
+            auto& bufferManager = bwxGLBufferManager::GetInstance();
+            m_frameUBO = bufferManager.GetOrCreateUBO("FrameUBO", {});
+            m_frameUBO->SetData(nullptr, sizeof(bwxGLFrameUniforms), GL_DYNAMIC_DRAW);
+        }
+
+        bwxGLFrameUniforms frame;
+        frame.view = view;
+        frame.projection = projection;
+        frame.viewProjection = projection * view;
+        frame.cameraPosition = glm::vec4(glm::vec3(glm::inverse(view)[3]), 1.0f);
+
+        // Raz na klatk dla wszystkich programw z blokiem FrameBlock
+        m_frameUBO->SetSubData(0, &frame, sizeof(frame));
+        bwxGLProfiler::GetInstance().AddUploadedBytes(sizeof(frame));
+        glBindBufferBase(GL_UNIFORM_BUFFER, bwxGL_FRAME_UBO_BINDING, m_frameUBO->GetID());
+    }
+
+    void bwxGLRenderSystem::UploadLights(const FrameSnapshot& frame) {
+        if (!frame.lightsChanged) return;
+
+        const auto& lights = frame.packedLights;
+        const size_t first = frame.lightsFirst;
+        const size_t end = std::min(first + frame.lightsCount, static_cast<size_t>(bwxGL_MAX_LIGHTS));
+        if (first >= end) return;
+
+        // Tylko zmienione wiata; slot za ostatnim zerowany (shader koczy ptl na power == 0)
+        const size_t packedEnd = std::min(end, lights.size());
+        if (first < packedEnd) {
+            m_lightUBO->SetSubData(first * sizeof(bwxGLPackedLight), &lights[first], (packedEnd - first) * sizeof(bwxGLPackedLight));
+            bwxGLProfiler::GetInstance().AddUploadedBytes((packedEnd - first) * sizeof(bwxGLPackedLight));
+        }
+        if (lights.size() < end) {
+            const bwxGLPackedLight terminator{};
+            m_lightUBO->SetSubData(lights.size() * sizeof(bwxGLPackedLight), &terminator, sizeof(bwxGLPackedLight));
+            bwxGLProfiler::GetInstance().AddUploadedBytes(sizeof(bwxGLPackedLight));
+        }
+    }
+
     void bwxGLRenderSystem::RenderAll() {
         if (!m_activeCamera) {
-            wxLogWarning("RenderSystem: No active camera set.");
+            BWX_LOG_LIMITED(BWX_LOGLEVEL_WARNING, 1, "RenderSystem: No active camera set.");
+            return;
+        }
+
+        Render(Extract());
+    }
+
+    void bwxGLRenderSystem::Record(bwxGLCommandBuffer& commands) {
+        if (!m_activeCamera) {
+            BWX_LOG_LIMITED(BWX_LOGLEVEL_WARNING, 1, "RenderSystem: No active camera set.");
             return;
         }
 
-        // Aktualizacja i przesanie danych wiate do UBO
-        if (m_lightSystem && m_lightUBO) {
+        // Migawka zostaje w m_frames do czasu odtworzenia - bwxGLRenderThread trzyma najwyej dwie klatki
+        FrameSnapshot* frame = &Extract();
+        commands.Record([this, frame] { Render(*frame); });
+    }
+
+    bwxGLRenderSystem::FrameSnapshot& bwxGLRenderSystem::Extract() {
+        FrameSnapshot& frame = m_frames[m_frameIndex];
+        m_frameIndex = (m_frameIndex + 1) % bwxGL_RENDER_THREAD_FRAMES;
+
+        frame.view = m_activeCamera->GetViewMatrix();
+        frame.projection = m_activeCamera->GetProjectionMatrix();
+        frame.nearPlane = m_activeCamera->GetNearPlane();
+        frame.farPlane = m_activeCamera->GetFarPlane();
+
+        // wiata pakowane tutaj, wysyane w Render() - kopia, bo scena zmienia si dalej
+        frame.lights = m_lightSystem != nullptr;
+        frame.lightsChanged = false;
+        if (m_lightSystem) {
             m_lightSystem->Update(0.0f); // TODO: przekaza deltaTime jeli potrzebne
-            const auto& lights = m_lightSystem->GetPackedLights();
+            frame.lightsChanged = m_lightSystem->GetDirtyRange(frame.lightsFirst, frame.lightsCount);
+            frame.packedLights = m_lightSystem->GetPackedLights();
+            m_lightSystem->ClearDirty();
+        }
+
+        // Odrzucanie obiektw poza bry widzenia - stan wiata (macierze, pudeka, koci) odczytany raz, tutaj
+        m_culledCount = 0;
+        frame.items.clear();
+        frame.bonePalette.Begin();
+
+        bwxGLFrustum frustum(frame.projection * frame.view);
+
+        // Kandydaci z drzewa BVH sceny (tylko zarejestrowane) albo wszystkie zarejestrowane obiekty
+        m_candidates.clear();
+        if (m_spatialIndex) {
+            m_spatialResults.clear();
+            m_spatialIndex->QueryFrustum(frustum, m_spatialResults);
+            for (void* item : m_spatialResults) {
+                auto* renderable = static_cast<bwxGLRenderableComponent*>(item);
+                if (m_registered.count(renderable)) m_candidates.push_back(renderable);
+            }
+            if (m_spatialUnbounded) {
+                for (bwxGLRenderableComponent* renderable : *m_spatialUnbounded) {
+                    if (m_registered.count(renderable)) m_candidates.push_back(renderable);
+                }
+            }
+            m_culledCount = m_registered.size() - m_candidates.size();
+        }
+        else {
+            for (const auto& renderable : m_renderables) {
+                if (renderable) m_candidates.push_back(renderable.get());
+            }
+        }
+
+        for (bwxGLRenderableComponent* renderable : m_candidates) {
+            if (!renderable->HasGeometry()) continue;
+
+            renderable->UpdateWorldState();
+
+            // BVH zwraca powikszone pudeka
+            if (!frustum.IsBoxVisible(renderable->GetWorldBounds())) {
+                ++m_culledCount;
+                continue;
+            }
+
+            // Macierze szkieletu kopiowane do palety klatki raz, nawet gdy dzieli go kilka siatek
+            const auto& skeleton = renderable->GetSkeleton();
+            const GLint boneBase = skeleton ? frame.bonePalette.Add(*skeleton) : -1;
+
+            frame.items.push_back({ renderable, renderable->GetWorldMatrix(), renderable->GetWorldBounds(), boneBase });
+        }
+
+        return frame;
+    }
+
+    void bwxGLRenderSystem::Render(FrameSnapshot& frame) {
+        bwxGL_PROFILE_SCOPE("RenderAll");
+
+        const glm::mat4& view = frame.view;
+        const glm::mat4& projection = frame.projection;
+
+        // Scena do celu o rozdzielczoci dobranej do czasu GPU - od tego miejsca GL_VIEWPORT jest ju przeskalowany
+        const bool scaled = m_dynamicResolution.Begin();
+
+        // Wyniki wskazywania z poprzednich klatek - tylko jeli GPU ju je ma
+        m_picker.Poll();
+
+        // Tekstury adowane asynchronicznie - porcja danych do PBO na klatk
+        auto& textureManager = bwxGLTextureManager::GetInstance();
+        if (textureManager.ProcessUploads() > 0) m_materialTableDirty = true;
+
+        // Zasoby zamwione przez wtki robocze (tryb wspbieny) - tworzone tutaj, w wtku GL
+        auto& materialManager = bwxGLMaterialManager::GetInstance();
+        if (materialManager.ProcessLoadRequests() > 0) m_materialTableDirty = true;
+        // Also catches CreateMaterial()/ReleaseMaterial() called directly since the last upload
+        if (materialManager.GetTableVersion() != m_materialTableVersion) m_materialTableDirty = true;
+        bwxGLBufferManager::GetInstance().ProcessLoadRequests();
+
+        // Parametry materiaw w jednym UBO - wysyane tylko po zmianie
+        materialManager.UploadMaterialBlocks();
+
+        // Tablica materiaw (SSBO) i tablice tekstur - jedno wizanie na klatk zamiast na materia
+        if (bwxGLMaterialManager::IsMaterialTableSupported()) {
+            if (m_materialTableDirty) {
+                materialManager.UploadMaterialTable();
+                m_materialTableVersion = materialManager.GetTableVersion();
+                m_materialTableDirty = false;
+            }
+            materialManager.BindMaterialTable();
+            textureManager.BindTextureArrays();
+        }
+
+        UploadFrameUniforms(view, projection);
+
+        // Przesanie danych wiate do UBO
+        if (frame.lights) {
+            bwxGL_PROFILE_SCOPE("Lights");
+
+            if (!m_lightUBO) {
+                auto& bufferManager = bwxGLBufferManager::GetInstance();
+                m_lightUBO = bufferManager.GetOrCreateUBO("LightsUBO", {});
+                // Peny rozmiar tablicy z shadera - pniej tylko glBufferSubData
+                m_lightUBO->SetData(nullptr, bwxGL_MAX_LIGHTS * sizeof(bwxGLPackedLight), GL_DYNAMIC_DRAW);
+            }
+
+            UploadLights(frame);
+            glBindBufferBase(GL_UNIFORM_BUFFER, bwxGL_LIGHTS_UBO_BINDING, m_lightUBO->GetID());
+
+            // Przypisanie wiate do klastrw widoku - shader czyta tylko wiata swojego klastra
+            if (m_clusteredLighting) {
+                GLint viewport[4];
+                glGetIntegerv(GL_VIEWPORT, viewport);
+
+                m_lightClusters.Build(frame.packedLights, view, projection, frame.nearPlane, frame.farPlane,
+                    glm::ivec4(viewport[0], viewport[1], viewport[2], viewport[3]));
+                m_lightClusters.Upload(frame.packedLights, frame.lightsChanged);
+                m_lightClusters.Bind();
+            }
+        }
+
+        BuildQueue(frame);
+
+        // Zapotrzebowanie na mipmapy zebrane w BuildQueue - usuwanie/przywracanie w ramach budetu VRAM
+        if (m_textureStreaming) bwxGLTextureStreamer::GetInstance().Update();
+
+        UploadInstanceData();
+        PrepareIndirectBuffers();
+
+        m_currentProgram = 0;
+        m_currentMaterial = nullptr;
+        m_currentVAO = 0;
+
+        // Przebieg wstpny: sama gbia, potem cieniowanie z GL_EQUAL - kady piksel owietlany raz
+        m_depthPrePassActive = false;
+        if (m_depthPrePass) {
+            bwxGL_PROFILE_SCOPE("DepthPrePass");
+            GLint depthFunc = GL_LESS;
+            glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+            m_depthFunc = static_cast<GLenum>(depthFunc);
+            m_currentDepthFunc = m_depthFunc;
+            m_depthPrePassActive = DrawDepthPrePass(m_renderQueue.GetOpaque(), m_renderQueue.GetOpaqueBatches());
+            m_currentProgram = 0;
+        }
+
+        // Nieprzezroczyste: posortowane wg stanu, od najbliszych
+        {
+            bwxGL_PROFILE_SCOPE("Opaque");
+            DrawQueue(m_renderQueue.GetOpaque(), m_renderQueue.GetOpaqueBatches(), view, projection);
+        }
+
+        if (m_depthPrePassActive) {
+            if (m_currentDepthFunc != m_depthFunc) glDepthFunc(m_depthFunc);
+            m_depthPrePassActive = false;
+        }
+
+        // Prostopadociany otaczajce testowane na gbi z nieprzezroczystych - wynik w nastpnej klatce
+        if (m_occlusionCulling && bwxGLOcclusionCuller::IsSupported()) {
+            bwxGL_PROFILE_SCOPE("Occlusion");
+            m_occlusion.IssueQueries(projection * view);
+            bwxGLProfiler::GetInstance().AddDrawCalls(m_occlusion.GetTestedCount());
+            m_currentProgram = 0;
+            m_currentVAO = 0;
+        }
+
+        // Niebo po nieprzezroczystych, na dalekiej paszczynie - zakryte piksele odrzuca early-Z
+        if (m_skyBox) {
+            if (m_currentMaterial) m_currentMaterial->Unbind();
+            m_skyBox->Render(view, projection);
+            m_currentProgram = 0;
+            m_currentMaterial = nullptr;
+            m_currentVAO = 0;
+        }
+
+        // Przezroczyste: od najdalszych, bez zapisu do bufora gbi
+        if (!m_renderQueue.GetTransparent().empty()) {
+            bwxGL_PROFILE_SCOPE("Transparent");
+            glDepthMask(GL_FALSE);
+            DrawQueue(m_renderQueue.GetTransparent(), m_renderQueue.GetTransparentBatches(), view, projection);
+            glDepthMask(GL_TRUE);
+        }
+
+        // Przebieg identyfikatorw do celu 1x1 tylko gdy zgoszono kliknicie - odczyt asynchroniczny przez PBO
+        if (m_picker.IsPickRequested()) {
+            bwxGL_PROFILE_SCOPE("Picking");
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            if (m_currentMaterial) m_currentMaterial->Unbind();
+            m_currentMaterial = nullptr;
+            // Wsprzdne kliknicia s w oknie - widok natywny, nie przeskalowany
+            m_picker.Render(m_renderQueue, projection * view,
+                scaled ? m_dynamicResolution.GetNativeViewport() : glm::ivec4(viewport[0], viewport[1], viewport[2], viewport[3]));
+        }
+
+        if (m_currentMaterial) m_currentMaterial->Unbind();
+        glBindVertexArray(0);
+        glUseProgram(0);
+
+        // Rozcignicie sceny na widok natywny
+        if (scaled) {
+            bwxGL_PROFILE_SCOPE("Upscale");
+            m_dynamicResolution.End();
+        }
+    }
+
+    void bwxGLRenderSystem::BuildQueue(FrameSnapshot& frame) {
+        bwxGL_PROFILE_SCOPE("BuildQueue");
+
+        m_renderQueue.Clear();
+
+        const glm::mat4& view = frame.view;
+        const glm::mat4& projection = frame.projection;
+
+        // Test zasonicia uywa wynikw z poprzednich klatek - bez czekania na GPU
+        const bool occlusion = m_occlusionCulling && bwxGLOcclusionCuller::IsSupported();
+        const glm::vec3 cameraPosition = glm::vec3(glm::inverse(view)[3]);
+        const float nearPlane = frame.nearPlane;
+        if (occlusion) m_occlusion.BeginFrame();
+
+        // Rozmiar na ekranie: rednica sfery otaczajcej / wysoko widoku; [1][1] = ctg(fov / 2)
+        const float projectionScale = projection[1][1];
+        const bool perspective = projection[2][3] != 0.0f;
+
+        // Streaming tekstur potrzebuje rozmiaru w pikselach
+        float viewportHeight = 0.0f;
+        if (m_textureStreaming) {
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            viewportHeight = static_cast<float>(viewport[3]);
+        }
+        auto& streamer = bwxGLTextureStreamer::GetInstance();
+
+        // Obiekty w bryle widzenia wybrane w Extract()
+        for (const FrameItem& item : frame.items) {
+            bwxGLRenderableComponent* renderable = item.renderable;
+
+            // Obiekty zasonite (liczone przez bwxGLOcclusionCuller)
+            if (occlusion && !m_occlusion.IsVisible(renderable, item.bounds, cameraPosition, nearPlane)) {
+                continue;
+            }
+
+            // Wybr poziomu szczegowoci przed pobraniem VAO - kady poziom ma wasn siatk
+            float screenSize = 0.0f;
+            if (renderable->GetLODChain() || m_textureStreaming) {
+                const float radius = glm::length(item.bounds.GetExtents());
+                screenSize = radius * projectionScale;
+                if (perspective) {
+                    const float distance = glm::length(glm::vec3(view * glm::vec4(item.bounds.GetCenter(), 1.0f)));
+                    screenSize = distance > radius ? screenSize / distance : 1.0f;
+                }
+            }
+            if (renderable->GetLODChain()) renderable->SelectLOD(screenSize);
+
+            GLuint vao = renderable->GetVAO();
+            if (!vao) continue;
 
-            if (!lights.empty()) {
-                m_lightUBO->Bind();
-                m_lightUBO->SetData(lights.data(), lights.size() * sizeof(bwxGLPackedLight), GL_DYNAMIC_DRAW);
-                glBindBufferBase(GL_UNIFORM_BUFFER, 2, m_lightUBO->GetID());
-                m_lightUBO->Unbind();
+            auto shader = renderable->GetShaderProgram();
+            auto material = renderable->GetMaterial();
+
+            // Uamek wysokoci widoku * wysoko w pikselach = lad tekstury na ekranie
+            if (m_textureStreaming && material) {
+                for (const auto& [type, path] : material->GetTextures()) streamer.Request(path, screenSize * viewportHeight);
+            }
+
+            float depth = -(view * item.model[3]).z; // Odlego od kamery w przestrzeni widoku
+
+            // Shader czyta materia z SSBO - materiay rezydentne trafiaj do wsplnych paczek
+            const bool materialTable = shader && shader->UsesMaterialTable() && material && material->GetTableIndex() >= 0;
+
+            m_renderQueue.Push(renderable,
+                shader ? shader->GetProgram() : 0,
+                material.get(),
+                vao,
+                item.model,
+                depth,
+                material && material->IsTransparent(),
+                renderable->IsInstanced(),
+                materialTable ? material->GetTableIndex() : -1,
+                materialTable && material->IsTableResident(),
+                item.boneBase);
+        }
+
+        frame.bonePalette.Upload();
+        m_renderQueue.Sort();
+        m_renderQueue.BuildBatches();
+    }
+
+    void bwxGLRenderSystem::UploadInstanceData() {
+        const auto& instances = m_renderQueue.GetInstanceData();
+        if (instances.empty()) return;
+
+        auto& bufferManager = bwxGLBufferManager::GetInstance();
+        GLsizeiptr size = static_cast<GLsizeiptr>(instances.size() * sizeof(glm::mat4));
+
+        // Region musi pomieci wszystkie instancje z jednej klatki
+        if (m_instanceVBO && m_instanceVBO->GetRegionSize() < size) {
+            bufferManager.ReleaseBuffer("RenderSystemInstances");
+            m_instanceVBO = nullptr;
+        }
+        if (!m_instanceVBO) {
+            m_instanceVBO = bufferManager.GetOrCreateRingBuffer("RenderSystemInstances", GL_ARRAY_BUFFER, size * 2);
+        }
+
+        // Jeden zapis na klatk prosto do zmapowanej pamici, bez realokacji
+        m_instanceVBO->Advance();
+        m_instanceBase = m_instanceVBO->Write(instances.data(), size, sizeof(glm::mat4));
+        bwxGLProfiler::GetInstance().AddUploadedBytes(static_cast<uint64_t>(size));
+    }
+
+    void bwxGLRenderSystem::BindInstanceAttributes(GLint firstInstance) {
+        // Atrybuty instancji s czci VAO siatki, przesunicie wskazuje pocztek paczki
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO->GetID());
+        for (GLuint i = 0; i < 4; ++i) {
+            GLuint location = bwxGL_INSTANCE_MATRIX_LOCATION + i;
+            size_t offset = static_cast<size_t>(m_instanceBase) + static_cast<size_t>(firstInstance) * sizeof(glm::mat4) + i * sizeof(glm::vec4);
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), reinterpret_cast<void*>(offset));
+            glVertexAttribDivisor(location, 1);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    bool bwxGLRenderSystem::IsMultiDrawIndirectSupported() {
+        return GLEW_ARB_multi_draw_indirect && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_shader_draw_parameters;
+    }
+
+    namespace {
+        GLsizeiptr GetStorageAlignment() {
+            static GLint alignment = 0;
+            if (alignment == 0) {
+                glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+                if (alignment <= 0) alignment = 256;
+            }
+            return alignment;
+        }
+    }
+
+    void bwxGLRenderSystem::PrepareIndirectBuffers() {
+        m_indirectDrawCount = 0;
+        m_indirectActive = false;
+
+        const size_t count = m_renderQueue.GetSize();
+        if (count == 0 || !IsMultiDrawIndirectSupported()) return;
+
+        auto& bufferManager = bwxGLBufferManager::GetInstance();
+
+        // Najgorszy przypadek: kady obiekt w osobnej paczce, kada paczka z wasnym wyrwnaniem
+        const GLsizeiptr commandBytes = static_cast<GLsizeiptr>(count * (sizeof(bwxGLDrawElementsIndirectCommand) + 4));
+        const GLsizeiptr dataBytes = static_cast<GLsizeiptr>(count) * (static_cast<GLsizeiptr>(sizeof(bwxGLDrawData)) + GetStorageAlignment());
+
+        if (m_indirectBuffer && m_indirectBuffer->GetRegionSize() < commandBytes) {
+            bufferManager.ReleaseBuffer("RenderSystemIndirect");
+            m_indirectBuffer = nullptr;
+        }
+        if (!m_indirectBuffer) {
+            m_indirectBuffer = bufferManager.GetOrCreateRingBuffer("RenderSystemIndirect", GL_DRAW_INDIRECT_BUFFER, commandBytes * 2);
+        }
+
+        if (m_drawDataSSBO && m_drawDataSSBO->GetRegionSize() < dataBytes) {
+            bufferManager.ReleaseBuffer("RenderSystemDrawData");
+            m_drawDataSSBO = nullptr;
+        }
+        if (!m_drawDataSSBO) {
+            m_drawDataSSBO = bufferManager.GetOrCreateRingBuffer("RenderSystemDrawData", GL_SHADER_STORAGE_BUFFER, dataBytes * 2);
+        }
+
+        m_indirectBuffer->Advance();
+        m_drawDataSSBO->Advance();
+        m_indirectActive = m_multiDrawIndirect;
+    }
+
+    bool bwxGLRenderSystem::DrawIndirect(const std::vector<bwxGLRenderQueue::SortEntry>& entries, const bwxGLDrawBatch& batch) {
+        if (!m_indirectActive) return false;
+
+        m_elementCommands.clear();
+        m_arrayCommands.clear();
+        m_drawData.clear();
+
+        // Paczka ma wsplne VAO; nowe polecenie zbiorcze tylko przy zmianie typu indeksw
+        bool runIndexed = false;
+        GLenum runType = 0;
+
+        for (uint32_t i = 0; i < batch.count; ++i) {
+            const bwxGLRenderQueue::SortEntry& entry = entries[batch.first + i];
+            const bwxGLDrawItem& drawItem = m_renderQueue.GetItem(entry);
+            const bwxGLMesh* mesh = drawItem.renderable->GetActiveMesh();
+            if (!mesh) continue;
+
+            const bool indexed = mesh->IsIndexed();
+            const GLenum indexType = indexed ? mesh->GetIndexType() : 0;
+            if (!m_drawData.empty() && (indexed != runIndexed || indexType != runType)) SubmitIndirect(runIndexed, runType);
+            runIndexed = indexed;
+            runType = indexType;
+
+            if (indexed) {
+                m_elementCommands.push_back({ static_cast<GLuint>(mesh->GetIndexCount()), 1, mesh->GetFirstIndex(),
+                    mesh->GetBaseVertex(), 0 });
             }
+            else {
+                m_arrayCommands.push_back({ static_cast<GLuint>(mesh->GetVertexCount()), 1,
+                    static_cast<GLuint>(mesh->GetBaseVertex()), 0 });
+            }
+            m_drawData.push_back({ drawItem.model, glm::uvec4(entry.index, std::max(drawItem.materialIndex, 0),
+                std::max(drawItem.boneBase, 0), 0) });
         }
 
-        glm::mat4 view = m_activeCamera->GetViewMatrix();
-        glm::mat4 projection = m_activeCamera->GetProjectionMatrix();
+        if (!m_drawData.empty()) SubmitIndirect(runIndexed, runType);
+        return true;
+    }
+
+    void bwxGLRenderSystem::SubmitIndirect(bool indexed, GLenum indexType) {
+        const GLsizei count = static_cast<GLsizei>(m_drawData.size());
+        const void* commands = indexed ? static_cast<const void*>(m_elementCommands.data()) : static_cast<const void*>(m_arrayCommands.data());
+        const GLsizeiptr commandBytes = indexed ? count * static_cast<GLsizeiptr>(sizeof(bwxGLDrawElementsIndirectCommand))
+            : count * static_cast<GLsizeiptr>(sizeof(bwxGLDrawArraysIndirectCommand));
+        const GLsizeiptr dataBytes = count * static_cast<GLsizeiptr>(sizeof(bwxGLDrawData));
 
-        for (const auto& renderable : m_renderables) {
-            if (!renderable) continue;
-            renderable->Render();
+        const GLintptr dataOffset = m_drawDataSSBO->Write(m_drawData.data(), dataBytes, GetStorageAlignment());
+        const GLintptr commandOffset = m_indirectBuffer->Write(commands, commandBytes, 4);
+
+        m_elementCommands.clear();
+        m_arrayCommands.clear();
+        m_drawData.clear();
+
+        if (dataOffset < 0 || commandOffset < 0) {
+            BWX_LOG_LIMITED(BWX_LOGLEVEL_WARNING, 1, "RenderSystem: Indirect buffers are full, %d draws skipped.", count);
+            return;
         }
+
+        // gl_DrawIDARB w shaderze wskazuje wpis w DrawDataBlock
+        m_drawDataSSBO->BindRange(GL_SHADER_STORAGE_BUFFER, bwxGL_DRAW_DATA_SSBO_BINDING, dataOffset, dataBytes);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer->GetID());
+
+        const void* offset = reinterpret_cast<const void*>(commandOffset);
+        if (indexed) glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, offset, count, 0);
+        else glMultiDrawArraysIndirect(GL_TRIANGLES, offset, count, 0);
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        m_indirectDrawCount += static_cast<size_t>(count);
+
+        auto& profiler = bwxGLProfiler::GetInstance();
+        profiler.AddDrawCalls();
+        profiler.AddUploadedBytes(static_cast<uint64_t>(dataBytes + commandBytes));
+    }
+
+    void bwxGLRenderSystem::BindDrawData(const glm::mat4& model, uint32_t index, GLint materialIndex, GLint boneBase) {
+        if (!m_drawDataSSBO) return;
+
+        // Pojedyncze wywoanie: gl_DrawIDARB == 0, wic wpis ley na pocztku zakresu
+        const bwxGLDrawData data{ model, glm::uvec4(index, std::max(materialIndex, 0), std::max(boneBase, 0), 0) };
+        const GLintptr offset = m_drawDataSSBO->Write(&data, sizeof(data), GetStorageAlignment());
+        if (offset >= 0) {
+            m_drawDataSSBO->BindRange(GL_SHADER_STORAGE_BUFFER, bwxGL_DRAW_DATA_SSBO_BINDING, offset, sizeof(data));
+            bwxGLProfiler::GetInstance().AddUploadedBytes(sizeof(data));
+        }
+    }
+
+    void bwxGLRenderSystem::DrawQueue(const std::vector<bwxGLRenderQueue::SortEntry>& entries, const std::vector<bwxGLDrawBatch>& batches,
+        const glm::mat4& view, const glm::mat4& projection) {
+        auto& profiler = bwxGLProfiler::GetInstance();
+        auto& materialManager = bwxGLMaterialManager::GetInstance();
+        for (const auto& batch : batches) {
+            const bwxGLDrawItem& item = m_renderQueue.GetItem(entries[batch.first]);
+            bwxGLShaderProgram* shader = item.renderable->GetShaderProgram().get();
+
+            if (item.program != m_currentProgram) {
+                glUseProgram(item.program);
+                m_currentProgram = item.program;
+                profiler.AddStateChanges();
+
+                if (shader) {
+                    // Programy bez bloku FrameBlock dostaj macierze jako zwyke uniformy
+                    if (!shader->HasFrameBlock()) {
+                        shader->SetUniform("view", view);
+                        shader->SetUniform("projection", projection);
+                    }
+                    if (m_clusteredLighting) m_lightClusters.ApplyToShader(*shader);
+                }
+
+                // Nowy program - uniformy materiau trzeba wysa ponownie
+                m_currentMaterial = nullptr;
+            }
+
+            // Materia wsplnej paczki jest w SSBO - nic do wizania
+            const bwxGLMaterial* material = item.sharedMaterial ? nullptr : item.material;
+            if (material != m_currentMaterial) {
+                if (m_currentMaterial) m_currentMaterial->Unbind();
+                if (material) {
+                    material->Bind();
+                    // Blok MaterialParams: zmiana materiau to jedno przesunicie zakresu UBO zamiast kilkunastu glUniform
+                    const bool block = shader && shader->HasMaterialParams() && materialManager.BindMaterialBlock(*material);
+                    if (shader && !block) material->ApplyToShader(*shader);
+                }
+                m_currentMaterial = material;
+                profiler.AddStateChanges();
+            }
+
+            if (item.vao != m_currentVAO) {
+                glBindVertexArray(item.vao);
+                m_currentVAO = item.vao;
+                profiler.AddStateChanges();
+            }
+
+            // Gbia z przebiegu wstpnego - tylko dokadnie te same piksele; pozostae programy jak zwykle
+            if (m_depthPrePassActive) {
+                const GLenum depthFunc = shader && shader->UsesDepthPrePass() ? GL_EQUAL : m_depthFunc;
+                if (depthFunc != m_currentDepthFunc) {
+                    glDepthFunc(depthFunc);
+                    m_currentDepthFunc = depthFunc;
+                    profiler.AddStateChanges();
+                }
+            }
+
+            if (batch.instanceOffset >= 0) {
+                BindInstanceAttributes(batch.instanceOffset);
+                if (shader && item.boneBase >= 0) shader->SetUniform(bwxGL_BONE_BASE_UNIFORM, item.boneBase);
+                item.renderable->DrawInstanced(static_cast<GLsizei>(batch.count));
+                profiler.AddDrawCalls();
+                continue;
+            }
+
+            // Caa paczka jednym glMultiDrawElementsIndirect
+            const bool indirect = shader && shader->IsIndirect();
+            if (indirect && DrawIndirect(entries, batch)) continue;
+
+            // cieka GL 3.3: kada siatka osobno
+            for (uint32_t i = 0; i < batch.count; ++i) {
+                const bwxGLRenderQueue::SortEntry& entry = entries[batch.first + i];
+                const bwxGLDrawItem& drawItem = m_renderQueue.GetItem(entry);
+                if (indirect) BindDrawData(drawItem.model, entry.index, drawItem.materialIndex, drawItem.boneBase);
+                else if (shader) {
+                    shader->SetUniform("model", drawItem.model);
+                    if (drawItem.boneBase >= 0) shader->SetUniform(bwxGL_BONE_BASE_UNIFORM, drawItem.boneBase);
+                }
+                drawItem.renderable->Draw();
+                profiler.AddDrawCalls();
+            }
+        }
+    }
+
+    bwxGLShaderProgram* bwxGLRenderSystem::GetDepthProgram(bool instanced, bool indirect, bool skinned) {
+        const int variant = (instanced ? 1 : 0) | (indirect ? 2 : 0) | (skinned ? 4 : 0);
+        if (m_depthPrograms[variant]) return m_depthPrograms[variant].get();
+        if (m_depthProgramFailed[variant]) return nullptr;
+
+        // Ten sam kod pozycji co w shaderach generatora - warunek poprawnoci GL_EQUAL
+        bwxGLShader vertex(bwxGL_SHADER_TYPE::SHADER_VERTEX, bwxGLShaderGenerator::GetDepthVertexShader(instanced, indirect, skinned));
+        bwxGLShader fragment(bwxGL_SHADER_TYPE::SHADER_FRAGMENT, bwxGLShaderGenerator::GetDepthFragmentShader());
+        auto program = std::make_unique<bwxGLShaderProgram>();
+        program->AttachShader(vertex);
+        program->AttachShader(fragment);
+        if (!program->Link()) {
+            wxLogWarning("RenderSystem: Cannot build depth pre-pass program (variant %d).", variant);
+            m_depthProgramFailed[variant] = true;
+            return nullptr;
+        }
+
+        m_depthPrograms[variant] = std::move(program);
+        return m_depthPrograms[variant].get();
+    }
+
+    bool bwxGLRenderSystem::DrawDepthPrePass(const std::vector<bwxGLRenderQueue::SortEntry>& entries, const std::vector<bwxGLDrawBatch>& batches) {
+        auto& profiler = bwxGLProfiler::GetInstance();
+
+        GLboolean colorMask[4];
+        glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+        bool drawn = false;
+        bwxGLShaderProgram* current = nullptr;
+        for (const auto& batch : batches) {
+            const bwxGLDrawItem& item = m_renderQueue.GetItem(entries[batch.first]);
+            bwxGLShaderProgram* shader = item.renderable->GetShaderProgram().get();
+            if (!shader || !shader->UsesDepthPrePass()) continue;
+
+            const bool instanced = batch.instanceOffset >= 0;
+            const bool indirect = !instanced && shader->IsIndirect();
+            bwxGLShaderProgram* depth = GetDepthProgram(instanced, indirect, item.boneBase >= 0);
+            if (!depth) continue;
+
+            if (depth != current) {
+                depth->Bind();
+                current = depth;
+                profiler.AddStateChanges();
+            }
+
+            if (item.vao != m_currentVAO) {
+                glBindVertexArray(item.vao);
+                m_currentVAO = item.vao;
+                profiler.AddStateChanges();
+            }
+            drawn = true;
+
+            if (instanced) {
+                BindInstanceAttributes(batch.instanceOffset);
+                if (item.boneBase >= 0) depth->SetUniform(bwxGL_BONE_BASE_UNIFORM, item.boneBase);
+                item.renderable->DrawInstanced(static_cast<GLsizei>(batch.count));
+                profiler.AddDrawCalls();
+                continue;
+            }
+
+            if (indirect && DrawIndirect(entries, batch)) continue;
+
+            for (uint32_t i = 0; i < batch.count; ++i) {
+                const bwxGLRenderQueue::SortEntry& entry = entries[batch.first + i];
+                const bwxGLDrawItem& drawItem = m_renderQueue.GetItem(entry);
+                if (indirect) BindDrawData(drawItem.model, entry.index, drawItem.materialIndex, drawItem.boneBase);
+                else {
+                    depth->SetUniform("model", drawItem.model);
+                    if (drawItem.boneBase >= 0) depth->SetUniform(bwxGL_BONE_BASE_UNIFORM, drawItem.boneBase);
+                }
+                drawItem.renderable->Draw();
+                profiler.AddDrawCalls();
+            }
+        }
+
+        glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
+        return drawn;
     }
 
 } // namespace bwx_sdk
\ No newline at end of file
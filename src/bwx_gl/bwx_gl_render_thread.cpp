@@ -0,0 +1,208 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_render_thread.cpp
+// Purpose:     BWX_SDK Library; OpenGL Render thread replaying recorded frames
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <chrono>
+#include <exception>
+
+#include <bwx_sdk/bwx_core/bwx_log.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_render_thread.h>
+
+namespace bwx_sdk {
+
+    bwxGLRenderThread::bwxGLRenderThread() = default;
+
+    bwxGLRenderThread::~bwxGLRenderThread() {
+        Stop();
+    }
+
+    bool bwxGLRenderThread::Start(wxGLCanvas* canvas, wxGLContext* context) {
+        if (IsRunning() || !canvas || !context) return false;
+
+        m_canvas = canvas;
+        m_context = context;
+        m_stopping = false;
+        m_started = false;
+        m_thread = std::thread(&bwxGLRenderThread::ThreadLoop, this);
+
+        bool ok = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_started; });
+            ok = m_startOK;
+        }
+
+        if (!ok) m_thread.join();
+        return ok;
+    }
+
+    void bwxGLRenderThread::Stop() {
+        if (!IsRunning()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+
+        // A frame begun but never ended is dropped
+        if (m_inFrame) {
+            m_buffers[m_recording].Reset();
+            m_inFrame = false;
+        }
+    }
+
+    bwxGLCommandBuffer& bwxGLRenderThread::BeginFrame() {
+        bwxGLCommandBuffer& buffer = m_buffers[m_recording];
+        if (m_inFrame) return buffer;
+
+        // The frame before the previous one replayed from this buffer
+        WaitFor(m_bufferSequence[m_recording]);
+        m_inFrame = true;
+        return buffer;
+    }
+
+    void bwxGLRenderThread::EndFrame(bool present) {
+        if (!m_inFrame) return;
+        m_inFrame = false;
+
+        bwxGLCommandBuffer& buffer = m_buffers[m_recording];
+        ++m_submittedFrames;
+
+        // Not started: replayed here, with the context current on the calling thread
+        if (!IsRunning()) {
+            buffer.Execute();
+            buffer.Reset();
+            m_completedFrames.fetch_add(1, std::memory_order_release);
+            return;
+        }
+
+        Item item;
+        item.frame = &buffer;
+        item.present = present;
+        m_bufferSequence[m_recording] = Enqueue(std::move(item));
+        m_recording = (m_recording + 1) % bwxGL_RENDER_THREAD_FRAMES;
+    }
+
+    void bwxGLRenderThread::Post(std::function<void()> task) {
+        if (!task) return;
+        if (!IsRunning()) {
+            task();
+            return;
+        }
+
+        Item item;
+        item.task = std::move(task);
+        Enqueue(std::move(item));
+    }
+
+    void bwxGLRenderThread::Invoke(const std::function<void()>& task) {
+        if (!task) return;
+        if (!IsRunning() || IsRenderThread()) {
+            task();
+            return;
+        }
+
+        Item item;
+        item.task = task;
+        WaitFor(Enqueue(std::move(item)));
+    }
+
+    void bwxGLRenderThread::Flush() {
+        uint64_t last = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            last = m_enqueued;
+        }
+        WaitFor(last);
+    }
+
+    bool bwxGLRenderThread::IsRenderThread() const {
+        return m_thread.get_id() == std::this_thread::get_id();
+    }
+
+    uint64_t bwxGLRenderThread::Enqueue(Item item) {
+        uint64_t sequence = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            sequence = item.sequence = ++m_enqueued;
+            m_queue.push_back(std::move(item));
+        }
+        m_wake.notify_one();
+        return sequence;
+    }
+
+    void bwxGLRenderThread::WaitFor(uint64_t sequence) {
+        if (!IsRunning() || IsRenderThread()) return;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this, sequence] { return m_executed >= sequence; });
+    }
+
+    void bwxGLRenderThread::ThreadLoop() {
+        const bool ok = m_canvas->SetCurrent(*m_context);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_started = true;
+            m_startOK = ok;
+        }
+        m_done.notify_all();
+
+        if (!ok) {
+            BWX_LOG_ERROR("bwxGLRenderThread: cannot make the context current on the render thread");
+            return;
+        }
+
+        while (true) {
+            Item item;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) break;  // Stopping, and everything submitted has run
+
+                item = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            try {
+                if (item.frame) {
+                    const auto start = std::chrono::steady_clock::now();
+                    item.frame->Execute();
+                    if (item.present) m_canvas->SwapBuffers();
+                    m_lastReplayMs.store(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                        std::memory_order_relaxed);
+                }
+                else {
+                    item.task();
+                }
+            }
+            catch (const std::exception& e) {
+                BWX_LOG_ERROR("bwxGLRenderThread: %s", e.what());
+            }
+
+            // Captures are released here, before the recording thread may reuse the buffer
+            if (item.frame) {
+                item.frame->Reset();
+                m_completedFrames.fetch_add(1, std::memory_order_release);
+            }
+            item.task = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_executed = item.sequence;
+            }
+            m_done.notify_all();
+        }
+    }
+
+} // namespace bwx_sdk
@@ -8,9 +8,62 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include <bwx_sdk/bwx_gl/bwx_gl_renderable_component.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_transform_component.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_node.h>
 
 namespace bwx_sdk {
 
+    GLuint bwxGLRenderableComponent::GetVAO() const {
+        if (bwxGLMesh* mesh = GetActiveMesh()) return mesh->GetVAO();
+        return m_buffer ? m_buffer->GetVAO() : 0;
+    }
+
+    void bwxGLRenderableComponent::SetLODChain(std::shared_ptr<bwxGLLODChain> chain) {
+        m_lodChain = std::move(chain);
+        m_lodLevel = 0;
+
+        if (!m_mesh && m_lodChain && m_lodChain->GetLevelCount() > 0) SetMesh(m_lodChain->GetLevel(0).mesh);
+    }
+
+    void bwxGLRenderableComponent::SelectLOD(float screenSize) {
+        if (m_lodChain) m_lodLevel = m_lodChain->Select(screenSize, m_lodLevel);
+    }
+
+    bwxGLMesh* bwxGLRenderableComponent::GetActiveMesh() const {
+        if (m_lodChain && m_lodLevel < m_lodChain->GetLevelCount()) {
+            if (bwxGLMesh* lod = m_lodChain->GetLevel(m_lodLevel).mesh.get()) return lod;
+        }
+        return m_mesh.get();
+    }
+
+    glm::mat4 bwxGLRenderableComponent::GetModelMatrix() const {
+        auto node = GetNode();
+        auto transform = node ? node->GetComponent<bwxGLTransformComponent>() : nullptr;
+        return transform ? transform->GetWorldMatrix() : glm::mat4(1.0f);
+    }
+
+    void bwxGLRenderableComponent::UpdateWorldState() {
+        auto node = GetNode();
+        auto transform = node ? node->GetComponent<bwxGLTransformComponent>() : nullptr;
+
+        m_worldMatrix = transform ? transform->GetWorldMatrix() : glm::mat4(1.0f);
+        unsigned int version = transform ? transform->GetWorldVersion() : 0;
+
+        if (m_worldBoundsDirty || version != m_worldBoundsVersion) {
+            m_worldBounds = m_mesh ? m_mesh->GetBounds().Transform(m_worldMatrix) : bwxGLBoundingBox();
+            m_worldBoundsVersion = version;
+            m_worldBoundsDirty = false;
+        }
+    }
+
+    void bwxGLRenderableComponent::Draw() const {
+        if (bwxGLMesh* mesh = GetActiveMesh()) mesh->Draw();
+    }
+
+    void bwxGLRenderableComponent::DrawInstanced(GLsizei instances) const {
+        if (bwxGLMesh* mesh = GetActiveMesh()) mesh->DrawInstanced(instances);
+    }
+
     void bwxGLRenderableComponent::Render() {
         if (m_material && m_buffer) {
             m_material->Bind();
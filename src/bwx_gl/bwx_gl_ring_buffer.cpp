@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_ring_buffer.cpp
+// Purpose:     BWX_SDK Library; OpenGL Persistent-mapped ring buffer
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <cstring>
+#include <iostream>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_ring_buffer.h>
+
+namespace bwx_sdk {
+
+    bwxGLRingBuffer::bwxGLRingBuffer(GLenum target, GLsizeiptr regionSize, GLuint regions) : bwxGLBuffer(target) {
+        Init(regionSize, regions);
+    }
+
+    bwxGLRingBuffer::bwxGLRingBuffer(GLenum target, GLsizeiptr regionSize, GLsizei stride, const std::vector<GLint>& layout, GLuint regions)
+        : bwxGLBuffer(target) {
+        glGenVertexArrays(1, &m_vaoID);
+        glBindVertexArray(m_vaoID);
+
+        Init(regionSize, regions);
+
+        Bind();
+        SetupLayout(stride, layout);
+
+        glBindVertexArray(0);
+        Unbind();
+    }
+
+    bwxGLRingBuffer::~bwxGLRingBuffer() {
+        Release();
+    }
+
+    void bwxGLRingBuffer::Init(GLsizeiptr regionSize, GLuint regions) {
+        // Regions start on a 256-byte boundary, which satisfies any UBO offset alignment
+        m_regionSize = (regionSize + 255) & ~static_cast<GLsizeiptr>(255);
+        m_regionCount = regions > 0 ? regions : 1;
+        m_region = 0;
+        m_head = 0;
+        m_fences.assign(m_regionCount, nullptr);
+
+        const GLsizeiptr totalSize = m_regionSize * m_regionCount;
+
+        Bind();
+        if (GLEW_ARB_buffer_storage) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(m_target, totalSize, nullptr, flags);
+            m_mapped = static_cast<unsigned char*>(glMapBufferRange(m_target, 0, totalSize, flags));
+            m_persistent = m_mapped != nullptr;
+        }
+
+        if (!m_persistent) {
+            std::cerr << "Warning: Persistent mapping unavailable, ring buffer uses glBufferSubData." << std::endl;
+            glBufferData(m_target, totalSize, nullptr, GL_STREAM_DRAW);
+            m_staging.resize(static_cast<size_t>(totalSize));
+        }
+        SetStorageSize(totalSize);
+        Unbind();
+    }
+
+    void bwxGLRingBuffer::Release() {
+        if (m_mapped && m_bufferID) {
+            Bind();
+            glUnmapBuffer(m_target);
+            Unbind();
+        }
+        m_mapped = nullptr;
+        m_persistent = false;
+
+        for (auto& fence : m_fences) {
+            if (fence) glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        m_staging.clear();
+
+        bwxGLBuffer::Release();
+    }
+
+    void* bwxGLRingBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset) {
+        if (size > m_regionSize) {
+            std::cerr << "Error: Ring buffer allocation of " << size << " bytes exceeds region size " << m_regionSize << std::endl;
+            return nullptr;
+        }
+
+        if (alignment < 1) alignment = 1;
+        GLsizeiptr start = (m_head + alignment - 1) / alignment * alignment;
+
+        // Region full - move on, fences keep data still in flight safe
+        if (start + size > m_regionSize) {
+            Advance();
+            start = 0;
+        }
+
+        offset = static_cast<GLintptr>(m_region * m_regionSize + start);
+        m_head = start + size;
+
+        unsigned char* base = m_persistent ? m_mapped : m_staging.data();
+        return base + offset;
+    }
+
+    void bwxGLRingBuffer::Commit(GLintptr offset, GLsizeiptr size) {
+        if (m_persistent) return; // Coherent mapping, nothing to flush
+
+        Bind();
+        glBufferSubData(m_target, offset, size, m_staging.data() + offset);
+        Unbind();
+    }
+
+    GLintptr bwxGLRingBuffer::Write(const void* data, GLsizeiptr size, GLsizeiptr alignment) {
+        GLintptr offset = 0;
+        void* dst = Allocate(size, alignment, offset);
+        if (!dst) return -1;
+
+        std::memcpy(dst, data, static_cast<size_t>(size));
+        Commit(offset, size);
+        return offset;
+    }
+
+    void bwxGLRingBuffer::BindRange(GLenum target, GLuint index, GLintptr offset, GLsizeiptr size) const {
+        glBindBufferRange(target, index, m_bufferID, offset, size);
+    }
+
+    void bwxGLRingBuffer::Advance() {
+        if (m_persistent) {
+            if (m_fences[m_region]) glDeleteSync(m_fences[m_region]);
+            m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        m_region = (m_region + 1) % m_regionCount;
+        m_head = 0;
+
+        WaitForRegion(m_region);
+    }
+
+    void bwxGLRingBuffer::WaitForRegion(GLuint region) {
+        GLsync fence = m_fences[region];
+        if (!fence) return;
+
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        }
+
+        glDeleteSync(fence);
+        m_fences[region] = nullptr;
+    }
+
+    GLsizeiptr bwxGLRingBuffer::GetUniformAlignment() {
+        static GLint alignment = 0;
+        if (alignment == 0) {
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            if (alignment <= 0) alignment = 256;
+        }
+        return alignment;
+    }
+
+} // namespace bwx_sdk
@@ -11,6 +11,7 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -18,8 +19,11 @@
 //#include <bwx_sdk/bwx_gl/bwx_gl_camera.h>
 //#include <bwx_sdk/bwx_gl/bwx_gl_light.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_mesh.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_renderable_component.h>
 
 #include <bwx_sdk/bwx_gl/bwx_gl_scene.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_transform_system.h>
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
 
 namespace bwx_sdk {
 
@@ -29,6 +33,12 @@ namespace bwx_sdk {
         //m_cameras.clear();
 		//m_lights.clear();
         m_meshes.clear();
+
+        // Nodes and components went back to their pools one by one; pools left without live blocks
+        // (no other scene uses them) give their chunks back in one go
+        m_proxies.clear();
+        m_root.reset();
+        bwxGLSlabPool::ReleaseAllUnused();
     }
 
     //void bwxGLScene::AddCamera(std::shared_ptr<bwxGLCamera> camera) {
@@ -79,4 +89,184 @@ namespace bwx_sdk {
 	//	return m_lights;
 	//}
 
+    void bwxGLScene::Update(float deltaTime, bool parallel) {
+        if (!m_root) return;
+
+        // Control components drive movement, so they run first and on this thread
+        UpdateMainThread(m_root, deltaTime);
+        UpdateSubtree(m_root, deltaTime, parallel);
+
+        // Velocities of all movement components in one batch, after anything that set them
+        m_movementSystem.Update(m_root, deltaTime);
+
+        // World matrices once all local transforms of this frame are final
+        bwxGLTransformSystem::GetInstance().Update(m_root);
+
+        if (m_spatialIndexing) UpdateSpatialIndex();
+    }
+
+    void bwxGLScene::SetSpatialIndexing(bool enable) {
+        m_spatialIndexing = enable;
+        if (!enable) {
+            m_bvh.Clear();
+            m_proxies.clear();
+            m_unbounded.clear();
+        }
+    }
+
+    void bwxGLScene::UpdateSpatialIndex() {
+        ++m_indexPass;
+        m_unbounded.clear();
+        if (m_root) IndexSubtree(m_root);
+
+        // Renderables not reached this time were removed from the scene (or lost their mesh)
+        for (auto it = m_proxies.begin(); it != m_proxies.end();) {
+            if (it->second.pass != m_indexPass) {
+                m_bvh.Remove(it->second.proxy);
+                it = m_proxies.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    void bwxGLScene::IndexSubtree(const std::shared_ptr<bwxGLNode>& node) {
+        if (auto* renderable = node->GetComponentPtr<bwxGLRenderableComponent>()) {
+            renderable->UpdateWorldState();
+            const bwxGLBoundingBox& bounds = renderable->GetWorldBounds();
+
+            if (bounds.IsValid()) {
+                auto it = m_proxies.find(renderable);
+                if (it == m_proxies.end()) {
+                    m_proxies.emplace(renderable, SpatialProxy{ m_bvh.Insert(bounds, renderable), m_indexPass });
+                }
+                else {
+                    m_bvh.Move(it->second.proxy, bounds);
+                    it->second.pass = m_indexPass;
+                }
+            }
+            else {
+                // Not placeable in the tree; a proxy from earlier bounds goes with the stale ones
+                m_unbounded.push_back(renderable);
+            }
+        }
+
+        for (const auto& child : node->GetChildren()) {
+            IndexSubtree(child);
+        }
+    }
+
+    void bwxGLScene::ToRenderables(const std::vector<void*>& items, std::vector<bwxGLRenderableComponent*>& out) {
+        out.reserve(out.size() + items.size());
+        for (void* item : items) {
+            out.push_back(static_cast<bwxGLRenderableComponent*>(item));
+        }
+    }
+
+    void bwxGLScene::QueryFrustum(const bwxGLFrustum& frustum, std::vector<bwxGLRenderableComponent*>& out) const {
+        std::vector<void*> items;
+        m_bvh.QueryFrustum(frustum, items);
+        ToRenderables(items, out);
+    }
+
+    void bwxGLScene::QueryBox(const bwxGLBoundingBox& box, std::vector<bwxGLRenderableComponent*>& out) const {
+        std::vector<void*> items;
+        m_bvh.QueryBox(box, items);
+
+        // The tree holds fat boxes - keep only the real overlaps
+        for (void* item : items) {
+            auto* renderable = static_cast<bwxGLRenderableComponent*>(item);
+            const bwxGLBoundingBox& bounds = renderable->GetWorldBounds();
+            if (bounds.min.x <= box.max.x && bounds.max.x >= box.min.x &&
+                bounds.min.y <= box.max.y && bounds.max.y >= box.min.y &&
+                bounds.min.z <= box.max.z && bounds.max.z >= box.min.z) {
+                out.push_back(renderable);
+            }
+        }
+    }
+
+    void bwxGLScene::QuerySphere(const glm::vec3& center, float radius, std::vector<bwxGLRenderableComponent*>& out) const {
+        std::vector<void*> items;
+        m_bvh.QuerySphere(center, radius, items);
+
+        for (void* item : items) {
+            auto* renderable = static_cast<bwxGLRenderableComponent*>(item);
+            const bwxGLBoundingBox& bounds = renderable->GetWorldBounds();
+            const glm::vec3 closest = glm::clamp(center, bounds.min, bounds.max);
+            const glm::vec3 offset = closest - center;
+            if (glm::dot(offset, offset) <= radius * radius) out.push_back(renderable);
+        }
+    }
+
+    bwxGLRenderableComponent* bwxGLScene::Pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float* distance) const {
+        std::vector<std::pair<void*, float>> hits;
+        m_bvh.QueryRay(origin, direction, maxDistance, hits);
+
+        // Hits come sorted by their fat boxes; the exact box can only be further, so the search stops
+        // once the next fat box starts behind the best exact hit
+        const float length = glm::length(direction);
+        if (length <= 0.0f) return nullptr;
+        const glm::vec3 dir = direction / length;
+
+        bwxGLRenderableComponent* best = nullptr;
+        float bestDistance = maxDistance;
+        for (const auto& [item, fatDistance] : hits) {
+            if (fatDistance > bestDistance) break;
+
+            auto* renderable = static_cast<bwxGLRenderableComponent*>(item);
+            const bwxGLBoundingBox& bounds = renderable->GetWorldBounds();
+
+            float tNear = 0.0f;
+            float tFar = bestDistance;
+            bool hit = true;
+            for (int axis = 0; axis < 3 && hit; ++axis) {
+                if (dir[axis] == 0.0f) {
+                    hit = origin[axis] >= bounds.min[axis] && origin[axis] <= bounds.max[axis];
+                    continue;
+                }
+                float t0 = (bounds.min[axis] - origin[axis]) / dir[axis];
+                float t1 = (bounds.max[axis] - origin[axis]) / dir[axis];
+                if (t0 > t1) std::swap(t0, t1);
+                tNear = std::max(tNear, t0);
+                tFar = std::min(tFar, t1);
+                hit = tNear <= tFar;
+            }
+
+            if (hit && tNear <= bestDistance) {
+                best = renderable;
+                bestDistance = tNear;
+            }
+        }
+
+        if (best && distance) *distance = bestDistance;
+        return best;
+    }
+
+    void bwxGLScene::UpdateMainThread(const std::shared_ptr<bwxGLNode>& node, float deltaTime) {
+        node->UpdateComponents(deltaTime, true);
+        for (const auto& child : node->GetChildren()) {
+            UpdateMainThread(child, deltaTime);
+        }
+    }
+
+    void bwxGLScene::UpdateSubtree(const std::shared_ptr<bwxGLNode>& node, float deltaTime, bool parallel) {
+        node->UpdateComponents(deltaTime, false);
+
+        const auto& children = node->GetChildren();
+        if (!parallel || children.size() < 2) {
+            for (const auto& child : children) {
+                UpdateSubtree(child, deltaTime, parallel);
+            }
+            return;
+        }
+
+        // Sibling subtrees share no components - each one is a separate job
+        bwxJobSystem::GetInstance().ParallelFor(children.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                UpdateSubtree(children[i], deltaTime, true);
+            }
+        });
+    }
+
 } // namespace bwx_sdk
@@ -0,0 +1,500 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_scene_cache.cpp
+// Purpose:     BWX_SDK Library; OpenGL Cooked binary scene cache
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_scene_cache.h>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        const char CACHE_MAGIC[4] = { 'B', 'W', 'X', 'S' };
+        const uint64_t BLOB_ALIGNMENT = 16;
+
+        // On-disk records; fixed-size fields only, offsets relative to the start of the file
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceHash;
+            uint32_t loaderFlags;
+            uint32_t assimpFlags;
+            uint32_t nodeCount;
+            uint32_t meshCount;
+            uint32_t materialCount;
+            uint32_t textureCount;
+            uint64_t nodesOffset;
+            uint64_t meshesOffset;
+            uint64_t materialsOffset;
+            uint64_t texturesOffset;
+            uint64_t stringsOffset;
+            uint64_t stringsSize;
+            uint64_t fileSize;
+        };
+
+        struct FileNode {
+            uint32_t name;  ///< Offset into the string table
+            int32_t parent;
+            float transform[16];
+            uint32_t firstMesh;
+            uint32_t meshCount;
+        };
+
+        struct FileMesh {
+            int32_t style;
+            uint32_t material;
+            uint32_t vertexCount;
+            uint32_t indexCount;
+            uint32_t indexType;
+            uint32_t stride;
+            float boundsMin[3];
+            float boundsMax[3];
+            uint64_t vertexOffset;
+            uint64_t indexOffset;
+        };
+
+        struct FileMaterial {
+            float ambient[4];
+            float diffuse[4];
+            float specular[4];
+            float shininess;
+            uint32_t firstTexture;
+            uint32_t textureCount;
+            uint32_t reserved;
+        };
+
+        struct FileTexture {
+            int32_t type;
+            uint32_t path;
+        };
+
+        uint64_t Align(uint64_t value) {
+            return (value + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+        }
+
+        size_t IndexSize(GLenum type) {
+            return type == GL_UNSIGNED_SHORT ? 2 : 4;
+        }
+
+    } // namespace
+
+    /**
+     * Read-only mapping of a whole file.
+     */
+    class bwxGLSceneCache::MappedFile {
+    public:
+        ~MappedFile() { Close(); }
+
+        bool Open(const std::string& path) {
+            Close();
+#if defined(_WIN32)
+            m_file = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) return false;
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+                Close();
+                return false;
+            }
+            m_size = static_cast<size_t>(size.QuadPart);
+
+            m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping) m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            m_fd = open(path.c_str(), O_RDONLY);
+            if (m_fd < 0) return false;
+
+            struct stat info;
+            if (fstat(m_fd, &info) != 0 || info.st_size == 0) {
+                Close();
+                return false;
+            }
+            m_size = static_cast<size_t>(info.st_size);
+
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if (data != MAP_FAILED) {
+                m_data = static_cast<const unsigned char*>(data);
+                madvise(data, m_size, MADV_SEQUENTIAL);
+            }
+#endif
+            if (!m_data) {
+                Close();
+                return false;
+            }
+            return true;
+        }
+
+        void Close() {
+#if defined(_WIN32)
+            if (m_data) UnmapViewOfFile(m_data);
+            if (m_mapping) CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+            if (m_fd >= 0) close(m_fd);
+            m_fd = -1;
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        inline const unsigned char* GetData() const { return m_data; }
+        inline size_t GetSize() const { return m_size; }
+
+    private:
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#else
+        int m_fd = -1;
+#endif
+        const unsigned char* m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+    bwxGLSceneCache::bwxGLSceneCache() = default;
+
+    bwxGLSceneCache::~bwxGLSceneCache() = default;
+
+    std::string bwxGLSceneCache::GetCachePath(const std::string& source) {
+        return source + bwxGL_SCENE_CACHE_EXT;
+    }
+
+    uint64_t bwxGLSceneCache::HashFile(const std::string& path) {
+        MappedFile file;
+        if (!file.Open(path)) return 0;
+
+        // FNV-1a over 64-bit words (the tail byte by byte) - a full pass over a big source costs
+        // about as much as reading it, still far below an import
+        const unsigned char* data = file.GetData();
+        const size_t size = file.GetSize();
+        uint64_t hash = 0xcbf29ce484222325ull ^ static_cast<uint64_t>(size);
+
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash = (hash ^ word) * 0x100000001b3ull;
+        }
+        for (; i < size; ++i) hash = (hash ^ data[i]) * 0x100000001b3ull;
+
+        return hash ? hash : 1;
+    }
+
+    bool bwxGLSceneCache::Open(const std::string& path, uint64_t sourceHash, unsigned int loaderFlags, unsigned int assimpFlags) {
+        Close();
+
+        m_file = std::make_unique<MappedFile>();
+        if (!m_file->Open(path)) {
+            m_file.reset();
+            return false;
+        }
+
+        const unsigned char* data = m_file->GetData();
+        const uint64_t size = m_file->GetSize();
+
+        FileHeader header;
+        if (size < sizeof(header)) {
+            Close();
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+
+        const bool valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+            header.version == bwxGL_SCENE_CACHE_VERSION && header.sourceHash == sourceHash &&
+            header.loaderFlags == loaderFlags && header.assimpFlags == assimpFlags && header.fileSize == size &&
+            header.nodesOffset + uint64_t(header.nodeCount) * sizeof(FileNode) <= size &&
+            header.meshesOffset + uint64_t(header.meshCount) * sizeof(FileMesh) <= size &&
+            header.materialsOffset + uint64_t(header.materialCount) * sizeof(FileMaterial) <= size &&
+            header.texturesOffset + uint64_t(header.textureCount) * sizeof(FileTexture) <= size &&
+            header.stringsOffset + header.stringsSize <= size;
+        if (!valid) {
+            Close();
+            return false;
+        }
+
+        const char* strings = reinterpret_cast<const char*>(data + header.stringsOffset);
+        auto getString = [&](uint32_t offset) {
+            // Every string is stored null-terminated; a bad offset gives an empty one
+            if (offset >= header.stringsSize) return std::string();
+            return std::string(strings + offset, strnlen(strings + offset, static_cast<size_t>(header.stringsSize - offset)));
+        };
+
+        m_nodes.resize(header.nodeCount);
+        for (uint32_t i = 0; i < header.nodeCount; ++i) {
+            FileNode record;
+            std::memcpy(&record, data + header.nodesOffset + i * sizeof(FileNode), sizeof(record));
+
+            Node& node = m_nodes[i];
+            node.name = getString(record.name);
+            node.parent = record.parent;
+            std::memcpy(&node.transform[0][0], record.transform, sizeof(record.transform));
+            node.firstMesh = record.firstMesh;
+            node.meshCount = record.meshCount;
+
+            if (uint64_t(node.firstMesh) + node.meshCount > header.meshCount) {
+                Close();
+                return false;
+            }
+        }
+
+        m_meshes.resize(header.meshCount);
+        for (uint32_t i = 0; i < header.meshCount; ++i) {
+            FileMesh record;
+            std::memcpy(&record, data + header.meshesOffset + i * sizeof(FileMesh), sizeof(record));
+
+            const uint64_t vertexBytes = uint64_t(record.vertexCount) * record.stride;
+            const uint64_t indexBytes = uint64_t(record.indexCount) * IndexSize(record.indexType);
+            if (record.vertexOffset + vertexBytes > size || record.indexOffset + indexBytes > size) {
+                Close();
+                return false;
+            }
+
+            Mesh& mesh = m_meshes[i];
+            mesh.style = record.style;
+            mesh.material = record.material;
+            mesh.vertexCount = static_cast<GLsizei>(record.vertexCount);
+            mesh.indexCount = static_cast<GLsizei>(record.indexCount);
+            mesh.indexType = record.indexType;
+            mesh.stride = static_cast<GLsizei>(record.stride);
+            mesh.bounds.min = glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]);
+            mesh.bounds.max = glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]);
+            mesh.vertices = data + record.vertexOffset;
+            mesh.indices = record.indexCount > 0 ? data + record.indexOffset : nullptr;
+        }
+
+        m_materials.resize(header.materialCount);
+        for (uint32_t i = 0; i < header.materialCount; ++i) {
+            FileMaterial record;
+            std::memcpy(&record, data + header.materialsOffset + i * sizeof(FileMaterial), sizeof(record));
+
+            Material& material = m_materials[i];
+            material.ambient = glm::vec4(record.ambient[0], record.ambient[1], record.ambient[2], record.ambient[3]);
+            material.diffuse = glm::vec4(record.diffuse[0], record.diffuse[1], record.diffuse[2], record.diffuse[3]);
+            material.specular = glm::vec4(record.specular[0], record.specular[1], record.specular[2], record.specular[3]);
+            material.shininess = record.shininess;
+
+            if (uint64_t(record.firstTexture) + record.textureCount > header.textureCount) {
+                Close();
+                return false;
+            }
+            for (uint32_t t = 0; t < record.textureCount; ++t) {
+                FileTexture texture;
+                std::memcpy(&texture, data + header.texturesOffset + (record.firstTexture + t) * sizeof(FileTexture), sizeof(texture));
+                material.textures.push_back({ static_cast<bwxGL_TEXTURE_TYPE>(texture.type), getString(texture.path) });
+            }
+        }
+
+        return true;
+    }
+
+    void bwxGLSceneCache::Close() {
+        Clear();
+        m_file.reset();
+    }
+
+    void bwxGLSceneCache::Clear() {
+        m_nodes.clear();
+        m_meshes.clear();
+        m_materials.clear();
+    }
+
+    uint32_t bwxGLSceneCache::AddNode(const std::string& name, int32_t parent, const glm::mat4& transform) {
+        Node node;
+        node.name = name;
+        node.parent = parent;
+        node.transform = transform;
+        node.firstMesh = static_cast<uint32_t>(m_meshes.size());
+        m_nodes.push_back(std::move(node));
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    bool bwxGLSceneCache::AddMesh(const bwxGLMesh& source, uint32_t material) {
+        if (m_nodes.empty()) return false;
+
+        Mesh mesh;
+        if (!source.GetEncodedData(mesh.vertexBlob, mesh.indexBlob)) return false;
+
+        mesh.style = source.GetFormat();
+        mesh.material = material;
+        mesh.vertexCount = source.GetVertexCount();
+        mesh.indexCount = source.GetIndexCount();
+        mesh.indexType = source.GetIndexType();
+        mesh.stride = source.GetLayout().GetStride();
+        mesh.bounds = source.GetBounds();
+        mesh.vertices = mesh.vertexBlob.data();
+        mesh.indices = mesh.indexBlob.empty() ? nullptr : mesh.indexBlob.data();
+
+        m_meshes.push_back(std::move(mesh));
+        ++m_nodes.back().meshCount;
+        return true;
+    }
+
+    uint32_t bwxGLSceneCache::AddMaterial(const Material& material) {
+        m_materials.push_back(material);
+        return static_cast<uint32_t>(m_materials.size() - 1);
+    }
+
+    bool bwxGLSceneCache::Write(const std::string& path, uint64_t sourceHash, unsigned int loaderFlags, unsigned int assimpFlags) const {
+        std::string strings;
+        auto addString = [&strings](const std::string& value) {
+            const uint32_t offset = static_cast<uint32_t>(strings.size());
+            strings.append(value);
+            strings.push_back('\0');
+            return offset;
+        };
+
+        std::vector<FileNode> nodes;
+        for (const auto& node : m_nodes) {
+            FileNode record{};
+            record.name = addString(node.name);
+            record.parent = node.parent;
+            std::memcpy(record.transform, &node.transform[0][0], sizeof(record.transform));
+            record.firstMesh = node.firstMesh;
+            record.meshCount = node.meshCount;
+            nodes.push_back(record);
+        }
+
+        std::vector<FileMaterial> materials;
+        std::vector<FileTexture> textures;
+        for (const auto& material : m_materials) {
+            FileMaterial record{};
+            std::memcpy(record.ambient, &material.ambient[0], sizeof(record.ambient));
+            std::memcpy(record.diffuse, &material.diffuse[0], sizeof(record.diffuse));
+            std::memcpy(record.specular, &material.specular[0], sizeof(record.specular));
+            record.shininess = material.shininess;
+            record.firstTexture = static_cast<uint32_t>(textures.size());
+            record.textureCount = static_cast<uint32_t>(material.textures.size());
+            for (const auto& texture : material.textures) {
+                textures.push_back({ static_cast<int32_t>(texture.type), addString(texture.path) });
+            }
+            materials.push_back(record);
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = bwxGL_SCENE_CACHE_VERSION;
+        header.sourceHash = sourceHash;
+        header.loaderFlags = loaderFlags;
+        header.assimpFlags = assimpFlags;
+        header.nodeCount = static_cast<uint32_t>(nodes.size());
+        header.meshCount = static_cast<uint32_t>(m_meshes.size());
+        header.materialCount = static_cast<uint32_t>(materials.size());
+        header.textureCount = static_cast<uint32_t>(textures.size());
+
+        uint64_t offset = sizeof(FileHeader);
+        header.nodesOffset = offset;
+        offset += nodes.size() * sizeof(FileNode);
+        header.meshesOffset = offset;
+        offset += m_meshes.size() * sizeof(FileMesh);
+        header.materialsOffset = offset;
+        offset += materials.size() * sizeof(FileMaterial);
+        header.texturesOffset = offset;
+        offset += textures.size() * sizeof(FileTexture);
+        header.stringsOffset = offset;
+        header.stringsSize = strings.size();
+        offset += strings.size();
+
+        // Blobs last, aligned, so a mapping can hand them on as they are
+        std::vector<FileMesh> meshes;
+        for (const auto& mesh : m_meshes) {
+            FileMesh record{};
+            record.style = mesh.style;
+            record.material = mesh.material;
+            record.vertexCount = static_cast<uint32_t>(mesh.vertexCount);
+            record.indexCount = static_cast<uint32_t>(mesh.indexCount);
+            record.indexType = mesh.indexType;
+            record.stride = static_cast<uint32_t>(mesh.stride);
+            std::memcpy(record.boundsMin, &mesh.bounds.min[0], sizeof(record.boundsMin));
+            std::memcpy(record.boundsMax, &mesh.bounds.max[0], sizeof(record.boundsMax));
+
+            offset = Align(offset);
+            record.vertexOffset = offset;
+            offset += uint64_t(mesh.vertexCount) * mesh.stride;
+            offset = Align(offset);
+            record.indexOffset = offset;
+            offset += uint64_t(mesh.indexCount) * IndexSize(mesh.indexType);
+            meshes.push_back(record);
+        }
+        header.fileSize = offset;
+
+        // Written aside and renamed, so a crash never leaves a truncated cache behind
+        const std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                std::cerr << "Failed to write scene cache: " << path << std::endl;
+                return false;
+            }
+
+            auto pad = [&out]() {
+                static const char zeros[BLOB_ALIGNMENT] = {};
+                const uint64_t position = static_cast<uint64_t>(out.tellp());
+                out.write(zeros, static_cast<std::streamsize>(Align(position) - position));
+            };
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(nodes.size() * sizeof(FileNode)));
+            out.write(reinterpret_cast<const char*>(meshes.data()), static_cast<std::streamsize>(meshes.size() * sizeof(FileMesh)));
+            out.write(reinterpret_cast<const char*>(materials.data()), static_cast<std::streamsize>(materials.size() * sizeof(FileMaterial)));
+            out.write(reinterpret_cast<const char*>(textures.data()), static_cast<std::streamsize>(textures.size() * sizeof(FileTexture)));
+            out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+            for (size_t i = 0; i < m_meshes.size(); ++i) {
+                const Mesh& mesh = m_meshes[i];
+                pad();
+                out.write(reinterpret_cast<const char*>(mesh.vertices), static_cast<std::streamsize>(uint64_t(mesh.vertexCount) * mesh.stride));
+                pad();
+                if (mesh.indices) {
+                    out.write(reinterpret_cast<const char*>(mesh.indices),
+                        static_cast<std::streamsize>(uint64_t(mesh.indexCount) * IndexSize(mesh.indexType)));
+                }
+            }
+
+            if (!out) {
+                std::cerr << "Failed to write scene cache: " << path << std::endl;
+                out.close();
+                std::filesystem::remove(temporary);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::cerr << "Failed to write scene cache: " << path << " (" << error.message() << ")" << std::endl;
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace bwx_sdk
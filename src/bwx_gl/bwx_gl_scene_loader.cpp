@@ -11,8 +11,12 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <bwx_sdk/bwx_core/bwx_file_watcher.h>
+#include <bwx_sdk/bwx_core/bwx_job_system.h>
 #include <bwx_sdk/bwx_core/bwx_string.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_material_manager.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_scene_loader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_manager.h>
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
@@ -24,11 +28,16 @@
 #include <vector>
 #include <algorithm>
 #include <cstring>
-#include <execution>
+#include <filesystem>
+#include <unordered_set>
 
 namespace bwx_sdk {
 
-	bwxGLSceneLoader::bwxGLSceneLoader() : m_assimpScene(NULL), m_convertBlenderCoords(false)
+	namespace {
+		const char s_sceneWatchOwner = 0; // Watcher registrations of WatchScene()
+	}
+
+	bwxGLSceneLoader::bwxGLSceneLoader() : m_assimpScene(NULL), m_generateShaders(false), m_convertBlenderCoords(false)
 	{
 		this->m_assimpFlags =
 			//aiProcess_CalcTangentSpace |							// Generate tangents and bitangents
@@ -99,12 +108,51 @@ namespace bwx_sdk {
 		//to[0][3] = from.d1; to[1][3] = from.d2; to[2][3] = from.d3; to[3][3] = from.d4;
 	}
 
+	bool bwxGLSceneLoader::WatchScene(const std::string& file, unsigned int flags, std::function<void(std::shared_ptr<bwxGLScene>)> onReloaded)
+	{
+		if (!onReloaded) return false;
+
+		return bwxFileWatcher::GetInstance().Watch(file, &s_sceneWatchOwner, [file, flags, onReloaded](const std::string&) {
+			auto scene = std::make_shared<bwxGLScene>();
+			bwxGLSceneLoader loader;
+			if (!loader.Load(file, scene, flags))
+			{
+				wxLogWarning("SceneLoader: Reload of %s failed, keeping the current scene.", file);
+				return;
+			}
+			onReloaded(scene);
+		});
+	}
+
+	void bwxGLSceneLoader::UnwatchScene(const std::string& file)
+	{
+		bwxFileWatcher::GetInstance().Unwatch(file, &s_sceneWatchOwner);
+	}
+
 	bool bwxGLSceneLoader::Load(const std::string& file, std::shared_ptr<bwxGLScene> scene, unsigned int flags)
 	{
 		// TODO: Porządki w loaderze
 
 		if (file.empty()) return false;
 
+		this->m_generateShaders = (flags & bwxGL_SCENE_LOADER_GEN_SHADERS);
+		this->m_convertBlenderCoords = (flags & bwxGL_SCENE_LOADER_CONV_BLENDER_COORDS);
+		this->m_directory = std::filesystem::path(file).parent_path().string();
+
+		// Cooked scene: no Assimp, mesh blobs go from the mapped file straight to the GPU
+		// Skeletons are not cooked - animated loads always go through Assimp
+		const bool useCache = (flags & bwxGL_SCENE_LOADER_CACHE) && (flags & bwxGL_SCENE_LOADER_MODELS) && !(flags & bwxGL_SCENE_LOADER_ANIMATIONS);
+		const unsigned int cacheFlags = flags & ~bwxGL_SCENE_LOADER_CACHE;
+		const uint64_t sourceHash = useCache ? bwxGLSceneCache::HashFile(file) : 0;
+		if (sourceHash)
+		{
+			bwxGLSceneCache cache;
+			if (cache.Open(bwxGLSceneCache::GetCachePath(file), sourceHash, cacheFlags, m_assimpFlags) && LoadFromCache(cache, scene))
+			{
+				return true;
+			}
+		}
+
 		Assimp::Importer importer;
 		m_assimpScene = importer.ReadFile(file, m_assimpFlags);
 
@@ -133,13 +181,24 @@ namespace bwx_sdk {
 		}
 		// Tests --------------------------------------------------------------
 
-		this->m_generateShaders = (flags & bwxGL_SCENE_LOADER_GEN_SHADERS);
-		this->m_convertBlenderCoords = (flags & bwxGL_SCENE_LOADER_CONV_BLENDER_COORDS);
+		// The import is recorded as it goes and written out for the next load
+		bwxGLSceneCache cooking;
+		if (sourceHash)
+		{
+			m_cooking = &cooking;
+			m_cookedMaterials.clear();
+		}
 
 		if (flags & bwxGL_SCENE_LOADER_CAMERAS) this->ProcessCameras(scene);
 		if (flags & bwxGL_SCENE_LOAER_LIGHTS) this->ProcessLights(scene);
 		if (flags & bwxGL_SCENE_LOADER_MODELS) this->ProcessModels(scene, (flags & bwxGL_SCENE_LOADER_ANIMATIONS));
 
+		if (m_cooking)
+		{
+			cooking.Write(bwxGLSceneCache::GetCachePath(file), sourceHash, cacheFlags, m_assimpFlags);
+			m_cooking = nullptr;
+		}
+
 		return true;
 	}
 
@@ -249,86 +308,264 @@ namespace bwx_sdk {
 		aiNode* root = m_assimpScene->mRootNode;
 		if (!root || root->mNumChildren == 0) return;  // Avoid empty scene
 
+		m_pendingNodes.clear();
+		m_pendingMeshes.clear();
+
 		std::span<aiNode*> children(root->mChildren, root->mNumChildren);
 		for (aiNode* child : children)
 		{
 			this->ProcessAssimpNodes(scene, scene->GetRoot(), child, animation);
 		}
 
-		//if (this->generate_shaders) scene->GenerateModelShaders();
+		// CPU phase: the meshes do not depend on each other - conversion, optimisation and bounds on the job system
+		bwxJobSystem::GetInstance().ParallelFor(m_pendingMeshes.size(), 1, [this](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++) this->ConvertMesh(m_pendingMeshes[i]);
+			});
+
+		// GL phase: buffers and texture placeholders only, images are decoded by bwxGLTextureLoader jobs
+		this->BuildModels(scene);
+
+		m_pendingNodes.clear();
+		m_pendingMeshes.clear();
 	}
 
 	void bwxGLSceneLoader::ProcessAssimpNodes(std::shared_ptr<bwxGLScene> scene, std::shared_ptr<bwxGLNode> parent, aiNode* node, bool animation)
 	{
 		if (node->mNumMeshes <= 0) return;
 
-		std::shared_ptr<bwxGLModel> model_tmp = std::make_shared<bwxGLModel>(bwxGL_MODEL_TYPE::MODEL_UNDEFINED);
-		//model_tmp->SetName(node->mName.C_Str());
-		//model_tmp->SetParent(parent);
-		//model_tmp->SetKeepParentTransform(parent != nullptr);
+		PendingNode pending;
+		pending.source = node;
+		pending.firstMesh = m_pendingMeshes.size();
+		pending.meshCount = node->mNumMeshes;
 
-		glm::mat4 trans;
-		ConvertMat44(node->mTransformation, trans);
+		ConvertMat44(node->mTransformation, pending.transform);
 		if (m_convertBlenderCoords)
 		{
-			trans = glm::rotate(trans, glm::radians(90.0f), glm::vec3(1.0, 0, 0));
+			pending.transform = glm::rotate(pending.transform, glm::radians(90.0f), glm::vec3(1.0, 0, 0));
 		}
-		//model_tmp->SetTransformMatrix(trans);
 
-		std::unordered_map<int, std::shared_ptr<bwxGLMaterial>> materialCache;
+		// Bones are looked up by name here, the conversion jobs only read the finished skeleton
+		if (animation) pending.skeleton = BuildSkeleton(node);
+		if (pending.skeleton) pending.animations = BuildAnimations(*pending.skeleton);
 
 		for (unsigned int meshIdx : std::span(node->mMeshes, node->mNumMeshes))
 		{
 			aiMesh* ai_m = m_assimpScene->mMeshes[meshIdx];
+			m_pendingMeshes.push_back({ ai_m, nullptr, ai_m->HasBones() ? pending.skeleton : nullptr });
+		}
+
+		m_pendingNodes.push_back(pending);
+
+		//for (aiNode* child : std::span(node->mChildren, node->mNumChildren))
+		//	this->ProcessAssimpNodes(scene, model_tmp, child, animation);
+	}
+
+	void bwxGLSceneLoader::ConvertMesh(PendingMesh& pending) const
+	{
+		const aiMesh* ai_m = pending.source;
 
-			std::vector<bwxGLVertex> vertices;
-			vertices.reserve(ai_m->mNumVertices);
+		std::vector<bwxGLVertex> vertices;
+		vertices.reserve(ai_m->mNumVertices);
 
-			std::vector<GLuint> indices;
-			indices.reserve(ai_m->mNumFaces * 3);
+		std::vector<GLuint> indices;
+		indices.reserve(ai_m->mNumFaces * 3);
 
-			int m_style = 0x00000000;
-			if (ai_m->HasNormals()) m_style |= bwxGL_MESH_NORMAL;
-			if (ai_m->HasTextureCoords(0)) m_style |= bwxGL_MESH_TEX_COORD;
-			if (ai_m->HasTangentsAndBitangents()) m_style |= (bwxGL_MESH_TANGENT | bwxGL_MESH_BITANGENT);
-			if (ai_m->HasVertexColors(0)) m_style |= bwxGL_MESH_COLOR;
-			if ((bool)ai_m->GetNumUVChannels()) m_style |= bwxGL_MESH_UV;
-			if (ai_m->HasFaces()) m_style |= bwxGL_MESH_INDICES;
+		int m_style = 0x00000000;
+		if (ai_m->HasNormals()) m_style |= bwxGL_MESH_NORMAL;
+		if (ai_m->HasTextureCoords(0)) m_style |= bwxGL_MESH_TEX_COORD;
+		if (ai_m->HasTangentsAndBitangents()) m_style |= (bwxGL_MESH_TANGENT | bwxGL_MESH_BITANGENT);
+		if (ai_m->HasVertexColors(0)) m_style |= bwxGL_MESH_COLOR;
+		if ((bool)ai_m->GetNumUVChannels()) m_style |= bwxGL_MESH_UV;
+		if (ai_m->HasFaces()) m_style |= bwxGL_MESH_INDICES;
+		if (pending.skeleton) m_style |= bwxGL_MESH_SKINNED;
 
-			std::shared_ptr<bwxGLMesh> mesh = std::make_shared<bwxGLMesh>(m_style);
-			//mesh->SetName(str::bwxFormatStd("%s_%d", ai_m->mName.C_Str(), meshIdx));
-			//mesh->SetParent(model_tmp);
+		std::shared_ptr<bwxGLMesh> mesh = std::make_shared<bwxGLMesh>(m_style);
+		//mesh->SetName(str::bwxFormatStd("%s_%d", ai_m->mName.C_Str(), meshIdx));
 
-			// Loop for vertices
-			for (unsigned int i = 0; i < ai_m->mNumVertices; i++)
+		// Loop for vertices
+		for (unsigned int i = 0; i < ai_m->mNumVertices; i++)
+		{
+			bwxGLVertex v;
+			v.position = glm::vec3(ai_m->mVertices[i].x, ai_m->mVertices[i].y, ai_m->mVertices[i].z);
+			if (ai_m->HasNormals()) v.normal = glm::vec3(ai_m->mNormals[i].x, ai_m->mNormals[i].y, ai_m->mNormals[i].z);
+			if (ai_m->HasTextureCoords(0)) v.texCoord = glm::vec2(ai_m->mTextureCoords[0][i].x, ai_m->mTextureCoords[0][i].y);
+			if (ai_m->HasTangentsAndBitangents())
 			{
-				bwxGLVertex v;
-				v.position = glm::vec3(ai_m->mVertices[i].x, ai_m->mVertices[i].y, ai_m->mVertices[i].z);
-				if (ai_m->HasNormals()) v.normal = glm::vec3(ai_m->mNormals[i].x, ai_m->mNormals[i].y, ai_m->mNormals[i].z);
-				vertices.emplace_back(std::move(v));
+				v.tangent = glm::vec3(ai_m->mTangents[i].x, ai_m->mTangents[i].y, ai_m->mTangents[i].z);
+				v.bitangent = glm::vec3(ai_m->mBitangents[i].x, ai_m->mBitangents[i].y, ai_m->mBitangents[i].z);
 			}
+			if (ai_m->HasVertexColors(0)) v.color = glm::vec3(ai_m->mColors[0][i].r, ai_m->mColors[0][i].g, ai_m->mColors[0][i].b);
+			v.boneIndices = glm::vec4(0.0f);
+			v.boneWeights = glm::vec4(0.0f);
+			vertices.emplace_back(std::move(v));
+		}
 
-			// Loop for texture coordinates
-			std::for_each(ai_m->mFaces, ai_m->mFaces + ai_m->mNumFaces, [&](const aiFace& face)
+		// Influences: the strongest bwxGL_MAX_BONE_INFLUENCES per vertex, renormalised
+		if (pending.skeleton)
+		{
+			for (const aiBone* bone : std::span(ai_m->mBones, ai_m->mNumBones))
+			{
+				const int32_t index = pending.skeleton->FindBone(bone->mName.C_Str());
+				if (index < 0) continue;
+
+				for (const aiVertexWeight& weight : std::span(bone->mWeights, bone->mNumWeights))
 				{
-					indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
-				});
+					if (weight.mVertexId >= vertices.size()) continue;
+					bwxGLVertex& v = vertices[weight.mVertexId];
+
+					int slot = 0;
+					for (int k = 1; k < bwxGL_MAX_BONE_INFLUENCES; k++)
+					{
+						if (v.boneWeights[k] < v.boneWeights[slot]) slot = k;
+					}
+					if (weight.mWeight > v.boneWeights[slot])
+					{
+						v.boneWeights[slot] = weight.mWeight;
+						v.boneIndices[slot] = static_cast<float>(index);
+					}
+				}
+			}
+
+			for (bwxGLVertex& v : vertices)
+			{
+				const float sum = v.boneWeights.x + v.boneWeights.y + v.boneWeights.z + v.boneWeights.w;
+				if (sum > 0.0f) v.boneWeights /= sum;
+				else v.boneWeights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f); // Unweighted vertex follows the first bone
+			}
+		}
+
+		// Loop for texture coordinates
+		std::for_each(ai_m->mFaces, ai_m->mFaces + ai_m->mNumFaces, [&](const aiFace& face)
+			{
+				indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+			});
 
-			if (materialCache.find(ai_m->mMaterialIndex) == materialCache.end())
-				materialCache[ai_m->mMaterialIndex] = ProcessMaterial(model_tmp, ai_m);
+		mesh->SetVertices(std::move(vertices));
+		mesh->SetIndices(std::move(indices));
+		mesh->Prepare();
 
-			//mesh->SetMaterial(materialCache[ai_m->mMaterialIndex]);
-			model_tmp->AddMesh(mesh);
+		pending.mesh = mesh;
+	}
+
+	void bwxGLSceneLoader::BuildModels(std::shared_ptr<bwxGLScene> scene)
+	{
+		for (const PendingNode& node : m_pendingNodes)
+		{
+			std::shared_ptr<bwxGLModel> model_tmp = std::make_shared<bwxGLModel>(bwxGL_MODEL_TYPE::MODEL_UNDEFINED);
+			model_tmp->SetSkeleton(node.skeleton);
+			for (const auto& clip : node.animations) model_tmp->AddAnimation(clip);
+			//model_tmp->SetName(node.source->mName.C_Str());
+			//model_tmp->SetTransformMatrix(node.transform);
+
+			if (m_cooking) m_cooking->AddNode(node.source->mName.C_Str(), -1, node.transform);
+
+			std::unordered_map<int, std::shared_ptr<bwxGLMaterial>> materialCache;
+
+			for (size_t i = node.firstMesh; i < node.firstMesh + node.meshCount; i++)
+			{
+				PendingMesh& pending = m_pendingMeshes[i];
+				aiMesh* ai_m = pending.source;
+
+				pending.mesh->SetupMesh();
+
+				if (materialCache.find(ai_m->mMaterialIndex) == materialCache.end())
+					materialCache[ai_m->mMaterialIndex] = ProcessMaterial(model_tmp, ai_m);
+
+				if (m_cooking) m_cooking->AddMesh(*pending.mesh, m_cookedMaterials[ai_m->mMaterialIndex]);
+
+				//mesh->SetMaterial(materialCache[ai_m->mMaterialIndex]);
+				model_tmp->AddMesh(pending.mesh);
+				if (m_generateShaders) AssignShaderProgram(model_tmp, *pending.mesh);
+			}
+
+			scene->AddModel(model_tmp);
 		}
+	}
 
-		scene->AddModel(model_tmp);
+	std::shared_ptr<bwxGLSkeleton> bwxGLSceneLoader::BuildSkeleton(const aiNode* node)
+	{
+		std::unordered_map<std::string, glm::mat4> offsets;
+		for (unsigned int meshIdx : std::span(node->mMeshes, node->mNumMeshes))
+		{
+			const aiMesh* ai_m = m_assimpScene->mMeshes[meshIdx];
+			for (const aiBone* bone : std::span(ai_m->mBones, ai_m->mNumBones))
+			{
+				glm::mat4 offset;
+				ConvertMat44(bone->mOffsetMatrix, offset);
+				offsets.emplace(bone->mName.C_Str(), offset);
+			}
+		}
+		if (offsets.empty()) return nullptr;
 
-		std::vector<aiNode*> children(node->mChildren, node->mChildren + node->mNumChildren);
-		std::for_each(std::execution::par, children.begin(), children.end(),
-			[this, scene, model_tmp, animation](aiNode* child)
+		// Bones and every node between them and the root - intermediate nodes carry transforms too
+		aiNode* root = m_assimpScene->mRootNode;
+		std::unordered_set<const aiNode*> needed;
+		for (const auto& [name, offset] : offsets)
+		{
+			for (const aiNode* n = root->FindNode(name.c_str()); n && n != root; n = n->mParent)
 			{
-				//this->ProcessAssimpNodes(scene, model_tmp, child, animation);
-			});
+				if (!needed.insert(n).second) break;
+			}
+		}
+
+		std::shared_ptr<bwxGLSkeleton> skeleton = std::make_shared<bwxGLSkeleton>();
+
+		// Depth-first from the root: a parent is always added before its children
+		std::vector<std::pair<const aiNode*, int32_t>> stack;
+		for (aiNode* child : std::span(root->mChildren, root->mNumChildren)) stack.emplace_back(child, -1);
+		while (!stack.empty())
+		{
+			auto [n, parent] = stack.back();
+			stack.pop_back();
+			if (needed.find(n) == needed.end()) continue;
+
+			glm::mat4 local;
+			ConvertMat44(n->mTransformation, local);
+			auto it = offsets.find(n->mName.C_Str());
+			const int32_t index = skeleton->AddBone(n->mName.C_Str(), parent, it != offsets.end() ? it->second : glm::mat4(1.0f), local);
+
+			for (aiNode* child : std::span(n->mChildren, n->mNumChildren)) stack.emplace_back(child, index);
+		}
+
+		return skeleton;
+	}
+
+	std::vector<std::shared_ptr<bwxGLAnimationClip>> bwxGLSceneLoader::BuildAnimations(const bwxGLSkeleton& skeleton) const
+	{
+		std::vector<std::shared_ptr<bwxGLAnimationClip>> clips;
+		if (!m_assimpScene->HasAnimations()) return clips;
+
+		for (const aiAnimation* ai_a : std::span(m_assimpScene->mAnimations, m_assimpScene->mNumAnimations))
+		{
+			// Key times are in ticks; files without a rate are commonly authored at 25 ticks per second
+			const double ticksPerSecond = ai_a->mTicksPerSecond > 0.0 ? ai_a->mTicksPerSecond : 25.0;
+			auto clip = std::make_shared<bwxGLAnimationClip>(ai_a->mName.C_Str(), static_cast<float>(ai_a->mDuration / ticksPerSecond));
+
+			for (const aiNodeAnim* channel : std::span(ai_a->mChannels, ai_a->mNumChannels))
+			{
+				bwxGLAnimationClip::Keys keys;
+				keys.bone = skeleton.FindBone(channel->mNodeName.C_Str());
+				if (keys.bone < 0) continue;
+
+				for (const aiVectorKey& key : std::span(channel->mPositionKeys, channel->mNumPositionKeys))
+				{
+					keys.translations.emplace_back(static_cast<float>(key.mTime / ticksPerSecond), glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z));
+				}
+				for (const aiQuatKey& key : std::span(channel->mRotationKeys, channel->mNumRotationKeys))
+				{
+					keys.rotations.emplace_back(static_cast<float>(key.mTime / ticksPerSecond), glm::quat(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z));
+				}
+				for (const aiVectorKey& key : std::span(channel->mScalingKeys, channel->mNumScalingKeys))
+				{
+					keys.scales.emplace_back(static_cast<float>(key.mTime / ticksPerSecond), glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z));
+				}
+				clip->AddTrack(keys);
+			}
+
+			if (clip->GetTrackCount()) clips.push_back(clip);
+		}
+		return clips;
 	}
 
 	std::shared_ptr<bwxGLMaterial> bwxGLSceneLoader::ProcessMaterial(std::shared_ptr<bwxGLModel> model, aiMesh* ai_m)
@@ -372,6 +609,12 @@ namespace bwx_sdk {
 			{aiTextureType_REFLECTION,   bwxGL_TEXTURE_TYPE::TEXTURE_REFLECTION}
 		};
 
+		bwxGLSceneCache::Material cooked;
+		cooked.ambient = material->GetAmbient();
+		cooked.diffuse = material->GetDiffuse();
+		cooked.specular = material->GetSpecular();
+		cooked.shininess = material->GetShininess();
+
 		// Process textures
 		for (const auto& [assimpType, glType] : textureMappings)
 		{
@@ -380,38 +623,99 @@ namespace bwx_sdk {
 			while (mat->GetTexture(assimpType, texIndex, &path) == AI_SUCCESS)
 			{
 				this->ProcessTexture(glType, material, model, path.data);
+				cooked.textures.push_back({ glType, path.data });
 				texIndex++;
 			}
 		}
 
-		return material;
+		if (m_cooking && m_cookedMaterials.find(ai_m->mMaterialIndex) == m_cookedMaterials.end())
+		{
+			m_cookedMaterials[ai_m->mMaterialIndex] = m_cooking->AddMaterial(cooked);
+		}
+
+		// Equal materials of other meshes and nodes become one object, so they batch together
+		return bwxGLMaterialManager::GetInstance().ShareMaterial(material);
 	}
 
-	void bwxGLSceneLoader::ProcessTexture(bwxGL_TEXTURE_TYPE type, std::shared_ptr<bwxGLMaterial> material, std::shared_ptr<bwxGLModel> model, const std::string& file)
+	std::shared_ptr<bwxGLMaterial> bwxGLSceneLoader::CreateMaterial(const bwxGLSceneCache::Material& cooked, std::shared_ptr<bwxGLModel> model)
+	{
+		std::shared_ptr<bwxGLMaterial> material = std::make_shared<bwxGLMaterial>();
+		material->SetAmbient(cooked.ambient);
+		material->SetDiffuse(cooked.diffuse);
+		material->SetSpecular(cooked.specular);
+		material->SetShininess(cooked.shininess);
+
+		for (const auto& texture : cooked.textures)
+		{
+			this->ProcessTexture(texture.type, material, model, texture.path);
+		}
+
+		return bwxGLMaterialManager::GetInstance().ShareMaterial(material);
+	}
+
+	bool bwxGLSceneLoader::LoadFromCache(const bwxGLSceneCache& cache, std::shared_ptr<bwxGLScene> scene)
 	{
-		bwxGLTexture2DData data;
-		bool skip_texture = false;
+		const auto& meshes = cache.GetMeshes();
+		const auto& materials = cache.GetMaterials();
 
-		/*
-		for (unsigned int i = 0; i < model->GetAllTexturesTmp()->size(); i++)
+		// Layouts come from the code, the stored blobs must still match them
+		for (const auto& cooked : meshes)
 		{
-			if (model->GetAllTexturesTmp()->operator[](i).path == file)
+			if (bwxGLVertexLayout::FromMeshFormat(cooked.style).GetStride() != cooked.stride || cooked.material >= materials.size())
 			{
-				data = model->GetAllTexturesTmp()->operator[](i);
-				data.type = type; // Jedna tektura może stanowić diffuse i specular..., dlatego kopiujemy bieżący typ
-				material->AddTexture(data);
-				skip_texture = true;
+				return false;
 			}
 		}
-		if (!skip_texture)
+
+		for (const auto& node : cache.GetNodes())
 		{
-			data.path = file;
-			data.type = type;
-			data.id = Texture::CreateFromFile(file);
-			material->AddTexture(data);
-			model->GetAllTexturesTmp()->push_back(data);
+			if (node.meshCount == 0) continue;
+
+			std::shared_ptr<bwxGLModel> model_tmp = std::make_shared<bwxGLModel>(bwxGL_MODEL_TYPE::MODEL_UNDEFINED);
+			std::unordered_map<uint32_t, std::shared_ptr<bwxGLMaterial>> materialCache;
+
+			for (uint32_t i = node.firstMesh; i < node.firstMesh + node.meshCount; i++)
+			{
+				const bwxGLSceneCache::Mesh& cooked = meshes[i];
+
+				std::shared_ptr<bwxGLMesh> mesh = std::make_shared<bwxGLMesh>(cooked.style);
+				mesh->SetupMesh(bwxGLVertexLayout::FromMeshFormat(cooked.style), cooked.vertices, cooked.vertexCount,
+					cooked.indices, cooked.indexCount, cooked.indexType, cooked.bounds);
+
+				if (materialCache.find(cooked.material) == materialCache.end())
+					materialCache[cooked.material] = CreateMaterial(materials[cooked.material], model_tmp);
+
+				model_tmp->AddMesh(mesh);
+				if (m_generateShaders) AssignShaderProgram(model_tmp, *mesh);
+			}
+
+			scene->AddModel(model_tmp);
 		}
-		*/
+
+		return true;
+	}
+
+	void bwxGLSceneLoader::AssignShaderProgram(std::shared_ptr<bwxGLModel> model, const bwxGLMesh& mesh)
+	{
+		// One program per variant, not per model - the generator links each combination once
+		const uint32_t features = bwxGLShaderGenerator::GetMeshFeatures(mesh.GetFormat()) | m_shaderFeatures;
+		model->SetShaderProgram(model->GetMeshesCount() - 1, bwxGLShaderGenerator::GetProgram(features));
+	}
+
+	void bwxGLSceneLoader::ProcessTexture(bwxGL_TEXTURE_TYPE type, std::shared_ptr<bwxGLMaterial> material, std::shared_ptr<bwxGLModel> model, const std::string& file)
+	{
+		if (file.empty() || file[0] == '*') return;  // Embedded textures are not supported yet
+
+		// Assimp gives paths relative to the scene file
+		std::filesystem::path path(file);
+		if (path.is_relative() && !m_directory.empty()) path = std::filesystem::path(m_directory) / path;
+
+		// Placeholder now - the image is decoded on the job system and uploaded by bwxGLTextureLoader::Update()
+		// (one file used as diffuse and specular, reached by another path or copied, is loaded once)
+		bwxGLTextureManager& textures = bwxGLTextureManager::GetInstance();
+		const std::string texturePath = textures.ResolveTexturePath(path.string());
+		textures.LoadTexture(texturePath, true, true);
+		material->AddTexture(type, texturePath);
 	}
 
 }
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
 
 namespace bwx_sdk {
 
@@ -40,6 +41,11 @@ namespace bwx_sdk {
 	}
 
 	bool bwxGLShader::LoadShader(bwxGL_SHADER_TYPE type, const std::string& source, bool fromFile)
+	{
+		return SubmitShader(type, source, fromFile) && CheckCompileStatus();
+	}
+
+	bool bwxGLShader::SubmitShader(bwxGL_SHADER_TYPE type, const std::string& source, bool fromFile)
 	{
 		std::string shaderCode = source;
 		if (fromFile)
@@ -58,6 +64,21 @@ namespace bwx_sdk {
 		const char* src = shaderCode.c_str();
 		glShaderSource(m_id, 1, &src, nullptr);
 		glCompileShader(m_id);
+		return true;
+	}
+
+	bool bwxGLShader::IsCompileComplete() const
+	{
+		if (!m_id || !GLEW_KHR_parallel_shader_compile) return true;
+
+		GLint complete = GL_TRUE;
+		glGetShaderiv(m_id, GL_COMPLETION_STATUS_KHR, &complete);
+		return complete == GL_TRUE;
+	}
+
+	bool bwxGLShader::CheckCompileStatus() const
+	{
+		if (!m_id) return false;
 
 		GLint success;
 		glGetShaderiv(m_id, GL_COMPILE_STATUS, &success);
@@ -130,8 +151,28 @@ namespace bwx_sdk {
 	}
 
 	bool bwxGLShaderProgram::Link()
+	{
+		SubmitLink();
+		return FinishLink();
+	}
+
+	void bwxGLShaderProgram::SubmitLink()
 	{
 		glLinkProgram(m_program);
+	}
+
+	bool bwxGLShaderProgram::IsLinkComplete() const
+	{
+		if (!m_program || !GLEW_KHR_parallel_shader_compile) return true;
+
+		GLint complete = GL_TRUE;
+		glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &complete);
+		return complete == GL_TRUE;
+	}
+
+	bool bwxGLShaderProgram::FinishLink()
+	{
+		if (!m_program) return false;
 
 		GLint success;
 		glGetProgramiv(m_program, GL_LINK_STATUS, &success);
@@ -150,9 +191,112 @@ namespace bwx_sdk {
 			m_program = bwxGL_SHADER_PROGRAM_EMPTY;
 			return false;
 		}
+
+		OnLinked();
 		return true;
 	}
 
+	void bwxGLShaderProgram::SetBinaryRetrievable(bool retrievable)
+	{
+		if (m_program && GLEW_ARB_get_program_binary)
+		{
+			glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, retrievable ? GL_TRUE : GL_FALSE);
+		}
+	}
+
+	bool bwxGLShaderProgram::GetBinary(GLenum& format, std::vector<unsigned char>& data) const
+	{
+		if (!m_program || !GLEW_ARB_get_program_binary) return false;
+
+		GLint length = 0;
+		glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) return false;
+
+		data.resize(static_cast<size_t>(length));
+		GLsizei written = 0;
+		glGetProgramBinary(m_program, length, &written, &format, data.data());
+		data.resize(static_cast<size_t>(written));
+		return written > 0;
+	}
+
+	bool bwxGLShaderProgram::LoadBinary(GLenum format, const void* data, GLsizei length)
+	{
+		if (!m_program || !GLEW_ARB_get_program_binary) return false;
+
+		glProgramBinary(m_program, format, data, length);
+
+		// A driver update invalidates binaries - a failed load is the normal signal for that, not an error
+		GLint success = GL_FALSE;
+		glGetProgramiv(m_program, GL_LINK_STATUS, &success);
+		if (!success) return false;
+
+		OnLinked();
+		return true;
+	}
+
+	void bwxGLShaderProgram::OnLinked()
+	{
+		GLint binaryLength = 0;
+		if (GLEW_ARB_get_program_binary) glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		SetMemoryBytes(binaryLength > 0 ? static_cast<size_t>(binaryLength) : 0);
+
+		m_instanced = glGetAttribLocation(m_program, bwxGL_INSTANCE_MATRIX_ATTRIB) == bwxGL_INSTANCE_MATRIX_LOCATION;
+
+		// Shared blocks get fixed binding points (GLSL 330 has no layout(binding))
+		GLuint frameBlock = glGetUniformBlockIndex(m_program, bwxGL_FRAME_UBO_BLOCK);
+		m_frameBlock = frameBlock != GL_INVALID_INDEX;
+		if (m_frameBlock) glUniformBlockBinding(m_program, frameBlock, bwxGL_FRAME_UBO_BINDING);
+
+		GLuint lightsBlock = glGetUniformBlockIndex(m_program, bwxGL_LIGHTS_UBO_BLOCK);
+		if (lightsBlock != GL_INVALID_INDEX) glUniformBlockBinding(m_program, lightsBlock, bwxGL_LIGHTS_UBO_BINDING);
+
+		GLuint materialParams = glGetUniformBlockIndex(m_program, bwxGL_MATERIAL_UBO_BLOCK);
+		m_materialParams = materialParams != GL_INVALID_INDEX;
+		if (m_materialParams) glUniformBlockBinding(m_program, materialParams, bwxGL_MATERIAL_UBO_BINDING);
+
+		// Storage blocks are only queryable through the program interface API (GL 4.3)
+		m_indirect = false;
+		m_materialTable = false;
+		if (GLEW_ARB_program_interface_query) {
+			GLuint drawBlock = glGetProgramResourceIndex(m_program, GL_SHADER_STORAGE_BLOCK, bwxGL_DRAW_DATA_SSBO_BLOCK);
+			m_indirect = drawBlock != GL_INVALID_INDEX;
+			if (m_indirect) glShaderStorageBlockBinding(m_program, drawBlock, bwxGL_DRAW_DATA_SSBO_BINDING);
+
+			GLuint materialBlock = glGetProgramResourceIndex(m_program, GL_SHADER_STORAGE_BLOCK, bwxGL_MATERIAL_SSBO_BLOCK);
+			m_materialTable = materialBlock != GL_INVALID_INDEX;
+			if (m_materialTable) glShaderStorageBlockBinding(m_program, materialBlock, bwxGL_MATERIAL_SSBO_BINDING);
+		}
+
+		CacheUniforms();
+
+		// Texture arrays sit on fixed units, set once instead of per draw (glProgramUniform needs no bound program)
+		auto arrays = m_uniformLocations.find(bwxGLHashName(bwxGL_TEXTURE_ARRAYS_UNIFORM));
+		if (m_materialTable && arrays != m_uniformLocations.end()) {
+			GLint units[bwxGL_MAX_TEXTURE_ARRAYS];
+			for (GLint i = 0; i < bwxGL_MAX_TEXTURE_ARRAYS; ++i) units[i] = bwxGL_TEXTURE_ARRAY_FIRST_UNIT + i;
+			glProgramUniform1iv(m_program, arrays->second, bwxGL_MAX_TEXTURE_ARRAYS, units);
+		}
+	}
+
+	void bwxGLShaderProgram::CacheUniforms()
+	{
+		// All active uniforms are resolved once here, SetUniform() only hashes the name
+		m_uniformCache = GetProgramUniforms();
+		m_uniformLocations.clear();
+
+		for (const auto& [name, location] : m_uniformCache)
+		{
+			m_uniformLocations[bwxGLHashName(name)] = location;
+
+			// "lights[0]" is also reachable as "lights"
+			const size_t bracket = name.find('[');
+			if (bracket != std::string::npos && name.compare(bracket, std::string::npos, "[0]") == 0)
+			{
+				m_uniformLocations[bwxGLHashName(std::string_view(name).substr(0, bracket))] = location;
+			}
+		}
+	}
+
 	void bwxGLShaderProgram::Bind() const
 	{
 		if (m_program)
@@ -173,6 +317,14 @@ namespace bwx_sdk {
 			glDeleteProgram(m_program);
 			m_program = bwxGL_SHADER_PROGRAM_EMPTY;
 		}
+		SetMemoryBytes(0);
+	}
+
+	void bwxGLShaderProgram::SetMemoryBytes(size_t bytes)
+	{
+		if (bytes == m_memoryBytes) return;
+		BWX_METRIC_GAUGE("gl.shaders.program_bytes").Add(static_cast<int64_t>(bytes) - static_cast<int64_t>(m_memoryBytes));
+		m_memoryBytes = bytes;
 	}
 
 	void bwxGLShaderProgram::Unload()
@@ -245,19 +397,22 @@ namespace bwx_sdk {
 		return attributes;
 	}
 
-	GLint bwxGLShaderProgram::GetUniformLocation(const std::string& name)
+	GLint bwxGLShaderProgram::GetUniformLocation(const bwxGLUniformName& name)
 	{
-		auto it = m_uniformCache.find(name);
-		if (it != m_uniformCache.end()) {
+		auto it = m_uniformLocations.find(name.hash);
+		if (it != m_uniformLocations.end()) {
 			return it->second;
 		}
 
-		GLint location = glGetUniformLocation(m_program, name.c_str());
+		// Not active (or program not linked yet) - asked once, then cached as well
+		std::string key(name.str);
+		GLint location = glGetUniformLocation(m_program, key.c_str());
 		if (location == -1) {
-			std::cerr << "Warning: Uniform '" << name << "' not found in shader program " << m_program << std::endl;
+			std::cerr << "Warning: Uniform '" << key << "' not found in shader program " << m_program << std::endl;
 		}
 
-		m_uniformCache[name] = location;
+		m_uniformCache[key] = location;
+		m_uniformLocations[name.hash] = location;
 		return location;
 	}
 
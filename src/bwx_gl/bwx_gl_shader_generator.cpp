@@ -8,6 +8,14 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include <bwx_sdk/bwx_gl/bwx_gl_shader_generator.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_light_system.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_light_clusters.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_material_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_vertex_layout.h>
+#include <bwx_sdk/bwx_core/bwx_startup_trace.h>
 
 #include <sstream>
 #include <iostream>
@@ -20,36 +28,113 @@
 
 namespace bwx_sdk {
 
-    std::unordered_map<std::string, std::string> bwx_sdk::bwxGLShaderGenerator::m_shaderCache;
+    std::unordered_map<uint32_t, std::string> bwx_sdk::bwxGLShaderGenerator::m_shaderCache;
+    std::unordered_set<uint32_t> bwx_sdk::bwxGLShaderGenerator::m_failedPrograms;
 
-    std::string bwxGLShaderGenerator::GetVertexShader(bool useNormals, bool useTexCoords, bool useLighting) 
+    std::string bwxGLShaderGenerator::GetVertexShader(bool useNormals, bool useTexCoords, bool useLighting, bool useInstancing, bool useIndirect,
+        bool useSkinning) 
     {
-        std::string key = "V_" + std::to_string(useNormals) + "_" + std::to_string(useTexCoords) + "_" + std::to_string(useLighting);
+        uint32_t key = 0;
+        if (useNormals) key |= bwxGL_SHADER_VARIANT_NORMALS;
+        if (useTexCoords) key |= bwxGL_SHADER_VARIANT_TEXCOORDS;
+        if (useLighting) key |= bwxGL_SHADER_VARIANT_LIGHTING;
+        if (useInstancing) key |= bwxGL_SHADER_VARIANT_INSTANCING;
+        if (useIndirect) key |= bwxGL_SHADER_VARIANT_INDIRECT;
+        if (useSkinning) key |= bwxGL_SHADER_VARIANT_SKINNING;
 
         auto it = m_shaderCache.find(key);
         if (it != m_shaderCache.end()) {
             return it->second;
         }
 
-        std::string shader = GenerateVertexShader(useNormals, useTexCoords, useLighting);
+        std::string shader = GenerateVertexShader(useNormals, useTexCoords, useLighting, useInstancing, useIndirect, useSkinning);
         m_shaderCache[key] = shader;
         return shader;
     }
 
-    std::string bwxGLShaderGenerator::GetFragmentShader(bool useTextures, bool useLighting) 
+    std::string bwxGLShaderGenerator::GetFragmentShader(bool useTextures, bool useLighting, bool useClusteredLights, bool useMaterialTable) 
     {
-        std::string key = "F_" + std::to_string(useTextures) + "_" + std::to_string(useLighting);
+        uint32_t key = bwxGL_SHADER_VARIANT_FRAGMENT;
+        if (useTextures) key |= bwxGL_SHADER_VARIANT_TEXCOORDS;
+        if (useLighting) key |= bwxGL_SHADER_VARIANT_LIGHTING;
+        if (useClusteredLights) key |= bwxGL_SHADER_VARIANT_CLUSTERED_LIGHTS;
+        if (useMaterialTable) key |= bwxGL_SHADER_VARIANT_MATERIAL_TABLE;
 
         auto it = m_shaderCache.find(key);
         if (it != m_shaderCache.end()) {
             return it->second;
         }
 
-        std::string shader = GenerateFragmentShader(useTextures, useLighting);
+        std::string shader = GenerateFragmentShader(useTextures, useLighting, useClusteredLights, useMaterialTable);
         m_shaderCache[key] = shader;
         return shader;
     }
 
+    uint32_t bwxGLShaderGenerator::NormalizeFeatures(uint32_t features)
+    {
+        features &= ~bwxGL_SHADER_VARIANT_FRAGMENT;
+        if (!(features & bwxGL_SHADER_VARIANT_NORMALS)) features &= ~bwxGL_SHADER_VARIANT_LIGHTING;
+        if (!(features & bwxGL_SHADER_VARIANT_LIGHTING)) features &= ~(bwxGL_SHADER_VARIANT_NORMALS | bwxGL_SHADER_VARIANT_CLUSTERED_LIGHTS);
+        if (features & bwxGL_SHADER_VARIANT_INSTANCING) features &= ~bwxGL_SHADER_VARIANT_INDIRECT;
+        if (!(features & bwxGL_SHADER_VARIANT_INDIRECT)) features &= ~bwxGL_SHADER_VARIANT_MATERIAL_TABLE;
+        return features;
+    }
+
+    uint32_t bwxGLShaderGenerator::GetMeshFeatures(int meshFormat)
+    {
+        uint32_t features = 0;
+        if (meshFormat & bwxGL_MESH_NORMAL) features |= bwxGL_SHADER_VARIANT_NORMALS;
+        if (meshFormat & bwxGL_MESH_TEX_COORD) features |= bwxGL_SHADER_VARIANT_TEXCOORDS;
+        if (meshFormat & bwxGL_MESH_SKINNED) features |= bwxGL_SHADER_VARIANT_SKINNING;
+        return features;
+    }
+
+    std::string bwxGLShaderGenerator::GetProgramName(uint32_t features)
+    {
+        std::ostringstream name;
+        name << "bwxGL_variant_" << std::hex << NormalizeFeatures(features);
+        return name.str();
+    }
+
+    std::shared_ptr<bwxGLShaderProgram> bwxGLShaderGenerator::GetProgram(uint32_t features)
+    {
+        features = NormalizeFeatures(features);
+        const std::string name = GetProgramName(features);
+
+        bwxGLShaderProgramManager& manager = bwxGLShaderProgramManager::GetInstance();
+        if (auto program = manager.GetShaderProgramPtr(name)) return program;
+        if (m_failedPrograms.count(features)) return nullptr;
+
+        BWX_STARTUP_PHASE("gl.shader.variant", "gl");
+        const bool lighting = features & bwxGL_SHADER_VARIANT_LIGHTING;
+        const bool texCoords = features & bwxGL_SHADER_VARIANT_TEXCOORDS;
+
+        // Every fragment variant reads Normal, so the vertex stage always passes it on; without the
+        // attribute it is a constant, and lighting (the only user) is off for such meshes anyway
+        const std::string vertex = GetVertexShader(true, texCoords, lighting,
+            features & bwxGL_SHADER_VARIANT_INSTANCING, features & bwxGL_SHADER_VARIANT_INDIRECT,
+            features & bwxGL_SHADER_VARIANT_SKINNING);
+        const std::string fragment = GetFragmentShader(texCoords, lighting,
+            features & bwxGL_SHADER_VARIANT_CLUSTERED_LIGHTS, features & bwxGL_SHADER_VARIANT_MATERIAL_TABLE);
+
+        if (manager.CreateShaderProgramFromStrings(name, vertex, fragment, false) == bwxGL_SHADER_PROGRAM_EMPTY) {
+            std::cerr << "ShaderGenerator: variant " << name << " failed to build" << std::endl;
+            m_failedPrograms.insert(features);
+            return nullptr;
+        }
+        return manager.GetShaderProgramPtr(name);
+    }
+
+    std::string bwxGLShaderGenerator::GetDepthVertexShader(bool useInstancing, bool useIndirect, bool useSkinning)
+    {
+        return GetVertexShader(false, false, false, useInstancing, useIndirect, useSkinning);
+    }
+
+    std::string bwxGLShaderGenerator::GetDepthFragmentShader()
+    {
+        return "#version 330 core\nvoid main() {}\n";
+    }
+
     std::string bwxGLShaderGenerator::GetDefaultSkyboxVertexShader() 
     {
         return R"GLSL(
@@ -84,11 +169,17 @@ namespace bwx_sdk {
         return R"GLSL(
                 #version 450 core
                 layout (location = 0) in vec4 vertex;
+                layout (location = 1) in vec4 glyphColor;
+                layout (location = 2) in float glyphPage;
                 out vec2 TexCoords;
+                out vec4 GlyphColor;
+                flat out float GlyphPage;
                 uniform mat4 projection;
                 void main() {
                     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
             	    TexCoords = vertex.zw;
+                    GlyphColor = glyphColor;
+                    GlyphPage = glyphPage;
                 };
             )GLSL";
     }
@@ -98,12 +189,72 @@ namespace bwx_sdk {
         return R"GLSL(
             #version 450 core
             in vec2 TexCoords;
+            in vec4 GlyphColor;
+            flat in float GlyphPage;
+            out vec4 color;
+            uniform sampler2DArray text;
+            uniform vec4 textColor;
+            void main() {
+                vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, vec3(TexCoords, GlyphPage)).r);
+                color = textColor * GlyphColor * sampled;
+            };
+        )GLSL";
+    }
+
+    std::string bwxGLShaderGenerator::GetSDFTTFFragmentShader()
+    {
+        // 0.5 is the outline; fwidth keeps the edge one pixel wide at any scale
+        return R"GLSL(
+            #version 450 core
+            in vec2 TexCoords;
+            in vec4 GlyphColor;
+            flat in float GlyphPage;
             out vec4 color;
-            uniform sampler2D text;
+            uniform sampler2DArray text;
             uniform vec4 textColor;
+            uniform float outlineWidth;
+            uniform vec4 outlineColor;
+            void main() {
+                float dist = texture(text, vec3(TexCoords, GlyphPage)).r;
+                float edge = max(fwidth(dist), 0.0001);
+                vec4 fill = textColor * GlyphColor;
+                float fillAlpha = smoothstep(0.5 - edge, 0.5 + edge, dist);
+                if (outlineWidth <= 0.0) {
+                    color = vec4(fill.rgb, fill.a * fillAlpha);
+                    return;
+                }
+                float outlineAlpha = smoothstep(0.5 - outlineWidth - edge, 0.5 - outlineWidth + edge, dist);
+                vec4 mixed = mix(outlineColor, fill, fillAlpha);
+                color = vec4(mixed.rgb, mixed.a * outlineAlpha);
+            };
+        )GLSL";
+    }
+
+    std::string bwxGLShaderGenerator::GetRectVertexShader()
+    {
+        // Four vertices per instance, drawn as a triangle strip; the corner comes from gl_VertexID
+        return R"GLSL(
+            #version 450 core
+            layout (location = 0) in vec4 rect;
+            layout (location = 1) in vec4 rectColor;
+            out vec4 RectColor;
+            uniform mat4 projection;
+            void main() {
+                vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+                gl_Position = projection * vec4(rect.xy + corner * rect.zw, 0.0, 1.0);
+                RectColor = rectColor;
+            };
+        )GLSL";
+    }
+
+    std::string bwxGLShaderGenerator::GetRectFragmentShader()
+    {
+        return R"GLSL(
+            #version 450 core
+            in vec4 RectColor;
+            out vec4 color;
             void main() {
-                vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-                color = textColor * sampled;
+                color = RectColor;
             };
         )GLSL";
     }
@@ -116,9 +267,20 @@ namespace bwx_sdk {
         src += "\n";
     */
 
-    std::string bwxGLShaderGenerator::GetLightStructBlock() {
+    std::string bwxGLShaderGenerator::GetFrameBlock() {
+        // Layout must match bwxGLFrameUniforms (bwx_gl_render_system.h)
         return R"GLSL(
-		#define MAX_LIGHTS 64
+layout(std140) uniform FrameBlock {
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+	vec4 cameraPosition;
+};
+)GLSL";
+    }
+
+    std::string bwxGLShaderGenerator::GetLightStructBlock() {
+        return "\n\t\t#define MAX_LIGHTS " + std::to_string(bwxGL_MAX_LIGHTS) + R"GLSL(
 
 		struct Light {
 			vec4 position;     // xyz: position, w: type
@@ -129,12 +291,59 @@ namespace bwx_sdk {
 			vec4 attenuation;  // x: constant, y: linear, z: quadratic, w: unused
 		};
 
-		layout(std140, binding = 2) uniform LightBlock {
+		layout(std140) uniform LightBlock {  // bound to 2 by bwxGLShaderProgram::Link()
 			Light lights[MAX_LIGHTS];
 		};
 	)GLSL";
     }
 
+    std::string bwxGLShaderGenerator::GetClusteredLightBlock() {
+        // Same Light struct as the UBO variant, but fetched from texture buffers (see bwxGLLightClusters)
+        std::string block;
+        block += "\n#define CLUSTER_X " + std::to_string(bwxGL_CLUSTER_X) + "\n";
+        block += "#define CLUSTER_Y " + std::to_string(bwxGL_CLUSTER_Y) + "\n";
+        block += "#define CLUSTER_Z " + std::to_string(bwxGL_CLUSTER_Z) + "\n";
+        block += "#define LIGHT_TEXELS " + std::to_string(bwxGL_CLUSTER_LIGHT_TEXELS) + "\n";
+        block += R"GLSL(
+		struct Light {
+			vec4 position;     // xyz: position, w: type
+			vec4 direction;    // xyz: direction, w: inner cone
+			vec4 diffuse;      // rgb: color, a: power
+			vec4 ambient;      // rgb: ambient, a: range
+			vec4 specular;     // rgb: specular, a: outer cone
+			vec4 attenuation;  // x: constant, y: linear, z: quadratic, w: unused
+		};
+
+		uniform samplerBuffer clusterLightData;
+		uniform usamplerBuffer clusterGrid;     // offset, count per cluster
+		uniform usamplerBuffer clusterIndices;  // global lights first, then per-cluster lists
+		uniform int clusterGlobalCount;
+		uniform vec2 clusterDepth;              // slice = log(depth) * x + y
+		uniform vec4 clusterViewport;
+
+		Light FetchLight(uint index) {
+			int base = int(index) * LIGHT_TEXELS;
+			Light light;
+			light.position = texelFetch(clusterLightData, base);
+			light.direction = texelFetch(clusterLightData, base + 1);
+			light.diffuse = texelFetch(clusterLightData, base + 2);
+			light.ambient = texelFetch(clusterLightData, base + 3);
+			light.specular = texelFetch(clusterLightData, base + 4);
+			light.attenuation = texelFetch(clusterLightData, base + 5);
+			return light;
+		}
+
+		int GetClusterIndex(vec3 fragPos) {
+			float depth = max(-(view * vec4(fragPos, 1.0)).z, 1e-4);
+			int slice = clamp(int(log(depth) * clusterDepth.x + clusterDepth.y), 0, CLUSTER_Z - 1);
+			vec2 uv = (gl_FragCoord.xy - clusterViewport.xy) / clusterViewport.zw;
+			ivec2 tile = clamp(ivec2(uv * vec2(CLUSTER_X, CLUSTER_Y)), ivec2(0), ivec2(CLUSTER_X - 1, CLUSTER_Y - 1));
+			return (slice * CLUSTER_Y + tile.y) * CLUSTER_X + tile.x;
+		}
+	)GLSL";
+        return block;
+    }
+
     std::string bwxGLShaderGenerator::GetLightCalculationFunction() {
         return R"GLSL(
 		vec3 CalculateLighting(Light light, vec3 normal, vec3 fragPos, vec3 viewDir)
@@ -158,56 +367,168 @@ namespace bwx_sdk {
 	)GLSL";
     }
 
-    std::string bwxGLShaderGenerator::GenerateVertexShader(bool useNormals, bool useTexCoords, bool useLighting) {
+    std::string bwxGLShaderGenerator::GenerateVertexShader(bool useNormals, bool useTexCoords, bool useLighting, bool useInstancing,
+        bool useIndirect, bool useSkinning) {
+        // Multi-draw-indirect reads the model matrix by draw index, which needs SSBOs and gl_DrawIDARB
+        if (useInstancing) useIndirect = false;
+
         std::string shader;
-        shader += "#version 330 core\n\n";
+        if (useIndirect) {
+            shader += "#version 430 core\n";
+            shader += "#extension GL_ARB_shader_draw_parameters : require\n\n";
+        }
+        else if (useSkinning) {
+            shader += "#version 430 core\n\n";  // The palette is an SSBO
+        }
+        else {
+            shader += "#version 330 core\n\n";
+        }
         shader += "layout(location = 0) in vec3 aPos;\n";
         if (useNormals) shader += "layout(location = 1) in vec3 aNormal;\n";
         if (useTexCoords) shader += "layout(location = 2) in vec2 aTexCoords;\n";
+        if (useSkinning) {
+            shader += "layout(location = " + std::to_string(bwxGL_ATTRIB_BONE_INDICES) + ") in uvec4 aBoneIndices;\n";
+            shader += "layout(location = " + std::to_string(bwxGL_ATTRIB_BONE_WEIGHTS) + ") in vec4 aBoneWeights;\n";
+        }
 
-        shader += "uniform mat4 model;\n";
-        shader += "uniform mat4 view;\n";
-        shader += "uniform mat4 projection;\n\n";
+        if (useInstancing) {
+            shader += "layout(location = " + std::to_string(bwxGL_INSTANCE_MATRIX_LOCATION) + ") in mat4 " bwxGL_INSTANCE_MATRIX_ATTRIB ";\n";
+            shader += "#define model " bwxGL_INSTANCE_MATRIX_ATTRIB "\n";
+        }
+        else if (useIndirect) {
+            shader += "struct DrawData {\n\tmat4 model;\n\tuvec4 info;\n};\n";
+            shader += "layout(std430, binding = " + std::to_string(bwxGL_DRAW_DATA_SSBO_BINDING) + ") readonly buffer " bwxGL_DRAW_DATA_SSBO_BLOCK " {\n";
+            shader += "\tDrawData drawData[];\n};\n";
+            shader += "#define model drawData[gl_DrawIDARB].model\n";
+        }
+        else {
+            shader += "uniform mat4 model;\n";
+        }
+        shader += GetFrameBlock();
+        if (useSkinning) shader += GetBonePaletteBlock(useIndirect);
+        shader += "\n";
 
+        // Bit-exact positions across programs, the depth pre-pass relies on it
+        shader += "invariant gl_Position;\n";
         shader += "out vec3 FragPos;\n";
+        if (useIndirect) shader += "flat out uint MaterialIndex;\n";
         if (useNormals) shader += "out vec3 Normal;\n";
         if (useTexCoords) shader += "out vec2 TexCoords;\n";
 
         shader += "void main() {\n";
-        shader += "\tFragPos = vec3(model * vec4(aPos, 1.0));\n";
-        if (useNormals)
+        if (useSkinning) {
+            shader += "\tmat4 skin = GetSkinMatrix(aBoneIndices, aBoneWeights);\n";
+            shader += "\tFragPos = vec3(model * skin * vec4(aPos, 1.0));\n";
+        }
+        else {
+            shader += "\tFragPos = vec3(model * vec4(aPos, 1.0));\n";
+        }
+        if (useIndirect)
+            shader += "\tMaterialIndex = drawData[gl_DrawIDARB].info.y;\n";
+        if (useNormals && useSkinning)
+            shader += "\tNormal = mat3(transpose(inverse(model * skin))) * aNormal;\n";
+        else if (useNormals)
             shader += "\tNormal = mat3(transpose(inverse(model))) * aNormal;\n";
         if (useTexCoords)
             shader += "\tTexCoords = aTexCoords;\n";
-        shader += "\tgl_Position = projection * view * vec4(FragPos, 1.0);\n";
+        shader += "\tgl_Position = viewProjection * vec4(FragPos, 1.0);\n";
         shader += "}\n";
 
         return shader;
     }
 
-    std::string bwxGLShaderGenerator::GenerateFragmentShader(bool useTextures, bool useLighting) {
+    std::string bwxGLShaderGenerator::GetBonePaletteBlock(bool useIndirect) {
+        std::string block;
+        block += "layout(std430, binding = " + std::to_string(bwxGL_BONE_PALETTE_SSBO_BINDING) + ") readonly buffer " bwxGL_BONE_PALETTE_SSBO_BLOCK " {\n";
+        block += "\tmat4 bones[];\n};\n";
+
+        // Indirect draws carry the first palette matrix in DrawData, the rest get it as a uniform
+        if (useIndirect) block += "#define " bwxGL_BONE_BASE_UNIFORM " drawData[gl_DrawIDARB].info.z\n";
+        else block += "uniform int " bwxGL_BONE_BASE_UNIFORM ";\n";
+
+        block += "mat4 GetSkinMatrix(uvec4 indices, vec4 weights) {\n";
+        block += "\tuint base = uint(" bwxGL_BONE_BASE_UNIFORM ");\n";
+        block += "\treturn bones[base + indices.x] * weights.x + bones[base + indices.y] * weights.y +\n";
+        block += "\t\tbones[base + indices.z] * weights.z + bones[base + indices.w] * weights.w;\n";
+        block += "}\n";
+        return block;
+    }
+
+    std::string bwxGLShaderGenerator::GetMaterialTableBlock(bool useBindless) {
+        std::string block;
+        block += "struct Material {\n\tvec4 diffuse;\n\tvec4 specular;\n\tvec4 emissive;\n\tvec4 params;\n";
+        block += "\tuvec2 diffuseHandle;\n\tint diffuseArray;\n\tint diffuseLayer;\n};\n";
+        block += "layout(std430, binding = " + std::to_string(bwxGL_MATERIAL_SSBO_BINDING) + ") readonly buffer " bwxGL_MATERIAL_SSBO_BLOCK " {\n";
+        block += "\tMaterial materials[];\n};\n";
+        block += "uniform sampler2DArray " bwxGL_TEXTURE_ARRAYS_UNIFORM "[" + std::to_string(bwxGL_MAX_TEXTURE_ARRAYS) + "];\n";
+        block += "uniform sampler2D diffuseMap;\n\n";
+
+        // Sampler arrays need constant (or dynamically uniform) indices, a flat input is neither
+        block += "vec4 SampleDiffuse(Material material, vec2 uv) {\n";
+        if (useBindless) {
+            block += "\tif (material.diffuseHandle != uvec2(0u)) return texture(sampler2D(material.diffuseHandle), uv);\n";
+        }
+        block += "\tif (material.diffuseArray == " + std::to_string(bwxGL_MATERIAL_BOUND_TEXTURE) + ") return texture(diffuseMap, uv);\n";
+        block += "\tvec3 uvw = vec3(uv, float(material.diffuseLayer));\n";
+        block += "\tswitch (material.diffuseArray) {\n";
+        for (int i = 0; i < bwxGL_MAX_TEXTURE_ARRAYS; ++i) {
+            block += "\tcase " + std::to_string(i) + ": return texture(" bwxGL_TEXTURE_ARRAYS_UNIFORM "[" + std::to_string(i) + "], uvw);\n";
+        }
+        block += "\t}\n";
+        block += "\treturn vec4(1.0);  // No diffuse texture\n";
+        block += "}\n";
+        return block;
+    }
+
+    std::string bwxGLShaderGenerator::GenerateFragmentShader(bool useTextures, bool useLighting, bool useClusteredLights,
+        bool useMaterialTable) {
+        // The material SSBO is as new as the indirect path that fills MaterialIndex
+        if (!GLEW_ARB_shader_storage_buffer_object) useMaterialTable = false;
+        const bool useBindless = useMaterialTable && GLEW_ARB_bindless_texture;
+
         std::string shader;
-        shader += "#version 330 core\n\n";
+        if (useMaterialTable) {
+            shader += "#version 430 core\n";
+            if (useBindless) shader += "#extension GL_ARB_bindless_texture : require\n";
+            shader += "\n";
+            shader += "flat in uint MaterialIndex;\n";
+        }
+        else {
+            shader += "#version 330 core\n\n";
+        }
         shader += "in vec3 FragPos;\n";
         shader += "in vec3 Normal;\n";
         shader += "in vec2 TexCoords;\n";
         shader += "out vec4 FragColor;\n";
-        shader += "uniform vec3 viewPos;\n";
+        shader += GetFrameBlock();
 
-        if (useTextures) {
+        if (useMaterialTable) {
+            shader += GetMaterialTableBlock(useBindless);
+        }
+        else if (useTextures) {
             shader += "uniform sampler2D diffuseMap;\n";
         }
         if (useLighting) {
-            shader += GetLightStructBlock();
+            shader += useClusteredLights ? GetClusteredLightBlock() : GetLightStructBlock();
             shader += GetLightCalculationFunction();
         }
 
         shader += "\nvoid main() {\n";
         shader += "\tvec3 norm = normalize(Normal);\n";
-        shader += "\tvec3 viewDir = normalize(viewPos - FragPos);\n";
+        shader += "\tvec3 viewDir = normalize(cameraPosition.xyz - FragPos);\n";
         shader += "\tvec3 result = vec3(0.0);\n";
 
-        if (useLighting) {
+        if (useLighting && useClusteredLights) {
+            // Only lights binned into this fragment's cluster
+            shader += "\tfor (int i = 0; i < clusterGlobalCount; ++i) {\n";
+            shader += "\t\tresult += CalculateLighting(FetchLight(texelFetch(clusterIndices, i).r), norm, FragPos, viewDir);\n";
+            shader += "\t}\n";
+            shader += "\tuvec2 cluster = texelFetch(clusterGrid, GetClusterIndex(FragPos)).rg;\n";
+            shader += "\tfor (uint i = 0u; i < cluster.y; ++i) {\n";
+            shader += "\t\tresult += CalculateLighting(FetchLight(texelFetch(clusterIndices, int(cluster.x + i)).r), norm, FragPos, viewDir);\n";
+            shader += "\t}\n";
+        }
+        else if (useLighting) {
             shader += "\tfor (int i = 0; i < MAX_LIGHTS; ++i) {\n";
             shader += "\t\tif (lights[i].diffuse.a == 0.0) break;\n";
             shader += "\t\tresult += CalculateLighting(lights[i], norm, FragPos, viewDir);\n";
@@ -217,7 +538,13 @@ namespace bwx_sdk {
             shader += "\tresult = vec3(1.0);\n";
         }
 
-        if (useTextures) {
+        if (useMaterialTable) {
+            shader += "\tMaterial material = materials[MaterialIndex];\n";
+            shader += "\tvec4 color = material.diffuse;\n";
+            if (useTextures) shader += "\tcolor *= SampleDiffuse(material, TexCoords);\n";
+            shader += "\tFragColor = vec4(result, 1.0) * color;\n";
+        }
+        else if (useTextures) {
             shader += "\tvec4 texColor = texture(diffuseMap, TexCoords);\n";
             shader += "\tFragColor = vec4(result, 1.0) * texColor;\n";
         }
@@ -12,7 +12,12 @@
 #endif
 
 #include <bwx_sdk/bwx_gl/bwx_gl_shader_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_program_cache.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_upload_worker.h>
+#include <bwx_sdk/bwx_core/bwx_file_watcher.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 
 namespace bwx_sdk {
@@ -29,7 +34,11 @@ namespace bwx_sdk {
 	}
 
 	void bwxGLShaderManager::AddShader(const std::string& name, bwxGLShader& shader) {
-		m_resources[name] = std::make_shared<bwxGLShader>(shader);
+		StoreResource(name, std::make_shared<bwxGLShader>(shader));
+	}
+
+	void bwxGLShaderManager::AddShader(const std::string& name, std::shared_ptr<bwxGLShader> shader) {
+		StoreResource(name, shader);
 	}
 
 	GLuint bwxGLShaderManager::LoadShader(const std::string& name, const std::string& source, bwxGL_SHADER_TYPE type, bool fromFile) 
@@ -39,7 +48,7 @@ namespace bwx_sdk {
 		{
 			if (m_overwrite || m_resources.find(name) == m_resources.end())
 			{
-				m_resources[name] = shader;
+				StoreResource(name, shader);
 			}
 		}
 		return shader->GetID();
@@ -139,6 +148,7 @@ namespace bwx_sdk {
 	}
 
 	std::shared_ptr<bwxGLShader> bwxGLShaderManager::GetShaderPtr(const std::string& name) {
+		auto lock = ReadLock();
 		auto it = m_resources.find(name);
 		if (it != m_resources.end()) {
 			return it->second;
@@ -202,7 +212,7 @@ namespace bwx_sdk {
 	}
 
 	void bwxGLShaderManager::Clear() {
-		m_resources.clear();
+		ClearResources();
 	}
 	
 	// ---------------------------------------------------------------------
@@ -218,7 +228,7 @@ namespace bwx_sdk {
 	}
 
 	void bwxGLShaderProgramManager::AddShaderProgram(const std::string& name, const bwxGLShaderProgram& program) {
-		m_resources[name] = std::make_shared<bwxGLShaderProgram>(program);
+		StoreResource(name, std::make_shared<bwxGLShaderProgram>(program));
 	}
 
 	GLuint bwxGLShaderProgramManager::CreateShaderProgram(const std::string& programName, const std::initializer_list<std::pair<bwxGL_SHADER_TYPE, std::string>>& shaders, bool fromFile)
@@ -235,7 +245,7 @@ namespace bwx_sdk {
 
 		if (program->Link())
 		{
-			m_resources[programName] = program;
+			StoreResource(programName, program);
 			return program->GetProgram();
 		}
 
@@ -254,7 +264,7 @@ namespace bwx_sdk {
 
 		if (program->Link())
 		{
-			m_resources[programName] = program;
+			StoreResource(programName, program);
 			return program->GetProgram();
 		}
 
@@ -268,7 +278,7 @@ namespace bwx_sdk {
 		program->AttachShader(bwxGLShaderManager::GetInstance().GetShader(fragmentName));
 		if (program->Link())
 		{
-			m_resources[programName] = program;
+			StoreResource(programName, program);
 			return program->GetProgram();
 		}
 		return bwxGL_SHADER_PROGRAM_EMPTY;
@@ -282,7 +292,7 @@ namespace bwx_sdk {
 		program->AttachShader(bwxGLShaderManager::GetInstance().GetShader(geometryName));
 		if (program->Link())
 		{
-			m_resources[programName] = program;
+			StoreResource(programName, program);
 			return program->GetProgram();
 		}
 		return bwxGL_SHADER_PROGRAM_EMPTY;
@@ -297,7 +307,7 @@ namespace bwx_sdk {
 		program->AttachShader(bwxGLShaderManager::GetInstance().GetShader(tessEvalName));
 		if (program->Link())
 		{
-			m_resources[programName] = program;
+			StoreResource(programName, program);
 			return program->GetProgram();
 		}
 		return bwxGL_SHADER_PROGRAM_EMPTY;
@@ -313,7 +323,7 @@ namespace bwx_sdk {
 		program->AttachShader(bwxGLShaderManager::GetInstance().GetShader(geometryName));
 		if (program->Link())
 		{
-			m_resources[programName] = program;
+			StoreResource(programName, program);
 			return program->GetProgram();
 		}
 		return bwxGL_SHADER_PROGRAM_EMPTY;
@@ -321,251 +331,278 @@ namespace bwx_sdk {
 
 	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, bool addToShaderManager)
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex) && 
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment))
-		{
-			if (addToShaderManager)
-			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-			}
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment } }, false, addToShaderManager);
+	}
 
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& geometry, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment }, { SHADER_GEOMETRY, geometry } }, false, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment },
+			{ SHADER_TESS_CONTROL, tessControl }, { SHADER_TESS_EVALUATION, tessEval } }, false, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, const std::string& geometry, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment },
+			{ SHADER_TESS_CONTROL, tessControl }, { SHADER_TESS_EVALUATION, tessEval }, { SHADER_GEOMETRY, geometry } }, false, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment } }, true, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& geometry, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment }, { SHADER_GEOMETRY, geometry } }, true, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment },
+			{ SHADER_TESS_CONTROL, tessControl }, { SHADER_TESS_EVALUATION, tessEval } }, true, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, const std::string& geometry, bool addToShaderManager)
+	{
+		return CreateShaderProgramFromSources(programName, { { SHADER_VERTEX, vertex }, { SHADER_FRAGMENT, fragment },
+			{ SHADER_TESS_CONTROL, tessControl }, { SHADER_TESS_EVALUATION, tessEval }, { SHADER_GEOMETRY, geometry } }, true, addToShaderManager);
+	}
+
+	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromSources(const std::string& programName, const std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& shaders, bool fromFile, bool addToShaderManager)
+	{
+		// Files are read here, so the cache key covers their content rather than their paths
+		std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>> sources = shaders;
+		if (fromFile && !LoadSources(sources)) return bwxGL_SHADER_PROGRAM_EMPTY;
 
-			if (program->Link())
+		auto& cache = bwxGLProgramBinaryCache::GetInstance();
+		const uint64_t key = cache.GetKey(sources);
+		if (key)
+		{
+			auto program = std::make_shared<bwxGLShaderProgram>();
+			if (cache.Load(*program, key))
 			{
-				m_resources[programName] = program;
+				StoreResource(programName, program);
+				if (fromFile && !m_programFiles.count(programName))
+				{
+					m_programFiles[programName] = shaders;
+					if (m_enableHotReload) WatchProgram(programName);
+				}
 				return program->GetProgram();
 			}
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
-	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& geometry, bool addToShaderManager)
-	{
 		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		bwxGLShader geometryShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex) && 
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment) && 
-			geometryShader.LoadShader(SHADER_GEOMETRY, geometry))
+		std::vector<std::shared_ptr<bwxGLShader>> compiled;
+		for (const auto& [type, source] : sources)
+		{
+			auto shader = std::make_shared<bwxGLShader>();
+			if (!shader->LoadShader(type, source)) return bwxGL_SHADER_PROGRAM_EMPTY;
+			compiled.push_back(shader);
+		}
+
+		for (size_t i = 0; i < compiled.size(); i++)
 		{
 			if (addToShaderManager)
 			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_GEOMETRY_SUFIX, geometryShader);
+				auto& shaderManager = bwxGLShaderManager::GetInstance();
+				shaderManager.AddShader(programName + shaderManager.GetShaderSuffix(sources[i].first), compiled[i]);
 			}
+			program->AttachShader(*compiled[i]);
+		}
 
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			program->AttachShader(geometryShader);
-			if (program->Link())
+		program->SetBinaryRetrievable(key != 0);
+		if (program->Link())
+		{
+			if (key) cache.Store(*program, key);
+			StoreResource(programName, program);
+			if (fromFile && !m_programFiles.count(programName))
 			{
-				m_resources[programName] = program;
-				return program->GetProgram();
+				m_programFiles[programName] = shaders;
+				if (m_enableHotReload) WatchProgram(programName);
 			}
+			return program->GetProgram();
 		}
 		return bwxGL_SHADER_PROGRAM_EMPTY;
 	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, bool addToShaderManager)
+	bool bwxGLShaderProgramManager::LoadSources(std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& sources) const
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		bwxGLShader tessControlShader;
-		bwxGLShader tessEvalShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex) && 
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment) && 
-			tessControlShader.LoadShader(SHADER_TESS_CONTROL, tessControl) && 
-			tessEvalShader.LoadShader(SHADER_TESS_EVALUATION, tessEval))
+		for (auto& [type, source] : sources)
 		{
-			if (addToShaderManager)
+			std::ifstream file(source);
+			if (!file.is_open())
 			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_CONTROL_SUFIX, tessControlShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_EVAL_SUFIX, tessEvalShader);
-			}
-
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			program->AttachShader(tessControlShader);
-			program->AttachShader(tessEvalShader);
-			if (program->Link())
-			{
-				m_resources[programName] = program;
-				return program->GetProgram();
+				std::cerr << "Shader file load error: " << source << std::endl;
+				return false;
 			}
+			source = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
+		return true;
 	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromStrings(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, const std::string& geometry, bool addToShaderManager)
+	bool bwxGLShaderProgramManager::IsParallelCompileSupported()
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		bwxGLShader tessControlShader;
-		bwxGLShader tessEvalShader;
-		bwxGLShader geometryShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex) && 
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment) && 
-			tessControlShader.LoadShader(SHADER_TESS_CONTROL, tessControl) && 
-			tessEvalShader.LoadShader(SHADER_TESS_EVALUATION, tessEval) && 
-			geometryShader.LoadShader(SHADER_GEOMETRY, geometry))
+		return GLEW_KHR_parallel_shader_compile;
+	}
+
+	bool bwxGLShaderProgramManager::CreateShaderProgramAsync(const std::string& programName, const std::vector<std::pair<bwxGL_SHADER_TYPE, std::string>>& shaders, bool fromFile)
+	{
+		PendingProgram pending;
+		pending.name = programName;
+		pending.sources = shaders;
+		if (fromFile && !LoadSources(pending.sources)) return false;
+
+		// A newer request for the same name replaces the one in flight
+		m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+			[&programName](const PendingProgram& p) { return p.name == programName; }), m_pending.end());
+
+		auto& cache = bwxGLProgramBinaryCache::GetInstance();
+		pending.key = cache.GetKey(pending.sources);
+		pending.program = std::make_shared<bwxGLShaderProgram>();
+		if (pending.key && cache.Load(*pending.program, pending.key))
 		{
-			if (addToShaderManager)
-			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_CONTROL_SUFIX, tessControlShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_EVAL_SUFIX, tessEvalShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_GEOMETRY_SUFIX, geometryShader);
-			}
+			StoreResource(programName, pending.program);
+			return true;
+		}
+
+		// Compiled and linked on the worker's shared context, stored by bwxGLUploadWorker::Update()
+		auto& worker = bwxGLUploadWorker::GetInstance();
+		if (worker.IsRunning())
+		{
+			auto job = std::make_shared<PendingProgram>(std::move(pending));
+			PendingProgram entry;
+			entry.name = job->name;
+			entry.program = job->program;
+			entry.onWorker = true;
+			m_pending.push_back(std::move(entry));
+
+			worker.Submit([this, job]() { return SubmitPendingProgram(*job) && CheckPendingProgram(*job); },
+				[this, job](bool ok)
+				{
+					// Replaced by a newer request meanwhile
+					auto it = std::find_if(m_pending.begin(), m_pending.end(),
+						[&job](const PendingProgram& p) { return p.program == job->program; });
+					if (it == m_pending.end()) return;
+					m_pending.erase(it);
+
+					if (!ok)
+					{
+						std::cerr << "Shader program build failed: " << job->name << std::endl;
+						return;
+					}
+					if (job->key) bwxGLProgramBinaryCache::GetInstance().Store(*job->program, job->key);
+					StoreResource(job->name, job->program);
+				});
+			return true;
+		}
 
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			program->AttachShader(tessControlShader);
-			program->AttachShader(tessEvalShader);
-			program->AttachShader(geometryShader);
-			if (program->Link())
+		// Without the extension glCompileShader may block, so submitting waits for UpdatePendingPrograms()
+		if (IsParallelCompileSupported())
+		{
+			static bool threadsSet = false;
+			if (!threadsSet)
 			{
-				m_resources[programName] = program;
-				return program->GetProgram();
+				glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+				threadsSet = true;
 			}
+			if (!SubmitPendingProgram(pending)) return false;
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
+
+		m_pending.push_back(std::move(pending));
+		return true;
 	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, bool addToShaderManager)
+	bool bwxGLShaderProgramManager::SubmitPendingProgram(PendingProgram& pending)
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex, true) &&
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment, true))
+		for (const auto& [type, source] : pending.sources)
 		{
-			if (addToShaderManager)
-			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-			}
-
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			if (program->Link())
-			{
-				m_resources[programName] = program;
-				return program->GetProgram();
-			}
+			auto shader = std::make_shared<bwxGLShader>();
+			if (!shader->SubmitShader(type, source)) return false;
+			pending.program->AttachShader(*shader);
+			pending.shaders.push_back(shader);
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
+
+		pending.program->SetBinaryRetrievable(pending.key != 0);
+		pending.program->SubmitLink();
+		pending.submitted = true;
+		return true;
 	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& geometry, bool addToShaderManager)
+	bool bwxGLShaderProgramManager::CheckPendingProgram(PendingProgram& pending)
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		bwxGLShader geometryShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex, true) &&
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment, true) &&
-			geometryShader.LoadShader(SHADER_GEOMETRY, geometry, true))
+		// Compile logs are only fetched now, when reading them no longer stalls
+		bool compiled = true;
+		for (const auto& shader : pending.shaders)
 		{
-			if (addToShaderManager)
-			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_GEOMETRY_SUFIX, geometryShader);
-			}
+			compiled = shader->CheckCompileStatus() && compiled;
+		}
 
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			program->AttachShader(geometryShader);
-			if (program->Link())
-			{
-				m_resources[programName] = program;
-				return program->GetProgram();
-			}
+		return compiled && pending.program->FinishLink();
+	}
+
+	bool bwxGLShaderProgramManager::FinishPendingProgram(PendingProgram& pending)
+	{
+		if (!CheckPendingProgram(pending))
+		{
+			std::cerr << "Shader program build failed: " << pending.name << std::endl;
+			return false;
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
+
+		if (pending.key) bwxGLProgramBinaryCache::GetInstance().Store(*pending.program, pending.key);
+		StoreResource(pending.name, pending.program);
+		return true;
 	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, bool addToShaderManager)
+	size_t bwxGLShaderProgramManager::UpdatePendingPrograms()
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		bwxGLShader tessControlShader;
-		bwxGLShader tessEvalShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex, true) &&
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment, true) &&
-			tessControlShader.LoadShader(SHADER_TESS_CONTROL, tessControl, true) &&
-			tessEvalShader.LoadShader(SHADER_TESS_EVALUATION, tessEval, true))
+		size_t budget = 1;
+		for (auto it = m_pending.begin(); it != m_pending.end();)
 		{
-			if (addToShaderManager)
+			// Handed over by bwxGLUploadWorker::Update()
+			if (it->onWorker)
 			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_CONTROL_SUFIX, tessControlShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_EVAL_SUFIX, tessEvalShader);
+				++it;
+				continue;
 			}
 
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			program->AttachShader(tessControlShader);
-			program->AttachShader(tessEvalShader);
-			if (program->Link())
+			if (!it->submitted)
 			{
-				m_resources[programName] = program;
-				return program->GetProgram();
+				if (budget == 0)
+				{
+					++it;
+					continue;
+				}
+				--budget;
+				if (!SubmitPendingProgram(*it))
+				{
+					it = m_pending.erase(it);
+					continue;
+				}
 			}
+			else if (!it->program->IsLinkComplete())
+			{
+				++it;
+				continue;
+			}
+
+			FinishPendingProgram(*it);
+			it = m_pending.erase(it);
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
+		return m_pending.size();
 	}
 
-	GLuint bwxGLShaderProgramManager::CreateShaderProgramFromFiles(const std::string& programName, const std::string& vertex, const std::string& fragment, const std::string& tessControl, const std::string& tessEval, const std::string& geometry, bool addToShaderManager)
+	bool bwxGLShaderProgramManager::IsShaderProgramPending(const std::string& name) const
 	{
-		auto program = std::make_shared<bwxGLShaderProgram>();
-		bwxGLShader vertexShader;
-		bwxGLShader fragmentShader;
-		bwxGLShader tessControlShader;
-		bwxGLShader tessEvalShader;
-		bwxGLShader geometryShader;
-		if (vertexShader.LoadShader(SHADER_VERTEX, vertex, true) &&
-			fragmentShader.LoadShader(SHADER_FRAGMENT, fragment, true) &&
-			tessControlShader.LoadShader(SHADER_TESS_CONTROL, tessControl, true) &&
-			tessEvalShader.LoadShader(SHADER_TESS_EVALUATION, tessEval, true) &&
-			geometryShader.LoadShader(SHADER_GEOMETRY, geometry, true))
+		for (const auto& pending : m_pending)
 		{
-			if (addToShaderManager)
-			{
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_VERTEX_SUFIX, vertexShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_FRAGMENT_SUFIX, fragmentShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_CONTROL_SUFIX, tessControlShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_TESS_EVAL_SUFIX, tessEvalShader);
-				bwxGLShaderManager::GetInstance().AddShader(programName + bwxGL_SHADER_GEOMETRY_SUFIX, geometryShader);
-			}
-
-			program->AttachShader(vertexShader);
-			program->AttachShader(fragmentShader);
-			program->AttachShader(tessControlShader);
-			program->AttachShader(tessEvalShader);
-			program->AttachShader(geometryShader);
-			if (program->Link())
-			{
-				m_resources[programName] = program;
-				return program->GetProgram();
-			}
+			if (pending.name == name) return true;
 		}
-		return bwxGL_SHADER_PROGRAM_EMPTY;
+		return false;
 	}
 
 	bwxGLShaderProgram bwxGLShaderProgramManager::GetShaderProgram(const std::string& programName) {
@@ -577,10 +614,21 @@ namespace bwx_sdk {
 	}
 
 	std::shared_ptr<bwxGLShaderProgram> bwxGLShaderProgramManager::GetShaderProgramPtr(const std::string& programName) {
+		if (!IsOwnerThread()) {
+			// Pending programs are tracked on the GL thread only, so no fallback from here
+			auto lock = ReadLock();
+			auto it = m_resources.find(programName);
+			return it != m_resources.end() ? it->second : nullptr;
+		}
+
 		auto it = m_resources.find(programName);
 		if (it != m_resources.end()) {
 			return it->second;
 		}
+		if (!m_fallbackProgram.empty() && m_fallbackProgram != programName && IsShaderProgramPending(programName)) {
+			it = m_resources.find(m_fallbackProgram);
+			if (it != m_resources.end()) return it->second;
+		}
 		return nullptr;
 	}
 
@@ -606,10 +654,18 @@ namespace bwx_sdk {
 
 	void bwxGLShaderProgramManager::UseShaderProgram(const std::string& programName)
 	{
-		auto it = m_resources.find(programName);
-		if (it != m_resources.end())
+		auto program = GetShaderProgramPtr(programName);
+		if (program)
 		{
-			it->second->Bind();
+			program->Bind();
+		}
+	}
+
+	void bwxGLShaderProgramManager::UseShaderProgram(bwxGLResourceHandle handle)
+	{
+		if (auto program = Resolve(handle))
+		{
+			program->Bind();
 		}
 	}
 
@@ -624,12 +680,58 @@ namespace bwx_sdk {
 		if (it != m_resources.end())
 		{
 			glDeleteProgram(it->second->GetProgram());
-			m_resources.erase(it);
+			EraseResource(it);
+		}
+
+		// Files may be shared between programs, so the remaining ones are watched again
+		if (m_programFiles.erase(programName) && m_enableHotReload)
+		{
+			bwxFileWatcher::GetInstance().UnwatchAll(this);
+			for (const auto& [name, files] : m_programFiles) WatchProgram(name);
+		}
+	}
+
+	void bwxGLShaderProgramManager::EnableHotReload(bool enabled)
+	{
+		if (enabled == m_enableHotReload) return;
+		m_enableHotReload = enabled;
+
+		if (!enabled)
+		{
+			bwxFileWatcher::GetInstance().UnwatchAll(this);
+			return;
+		}
+		for (const auto& [name, files] : m_programFiles) WatchProgram(name);
+	}
+
+	void bwxGLShaderProgramManager::WatchProgram(const std::string& programName)
+	{
+		auto it = m_programFiles.find(programName);
+		if (it == m_programFiles.end()) return;
+
+		for (const auto& [type, path] : it->second)
+		{
+			bwxFileWatcher::GetInstance().Watch(path, this, [this, programName](const std::string&) {
+				if (ReloadShaderProgram(programName)) wxLogMessage("[ShaderProgramManager] Hot reloaded program: %s", programName);
+			});
 		}
 	}
 
+	bool bwxGLShaderProgramManager::ReloadShaderProgram(const std::string& programName)
+	{
+		auto it = m_programFiles.find(programName);
+		if (it == m_programFiles.end()) return false;
+
+		// A copy - the rebuild looks the entry up again
+		const auto files = it->second;
+		return CreateShaderProgramFromSources(programName, files, true, false) != bwxGL_SHADER_PROGRAM_EMPTY;
+	}
+
 	void bwxGLShaderProgramManager::Clear() {
-		m_resources.clear();
+		m_pending.clear();
+		if (!m_programFiles.empty() && !bwxFileWatcher::GetInstance().IsShutDown()) bwxFileWatcher::GetInstance().UnwatchAll(this);
+		m_programFiles.clear();
+		ClearResources();
 	}
 
 } // namespace bwx_sdk
\ No newline at end of file
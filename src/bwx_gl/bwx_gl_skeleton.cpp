@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_skeleton.cpp
+// Purpose:     BWX_SDK Library; OpenGL Flat skeleton and GPU bone palette
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_skeleton.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+
+namespace bwx_sdk {
+
+    int32_t bwxGLSkeleton::AddBone(const std::string& name, int32_t parent, const glm::mat4& offset, const glm::mat4& local) {
+        const int32_t index = static_cast<int32_t>(m_parents.size());
+        if (parent >= index) {
+            wxLogWarning("Skeleton: Bone \"%s\" added before its parent, attached to the root.", name);
+            parent = -1;
+        }
+
+        m_names.push_back(name);
+        m_parents.push_back(parent);
+        m_offsets.push_back(offset);
+        m_bindPose.push_back(local);
+        m_local.push_back(local);
+        m_global.push_back(parent < 0 ? local : m_global[parent] * local);
+        m_palette.push_back(m_global.back() * offset);
+        m_lookup.emplace(name, index);
+        return index;
+    }
+
+    int32_t bwxGLSkeleton::FindBone(const std::string& name) const {
+        auto it = m_lookup.find(name);
+        return it != m_lookup.end() ? it->second : -1;
+    }
+
+    void bwxGLSkeleton::ResetToBindPose() {
+        m_local = m_bindPose;
+    }
+
+    void bwxGLSkeleton::Update() {
+        // Parents come first, so their globals are already final
+        const size_t count = m_parents.size();
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t parent = m_parents[i];
+            m_global[i] = parent < 0 ? m_local[i] : m_global[parent] * m_local[i];
+            m_palette[i] = m_global[i] * m_offsets[i];
+        }
+    }
+
+    void bwxGLBonePalette::Begin() {
+        m_matrices.clear();
+        m_bases.clear();
+    }
+
+    GLint bwxGLBonePalette::Add(const bwxGLSkeleton& skeleton) {
+        if (skeleton.IsEmpty()) return -1;
+
+        // Every mesh of a model shares its skeleton - one copy per frame
+        auto it = m_bases.find(&skeleton);
+        if (it != m_bases.end()) return it->second;
+
+        const GLint base = static_cast<GLint>(m_matrices.size());
+        const auto& palette = skeleton.GetPalette();
+        m_matrices.insert(m_matrices.end(), palette.begin(), palette.end());
+        m_bases.emplace(&skeleton, base);
+        return base;
+    }
+
+    bool bwxGLBonePalette::Upload() {
+        if (m_matrices.empty() || !IsSupported()) return false;
+
+        static GLint alignment = 0;
+        if (alignment == 0) {
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            if (alignment <= 0) alignment = 256;
+        }
+
+        const GLsizeiptr bytes = static_cast<GLsizeiptr>(m_matrices.size() * sizeof(glm::mat4));
+        if (m_ring && m_ring->GetRegionSize() < bytes + alignment) m_ring.reset();
+        if (!m_ring) {
+            // Some headroom, so a growing crowd does not reallocate every frame
+            m_ring = std::make_unique<bwxGLRingBuffer>(GL_SHADER_STORAGE_BUFFER, std::max<GLsizeiptr>(bytes * 2, 64 * sizeof(glm::mat4)));
+        }
+
+        m_ring->Advance();
+        const GLintptr offset = m_ring->Write(m_matrices.data(), bytes, alignment);
+        if (offset < 0) {
+            wxLogWarning("BonePalette: %zu matrices do not fit the palette buffer.", m_matrices.size());
+            return false;
+        }
+
+        m_ring->BindRange(GL_SHADER_STORAGE_BUFFER, bwxGL_BONE_PALETTE_SSBO_BINDING, offset, bytes);
+        bwxGLProfiler::GetInstance().AddUploadedBytes(static_cast<uint64_t>(bytes));
+        return true;
+    }
+
+    bool bwxGLBonePalette::IsSupported() {
+        return GLEW_ARB_shader_storage_buffer_object;
+    }
+
+} // namespace bwx_sdk
@@ -8,7 +8,12 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include <bwx_sdk/bwx_gl/bwx_gl_skybox.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_compressed_image.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_image_loader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
 
+#include <algorithm>
+#include <iostream>
 #include <vector>
 
 namespace bwx_sdk {
@@ -48,6 +53,7 @@ namespace bwx_sdk {
 	{
 		glDeleteVertexArrays(1, &VAO);
 		glDeleteBuffers(1, &VBO);
+		if (textureID) glDeleteTextures(1, &textureID);
 
 		//wxDELETE(shader);
 	}
@@ -137,43 +143,194 @@ namespace bwx_sdk {
 			"}\n";
 	}
 
+	const char* bwxGLSkyBox::FullScreenSkyBoxVertexShader()
+	{
+		// Triangle covering the screen; z = w puts it on the far plane. The ray is interpolated
+		// before the divide, which keeps it exact across the screen
+		return "#version 330 core\n" \
+			"out vec4 ViewRay;\n\n" \
+			"uniform mat4 invViewProjection;\n" \
+			"void main()\n" \
+			"{\n" \
+			"	vec2 pos = vec2(float((gl_VertexID & 1) << 2) - 1.0, float((gl_VertexID & 2) << 1) - 1.0);\n" \
+			"	gl_Position = vec4(pos, 1.0, 1.0);\n" \
+			"	ViewRay = invViewProjection * vec4(pos, 1.0, 1.0);\n" \
+			"}\n";
+	}
+
+	const char* bwxGLSkyBox::FullScreenSkyBoxFragmentShader()
+	{
+		return "#version 330 core\n" \
+			"in vec4 ViewRay;\n" \
+			"out vec4 color;\n\n" \
+			"uniform samplerCube skybox;\n\n" \
+			"void main()\n" \
+			"{\n" \
+			"    color = texture(skybox, ViewRay.xyz / ViewRay.w);\n" \
+			"}\n";
+	}
+
 	void bwxGLSkyBox::LoadCube(std::vector<std::string> faces)
 	{
+		if (textureID) glDeleteTextures(1, &textureID);
 		glGenTextures(1, &textureID);
 		glActiveTexture(GL_TEXTURE0);
 
+		// The chain every face has; a face without mips limits the whole cube to level 0
+		GLint levels = 0;
+
 		glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
-		for (GLuint i = 0; i < faces.size(); i++)
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (GLuint i = 0; i < faces.size() && i < 6; i++)
 		{
-			//bwxGLImgLoader img;
-			//img.Load(faces[i]);
-
-			//glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, img.Width(), img.Height(), 0, GL_RGB, GL_UNSIGNED_BYTE, img.Data());
+			const GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + i;
+			GLint faceLevels = 0;
+
+			if (bwxGLCompressedImage::IsContainer(faces[i]))
+			{
+				LoadCompressedFace(target, faces[i], faceLevels);
+			}
+			else
+			{
+				bwxGLImgLoader img;
+				if (img.Load(faces[i]))
+				{
+					const GLenum format = img.GetBytesPerPixel() == 4 ? GL_RGBA : GL_RGB;
+					glTexImage2D(target, 0, format, img.Width(), img.Height(), 0, format, GL_UNSIGNED_BYTE, img.Data().data());
+					faceLevels = 1;
+				}
+				else
+				{
+					std::cerr << "SkyBox: Cannot load face " << faces[i] << std::endl;
+				}
+			}
+
+			levels = i == 0 ? faceLevels : std::min(levels, faceLevels);
 		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, std::max(levels - 1, 0));
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 
-	void bwxGLSkyBox::Render(glm::mat4* PV)
+	bool bwxGLSkyBox::LoadCompressedFace(GLenum target, const std::string& file, GLint& levels)
+	{
+		bwxGLCompressedImage image;
+		if (!image.Load(wxString::FromUTF8(file)) || image.GetLevelCount() == 0)
+		{
+			std::cerr << "SkyBox: Cannot load face " << file << std::endl;
+			return false;
+		}
+		if (!bwxGLCompressedImage::IsFormatSupported(image.GetFormat()))
+		{
+			std::cerr << "SkyBox: Format 0x" << std::hex << image.GetFormat() << std::dec << " is not supported by the driver: " << file << std::endl;
+			return false;
+		}
+
+		// Stored levels as they are - no mip generation for compressed data
+		const GLenum pixelFormat = image.HasAlpha() ? GL_RGBA : GL_RGB;
+		for (size_t i = 0; i < image.GetLevelCount(); ++i)
+		{
+			const bwxGLImageLevel& level = image.GetLevel(i);
+			if (image.IsCompressed())
+			{
+				glCompressedTexImage2D(target, static_cast<GLint>(i), image.GetFormat(), level.width, level.height, 0,
+					static_cast<GLsizei>(level.size), image.GetLevelData(i));
+			}
+			else
+			{
+				glTexImage2D(target, static_cast<GLint>(i), image.GetFormat(), level.width, level.height, 0, pixelFormat,
+					GL_UNSIGNED_BYTE, image.GetLevelData(i));
+			}
+		}
+
+		levels = static_cast<GLint>(image.GetLevelCount());
+		return true;
+	}
+
+	std::unique_ptr<bwxGLShaderProgram> bwxGLSkyBox::CreateProgram(const char* vertex, const char* fragment)
 	{
+		bwxGLShader vertexShader(bwxGL_SHADER_TYPE::SHADER_VERTEX, vertex);
+		bwxGLShader fragmentShader(bwxGL_SHADER_TYPE::SHADER_FRAGMENT, fragment);
+		auto program = std::make_unique<bwxGLShaderProgram>();
+		program->AttachShader(vertexShader);
+		program->AttachShader(fragmentShader);
+		if (!program->Link()) return nullptr;
+
+		program->Bind();
+		program->SetUniform("skybox", 0);
+		program->Unbind();
+		return program;
+	}
+
+	void bwxGLSkyBox::Render(const glm::mat4& view, const glm::mat4& projection)
+	{
+		// Rotation only - the sky stays at infinity
+		const glm::mat4 PV = projection * glm::mat4(glm::mat3(view));
+
+		if (m_geometry == bwxGL_SKYBOX_GEOMETRY::CUBE)
+		{
+			glm::mat4 matrix = PV;
+			Render(&matrix);
+			return;
+		}
+
+		bwxGL_PROFILE_SCOPE("SkyBox");
+
+		if (!m_triangleProgram) m_triangleProgram = CreateProgram(FullScreenSkyBoxVertexShader(), FullScreenSkyBoxFragmentShader());
+		if (!m_triangleProgram) return;
+
+		GLint depthFunc = GL_LESS;
+		GLboolean depthMask = GL_TRUE;
+		glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+		glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
 		glDepthFunc(GL_LEQUAL);
 		glDepthMask(GL_FALSE);
 
-		//shader->Bind();
+		m_triangleProgram->Bind();
+		m_triangleProgram->SetUniform("invViewProjection", glm::inverse(PV));
+
+		// The positions come from gl_VertexID; core profiles still want a VAO bound
+		glBindVertexArray(VAO);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		bwxGLProfiler::GetInstance().AddDrawCalls();
+		glBindVertexArray(0);
+
+		m_triangleProgram->Unbind();
+
+		glDepthMask(depthMask);
+		glDepthFunc(static_cast<GLenum>(depthFunc));
+	}
+
+	void bwxGLSkyBox::Render(glm::mat4* PV)
+	{
+		bwxGL_PROFILE_SCOPE("SkyBox");
 
-		//shader->SetMat4("PV", 1, GL_FALSE, PV[0][0]);
+		glDepthFunc(GL_LEQUAL);
+		glDepthMask(GL_FALSE);
+
+		if (m_program)
+		{
+			m_program->Bind();
+			m_program->SetUniform("PV", *PV);
+		}
 
 		glBindVertexArray(VAO);
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 		glDrawArrays(GL_TRIANGLES, 0, 36);
+		bwxGLProfiler::GetInstance().AddDrawCalls();
 		glBindVertexArray(0);
 
-		//shader->Unbind();
+		if (m_program) m_program->Unbind();
 
 		glDepthMask(GL_TRUE);
 		glDepthFunc(GL_LESS);
@@ -181,6 +338,8 @@ namespace bwx_sdk {
 
 	void bwxGLSkyBox::UseDefaultSkyBoxShader()
 	{
+		m_program = CreateProgram(DefaultSkyBoxVertexShader(), DefaultSkyBoxFragmentShader());
+
 		//shader = new bwxGLShader(bwxGLSkyBox::DefaultSkyBoxVertexShader(), 0, 0, 0, bwxGLSkyBox::DefaultSkyBoxFragmentShader());
 		//shader->Bind();
 		//shader->AddUniform("view");
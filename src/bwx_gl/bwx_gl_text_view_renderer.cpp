@@ -0,0 +1,392 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_text_view_renderer.cpp
+// Purpose:     BWX_SDK Library; OpenGL Full View renderer for bwxTextEditor
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader_generator.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_text_view_renderer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_utils.h>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        std::string FontKey(const wxString& faceName, bool bold, bool italic) {
+            std::string key(faceName.Lower().utf8_str());
+            key += bold ? "|b" : "|-";
+            key += italic ? "i" : "-";
+            return key;
+        }
+
+        glm::vec4 ToColor(const wxColour& colour, int alpha) {
+            return glm::vec4(colour.Red(), colour.Green(), colour.Blue(), alpha) / 255.0f;
+        }
+
+    }
+
+    bwxGLTextViewRenderer::~bwxGLTextViewRenderer() {
+        Detach();
+    }
+
+    void bwxGLTextViewRenderer::Attach(wxWindow* host) {
+        Detach();
+        m_host = host;
+        if (!m_host) return;
+
+        const wxGLAttributes canvasAttrs = bwxGLUtils::GetDefaultCanvasAttrs();
+        if (!wxGLCanvas::IsDisplaySupported(canvasAttrs)) {
+            wxLogWarning("GLTextViewRenderer: OpenGL display not supported, drawing with wxDC.");
+            return;
+        }
+
+        m_canvas = new wxGLCanvas(m_host, canvasAttrs, wxID_ANY, wxPoint(0, 0), m_host->GetClientSize());
+        m_canvas->SetBackgroundStyle(wxBG_STYLE_PAINT);
+
+        const wxGLContextAttrs contextAttrs = bwxGLUtils::GetDefaultContextAttrs(4, 5);
+        m_context = std::make_unique<wxGLContext>(m_canvas, nullptr, &contextAttrs);
+        if (!m_context->IsOK()) {
+            wxLogWarning("GLTextViewRenderer: Cannot create OpenGL 4.5 context, drawing with wxDC.");
+            m_context.reset();
+            m_canvas->Destroy();
+            m_canvas = nullptr;
+            return;
+        }
+
+        m_canvas->Bind(wxEVT_PAINT, &bwxGLTextViewRenderer::OnCanvasPaint, this);
+        m_canvas->Bind(wxEVT_SET_FOCUS, &bwxGLTextViewRenderer::OnCanvasFocus, this);
+        for (wxEventType type : { wxEVT_LEFT_DOWN, wxEVT_LEFT_UP, wxEVT_LEFT_DCLICK, wxEVT_MOTION, wxEVT_MOUSEWHEEL,
+                                  wxEVT_RIGHT_DOWN, wxEVT_RIGHT_UP, wxEVT_MIDDLE_DOWN }) {
+            m_canvas->Bind(type, &bwxGLTextViewRenderer::OnCanvasMouse, this);
+        }
+    }
+
+    void bwxGLTextViewRenderer::Detach() {
+        if (m_canvas) {
+            if (m_context && m_glReady) {
+                m_canvas->SetCurrent(*m_context);
+                ReleaseGL();
+            }
+            m_context.reset();
+            m_canvas->Destroy();
+            m_canvas = nullptr;
+        }
+        m_glReady = false;
+        m_host = nullptr;
+    }
+
+    void bwxGLTextViewRenderer::ReleaseGL() {
+        ResetStyleFonts();
+        m_fonts.clear();
+
+        if (m_rectBuffer) m_rectBuffer->Release();
+        m_rectBuffer.reset();
+        m_rectProgram.reset();
+    }
+
+    void bwxGLTextViewRenderer::RenderArea(wxDC& dc, const wxRect& clientRect, int scrollY, const wxRect& updateRect) {
+        if (!m_canvas) {
+            FullViewRenderer::RenderArea(dc, clientRect, scrollY, updateRect);
+            return;
+        }
+
+        // The host is hidden behind the canvas; draw there instead, whole
+        m_scrollY = scrollY;
+        m_canvas->Refresh(false);
+    }
+
+    wxRect bwxGLTextViewRenderer::UpdateLayout(int scrollY, const wxRect& clientRect) {
+        m_scrollY = scrollY;
+        return FullViewRenderer::UpdateLayout(scrollY, clientRect);
+    }
+
+    void bwxGLTextViewRenderer::OnResize(int width, int height) {
+        FullViewRenderer::OnResize(width, height);
+        if (m_canvas) m_canvas->SetSize(0, 0, width, height);
+    }
+
+    void bwxGLTextViewRenderer::SetDocument(gui::bwxTextDocument* doc) {
+        // Style IDs belong to the document
+        ResetStyleFonts();
+        FullViewRenderer::SetDocument(doc);
+    }
+
+    void bwxGLTextViewRenderer::SetFontFile(const wxString& faceName, const std::string& path, bool bold, bool italic) {
+        m_fontFiles[FontKey(faceName, bold, italic)] = path;
+        ResetStyleFonts();
+    }
+
+    void bwxGLTextViewRenderer::SetDefaultFontFile(const std::string& path) {
+        m_defaultFontFile = path;
+        ResetStyleFonts();
+    }
+
+    void bwxGLTextViewRenderer::ResetStyleFonts() {
+        m_styleFonts.clear();
+        m_styleResolved.clear();
+    }
+
+    bwxGLTextViewRenderer::Font* bwxGLTextViewRenderer::GetStyleFont(int styleId) {
+        const int styleCount = m_document->GetStyleCount();
+        if (styleId < 0 || styleId >= styleCount) styleId = gui::TextStyleTable::DefaultStyle;
+
+        // Styles interned since last call get empty slots
+        if (styleId >= static_cast<int>(m_styleResolved.size())) {
+            m_styleFonts.resize(styleCount, nullptr);
+            m_styleResolved.resize(styleCount, false);
+        }
+
+        if (!m_styleResolved[styleId]) {
+            const gui::TextFormat& format = m_document->GetStyle(styleId);
+
+            std::string path = m_defaultFontFile;
+            auto it = m_fontFiles.find(FontKey(format.fontName, format.bold, format.italic));
+            if (it == m_fontFiles.end()) it = m_fontFiles.find(FontKey(format.fontName, false, false));
+            if (it != m_fontFiles.end()) path = it->second;
+
+            m_styleFonts[styleId] = path.empty() ? nullptr : LoadFont(path);
+            m_styleResolved[styleId] = true;
+
+            if (!m_styleFonts[styleId]) {
+                wxLogWarning("GLTextViewRenderer: No font file for \"%s\", its text is not drawn.", format.fontName);
+            }
+        }
+
+        return m_styleFonts[styleId];
+    }
+
+    bwxGLTextViewRenderer::Font* bwxGLTextViewRenderer::LoadFont(const std::string& path) {
+        auto it = m_fonts.find(path);
+        if (it != m_fonts.end()) return it->second.get();
+
+        // One distance-field atlas serves every size of the face
+        auto font = std::make_unique<Font>();
+        font->ttf = std::make_unique<bwxGLTTF>();
+        if (!font->ttf->LoadFromFile(path, bwxGL_TEXT_VIEW_ATLAS_PIXELS, bwxGL_TTF_MODE::TTF_SDF)) {
+            wxLogWarning("GLTextViewRenderer: Cannot load font %s.", path);
+            m_fonts[path] = nullptr;
+            return nullptr;
+        }
+        font->text = std::make_unique<bwxGLText>(*font->ttf);
+
+        Font* loaded = font.get();
+        m_fonts[path] = std::move(font);
+        return loaded;
+    }
+
+    bool bwxGLTextViewRenderer::MakeCurrent() {
+        if (!m_context) return false;
+
+        m_canvas->SetCurrent(*m_context);
+        if (!m_glReady) {
+            glewExperimental = GL_TRUE;
+            GLenum err = glewInit();
+            if (err != GLEW_OK) {
+                wxLogError("GLTextViewRenderer: %s", wxString(glewGetErrorString(err)));
+                return false;
+            }
+            m_glReady = true;
+        }
+        return true;
+    }
+
+    void bwxGLTextViewRenderer::OnCanvasPaint(wxPaintEvent& WXUNUSED(event)) {
+        wxPaintDC dc(m_canvas);
+        if (!MakeCurrent()) return;
+
+        Draw();
+        m_canvas->SwapBuffers();
+    }
+
+    void bwxGLTextViewRenderer::OnCanvasMouse(wxMouseEvent& event) {
+        // Canvas covers the client area at (0, 0), so positions are the host's as they are
+        wxMouseEvent forwarded(event);
+        forwarded.SetEventObject(m_host);
+        forwarded.SetId(m_host->GetId());
+        m_host->GetEventHandler()->ProcessEvent(forwarded);
+    }
+
+    void bwxGLTextViewRenderer::OnCanvasFocus(wxFocusEvent& WXUNUSED(event)) {
+        // Keyboard input belongs to the editor
+        m_host->SetFocus();
+    }
+
+    void bwxGLTextViewRenderer::Draw() {
+        BWX_METRIC_SCOPE_TIME("gui.text.gl_render_ms");
+
+        const wxSize size = m_canvas->GetClientSize();
+        const double contentScale = m_canvas->GetContentScaleFactor();
+        glViewport(0, 0, static_cast<GLsizei>(size.x * contentScale), static_cast<GLsizei>(size.y * contentScale));
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        if (!m_document) return;
+
+        CalculateLayout();
+        LayoutVisible(GetMeasureDC(), m_scrollY, size.y);
+
+        m_surfaceHeight = size.y;
+        const glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(size.x), 0.0f, static_cast<float>(size.y));
+
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        int firstParagraph, lastParagraph;
+        GetVisibleParagraphRange(m_scrollY, size.y, firstParagraph, lastParagraph);
+
+        // Highlights of visible paragraphs, then selection - under the text
+        if (!m_highlights.empty() && firstParagraph <= lastParagraph) {
+            const int startPos = m_document->GetLineStart(firstParagraph);
+            const int endPos = m_document->GetLineEnd(lastParagraph);
+            const glm::vec4 color = ToColor(m_highlightColor, m_selectionOpacity);
+
+            auto it = std::lower_bound(m_highlights.begin(), m_highlights.end(), startPos,
+                                       [](const gui::TextRange& range, int pos) { return range.endPos <= pos; });
+            for (; it != m_highlights.end() && it->startPos < endPos; ++it) {
+                for (wxRect rect : GetSelectionRects(it->startPos, it->endPos)) {
+                    rect.y -= m_scrollY;
+                    QueueRect(m_underlay, rect, color);
+                }
+            }
+        }
+
+        const gui::Selection selection = m_document->GetSelection();
+        if (selection.active && !selection.IsEmpty()) {
+            const glm::vec4 color = ToColor(m_selectionColor, m_selectionOpacity);
+            for (wxRect rect : GetSelectionRects(selection.GetMin(), selection.GetMax())) {
+                rect.y -= m_scrollY;
+                QueueRect(m_underlay, rect, color);
+            }
+        }
+
+        DrawRects(m_underlay, projection);
+
+        // Glyphs of every visible line, one batch per font file
+        for (int paragraph = firstParagraph; paragraph <= lastParagraph; ++paragraph) {
+            const ParagraphLayout& layout = m_paragraphs[paragraph];
+            const int paragraphStart = m_document->GetLineStart(paragraph);
+            const int yPos = GetParagraphY(paragraph) - m_scrollY;
+
+            for (const LayoutLine& line : layout.lines) {
+                if (yPos + line.y + line.height > 0 && yPos + line.y < size.y) QueueLine(layout, line, paragraphStart, yPos);
+            }
+        }
+
+        for (auto& [path, font] : m_fonts) {
+            if (font) font->text->Flush(projection);
+        }
+
+        // Caret as in the wxDC view: 1px line over the character height
+        if (m_cursorVisible) {
+            wxRect cursorRect = GetCursorRect(m_document->GetCursor().position);
+            if (!cursorRect.IsEmpty()) {
+                QueueRect(m_overlay, wxRect(cursorRect.x, cursorRect.y - m_scrollY, 1, cursorRect.height + 1),
+                          glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            }
+        }
+
+        DrawRects(m_overlay, projection);
+
+        glDisable(GL_BLEND);
+    }
+
+    void bwxGLTextViewRenderer::QueueLine(const ParagraphLayout& layout, const LayoutLine& line, int paragraphStart, int yPos) {
+        const int lineStart = paragraphStart + line.startPos;
+        const int lineEnd = paragraphStart + line.endPos;
+        const int top = yPos + line.y;
+        const std::wstring text = m_document->GetText(lineStart, lineEnd).ToStdWstring();
+
+        wxDC& dc = GetMeasureDC();
+        const double pixelsPerPoint = dc.GetPPI().y / 72.0;
+
+        auto queueRun = [&](int runStart, int runEnd, int styleId) {
+            // Ascent of the wxDC font, so the baseline is where the editor measured it
+            const StyleCache& style = SelectStyle(dc, styleId);
+            const gui::TextFormat& format = m_document->GetStyle(styleId);
+            const glm::vec4 color = ToColor(format.textColor, 255);
+            const GLfloat baseline = static_cast<GLfloat>(m_surfaceHeight - (top + style.ascent));
+
+            if (Font* font = GetStyleFont(styleId)) {
+                const GLfloat scale = static_cast<GLfloat>(format.fontSize * pixelsPerPoint / bwxGL_TEXT_VIEW_ATLAS_PIXELS);
+                for (int i = runStart; i < runEnd; ++i) {
+                    if (text[i] <= L' ') continue;
+                    const GLfloat x = static_cast<GLfloat>(m_marginLeft + layout.GetEdge(line, i));
+                    font->text->QueueGlyph(text[i], glm::vec2(x, baseline), scale, color);
+                }
+            }
+
+            if (format.underline) {
+                const int x = m_marginLeft + layout.GetEdge(line, runStart);
+                QueueRect(m_overlay, wxRect(x, top + style.ascent + 1, m_marginLeft + layout.GetEdge(line, runEnd) - x, 1), color);
+            }
+        };
+
+        bool anyRun = false;
+        m_document->ForEachFormatRun(lineStart, lineEnd, [&](int runStartPos, int runEndPos, int styleId) {
+            queueRun(runStartPos - lineStart, runEndPos - lineStart, styleId);
+            anyRun = true;
+        });
+
+        if (!anyRun) queueRun(0, static_cast<int>(text.size()), gui::TextStyleTable::DefaultStyle);
+    }
+
+    void bwxGLTextViewRenderer::QueueRect(std::vector<GLfloat>& rects, const wxRect& rect, const glm::vec4& color) const {
+        const GLfloat y = static_cast<GLfloat>(m_surfaceHeight - rect.y - rect.height);
+        rects.insert(rects.end(), { static_cast<GLfloat>(rect.x), y, static_cast<GLfloat>(rect.width), static_cast<GLfloat>(rect.height),
+                                    color.r, color.g, color.b, color.a });
+    }
+
+    void bwxGLTextViewRenderer::DrawRects(std::vector<GLfloat>& rects, const glm::mat4& projection) {
+        if (rects.empty()) return;
+
+        if (!m_rectProgram) {
+            m_rectProgram = std::make_shared<bwxGLShaderProgram>();
+            m_rectProgram->AttachShader(bwxGLShader(SHADER_VERTEX, bwxGLShaderGenerator::GetRectVertexShader()));
+            m_rectProgram->AttachShader(bwxGLShader(SHADER_FRAGMENT, bwxGLShaderGenerator::GetRectFragmentShader()));
+            if (m_rectProgram->Link()) {
+                m_rectProgram->Bind();
+                m_rectProgram->AddUniform("projection");
+                m_rectProgram->Unbind();
+            }
+        }
+
+        const GLsizeiptr size = static_cast<GLsizeiptr>(rects.size() * sizeof(GLfloat));
+        if (!m_rectBuffer) {
+            // Attributes advance per instance, the four corners come from gl_VertexID
+            m_rectBuffer = std::make_unique<bwxGLBuffer>(size, bwxGL_TEXT_VIEW_RECT_FLOATS, std::vector<GLint>{ 4, 4 },
+                                                         GL_ARRAY_BUFFER, GL_STREAM_DRAW);
+            glBindVertexArray(m_rectBuffer->GetVAO());
+            glVertexAttribDivisor(0, 1);
+            glVertexAttribDivisor(1, 1);
+            glBindVertexArray(0);
+        }
+        m_rectBuffer->SetData(rects.data(), size, GL_STREAM_DRAW);
+
+        m_rectProgram->Bind();
+        m_rectProgram->SetUniform("projection", projection);
+
+        glBindVertexArray(m_rectBuffer->GetVAO());
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(rects.size() / bwxGL_TEXT_VIEW_RECT_FLOATS));
+        bwxGLProfiler::GetInstance().AddDrawCalls();
+        bwxGLProfiler::GetInstance().AddUploadedBytes(static_cast<uint64_t>(size));
+        glBindVertexArray(0);
+
+        m_rectProgram->Unbind();
+        rects.clear();
+    }
+
+} // namespace bwx_sdk
@@ -20,6 +20,7 @@
 #include <string>
 
 #include <bwx_sdk/bwx_core/bwx_math.h>
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_image_loader.h>
 
 namespace bwx_sdk {
@@ -44,6 +45,20 @@ namespace bwx_sdk {
         Delete();  // Delete old texture (if exists)
 
         m_data.path = file;
+        m_params = { wrapS, wrapT, filterMin, filterMag, mipmaps, srgb };
+
+        // KTX2 / DDS: pre-compressed levels straight to GL
+        if (bwxGLCompressedImage::IsContainer(file)) {
+            bwxGLCompressedImage image;
+            if (!image.Load(file)) {
+                std::cerr << "Failed to load texture: " << file << std::endl;
+                return;
+            }
+
+            glGenTextures(1, &m_data.textureID);
+            if (!Upload(image)) Delete();
+            return;
+        }
 
         // Load image
         bwxGLImgLoader img;
@@ -52,31 +67,122 @@ namespace bwx_sdk {
             return;
         }
 
+        glGenTextures(1, &m_data.textureID);
+        Upload(img.Width(), img.Height(), img.HasAlpha(), img.Data().data());
+    }
+
+    void bwxGLTexture2D::CreatePlaceholder(const wxString& file, const bwxGLTextureParams& params)
+    {
+        Delete();
+
+        m_data.path = file;
+        m_params = params;
+
         glGenTextures(1, &m_data.textureID);
         glBindTexture(GL_TEXTURE_2D, m_data.textureID);
+        ApplyParameters();
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterMin);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterMag);
+        // Single texel, no mipmaps - complete for any min filter
+        const GLuint texel = bwxGL_TEXTURE_PLACEHOLDER_COLOR;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &texel);
+        SetMemoryBytes(sizeof(texel));
+
+        this->Unbind();
+        m_pending = true;
+    }
+
+    void bwxGLTexture2D::Upload(int width, int height, bool alpha, const void* pixels)
+    {
+        m_pending = false;
+        if (!m_data.textureID) return;
+
+        glBindTexture(GL_TEXTURE_2D, m_data.textureID);
+        ApplyParameters();
 
         // Format
-        GLenum format = img.HasAlpha() ? GL_RGBA : GL_RGB;
-        GLenum internalFormat = srgb ? (img.HasAlpha() ? GL_SRGB8_ALPHA8 : GL_SRGB8) : format;
+        GLenum format = alpha ? GL_RGBA : GL_RGB;
+        GLenum internalFormat = m_params.srgb ? (alpha ? GL_SRGB8_ALPHA8 : GL_SRGB8) : format;
+
+		// Texture data; RGB rows are tightly packed
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-		// Texture data
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, img.Width(), img.Height(), 0, format, GL_UNSIGNED_BYTE, img.Data().data());
+        // Drivers pad RGB to four bytes per texel; a mip chain adds a third
+        size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+        if (m_params.mipmaps) bytes += bytes / 3;
+        SetMemoryBytes(bytes);
 
-        if (mipmaps)
+        if (m_params.mipmaps)
         {
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 4);
             glGenerateMipmap(GL_TEXTURE_2D);
         }
+        else
+        {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        }
 
         this->Unbind();
     }
 
+    bool bwxGLTexture2D::Upload(const bwxGLCompressedImage& image)
+    {
+        m_pending = false;
+        if (!m_data.textureID || image.GetLevelCount() == 0) return false;
+
+        const GLenum format = m_params.srgb ? bwxGLCompressedImage::ToSRGB(image.GetFormat()) : image.GetFormat();
+        if (!bwxGLCompressedImage::IsFormatSupported(format)) {
+            std::cerr << "Texture format 0x" << std::hex << format << std::dec << " is not supported by the driver: " << m_data.path << std::endl;
+            return false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, m_data.textureID);
+        ApplyParameters();
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        const GLenum pixelFormat = image.HasAlpha() ? GL_RGBA : GL_RGB;
+        size_t bytes = 0;
+        for (size_t i = 0; i < image.GetLevelCount(); ++i) {
+            const bwxGLImageLevel& level = image.GetLevel(i);
+            bytes += level.size;
+            if (image.IsCompressed()) {
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), format, level.width, level.height, 0,
+                    static_cast<GLsizei>(level.size), image.GetLevelData(i));
+            }
+            else {
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), format, level.width, level.height, 0, pixelFormat,
+                    GL_UNSIGNED_BYTE, image.GetLevelData(i));
+            }
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        // Stored chain as is; only an uncompressed single level can still get mipmaps here
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        if (image.GetLevelCount() == 1 && m_params.mipmaps && !image.IsCompressed()) {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 4);
+            glGenerateMipmap(GL_TEXTURE_2D);
+            bytes += bytes / 3;
+        }
+        else {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.GetLevelCount() - 1));
+        }
+        SetMemoryBytes(bytes);
+
+        this->Unbind();
+        return true;
+    }
+
+    void bwxGLTexture2D::ApplyParameters() const
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_params.wrapS);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_params.wrapT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_params.filterMin);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_params.filterMag);
+    }
+
     void bwxGLTexture2D::Bind(int index)
     {
         glActiveTexture(GL_TEXTURE0 + index);
@@ -110,6 +216,15 @@ namespace bwx_sdk {
             glDeleteTextures(1, &m_data.textureID);
             m_data.textureID = 0;
         }
+        SetMemoryBytes(0);
+        m_pending = false;
+    }
+
+    void bwxGLTexture2D::SetMemoryBytes(size_t bytes)
+    {
+        if (bytes == m_memoryBytes) return;
+        BWX_METRIC_GAUGE("gl.textures.vram_bytes").Add(static_cast<int64_t>(bytes) - static_cast<int64_t>(m_memoryBytes));
+        m_memoryBytes = bytes;
     }
 
 } // namespace bwx_sdk
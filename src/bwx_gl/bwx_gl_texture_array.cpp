@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_array.cpp
+// Purpose:     BWX_SDK Library; OpenGL Texture array of same-size textures
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_array.h>
+
+namespace bwx_sdk {
+
+    bwxGLTextureArray::bwxGLTextureArray(GLsizei width, GLsizei height, GLenum internalFormat, GLsizei levels, GLsizei capacity)
+        : m_width(width), m_height(height), m_format(internalFormat), m_levels(std::max<GLsizei>(levels, 1)),
+          m_capacity(std::max<GLsizei>(capacity, 1)) {
+    }
+
+    bwxGLTextureArray::~bwxGLTextureArray() {
+        if (m_texture) glDeleteTextures(1, &m_texture);
+    }
+
+    bool bwxGLTextureArray::IsSupported() {
+        return GLEW_VERSION_4_3 || (GLEW_ARB_copy_image && GLEW_ARB_texture_storage);
+    }
+
+    bool bwxGLTextureArray::Describe(const bwxGLTexture2D& texture, GLsizei& width, GLsizei& height, GLenum& internalFormat,
+        GLsizei& levels) {
+        if (!texture.GetID() || texture.IsPending()) return false;
+
+        GLint w = 0, h = 0, format = 0, maxLevel = 0;
+        glBindTexture(GL_TEXTURE_2D, texture.GetID());
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (w <= 0 || h <= 0) return false;
+
+        // MAX_LEVEL may point past the smallest level the texture really has
+        GLsizei fullChain = 1;
+        for (GLint size = std::max(w, h); size > 1; size /= 2) ++fullChain;
+
+        width = w;
+        height = h;
+        internalFormat = static_cast<GLenum>(format);
+        levels = std::min<GLsizei>(maxLevel + 1, fullChain);
+        return true;
+    }
+
+    bool bwxGLTextureArray::Matches(GLsizei width, GLsizei height, GLenum internalFormat, GLsizei levels) const {
+        return width == m_width && height == m_height && internalFormat == m_format && levels == m_levels;
+    }
+
+    GLuint bwxGLTextureArray::Allocate(GLsizei capacity, const bwxGLTextureParams& params) const {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_levels, m_format, m_width, m_height, capacity);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, params.wrapS);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, params.wrapT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, params.filterMin);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, params.filterMag);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return texture;
+    }
+
+    GLint bwxGLTextureArray::AddLayer(const bwxGLTexture2D& texture, const bwxGLTextureParams& params) {
+        GLsizei width, height, levels;
+        GLenum format;
+        if (!IsSupported() || !Describe(texture, width, height, format, levels)) return -1;
+        if (!Matches(width, height, format, levels)) return -1;
+
+        if (!m_texture) {
+            m_texture = Allocate(m_capacity, params);
+        }
+        else if (m_layers == m_capacity) {
+            // Immutable storage - grow into a new array and move the existing layers over on the GPU
+            const GLsizei capacity = m_capacity * 2;
+            GLuint grown = Allocate(capacity, params);
+            for (GLsizei level = 0; level < m_levels; ++level) {
+                glCopyImageSubData(m_texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+                    grown, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+                    std::max(m_width >> level, 1), std::max(m_height >> level, 1), m_layers);
+            }
+            glDeleteTextures(1, &m_texture);
+            m_texture = grown;
+            m_capacity = capacity;
+        }
+
+        const GLint layer = m_layers++;
+        for (GLsizei level = 0; level < m_levels; ++level) {
+            glCopyImageSubData(texture.GetID(), GL_TEXTURE_2D, level, 0, 0, 0,
+                m_texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+                std::max(m_width >> level, 1), std::max(m_height >> level, 1), 1);
+        }
+        return layer;
+    }
+
+    void bwxGLTextureArray::Bind(int unit) const {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+    }
+
+} // namespace bwx_sdk
@@ -0,0 +1,256 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_cooker.cpp
+// Purpose:     BWX_SDK Library; OpenGL Offline texture compression to DDS
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <wx/filename.h>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_cooker.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_image_loader.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        inline void WriteU32(unsigned char* p, uint32_t value) {
+            p[0] = static_cast<unsigned char>(value);
+            p[1] = static_cast<unsigned char>(value >> 8);
+            p[2] = static_cast<unsigned char>(value >> 16);
+            p[3] = static_cast<unsigned char>(value >> 24);
+        }
+
+        inline uint16_t To565(const GLubyte* c) {
+            return static_cast<uint16_t>(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 | ((c[2] * 31 + 127) / 255));
+        }
+
+        inline void From565(uint16_t c, int rgb[3]) {
+            const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+
+        // 2x2 box filter; odd sizes repeat the last row/column
+        std::vector<GLubyte> Downsample(const std::vector<GLubyte>& src, int width, int height, int& outWidth, int& outHeight) {
+            outWidth = std::max(width / 2, 1);
+            outHeight = std::max(height / 2, 1);
+
+            std::vector<GLubyte> dst(static_cast<size_t>(outWidth) * outHeight * 4);
+            for (int y = 0; y < outHeight; ++y) {
+                const int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+                for (int x = 0; x < outWidth; ++x) {
+                    const int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                    for (int c = 0; c < 4; ++c) {
+                        const int sum = src[(static_cast<size_t>(y0) * width + x0) * 4 + c] + src[(static_cast<size_t>(y0) * width + x1) * 4 + c] +
+                                        src[(static_cast<size_t>(y1) * width + x0) * 4 + c] + src[(static_cast<size_t>(y1) * width + x1) * 4 + c];
+                        dst[(static_cast<size_t>(y) * outWidth + x) * 4 + c] = static_cast<GLubyte>((sum + 2) / 4);
+                    }
+                }
+            }
+            return dst;
+        }
+    }
+
+    void bwxGLTextureCooker::EncodeBC1Block(const GLubyte rgba[64], unsigned char out[8]) {
+        // Principal axis of the block colours (power iteration on the covariance)
+        float mean[3] = { 0, 0, 0 };
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 3; ++c) mean[c] += rgba[i * 4 + c];
+        }
+        for (int c = 0; c < 3; ++c) mean[c] /= 16.0f;
+
+        float cov[6] = { 0, 0, 0, 0, 0, 0 }; // rr rg rb gg gb bb
+        for (int i = 0; i < 16; ++i) {
+            const float r = rgba[i * 4] - mean[0], g = rgba[i * 4 + 1] - mean[1], b = rgba[i * 4 + 2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 4; ++iteration) {
+            const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            const float length = std::max({ std::fabs(x), std::fabs(y), std::fabs(z) });
+            if (length <= 0.0f) break;
+            axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+        }
+
+        // Extreme texels along the axis become the endpoints
+        int minIndex = 0, maxIndex = 0;
+        float minDot = HUGE_VALF, maxDot = -HUGE_VALF;
+        for (int i = 0; i < 16; ++i) {
+            const float dot = rgba[i * 4] * axis[0] + rgba[i * 4 + 1] * axis[1] + rgba[i * 4 + 2] * axis[2];
+            if (dot < minDot) { minDot = dot; minIndex = i; }
+            if (dot > maxDot) { maxDot = dot; maxIndex = i; }
+        }
+
+        uint16_t c0 = To565(&rgba[maxIndex * 4]);
+        uint16_t c1 = To565(&rgba[minIndex * 4]);
+        if (c0 < c1) std::swap(c0, c1); // c0 > c1 selects the four colour mode
+
+        out[0] = static_cast<unsigned char>(c0);
+        out[1] = static_cast<unsigned char>(c0 >> 8);
+        out[2] = static_cast<unsigned char>(c1);
+        out[3] = static_cast<unsigned char>(c1 >> 8);
+
+        uint32_t indices = 0;
+        if (c0 != c1) {
+            int palette[4][3];
+            From565(c0, palette[0]);
+            From565(c1, palette[1]);
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            for (int i = 0; i < 16; ++i) {
+                int best = 0, bestDistance = INT32_MAX;
+                for (int p = 0; p < 4; ++p) {
+                    const int dr = rgba[i * 4] - palette[p][0], dg = rgba[i * 4 + 1] - palette[p][1], db = rgba[i * 4 + 2] - palette[p][2];
+                    const int distance = dr * dr + dg * dg + db * db;
+                    if (distance < bestDistance) { bestDistance = distance; best = p; }
+                }
+                indices |= static_cast<uint32_t>(best) << (i * 2);
+            }
+        }
+        WriteU32(out + 4, indices);
+    }
+
+    void bwxGLTextureCooker::EncodeBC3Block(const GLubyte rgba[64], unsigned char out[16]) {
+        int a0 = 0, a1 = 255;
+        for (int i = 0; i < 16; ++i) {
+            a0 = std::max<int>(a0, rgba[i * 4 + 3]);
+            a1 = std::min<int>(a1, rgba[i * 4 + 3]);
+        }
+
+        out[0] = static_cast<unsigned char>(a0);
+        out[1] = static_cast<unsigned char>(a1);
+
+        // a0 > a1: eight interpolated alpha values
+        uint64_t indices = 0;
+        if (a0 != a1) {
+            int palette[8] = { a0, a1 };
+            for (int i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+
+            for (int i = 0; i < 16; ++i) {
+                int best = 0, bestDistance = INT32_MAX;
+                for (int p = 0; p < 8; ++p) {
+                    const int distance = std::abs(rgba[i * 4 + 3] - palette[p]);
+                    if (distance < bestDistance) { bestDistance = distance; best = p; }
+                }
+                indices |= static_cast<uint64_t>(best) << (i * 3);
+            }
+        }
+        for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+
+        EncodeBC1Block(rgba, out + 8);
+    }
+
+    wxString bwxGLTextureCooker::GetCookedPath(const wxString& source) {
+        wxFileName name(source);
+        name.SetExt("dds");
+        return name.GetFullPath();
+    }
+
+    bool bwxGLTextureCooker::IsUpToDate(const wxString& source) {
+        const wxString cooked = GetCookedPath(source);
+        if (cooked == source || !wxFileName::FileExists(cooked)) return false;
+        if (!wxFileName::FileExists(source)) return true;
+
+        return wxFileName(cooked).GetModificationTime() >= wxFileName(source).GetModificationTime();
+    }
+
+    bool bwxGLTextureCooker::Cook(const wxString& source, const wxString& target, bool mipmaps) {
+        bwxGLImgLoader img;
+        if (!img.Decode(source)) {
+            std::cerr << "Failed to cook texture, cannot read: " << source << std::endl;
+            return false;
+        }
+
+        const bool alpha = img.HasAlpha();
+        const int bpp = img.GetBytesPerPixel();
+        int width = img.Width(), height = img.Height();
+
+        // Rows stay in the loader's GL order, so the cooked file uploads the same way as the source
+        std::vector<GLubyte> level(static_cast<size_t>(width) * height * 4);
+        const std::vector<GLubyte>& pixels = img.Data();
+        for (size_t i = 0, count = static_cast<size_t>(width) * height; i < count; ++i) {
+            for (int c = 0; c < 3; ++c) level[i * 4 + c] = pixels[i * bpp + c];
+            level[i * 4 + 3] = alpha ? pixels[i * bpp + 3] : 255;
+        }
+
+        const size_t blockBytes = alpha ? 16 : 8;
+        std::vector<unsigned char> payload;
+        uint32_t levelCount = 0;
+        size_t firstLevelSize = 0;
+
+        while (true) {
+            const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+            const size_t offset = payload.size();
+            payload.resize(offset + static_cast<size_t>(blocksX) * blocksY * blockBytes);
+            if (levelCount == 0) firstLevelSize = payload.size();
+
+            GLubyte block[64];
+            for (int by = 0; by < blocksY; ++by) {
+                for (int bx = 0; bx < blocksX; ++bx) {
+                    // Edge blocks repeat the last texel
+                    for (int y = 0; y < 4; ++y) {
+                        const int sy = std::min(by * 4 + y, height - 1);
+                        for (int x = 0; x < 4; ++x) {
+                            const int sx = std::min(bx * 4 + x, width - 1);
+                            std::copy_n(&level[(static_cast<size_t>(sy) * width + sx) * 4], 4, &block[(y * 4 + x) * 4]);
+                        }
+                    }
+
+                    unsigned char* dst = payload.data() + offset + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+                    if (alpha) EncodeBC3Block(block, dst);
+                    else EncodeBC1Block(block, dst);
+                }
+            }
+
+            ++levelCount;
+            if (!mipmaps || (width == 1 && height == 1)) break;
+            level = Downsample(level, width, height, width, height);
+        }
+
+        unsigned char header[128] = {};
+        WriteU32(header, 0x20534444);                               // "DDS "
+        WriteU32(header + 4, 124);
+        WriteU32(header + 8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000); // CAPS, HEIGHT, WIDTH, PIXELFORMAT, MIPMAPCOUNT, LINEARSIZE
+        WriteU32(header + 12, static_cast<uint32_t>(img.Height()));
+        WriteU32(header + 16, static_cast<uint32_t>(img.Width()));
+        WriteU32(header + 20, static_cast<uint32_t>(firstLevelSize));
+        WriteU32(header + 28, levelCount);
+        WriteU32(header + 76, 32);
+        WriteU32(header + 80, 0x4);                                 // DDPF_FOURCC
+        WriteU32(header + 84, alpha ? 0x35545844 : 0x31545844);     // "DXT5" / "DXT1"
+        WriteU32(header + 108, 0x1000 | (levelCount > 1 ? 0x400008 : 0)); // TEXTURE (+ COMPLEX | MIPMAP)
+
+        const wxString path = target.IsEmpty() ? GetCookedPath(source) : target;
+        std::ofstream out(path.fn_str(), std::ios::binary);
+        if (!out) {
+            std::cerr << "Failed to cook texture, cannot write: " << path << std::endl;
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        return static_cast<bool>(out);
+    }
+
+} // namespace bwx_sdk
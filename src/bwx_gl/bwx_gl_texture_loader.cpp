@@ -0,0 +1,310 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_loader.cpp
+// Purpose:     BWX_SDK Library; OpenGL Asynchronous texture loading
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_loader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_cooker.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_upload_worker.h>
+
+namespace bwx_sdk {
+
+    bwxGLTextureLoader& bwxGLTextureLoader::GetInstance() {
+        static bwxGLTextureLoader instance;
+        return instance;
+    }
+
+    bwxGLTextureLoader::bwxGLTextureLoader() {
+        // Constructed first, so the job system outlives the loader and its pending decodes
+        bwxJobSystem::GetInstance();
+    }
+
+    bwxGLTextureLoader::~bwxGLTextureLoader() {
+        bwxJobSystem::GetInstance().Wait(m_jobs);
+        for (auto& upload : m_uploads) Discard(upload);
+    }
+
+    void bwxGLTextureLoader::Enqueue(const std::shared_ptr<bwxGLTexture2D>& texture, bwxGL_IMG_ROTATE_MODE rotate) {
+        if (!texture) return;
+
+        // Same rule as bwxGLImgLoader::Load(), queried here because workers have no GL context
+        GLint textureCompression;
+        glGetIntegerv(GL_TEXTURE_COMPRESSION_HINT, &textureCompression);
+        const bool powerOf2 = textureCompression == GL_NICEST;
+
+        std::weak_ptr<bwxGLTexture2D> weak = texture;
+        wxString path = texture->GetPath();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_inFlight;
+        }
+
+        bwxJobSystem::GetInstance().Schedule([this, weak, path, rotate, powerOf2]() {
+            Decoded image;
+            image.texture = weak;
+            image.path = path;
+            image.rotate = rotate;
+
+            // GLEW capability flags are plain globals, safe to read here
+            const bool container = bwxGLCompressedImage::IsContainer(path);
+            if (container || (rotate == bwxGL_IMG_ROTATE_MODE::IMG_ROTATE0 && bwxGLTextureCooker::IsUpToDate(path))) {
+                auto compressed = std::make_shared<bwxGLCompressedImage>();
+                if (compressed->Load(container ? path : bwxGLTextureCooker::GetCookedPath(path)) &&
+                    bwxGLCompressedImage::IsFormatSupported(compressed->GetFormat())) {
+                    image.compressed = std::move(compressed);
+                    image.ok = true;
+                }
+            }
+
+            // Only decoded here; the pixels go straight into the PBO once the GL thread has mapped one
+            if (!image.ok && !container) {
+                auto img = std::make_shared<bwxGLImgLoader>();
+                image.ok = img->Open(path, rotate, powerOf2);
+                if (image.ok) {
+                    image.width = img->Width();
+                    image.height = img->Height();
+                    image.alpha = img->HasAlpha();
+                    image.source = std::move(img);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_inFlight;
+            m_decoded.push_back(std::move(image));
+        }, &m_jobs);
+    }
+
+    size_t bwxGLTextureLoader::Update(size_t byteBudget) {
+        size_t completed = 0;
+        size_t budget = byteBudget;
+
+        std::vector<Decoded> decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            decoded.swap(m_decoded);
+        }
+
+        const bool worker = bwxGLUploadWorker::GetInstance().IsRunning();
+
+        for (auto& image : decoded) {
+            auto texture = image.texture.lock();
+            if (!texture || !texture->IsPending()) continue;
+
+            if (image.ok && worker) {
+                UploadOnWorker(std::move(image), texture->GetParams());
+                continue;
+            }
+
+            if (!image.ok) {
+                // Keeps the placeholder, so whatever uses the texture still draws
+                wxLogError("Failed to load texture: %s", image.path);
+                std::cerr << "Failed to load texture: " << image.path << std::endl;
+                texture->m_pending = false;
+                continue;
+            }
+
+            if (image.compressed) {
+                if (!texture->Upload(*image.compressed)) {
+                    wxLogError("Failed to load texture: %s", image.path);
+                }
+                budget -= std::min(budget, image.compressed->GetDataSize());
+                ++completed;
+                continue;
+            }
+
+            Upload upload;
+            upload.image = std::move(image);
+            m_uploads.push_back(std::move(upload));
+        }
+
+        for (auto it = m_uploads.begin(); it != m_uploads.end();) {
+            // Deleted or recreated in the meantime
+            auto texture = it->image.texture.lock();
+            if (!texture || !texture->IsPending()) {
+                Discard(*it);
+                it = m_uploads.erase(it);
+                continue;
+            }
+
+            if (budget == 0) break;
+
+            if (Step(*it, budget)) {
+                ++completed;
+                it = m_uploads.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        return completed;
+    }
+
+    bool bwxGLTextureLoader::Step(Upload& upload, size_t& budget) {
+        const std::shared_ptr<bwxGLImgLoader> source = upload.image.source;
+        const size_t size = source->GetDataSize();
+
+        if (!upload.pbo) {
+            upload.pbo = new bwxGLBuffer(GL_PIXEL_UNPACK_BUFFER);
+            upload.mapped = static_cast<unsigned char*>(upload.pbo->MapWrite(static_cast<GLsizeiptr>(size), GL_STREAM_DRAW));
+
+            // The mapping stays across frames; unbound, so other pixel transfers are unaffected
+            upload.pbo->Unbind();
+            budget -= std::min(budget, size);
+
+            if (!upload.mapped) {
+                delete upload.pbo;
+                upload.pbo = nullptr;
+
+                // No mapping - one CPU copy and a plain upload
+                std::vector<GLubyte> pixels(size);
+                auto texture = upload.image.texture.lock();
+                if (texture && source->CopyTo(pixels.data(), pixels.size())) {
+                    texture->Upload(upload.image.width, upload.image.height, upload.image.alpha, pixels.data());
+                }
+                upload.image.source.reset();
+                return true;
+            }
+
+            // Mapped memory is ordinary memory to the worker; GL is not touched until Finish()
+            upload.copy = std::make_shared<CopyJob>();
+            std::shared_ptr<CopyJob> copy = upload.copy;
+            unsigned char* mapped = upload.mapped;
+            bwxJobSystem::GetInstance().Schedule([copy, source, mapped, size]() {
+                copy->ok = source->CopyTo(mapped, size);
+            }, &copy->counter);
+            return false;
+        }
+
+        if (!upload.copy->counter.IsDone()) return false;
+
+        Finish(upload);
+        return true;
+    }
+
+    void bwxGLTextureLoader::Finish(Upload& upload) {
+        auto texture = upload.image.texture.lock();
+        const bool copied = upload.copy && upload.copy->ok;
+
+        upload.pbo->Bind();
+        if (upload.pbo->Unmap() && copied) {
+            // Source is the bound PBO; the copy into the texture runs on the GPU
+            upload.pbo->Bind();
+            if (texture) texture->Upload(upload.image.width, upload.image.height, upload.image.alpha, nullptr);
+            upload.pbo->Unbind();
+        }
+        else if (texture && copied) {
+            // Storage lost while mapped and the decoded image is already freed - decode it again
+            upload.pbo->Unbind();
+            Enqueue(texture, upload.image.rotate);
+        }
+        else if (texture) {
+            upload.pbo->Unbind();
+            wxLogError("Failed to load texture: %s", upload.image.path);
+            texture->m_pending = false;
+        }
+
+        // GL keeps the storage alive until the pending transfer is done
+        delete upload.pbo;
+        upload.pbo = nullptr;
+        upload.mapped = nullptr;
+        upload.copy.reset();
+        upload.image.source.reset();
+    }
+
+    void bwxGLTextureLoader::UploadOnWorker(Decoded image, const bwxGLTextureParams& params) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_onWorker;
+        }
+
+        // The placeholder stays in use; the image goes into a new texture that takes its place when ready
+        auto staged = std::make_shared<bwxGLTexture2D>();
+        auto decoded = std::make_shared<Decoded>(std::move(image));
+
+        bwxGLUploadWorker::GetInstance().Submit(
+            [staged, decoded, params]() {
+                staged->m_data.path = decoded->path;
+                staged->m_params = params;
+                glGenTextures(1, &staged->m_data.textureID);
+
+                if (decoded->compressed) return staged->Upload(*decoded->compressed);
+
+                // Decoded image copied here, on the worker, instead of into a mapped PBO
+                std::vector<GLubyte> pixels(decoded->source->GetDataSize());
+                if (!decoded->source->CopyTo(pixels.data(), pixels.size())) return false;
+                staged->Upload(decoded->width, decoded->height, decoded->alpha, pixels.data());
+                return true;
+            },
+            [this, staged, decoded](bool ok) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    --m_onWorker;
+                }
+
+                // Deleted or recreated in the meantime; staged frees its texture
+                auto texture = decoded->texture.lock();
+                if (!texture || !texture->IsPending()) return;
+
+                if (!ok) {
+                    wxLogError("Failed to load texture: %s", decoded->path);
+                    texture->m_pending = false;
+                    return;
+                }
+
+                // The placeholder name leaves with staged
+                std::swap(texture->m_data.textureID, staged->m_data.textureID);
+                std::swap(texture->m_memoryBytes, staged->m_memoryBytes);
+                texture->m_pending = false;
+            });
+    }
+
+    void bwxGLTextureLoader::Discard(Upload& upload) {
+        if (!upload.pbo) return;
+
+        // The worker may still be writing into the mapping
+        if (upload.copy) bwxJobSystem::GetInstance().Wait(upload.copy->counter);
+        upload.copy.reset();
+
+        if (upload.mapped) {
+            upload.pbo->Bind();
+            upload.pbo->Unmap();
+        }
+        delete upload.pbo;
+        upload.pbo = nullptr;
+        upload.mapped = nullptr;
+    }
+
+    void bwxGLTextureLoader::Flush() {
+        auto& worker = bwxGLUploadWorker::GetInstance();
+        while (GetPendingCount() > 0) {
+            const size_t done = Update(std::numeric_limits<size_t>::max()) + worker.Update();
+            if (done == 0) std::this_thread::yield();
+        }
+    }
+
+    size_t bwxGLTextureLoader::GetPendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_inFlight + m_decoded.size() + m_uploads.size() + m_onWorker;
+    }
+
+} // namespace bwx_sdk
@@ -18,6 +18,12 @@
 
 #include <bwx_sdk/bwx_gl/bwx_gl_texture.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_texture_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_cooker.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_scene_cache.h>
+#include <bwx_sdk/bwx_core/bwx_file_watcher.h>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
 #include <iostream>
 
 namespace bwx_sdk {
@@ -27,16 +33,43 @@ namespace bwx_sdk {
         return instance;
     }
 
-    GLuint bwxGLTextureManager::LoadTexture(const std::string& filePath, bool generateMipmaps) {
+    GLuint bwxGLTextureManager::LoadTexture(const std::string& filePath, bool generateMipmaps, bool async) {
         
         // Return ID if texture exists
+        if (!IsOwnerThread()) {
+            if (GLuint id = GetTextureID(filePath)) return id;
+
+            // Worker thread: the placeholder is made by the next ProcessUploads(), decoding goes on as usual
+            QueueRequest(filePath, [this, filePath, generateMipmaps]() { LoadTexture(filePath, generateMipmaps, true); });
+            return 0;
+        }
+
         auto it = m_resources.find(filePath);
         if (it != m_resources.end()) {
             return it->second->GetID();
         }
 
-        // If not then load texture...
-		std::shared_ptr<bwxGLTexture2D> texture = std::make_shared<bwxGLTexture2D>(filePath);
+        // Placeholder now, decoding on the job system, upload in ProcessUploads()
+        if (async) {
+            std::shared_ptr<bwxGLTexture2D> texture = std::make_shared<bwxGLTexture2D>();
+            bwxGLTextureParams params;
+            params.mipmaps = generateMipmaps;
+            texture->CreatePlaceholder(filePath, params);
+
+            bwxGLTextureLoader::GetInstance().Enqueue(texture);
+            StoreResource(filePath, texture);
+            if (m_enableHotReload) WatchTexture(filePath);
+            return texture->GetID();
+        }
+
+        // If not then load texture - the cooked DDS first, when it is current and the driver takes its format...
+		std::shared_ptr<bwxGLTexture2D> texture;
+		if (bwxGLTextureCooker::IsUpToDate(filePath)) {
+			texture = std::make_shared<bwxGLTexture2D>(bwxGLTextureCooker::GetCookedPath(filePath), GL_REPEAT, GL_LINEAR, generateMipmaps);
+		}
+		if (!texture || !texture->GetID()) {
+			texture = std::make_shared<bwxGLTexture2D>(filePath, GL_REPEAT, GL_LINEAR, generateMipmaps);
+		}
 		if (!texture->GetID()) {
 			wxLogError("Failed to load texture: %s", filePath);
 			std::cerr << "Failed to load texture: " << filePath << std::endl;
@@ -44,10 +77,44 @@ namespace bwx_sdk {
 		}
 
 		// ...and store it
-		m_resources[filePath] = texture;
+		StoreResource(filePath, texture);
+		if (m_enableHotReload) WatchTexture(filePath);
         return texture->GetID();
     }
 
+	size_t bwxGLTextureManager::ProcessUploads(size_t byteBudget) {
+		ProcessLoadRequests();
+		return bwxGLTextureLoader::GetInstance().Update(byteBudget);
+	}
+
+	std::string bwxGLTextureManager::ResolveTexturePath(const std::string& filePath) {
+		auto it = m_resolvedPaths.find(filePath);
+		if (it != m_resolvedPaths.end()) return it->second;
+
+		// "..", links and paths relative to different directories end up at one path...
+		std::error_code error;
+		const std::filesystem::path canonical = std::filesystem::weakly_canonical(filePath, error);
+		std::string key = error ? std::filesystem::path(filePath).lexically_normal().string() : canonical.string();
+
+		// ...and copies of one image at one texture; a file loaded already keeps its own
+		if (const uint64_t hash = bwxGLSceneCache::HashFile(key)) {
+			auto [content, inserted] = m_contentKeys.emplace(hash, key);
+			if (!inserted && content->second != key && m_resources.find(key) == m_resources.end()) key = content->second;
+		}
+
+		m_resolvedPaths.emplace(filePath, key);
+		return key;
+	}
+
+	void bwxGLTextureManager::ForgetContent(const std::string& filePath) {
+		for (auto it = m_resolvedPaths.begin(); it != m_resolvedPaths.end();) {
+			it = it->second == filePath ? m_resolvedPaths.erase(it) : std::next(it);
+		}
+		for (auto it = m_contentKeys.begin(); it != m_contentKeys.end();) {
+			it = it->second == filePath ? m_contentKeys.erase(it) : std::next(it);
+		}
+	}
+
 	void bwxGLTextureManager::BindTexture(const std::string& filePath, int textureUnit) {
 		auto it = m_resources.find(filePath);
 		if (it != m_resources.end()) {
@@ -62,14 +129,60 @@ namespace bwx_sdk {
 	}
 
 	void bwxGLTextureManager::DeleteTexture(const std::string& filePath) {
+		ReleaseLocation(filePath);
+		ForgetContent(filePath);
+		bwxFileWatcher::GetInstance().Unwatch(filePath, this);
+		m_watched.erase(filePath);
+
 		auto it = m_resources.find(filePath);
 		if (it != m_resources.end()) {
 			it->second->Delete();
-			m_resources.erase(it);
+			EraseResource(it);
 		}
 	}
 
+	void bwxGLTextureManager::EnableHotReload(bool enabled) {
+		m_enableHotReload = enabled;
+		if (!enabled) {
+			bwxFileWatcher::GetInstance().UnwatchAll(this);
+			m_watched.clear();
+			return;
+		}
+
+		for (const auto& [path, texture] : m_resources) {
+			WatchTexture(path);
+		}
+	}
+
+	void bwxGLTextureManager::WatchTexture(const std::string& filePath) {
+		// Textures are keyed by their path; files already watched are skipped
+		if (m_watched.count(filePath)) return;
+		if (bwxFileWatcher::GetInstance().Watch(filePath, this, [this, filePath](const std::string&) { ReloadTexture(filePath); })) {
+			m_watched.insert(filePath);
+		}
+	}
+
+	bool bwxGLTextureManager::ReloadTexture(const std::string& filePath) {
+		auto it = m_resources.find(filePath);
+		if (it == m_resources.end()) return false;
+
+		// A new texture object: one made resident for bindless access can no longer be respecified.
+		// Materials refer to textures by path, so they pick it up; the array copy is dropped until the next build.
+		// The content changed, so paths resolved to it by their content are looked at again
+		ReleaseLocation(filePath);
+		ForgetContent(filePath);
+
+		auto texture = std::make_shared<bwxGLTexture2D>();
+		texture->CreatePlaceholder(filePath, it->second->GetParams());
+		bwxGLTextureLoader::GetInstance().Enqueue(texture);
+		StoreResource(filePath, texture);
+
+		wxLogMessage("[TextureManager] Hot reloading texture: %s", filePath);
+		return true;
+	}
+
 	std::shared_ptr<bwxGLTexture2D> bwxGLTextureManager::GetTexturePtr(const std::string& filePath) {
+		auto lock = ReadLock();
 		auto it = m_resources.find(filePath);
 		if (it != m_resources.end()) {
 			return it->second;
@@ -78,6 +191,7 @@ namespace bwx_sdk {
 	}
 
 	GLuint bwxGLTextureManager::GetTextureID(const std::string& filePath) {
+		auto lock = ReadLock();
 		auto it = m_resources.find(filePath);
 		if (it != m_resources.end()) {
 			return it->second->GetID();
@@ -85,12 +199,123 @@ namespace bwx_sdk {
 		return 0;
 	}
 
+	size_t bwxGLTextureManager::BuildTextureArrays(size_t minLayers) {
+		if (!bwxGLTextureArray::IsSupported()) {
+			wxLogWarning("Texture arrays need GL 4.3 or ARB_copy_image + ARB_texture_storage.");
+			return 0;
+		}
+
+		struct Group {
+			GLsizei width, height, levels;
+			GLenum format;
+			std::vector<std::string> paths;
+		};
+		std::vector<Group> groups;
+
+		for (const auto& [path, texture] : m_resources) {
+			auto location = m_locations.find(path);
+			if (location != m_locations.end() && location->second.array >= 0) continue; // Already in an array
+
+			GLsizei width, height, levels;
+			GLenum format;
+			if (!bwxGLTextureArray::Describe(*texture, width, height, format, levels)) continue;
+
+			auto group = std::find_if(groups.begin(), groups.end(), [&](const Group& g) {
+				return g.width == width && g.height == height && g.format == format && g.levels == levels;
+			});
+			if (group == groups.end()) group = groups.insert(groups.end(), { width, height, levels, format, {} });
+			group->paths.push_back(path);
+		}
+
+		size_t placed = 0;
+		for (const auto& group : groups) {
+			if (group.paths.size() < minLayers) continue;
+
+			// Existing array of this shape first, so repeated calls append instead of duplicating
+			GLint arrayIndex = -1;
+			for (size_t i = 0; i < m_arrays.size(); ++i) {
+				if (m_arrays[i]->Matches(group.width, group.height, group.format, group.levels)) arrayIndex = static_cast<GLint>(i);
+			}
+			if (arrayIndex < 0) {
+				if (m_arrays.size() >= bwxGL_MAX_TEXTURE_ARRAYS) continue;
+				m_arrays.push_back(std::make_unique<bwxGLTextureArray>(group.width, group.height, group.format, group.levels,
+					std::max<GLsizei>(static_cast<GLsizei>(group.paths.size()), bwxGL_TEXTURE_ARRAY_LAYERS)));
+				arrayIndex = static_cast<GLint>(m_arrays.size() - 1);
+			}
+
+			for (const auto& path : group.paths) {
+				const auto& texture = m_resources[path];
+				const GLint layer = m_arrays[arrayIndex]->AddLayer(*texture, texture->GetParams());
+				if (layer < 0) continue;
+
+				m_locations[path].array = arrayIndex;
+				m_locations[path].layer = layer;
+				++placed;
+			}
+		}
+
+		return placed;
+	}
+
+	void bwxGLTextureManager::BindTextureArrays(int firstUnit) const {
+		for (size_t i = 0; i < m_arrays.size(); ++i) {
+			m_arrays[i]->Bind(firstUnit + static_cast<int>(i));
+		}
+	}
+
+	bool bwxGLTextureManager::IsBindlessSupported() {
+		return GLEW_ARB_bindless_texture;
+	}
+
+	GLuint64 bwxGLTextureManager::GetBindlessHandle(const std::string& filePath) {
+		if (!IsBindlessSupported()) return 0;
+
+		auto location = m_locations.find(filePath);
+		if (location != m_locations.end() && location->second.handle) return location->second.handle;
+
+		auto it = m_resources.find(filePath);
+		if (it == m_resources.end() || !it->second->GetID() || it->second->IsPending()) return 0;
+
+		// The handle freezes the texture state - an async texture gets it only once its image is in
+		const GLuint64 handle = glGetTextureHandleARB(it->second->GetID());
+		if (!handle) return 0;
+
+		glMakeTextureHandleResidentARB(handle);
+		m_locations[filePath].handle = handle;
+		return handle;
+	}
+
+	const bwxGLTextureLocation* bwxGLTextureManager::GetLocation(const std::string& filePath) const {
+		auto it = m_locations.find(filePath);
+		return it != m_locations.end() ? &it->second : nullptr;
+	}
+
+	void bwxGLTextureManager::ReleaseLocation(const std::string& filePath) {
+		auto it = m_locations.find(filePath);
+		if (it == m_locations.end()) return;
+
+		// A resident handle keeps the texture alive, it has to go before glDeleteTextures
+		if (it->second.handle) glMakeTextureHandleNonResidentARB(it->second.handle);
+		m_locations.erase(it);
+	}
+
 	void bwxGLTextureManager::Clear() {
+		for (const auto& [path, location] : m_locations) {
+			if (location.handle) glMakeTextureHandleNonResidentARB(location.handle);
+		}
+		m_locations.clear();
+		m_arrays.clear();
+		m_resolvedPaths.clear();
+		m_contentKeys.clear();
+
+		if (!bwxFileWatcher::GetInstance().IsShutDown()) bwxFileWatcher::GetInstance().UnwatchAll(this);
+		m_watched.clear();
+
 		for (auto& texture : m_resources) {
 			texture.second->Delete();
 		}
 
-		m_resources.clear();
+		ClearResources();
 	}
 
     bwxGLTextureManager::~bwxGLTextureManager() {
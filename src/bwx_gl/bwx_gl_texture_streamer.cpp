@@ -0,0 +1,232 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_texture_streamer.cpp
+// Purpose:     BWX_SDK Library; OpenGL Texture mip streaming within a VRAM budget
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_streamer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_array.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_loader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_texture_manager.h>
+
+namespace bwx_sdk {
+
+    bwxGLTextureStreamer& bwxGLTextureStreamer::GetInstance() {
+        static bwxGLTextureStreamer instance;
+        return instance;
+    }
+
+    void bwxGLTextureStreamer::Request(const std::string& filePath, float screenPixels) {
+        auto it = m_textures.find(filePath);
+        if (it == m_textures.end()) {
+            Entry entry;
+            if (!Register(entry, filePath, bwxGLTextureManager::GetInstance().GetTexturePtr(filePath))) return;
+            it = m_textures.emplace(filePath, std::move(entry)).first;
+        }
+
+        Entry& entry = it->second;
+        const GLint lastLevel = static_cast<GLint>(entry.levelBytes.size()) - 1;
+
+        // One texel per pixel: every halving of the footprint makes one more level unnecessary
+        GLint mip = 0;
+        if (screenPixels < static_cast<float>(entry.size)) {
+            mip = static_cast<GLint>(std::floor(std::log2(static_cast<float>(entry.size) / std::max(screenPixels, 1.0f))));
+        }
+        mip = std::clamp(mip, 0, lastLevel);
+
+        // The finest level any object asked for this frame
+        if (entry.lastUsedFrame != m_frame) entry.requiredMip = mip;
+        else entry.requiredMip = std::min(entry.requiredMip, mip);
+        entry.lastUsedFrame = m_frame;
+    }
+
+    size_t bwxGLTextureStreamer::Update() {
+        m_residentBytes = 0;
+
+        for (auto it = m_textures.begin(); it != m_textures.end();) {
+            Entry& entry = it->second;
+            auto texture = entry.texture.lock();
+
+            // Deleted, or loaded again under the same path
+            if (!texture || texture->GetID() != entry.id) {
+                it = m_textures.erase(it);
+                continue;
+            }
+
+            // The reload re-specified the whole chain from level 0; a failed one left the old mips
+            if (entry.restoring && !texture->IsPending()) {
+                entry.restoring = false;
+                Entry restored;
+                if (Register(restored, it->first, texture)) {
+                    restored.requiredMip = entry.requiredMip;
+                    restored.lastUsedFrame = entry.lastUsedFrame;
+                    entry = std::move(restored);
+                }
+            }
+
+            m_residentBytes += GetResidentBytes(entry);
+            ++it;
+        }
+
+        size_t evicted = 0;
+        if (m_residentBytes > m_budget) {
+            std::vector<Entry*> order;
+            order.reserve(m_textures.size());
+            for (auto& [path, entry] : m_textures) {
+                if (!entry.restoring) order.push_back(&entry);
+            }
+            std::sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) { return a->lastUsedFrame < b->lastUsedFrame; });
+
+            for (Entry* entry : order) {
+                // Visible textures keep what they need, the rest can go down to the smallest level
+                const GLint lastLevel = static_cast<GLint>(entry->levelBytes.size()) - 1;
+                const GLint target = entry->lastUsedFrame == m_frame ? entry->requiredMip : lastLevel;
+
+                GLint base = entry->residentBase;
+                while (base < target && m_residentBytes > m_budget) {
+                    m_residentBytes -= entry->levelBytes[base];
+                    ++base;
+                }
+
+                if (base != entry->residentBase) {
+                    evicted += static_cast<size_t>(base - entry->residentBase);
+                    Evict(*entry, base);
+                }
+                if (m_residentBytes <= m_budget) break;
+            }
+
+            if (m_residentBytes > m_budget && !m_overBudgetLogged) {
+                wxLogWarning("Texture streaming: %zu bytes needed on screen, budget is %zu.", m_residentBytes, m_budget);
+                m_overBudgetLogged = true;
+            }
+        }
+        else {
+            m_overBudgetLogged = false;
+
+            // Detail back for visible textures, as long as the whole chain fits
+            int restores = 0;
+            for (auto& [path, entry] : m_textures) {
+                if (restores >= bwxGL_TEXTURE_STREAMING_RESTORES) break;
+                if (entry.restoring || entry.lastUsedFrame != m_frame || entry.requiredMip >= entry.residentBase) continue;
+
+                size_t missing = 0;
+                for (GLint level = 0; level < entry.residentBase; ++level) missing += entry.levelBytes[level];
+                if (m_residentBytes + missing > m_budget) continue;
+
+                if (Restore(entry, entry.texture.lock())) {
+                    m_residentBytes += missing;
+                    ++restores;
+                }
+            }
+        }
+
+        BWX_METRIC_GAUGE("gl.textures.streamed_bytes").Set(static_cast<int64_t>(m_residentBytes));
+        BWX_METRIC_COUNTER("gl.textures.evicted_levels").Add(evicted);
+
+        ++m_frame;
+        return evicted;
+    }
+
+    GLint bwxGLTextureStreamer::GetResidentMip(const std::string& filePath) const {
+        auto it = m_textures.find(filePath);
+        return it != m_textures.end() ? it->second.residentBase : -1;
+    }
+
+    void bwxGLTextureStreamer::Clear() {
+        m_textures.clear();
+        m_residentBytes = 0;
+        BWX_METRIC_GAUGE("gl.textures.streamed_bytes").Set(0);
+        m_overBudgetLogged = false;
+    }
+
+    bool bwxGLTextureStreamer::Register(Entry& entry, const std::string& filePath, const std::shared_ptr<bwxGLTexture2D>& texture) const {
+        if (!texture || !texture->GetID() || texture->IsPending()) return false;
+
+        const bwxGLTextureLocation* location = bwxGLTextureManager::GetInstance().GetLocation(filePath);
+        if (location && location->handle) return false;
+
+        GLsizei width, height, levels;
+        GLenum format;
+        if (!bwxGLTextureArray::Describe(*texture, width, height, format, levels)) return false;
+
+        GLint base = 0;
+        glBindTexture(GL_TEXTURE_2D, texture->GetID());
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, &base);
+
+        // Evicted outside this streamer (or a reload that failed) - level 0 no longer tells the size
+        if (base != 0) {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            return false;
+        }
+
+        entry.levelBytes.clear();
+        for (GLint level = 0; level < levels; ++level) {
+            GLint compressed = GL_FALSE, size = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED, &compressed);
+            if (compressed) {
+                glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+            }
+            else {
+                // Drivers keep RGB8 as RGBA8 as well
+                size = std::max(width >> level, 1) * std::max(height >> level, 1) * 4;
+            }
+            entry.levelBytes.push_back(static_cast<size_t>(size));
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        entry.texture = texture;
+        entry.id = texture->GetID();
+        entry.size = std::max(width, height);
+        entry.residentBase = 0;
+        entry.requiredMip = 0;
+        entry.restoring = false;
+        return true;
+    }
+
+    size_t bwxGLTextureStreamer::GetResidentBytes(const Entry& entry) const {
+        size_t bytes = 0;
+        for (size_t level = static_cast<size_t>(entry.residentBase); level < entry.levelBytes.size(); ++level) bytes += entry.levelBytes[level];
+        return bytes;
+    }
+
+    void bwxGLTextureStreamer::Evict(Entry& entry, GLint base) {
+        glBindTexture(GL_TEXTURE_2D, entry.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, base);
+
+        // Levels below the base do not count for completeness; a single texel frees their storage
+        for (GLint level = entry.residentBase; level < base; ++level) {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        entry.residentBase = base;
+    }
+
+    bool bwxGLTextureStreamer::Restore(Entry& entry, const std::shared_ptr<bwxGLTexture2D>& texture) {
+        if (!texture || texture->GetPath().IsEmpty()) return false;
+
+        // The remaining mips keep drawing until the loader re-specifies the chain
+        texture->m_pending = true;
+        bwxGLTextureLoader::GetInstance().Enqueue(texture);
+        entry.restoring = true;
+        return true;
+    }
+
+} // namespace bwx_sdk
@@ -0,0 +1,478 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_thumbnail_renderer.cpp
+// Purpose:     BWX_SDK Library; OpenGL Batch offscreen thumbnails of models and materials
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <bwx_sdk/bwx_core/bwx_metrics.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_buffer.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_light_system.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_material.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_material_manager.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_model.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_render_system.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_shader_generator.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_thumbnail_renderer.h>
+
+namespace bwx_sdk {
+
+    namespace {
+
+        const GLsizei ATLAS_SIZE = bwxGL_THUMBNAIL_SIZE * bwxGL_THUMBNAIL_ATLAS_TILES;
+        const size_t ATLAS_CAPACITY = bwxGL_THUMBNAIL_ATLAS_TILES * bwxGL_THUMBNAIL_ATLAS_TILES;
+        const size_t THUMBNAIL_BYTES = bwxGL_THUMBNAIL_SIZE * bwxGL_THUMBNAIL_SIZE * 4;
+
+        const float CAMERA_FOV = glm::radians(30.0f);
+        const float CAMERA_MARGIN = 1.08f;  // The unit sphere does not quite touch the tile edges
+        const glm::vec3 CAMERA_DIRECTION = glm::normalize(glm::vec3(1.0f, 0.7f, 1.4f));  // Three-quarter view from above
+
+        const int SPHERE_RINGS = 24;
+        const int SPHERE_SEGMENTS = 48;
+
+        const char CACHE_MAGIC[4] = { 'B', 'W', 'X', 'T' };
+
+        struct CacheHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t key;
+            uint32_t size;
+            uint32_t reserved;
+        };
+
+        bwxGLPackedLight MakeLight(const glm::vec3& position, const glm::vec3& color, float ambient) {
+            bwxGLPackedLight light = {};
+            light.position = glm::vec4(position, 0.0f);  // Point light; no falloff over the unit sphere
+            light.diffuse = glm::vec4(color, 1.0f);
+            light.ambient = glm::vec4(glm::vec3(ambient), 0.0f);
+            light.specular = glm::vec4(color, 0.0f);
+            light.attenuation = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+            return light;
+        }
+    }
+
+    bwxGLThumbnailRenderer::~bwxGLThumbnailRenderer() {
+        Release();
+    }
+
+    bool bwxGLThumbnailRenderer::IsSupported() {
+        return GLEW_VERSION_3_3;
+    }
+
+    void bwxGLThumbnailRenderer::RequestModel(std::shared_ptr<bwxGLModel> model, uint64_t key, Callback callback) {
+        std::vector<unsigned char> pixels;
+        if (!model || LoadCached(key, pixels)) {
+            if (callback) callback(pixels);
+            return;
+        }
+
+        Request request;
+        request.model = std::move(model);
+        request.key = key;
+        request.callback = std::move(callback);
+        m_queue.push_back(std::move(request));
+    }
+
+    void bwxGLThumbnailRenderer::RequestMaterial(std::shared_ptr<bwxGLMaterial> material, Callback callback) {
+        std::vector<unsigned char> pixels;
+        const uint64_t key = material ? material->GetContentHash() : 0;
+        if (!material || LoadCached(key, pixels)) {
+            if (callback) callback(pixels);
+            return;
+        }
+
+        Request request;
+        request.material = std::move(material);
+        request.key = key;
+        request.callback = std::move(callback);
+        m_queue.push_back(std::move(request));
+    }
+
+    void bwxGLThumbnailRenderer::Render(double budgetMs) {
+        if (m_queue.empty() || !CreateResources()) return;
+
+        Atlas* atlas = nullptr;
+        for (Atlas& slot : m_atlases) {
+            if (!slot.fence) {
+                atlas = &slot;
+                break;
+            }
+        }
+        if (!atlas) return; // Every atlas is still being read back - the queue waits for the next frame
+
+        BWX_METRIC_SCOPE_TIME("gl.thumbnails.render_ms");
+        const auto start = std::chrono::steady_clock::now();
+
+        GLint previousFramebuffer = 0;
+        GLint previousViewport[4];
+        GLint previousFrameBlock = 0;
+        GLint previousLightBlock = 0;
+        GLint previousDepthFunc = GL_LESS;
+        GLboolean depthMask = GL_TRUE;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+        glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, bwxGL_FRAME_UBO_BINDING, &previousFrameBlock);
+        glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, bwxGL_LIGHTS_UBO_BINDING, &previousLightBlock);
+        glGetIntegerv(GL_DEPTH_FUNC, &previousDepthFunc);
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+        const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+        const GLboolean blend = glIsEnabled(GL_BLEND);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, atlas->framebuffer);
+        glViewport(0, 0, ATLAS_SIZE, ATLAS_SIZE);
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+
+        const GLfloat transparent[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        const GLfloat farDepth = 1.0f;
+        glClearBufferfv(GL_COLOR, 0, transparent);
+        glClearBufferfv(GL_DEPTH, 0, &farDepth);
+
+        // One camera and one set of lights for everything: each item is scaled into the unit sphere instead
+        glBindBufferBase(GL_UNIFORM_BUFFER, bwxGL_FRAME_UBO_BINDING, m_frameUBO->GetID());
+        glBindBufferBase(GL_UNIFORM_BUFFER, bwxGL_LIGHTS_UBO_BINDING, m_lightUBO->GetID());
+
+        atlas->tiles.clear();
+        while (!m_queue.empty() && atlas->tiles.size() < ATLAS_CAPACITY) {
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (!atlas->tiles.empty() && elapsed.count() >= budgetMs) break;
+
+            Request request = std::move(m_queue.front());
+            m_queue.pop_front();
+
+            const size_t index = atlas->tiles.size();
+            glViewport(static_cast<GLint>(index % bwxGL_THUMBNAIL_ATLAS_TILES) * bwxGL_THUMBNAIL_SIZE,
+                static_cast<GLint>(index / bwxGL_THUMBNAIL_ATLAS_TILES) * bwxGL_THUMBNAIL_SIZE,
+                bwxGL_THUMBNAIL_SIZE, bwxGL_THUMBNAIL_SIZE);
+
+            Tile tile;
+            tile.key = request.key;
+            tile.callback = std::move(request.callback);
+            tile.drawn = request.model ? DrawModel(*request.model) : DrawMaterial(*request.material);
+            atlas->tiles.push_back(std::move(tile));
+        }
+
+        // Only the rows of tiles in use; the fence tells Poll() when the copy can be read
+        const GLsizei rows = static_cast<GLsizei>((atlas->tiles.size() + bwxGL_THUMBNAIL_ATLAS_TILES - 1) / bwxGL_THUMBNAIL_ATLAS_TILES);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, atlas->pbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, ATLAS_SIZE, rows * bwxGL_THUMBNAIL_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        atlas->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        ++m_inFlight;
+
+        BWX_METRIC_COUNTER("gl.thumbnails.rendered").Add(atlas->tiles.size());
+
+        glBindVertexArray(0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, bwxGL_FRAME_UBO_BINDING, static_cast<GLuint>(previousFrameBlock));
+        glBindBufferBase(GL_UNIFORM_BUFFER, bwxGL_LIGHTS_UBO_BINDING, static_cast<GLuint>(previousLightBlock));
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+        glDepthFunc(static_cast<GLenum>(previousDepthFunc));
+        glDepthMask(depthMask);
+        if (!depthTest) glDisable(GL_DEPTH_TEST);
+        if (blend) glEnable(GL_BLEND);
+    }
+
+    bool bwxGLThumbnailRenderer::DrawModel(bwxGLModel& model) {
+        const bwxGLBoundingBox& bounds = model.GetBounds();
+        if (!bounds.IsValid()) return false;
+
+        const glm::mat4 transform = GetFramingMatrix(bounds);
+        auto& profiler = bwxGLProfiler::GetInstance();
+        bool drawn = false;
+
+        for (int i = 0; i < model.GetMeshesCount(); ++i) {
+            const std::shared_ptr<bwxGLMesh> mesh = model.GetMesh(i);
+            if (!mesh || !mesh->GetVAO()) continue;
+
+            // No material on a bare model and no bone palette here: lit, untextured, in the bind pose
+            const uint32_t features = bwxGL_SHADER_VARIANT_LIGHTING |
+                (bwxGLShaderGenerator::GetMeshFeatures(mesh->GetFormat()) & bwxGL_SHADER_VARIANT_NORMALS);
+            const std::shared_ptr<bwxGLShaderProgram> program = bwxGLShaderGenerator::GetProgram(features);
+            if (!program) continue;
+
+            program->Bind();
+            program->SetUniform("model", transform);
+            glBindVertexArray(mesh->GetVAO());
+            mesh->Draw();
+            profiler.AddDrawCalls();
+            drawn = true;
+        }
+        return drawn;
+    }
+
+    bool bwxGLThumbnailRenderer::DrawMaterial(const bwxGLMaterial& material) {
+        if (!m_sphere) CreateSphere();
+
+        uint32_t features = bwxGL_SHADER_VARIANT_NORMALS | bwxGL_SHADER_VARIANT_LIGHTING;
+        if (material.HasTexture(TEXTURE_DIFFUSE)) features |= bwxGL_SHADER_VARIANT_TEXCOORDS;
+        const std::shared_ptr<bwxGLShaderProgram> program = bwxGLShaderGenerator::GetProgram(features);
+        if (!program) return false;
+
+        program->Bind();
+        program->SetUniform("model", GetFramingMatrix(m_sphere->GetBounds()));
+
+        // As bwxGLRenderSystem binds it, so the preview matches the scene
+        material.Bind();
+        const bool block = program->HasMaterialParams() && bwxGLMaterialManager::GetInstance().BindMaterialBlock(material);
+        if (!block) material.ApplyToShader(*program);
+
+        glBindVertexArray(m_sphere->GetVAO());
+        m_sphere->Draw();
+        bwxGLProfiler::GetInstance().AddDrawCalls();
+        material.Unbind();
+        return true;
+    }
+
+    glm::mat4 bwxGLThumbnailRenderer::GetFramingMatrix(const bwxGLBoundingBox& bounds) {
+        const float radius = std::max(glm::length(bounds.GetExtents()), 1e-6f);
+        return glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / radius)) * glm::translate(glm::mat4(1.0f), -bounds.GetCenter());
+    }
+
+    void bwxGLThumbnailRenderer::Poll() {
+        if (!m_inFlight) return;
+
+        for (Atlas& atlas : m_atlases) {
+            if (!atlas.fence) continue;
+
+            const GLenum status = glClientWaitSync(atlas.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+
+            glDeleteSync(atlas.fence);
+            atlas.fence = nullptr;
+            --m_inFlight;
+
+            const size_t rows = (atlas.tiles.size() + bwxGL_THUMBNAIL_ATLAS_TILES - 1) / bwxGL_THUMBNAIL_ATLAS_TILES;
+            const GLsizeiptr bytes = static_cast<GLsizeiptr>(rows * bwxGL_THUMBNAIL_SIZE) * ATLAS_SIZE * 4;
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, atlas.pbo);
+            const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+            Deliver(atlas, static_cast<const unsigned char*>(data));
+            if (data) glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            atlas.tiles.clear();
+        }
+    }
+
+    void bwxGLThumbnailRenderer::Deliver(const Atlas& atlas, const unsigned char* data) {
+        const size_t rowBytes = bwxGL_THUMBNAIL_SIZE * 4;
+        std::vector<unsigned char> pixels;
+
+        for (size_t i = 0; i < atlas.tiles.size(); ++i) {
+            const Tile& tile = atlas.tiles[i];
+            pixels.clear();
+
+            if (data && tile.drawn) {
+                // GL rows run bottom-up; thumbnails are handed out top row first
+                const size_t x = (i % bwxGL_THUMBNAIL_ATLAS_TILES) * bwxGL_THUMBNAIL_SIZE;
+                const size_t y = (i / bwxGL_THUMBNAIL_ATLAS_TILES) * bwxGL_THUMBNAIL_SIZE;
+                pixels.resize(THUMBNAIL_BYTES);
+                for (size_t row = 0; row < bwxGL_THUMBNAIL_SIZE; ++row) {
+                    const size_t source = ((y + bwxGL_THUMBNAIL_SIZE - 1 - row) * ATLAS_SIZE + x) * 4;
+                    std::memcpy(pixels.data() + row * rowBytes, data + source, rowBytes);
+                }
+                StoreCached(tile.key, pixels);
+            }
+
+            if (tile.callback) tile.callback(pixels);
+        }
+    }
+
+    std::string bwxGLThumbnailRenderer::GetCachePath(uint64_t key) const {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << bwxGL_THUMBNAIL_CACHE_EXT;
+        return (std::filesystem::path(m_cacheDirectory) / name.str()).string();
+    }
+
+    bool bwxGLThumbnailRenderer::LoadCached(uint64_t key, std::vector<unsigned char>& pixels) const {
+        if (!key || m_cacheDirectory.empty()) return false;
+
+        std::ifstream in(GetCachePath(key), std::ios::binary);
+        if (!in) return false;
+
+        CacheHeader header = {};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        const bool valid = in && std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+            header.version == bwxGL_THUMBNAIL_CACHE_VERSION && header.key == key && header.size == bwxGL_THUMBNAIL_SIZE;
+        if (!valid) return false;
+
+        pixels.resize(THUMBNAIL_BYTES);
+        in.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+        if (!in) {
+            pixels.clear();
+            return false;
+        }
+
+        BWX_METRIC_COUNTER("gl.thumbnails.cache_hits").Add();
+        return true;
+    }
+
+    void bwxGLThumbnailRenderer::StoreCached(uint64_t key, const std::vector<unsigned char>& pixels) const {
+        if (!key || m_cacheDirectory.empty()) return;
+
+        std::error_code error;
+        std::filesystem::create_directories(m_cacheDirectory, error);
+
+        CacheHeader header = {};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = bwxGL_THUMBNAIL_CACHE_VERSION;
+        header.key = key;
+        header.size = bwxGL_THUMBNAIL_SIZE;
+
+        // Written aside and renamed, so a crash never leaves a truncated thumbnail behind
+        const std::string path = GetCachePath(key);
+        const std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+            if (!out) {
+                std::cerr << "Failed to write thumbnail cache: " << path << std::endl;
+                out.close();
+                std::filesystem::remove(temporary, error);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::cerr << "Failed to write thumbnail cache: " << path << " (" << error.message() << ")" << std::endl;
+            std::filesystem::remove(temporary, error);
+        }
+    }
+
+    bool bwxGLThumbnailRenderer::CreateResources() {
+        if (m_frameUBO) return true;
+        if (!IsSupported()) return false;
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+        GLenum status = GL_FRAMEBUFFER_COMPLETE;
+        for (Atlas& atlas : m_atlases) {
+            glGenRenderbuffers(1, &atlas.colorTarget);
+            glBindRenderbuffer(GL_RENDERBUFFER, atlas.colorTarget);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE);
+            glGenRenderbuffers(1, &atlas.depthTarget);
+            glBindRenderbuffer(GL_RENDERBUFFER, atlas.depthTarget);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, ATLAS_SIZE, ATLAS_SIZE);
+
+            glGenFramebuffers(1, &atlas.framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, atlas.framebuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, atlas.colorTarget);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, atlas.depthTarget);
+            status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+            if (status != GL_FRAMEBUFFER_COMPLETE) break;
+
+            glGenBuffers(1, &atlas.pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, atlas.pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(ATLAS_SIZE) * ATLAS_SIZE * 4, nullptr, GL_STREAM_READ);
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Thumbnails: atlas framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+            Release();
+            return false;
+        }
+
+        // Camera fitted to the unit sphere; see GetFramingMatrix()
+        const float distance = CAMERA_MARGIN / std::sin(CAMERA_FOV * 0.5f);
+        bwxGLFrameUniforms frame;
+        frame.view = glm::lookAt(CAMERA_DIRECTION * distance, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        frame.projection = glm::perspective(CAMERA_FOV, 1.0f, distance - 1.5f, distance + 1.5f);
+        frame.viewProjection = frame.projection * frame.view;
+        frame.cameraPosition = glm::vec4(CAMERA_DIRECTION * distance, 1.0f);
+        m_frameUBO = std::make_unique<bwxGLBuffer>(GL_UNIFORM_BUFFER);
+        m_frameUBO->SetData(&frame, sizeof(frame), GL_STATIC_DRAW);
+
+        // Key, fill and rim; the slot after the last one stays zeroed, which ends the shader's light loop
+        std::vector<bwxGLPackedLight> lights(bwxGL_MAX_LIGHTS, bwxGLPackedLight{});
+        lights[0] = MakeLight(glm::vec3(4.0f, 6.0f, 5.0f), glm::vec3(0.85f), 0.12f);
+        lights[1] = MakeLight(glm::vec3(-6.0f, 1.0f, 3.0f), glm::vec3(0.35f, 0.37f, 0.42f), 0.0f);
+        lights[2] = MakeLight(glm::vec3(-2.0f, 4.0f, -6.0f), glm::vec3(0.4f), 0.0f);
+        m_lightUBO = std::make_unique<bwxGLBuffer>(GL_UNIFORM_BUFFER);
+        m_lightUBO->SetData(lights.data(), static_cast<GLsizeiptr>(lights.size() * sizeof(bwxGLPackedLight)), GL_STATIC_DRAW);
+
+        return true;
+    }
+
+    void bwxGLThumbnailRenderer::CreateSphere() {
+        m_sphere = std::make_unique<bwxGLMesh>(bwxGL_MESH_NORMAL | bwxGL_MESH_TEX_COORD | bwxGL_MESH_INDICES);
+
+        for (int ring = 0; ring <= SPHERE_RINGS; ++ring) {
+            const float phi = glm::pi<float>() * ring / SPHERE_RINGS;
+            for (int segment = 0; segment <= SPHERE_SEGMENTS; ++segment) {
+                const float theta = glm::two_pi<float>() * segment / SPHERE_SEGMENTS;
+
+                bwxGLVertex vertex = {};
+                vertex.position = glm::vec3(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                vertex.normal = vertex.position;
+                vertex.texCoord = glm::vec2(static_cast<float>(segment) / SPHERE_SEGMENTS, 1.0f - static_cast<float>(ring) / SPHERE_RINGS);
+                m_sphere->AddVertex(vertex);
+            }
+        }
+
+        // Counter-clockwise seen from outside
+        for (int ring = 0; ring < SPHERE_RINGS; ++ring) {
+            for (int segment = 0; segment < SPHERE_SEGMENTS; ++segment) {
+                const GLuint a = static_cast<GLuint>(ring * (SPHERE_SEGMENTS + 1) + segment);
+                const GLuint b = a + SPHERE_SEGMENTS + 1;
+                m_sphere->AddIndice(a);
+                m_sphere->AddIndice(a + 1);
+                m_sphere->AddIndice(b);
+                m_sphere->AddIndice(a + 1);
+                m_sphere->AddIndice(b + 1);
+                m_sphere->AddIndice(b);
+            }
+        }
+
+        m_sphere->SetupMesh();
+    }
+
+    void bwxGLThumbnailRenderer::Release() {
+        for (Atlas& atlas : m_atlases) {
+            if (atlas.fence) glDeleteSync(atlas.fence);
+            if (atlas.pbo) glDeleteBuffers(1, &atlas.pbo);
+            if (atlas.framebuffer) glDeleteFramebuffers(1, &atlas.framebuffer);
+            if (atlas.colorTarget) glDeleteRenderbuffers(1, &atlas.colorTarget);
+            if (atlas.depthTarget) glDeleteRenderbuffers(1, &atlas.depthTarget);
+            atlas = Atlas();
+        }
+        m_inFlight = 0;
+        m_queue.clear();
+
+        m_frameUBO.reset();
+        m_lightUBO.reset();
+        m_sphere.reset();
+    }
+
+} // namespace bwx_sdk
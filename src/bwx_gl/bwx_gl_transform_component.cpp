@@ -25,4 +25,8 @@ namespace bwx_sdk {
 		return m_transform;
 	}
 
+	glm::mat4 bwxGLTransformComponent::GetWorldMatrix() {
+		return m_worldManaged ? m_worldMatrix : GetTransformMatrix();
+	}
+
 } // namespace bwx_sdk
\ No newline at end of file
@@ -0,0 +1,154 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_transform_system.cpp
+// Purpose:     BWX_SDK Library; World transform hierarchy system (ECS)
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <utility>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define bwxGL_TRANSFORM_SSE
+#endif
+
+#include <bwx_sdk/bwx_gl/bwx_gl_transform_system.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        // out = a * b (column-major); out must not alias a or b
+        inline void MultiplyMatrix(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+#if defined(bwxGL_TRANSFORM_SSE)
+            const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+            const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+            const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+            const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+            for (int c = 0; c < 4; ++c) {
+                __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[c][0]));
+                r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[c][1])));
+                r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[c][2])));
+                r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[c][3])));
+                _mm_storeu_ps(&out[c][0], r);
+            }
+#else
+            out = a * b;
+#endif
+        }
+    }
+
+    void bwxGLTransformSystem::Update(const std::shared_ptr<bwxGLNode>& root) {
+        if (!root) {
+            Clear();
+            return;
+        }
+
+        if (!m_built || m_root.lock() != root || m_hierarchyVersion != bwxGLNode::GetHierarchyVersion()) {
+            Rebuild(root);
+        }
+
+        m_updatedCount = 0;
+        const size_t count = m_components.size();
+
+        for (size_t i = 0; i < count; ++i) {
+            bwxGLTransformComponent* component = m_components[i];
+
+            const bool localChanged = component->GetVersion() != m_localVersion[i];
+            if (localChanged) {
+                m_local[i] = component->GetTransformMatrix();
+                m_localVersion[i] = component->GetVersion();
+            }
+
+            // Parent index is always lower, its flag is already final for this pass
+            const int32_t parent = m_parent[i];
+            const bool dirty = localChanged || (parent >= 0 && m_dirty[parent]);
+            m_dirty[i] = dirty;
+            if (!dirty) continue;
+
+            if (parent >= 0) {
+                MultiplyMatrix(m_world[parent], m_local[i], m_world[i]);
+            }
+            else {
+                m_world[i] = m_local[i];
+            }
+
+            component->m_worldMatrix = m_world[i];
+            ++component->m_worldVersion;
+            ++m_updatedCount;
+        }
+    }
+
+    void bwxGLTransformSystem::Clear() {
+        for (auto& owner : m_owners) {
+            owner->m_worldManaged = false;
+            owner->MarkDirty(); // Dependants must notice the switch back to the local matrix
+        }
+
+        m_local.clear();
+        m_world.clear();
+        m_parent.clear();
+        m_dirty.clear();
+        m_localVersion.clear();
+        m_components.clear();
+        m_owners.clear();
+        m_root.reset();
+        m_built = false;
+        m_updatedCount = 0;
+    }
+
+    void bwxGLTransformSystem::Rebuild(const std::shared_ptr<bwxGLNode>& root) {
+        Clear();
+
+        m_root = root;
+        m_hierarchyVersion = bwxGLNode::GetHierarchyVersion();
+        m_built = true;
+
+        // Breadth-first, so every level follows the previous one; second = nearest transform above
+        std::vector<std::pair<bwxGLNode*, int32_t>> level{ { root.get(), -1 } };
+        std::vector<std::pair<bwxGLNode*, int32_t>> next;
+
+        while (!level.empty()) {
+            next.clear();
+
+            for (const auto& [node, parentIndex] : level) {
+                int32_t index = parentIndex;
+
+                if (auto transform = node->GetComponent<bwxGLTransformComponent>()) {
+                    index = static_cast<int32_t>(m_components.size());
+
+                    transform->m_worldManaged = true;
+                    transform->m_worldVersion = transform->GetVersion();
+
+                    m_components.push_back(transform.get());
+                    m_owners.push_back(transform);
+                    m_parent.push_back(parentIndex);
+                }
+
+                for (const auto& child : node->GetChildren()) {
+                    next.emplace_back(child.get(), index);
+                }
+            }
+
+            level.swap(next);
+        }
+
+        const size_t count = m_components.size();
+        m_local.assign(count, glm::mat4(1.0f));
+        m_world.assign(count, glm::mat4(1.0f));
+        m_dirty.assign(count, 0);
+
+        // Versions that never match - the first pass computes everything
+        m_localVersion.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            m_localVersion[i] = m_components[i]->GetVersion() - 1;
+        }
+    }
+
+} // namespace bwx_sdk
@@ -13,16 +13,76 @@
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_MODULE_H
 
+// FT_RENDER_MODE_SDF and the "sdf"/"bsdf" modules came with FreeType 2.11
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+#define bwxGL_TTF_HAS_SDF 1
+#else
+#define bwxGL_TTF_HAS_SDF 0
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <map>
 #include <memory>
+#include <utility>
 
 #include <bwx_sdk/bwx_gl/bwx_gl_ttf.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_profiler.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_shader.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_shader_generator.h>
 #include <bwx_sdk/bwx_gl/bwx_gl_buffer.h>
+#include <bwx_sdk/bwx_core/bwx_startup_trace.h>
+
+#include <wx/glcanvas.h> // Platform context API (WGL, GLX or EGL)
 
 namespace bwx_sdk {
 
+    namespace {
+        // Native handle of the context current on this thread; GL names are only valid there
+        const void* GetCurrentContextKey()
+        {
+#if defined(__WXMSW__)
+            return wglGetCurrentContext();
+#elif wxUSE_GLCANVAS_EGL
+            return eglGetCurrentContext();
+#else
+            return glXGetCurrentContext();
+#endif
+        }
+
+        // One program per mode and GL context, shared by the bwxGLTexts drawn there and linked when the
+        // first of them is drawn. Contexts are not shared (e.g. bwxGLTextViewRenderer owns its own), so
+        // a process-wide program would not exist in all but one of them. The texts own the program; it
+        // goes away with the last one
+        std::shared_ptr<bwxGLShaderProgram> GetTextProgram(bool distanceField)
+        {
+            static std::map<std::pair<const void*, bool>, std::weak_ptr<bwxGLShaderProgram>> programs;
+
+            std::weak_ptr<bwxGLShaderProgram>& cached = programs[{ GetCurrentContextKey(), distanceField }];
+            if (auto program = cached.lock()) return program;
+
+            BWX_STARTUP_PHASE("gl.text.program", "gl");
+            const std::string fragment = distanceField ? bwxGLShaderGenerator::GetSDFTTFFragmentShader()
+                                                       : bwxGLShaderGenerator::GetDefaultTTFFragmentShader();
+            bwxGLShader vertexShader(bwxGL_SHADER_TYPE::SHADER_VERTEX, bwxGLShaderGenerator::GetDefaultTTFVertexShader());
+            bwxGLShader fragmentShader(bwxGL_SHADER_TYPE::SHADER_FRAGMENT, fragment);
+
+            auto program = std::make_shared<bwxGLShaderProgram>();
+            program->AttachShader(vertexShader);
+            program->AttachShader(fragmentShader);
+            if (!program->Link()) return nullptr;
+
+            program->Bind();
+            program->AddUniforms({ "projection", "textColor", "outlineWidth", "outlineColor" }); // Cached where present
+            program->Unbind();
+
+            cached = program;
+            return program;
+        }
+    }
+
 	void bwxGLTTF::SetCharset(const std::wstring& charset)
 	{
 		m_charset = charset;
@@ -84,99 +144,239 @@ namespace bwx_sdk {
 			L"ÀÈÉÌÒÓÙàèéìòóù"; ///< Default charset (with Italian characters)
 	}
 
-    bool bwxGLTTF::LoadFromFile(const std::string& filepath, int pixelHeight)
+    bwxGLTTF::~bwxGLTTF()
     {
-        FT_Library ft;
-        if (FT_Init_FreeType(&ft))
+        Release();
+    }
+
+    void bwxGLTTF::Release()
+    {
+        if (m_textureAtlas) glDeleteTextures(1, &m_textureAtlas);
+        m_textureAtlas = 0;
+        m_pageCount = 0;
+        m_pageTop = 0;
+        m_shelves.clear();
+
+        m_glyphs.clear();
+        m_bmp.clear();
+        m_extended.clear();
+
+        if (m_face) FT_Done_Face(m_face);
+        if (m_library) FT_Done_FreeType(m_library);
+        m_face = nullptr;
+        m_library = nullptr;
+    }
+
+    bool bwxGLTTF::LoadFromFile(const std::string& filepath, int pixelHeight, bwxGL_TTF_MODE mode)
+    {
+        Release();
+
+        m_mode = mode;
+#if !bwxGL_TTF_HAS_SDF
+        if (m_mode == bwxGL_TTF_MODE::TTF_SDF)
+        {
+            std::cerr << "Distance-field fonts need FreeType 2.11 or newer, loading bitmaps." << std::endl;
+            m_mode = bwxGL_TTF_MODE::TTF_BITMAP;
+        }
+#endif
+
+        if (FT_Init_FreeType(&m_library))
         {
             std::cerr << "Failed to initialize FreeType." << std::endl;
+            m_library = nullptr;
             return false;
         }
 
-        FT_Face face;
-        if (FT_New_Face(ft, filepath.c_str(), 0, &face))
+        if (FT_New_Face(m_library, filepath.c_str(), 0, &m_face))
         {
             std::cerr << "Failed to load font face." << std::endl;
-            FT_Done_FreeType(ft);
+            m_face = nullptr;
+            Release();
             return false;
         }
 
-        FT_Set_Pixel_Sizes(face, 0, pixelHeight);
-
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glGenTextures(1, &m_textureAtlas);
-        glBindTexture(GL_TEXTURE_2D, m_textureAtlas);
+        FT_Set_Pixel_Sizes(m_face, 0, pixelHeight);
 
-        int atlasWidth = 0;
-        int atlasHeight = 0;
-        for (wchar_t c : m_charset)
+#if bwxGL_TTF_HAS_SDF
+        if (m_mode == bwxGL_TTF_MODE::TTF_SDF)
         {
-            if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-                continue;
-
-            atlasWidth += face->glyph->bitmap.width;
-            atlasHeight = std::max(atlasHeight, static_cast<int>(face->glyph->bitmap.rows));
+            FT_Int spread = bwxGL_TTF_SDF_SPREAD;
+            FT_Property_Set(m_library, "sdf", "spread", &spread);
+            FT_Property_Set(m_library, "bsdf", "spread", &spread);
         }
+#endif
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasWidth, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+        m_bmp.assign(0x10000, 0);
+        AddPage();
 
-        int offsetX = 0;
+        // Warm-up only - characters outside the charset come in through GetGlyph()
         for (wchar_t c : m_charset)
         {
-            if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-                continue;
+            GetGlyph(c);
+        }
 
-            FT_Bitmap& bitmap = face->glyph->bitmap;
+        return true;
+    }
 
-            glTexSubImage2D(GL_TEXTURE_2D, 0, offsetX, 0, bitmap.width, bitmap.rows, GL_RED, GL_UNSIGNED_BYTE, bitmap.buffer);
+	GLuint bwxGLTTF::GetTextureAtlas() const
+	{
+		return m_textureAtlas;
+	}
+
+    uint32_t bwxGLTTF::Lookup(uint32_t code) const
+    {
+        if (code < m_bmp.size() && m_bmp[code]) return m_bmp[code];
 
+        auto it = m_extended.find(code);
+        return it != m_extended.end() ? it->second : 0;
+    }
+
+	bwxGLTTF::bwxGLTTFGlyph& bwxGLTTF::GetGlyph(wchar_t c)
+	{
+        const uint32_t code = static_cast<uint32_t>(c);
+        uint32_t index = Lookup(code);
+
+        if (!index)
+        {
+            // A character the font cannot give is kept as an empty glyph, so it is not retried every frame
             bwxGLTTFGlyph glyph;
-            glyph.size = { bitmap.width, bitmap.rows };
-            glyph.bearing = { face->glyph->bitmap_left, face->glyph->bitmap_top };
-            glyph.advance = face->glyph->advance.x >> 6;
-            glyph.uvTopLeft = glm::vec2(offsetX / static_cast<float>(atlasWidth), bitmap.rows / static_cast<float>(atlasHeight));
-            glyph.uvBottomRight = glm::vec2((offsetX + bitmap.width) / static_cast<float>(atlasWidth), 0);
+            Rasterize(code, glyph);
 
-            m_glyphs[c] = glyph;
+            m_glyphs.push_back(glyph);
+            index = static_cast<uint32_t>(m_glyphs.size());
 
-            offsetX += bitmap.width;
+            if (code < m_bmp.size() && index <= 0xFFFF) m_bmp[code] = static_cast<uint16_t>(index);
+            else m_extended[code] = index;
         }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		return m_glyphs[index - 1];
+	}
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+    const bwxGLTTF::bwxGLTTFGlyph* bwxGLTTF::FindGlyph(wchar_t c) const
+    {
+        const uint32_t index = Lookup(static_cast<uint32_t>(c));
+        return index ? &m_glyphs[index - 1] : nullptr;
+    }
 
-        FT_Done_Face(face);
-        FT_Done_FreeType(ft);
+    int bwxGLTTF::GetGlyphHeight(wchar_t c) { return GetGlyph(c).size.y; }
+
+    int bwxGLTTF::GetGlyphWidth(wchar_t c) { return GetGlyph(c).size.x; }
+
+    bool bwxGLTTF::Rasterize(uint32_t code, bwxGLTTFGlyph& glyph)
+    {
+        const bool distanceField = m_mode == bwxGL_TTF_MODE::TTF_SDF;
+        if (!m_face || FT_Load_Char(m_face, code, distanceField ? FT_LOAD_DEFAULT : FT_LOAD_RENDER)) return false;
+
+        glyph.advance = m_face->glyph->advance.x >> 6;
+
+#if bwxGL_TTF_HAS_SDF
+        // The field adds the spread on every side, bitmap_left/top already account for it.
+        // A blank glyph (space) has no outline to render - it keeps its advance only
+        if (distanceField && FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_SDF)) return true;
+#endif
+
+        FT_Bitmap& bitmap = m_face->glyph->bitmap;
+
+        glyph.size = { static_cast<int>(bitmap.width), static_cast<int>(bitmap.rows) };
+        glyph.bearing = { m_face->glyph->bitmap_left, m_face->glyph->bitmap_top };
+
+        // Nothing to draw (space) - no atlas space either
+        if (bitmap.width == 0 || bitmap.rows == 0) return true;
+
+        glm::ivec2 origin;
+        GLint page;
+        if (!Reserve(glyph.size.x, glyph.size.y, origin, page))
+        {
+            std::cerr << "Glyph " << code << " does not fit into an atlas page." << std::endl;
+            glyph.size = glm::ivec2(0);
+            return false;
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, bitmap.pitch);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureAtlas);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, origin.x, origin.y, page, bitmap.width, bitmap.rows, 1, GL_RED, GL_UNSIGNED_BYTE, bitmap.buffer);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+        // Bitmap rows run top-down, as the quads in bwxGLText expect
+        const float atlasSize = static_cast<float>(bwxGL_TTF_ATLAS_SIZE);
+        glyph.uvTopLeft = glm::vec2(origin.x / atlasSize, (origin.y + glyph.size.y) / atlasSize);
+        glyph.uvBottomRight = glm::vec2((origin.x + glyph.size.x) / atlasSize, origin.y / atlasSize);
+        glyph.page = page;
 
         return true;
     }
 
-	GLuint bwxGLTTF::GetTextureAtlas() const
-	{
-		return m_textureAtlas;
-	}
+    bool bwxGLTTF::Reserve(int width, int height, glm::ivec2& origin, GLint& page)
+    {
+        const int w = width + bwxGL_TTF_GLYPH_PADDING;
+        const int h = height + bwxGL_TTF_GLYPH_PADDING;
+        if (w > bwxGL_TTF_ATLAS_SIZE || h > bwxGL_TTF_ATLAS_SIZE) return false;
 
-	bwxGLTTF::bwxGLTTFGlyph& bwxGLTTF::GetGlyph(wchar_t c)
-	{
-		return m_glyphs.at(c);
-	}
+        // Shelf packing: the tightest shelf with room, unless it would waste more than half of a new one
+        Shelf* best = nullptr;
+        for (Shelf& shelf : m_shelves)
+        {
+            if (shelf.height < h || shelf.x + w > bwxGL_TTF_ATLAS_SIZE) continue;
+            if (!best || shelf.height < best->height) best = &shelf;
+        }
 
-    std::map<GLchar, bwxGLTTF::bwxGLTTFGlyph>& bwxGLTTF::GetGlyphs() { return m_glyphs; }
+        const bool roomForShelf = m_pageTop + h <= bwxGL_TTF_ATLAS_SIZE;
+        if (best && (best->height <= h + h / 2 || !roomForShelf))
+        {
+            origin = { best->x, best->y };
+            page = best->page;
+            best->x += w;
+            return true;
+        }
+
+        if (!roomForShelf) AddPage();
+
+        m_shelves.push_back({ m_pageCount - 1, m_pageTop, h, w });
+        origin = { 0, m_pageTop };
+        page = m_pageCount - 1;
+        m_pageTop += h;
+        return true;
+    }
 
-    int bwxGLTTF::GetGlyphHeight(wchar_t c) const { return m_glyphs.at(c).size.y; }
+    void bwxGLTTF::AddPage()
+    {
+        GLuint grown = 0;
+        glGenTextures(1, &grown);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, grown);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R8, bwxGL_TTF_ATLAS_SIZE, bwxGL_TTF_ATLAS_SIZE, m_pageCount + 1);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // The padding around glyphs must read as empty (also "far outside" for distance fields)
+        const std::vector<unsigned char> empty(static_cast<size_t>(bwxGL_TTF_ATLAS_SIZE) * bwxGL_TTF_ATLAS_SIZE, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, m_pageCount, bwxGL_TTF_ATLAS_SIZE, bwxGL_TTF_ATLAS_SIZE, 1, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
-    int bwxGLTTF::GetGlyphWidth(wchar_t c) const { return m_glyphs.at(c).size.x; }
-    
-    bwxGLText::bwxGLText(bwxGLTTF& font) : m_font(font)
+        // Immutable storage - the packed pages move over on the GPU, glyph UVs stay as they are
+        if (m_textureAtlas)
+        {
+            glCopyImageSubData(m_textureAtlas, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                grown, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                bwxGL_TTF_ATLAS_SIZE, bwxGL_TTF_ATLAS_SIZE, m_pageCount);
+            glDeleteTextures(1, &m_textureAtlas);
+        }
+
+        m_textureAtlas = grown;
+        m_pageCount++;
+        m_pageTop = 0;
+    }
+
+    bwxGLText::bwxGLText(bwxGLTTF& font) : m_font(&font)
 	{
-		GLsizeiptr bufferSize = sizeof(GLfloat) * 6 * 4;
-        m_dynamicBuffer = std::make_shared<bwxGLBuffer>();
-        m_dynamicBuffer->Create(bufferSize, 4, { 4 }, GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW);
-		SetDefaultShaderProgram();
+		GLsizeiptr regionSize = sizeof(GLfloat) * 6 * bwxGL_TEXT_VERTEX_FLOATS * bwxGL_TEXT_RING_GLYPHS;
+        m_dynamicBuffer = std::make_shared<bwxGLRingBuffer>(GL_ARRAY_BUFFER, regionSize, bwxGL_TEXT_VERTEX_FLOATS, std::vector<GLint>{ 4, 4, 1 });
+        // The default program is picked up by the first Flush()
     }
 
 	bwxGLText::~bwxGLText()
@@ -188,76 +388,143 @@ namespace bwx_sdk {
 	void bwxGLText::SetShaderProgram(std::shared_ptr<bwxGLShaderProgram> shader)
 	{
 		m_shaderProgram = shader;
+        m_distanceField = false;
 	}
 
 	void bwxGLText::SetDefaultShaderProgram()
 	{
-		m_shaderProgram = std::make_shared<bwxGLShaderProgram>();
-		m_shaderProgram->AttachShader(bwxGLShader(SHADER_VERTEX, bwxGLShaderGenerator::GetDefaultTTFVertexShader()));
-		m_shaderProgram->AttachShader(bwxGLShader(SHADER_FRAGMENT, bwxGLShaderGenerator::GetDefaultTTFFragmentShader()));
-        if (m_shaderProgram->Link())
+        if (m_font->GetMode() == bwxGL_TTF_MODE::TTF_SDF)
         {
-            m_shaderProgram->Bind();
-			m_shaderProgram->AddUniform("projection"); // Add to uniform cache if exists in program
-			m_shaderProgram->AddUniform("textColor"); // Add to uniform cache if exists in program
-            m_shaderProgram->Unbind();
+            SetSDFShaderProgram();
+            return;
         }
+
+        m_distanceField = false;
+        m_shaderProgram = GetTextProgram(false);
 	}
 
+    void bwxGLText::SetSDFShaderProgram()
+    {
+        m_distanceField = true;
+        m_shaderProgram = GetTextProgram(true);
+    }
+
+    void bwxGLText::SetOutline(GLfloat width, const glm::vec4& color)
+    {
+        m_outlineWidth = width;
+        m_outlineColor = color;
+    }
+
     void bwxGLText::SetFont(bwxGLTTF& font) {
-        m_font = font;
+        m_font = &font;
     }
 
 	int bwxGLText::GetFontHeight() {
-		return m_font.GetGlyph('H').size.y;
+		return m_font->GetGlyph('H').size.y;
 	}
 
     void bwxGLText::Render(const std::wstring& text, const glm::mat4& orth, const glm::vec2& pos, GLfloat scale, const glm::vec4& color)
     {
-        // Activate corresponding render state
-        m_shaderProgram->Bind();
-        m_shaderProgram->SetUniform("projection", orth);
-        m_shaderProgram->SetUniform("textColor", color[0], color[1], color[2], color[3]);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_font.GetTextureAtlas());
+        Queue(text, pos, scale, color);
+        Flush(orth);
+    }
 
-        // Initialize VAO/VBO once (ideally this should be done during class initialization)
-        glBindVertexArray(m_dynamicBuffer->GetVAO());
+    void bwxGLText::Queue(const std::wstring& text, const glm::vec2& pos, GLfloat scale, const glm::vec4& color)
+    {
+        m_batch.reserve(m_batch.size() + text.size() * 6 * bwxGL_TEXT_VERTEX_FLOATS);
 
         GLfloat x = pos.x;
-        GLfloat y = pos.y;
-
         for (auto c : text)
         {
-            const auto& ch = m_font.GetGlyph(c);
+            x += QueueGlyph(c, glm::vec2(x, pos.y), scale, color);
+        }
+    }
+
+    GLfloat bwxGLText::QueueGlyph(wchar_t c, const glm::vec2& pos, GLfloat scale, const glm::vec4& color)
+    {
+        const auto& ch = m_font->GetGlyph(c);
+
+        GLfloat xpos = pos.x + ch.bearing.x * scale;
+        GLfloat ypos = pos.y - (ch.size.y - ch.bearing.y) * scale;
+
+        GLfloat w = ch.size.x * scale;
+        GLfloat h = ch.size.y * scale;
+
+        const GLfloat vertices[6][4] = {
+            { xpos,     ypos + h,   ch.uvTopLeft.x,     ch.uvBottomRight.y },
+            { xpos,     ypos,       ch.uvTopLeft.x,     ch.uvTopLeft.y },
+            { xpos + w, ypos,       ch.uvBottomRight.x, ch.uvTopLeft.y },
+
+            { xpos,     ypos + h,   ch.uvTopLeft.x,     ch.uvBottomRight.y },
+            { xpos + w, ypos,       ch.uvBottomRight.x, ch.uvTopLeft.y },
+            { xpos + w, ypos + h,   ch.uvBottomRight.x, ch.uvBottomRight.y }
+        };
+
+        // Colour and page per vertex, so strings of any colour share one draw
+        const GLfloat page = static_cast<GLfloat>(ch.page);
+        for (const auto& v : vertices)
+        {
+            m_batch.insert(m_batch.end(), { v[0], v[1], v[2], v[3], color.r, color.g, color.b, color.a, page });
+        }
+
+        return ch.advance * scale;
+    }
+
+    void bwxGLText::Flush(const glm::mat4& orth)
+    {
+        if (m_batch.empty()) return;
+
+        if (!m_shaderProgram) SetDefaultShaderProgram();
+        if (!m_shaderProgram)
+        {
+            m_batch.clear();
+            return;
+        }
+
+        bwxGL_PROFILE_SCOPE("Text");
+        auto& profiler = bwxGLProfiler::GetInstance();
+
+        // Activate corresponding render state; the colour comes with the vertices
+        m_shaderProgram->Bind();
+        m_shaderProgram->SetUniform("projection", orth);
+        m_shaderProgram->SetUniform("textColor", 1.0f, 1.0f, 1.0f, 1.0f);
+        if (m_distanceField)
+        {
+            m_shaderProgram->SetUniform("outlineWidth", m_outlineWidth);
+            m_shaderProgram->SetUniform("outlineColor", m_outlineColor[0], m_outlineColor[1], m_outlineColor[2], m_outlineColor[3]);
+        }
 
-            GLfloat xpos = x + ch.bearing.x * scale;
-            GLfloat ypos = y - (ch.size.y - ch.bearing.y) * scale;
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_font->GetTextureAtlas());
 
-            GLfloat w = ch.size.x * scale;
-            GLfloat h = ch.size.y * scale;
+        glBindVertexArray(m_dynamicBuffer->GetVAO());
 
-            GLfloat vertices[6][4] = {
-                { xpos,     ypos + h,   ch.uvTopLeft.x,     ch.uvBottomRight.y },
-                { xpos,     ypos,       ch.uvTopLeft.x,     ch.uvTopLeft.y },
-                { xpos + w, ypos,       ch.uvBottomRight.x, ch.uvTopLeft.y },
+        // Written straight into the mapped ring; a batch larger than a region is split at region size
+        const GLsizeiptr vertexSize = sizeof(GLfloat) * bwxGL_TEXT_VERTEX_FLOATS;
+        const size_t vertexCount = m_batch.size() / bwxGL_TEXT_VERTEX_FLOATS;
+        const size_t maxVertices = static_cast<size_t>(m_dynamicBuffer->GetRegionSize() / vertexSize) / 6 * 6;
 
-                { xpos,     ypos + h,   ch.uvTopLeft.x,     ch.uvBottomRight.y },
-                { xpos + w, ypos,       ch.uvBottomRight.x, ch.uvTopLeft.y },
-                { xpos + w, ypos + h,   ch.uvBottomRight.x, ch.uvBottomRight.y }
-            };
+        for (size_t first = 0; first < vertexCount; first += maxVertices)
+        {
+            const size_t count = std::min(maxVertices, vertexCount - first);
+            const GLsizeiptr size = static_cast<GLsizeiptr>(count) * vertexSize;
 
-            glBindBuffer(GL_ARRAY_BUFFER, m_dynamicBuffer->GetID());
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+            GLintptr offset = 0;
+            void* dst = m_dynamicBuffer->Allocate(size, vertexSize, offset);
+            if (!dst) break;
 
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+            std::memcpy(dst, m_batch.data() + first * bwxGL_TEXT_VERTEX_FLOATS, static_cast<size_t>(size));
+            m_dynamicBuffer->Commit(offset, size);
 
-            x += (ch.advance) * scale;
+            glDrawArrays(GL_TRIANGLES, static_cast<GLint>(offset / vertexSize), static_cast<GLsizei>(count));
+            profiler.AddDrawCalls();
+            profiler.AddUploadedBytes(static_cast<uint64_t>(size));
         }
 
+        m_batch.clear();
+
         glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
         m_shaderProgram->Unbind();
     }
 
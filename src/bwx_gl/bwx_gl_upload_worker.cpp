@@ -0,0 +1,213 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_upload_worker.cpp
+// Purpose:     BWX_SDK Library; OpenGL Background resource creation on a shared context
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-15
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <exception>
+#include <iterator>
+
+#include <bwx_sdk/bwx_core/bwx_log.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_upload_worker.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_utils.h>
+
+namespace bwx_sdk {
+
+    bwxGLUploadWorker& bwxGLUploadWorker::GetInstance() {
+        static bwxGLUploadWorker instance;
+        return instance;
+    }
+
+    bwxGLUploadWorker::~bwxGLUploadWorker() {
+        // Static destruction: the canvas and wx are gone, so no wx or GL call may happen here. Stop() was
+        // not called - the jobs are abandoned (their captures may own GL objects, so they are leaked, not
+        // destroyed) and the context is leaked too; only the thread is joined, after the job it is running
+        if (!IsRunning()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            new std::deque<Job>(std::move(m_queue));
+            m_queue.clear();
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+
+        new std::vector<Job>(std::move(m_finished));
+        m_finished.clear();
+        m_context.release();
+    }
+
+    bool bwxGLUploadWorker::Start(wxGLCanvas* canvas, const wxGLContext* shareWith, int major, int minor) {
+        if (IsRunning()) return true;
+
+        m_context = bwxGLUtils::CreateSharedContext(canvas, shareWith, major, minor);
+        if (!m_context) {
+            BWX_LOG_ERROR("bwxGLUploadWorker: cannot create a context shared with the main one");
+            return false;
+        }
+
+        m_canvas = canvas;
+        m_stopping = false;
+        m_startDone = false;
+        m_thread = std::thread(&bwxGLUploadWorker::ThreadLoop, this);
+
+        bool ok = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_started.wait(lock, [this] { return m_startDone; });
+            ok = m_startOK;
+        }
+
+        if (!ok) {
+            m_thread.join();
+            m_context.reset();
+        }
+        return ok;
+    }
+
+    void bwxGLUploadWorker::Stop() {
+        if (!IsRunning()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+        m_context.reset();
+    }
+
+    bool bwxGLUploadWorker::IsRunning() const {
+        return m_thread.joinable();
+    }
+
+    void bwxGLUploadWorker::Submit(std::function<bool()> create, std::function<void(bool)> ready) {
+        if (!create) return;
+
+        Job job;
+        job.create = std::move(create);
+        job.ready = std::move(ready);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(job));
+        }
+        m_wake.notify_one();
+    }
+
+    size_t bwxGLUploadWorker::Update() {
+        std::vector<Job> jobs;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            jobs.swap(m_finished);
+
+            // No worker - created here, on the GL thread, so there is nothing to wait for
+            if (!IsRunning()) {
+                while (!m_queue.empty()) {
+                    jobs.push_back(std::move(m_queue.front()));
+                    m_queue.pop_front();
+                }
+            }
+        }
+
+        size_t done = 0;
+        std::vector<Job> waiting;
+        for (Job& job : jobs) {
+            if (job.create) {
+                try {
+                    job.ok = job.create();
+                }
+                catch (const std::exception& e) {
+                    BWX_LOG_ERROR("bwxGLUploadWorker: %s", e.what());
+                    job.ok = false;
+                }
+                job.create = nullptr;
+            }
+            else if (job.fence) {
+                // Polled only; the next Update() looks again
+                const GLenum status = glClientWaitSync(job.fence, 0, 0);
+                if (status == GL_TIMEOUT_EXPIRED) {
+                    waiting.push_back(std::move(job));
+                    continue;
+                }
+                glDeleteSync(job.fence);
+                job.fence = nullptr;
+            }
+
+            if (job.ready) job.ready(job.ok);
+            ++done;
+        }
+
+        if (!waiting.empty()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished.insert(m_finished.begin(), std::make_move_iterator(waiting.begin()), std::make_move_iterator(waiting.end()));
+        }
+        return done;
+    }
+
+    void bwxGLUploadWorker::Flush() {
+        while (GetPendingCount() > 0) {
+            if (Update() == 0) std::this_thread::yield();
+        }
+    }
+
+    size_t bwxGLUploadWorker::GetPendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size() + m_running + m_finished.size();
+    }
+
+    void bwxGLUploadWorker::ThreadLoop() {
+        const bool ok = m_canvas->SetCurrent(*m_context);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_startDone = true;
+            m_startOK = ok;
+        }
+        m_started.notify_all();
+
+        if (!ok) {
+            BWX_LOG_ERROR("bwxGLUploadWorker: cannot make the shared context current on the worker");
+            return;
+        }
+
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) break;  // Stopping, and every queued job has run
+
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+                ++m_running;
+            }
+
+            try {
+                job.ok = job.create();
+            }
+            catch (const std::exception& e) {
+                BWX_LOG_ERROR("bwxGLUploadWorker: %s", e.what());
+                job.ok = false;
+            }
+            job.create = nullptr;  // Captures released here, with the shared context current
+
+            // Signalled when the GPU has executed the job; flushed, or the main context could wait forever
+            job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_running;
+                m_finished.push_back(std::move(job));
+            }
+        }
+    }
+
+} // namespace bwx_sdk
@@ -11,11 +11,15 @@
 #error OpenGL functionality is not available for macOS.
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <thread>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
 
+#include <wx/display.h>
+
 #include <bwx_sdk/bwx_gl/bwx_gl_utils.h>
 
 namespace bwx_sdk {
@@ -46,6 +50,17 @@ namespace bwx_sdk {
 		return ret;
 	}
 
+	std::unique_ptr<wxGLContext> bwxGLUtils::CreateSharedContext(wxGLCanvas* canvas, const wxGLContext* other, int major, int minor)
+	{
+		if (!canvas || !other) return nullptr;
+
+		// Sharing needs the same profile and version as the other context
+		wxGLContextAttrs attrs = GetDefaultContextAttrs(major, minor);
+		auto context = std::make_unique<wxGLContext>(canvas, other, &attrs);
+		if (!context->IsOK()) return nullptr;
+		return context;
+	}
+
 	wxGLAttributes bwxGLUtils::GetDefaultCanvasAttrs(int depth)
 	{
 		wxGLAttributes ret;
@@ -159,6 +174,10 @@ namespace bwx_sdk {
 		std::chrono::duration<GLfloat> delta = now - m_frameStart;
 		m_lastDelta = delta.count();
 		m_frameStart = now;
+
+		m_frameTimes[m_frameTimeNext] = m_lastDelta;
+		m_frameTimeNext = (m_frameTimeNext + 1) % m_frameTimes.size();
+		m_frameTimeCount = std::min(m_frameTimeCount + 1, m_frameTimes.size());
 	}
 
 	void bwxGLFPSMonitor::LimitFPS(int targetFPS)
@@ -168,6 +187,39 @@ namespace bwx_sdk {
 
 		using namespace std::chrono;
 
+		if (m_pacing == bwxGL_FRAME_PACING::FRAME_PACING_PRECISE)
+		{
+			double period = 1.0 / static_cast<double>(targetFPS);
+			if (m_refreshRate > 0.0)
+			{
+				// Whole refresh intervals - a frame never straddles two vsyncs
+				const double interval = 1.0 / m_refreshRate;
+				period = interval * std::max(1.0, std::round(period / interval));
+			}
+			const auto step = duration_cast<steady_clock::duration>(duration<double>(period));
+
+			if (!m_deadlineSet || m_deadlineFPS != targetFPS)
+			{
+				m_deadline = m_frameStart;
+				m_deadlineFPS = targetFPS;
+				m_deadlineSet = true;
+			}
+
+			// Deadlines follow each other, so a late frame shortens the next one instead of shifting all later frames
+			m_deadline += step;
+
+			const auto now = steady_clock::now();
+			if (now > m_deadline + step)
+			{
+				// More than a frame behind (hitch, breakpoint) - start again rather than rush to catch up
+				m_deadline = now;
+				return;
+			}
+
+			WaitUntil(m_deadline);
+			return;
+		}
+
 		const GLfloat targetFrameTime = 1.0f / static_cast<GLfloat>(targetFPS);
 		auto now = steady_clock::now();
 		std::chrono::duration<GLfloat> frameTime = now - m_frameStart;
@@ -184,6 +236,66 @@ namespace bwx_sdk {
 		}
 	}
 
+	void bwxGLFPSMonitor::WaitUntil(std::chrono::steady_clock::time_point deadline)
+	{
+		using namespace std::chrono;
+
+		// Coarse part: 1 ms sleeps while even a long one (mean + std. deviation) ends before the deadline
+		while (duration<double>(deadline - steady_clock::now()).count() > m_sleepEstimate)
+		{
+			const auto start = steady_clock::now();
+			std::this_thread::sleep_for(milliseconds(1));
+			const double observed = duration<double>(steady_clock::now() - start).count();
+
+			// Welford; the count is capped, so the estimate follows changes of the timer resolution.
+			// Once capped, M2 forgets the same share as the mean or the variance would grow without bound
+			if (m_sleepCount < 1000) ++m_sleepCount;
+			else m_sleepM2 *= static_cast<double>(m_sleepCount - 1) / static_cast<double>(m_sleepCount);
+			const double delta = observed - m_sleepMean;
+			m_sleepMean += delta / static_cast<double>(m_sleepCount);
+			m_sleepM2 += delta * (observed - m_sleepMean);
+			m_sleepEstimate = m_sleepMean + std::sqrt(std::max(0.0, m_sleepM2 / static_cast<double>(m_sleepCount - 1)));
+		}
+
+		// Fine part: spin, yielding so the other threads keep the core
+		while (steady_clock::now() < deadline)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	bool bwxGLFPSMonitor::AlignToDisplay(const wxWindow* window)
+	{
+		const int index = window ? wxDisplay::GetFromWindow(window) : wxNOT_FOUND;
+		const int refresh = wxDisplay(index != wxNOT_FOUND ? static_cast<unsigned>(index) : 0u).GetCurrentMode().GetRefresh();
+		if (refresh <= 0)
+			return false;
+
+		SetRefreshRate(static_cast<double>(refresh));
+		return true;
+	}
+
+	GLfloat bwxGLFPSMonitor::GetFrameTimeVariance() const
+	{
+		if (m_frameTimeCount < 2)
+			return 0.0f;
+
+		double mean = 0.0;
+		for (size_t i = 0; i < m_frameTimeCount; ++i)
+			mean += m_frameTimes[i];
+		mean /= static_cast<double>(m_frameTimeCount);
+
+		double sum = 0.0;
+		for (size_t i = 0; i < m_frameTimeCount; ++i)
+			sum += (m_frameTimes[i] - mean) * (m_frameTimes[i] - mean);
+		return static_cast<GLfloat>(sum / static_cast<double>(m_frameTimeCount - 1));
+	}
+
+	GLfloat bwxGLFPSMonitor::GetFrameTimeStdDev() const
+	{
+		return std::sqrt(GetFrameTimeVariance());
+	}
+
 	GLfloat bwxGLFPSMonitor::GetDelta() const
 	{
 		return m_lastDelta;
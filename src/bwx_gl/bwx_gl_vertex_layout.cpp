@@ -0,0 +1,207 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bwx_gl_vertex_layout.cpp
+// Purpose:     BWX_SDK Library; OpenGL Interleaved vertex layout descriptor
+// Author:      Bartosz Warzocha <bartosz.warzocha@gmail.com>
+// Created:     2026-10-14
+// Copyright:   (c) 2026 by Bartosz Warzocha
+// Licence:     wxWidgets licence
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__APPLE__)
+#error OpenGL functionality is not available for macOS.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <bwx_sdk/bwx_gl/bwx_gl_vertex_layout.h>
+#include <bwx_sdk/bwx_gl/bwx_gl_mesh.h>
+
+namespace bwx_sdk {
+
+    namespace {
+        uint16_t FloatToHalf(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            const uint32_t sign = (bits >> 16) & 0x8000u;
+            const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+            uint32_t mantissa = bits & 0x007FFFFFu;
+
+            if (exponent >= 31) {
+                // Overflow becomes infinity, NaN stays NaN
+                const bool nan = ((bits >> 23) & 0xFFu) == 0xFFu && mantissa;
+                return static_cast<uint16_t>(sign | 0x7C00u | (nan ? 0x200u : 0u));
+            }
+            if (exponent <= 0) {
+                if (exponent < -10) return static_cast<uint16_t>(sign);
+                // Denormal
+                mantissa |= 0x00800000u;
+                const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+                uint32_t half = mantissa >> shift;
+                if ((mantissa >> (shift - 1)) & 1u) ++half;
+                return static_cast<uint16_t>(sign | half);
+            }
+
+            uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+            if (mantissa & 0x00001000u) ++half; // Round to nearest; a carry into the exponent is correct
+            return static_cast<uint16_t>(half);
+        }
+
+        uint32_t PackSnorm10(const float* v, GLint count) {
+            uint32_t packed = 0;
+            for (GLint i = 0; i < 3; ++i) {
+                const float c = i < count ? std::clamp(v[i], -1.0f, 1.0f) : 0.0f;
+                const int32_t q = static_cast<int32_t>(std::lround(c * 511.0f));
+                packed |= (static_cast<uint32_t>(q) & 0x3FFu) << (10 * i);
+            }
+            return packed; // w = 0
+        }
+
+        uint32_t PackUnorm8(const float* v, GLint count) {
+            uint32_t packed = 0;
+            for (GLint i = 0; i < 4; ++i) {
+                const float c = i < count ? std::clamp(v[i], 0.0f, 1.0f) : 1.0f;
+                packed |= static_cast<uint32_t>(std::lround(c * 255.0f)) << (8 * i);
+            }
+            return packed;
+        }
+    }
+
+    bwxGLVertexLayout bwxGLVertexLayout::FromMeshFormat(int format) {
+        bwxGLVertexLayout layout;
+        layout.Add(bwxGL_ATTRIB_POSITION, 3, offsetof(bwxGLVertex, position));
+
+        const bool compact = (format & bwxGL_MESH_COMPACT) != 0;
+        const bwxGLVertexEncoding direction = compact ? bwxGL_ENCODING_SNORM_10_10_10 : bwxGL_ENCODING_FLOAT;
+        const bwxGLVertexEncoding uv = compact ? bwxGL_ENCODING_HALF : bwxGL_ENCODING_FLOAT;
+        const bwxGLVertexEncoding color = compact ? bwxGL_ENCODING_UNORM8 : bwxGL_ENCODING_FLOAT;
+
+        if (format & bwxGL_MESH_NORMAL) layout.Add(bwxGL_ATTRIB_NORMAL, 3, offsetof(bwxGLVertex, normal), direction);
+        if (format & bwxGL_MESH_TEX_COORD) layout.Add(bwxGL_ATTRIB_TEX_COORD, 2, offsetof(bwxGLVertex, texCoord), uv);
+        if (format & bwxGL_MESH_TANGENT) layout.Add(bwxGL_ATTRIB_TANGENT, 3, offsetof(bwxGLVertex, tangent), direction);
+        if (format & bwxGL_MESH_BITANGENT) layout.Add(bwxGL_ATTRIB_BITANGENT, 3, offsetof(bwxGLVertex, bitangent), direction);
+        if (format & bwxGL_MESH_COLOR) layout.Add(bwxGL_ATTRIB_COLOR, 3, offsetof(bwxGLVertex, color), color);
+        if (format & bwxGL_MESH_SKINNED) {
+            layout.Add(bwxGL_ATTRIB_BONE_INDICES, 4, offsetof(bwxGLVertex, boneIndices), bwxGL_ENCODING_UINT16);
+            layout.Add(bwxGL_ATTRIB_BONE_WEIGHTS, 4, offsetof(bwxGLVertex, boneWeights), color);
+        }
+
+        return layout;
+    }
+
+    void bwxGLVertexLayout::Add(GLuint location, GLint components, size_t sourceOffset, bwxGLVertexEncoding encoding) {
+        bwxGLVertexAttribute attribute;
+        attribute.location = location;
+        attribute.components = components;
+        attribute.sourceComponents = components;
+        attribute.type = GL_FLOAT;
+        attribute.normalized = GL_FALSE;
+        attribute.encoding = encoding;
+        attribute.offset = static_cast<GLuint>(m_stride);
+        attribute.sourceOffset = sourceOffset;
+
+        GLsizei bytes = static_cast<GLsizei>(components * sizeof(float));
+        switch (encoding) {
+        case bwxGL_ENCODING_HALF:
+            attribute.type = GL_HALF_FLOAT;
+            bytes = (components * 2 + 3) & ~3; // Keep the next attribute 4-byte aligned
+            break;
+        case bwxGL_ENCODING_SNORM_10_10_10:
+            // Packed types need size 4; a vec3 attribute simply ignores w
+            attribute.components = 4;
+            attribute.type = GL_INT_2_10_10_10_REV;
+            attribute.normalized = GL_TRUE;
+            bytes = 4;
+            break;
+        case bwxGL_ENCODING_UNORM8:
+            attribute.components = 4;
+            attribute.type = GL_UNSIGNED_BYTE;
+            attribute.normalized = GL_TRUE;
+            bytes = 4;
+            break;
+        case bwxGL_ENCODING_UINT16:
+            attribute.type = GL_UNSIGNED_SHORT;
+            bytes = (components * 2 + 3) & ~3;
+            break;
+        default:
+            break;
+        }
+
+        m_attributes.push_back(attribute);
+        m_stride += bytes;
+    }
+
+    void bwxGLVertexLayout::Write(const void* source, unsigned char* dst) const {
+        const unsigned char* src = static_cast<const unsigned char*>(source);
+
+        for (const auto& attribute : m_attributes) {
+            const float* values = reinterpret_cast<const float*>(src + attribute.sourceOffset);
+            unsigned char* out = dst + attribute.offset;
+
+            switch (attribute.encoding) {
+            case bwxGL_ENCODING_HALF:
+                for (GLint i = 0; i < attribute.sourceComponents; ++i) {
+                    const uint16_t half = FloatToHalf(values[i]);
+                    std::memcpy(out + i * 2, &half, sizeof(half));
+                }
+                break;
+            case bwxGL_ENCODING_SNORM_10_10_10: {
+                const uint32_t packed = PackSnorm10(values, attribute.sourceComponents);
+                std::memcpy(out, &packed, sizeof(packed));
+                break;
+            }
+            case bwxGL_ENCODING_UNORM8: {
+                const uint32_t packed = PackUnorm8(values, attribute.sourceComponents);
+                std::memcpy(out, &packed, sizeof(packed));
+                break;
+            }
+            case bwxGL_ENCODING_UINT16:
+                for (GLint i = 0; i < attribute.sourceComponents; ++i) {
+                    const uint16_t index = static_cast<uint16_t>(std::clamp(values[i], 0.0f, 65535.0f));
+                    std::memcpy(out + i * 2, &index, sizeof(index));
+                }
+                break;
+            default:
+                std::memcpy(out, values, attribute.sourceComponents * sizeof(float));
+                break;
+            }
+        }
+    }
+
+    uint64_t bwxGLVertexLayout::GetSignature() const {
+        // FNV-1a over the fields that reach glVertexAttribPointer
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+
+        mix(static_cast<uint64_t>(m_stride));
+        for (const auto& attribute : m_attributes) {
+            mix(attribute.location);
+            mix(static_cast<uint64_t>(attribute.components));
+            mix(attribute.type);
+            mix(attribute.normalized);
+            mix(attribute.offset);
+            mix(attribute.encoding);
+        }
+        return hash;
+    }
+
+    void bwxGLVertexLayout::Apply() const {
+        for (const auto& attribute : m_attributes) {
+            const void* offset = reinterpret_cast<void*>(static_cast<intptr_t>(attribute.offset));
+            if (attribute.encoding == bwxGL_ENCODING_UINT16) {
+                glVertexAttribIPointer(attribute.location, attribute.components, attribute.type, m_stride, offset);
+            }
+            else {
+                glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized, m_stride, offset);
+            }
+            glEnableVertexAttribArray(attribute.location);
+        }
+    }
+
+} // namespace bwx_sdk
@@ -8,6 +8,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "bwx_sdk/bwx_gui/bwx_reactive.h"
+#include <wx/app.h>
+#include <wx/toplevel.h>
 #include <algorithm>
 
 namespace bwx {
@@ -18,22 +20,38 @@ namespace gui {
 // ============================================================================
 
 std::vector<bwxReactive*> bwxReactive::s_controls;
+int bwxReactive::s_passDepth = 0;
+bool bwxReactive::s_hasEmptySlots = false;
+bool bwxReactive::s_deliveryScheduled = false;
+bool bwxReactive::s_hasPendingScale = false;
+double bwxReactive::s_pendingScale = 1.0;
+bool bwxReactive::s_hasPendingTheme = false;
+std::string bwxReactive::s_pendingTheme;
 
 // ============================================================================
 // Lifecycle
 // ============================================================================
 
-bwxReactive::bwxReactive() {
+bwxReactive::bwxReactive()
+    : m_registryIndex(s_controls.size()) {
     // Register this control in static registry
     s_controls.push_back(this);
 }
 
 bwxReactive::~bwxReactive() {
-    // Unregister this control from static registry
-    auto it = std::find(s_controls.begin(), s_controls.end(), this);
-    if (it != s_controls.end()) {
-        s_controls.erase(it);
+    // Unregister this control from static registry - O(1), slot index known
+    // Pass in progress iterates by index - clear slot, compact when pass ends
+    if (s_passDepth > 0) {
+        s_controls[m_registryIndex] = nullptr;
+        s_hasEmptySlots = true;
+        return;
     }
+
+    // Swap with last control and pop (registry order does not matter)
+    bwxReactive* last = s_controls.back();
+    s_controls[m_registryIndex] = last;
+    last->m_registryIndex = m_registryIndex;
+    s_controls.pop_back();
 }
 
 // ============================================================================
@@ -41,25 +59,115 @@ bwxReactive::~bwxReactive() {
 // ============================================================================
 
 void bwxReactive::broadcastFontScaleChange(double scale) {
-    // Iterate through all registered controls and notify
-    // TODO (Task #00044): Copy vector before iteration to prevent
-    // iterator invalidation if controls are destroyed during broadcast
-    for (auto* control : s_controls) {
-        control->onFontScaleChanged(scale);
-    }
+    s_pendingScale = scale;
+    s_hasPendingScale = true;
+    scheduleDelivery();
 }
 
 void bwxReactive::broadcastThemeChange(const std::string& themeName) {
-    // Iterate through all registered controls and notify
-    // TODO (Task #00044): Copy vector before iteration to prevent
-    // iterator invalidation if controls are destroyed during broadcast
+    s_pendingTheme = themeName;
+    s_hasPendingTheme = true;
+    scheduleDelivery();
+}
+
+void bwxReactive::flushBroadcasts() {
+    deliverPending();
+}
+
+void bwxReactive::scheduleDelivery() {
+    // Running pass picks up new changes itself
+    if (s_passDepth > 0 || s_deliveryScheduled) {
+        return;
+    }
+
+    // No event loop (e.g. tests) - deliver right away
+    if (!wxTheApp) {
+        deliverPending();
+        return;
+    }
+
+    // Coalesce: changes within this event-loop tick are delivered together
+    s_deliveryScheduled = true;
+    wxTheApp->CallAfter([]() {
+        s_deliveryScheduled = false;
+        deliverPending();
+    });
+}
+
+void bwxReactive::deliverPending() {
+    if (s_passDepth > 0 || (!s_hasPendingScale && !s_hasPendingTheme)) {
+        return;
+    }
+
+    // Freeze affected top-level windows - controls update without repainting one by one
+    std::vector<wxWindow*> topLevels;
     for (auto* control : s_controls) {
-        control->onThemeChanged(themeName);
+        wxWindow* window = control->getReactiveWindow();
+        wxWindow* topLevel = window ? wxGetTopLevelParent(window) : nullptr;
+        if (topLevel && std::find(topLevels.begin(), topLevels.end(), topLevel) == topLevels.end()) {
+            topLevels.push_back(topLevel);
+            topLevel->Freeze();
+        }
+    }
+
+    // Handlers may broadcast again - repeat until nothing is pending
+    ++s_passDepth;
+    while (s_hasPendingScale || s_hasPendingTheme) {
+        if (s_hasPendingScale) {
+            s_hasPendingScale = false;
+            double scale = s_pendingScale;
+            for (size_t i = 0; i < s_controls.size(); ++i) {
+                if (s_controls[i]) {
+                    s_controls[i]->onFontScaleChanged(scale);
+                }
+            }
+        }
+
+        if (s_hasPendingTheme) {
+            s_hasPendingTheme = false;
+            std::string themeName = s_pendingTheme;
+            for (size_t i = 0; i < s_controls.size(); ++i) {
+                if (s_controls[i]) {
+                    s_controls[i]->onThemeChanged(themeName);
+                }
+            }
+        }
+    }
+
+    // One layout per top-level window, after all its controls changed
+    // (skip windows destroyed by handlers)
+    for (auto* topLevel : topLevels) {
+        if (wxTopLevelWindows.Find(topLevel)) {
+            topLevel->Layout();
+            topLevel->Thaw();
+        }
+    }
+
+    // Reactive top-level windows adjust to their new layout
+    for (size_t i = 0; i < s_controls.size(); ++i) {
+        wxWindow* window = s_controls[i] ? s_controls[i]->getReactiveWindow() : nullptr;
+        if (window && window->IsTopLevel()) {
+            s_controls[i]->onLayoutUpdated();
+        }
+    }
+    --s_passDepth;
+
+    if (s_hasEmptySlots) {
+        s_controls.erase(std::remove(s_controls.begin(), s_controls.end(), nullptr), s_controls.end());
+        for (size_t i = 0; i < s_controls.size(); ++i) {
+            s_controls[i]->m_registryIndex = i;
+        }
+        s_hasEmptySlots = false;
+    }
+
+    // Broadcast from onLayoutUpdated() - next tick
+    if (s_hasPendingScale || s_hasPendingTheme) {
+        scheduleDelivery();
     }
 }
 
 size_t bwxReactive::getRegisteredControlsCount() {
-    return s_controls.size();
+    return s_controls.size() - std::count(s_controls.begin(), s_controls.end(), nullptr);
 }
 
 } // namespace gui
@@ -17,24 +17,34 @@
 namespace bwx_sdk {
 
 	bwxBoxSizer::bwxBoxSizer(int orientation) 
-		: wxBoxSizer(orientation), m_margin(5), m_labelWidth(90), m_labelHmargin(10), m_labelVmargin(5)
+		: wxBoxSizer(orientation), m_margin(5), m_labelWidth(90), m_labelHmargin(10), m_labelVmargin(5), m_marginsDirty(false)
 	{
 
 	}
 
+	wxSize bwxBoxSizer::CalcMin()
+	{
+		// Margins of all items added since the last layout are fixed in one pass
+		if (m_marginsDirty)
+		{
+			RecalculateMargins();
+			m_marginsDirty = false;
+		}
+
+		return wxBoxSizer::CalcMin();
+	}
+
 	wxSizerItem* bwxBoxSizer::Add_(wxWindow* w, int prop, int flags, int marg)
 	{
 		wxSizerItem* ret = wxBoxSizer::Add(w, prop, flags, marg);
-		RecalculateMargins();
-		RecalcSizes();
+		m_marginsDirty = true;
 		return ret;
 	}
 
 	wxSizerItem* bwxBoxSizer::Add_(wxSizer* s, int prop, int flags, int marg)
 	{
 		wxSizerItem* ret = wxBoxSizer::Add(s, prop, flags, marg);
-		RecalculateMargins();
-		RecalcSizes();
+		m_marginsDirty = true;
 		return ret;
 	}
 
@@ -81,8 +91,6 @@ namespace bwx_sdk {
 				}
 			}
 		}
-
-		wxBoxSizer::RecalcSizes();
 	}
 
 	wxSizerItem* bwxBoxSizer::Add(wxWindow* w, int prop, int flags, int marg)
@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        bwx_text_document.cpp
-// Purpose:     Document model implementation - Gap Buffer storage, formatting, undo/redo
+// Purpose:     Document model implementation - Gap Buffer / Piece Table storage, formatting, undo/redo
 // Author:      Kalahari Team
 // Created:     2025-11-04
 // Copyright:   (c) 2025 Kalahari Project
@@ -12,9 +12,26 @@
 	#include <wx/wx.h>
 #endif
 
+#include <wx/filefn.h>
+#include <wx/hashmap.h>
+
+#if defined(_WIN32)
+	#include <wx/msw/wrapwin.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
 #include <bwx_sdk/bwx_gui/bwx_text_document.h>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
 
 namespace bwx_sdk {
 namespace gui {
@@ -36,6 +53,11 @@ namespace gui {
 /// - Insert elsewhere: O(n) - move gap to position
 /// - Delete at gap: O(1) - expand gap
 /// - Get char: O(1) - check if before/after gap
+///
+/// Newline index follows the same split: newlines before the gap are kept as
+/// positions, newlines after it as distances from the end of text, so edits at
+/// the gap leave both lists valid and only a gap move shifts entries between them.
+/// Line lookups are binary searches - O(log n).
 class GapBufferStorage : public ITextStorage
 {
 public:
@@ -64,19 +86,7 @@ public:
 		if (m_gapStart == 0 && m_gapEnd == m_bufferSize)
 			return wxEmptyString;
 
-		// Concatenate text before gap and after gap
-		wxString result;
-		result.Alloc(GetLength());
-
-		// Text before gap
-		for (int i = 0; i < m_gapStart; ++i)
-			result.Append(m_buffer[i]);
-
-		// Text after gap
-		for (int i = m_gapEnd; i < m_bufferSize; ++i)
-			result.Append(m_buffer[i]);
-
-		return result;
+		return GetText(0, GetLength());
 	}
 
 	wxString GetText(int startPos, int endPos) const override
@@ -87,8 +97,16 @@ public:
 		wxString result;
 		result.Alloc(endPos - startPos);
 
-		for (int i = startPos; i < endPos; ++i)
-			result.Append(GetChar(i));
+		// Part before gap, then part after gap - two block copies
+		if (startPos < m_gapStart)
+			result.append(m_buffer + startPos, std::min(endPos, m_gapStart) - startPos);
+
+		if (endPos > m_gapStart)
+		{
+			int gapSize = m_gapEnd - m_gapStart;
+			int from = std::max(startPos, m_gapStart);
+			result.append(m_buffer + from + gapSize, endPos - from);
+		}
 
 		return result;
 	}
@@ -109,6 +127,14 @@ public:
 
 		m_gapStart = newLength;
 		m_gapEnd = m_bufferSize;
+
+		m_newlinesBefore.clear();
+		m_newlinesAfter.clear();
+		for (int i = 0; i < newLength; ++i)
+		{
+			if (m_buffer[i] == '\n')
+				m_newlinesBefore.push_back(i);
+		}
 	}
 
 	void InsertText(int pos, const wxString& text) override
@@ -130,7 +156,11 @@ public:
 
 		// Insert text into gap
 		for (int i = 0; i < textLength; ++i)
+		{
+			if (text[i] == '\n')
+				m_newlinesBefore.push_back(m_gapStart);
 			m_buffer[m_gapStart++] = text[i];
+		}
 	}
 
 	void DeleteText(int startPos, int endPos) override
@@ -141,6 +171,10 @@ public:
 		// Move gap to deletion start
 		MoveGapTo(startPos);
 
+		// Drop newlines of deleted text (nearest to the gap are at the back)
+		while (!m_newlinesAfter.empty() && GetLength() - m_newlinesAfter.back() < endPos)
+			m_newlinesAfter.pop_back();
+
 		// Expand gap to cover deleted text
 		m_gapEnd += (endPos - startPos);
 	}
@@ -166,6 +200,52 @@ public:
 	{
 		m_gapStart = 0;
 		m_gapEnd = m_bufferSize;
+		m_newlinesBefore.clear();
+		m_newlinesAfter.clear();
+	}
+
+	void ForEachChunk(int startPos, int endPos, const TextChunkVisitor& visitor) const override
+	{
+		startPos = std::max(startPos, 0);
+		endPos = std::min(endPos, GetLength());
+
+		if (startPos < std::min(endPos, m_gapStart))
+			visitor(m_buffer + startPos, std::min(endPos, m_gapStart) - startPos);
+
+		int from = std::max(startPos, m_gapStart);
+		if (from < endPos)
+			visitor(m_buffer + from + (m_gapEnd - m_gapStart), endPos - from);
+	}
+
+	int GetLineCount() const override
+	{
+		return static_cast<int>(m_newlinesBefore.size() + m_newlinesAfter.size()) + 1;
+	}
+
+	int GetLineStart(int line) const override
+	{
+		if (line <= 0)
+			return 0;
+
+		int newline = std::min(line, GetLineCount() - 1) - 1;
+		int before = static_cast<int>(m_newlinesBefore.size());
+		if (newline < before)
+			return m_newlinesBefore[newline] + 1;
+
+		// After-gap list runs from the end of text towards the gap
+		return GetLength() - m_newlinesAfter[m_newlinesAfter.size() - 1 - (newline - before)] + 1;
+	}
+
+	int GetLineFromPosition(int pos) const override
+	{
+		pos = std::max(0, std::min(pos, GetLength()));
+
+		if (pos <= m_gapStart)
+			return static_cast<int>(std::lower_bound(m_newlinesBefore.begin(), m_newlinesBefore.end(), pos) - m_newlinesBefore.begin());
+
+		// Newlines after gap with position < pos have distance > length - pos
+		auto it = std::upper_bound(m_newlinesAfter.begin(), m_newlinesAfter.end(), GetLength() - pos);
+		return static_cast<int>(m_newlinesBefore.size() + (m_newlinesAfter.end() - it));
 	}
 
 private:
@@ -194,6 +274,12 @@ private:
 
 			m_gapStart -= distance;
 			m_gapEnd -= distance;
+
+			while (!m_newlinesBefore.empty() && m_newlinesBefore.back() >= pos)
+			{
+				m_newlinesAfter.push_back(GetLength() - m_newlinesBefore.back());
+				m_newlinesBefore.pop_back();
+			}
 		}
 		else if (pos > m_gapStart)
 		{
@@ -204,6 +290,12 @@ private:
 
 			m_gapStart += distance;
 			m_gapEnd += distance;
+
+			while (!m_newlinesAfter.empty() && GetLength() - m_newlinesAfter.back() < pos)
+			{
+				m_newlinesBefore.push_back(GetLength() - m_newlinesAfter.back());
+				m_newlinesAfter.pop_back();
+			}
 		}
 	}
 
@@ -236,542 +328,1989 @@ private:
 	int m_bufferSize;      ///< Total buffer size
 	int m_gapStart;        ///< Start of gap
 	int m_gapEnd;          ///< End of gap (exclusive)
+
+	std::vector<int> m_newlinesBefore;  ///< Positions of newlines before gap (ascending)
+	std::vector<int> m_newlinesAfter;   ///< Distances of newlines after gap from end of text (ascending)
 };
 
 // ============================================================================
-// Text Command Implementations
+// Mapped Text Buffer - read-only UTF-8 file, decoded on demand
 // ============================================================================
 
-/// Insert text command
-class InsertTextCommand : public ITextCommand
+/// Bytes per decoded block of a mapped file (cut at the next character boundary)
+static const size_t MAPPED_BLOCK_BYTES = 64 * 1024;
+
+/// Decoded blocks kept per mapped file (most recently used)
+static const size_t MAPPED_CACHED_BLOCKS = 16;
+
+/// Decode UTF-8 sequence whose lead byte was read (p is past it, advanced past the sequence)
+/// Invalid lead bytes, truncated sequences and out-of-range values read as U+FFFD.
+static uint32_t DecodeUtf8Sequence(uint32_t lead, const unsigned char*& p, const unsigned char* end)
 {
-public:
-	InsertTextCommand(int pos, const wxString& text)
-		: m_position(pos), m_text(text)
+	int extra;
+	uint32_t min;
+	if ((lead & 0xE0) == 0xC0) { extra = 1; lead &= 0x1F; min = 0x80; }
+	else if ((lead & 0xF0) == 0xE0) { extra = 2; lead &= 0x0F; min = 0x800; }
+	else if ((lead & 0xF8) == 0xF0) { extra = 3; lead &= 0x07; min = 0x10000; }
+	else return 0xFFFD;
+
+	if (end - p < extra)
+		return 0xFFFD;
+	for (int i = 0; i < extra; ++i)
 	{
+		if ((p[i] & 0xC0) != 0x80)
+			return 0xFFFD;
+		lead = (lead << 6) | (p[i] & 0x3F);
 	}
+	p += extra;
 
-	void Execute(bwxTextDocument* doc) override
-	{
-		doc->InsertTextInternal(m_position, m_text);
-	}
+	if (lead < min || lead > 0x10FFFF || (lead >= 0xD800 && lead <= 0xDFFF))
+		return 0xFFFD;
+	return lead;
+}
 
-	void Undo(bwxTextDocument* doc) override
+/// Decode code points of [p, stop) - "\r\n" reads as "\n"
+/// Sequences starting before stop are read whole (end is the end of the data).
+/// @return Position after the last sequence read (the next block starts there)
+template <typename Visitor>
+static const unsigned char* DecodeUtf8(const unsigned char* p, const unsigned char* stop, const unsigned char* end, Visitor&& visitor)
+{
+	while (p < stop)
 	{
-		doc->DeleteTextInternal(m_position, m_position + m_text.Length());
+		uint32_t ch = *p++;
+		if (ch < 0x80)
+		{
+			if (ch == '\r' && p < end && *p == '\n')
+				continue;
+		}
+		else
+		{
+			ch = DecodeUtf8Sequence(ch, p, end);
+		}
+		visitor(ch);
 	}
+	return p;
+}
 
-	bool CanMerge(const ITextCommand* other) const override
+/// Number of wxChars of code point (surrogate pair where wxChar is UTF-16, as in wxString)
+static int CharUnits(uint32_t ch)
+{
+	return (sizeof(wxChar) == 2 && ch > 0xFFFF) ? 2 : 1;
+}
+
+/// Read-only UTF-8 text file, memory-mapped and decoded in blocks on demand
+///
+/// Open() reads the bytes once, without decoding into memory: it cuts the file
+/// into blocks of MAPPED_BLOCK_BYTES and records where each starts (byte and
+/// character offset) and how many newlines come before it - a few bytes per
+/// block. Characters are decoded per block when read and kept in a small LRU
+/// cache, so memory does not grow with file size. A UTF-8 BOM is skipped.
+///
+/// The file must not be changed while mapped (the mapping reads it in place).
+class MappedTextBuffer
+{
+public:
+	~MappedTextBuffer() { Close(); }
+
+	/// Map and index file
+	/// @return False if the file cannot be mapped or has more than INT_MAX characters
+	bool Open(const wxString& path)
 	{
-		const InsertTextCommand* insertCmd = dynamic_cast<const InsertTextCommand*>(other);
-		if (!insertCmd)
+		Close();
+#if defined(_WIN32)
+		m_file = CreateFileW(path.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
 			return false;
 
-		// Only merge single-character insertions (typical typing)
-		// Don't merge multi-character inserts (programmatic operations)
-		if (m_text.Length() != 1 || insertCmd->m_text.Length() != 1)
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_file, &size))
+		{
+			Close();
+			return false;
+		}
+		m_size = static_cast<size_t>(size.QuadPart);
+		if (m_size > 0)
+		{
+			m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping)
+				m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		}
+#else
+		m_fd = open(path.fn_str(), O_RDONLY);
+		if (m_fd < 0)
 			return false;
 
-		// Can merge if inserting at adjacent position
-		return insertCmd->m_position == m_position + (int)m_text.Length();
+		struct stat info;
+		if (fstat(m_fd, &info) != 0)
+		{
+			Close();
+			return false;
+		}
+		m_size = static_cast<size_t>(info.st_size);
+		if (m_size > 0)
+		{
+			void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+			if (data != MAP_FAILED)
+				m_data = static_cast<const unsigned char*>(data);
+		}
+#endif
+		if (m_size > 0 && !m_data)
+		{
+			Close();
+			return false;
+		}
+
+		if (!Index())
+		{
+			Close();
+			return false;
+		}
+		return true;
 	}
 
-	void Merge(ITextCommand* other) override
+	/// Unmap file
+	void Close()
 	{
-		InsertTextCommand* insertCmd = dynamic_cast<InsertTextCommand*>(other);
-		if (insertCmd)
-			m_text += insertCmd->m_text;
+#if defined(_WIN32)
+		if (m_data)
+			UnmapViewOfFile(m_data);
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+#else
+		if (m_data)
+			munmap(const_cast<unsigned char*>(m_data), m_size);
+		if (m_fd >= 0)
+			close(m_fd);
+		m_fd = -1;
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_blocks.clear();
+		m_cache.clear();
+		m_length = 0;
+		m_newlines = 0;
+		m_words = 0;
 	}
 
-	wxString GetTypeName() const override { return "InsertText"; }
+	/// Get number of characters
+	int GetLength() const { return m_length; }
 
-private:
-	int m_position;
-	wxString m_text;
-};
+	/// Get number of words (counted while indexing, same rule as bwxTextDocument)
+	int GetWordCount() const { return m_words; }
 
-/// Delete text command
-class DeleteTextCommand : public ITextCommand
-{
-public:
-	DeleteTextCommand(int startPos, int endPos)
-		: m_startPos(startPos), m_endPos(endPos), m_deletedText()
+	/// Get character at position
+	wxChar GetChar(int pos) const
 	{
+		int block = FindBlock(pos);
+		return (*Decode(block))[pos - m_blocks[block].charStart];
 	}
 
-	void Execute(bwxTextDocument* doc) override
+	/// Visit characters [startPos, endPos) block by block
+	void Visit(int startPos, int endPos, const TextChunkVisitor& visitor) const
 	{
-		// Store deleted text for undo
-		m_deletedText = doc->GetText(m_startPos, m_endPos);
-		doc->DeleteTextInternal(m_startPos, m_endPos);
+		while (startPos < endPos)
+		{
+			int block = FindBlock(startPos);
+			int blockEnd = BlockEnd(block);
+
+			// Held here - the visitor may read other blocks and push this one out of the cache
+			Chars chars = Decode(block);
+			int length = std::min(endPos, blockEnd) - startPos;
+			visitor(chars->data() + (startPos - m_blocks[block].charStart), length);
+			startPos += length;
+		}
 	}
 
-	void Undo(bwxTextDocument* doc) override
+	/// Count newlines in [startPos, endPos)
+	int CountNewlines(int startPos, int endPos) const
 	{
-		doc->InsertTextInternal(m_startPos, m_deletedText);
+		return NewlinesBefore(endPos) - NewlinesBefore(startPos);
 	}
 
-	wxString GetTypeName() const override { return "DeleteText"; }
+	/// Get position of index-th newline (1-based) at or after pos
+	int FindNewline(int pos, int index) const
+	{
+		// Global number of the newline, then the block holding it
+		int target = NewlinesBefore(pos) + index - 1;
+		auto next = std::upper_bound(m_blocks.begin(), m_blocks.end(), target,
+			[](int newline, const Block& block) { return newline < block.newlinesBefore; });
+		int block = static_cast<int>(next - m_blocks.begin()) - 1;
+
+		Chars chars = Decode(block);
+		int remaining = target - m_blocks[block].newlinesBefore;
+		for (size_t i = 0; i < chars->size(); ++i)
+		{
+			if ((*chars)[i] == '\n' && remaining-- == 0)
+				return m_blocks[block].charStart + static_cast<int>(i);
+		}
+		return m_length;
+	}
 
 private:
-	int m_startPos;
-	int m_endPos;
-	wxString m_deletedText;
-};
+	/// Index entry of block
+	struct Block
+	{
+		size_t byteStart;    ///< Offset in file
+		int charStart;       ///< Position of first character
+		int newlinesBefore;  ///< Newlines in blocks before
+	};
 
-/// Apply format command
-class ApplyFormatCommand : public ITextCommand
-{
-public:
-	ApplyFormatCommand(int startPos, int endPos, const TextFormat& format)
-		: m_startPos(startPos), m_endPos(endPos), m_newFormat(format)
+	/// Decoded block (shared, so readers keep it alive past eviction)
+	using Chars = std::shared_ptr<const std::wstring>;
+
+	/// Cut file into blocks, count characters, newlines and words
+	bool Index()
 	{
+		const unsigned char* end = m_data + m_size;
+		const unsigned char* p = m_data;
+		if (m_size >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF)
+			p += 3;
+
+#if !defined(_WIN32)
+		if (m_data)
+			madvise(const_cast<unsigned char*>(m_data), m_size, MADV_SEQUENTIAL);
+#endif
+
+		long long length = 0;
+		long long newlines = 0;
+		long long words = 0;
+		bool inWord = false;
+		while (p < end)
+		{
+			m_blocks.push_back(Block{ static_cast<size_t>(p - m_data), static_cast<int>(length), static_cast<int>(newlines) });
+
+			const unsigned char* stop = p + std::min(MAPPED_BLOCK_BYTES, static_cast<size_t>(end - p));
+			p = DecodeUtf8(p, stop, end, [&](uint32_t ch) {
+				length += CharUnits(ch);
+				bool separator = ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+				if (ch == '\n')
+					newlines++;
+				if (!separator && !inWord)
+					words++;
+				inWord = !separator;
+			});
+
+			if (length > INT_MAX)
+				return false;
+		}
+
+#if !defined(_WIN32)
+		if (m_data)
+			madvise(const_cast<unsigned char*>(m_data), m_size, MADV_NORMAL);
+#endif
+
+		m_length = static_cast<int>(length);
+		m_newlines = static_cast<int>(newlines);
+		m_words = static_cast<int>(std::min<long long>(words, INT_MAX));
+		return true;
 	}
 
-	void Execute(bwxTextDocument* doc) override
+	/// Get block containing position (0 <= pos < length)
+	int FindBlock(int pos) const
 	{
-		// Store old format runs for undo
-		m_oldRuns = doc->GetFormatRuns(m_startPos, m_endPos);
-		doc->ApplyFormatInternal(m_startPos, m_endPos, m_newFormat);
+		auto next = std::upper_bound(m_blocks.begin(), m_blocks.end(), pos,
+			[](int position, const Block& block) { return position < block.charStart; });
+		return static_cast<int>(next - m_blocks.begin()) - 1;
 	}
 
-	void Undo(bwxTextDocument* doc) override
+	/// Get position after last character of block
+	int BlockEnd(int block) const
 	{
-		doc->RestoreFormatRuns(m_startPos, m_endPos, m_oldRuns);
+		return block + 1 < static_cast<int>(m_blocks.size()) ? m_blocks[block + 1].charStart : m_length;
 	}
 
-	wxString GetTypeName() const override { return "ApplyFormat"; }
+	/// Count newlines before position
+	int NewlinesBefore(int pos) const
+	{
+		if (pos >= m_length)
+			return m_newlines;
+		if (pos <= 0)
+			return 0;
 
-private:
-	int m_startPos;
-	int m_endPos;
-	TextFormat m_newFormat;
-	std::vector<FormatRun> m_oldRuns;
-};
+		int block = FindBlock(pos);
+		int offset = pos - m_blocks[block].charStart;
+		if (offset == 0)
+			return m_blocks[block].newlinesBefore;
 
-// ============================================================================
-// bwxTextDocument Implementation
-// ============================================================================
+		Chars chars = Decode(block);
+		return m_blocks[block].newlinesBefore + static_cast<int>(std::count(chars->begin(), chars->begin() + offset, L'\n'));
+	}
 
-bwxTextDocument::bwxTextDocument()
-	: m_storage(std::make_unique<GapBufferStorage>())
-	, m_formatRuns()
-	, m_cursor()
-	, m_selection()
-	, m_metadata()
-	, m_undoStack()
-	, m_redoStack()
-	, m_maxUndoStack(100)
-	, m_observers()
-{
-	// Initialize with default format run covering empty document
-	m_formatRuns.push_back(FormatRun(0, 0, TextFormat()));
-}
+	/// Get decoded block (from cache, or decoded now)
+	Chars Decode(int block) const
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
 
-bwxTextDocument::~bwxTextDocument()
-{
-	// Clear undo/redo stacks (unique_ptr handles deletion)
-	m_undoStack.clear();
-	m_redoStack.clear();
-}
+		for (size_t i = 0; i < m_cache.size(); ++i)
+		{
+			if (m_cache[i].first == block)
+			{
+				// Move to front - most recently used
+				std::rotate(m_cache.begin(), m_cache.begin() + i, m_cache.begin() + i + 1);
+				return m_cache.front().second;
+			}
+		}
+
+		auto chars = std::make_shared<std::wstring>();
+		chars->reserve(BlockEnd(block) - m_blocks[block].charStart);
+
+		const unsigned char* start = m_data + m_blocks[block].byteStart;
+		const unsigned char* stop = block + 1 < static_cast<int>(m_blocks.size()) ? m_data + m_blocks[block + 1].byteStart : m_data + m_size;
+		DecodeUtf8(start, stop, m_data + m_size, [&chars](uint32_t ch) {
+			if (CharUnits(ch) == 2)
+			{
+				ch -= 0x10000;
+				chars->push_back(static_cast<wchar_t>(0xD800 + (ch >> 10)));
+				chars->push_back(static_cast<wchar_t>(0xDC00 + (ch & 0x3FF)));
+			}
+			else
+			{
+				chars->push_back(static_cast<wchar_t>(ch));
+			}
+		});
+
+		if (m_cache.size() >= MAPPED_CACHED_BLOCKS)
+			m_cache.pop_back();
+		m_cache.emplace(m_cache.begin(), block, chars);
+		return chars;
+	}
+
+#if defined(_WIN32)
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#else
+	int m_fd = -1;
+#endif
+	const unsigned char* m_data = nullptr;  ///< Mapped file (nullptr if empty)
+	size_t m_size = 0;                      ///< File size in bytes
+	std::vector<Block> m_blocks;            ///< Block index (ascending)
+	int m_length = 0;                       ///< Characters in file
+	int m_newlines = 0;                     ///< Newlines in file
+	int m_words = 0;                        ///< Words in file
+
+	mutable std::mutex m_cacheMutex;        ///< Reads may come from several threads
+	mutable std::vector<std::pair<int, Chars>> m_cache; ///< Decoded blocks, most recently used first
+};
 
 // ============================================================================
-// Text Operations
+// Piece Table Storage Implementation
 // ============================================================================
 
-wxString bwxTextDocument::GetText() const
+/// Piece Table text storage - efficient for editing anywhere in large documents
+///
+/// Text is never moved: the loaded text stays in the original buffer and every
+/// insertion is appended to the added buffer. The document is a sequence of
+/// pieces (buffer, start, length) kept in a treap - a binary tree balanced by
+/// random priorities - where every node knows the length and newline count of
+/// its subtree, so positions and lines are found by descending from the root.
+///
+/// Example: "Hello World", then "big " inserted at 6
+/// Original: [Hello World]  Added: [big ]
+/// Pieces:   (original 0..6) (added 0..4) (original 6..11)
+///
+/// Operations:
+/// - Insert: O(log n) - split tree at position, append piece, merge
+/// - Delete: O(log n) - split out the range and drop it
+/// - Get char: O(log n) - descend by subtree lengths
+/// - Get range: O(log n + k) - copy whole pieces, not characters
+///
+/// MapFile() makes a mapped UTF-8 file the original buffer instead of a copy
+/// of the text (MappedTextBuffer), so opening costs one pass over the bytes and
+/// memory grows with the edits only.
+class PieceTableStorage : public ITextStorage
 {
-	return m_storage->GetText();
-}
+public:
+	/// Constructor
+	PieceTableStorage()
+		: m_root()
+		, m_seed(0x9E3779B9u)
+	{
+	}
 
-wxString bwxTextDocument::GetText(int startPos, int endPos) const
-{
-	return m_storage->GetText(startPos, endPos);
-}
+	// ========================================================================
+	// ITextStorage Interface Implementation
+	// ========================================================================
 
-void bwxTextDocument::SetText(const wxString& text)
-{
-	m_storage->SetText(text);
+	wxString GetText() const override
+	{
+		return GetText(0, GetLength());
+	}
 
-	// Reset format runs
-	m_formatRuns.clear();
-	m_formatRuns.push_back(FormatRun(0, text.Length(), TextFormat()));
+	wxString GetText(int startPos, int endPos) const override
+	{
+		if (startPos < 0 || endPos > GetLength() || startPos >= endPos)
+			return wxEmptyString;
 
-	// Reset cursor and selection
-	m_cursor = Cursor();
-	m_selection = Selection();
+		wxString result;
+		result.Alloc(endPos - startPos);
+		AppendRange(m_root.get(), startPos, endPos, result);
+		return result;
+	}
 
-	// Clear undo history (new document)
-	ClearUndoHistory();
+	void SetText(const wxString& text) override
+	{
+		Clear();
 
-	// Update metadata
-	UpdateWordCount();
-	m_metadata.modified = wxDateTime::Now();
+		m_original = text.ToStdWstring();
+		IndexNewlines(m_original, 0, m_originalNewlines);
 
-	NotifyTextChanged();
-}
+		if (!m_original.empty())
+			m_root = MakeNode(Piece{ false, 0, static_cast<int>(m_original.size()) });
+	}
 
-void bwxTextDocument::InsertText(int pos, const wxString& text)
-{
-	if (text.IsEmpty())
-		return;
+	void InsertText(int pos, const wxString& text) override
+	{
+		if (pos < 0 || pos > GetLength() || text.IsEmpty())
+			return;
 
-	// Create and execute command
-	auto cmd = std::make_unique<InsertTextCommand>(pos, text);
-	cmd->Execute(this);
+		// Append to added buffer
+		int bufferEnd = static_cast<int>(m_added.size());
+		m_added += text.ToStdWstring();
+		IndexNewlines(m_added, bufferEnd, m_addedNewlines);
+		int textLength = static_cast<int>(m_added.size()) - bufferEnd;
 
-	AddCommand(std::move(cmd));
-}
+		std::unique_ptr<Node> left, right;
+		Split(std::move(m_root), pos, left, right);
 
-void bwxTextDocument::DeleteText(int startPos, int endPos)
-{
-	if (startPos >= endPos)
-		return;
+		// Typing continues the piece added by the previous keystroke - no new piece needed
+		if (!ExtendLast(left.get(), bufferEnd, textLength))
+			left = Merge(std::move(left), MakeNode(Piece{ true, bufferEnd, textLength }));
 
-	// Create and execute command
-	auto cmd = std::make_unique<DeleteTextCommand>(startPos, endPos);
-	cmd->Execute(this);
+		m_root = Merge(std::move(left), std::move(right));
+	}
 
-	AddCommand(std::move(cmd));
-}
+	void DeleteText(int startPos, int endPos) override
+	{
+		if (startPos < 0 || endPos > GetLength() || startPos >= endPos)
+			return;
 
-wxChar bwxTextDocument::GetChar(int pos) const
-{
-	return m_storage->GetChar(pos);
-}
+		// Cut out the range; deleted text stays in the buffers (undo keeps its own copy)
+		std::unique_ptr<Node> left, middle, right;
+		Split(std::move(m_root), startPos, left, middle);
+		Split(std::move(middle), endPos - startPos, middle, right);
+		m_root = Merge(std::move(left), std::move(right));
+	}
 
-int bwxTextDocument::GetLength() const
-{
-	return m_storage->GetLength();
-}
+	wxChar GetChar(int pos) const override
+	{
+		if (pos < 0 || pos >= GetLength())
+			return 0;
 
-void bwxTextDocument::Clear()
-{
-	SetText(wxEmptyString);
-}
+		const Node* node = m_root.get();
+		while (node)
+		{
+			int leftLength = Length(node->left.get());
+			if (pos < leftLength)
+			{
+				node = node->left.get();
+				continue;
+			}
+
+			pos -= leftLength;
+			if (pos < node->piece.length)
+				return BufferChar(node->piece, node->piece.start + pos);
+
+			pos -= node->piece.length;
+			node = node->right.get();
+		}
 
-// ============================================================================
-// Internal Text Operations (called by commands, no undo)
-// ============================================================================
+		return 0;
+	}
 
-void bwxTextDocument::InsertTextInternal(int pos, const wxString& text)
-{
-	if (text.IsEmpty())
-		return;
+	int GetLength() const override
+	{
+		return Length(m_root.get());
+	}
 
-	int textLength = text.Length();
+	void Clear() override
+	{
+		m_root.reset();
+		m_mapped.reset();
+		m_original.clear();
+		m_added.clear();
+		m_originalNewlines.clear();
+		m_addedNewlines.clear();
+	}
 
-	// Insert into storage
-	m_storage->InsertText(pos, text);
+	void ForEachChunk(int startPos, int endPos, const TextChunkVisitor& visitor) const override
+	{
+		VisitRange(m_root.get(), std::max(startPos, 0), std::min(endPos, GetLength()), visitor);
+	}
 
-	// Adjust format runs
-	for (auto& run : m_formatRuns)
+	int GetLineCount() const override
 	{
-		if (pos < run.startPos)
-		{
-			// Insertion is before this run - shift entire run
-			run.startPos += textLength;
-			run.endPos += textLength;
-		}
-		else if (pos >= run.startPos && pos < run.endPos)
+		return Newlines(m_root.get()) + 1;
+	}
+
+	int GetLineStart(int line) const override
+	{
+		if (line <= 0)
+			return 0;
+
+		// Find the line-th newline
+		int newline = std::min(line, GetLineCount() - 1);
+		int pos = 0;
+		const Node* node = m_root.get();
+		while (node)
 		{
-			// Insertion is inside this run - expand run
-			run.endPos += textLength;
+			int leftNewlines = Newlines(node->left.get());
+			if (newline <= leftNewlines)
+			{
+				node = node->left.get();
+				continue;
+			}
+
+			newline -= leftNewlines;
+			pos += Length(node->left.get());
+			if (newline <= node->pieceNewlines)
+				return pos + FindNewline(node->piece, newline) - node->piece.start + 1;
+
+			newline -= node->pieceNewlines;
+			pos += node->piece.length;
+			node = node->right.get();
 		}
-		else if (pos == run.endPos && run.startPos == run.endPos)
+
+		return GetLength();
+	}
+
+	int GetLineFromPosition(int pos) const override
+	{
+		pos = std::max(0, std::min(pos, GetLength()));
+
+		int line = 0;
+		const Node* node = m_root.get();
+		while (node)
 		{
-			// Special case: empty run at insertion point - expand it
-			run.endPos += textLength;
+			int leftLength = Length(node->left.get());
+			if (pos < leftLength)
+			{
+				node = node->left.get();
+				continue;
+			}
+
+			pos -= leftLength;
+			line += Newlines(node->left.get());
+			if (pos < node->piece.length)
+				return line + CountNewlines(Piece{ node->piece.added, node->piece.start, pos });
+
+			pos -= node->piece.length;
+			line += node->pieceNewlines;
+			node = node->right.get();
 		}
-		// If pos >= run.endPos (and run is not empty), don't modify the run
+
+		return line;
 	}
 
-	// Adjust cursor
-	if (m_cursor.position >= pos)
-		m_cursor.position += textLength;
+	// ========================================================================
+	// Mapped Files
+	// ========================================================================
 
-	// Adjust selection
-	if (m_selection.active)
+	/// Use UTF-8 file as original buffer (replaces all content)
+	/// @return False if the file cannot be mapped - content is left unchanged
+	bool MapFile(const wxString& path)
 	{
-		if (m_selection.startPos >= pos)
-			m_selection.startPos += textLength;
-		if (m_selection.endPos >= pos)
-			m_selection.endPos += textLength;
+		auto mapped = std::make_unique<MappedTextBuffer>();
+		if (!mapped->Open(path))
+			return false;
+
+		Clear();
+		m_mapped = std::move(mapped);
+		if (m_mapped->GetLength() > 0)
+			m_root = MakeNode(Piece{ false, 0, m_mapped->GetLength() });
+		return true;
 	}
 
-	// Update metadata
-	UpdateWordCount();
-	m_metadata.modified = wxDateTime::Now();
+	/// Get word count of mapped file (0 if none)
+	int GetMappedWordCount() const
+	{
+		return m_mapped ? m_mapped->GetWordCount() : 0;
+	}
 
-	NotifyTextChanged();
-}
+private:
+	// ========================================================================
+	// Tree Structures
+	// ========================================================================
 
-void bwxTextDocument::DeleteTextInternal(int startPos, int endPos)
-{
-	if (startPos >= endPos)
-		return;
+	/// Piece - span of one of the buffers
+	struct Piece
+	{
+		bool added;   ///< Added buffer (true) or original buffer (false)
+		int start;    ///< Start offset in buffer
+		int length;   ///< Number of characters
+	};
 
-	int deleteLength = endPos - startPos;
+	/// Tree node - one piece plus subtree totals
+	struct Node
+	{
+		Piece piece;
+		int pieceNewlines;              ///< Newlines inside this piece
+		uint32_t priority;              ///< Heap priority (random)
+		int length;                     ///< Characters in subtree
+		int newlines;                   ///< Newlines in subtree
+		std::unique_ptr<Node> left;
+		std::unique_ptr<Node> right;
+	};
 
-	// Delete from storage
-	m_storage->DeleteText(startPos, endPos);
+	// ========================================================================
+	// Private Helper Methods
+	// ========================================================================
 
-	// Adjust format runs
-	auto it = m_formatRuns.begin();
-	while (it != m_formatRuns.end())
+	static int Length(const Node* node) { return node ? node->length : 0; }
+	static int Newlines(const Node* node) { return node ? node->newlines : 0; }
+
+	const std::wstring& Buffer(const Piece& piece) const
 	{
-		if (it->endPos <= startPos)
-		{
-			// Run entirely before deletion - no change
-			++it;
-		}
-		else if (it->startPos >= endPos)
+		return piece.added ? m_added : m_original;
+	}
+
+	/// Get character at offset of piece's buffer
+	wxChar BufferChar(const Piece& piece, int offset) const
+	{
+		if (!piece.added && m_mapped)
+			return m_mapped->GetChar(offset);
+		return Buffer(piece)[offset];
+	}
+
+	/// Record offsets of newlines in buffer from given offset
+	static void IndexNewlines(const std::wstring& buffer, int from, std::vector<int>& newlines)
+	{
+		for (int i = from; i < static_cast<int>(buffer.size()); ++i)
 		{
-			// Run entirely after deletion - shift left
-			it->startPos -= deleteLength;
-			it->endPos -= deleteLength;
-			++it;
+			if (buffer[i] == '\n')
+				newlines.push_back(i);
 		}
-		else if (it->startPos >= startPos && it->endPos <= endPos)
+	}
+
+	const std::vector<int>& NewlineIndex(const Piece& piece) const
+	{
+		return piece.added ? m_addedNewlines : m_originalNewlines;
+	}
+
+	/// Count newlines in piece (binary search in buffer newline index)
+	int CountNewlines(const Piece& piece) const
+	{
+		if (!piece.added && m_mapped)
+			return m_mapped->CountNewlines(piece.start, piece.start + piece.length);
+
+		const std::vector<int>& newlines = NewlineIndex(piece);
+		auto first = std::lower_bound(newlines.begin(), newlines.end(), piece.start);
+		auto last = std::lower_bound(first, newlines.end(), piece.start + piece.length);
+		return static_cast<int>(last - first);
+	}
+
+	/// Get buffer offset of index-th newline (1-based) of piece
+	int FindNewline(const Piece& piece, int index) const
+	{
+		if (!piece.added && m_mapped)
+			return m_mapped->FindNewline(piece.start, index);
+
+		const std::vector<int>& newlines = NewlineIndex(piece);
+		auto first = std::lower_bound(newlines.begin(), newlines.end(), piece.start);
+		return first[index - 1];
+	}
+
+	std::unique_ptr<Node> MakeNode(const Piece& piece)
+	{
+		// xorshift32 - cheap and good enough to keep the tree balanced
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+
+		auto node = std::make_unique<Node>();
+		node->piece = piece;
+		node->pieceNewlines = CountNewlines(piece);
+		node->priority = m_seed;
+		Update(node.get());
+		return node;
+	}
+
+	/// Recalculate subtree totals from children
+	static void Update(Node* node)
+	{
+		node->length = Length(node->left.get()) + node->piece.length + Length(node->right.get());
+		node->newlines = Newlines(node->left.get()) + node->pieceNewlines + Newlines(node->right.get());
+	}
+
+	/// Split tree into first pos characters (left) and the rest (right)
+	void Split(std::unique_ptr<Node> node, int pos, std::unique_ptr<Node>& left, std::unique_ptr<Node>& right)
+	{
+		if (!node)
 		{
-			// Run entirely within deletion - remove
-			it = m_formatRuns.erase(it);
+			left.reset();
+			right.reset();
+			return;
 		}
-		else if (it->startPos < startPos && it->endPos > endPos)
+
+		int leftLength = Length(node->left.get());
+		if (pos <= leftLength)
 		{
-			// Run spans deletion - shrink
-			it->endPos -= deleteLength;
-			++it;
+			Split(std::move(node->left), pos, left, node->left);
+			Update(node.get());
+			right = std::move(node);
 		}
-		else if (it->startPos < startPos)
+		else if (pos >= leftLength + node->piece.length)
 		{
-			// Run starts before, ends within deletion - truncate
-			it->endPos = startPos;
-			++it;
+			Split(std::move(node->right), pos - leftLength - node->piece.length, node->right, right);
+			Update(node.get());
+			left = std::move(node);
 		}
 		else
 		{
-			// Run starts within deletion, ends after - shift and truncate
-			it->startPos = startPos;
-			it->endPos -= deleteLength;
-			++it;
+			// Position falls inside this piece - cut it in two
+			int offset = pos - leftLength;
+			Piece tail{ node->piece.added, node->piece.start + offset, node->piece.length - offset };
+			node->piece.length = offset;
+			node->pieceNewlines = CountNewlines(node->piece);
+
+			right = Merge(MakeNode(tail), std::move(node->right));
+			Update(node.get());
+			left = std::move(node);
 		}
 	}
 
-	// Ensure at least one format run exists
-	if (m_formatRuns.empty())
-		m_formatRuns.push_back(FormatRun(0, 0, TextFormat()));
+	/// Merge two trees (all of left comes before all of right)
+	std::unique_ptr<Node> Merge(std::unique_ptr<Node> left, std::unique_ptr<Node> right)
+	{
+		if (!left)
+			return right;
+		if (!right)
+			return left;
 
-	// Adjust cursor
-	if (m_cursor.position >= endPos)
-		m_cursor.position -= deleteLength;
-	else if (m_cursor.position > startPos)
-		m_cursor.position = startPos;
+		if (left->priority > right->priority)
+		{
+			left->right = Merge(std::move(left->right), std::move(right));
+			Update(left.get());
+			return left;
+		}
 
-	// Adjust selection
-	if (m_selection.active)
+		right->left = Merge(std::move(left), std::move(right->left));
+		Update(right.get());
+		return right;
+	}
+
+	/// Grow last piece of tree if it ends where the added buffer ended
+	bool ExtendLast(Node* node, int bufferEnd, int length)
 	{
-		if (m_selection.startPos >= endPos)
-			m_selection.startPos -= deleteLength;
-		else if (m_selection.startPos > startPos)
-			m_selection.startPos = startPos;
+		if (!node)
+			return false;
 
-		if (m_selection.endPos >= endPos)
-			m_selection.endPos -= deleteLength;
-		else if (m_selection.endPos > startPos)
-			m_selection.endPos = startPos;
+		bool extended = false;
+		if (node->right)
+		{
+			extended = ExtendLast(node->right.get(), bufferEnd, length);
+		}
+		else if (node->piece.added && node->piece.start + node->piece.length == bufferEnd)
+		{
+			node->piece.length += length;
+			node->pieceNewlines = CountNewlines(node->piece);
+			extended = true;
+		}
 
-		if (m_selection.startPos == m_selection.endPos)
-			m_selection.active = false;
-	}
+		if (extended)
+			Update(node);
 
-	// Update metadata
-	UpdateWordCount();
-	m_metadata.modified = wxDateTime::Now();
+		return extended;
+	}
 
-	NotifyTextChanged();
-}
+	/// Append text in range [startPos, endPos) of subtree to result
+	void AppendRange(const Node* node, int startPos, int endPos, wxString& result) const
+	{
+		VisitRange(node, startPos, endPos, [&result](const wxChar* chars, int length) {
+			result.append(chars, length);
+		});
+	}
 
-// ============================================================================
-// Formatting Operations
-// ============================================================================
+	/// Visit pieces overlapping range [startPos, endPos) of subtree, in order
+	void VisitRange(const Node* node, int startPos, int endPos, const TextChunkVisitor& visitor) const
+	{
+		if (!node || startPos >= endPos)
+			return;
 
-void bwxTextDocument::ApplyFormat(int startPos, int endPos, const TextFormat& format)
-{
-	if (startPos >= endPos)
-		return;
+		int leftLength = Length(node->left.get());
+		if (startPos < leftLength)
+			VisitRange(node->left.get(), startPos, std::min(endPos, leftLength), visitor);
 
-	// Create and execute command
-	auto cmd = std::make_unique<ApplyFormatCommand>(startPos, endPos, format);
-	cmd->Execute(this);
+		int pieceStart = std::max(startPos - leftLength, 0);
+		int pieceEnd = std::min(endPos - leftLength, node->piece.length);
+		if (pieceStart < pieceEnd)
+		{
+			if (!node->piece.added && m_mapped)
+				m_mapped->Visit(node->piece.start + pieceStart, node->piece.start + pieceEnd, visitor);
+			else
+				visitor(Buffer(node->piece).data() + node->piece.start + pieceStart, pieceEnd - pieceStart);
+		}
 
-	AddCommand(std::move(cmd));
-}
+		int rightStart = leftLength + node->piece.length;
+		if (endPos > rightStart)
+			VisitRange(node->right.get(), std::max(startPos - rightStart, 0), endPos - rightStart, visitor);
+	}
 
-void bwxTextDocument::ApplyFormatInternal(int startPos, int endPos, const TextFormat& format)
-{
-	if (startPos >= endPos)
-		return;
+	// ========================================================================
+	// Member Variables
+	// ========================================================================
 
-	// Split runs at boundaries
-	SplitRunAt(startPos);
-	SplitRunAt(endPos);
+	std::unique_ptr<Node> m_root;         ///< Piece tree
+	std::unique_ptr<MappedTextBuffer> m_mapped; ///< File mapped by MapFile() - original buffer instead of m_original
+	std::wstring m_original;              ///< Text given to SetText() (read-only)
+	std::wstring m_added;                 ///< Inserted text (append-only)
+	std::vector<int> m_originalNewlines;  ///< Newline offsets in original buffer
+	std::vector<int> m_addedNewlines;     ///< Newline offsets in added buffer
+	uint32_t m_seed;                      ///< Priority generator state
+};
 
-	// Apply format to runs in range
-	for (auto& run : m_formatRuns)
+std::unique_ptr<ITextStorage> CreateTextStorage(TextStorageType type)
+{
+	switch (type)
 	{
-		if (run.startPos >= startPos && run.endPos <= endPos)
-			run.format = format;
+	case TextStorageType::PieceTable:
+		return std::make_unique<PieceTableStorage>();
+	case TextStorageType::GapBuffer:
+	default:
+		return std::make_unique<GapBufferStorage>();
 	}
+}
 
-	// Merge adjacent runs with same format
-	MergeAdjacentRuns();
+// ============================================================================
+// Text Style Table Implementation
+// ============================================================================
 
-	NotifyFormatChanged();
+TextStyleTable::TextStyleTable()
+	: m_styles()
+	, m_index()
+{
+	// Style 0 is the default format
+	Intern(TextFormat());
 }
 
-TextFormat bwxTextDocument::GetFormatAt(int pos) const
+int TextStyleTable::Intern(const TextFormat& format)
 {
-	// Binary search for run containing position
-	for (const auto& run : m_formatRuns)
+	size_t hash = Hash(format);
+	auto range = m_index.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
 	{
-		if (run.Contains(pos))
-			return run.format;
+		if (m_styles[it->second] == format)
+			return it->second;
 	}
 
-	// Default format
-	return TextFormat();
+	int styleId = static_cast<int>(m_styles.size());
+	m_styles.push_back(format);
+	m_index.emplace(hash, styleId);
+	return styleId;
 }
 
-std::vector<FormatRun> bwxTextDocument::GetFormatRuns(int startPos, int endPos) const
+const TextFormat& TextStyleTable::Get(int styleId) const
 {
-	std::vector<FormatRun> result;
-
-	for (const auto& run : m_formatRuns)
-	{
-		if (run.endPos <= startPos)
-			continue;
-		if (run.startPos >= endPos)
-			break;
+	if (styleId < 0 || styleId >= GetCount())
+		return m_styles[DefaultStyle];
 
-		// Run intersects range
-		FormatRun intersect = run;
-		intersect.startPos = std::max(intersect.startPos, startPos);
-		intersect.endPos = std::min(intersect.endPos, endPos);
-		result.push_back(intersect);
-	}
+	return m_styles[styleId];
+}
 
-	return result;
+size_t TextStyleTable::Hash(const TextFormat& format)
+{
+	size_t hash = wxStringHash()(format.fontName);
+	auto combine = [&hash](size_t value) {
+		hash ^= value + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+	};
+
+	combine(static_cast<size_t>(format.fontSize));
+	combine(format.textColor.GetRGBA());
+	combine(format.backgroundColor.GetRGBA());
+	combine((format.bold ? 1u : 0u) | (format.italic ? 2u : 0u) | (format.underline ? 4u : 0u));
+	return hash;
 }
 
-void bwxTextDocument::RestoreFormatRuns(int startPos, int endPos, const std::vector<FormatRun>& runs)
+// ============================================================================
+// Format Run Tree Implementation
+// ============================================================================
+
+/// Treap node - one format run
+struct FormatRunTree::Node
 {
-	// Remove runs in range
-	auto it = m_formatRuns.begin();
-	while (it != m_formatRuns.end())
+	int styleId = 0;              ///< Style of this run
+	int runLength = 0;            ///< Length of this run
+	int length = 0;               ///< Total length of subtree
+	int count = 0;                ///< Number of runs in subtree
+	uint32_t priority = 0;        ///< Heap priority (parent >= children)
+	std::unique_ptr<Node> left;   ///< Runs before
+	std::unique_ptr<Node> right;  ///< Runs after
+
+	static int Length(const Node* node) { return node ? node->length : 0; }
+	static int Count(const Node* node) { return node ? node->count : 0; }
+
+	/// Recalculate subtree totals from children
+	static void Update(Node* node)
+	{
+		node->length = Length(node->left.get()) + node->runLength + Length(node->right.get());
+		node->count = Count(node->left.get()) + 1 + Count(node->right.get());
+	}
+
+	/// Grow run containing pos (or the last run, if pos is the end of subtree)
+	static void Grow(Node* node, int pos, int length)
 	{
-		if (it->startPos >= startPos && it->endPos <= endPos)
-			it = m_formatRuns.erase(it);
+		int leftLength = Length(node->left.get());
+		if (pos < leftLength)
+			Grow(node->left.get(), pos, length);
+		else if (pos < leftLength + node->runLength || !node->right)
+			node->runLength += length;
 		else
-			++it;
+			Grow(node->right.get(), pos - leftLength - node->runLength, length);
+
+		Update(node);
 	}
 
-	// Insert restored runs
-	m_formatRuns.insert(m_formatRuns.end(), runs.begin(), runs.end());
+	/// Visit runs of subtree (starting at offset) overlapping range [startPos, endPos), in order
+	static void Visit(const Node* node, int offset, int startPos, int endPos, const Visitor& visitor)
+	{
+		if (!node)
+			return;
+
+		int runStart = offset + Length(node->left.get());
+		int runEnd = runStart + node->runLength;
 
-	// Sort and merge
-	std::sort(m_formatRuns.begin(), m_formatRuns.end(),
-		[](const FormatRun& a, const FormatRun& b) { return a.startPos < b.startPos; });
-	MergeAdjacentRuns();
+		if (startPos < runStart)
+			Visit(node->left.get(), offset, startPos, endPos, visitor);
 
-	NotifyFormatChanged();
-}
+		if (startPos < runEnd && endPos > runStart)
+			visitor(std::max(startPos, runStart), std::min(endPos, runEnd), node->styleId);
 
-void bwxTextDocument::ClearFormatting()
+		if (endPos > runEnd)
+			Visit(node->right.get(), runEnd, startPos, endPos, visitor);
+	}
+};
+
+FormatRunTree::FormatRunTree()
+	: m_root()
+	, m_seed(0x2545F491u)
 {
-	m_formatRuns.clear();
-	m_formatRuns.push_back(FormatRun(0, GetLength(), TextFormat()));
-	NotifyFormatChanged();
 }
 
-void bwxTextDocument::ClearFormatting(int startPos, int endPos)
+FormatRunTree::~FormatRunTree() = default;
+
+void FormatRunTree::Reset(int length)
 {
-	ApplyFormat(startPos, endPos, TextFormat());
+	m_root.reset();
+	if (length > 0)
+		m_root = MakeNode(TextStyleTable::DefaultStyle, length);
 }
 
-void bwxTextDocument::SplitRunAt(int pos)
+void FormatRunTree::InsertText(int pos, int length)
 {
-	for (size_t i = 0; i < m_formatRuns.size(); ++i)
+	if (length <= 0)
+		return;
+
+	// Text typed into an empty document starts with the default style
+	if (!m_root)
 	{
-		FormatRun& run = m_formatRuns[i];
-		if (pos > run.startPos && pos < run.endPos)
-		{
-			// Split run at position
-			FormatRun newRun(pos, run.endPos, run.format);
-			run.endPos = pos;
-			m_formatRuns.insert(m_formatRuns.begin() + i + 1, newRun);
-			return;
-		}
+		m_root = MakeNode(TextStyleTable::DefaultStyle, length);
+		return;
 	}
+
+	Node::Grow(m_root.get(), std::clamp(pos, 0, GetLength()), length);
 }
 
-void bwxTextDocument::MergeAdjacentRuns()
+void FormatRunTree::DeleteText(int startPos, int endPos)
 {
-	if (m_formatRuns.size() <= 1)
+	startPos = std::max(startPos, 0);
+	endPos = std::min(endPos, GetLength());
+	if (startPos >= endPos)
 		return;
 
-	std::vector<FormatRun> merged;
-	merged.push_back(m_formatRuns[0]);
+	std::unique_ptr<Node> before, rest, removed, after;
+	Split(std::move(m_root), startPos, before, rest);
+	Split(std::move(rest), endPos - startPos, removed, after);
+	m_root = Join(std::move(before), std::move(after));
+}
+
+void FormatRunTree::Assign(int startPos, int endPos, int styleId)
+{
+	Assign(startPos, endPos, std::vector<FormatRun>{ FormatRun(startPos, endPos, TextFormat(), styleId) });
+}
+
+void FormatRunTree::Assign(int startPos, int endPos, const std::vector<FormatRun>& runs)
+{
+	startPos = std::max(startPos, 0);
+	endPos = std::min(endPos, GetLength());
+	if (startPos >= endPos)
+		return;
 
-	for (size_t i = 1; i < m_formatRuns.size(); ++i)
+	// Build replacement for the range, clipped to it
+	std::unique_ptr<Node> middle;
+	int pos = startPos;
+	for (const FormatRun& run : runs)
 	{
-		FormatRun& last = merged.back();
-		const FormatRun& current = m_formatRuns[i];
+		int runStart = std::max(run.startPos, pos);
+		int runEnd = std::min(run.endPos, endPos);
+		if (runStart >= runEnd)
+			continue;
+
+		if (runStart > pos)
+			middle = Join(std::move(middle), MakeNode(TextStyleTable::DefaultStyle, runStart - pos));
+		middle = Join(std::move(middle), MakeNode(std::max(run.styleId, 0), runEnd - runStart));
+		pos = runEnd;
+	}
+	if (pos < endPos)
+		middle = Join(std::move(middle), MakeNode(TextStyleTable::DefaultStyle, endPos - pos));
+
+	std::unique_ptr<Node> before, rest, replaced, after;
+	Split(std::move(m_root), startPos, before, rest);
+	Split(std::move(rest), endPos - startPos, replaced, after);
+	m_root = Join(Join(std::move(before), std::move(middle)), std::move(after));
+}
 
-		if (last.endPos == current.startPos && last.format == current.format)
+int FormatRunTree::Find(int pos) const
+{
+	const Node* node = m_root.get();
+	while (node)
+	{
+		int leftLength = Node::Length(node->left.get());
+		if (pos < leftLength)
+		{
+			node = node->left.get();
+		}
+		else if (pos < leftLength + node->runLength)
 		{
-			// Merge with previous run
-			last.endPos = current.endPos;
+			return node->styleId;
 		}
 		else
 		{
-			merged.push_back(current);
+			pos -= leftLength + node->runLength;
+			node = node->right.get();
 		}
 	}
 
-	m_formatRuns = merged;
+	return -1;
 }
 
-// ============================================================================
-// Cursor & Selection
-// ============================================================================
-
-void bwxTextDocument::SetCursor(const Cursor& cursor)
+void FormatRunTree::Visit(int startPos, int endPos, const Visitor& visitor) const
 {
-	m_cursor = cursor;
-	m_cursor.position = std::max(0, std::min(m_cursor.position, GetLength()));
-	UpdateCursorLineColumn();
-	NotifyCursorMoved();
+	if (startPos < endPos)
+		Node::Visit(m_root.get(), 0, startPos, endPos, visitor);
 }
 
-void bwxTextDocument::SetCursorPosition(int pos)
+int FormatRunTree::GetLength() const
 {
-	m_cursor.position = std::max(0, std::min(pos, GetLength()));
-	UpdateCursorLineColumn();
-	NotifyCursorMoved();
+	return Node::Length(m_root.get());
 }
 
-void bwxTextDocument::MoveCursor(int offset)
+int FormatRunTree::GetCount() const
 {
-	SetCursorPosition(m_cursor.position + offset);
+	return Node::Count(m_root.get());
 }
 
-void bwxTextDocument::SetSelection(int startPos, int endPos)
+std::unique_ptr<FormatRunTree::Node> FormatRunTree::MakeNode(int styleId, int length)
 {
-	m_selection.startPos = std::max(0, std::min(startPos, GetLength()));
-	m_selection.endPos = std::max(0, std::min(endPos, GetLength()));
-	m_selection.active = (m_selection.startPos != m_selection.endPos);
-	NotifySelectionChanged();
+	// xorshift32 - cheap and good enough to keep the tree balanced
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+
+	auto node = std::make_unique<Node>();
+	node->styleId = styleId;
+	node->runLength = length;
+	node->priority = m_seed;
+	Node::Update(node.get());
+	return node;
+}
+
+void FormatRunTree::Split(std::unique_ptr<Node> node, int pos, std::unique_ptr<Node>& left, std::unique_ptr<Node>& right)
+{
+	if (!node)
+	{
+		left.reset();
+		right.reset();
+		return;
+	}
+
+	int leftLength = Node::Length(node->left.get());
+	if (pos <= leftLength)
+	{
+		Split(std::move(node->left), pos, left, node->left);
+		Node::Update(node.get());
+		right = std::move(node);
+	}
+	else if (pos >= leftLength + node->runLength)
+	{
+		Split(std::move(node->right), pos - leftLength - node->runLength, node->right, right);
+		Node::Update(node.get());
+		left = std::move(node);
+	}
+	else
+	{
+		// Position falls inside this run - cut it in two
+		int offset = pos - leftLength;
+		std::unique_ptr<Node> tail = MakeNode(node->styleId, node->runLength - offset);
+		node->runLength = offset;
+
+		right = Merge(std::move(tail), std::move(node->right));
+		Node::Update(node.get());
+		left = std::move(node);
+	}
+}
+
+std::unique_ptr<FormatRunTree::Node> FormatRunTree::Merge(std::unique_ptr<Node> left, std::unique_ptr<Node> right)
+{
+	if (!left)
+		return right;
+	if (!right)
+		return left;
+
+	if (left->priority > right->priority)
+	{
+		left->right = Merge(std::move(left->right), std::move(right));
+		Node::Update(left.get());
+		return left;
+	}
+
+	right->left = Merge(std::move(left), std::move(right->left));
+	Node::Update(right.get());
+	return right;
+}
+
+std::unique_ptr<FormatRunTree::Node> FormatRunTree::Join(std::unique_ptr<Node> left, std::unique_ptr<Node> right)
+{
+	if (!left || !right)
+		return Merge(std::move(left), std::move(right));
+
+	const Node* last = left.get();
+	while (last->right)
+		last = last->right.get();
+
+	const Node* first = right.get();
+	while (first->left)
+		first = first->left.get();
+
+	if (last->styleId == first->styleId)
+	{
+		// Drop the first run of right and give its length to the last run of left
+		int length = first->runLength;
+		std::unique_ptr<Node> head, tail;
+		Split(std::move(right), length, head, tail);
+		Node::Grow(left.get(), left->length, length);
+		right = std::move(tail);
+	}
+
+	return Merge(std::move(left), std::move(right));
+}
+
+// ============================================================================
+// Text Command Implementations
+// ============================================================================
+
+/// Approximate heap memory of string contents
+static size_t StringMemory(const wxString& text)
+{
+	return text.Length() * sizeof(wxChar);
+}
+
+/// Insert text command
+class InsertTextCommand : public ITextCommand
+{
+public:
+	InsertTextCommand(int pos, const wxString& text)
+		: m_position(pos), m_text(text), m_typing(text.Length() == 1)
+	{
+	}
+
+	void Execute(bwxTextDocument* doc) override
+	{
+		doc->InsertTextInternal(m_position, m_text);
+	}
+
+	void Undo(bwxTextDocument* doc) override
+	{
+		doc->DeleteTextInternal(m_position, m_position + m_text.Length());
+	}
+
+	bool CanMerge(const ITextCommand* other) const override
+	{
+		const InsertTextCommand* insertCmd = dynamic_cast<const InsertTextCommand*>(other);
+		if (!insertCmd)
+			return false;
+
+		// Only merge single-character insertions (typical typing)
+		// Don't merge multi-character inserts (programmatic operations)
+		if (!m_typing || !insertCmd->m_typing)
+			return false;
+
+		// Can merge if inserting at adjacent position
+		return insertCmd->m_position == m_position + (int)m_text.Length();
+	}
+
+	void Merge(ITextCommand* other) override
+	{
+		InsertTextCommand* insertCmd = dynamic_cast<InsertTextCommand*>(other);
+		if (insertCmd)
+			m_text += insertCmd->m_text;
+	}
+
+	size_t GetMemorySize() const override { return sizeof(*this) + StringMemory(m_text); }
+
+	wxString GetTypeName() const override { return "InsertText"; }
+
+private:
+	int m_position;
+	wxString m_text;
+	bool m_typing;  ///< Started as single-character insert (mergeable)
+};
+
+/// Delete text command
+class DeleteTextCommand : public ITextCommand
+{
+public:
+	DeleteTextCommand(int startPos, int endPos, bool keystroke)
+		: m_startPos(startPos), m_endPos(endPos), m_deletedText(),
+		  m_keystroke(keystroke && endPos - startPos == 1)
+	{
+	}
+
+	void Execute(bwxTextDocument* doc) override
+	{
+		// Store deleted text for undo
+		m_deletedText = doc->GetText(m_startPos, m_endPos);
+		doc->DeleteTextInternal(m_startPos, m_endPos);
+	}
+
+	void Undo(bwxTextDocument* doc) override
+	{
+		doc->InsertTextInternal(m_startPos, m_deletedText);
+	}
+
+	bool CanMerge(const ITextCommand* other) const override
+	{
+		const DeleteTextCommand* deleteCmd = dynamic_cast<const DeleteTextCommand*>(other);
+		if (!deleteCmd)
+			return false;
+
+		// Only merge single-character deletions (Backspace/Delete held down)
+		// Don't merge selection or programmatic deletes
+		if (!m_keystroke || !deleteCmd->m_keystroke)
+			return false;
+
+		// Backspace deletes just before, Delete deletes at the same position
+		return deleteCmd->m_endPos == m_startPos || deleteCmd->m_startPos == m_startPos;
+	}
+
+	void Merge(ITextCommand* other) override
+	{
+		DeleteTextCommand* deleteCmd = dynamic_cast<DeleteTextCommand*>(other);
+		if (!deleteCmd)
+			return;
+
+		if (deleteCmd->m_endPos == m_startPos)
+		{
+			m_deletedText = deleteCmd->m_deletedText + m_deletedText;
+			m_startPos = deleteCmd->m_startPos;
+		}
+		else
+		{
+			m_deletedText += deleteCmd->m_deletedText;
+		}
+		m_endPos = m_startPos + m_deletedText.Length();
+	}
+
+	size_t GetMemorySize() const override { return sizeof(*this) + StringMemory(m_deletedText); }
+
+	wxString GetTypeName() const override { return "DeleteText"; }
+
+private:
+	int m_startPos;
+	int m_endPos;
+	wxString m_deletedText;
+	bool m_keystroke;  ///< Started as single-character Backspace/Delete (mergeable)
+};
+
+/// Apply format command
+class ApplyFormatCommand : public ITextCommand
+{
+public:
+	ApplyFormatCommand(int startPos, int endPos, const TextFormat& format)
+		: m_startPos(startPos), m_endPos(endPos), m_newFormat(format)
+	{
+	}
+
+	void Execute(bwxTextDocument* doc) override
+	{
+		// Store old styles for undo (IDs only - formats stay in the style table)
+		m_oldSpans = doc->GetStyleSpans(m_startPos, m_endPos);
+		doc->ApplyFormatInternal(m_startPos, m_endPos, m_newFormat);
+	}
+
+	void Undo(bwxTextDocument* doc) override
+	{
+		doc->RestoreStyleSpans(m_startPos, m_oldSpans);
+	}
+
+	size_t GetMemorySize() const override
+	{
+		return sizeof(*this) + StringMemory(m_newFormat.fontName) + m_oldSpans.capacity() * sizeof(StyleSpan);
+	}
+
+	wxString GetTypeName() const override { return "ApplyFormat"; }
+
+private:
+	int m_startPos;
+	int m_endPos;
+	TextFormat m_newFormat;
+	std::vector<StyleSpan> m_oldSpans;
+};
+
+/// Compound command - all edits of one batch, undone and redone as one step
+class CompoundCommand : public ITextCommand
+{
+public:
+	explicit CompoundCommand(std::vector<std::unique_ptr<ITextCommand>> commands)
+		: m_commands(std::move(commands))
+	{
+	}
+
+	void Execute(bwxTextDocument* doc) override
+	{
+		for (auto& cmd : m_commands)
+			cmd->Execute(doc);
+	}
+
+	void Undo(bwxTextDocument* doc) override
+	{
+		// Reverse order - every command sees the document it left behind
+		for (auto it = m_commands.rbegin(); it != m_commands.rend(); ++it)
+			(*it)->Undo(doc);
+	}
+
+	size_t GetMemorySize() const override
+	{
+		size_t size = sizeof(*this) + m_commands.capacity() * sizeof(m_commands[0]);
+		for (const auto& cmd : m_commands)
+			size += cmd->GetMemorySize();
+		return size;
+	}
+
+	wxString GetTypeName() const override { return "Compound"; }
+
+private:
+	std::vector<std::unique_ptr<ITextCommand>> m_commands;
+};
+
+// ============================================================================
+// bwxTextDocument Implementation
+// ============================================================================
+
+/// Word separator for word counting
+static bool IsWordSeparator(wxChar ch)
+{
+	return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+bwxTextDocument::bwxTextDocument(TextStorageType storageType)
+	: m_storage(CreateTextStorage(storageType))
+	, m_storageType(storageType)
+	, m_styles()
+	, m_formatRuns()
+	, m_cursor()
+	, m_selection()
+	, m_metadata()
+	, m_undoStack()
+	, m_redoStack()
+	, m_maxUndoStack(100)
+	, m_maxUndoMemory(16 * 1024 * 1024)
+	, m_undoMemory(0)
+	, m_redoMemory(0)
+	, m_batchDepth(0)
+	, m_batchCommands()
+	, m_batchChanges()
+	, m_observers()
+	, m_changeCount(0)
+	, m_saveJobs()
+{
+}
+
+bwxTextDocument::~bwxTextDocument()
+{
+	// Background save must not outlive its job counter
+	WaitForSave();
+
+	// Clear undo/redo stacks (unique_ptr handles deletion)
+	m_undoStack.clear();
+	m_redoStack.clear();
+}
+
+// ============================================================================
+// Text Operations
+// ============================================================================
+
+wxString bwxTextDocument::GetText() const
+{
+	return m_storage->GetText();
+}
+
+wxString bwxTextDocument::GetText(int startPos, int endPos) const
+{
+	return m_storage->GetText(startPos, endPos);
+}
+
+void bwxTextDocument::SetText(const wxString& text)
+{
+	int oldLength = GetLength();
+	m_storage->SetText(text);
+
+	// Reset format runs
+	m_formatRuns.Reset(text.Length());
+
+	// Reset cursor and selection
+	m_cursor = Cursor();
+	m_selection = Selection();
+
+	// Clear undo history (new document)
+	ClearUndoHistory();
+
+	// Update metadata
+	UpdateWordCount();
+	m_metadata.modified = wxDateTime::Now();
+
+	NotifyTextRangeChanged(0, oldLength, GetLength());
+	NotifyTextChanged();
+}
+
+void bwxTextDocument::InsertText(int pos, const wxString& text)
+{
+	if (text.IsEmpty())
+		return;
+
+	// Create and execute command
+	auto cmd = std::make_unique<InsertTextCommand>(pos, text);
+	cmd->Execute(this);
+
+	AddCommand(std::move(cmd));
+}
+
+void bwxTextDocument::DeleteText(int startPos, int endPos, bool keystroke)
+{
+	if (startPos >= endPos)
+		return;
+
+	// Create and execute command
+	auto cmd = std::make_unique<DeleteTextCommand>(startPos, endPos, keystroke);
+	cmd->Execute(this);
+
+	AddCommand(std::move(cmd));
+}
+
+wxChar bwxTextDocument::GetChar(int pos) const
+{
+	return m_storage->GetChar(pos);
+}
+
+int bwxTextDocument::GetLength() const
+{
+	return m_storage->GetLength();
+}
+
+void bwxTextDocument::Clear()
+{
+	SetText(wxEmptyString);
+}
+
+// ============================================================================
+// Lines & Chunks
+// ============================================================================
+
+int bwxTextDocument::GetLineCount() const
+{
+	return m_storage->GetLineCount();
+}
+
+int bwxTextDocument::GetLineStart(int line) const
+{
+	return m_storage->GetLineStart(line);
+}
+
+int bwxTextDocument::GetLineEnd(int line) const
+{
+	if (line + 1 >= GetLineCount())
+		return GetLength();
+
+	// Next line starts right after the newline
+	return std::max(0, m_storage->GetLineStart(line + 1) - 1);
+}
+
+int bwxTextDocument::GetLineFromPosition(int pos) const
+{
+	return m_storage->GetLineFromPosition(pos);
+}
+
+wxString bwxTextDocument::GetLineText(int line) const
+{
+	return m_storage->GetText(GetLineStart(line), GetLineEnd(line));
+}
+
+void bwxTextDocument::ForEachChunk(int startPos, int endPos, const TextChunkVisitor& visitor) const
+{
+	m_storage->ForEachChunk(startPos, endPos, visitor);
+}
+
+void bwxTextDocument::SetStorageType(TextStorageType type)
+{
+	if (type == m_storageType)
+		return;
+
+	// Offsets stay the same, so format runs, cursor and undo commands remain valid
+	std::unique_ptr<ITextStorage> storage = CreateTextStorage(type);
+	storage->SetText(m_storage->GetText());
+
+	m_storage = std::move(storage);
+	m_storageType = type;
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+/// Characters searched per ForEachChunk() call - lets Find() stop early
+static const int SEARCH_WINDOW = 1 << 20;
+
+/// Streaming substring search over consecutive text chunks
+///
+/// Matches spanning a chunk boundary are found through a tail of the
+/// previous chunks (pattern length - 1 characters). Case-sensitive search
+/// jumps between first-character candidates with char_traits::find (wmemchr,
+/// vectorized by the C library) and compares them with char_traits::compare.
+class TextSearcher
+{
+public:
+	TextSearcher(const wxString& pattern, bool matchCase)
+		: m_pattern(pattern.ToStdWstring()), m_matchCase(matchCase)
+		, m_tail(), m_tailPos(0), m_nextPos(0), m_stopped(false)
+	{
+		if (!m_matchCase)
+		{
+			for (wchar_t& ch : m_pattern)
+				ch = Fold(ch);
+		}
+	}
+
+	/// Search next chunk (chunks must be consecutive)
+	/// @param chars Chunk characters
+	/// @param length Chunk length
+	/// @param chunkPos Document position of chunk
+	/// @param onMatch Receives match position, returns false to stop
+	/// @return false once stopped
+	bool Feed(const wxChar* chars, int length, int chunkPos, const std::function<bool(int)>& onMatch)
+	{
+		int patternLength = static_cast<int>(m_pattern.size());
+		if (m_stopped || patternLength == 0)
+			return false;
+
+		// Matches starting in tail of previous chunks, ending in this one
+		if (!m_tail.empty())
+		{
+			int tailLength = static_cast<int>(m_tail.size());
+			std::wstring joint = m_tail;
+			joint.append(chars, std::min(length, patternLength - 1));
+
+			for (int i = 0; i < tailLength && i + patternLength <= (int)joint.size(); ++i)
+			{
+				if (m_tailPos + i >= m_nextPos && Matches(joint.data() + i) && !Report(m_tailPos + i, onMatch))
+					return false;
+			}
+		}
+
+		// Matches inside this chunk
+		int last = length - patternLength;
+		int from = std::max(0, m_nextPos - chunkPos);
+		while (from <= last)
+		{
+			int candidate = FindCandidate(chars, from, last + 1);
+			if (candidate < 0)
+				break;
+
+			if (Matches(chars + candidate))
+			{
+				if (!Report(chunkPos + candidate, onMatch))
+					return false;
+				from = m_nextPos - chunkPos;
+			}
+			else
+			{
+				from = candidate + 1;
+			}
+		}
+
+		// Keep last pattern length - 1 characters for boundary matches
+		int keep = patternLength - 1;
+		if (length >= keep)
+		{
+			m_tail.assign(chars + length - keep, keep);
+			m_tailPos = chunkPos + length - keep;
+		}
+		else
+		{
+			if (m_tail.empty())
+				m_tailPos = chunkPos;
+			m_tail.append(chars, length);
+			int drop = static_cast<int>(m_tail.size()) - keep;
+			if (drop > 0)
+			{
+				m_tail.erase(0, drop);
+				m_tailPos += drop;
+			}
+		}
+		return true;
+	}
+
+	/// Check if search was stopped by onMatch
+	bool IsStopped() const { return m_stopped; }
+
+private:
+	/// Case folding - ASCII inline, the rest through wxTolower()
+	static wchar_t Fold(wchar_t ch)
+	{
+		if (ch < 0x80)
+			return (ch >= 'A' && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+		return static_cast<wchar_t>(wxTolower(ch));
+	}
+
+	/// Find first-character candidate in [from, end)
+	int FindCandidate(const wxChar* chars, int from, int end) const
+	{
+		if (m_matchCase)
+		{
+			const wxChar* hit = std::char_traits<wxChar>::find(chars + from, end - from, m_pattern[0]);
+			return hit ? static_cast<int>(hit - chars) : -1;
+		}
+
+		for (int i = from; i < end; ++i)
+		{
+			if (Fold(chars[i]) == m_pattern[0])
+				return i;
+		}
+		return -1;
+	}
+
+	/// Check if pattern matches at given characters
+	bool Matches(const wxChar* chars) const
+	{
+		if (m_matchCase)
+			return std::char_traits<wxChar>::compare(chars, m_pattern.data(), m_pattern.size()) == 0;
+
+		for (size_t i = 0; i < m_pattern.size(); ++i)
+		{
+			if (Fold(chars[i]) != m_pattern[i])
+				return false;
+		}
+		return true;
+	}
+
+	bool Report(int pos, const std::function<bool(int)>& onMatch)
+	{
+		// Matches don't overlap - next one starts after this one
+		m_nextPos = pos + static_cast<int>(m_pattern.size());
+		if (!onMatch(pos))
+			m_stopped = true;
+		return !m_stopped;
+	}
+
+	std::wstring m_pattern;  ///< Pattern (folded if !m_matchCase)
+	bool m_matchCase;        ///< Case-sensitive?
+	std::wstring m_tail;     ///< End of previous chunks (boundary matches)
+	int m_tailPos;           ///< Document position of m_tail
+	int m_nextPos;           ///< First position allowed for next match
+	bool m_stopped;          ///< Stopped by onMatch?
+};
+
+void bwxTextDocument::Search(const wxString& text, bool matchCase, int startPos, int endPos,
+                             const std::function<bool(int pos)>& onMatch) const
+{
+	startPos = std::max(startPos, 0);
+	endPos = std::min(endPos, GetLength());
+	if (text.IsEmpty() || endPos - startPos < (int)text.Length())
+		return;
+
+	TextSearcher searcher(text, matchCase);
+
+	// Windows of storage chunks - the visitor itself cannot stop ForEachChunk()
+	for (int windowStart = startPos; windowStart < endPos && !searcher.IsStopped(); windowStart += SEARCH_WINDOW)
+	{
+		int windowEnd = std::min(windowStart + SEARCH_WINDOW, endPos);
+		int chunkPos = windowStart;
+		ForEachChunk(windowStart, windowEnd, [&searcher, &chunkPos, &onMatch](const wxChar* chars, int length) {
+			searcher.Feed(chars, length, chunkPos, onMatch);
+			chunkPos += length;
+		});
+	}
+}
+
+int bwxTextDocument::Find(const wxString& text, int startPos, bool matchCase) const
+{
+	int found = -1;
+	Search(text, matchCase, startPos, GetLength(), [&found](int pos) {
+		found = pos;
+		return false;
+	});
+	return found;
+}
+
+std::vector<TextRange> bwxTextDocument::FindAll(const wxString& text, bool matchCase, int startPos, int endPos) const
+{
+	std::vector<TextRange> matches;
+	int length = static_cast<int>(text.Length());
+	Search(text, matchCase, startPos, endPos < 0 ? GetLength() : endPos, [&matches, length](int pos) {
+		matches.push_back(TextRange{ pos, pos + length });
+		return true;
+	});
+	return matches;
+}
+
+int bwxTextDocument::ReplaceAll(const wxString& text, const wxString& replacement, bool matchCase)
+{
+	std::vector<TextRange> matches = FindAll(text, matchCase);
+	if (matches.empty())
+		return 0;
+
+	// Back to front - earlier matches keep their positions
+	TextBatch batch(*this);
+	for (auto it = matches.rbegin(); it != matches.rend(); ++it)
+	{
+		DeleteText(it->startPos, it->endPos);
+		InsertText(it->startPos, replacement);
+	}
+
+	return static_cast<int>(matches.size());
+}
+
+// ============================================================================
+// Internal Text Operations (called by commands, no undo)
+// ============================================================================
+
+void bwxTextDocument::InsertTextInternal(int pos, const wxString& text)
+{
+	if (text.IsEmpty())
+		return;
+
+	int textLength = text.Length();
+
+	// Only word starts in the inserted text and right after it can change
+	int oldWords = CountWords(pos, std::min(pos + 1, GetLength()));
+
+	// Insert into storage
+	m_storage->InsertText(pos, text);
+
+	// Adjust format runs - the run at pos grows, later runs move with it
+	m_formatRuns.InsertText(pos, textLength);
+
+	// Adjust cursor
+	if (m_cursor.position >= pos)
+		m_cursor.position += textLength;
+
+	// Adjust selection
+	if (m_selection.active)
+	{
+		if (m_selection.startPos >= pos)
+			m_selection.startPos += textLength;
+		if (m_selection.endPos >= pos)
+			m_selection.endPos += textLength;
+	}
+
+	// Update metadata
+	m_metadata.wordCount += CountWords(pos, std::min(pos + textLength + 1, GetLength())) - oldWords;
+	m_metadata.characterCount = GetLength();
+	m_metadata.modified = wxDateTime::Now();
+
+	NotifyTextRangeChanged(pos, 0, textLength);
+	NotifyTextChanged();
+}
+
+void bwxTextDocument::DeleteTextInternal(int startPos, int endPos)
+{
+	if (startPos >= endPos)
+		return;
+
+	int deleteLength = endPos - startPos;
+
+	// Only word starts in the deleted text and right after it can change
+	int oldWords = CountWords(startPos, std::min(endPos + 1, GetLength()));
+
+	// Delete from storage
+	m_storage->DeleteText(startPos, endPos);
+
+	// Adjust format runs - runs inside the range disappear, later runs move back
+	m_formatRuns.DeleteText(startPos, endPos);
+
+	// Adjust cursor
+	if (m_cursor.position >= endPos)
+		m_cursor.position -= deleteLength;
+	else if (m_cursor.position > startPos)
+		m_cursor.position = startPos;
+
+	// Adjust selection
+	if (m_selection.active)
+	{
+		if (m_selection.startPos >= endPos)
+			m_selection.startPos -= deleteLength;
+		else if (m_selection.startPos > startPos)
+			m_selection.startPos = startPos;
+
+		if (m_selection.endPos >= endPos)
+			m_selection.endPos -= deleteLength;
+		else if (m_selection.endPos > startPos)
+			m_selection.endPos = startPos;
+
+		if (m_selection.startPos == m_selection.endPos)
+			m_selection.active = false;
+	}
+
+	// Update metadata
+	m_metadata.wordCount += CountWords(startPos, std::min(startPos + 1, GetLength())) - oldWords;
+	m_metadata.characterCount = GetLength();
+	m_metadata.modified = wxDateTime::Now();
+
+	NotifyTextRangeChanged(startPos, deleteLength, 0);
+	NotifyTextChanged();
+}
+
+// ============================================================================
+// Formatting Operations
+// ============================================================================
+
+void bwxTextDocument::ApplyFormat(int startPos, int endPos, const TextFormat& format)
+{
+	if (startPos >= endPos)
+		return;
+
+	// Create and execute command
+	auto cmd = std::make_unique<ApplyFormatCommand>(startPos, endPos, format);
+	cmd->Execute(this);
+
+	AddCommand(std::move(cmd));
+}
+
+void bwxTextDocument::ApplyFormatInternal(int startPos, int endPos, const TextFormat& format)
+{
+	if (startPos >= endPos)
+		return;
+
+	// Replace runs in range, joining neighbours with the same style
+	m_formatRuns.Assign(startPos, endPos, m_styles.Intern(format));
+
+	NotifyFormatRangeChanged(startPos, endPos);
+	NotifyFormatChanged();
+}
+
+TextFormat bwxTextDocument::GetFormatAt(int pos) const
+{
+	// Unknown style (past the end) gives default format
+	return m_styles.Get(m_formatRuns.Find(pos));
+}
+
+int bwxTextDocument::GetStyleIdAt(int pos) const
+{
+	return std::max(m_formatRuns.Find(pos), static_cast<int>(TextStyleTable::DefaultStyle));
+}
+
+std::vector<FormatRun> bwxTextDocument::GetFormatRuns(int startPos, int endPos) const
+{
+	std::vector<FormatRun> result;
+	m_formatRuns.Visit(startPos, endPos, [this, &result](int runStart, int runEnd, int styleId) {
+		result.push_back(FormatRun(runStart, runEnd, m_styles.Get(styleId), styleId));
+	});
+
+	return result;
+}
+
+void bwxTextDocument::ForEachFormatRun(int startPos, int endPos, const FormatRunTree::Visitor& visitor) const
+{
+	m_formatRuns.Visit(startPos, endPos, visitor);
+}
+
+void bwxTextDocument::RestoreFormatRuns(int startPos, int endPos, const std::vector<FormatRun>& runs)
+{
+	// Runs from GetFormatRuns() carry their style ID, others are interned here
+	std::vector<FormatRun> interned = runs;
+	for (FormatRun& run : interned)
+	{
+		if (run.styleId < 0 || run.styleId >= m_styles.GetCount() || m_styles.Get(run.styleId) != run.format)
+			run.styleId = m_styles.Intern(run.format);
+	}
+
+	m_formatRuns.Assign(startPos, endPos, interned);
+
+	NotifyFormatRangeChanged(startPos, endPos);
+	NotifyFormatChanged();
+}
+
+std::vector<StyleSpan> bwxTextDocument::GetStyleSpans(int startPos, int endPos) const
+{
+	std::vector<StyleSpan> spans;
+	ForEachFormatRun(startPos, endPos, [&spans](int runStart, int runEnd, int styleId) {
+		spans.push_back(StyleSpan{ runEnd - runStart, styleId });
+	});
+	return spans;
+}
+
+void bwxTextDocument::RestoreStyleSpans(int startPos, const std::vector<StyleSpan>& spans)
+{
+	std::vector<FormatRun> runs;
+	runs.reserve(spans.size());
+
+	int pos = startPos;
+	for (const StyleSpan& span : spans)
+	{
+		runs.emplace_back(pos, pos + span.length, TextFormat(), span.styleId);
+		pos += span.length;
+	}
+
+	m_formatRuns.Assign(startPos, pos, runs);
+
+	NotifyFormatRangeChanged(startPos, pos);
+	NotifyFormatChanged();
+}
+
+void bwxTextDocument::ClearFormatting()
+{
+	m_formatRuns.Reset(GetLength());
+	NotifyFormatRangeChanged(0, GetLength());
+	NotifyFormatChanged();
+}
+
+void bwxTextDocument::ClearFormatting(int startPos, int endPos)
+{
+	ApplyFormat(startPos, endPos, TextFormat());
+}
+
+// ============================================================================
+// Cursor & Selection
+// ============================================================================
+
+void bwxTextDocument::SetCursor(const Cursor& cursor)
+{
+	m_cursor = cursor;
+	m_cursor.position = std::max(0, std::min(m_cursor.position, GetLength()));
+	UpdateCursorLineColumn();
+	NotifyCursorMoved();
+}
+
+void bwxTextDocument::SetCursorPosition(int pos)
+{
+	m_cursor.position = std::max(0, std::min(pos, GetLength()));
+	UpdateCursorLineColumn();
+	NotifyCursorMoved();
+}
+
+void bwxTextDocument::MoveCursor(int offset)
+{
+	SetCursorPosition(m_cursor.position + offset);
+}
+
+void bwxTextDocument::SetSelection(int startPos, int endPos)
+{
+	m_selection.startPos = std::max(0, std::min(startPos, GetLength()));
+	m_selection.endPos = std::max(0, std::min(endPos, GetLength()));
+	m_selection.active = (m_selection.startPos != m_selection.endPos);
+	NotifySelectionChanged();
 }
 
 void bwxTextDocument::ClearSelection()
@@ -782,172 +2321,1091 @@ void bwxTextDocument::ClearSelection()
 	NotifySelectionChanged();
 }
 
-void bwxTextDocument::SelectAll()
+void bwxTextDocument::SelectAll()
+{
+	SetSelection(0, GetLength());
+}
+
+wxString bwxTextDocument::GetSelectedText() const
+{
+	if (!m_selection.active)
+		return wxEmptyString;
+
+	return GetText(m_selection.GetMin(), m_selection.GetMax());
+}
+
+bool bwxTextDocument::DeleteSelection()
+{
+	if (!m_selection.active || m_selection.IsEmpty())
+		return false;
+
+	DeleteText(m_selection.GetMin(), m_selection.GetMax());
+	ClearSelection();
+	return true;
+}
+
+void bwxTextDocument::UpdateCursorLineColumn()
+{
+	// Calculate line and column from position (line index lookup)
+	m_cursor.line = GetLineFromPosition(m_cursor.position);
+	m_cursor.column = m_cursor.position - GetLineStart(m_cursor.line);
+}
+
+// ============================================================================
+// Undo / Redo
+// ============================================================================
+
+void bwxTextDocument::Undo()
+{
+	if (!CanUndo())
+		return;
+
+	// Pop command from undo stack
+	std::unique_ptr<ITextCommand> cmd = std::move(m_undoStack.back());
+	m_undoStack.pop_back();
+	size_t size = cmd->GetMemorySize();
+	m_undoMemory -= size;
+
+	// Execute undo (one notification even for compound commands)
+	BeginBatch();
+	cmd->Undo(this);
+	EndBatch();
+
+	// Push to redo stack
+	m_redoStack.push_back(std::move(cmd));
+	m_redoMemory += size;
+}
+
+void bwxTextDocument::Redo()
+{
+	if (!CanRedo())
+		return;
+
+	// Pop command from redo stack
+	std::unique_ptr<ITextCommand> cmd = std::move(m_redoStack.back());
+	m_redoStack.pop_back();
+	m_redoMemory -= cmd->GetMemorySize();
+
+	// Execute redo (one notification even for compound commands)
+	BeginBatch();
+	cmd->Execute(this);
+	EndBatch();
+
+	// Push to undo stack (re-measured - redo may have re-read deleted text)
+	m_undoMemory += cmd->GetMemorySize();
+	m_undoStack.push_back(std::move(cmd));
+}
+
+bool bwxTextDocument::CanUndo() const
+{
+	return !m_undoStack.empty();
+}
+
+bool bwxTextDocument::CanRedo() const
+{
+	return !m_redoStack.empty();
+}
+
+void bwxTextDocument::ClearUndoHistory()
+{
+	m_undoStack.clear();
+	m_redoStack.clear();
+	m_batchCommands.clear();
+	m_undoMemory = 0;
+	m_redoMemory = 0;
+}
+
+void bwxTextDocument::SetMaxUndoMemory(size_t bytes)
+{
+	m_maxUndoMemory = bytes;
+	TrimUndoHistory();
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+void bwxTextDocument::BeginBatch()
+{
+	++m_batchDepth;
+}
+
+void bwxTextDocument::EndBatch()
+{
+	if (m_batchDepth == 0 || --m_batchDepth > 0)
+		return;
+
+	// One undo step for the whole batch
+	if (!m_batchCommands.empty())
+	{
+		std::unique_ptr<ITextCommand> cmd;
+		if (m_batchCommands.size() == 1)
+			cmd = std::move(m_batchCommands.front());
+		else
+			cmd = std::make_unique<CompoundCommand>(std::move(m_batchCommands));
+		m_batchCommands.clear();
+		AddCommand(std::move(cmd));
+	}
+
+	// One notification per change kind - text first, so layout is ready for cursor
+	BatchChanges changes = m_batchChanges;
+	m_batchChanges = BatchChanges();
+
+	if (changes.text)
+	{
+		int inserted = changes.textEnd - changes.textStart;
+		NotifyTextRangeChanged(changes.textStart, inserted - changes.textDelta, inserted);
+		NotifyTextChanged();
+	}
+	if (changes.format)
+	{
+		NotifyFormatRangeChanged(changes.formatStart, changes.formatEnd);
+		NotifyFormatChanged();
+	}
+	if (changes.cursor)
+		NotifyCursorMoved();
+	if (changes.selection)
+		NotifySelectionChanged();
+}
+
+void bwxTextDocument::AddCommand(std::unique_ptr<ITextCommand> cmd)
+{
+	// Clear redo stack (new action invalidates redo)
+	ClearRedoStack();
+
+	// Open batch collects commands into one undo step
+	if (m_batchDepth > 0)
+	{
+		m_batchCommands.push_back(std::move(cmd));
+		return;
+	}
+
+	// Try to merge with last command (for consecutive typing)
+	if (!m_undoStack.empty())
+	{
+		ITextCommand* lastCmd = m_undoStack.back().get();
+		if (lastCmd->CanMerge(cmd.get()))
+		{
+			m_undoMemory -= lastCmd->GetMemorySize();
+			lastCmd->Merge(cmd.get());
+			m_undoMemory += lastCmd->GetMemorySize();
+			TrimUndoHistory();
+			return;
+		}
+	}
+
+	// Add to undo stack
+	m_undoMemory += cmd->GetMemorySize();
+	m_undoStack.push_back(std::move(cmd));
+
+	TrimUndoHistory();
+}
+
+void bwxTextDocument::ClearRedoStack()
+{
+	m_redoStack.clear();
+	m_redoMemory = 0;
+}
+
+void bwxTextDocument::TrimUndoHistory()
+{
+	// Redo history goes first - it is the least likely to be used
+	if (m_undoMemory + m_redoMemory > m_maxUndoMemory)
+		ClearRedoStack();
+
+	// Keep the newest step even if it alone exceeds the budget
+	while (m_undoStack.size() > 1 &&
+	       ((int)m_undoStack.size() > m_maxUndoStack || m_undoMemory > m_maxUndoMemory))
+	{
+		m_undoMemory -= m_undoStack.front()->GetMemorySize();
+		m_undoStack.pop_front();
+	}
+}
+
+// ============================================================================
+// Metadata
+// ============================================================================
+
+void bwxTextDocument::UpdateWordCount()
+{
+	m_metadata.characterCount = GetLength();
+	m_metadata.wordCount = CountWords(0, GetLength());
+}
+
+int bwxTextDocument::CountWords(int startPos, int endPos) const
+{
+	// Count word starts (simple algorithm: split by whitespace) - a word
+	// continuing from before startPos is not counted again
+	int wordCount = 0;
+	bool inWord = startPos > 0 && startPos < endPos && !IsWordSeparator(GetChar(startPos - 1));
+
+	ForEachChunk(startPos, endPos, [&wordCount, &inWord](const wxChar* chars, int length) {
+		for (int i = 0; i < length; ++i)
+		{
+			bool isWhitespace = IsWordSeparator(chars[i]);
+
+			if (!isWhitespace && !inWord)
+			{
+				wordCount++;
+				inWord = true;
+			}
+			else if (isWhitespace)
+			{
+				inWord = false;
+			}
+		}
+	});
+
+	return wordCount;
+}
+
+// ============================================================================
+// .ktxt Streaming I/O
+// ============================================================================
+
+/// .ktxt format version written by SaveToFile()
+static const long KtxtVersion = 1;
+
+/// I/O buffer size of .ktxt reader and writer (bytes)
+static const size_t KtxtBufferSize = 64 * 1024;
+
+/// Streaming .ktxt writer - JSON is written piece by piece, no object tree
+///
+/// Text goes straight from storage chunks to UTF-8 in a fixed-size buffer.
+class KtxtWriter
+{
+public:
+	explicit KtxtWriter(std::ostream& out)
+		: m_out(out), m_buffer(), m_highSurrogate(0)
+	{
+		m_buffer.reserve(KtxtBufferSize + 16);
+	}
+
+	/// Write raw JSON syntax
+	void Raw(const char* text)
+	{
+		m_buffer += text;
+		FlushIfFull();
+	}
+
+	/// Write number
+	void Number(long long value) { Raw(std::to_string(value).c_str()); }
+
+	/// Write boolean
+	void Bool(bool value) { Raw(value ? "true" : "false"); }
+
+	/// Write quoted string
+	void String(const wxString& text)
+	{
+		std::wstring chars = text.ToStdWstring();
+		m_buffer += '"';
+		Chars(chars.data(), static_cast<int>(chars.size()));
+		EndChars();
+		m_buffer += '"';
+		FlushIfFull();
+	}
+
+	/// Write string contents piece by piece (escaped, no quotes) - finish with EndChars()
+	void Chars(const wxChar* chars, int length)
+	{
+		for (int i = 0; i < length; ++i)
+		{
+			unsigned long ch = static_cast<unsigned long>(chars[i]);
+
+			// UTF-16 wxChar: surrogate pair may be split between chunks
+			if (m_highSurrogate)
+			{
+				if (ch >= 0xDC00 && ch <= 0xDFFF)
+				{
+					AppendUTF8(0x10000 + ((m_highSurrogate - 0xD800) << 10) + (ch - 0xDC00));
+					m_highSurrogate = 0;
+					continue;
+				}
+				AppendUTF8(0xFFFD);
+				m_highSurrogate = 0;
+			}
+
+			switch (ch)
+			{
+				case '"':  m_buffer += "\\\""; break;
+				case '\\': m_buffer += "\\\\"; break;
+				case '\n': m_buffer += "\\n"; break;
+				case '\r': m_buffer += "\\r"; break;
+				case '\t': m_buffer += "\\t"; break;
+				default:
+					if (ch >= 0xD800 && ch <= 0xDBFF)
+					{
+						m_highSurrogate = ch;
+					}
+					else if (ch < 0x20)
+					{
+						static const char hex[] = "0123456789abcdef";
+						m_buffer += "\\u00";
+						m_buffer += hex[ch >> 4];
+						m_buffer += hex[ch & 0xF];
+					}
+					else
+					{
+						AppendUTF8(ch);
+					}
+					break;
+			}
+			FlushIfFull();
+		}
+	}
+
+	/// Finish string written with Chars()
+	void EndChars()
+	{
+		if (m_highSurrogate)
+			AppendUTF8(0xFFFD);
+		m_highSurrogate = 0;
+	}
+
+	/// Write buffered data to stream
+	/// @return true if everything so far was written
+	bool Flush()
+	{
+		m_out.write(m_buffer.data(), m_buffer.size());
+		m_buffer.clear();
+		return m_out.good();
+	}
+
+private:
+	void FlushIfFull()
+	{
+		if (m_buffer.size() >= KtxtBufferSize)
+			Flush();
+	}
+
+	void AppendUTF8(unsigned long cp)
+	{
+		if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+			cp = 0xFFFD;
+
+		if (cp < 0x80)
+		{
+			m_buffer += static_cast<char>(cp);
+		}
+		else if (cp < 0x800)
+		{
+			m_buffer += static_cast<char>(0xC0 | (cp >> 6));
+			m_buffer += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+		else if (cp < 0x10000)
+		{
+			m_buffer += static_cast<char>(0xE0 | (cp >> 12));
+			m_buffer += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			m_buffer += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+		else
+		{
+			m_buffer += static_cast<char>(0xF0 | (cp >> 18));
+			m_buffer += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+			m_buffer += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			m_buffer += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+	}
+
+	std::ostream& m_out;
+	std::string m_buffer;
+	unsigned long m_highSurrogate;  ///< Pending high surrogate (UTF-16 wxChar)
+};
+
+/// Streaming .ktxt reader - pull parser over a buffered stream, no object tree
+///
+/// Strings are decoded from UTF-8 straight into the target wxString.
+/// Any error makes IsOk() false and all further reads fail.
+class KtxtReader
 {
-	SetSelection(0, GetLength());
-}
+public:
+	explicit KtxtReader(std::istream& in)
+		: m_in(in), m_buffer(KtxtBufferSize), m_pos(0), m_end(0), m_ok(true)
+	{
+	}
 
-wxString bwxTextDocument::GetSelectedText() const
-{
-	if (!m_selection.active)
-		return wxEmptyString;
+	/// Check if everything read so far was valid
+	bool IsOk() const { return m_ok; }
 
-	return GetText(m_selection.GetMin(), m_selection.GetMax());
-}
+	/// Consume given syntax character (after whitespace) if present
+	bool Consume(char ch)
+	{
+		SkipSpace();
+		if (Peek() != static_cast<unsigned char>(ch))
+			return false;
+		++m_pos;
+		return true;
+	}
 
-bool bwxTextDocument::DeleteSelection()
-{
-	if (!m_selection.active || m_selection.IsEmpty())
-		return false;
+	/// Expect given syntax character
+	bool Expect(char ch) { return Consume(ch) || Fail(); }
 
-	DeleteText(m_selection.GetMin(), m_selection.GetMax());
-	ClearSelection();
-	return true;
-}
+	/// Advance to next object member - false at closing brace or on error
+	/// @param first In/out: true before the first member
+	/// @param key Member name
+	bool NextKey(bool& first, wxString& key)
+	{
+		if (!m_ok || Consume('}'))
+			return false;
+		if (!first && !Expect(','))
+			return false;
+		first = false;
+		key.clear();
+		return ReadString(key) && Expect(':');
+	}
 
-void bwxTextDocument::UpdateCursorLineColumn()
-{
-	// Calculate line and column from position
-	m_cursor.line = 0;
-	m_cursor.column = 0;
+	/// Advance to next array item - false at closing bracket or on error
+	/// @param first In/out: true before the first item
+	bool NextItem(bool& first)
+	{
+		if (!m_ok || Consume(']'))
+			return false;
+		if (!first && !Expect(','))
+			return false;
+		first = false;
+		return true;
+	}
+
+	/// Read string, appending to text
+	bool ReadString(wxString& text)
+	{
+		if (!Expect('"'))
+			return false;
+
+		wxChar chunk[1024];
+		size_t count = 0;
+		for (;;)
+		{
+			int ch = Get();
+			if (ch < 0)
+				return Fail();
+			if (ch == '"')
+				break;
+
+			unsigned long cp = 0;
+			if (ch == '\\')
+			{
+				if (!ReadEscape(cp))
+					return false;
+			}
+			else if (ch < 0x80)
+			{
+				cp = ch;
+			}
+			else
+			{
+				cp = ReadUTF8(ch);
+			}
+
+			// Code point to wxChar (surrogate pair for UTF-16 wxChar)
+			if (sizeof(wxChar) == 2 && cp >= 0x10000)
+			{
+				cp -= 0x10000;
+				chunk[count++] = static_cast<wxChar>(0xD800 + (cp >> 10));
+				chunk[count++] = static_cast<wxChar>(0xDC00 + (cp & 0x3FF));
+			}
+			else
+			{
+				chunk[count++] = static_cast<wxChar>(cp);
+			}
+
+			if (count >= WXSIZEOF(chunk) - 2)
+			{
+				text.append(chunk, count);
+				count = 0;
+			}
+		}
+		text.append(chunk, count);
+		return true;
+	}
 
-	wxString text = GetText();
-	for (int i = 0; i < m_cursor.position && i < (int)text.Length(); ++i)
+	/// Read integer number
+	bool ReadNumber(long long& value)
 	{
-		if (text[i] == '\n')
+		SkipSpace();
+		bool negative = Peek() == '-';
+		if (negative)
+			++m_pos;
+
+		int ch = Peek();
+		if (ch < '0' || ch > '9')
+			return Fail();
+
+		value = 0;
+		while ((ch = Peek()) >= '0' && ch <= '9')
 		{
-			m_cursor.line++;
-			m_cursor.column = 0;
+			if (value > (LLONG_MAX - 9) / 10)
+				return Fail();
+			value = value * 10 + (ch - '0');
+			++m_pos;
 		}
+		if (negative)
+			value = -value;
+		return true;
+	}
+
+	/// Read integer number in int range
+	bool ReadInt(int& value)
+	{
+		long long number = 0;
+		if (!ReadNumber(number) || number < INT_MIN || number > INT_MAX)
+			return Fail();
+		value = static_cast<int>(number);
+		return true;
+	}
+
+	/// Read boolean
+	bool ReadBool(bool& value)
+	{
+		SkipSpace();
+		if (ReadWord("true"))
+			value = true;
+		else if (ReadWord("false"))
+			value = false;
 		else
+			return Fail();
+		return true;
+	}
+
+	/// Skip any value (unknown members of newer versions)
+	bool SkipValue(int depth = 0)
+	{
+		if (depth > 64)
+			return Fail();
+
+		SkipSpace();
+		int ch = Peek();
+		bool first = true;
+		wxString skipped;
+		switch (ch)
 		{
-			m_cursor.column++;
+			case '{':
+				++m_pos;
+				while (NextKey(first, skipped))
+				{
+					skipped.clear();
+					if (!SkipValue(depth + 1))
+						return false;
+				}
+				return m_ok;
+			case '[':
+				++m_pos;
+				while (NextItem(first))
+				{
+					if (!SkipValue(depth + 1))
+						return false;
+				}
+				return m_ok;
+			case '"':
+				return ReadString(skipped);
+			case 't':
+			case 'f':
+			{
+				bool flag;
+				return ReadBool(flag);
+			}
+			case 'n':
+				return ReadWord("null") || Fail();
+			default:
+			{
+				// Numbers - fraction and exponent tolerated, value unused
+				long long number;
+				if (!ReadNumber(number))
+					return false;
+				while ((ch = Peek()) == '.' || ch == 'e' || ch == 'E' || ch == '+' || ch == '-' || (ch >= '0' && ch <= '9'))
+					++m_pos;
+				return true;
+			}
 		}
 	}
-}
 
-// ============================================================================
-// Undo / Redo
-// ============================================================================
+private:
+	bool Fail()
+	{
+		m_ok = false;
+		return false;
+	}
 
-void bwxTextDocument::Undo()
-{
-	if (!CanUndo())
-		return;
+	int Peek()
+	{
+		if (m_pos == m_end)
+		{
+			m_in.read(m_buffer.data(), m_buffer.size());
+			m_end = static_cast<size_t>(m_in.gcount());
+			m_pos = 0;
+			if (m_end == 0)
+				return -1;
+		}
+		return static_cast<unsigned char>(m_buffer[m_pos]);
+	}
 
-	// Pop command from undo stack
-	std::unique_ptr<ITextCommand> cmd = std::move(m_undoStack.back());
-	m_undoStack.pop_back();
+	int Get()
+	{
+		int ch = Peek();
+		if (ch >= 0)
+			++m_pos;
+		return ch;
+	}
 
-	// Execute undo
-	cmd->Undo(this);
+	void SkipSpace()
+	{
+		int ch;
+		while ((ch = Peek()) == ' ' || ch == '\n' || ch == '\r' || ch == '\t')
+			++m_pos;
+	}
 
-	// Push to redo stack
-	m_redoStack.push_back(std::move(cmd));
-}
+	bool ReadWord(const char* word)
+	{
+		for (; *word; ++word)
+		{
+			if (Get() != static_cast<unsigned char>(*word))
+				return false;
+		}
+		return true;
+	}
 
-void bwxTextDocument::Redo()
-{
-	if (!CanRedo())
-		return;
+	bool ReadHex4(unsigned long& value)
+	{
+		value = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			int ch = Get();
+			int digit;
+			if (ch >= '0' && ch <= '9')
+				digit = ch - '0';
+			else if (ch >= 'a' && ch <= 'f')
+				digit = ch - 'a' + 10;
+			else if (ch >= 'A' && ch <= 'F')
+				digit = ch - 'A' + 10;
+			else
+				return Fail();
+			value = (value << 4) | digit;
+		}
+		return true;
+	}
 
-	// Pop command from redo stack
-	std::unique_ptr<ITextCommand> cmd = std::move(m_redoStack.back());
-	m_redoStack.pop_back();
+	bool ReadEscape(unsigned long& cp)
+	{
+		int ch = Get();
+		switch (ch)
+		{
+			case '"':  cp = '"'; return true;
+			case '\\': cp = '\\'; return true;
+			case '/':  cp = '/'; return true;
+			case 'b':  cp = '\b'; return true;
+			case 'f':  cp = '\f'; return true;
+			case 'n':  cp = '\n'; return true;
+			case 'r':  cp = '\r'; return true;
+			case 't':  cp = '\t'; return true;
+			case 'u':
+			{
+				if (!ReadHex4(cp))
+					return false;
+				if (cp < 0xD800 || cp > 0xDBFF)
+				{
+					if (cp >= 0xDC00 && cp <= 0xDFFF)
+						cp = 0xFFFD;
+					return true;
+				}
+
+				// High surrogate - combine with following \uDC00..\uDFFF
+				unsigned long low = 0;
+				if (Peek() != '\\' || (++m_pos, Get() != 'u') || !ReadHex4(low) || low < 0xDC00 || low > 0xDFFF)
+					return Fail();
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+				return true;
+			}
+			default:
+				return Fail();
+		}
+	}
 
-	// Execute redo
-	cmd->Execute(this);
+	unsigned long ReadUTF8(int lead)
+	{
+		int extra;
+		unsigned long cp;
+		unsigned long minimum;
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			extra = 1;
+			cp = lead & 0x1F;
+			minimum = 0x80;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			extra = 2;
+			cp = lead & 0x0F;
+			minimum = 0x800;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			extra = 3;
+			cp = lead & 0x07;
+			minimum = 0x10000;
+		}
+		else
+		{
+			return 0xFFFD;
+		}
 
-	// Push to undo stack
-	m_undoStack.push_back(std::move(cmd));
-}
+		for (int i = 0; i < extra; ++i)
+		{
+			int ch = Peek();
+			if (ch < 0 || (ch & 0xC0) != 0x80)
+				return 0xFFFD;
+			cp = (cp << 6) | (ch & 0x3F);
+			++m_pos;
+		}
 
-bool bwxTextDocument::CanUndo() const
-{
-	return !m_undoStack.empty();
-}
+		if (cp < minimum || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+			return 0xFFFD;
+		return cp;
+	}
 
-bool bwxTextDocument::CanRedo() const
-{
-	return !m_redoStack.empty();
-}
+	std::istream& m_in;
+	std::vector<char> m_buffer;
+	size_t m_pos;
+	size_t m_end;
+	bool m_ok;
+};
 
-void bwxTextDocument::ClearUndoHistory()
+/// Read one style object of .ktxt "styles" array
+static bool ReadKtxtStyle(KtxtReader& reader, TextFormat& format)
 {
-	m_undoStack.clear();
-	m_redoStack.clear();
+	if (!reader.Expect('{'))
+		return false;
+
+	bool first = true;
+	wxString key;
+	while (reader.NextKey(first, key))
+	{
+		wxString colour;
+		if (key == "font")
+		{
+			format.fontName.clear();
+			reader.ReadString(format.fontName);
+		}
+		else if (key == "size")
+			reader.ReadInt(format.fontSize);
+		else if (key == "color" && reader.ReadString(colour))
+			format.textColor.Set(colour);
+		else if (key == "background" && reader.ReadString(colour))
+			format.backgroundColor.Set(colour);
+		else if (key == "bold")
+			reader.ReadBool(format.bold);
+		else if (key == "italic")
+			reader.ReadBool(format.italic);
+		else if (key == "underline")
+			reader.ReadBool(format.underline);
+		else
+			reader.SkipValue();
+	}
+	return reader.IsOk();
 }
 
-void bwxTextDocument::AddCommand(std::unique_ptr<ITextCommand> cmd)
+// ============================================================================
+// File I/O
+// ============================================================================
+
+bool bwxTextDocument::LoadFromFile(const wxString& path)
 {
-	// Clear redo stack (new action invalidates redo)
-	m_redoStack.clear();
+	std::ifstream file(path.fn_str(), std::ios::binary);
+	if (!file)
+	{
+		wxLogError("Cannot open file '%s'", path);
+		return false;
+	}
 
-	// Try to merge with last command (for consecutive typing)
-	if (!m_undoStack.empty())
+	// Read everything first - the document is replaced only if the file is valid
+	KtxtReader reader(file);
+	wxString format;
+	long long version = 0;
+	wxString title;
+	wxString author;
+	wxString created;
+	wxString modified;
+	std::vector<TextFormat> styles;
+	std::vector<StyleSpan> spans;
+	wxString text;
+
+	if (reader.Expect('{'))
 	{
-		ITextCommand* lastCmd = m_undoStack.back().get();
-		if (lastCmd->CanMerge(cmd.get()))
+		bool first = true;
+		wxString key;
+		while (reader.NextKey(first, key))
 		{
-			lastCmd->Merge(cmd.get());
-			return;
+			if (key == "format")
+				reader.ReadString(format);
+			else if (key == "version")
+				reader.ReadNumber(version);
+			else if (key == "title")
+				reader.ReadString(title);
+			else if (key == "author")
+				reader.ReadString(author);
+			else if (key == "created")
+				reader.ReadString(created);
+			else if (key == "modified")
+				reader.ReadString(modified);
+			else if (key == "styles" && reader.Expect('['))
+			{
+				bool firstStyle = true;
+				while (reader.NextItem(firstStyle))
+				{
+					styles.emplace_back();
+					ReadKtxtStyle(reader, styles.back());
+				}
+			}
+			else if (key == "runs" && reader.Expect('['))
+			{
+				// [[length, style], ...]
+				bool firstRun = true;
+				while (reader.NextItem(firstRun))
+				{
+					StyleSpan span = { 0, 0 };
+					if (reader.Expect('[') && reader.ReadInt(span.length) && reader.Expect(',') &&
+					    reader.ReadInt(span.styleId) && reader.Expect(']'))
+						spans.push_back(span);
+				}
+			}
+			else if (key == "length")
+			{
+				// Text length ahead of text - one allocation for the whole body
+				long long length = 0;
+				if (reader.ReadNumber(length) && length > 0 && length <= INT_MAX)
+					text.reserve(static_cast<size_t>(length));
+			}
+			else if (key == "text")
+				reader.ReadString(text);
+			else
+				reader.SkipValue();
 		}
 	}
 
-	// Add to undo stack
-	m_undoStack.push_back(std::move(cmd));
+	// Runs must use known styles and fit the text
+	bool valid = reader.IsOk() && format == "ktxt" && version >= 1 && version <= KtxtVersion;
+	long long runsLength = 0;
+	for (const StyleSpan& span : spans)
+	{
+		if (span.length <= 0 || span.styleId < 0 || span.styleId >= (int)styles.size())
+			valid = false;
+		runsLength += span.length;
+	}
+	if (!valid || runsLength > (long long)text.Length())
+	{
+		wxLogError("File '%s' is not a valid .ktxt document", path);
+		return false;
+	}
 
-	// Enforce undo limit
-	if ((int)m_undoStack.size() > m_maxUndoStack)
-		m_undoStack.pop_front();
-}
+	// Replace document - observers get one notification
+	BeginBatch();
 
-// ============================================================================
-// Metadata
-// ============================================================================
+	SetText(text);
+	text = wxString();
 
-void bwxTextDocument::UpdateWordCount()
+	std::vector<int> styleIds;
+	styleIds.reserve(styles.size());
+	for (const TextFormat& style : styles)
+		styleIds.push_back(m_styles.Intern(style));
+	for (StyleSpan& span : spans)
+		span.styleId = styleIds[span.styleId];
+	RestoreStyleSpans(0, spans);
+
+	m_metadata.title = title;
+	m_metadata.author = author;
+	if (!created.IsEmpty())
+		m_metadata.created.ParseISOCombined(created);
+	if (!modified.IsEmpty())
+		m_metadata.modified.ParseISOCombined(modified);
+
+	EndBatch();
+	return true;
+}
+
+/// Write .ktxt file - text comes from a chunk source, so live documents and snapshots share it
+/// Written to a temporary file first - a failed save keeps the old file. Safe on any thread.
+static bool WriteKtxtFile(const wxString& path, const DocumentMetadata& metadata,
+                          const std::vector<TextFormat>& styles, const std::vector<StyleSpan>& spans,
+                          int length, const std::function<void(const TextChunkVisitor&)>& forEachChunk)
 {
-	wxString text = GetText();
-	m_metadata.characterCount = text.Length();
+	wxString tempPath = path + ".tmp";
+	std::ofstream file(tempPath.fn_str(), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		wxLogError("Cannot create file '%s'", tempPath);
+		return false;
+	}
 
-	// Count words (simple algorithm: split by whitespace)
-	m_metadata.wordCount = 0;
-	bool inWord = false;
+	KtxtWriter writer(file);
+	writer.Raw("{\n\"format\": \"ktxt\",\n\"version\": ");
+	writer.Number(KtxtVersion);
+	writer.Raw(",\n\"title\": ");
+	writer.String(metadata.title);
+	writer.Raw(",\n\"author\": ");
+	writer.String(metadata.author);
+	writer.Raw(",\n\"created\": ");
+	writer.String(metadata.created.FormatISOCombined());
+	writer.Raw(",\n\"modified\": ");
+	writer.String(metadata.modified.FormatISOCombined());
+
+	writer.Raw(",\n\"styles\": [");
+	for (size_t i = 0; i < styles.size(); ++i)
+	{
+		const TextFormat& style = styles[i];
+		writer.Raw(i == 0 ? "\n{\"font\": " : ",\n{\"font\": ");
+		writer.String(style.fontName);
+		writer.Raw(", \"size\": ");
+		writer.Number(style.fontSize);
+		writer.Raw(", \"color\": ");
+		writer.String(style.textColor.GetAsString(wxC2S_HTML_SYNTAX));
+		writer.Raw(", \"background\": ");
+		writer.String(style.backgroundColor.GetAsString(wxC2S_HTML_SYNTAX));
+		writer.Raw(", \"bold\": ");
+		writer.Bool(style.bold);
+		writer.Raw(", \"italic\": ");
+		writer.Bool(style.italic);
+		writer.Raw(", \"underline\": ");
+		writer.Bool(style.underline);
+		writer.Raw("}");
+	}
 
-	for (size_t i = 0; i < text.Length(); ++i)
+	// Runs as [length, style] pairs
+	writer.Raw("\n],\n\"runs\": [");
+	for (size_t i = 0; i < spans.size(); ++i)
 	{
-		wxChar ch = text[i];
-		bool isWhitespace = (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r');
+		writer.Raw(i == 0 ? "[" : ",[");
+		writer.Number(spans[i].length);
+		writer.Raw(",");
+		writer.Number(spans[i].styleId);
+		writer.Raw("]");
+	}
 
-		if (!isWhitespace && !inWord)
-		{
-			m_metadata.wordCount++;
-			inWord = true;
-		}
-		else if (isWhitespace)
-		{
-			inWord = false;
-		}
+	// Text last, straight from the chunk source
+	writer.Raw("],\n\"length\": ");
+	writer.Number(length);
+	writer.Raw(",\n\"text\": \"");
+	forEachChunk([&writer](const wxChar* chars, int chunkLength) {
+		writer.Chars(chars, chunkLength);
+	});
+	writer.EndChars();
+	writer.Raw("\"\n}\n");
+
+	bool written = writer.Flush();
+	file.close();
+	if (!written || file.fail() || !wxRenameFile(tempPath, path, true))
+	{
+		wxRemoveFile(tempPath);
+		wxLogError("Cannot write file '%s'", path);
+		return false;
 	}
+	return true;
 }
 
-// ============================================================================
-// File I/O (Stub - will implement with JSON in Day 11-12)
-// ============================================================================
+bool bwxTextDocument::OpenTextFile(const wxString& path)
+{
+	// Mapping needs the piece table - the file becomes its original buffer
+	auto storage = std::make_unique<PieceTableStorage>();
+	if (!storage->MapFile(path))
+	{
+		wxLogError("Cannot open file '%s'", path);
+		return false;
+	}
+
+	int oldLength = GetLength();
+	int wordCount = storage->GetMappedWordCount();
+	m_storage = std::move(storage);
+	m_storageType = TextStorageType::PieceTable;
+
+	// Reset format runs
+	m_formatRuns.Reset(GetLength());
+
+	// Reset cursor and selection
+	m_cursor = Cursor();
+	m_selection = Selection();
 
-bool bwxTextDocument::LoadFromFile([[maybe_unused]] const wxString& path)
+	// Clear undo history (new document)
+	ClearUndoHistory();
+
+	// Counted while the file was indexed - no decoding pass
+	m_metadata.characterCount = GetLength();
+	m_metadata.wordCount = wordCount;
+	m_metadata.modified = wxDateTime::Now();
+
+	NotifyTextRangeChanged(0, oldLength, GetLength());
+	NotifyTextChanged();
+	return true;
+}
+
+bool bwxTextDocument::SaveToFile(const wxString& path)
+{
+	std::vector<TextFormat> styles;
+	std::vector<StyleSpan> spans;
+	GetFileStyles(styles, spans);
+
+	int length = GetLength();
+	return WriteKtxtFile(path, m_metadata, styles, spans, length, [this, length](const TextChunkVisitor& visitor) {
+		ForEachChunk(0, length, visitor);
+	});
+}
+
+std::shared_ptr<const DocumentSnapshot> bwxTextDocument::CreateSnapshot() const
+{
+	auto snapshot = std::make_shared<DocumentSnapshot>();
+
+	// One flat copy of the text - encoding and disk I/O are left to the caller
+	int length = GetLength();
+	snapshot->text.reserve(length);
+	ForEachChunk(0, length, [&snapshot](const wxChar* chars, int chunkLength) {
+		snapshot->text.append(chars, chunkLength);
+	});
+
+	GetFileStyles(snapshot->styles, snapshot->spans);
+	snapshot->metadata = m_metadata;
+	return snapshot;
+}
+
+bool bwxTextDocument::SaveSnapshot(const DocumentSnapshot& snapshot, const wxString& path)
+{
+	int length = static_cast<int>(snapshot.text.size());
+	return WriteKtxtFile(path, snapshot.metadata, snapshot.styles, snapshot.spans, length,
+		[&snapshot, length](const TextChunkVisitor& visitor) {
+			visitor(snapshot.text.data(), length);
+		});
+}
+
+void bwxTextDocument::SaveToFileAsync(const wxString& path, std::function<void(bool)> onDone)
+{
+	// Saves run one at a time - the next one may target the same file
+	WaitForSave();
+
+	std::shared_ptr<const DocumentSnapshot> snapshot = CreateSnapshot();
+	bwxJobSystem::GetInstance().Schedule([snapshot, path, onDone]() {
+		bool saved = SaveSnapshot(*snapshot, path);
+		if (onDone)
+			onDone(saved);
+	}, &m_saveJobs);
+}
+
+void bwxTextDocument::WaitForSave()
 {
-	// TODO: Implement JSON loading (Day 11-12)
-	wxLogWarning("bwxTextDocument::LoadFromFile() not yet implemented");
-	return false;
+	if (!m_saveJobs.IsDone())
+		bwxJobSystem::GetInstance().Wait(m_saveJobs);
 }
 
-bool bwxTextDocument::SaveToFile([[maybe_unused]] const wxString& path)
+void bwxTextDocument::GetFileStyles(std::vector<TextFormat>& styles, std::vector<StyleSpan>& spans) const
 {
-	// TODO: Implement JSON saving (Day 11-12)
-	wxLogWarning("bwxTextDocument::SaveToFile() not yet implemented");
-	return false;
+	// Only styles in use are written, renumbered densely
+	std::vector<int> fileStyles(m_styles.GetCount(), -1);
+	styles.clear();
+	spans.clear();
+
+	ForEachFormatRun(0, GetLength(), [this, &fileStyles, &styles, &spans](int startPos, int endPos, int styleId) {
+		if (fileStyles[styleId] < 0)
+		{
+			fileStyles[styleId] = static_cast<int>(styles.size());
+			styles.push_back(m_styles.Get(styleId));
+		}
+		spans.push_back(StyleSpan{ endPos - startPos, fileStyles[styleId] });
+	});
 }
 
 // ============================================================================
@@ -967,24 +3425,102 @@ void bwxTextDocument::RemoveObserver(IDocumentObserver* observer)
 
 void bwxTextDocument::NotifyTextChanged()
 {
+	// Batch sends it once, from the merged range
+	if (m_batchDepth > 0)
+		return;
+
 	for (auto* observer : m_observers)
 		observer->OnTextChanged();
 }
 
+void bwxTextDocument::NotifyTextRangeChanged(int pos, int removedLength, int insertedLength)
+{
+	++m_changeCount;
+
+	if (m_batchDepth > 0)
+	{
+		BatchChanges& changes = m_batchChanges;
+		int delta = insertedLength - removedLength;
+
+		// Move position of earlier change past this edit
+		auto map = [&](int p, int inside) {
+			return p <= pos ? p : (p >= pos + removedLength ? p + delta : inside);
+		};
+
+		if (!changes.text)
+		{
+			changes.text = true;
+			changes.textStart = pos;
+			changes.textEnd = pos + insertedLength;
+			changes.textDelta = delta;
+		}
+		else
+		{
+			// Merged edit covers both edits and any text between them
+			changes.textEnd = std::max(map(changes.textEnd, pos + insertedLength), pos + insertedLength);
+			changes.textStart = std::min(changes.textStart, pos);
+			changes.textDelta += delta;
+		}
+
+		if (changes.format)
+		{
+			changes.formatStart = map(changes.formatStart, pos);
+			changes.formatEnd = map(changes.formatEnd, pos + insertedLength);
+		}
+		return;
+	}
+
+	for (auto* observer : m_observers)
+		observer->OnTextRangeChanged(pos, removedLength, insertedLength);
+}
+
+void bwxTextDocument::NotifyFormatRangeChanged(int startPos, int endPos)
+{
+	++m_changeCount;
+
+	if (m_batchDepth > 0)
+	{
+		BatchChanges& changes = m_batchChanges;
+		changes.formatStart = changes.format ? std::min(changes.formatStart, startPos) : startPos;
+		changes.formatEnd = changes.format ? std::max(changes.formatEnd, endPos) : endPos;
+		changes.format = true;
+		return;
+	}
+
+	for (auto* observer : m_observers)
+		observer->OnFormatRangeChanged(startPos, endPos);
+}
+
 void bwxTextDocument::NotifyCursorMoved()
 {
+	if (m_batchDepth > 0)
+	{
+		m_batchChanges.cursor = true;
+		return;
+	}
+
 	for (auto* observer : m_observers)
 		observer->OnCursorMoved();
 }
 
 void bwxTextDocument::NotifySelectionChanged()
 {
+	if (m_batchDepth > 0)
+	{
+		m_batchChanges.selection = true;
+		return;
+	}
+
 	for (auto* observer : m_observers)
 		observer->OnSelectionChanged();
 }
 
 void bwxTextDocument::NotifyFormatChanged()
 {
+	// Batch sends it once, from the merged range
+	if (m_batchDepth > 0)
+		return;
+
 	for (auto* observer : m_observers)
 		observer->OnFormatChanged();
 }
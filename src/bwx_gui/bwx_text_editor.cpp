@@ -15,6 +15,8 @@
 #include <wx/clipbrd.h>
 #include <wx/dcbuffer.h>
 #include <bwx_sdk/bwx_gui/bwx_text_editor.h>
+#include <algorithm>
+#include <iterator>
 
 namespace bwx_sdk {
 namespace gui {
@@ -23,6 +25,13 @@ namespace gui {
 // Event Table
 // ============================================================================
 
+/// Timer IDs (one owner, so events are told apart by ID)
+enum
+{
+	ID_CARET_TIMER = wxID_HIGHEST + 1,
+	ID_AUTOSAVE_TIMER
+};
+
 wxBEGIN_EVENT_TABLE(bwxTextEditor, wxControl)
 	EVT_PAINT(bwxTextEditor::OnPaint)
 	EVT_SIZE(bwxTextEditor::OnSize)
@@ -32,10 +41,15 @@ wxBEGIN_EVENT_TABLE(bwxTextEditor, wxControl)
 	EVT_MOTION(bwxTextEditor::OnMotion)
 	EVT_SET_FOCUS(bwxTextEditor::OnSetFocus)
 	EVT_KILL_FOCUS(bwxTextEditor::OnKillFocus)
-	EVT_TIMER(wxID_ANY, bwxTextEditor::OnCaretTimer)
+	EVT_TIMER(ID_CARET_TIMER, bwxTextEditor::OnCaretTimer)
+	EVT_TIMER(ID_AUTOSAVE_TIMER, bwxTextEditor::OnAutoSaveTimer)
 	EVT_MOUSEWHEEL(bwxTextEditor::OnMouseWheel)
+	EVT_IDLE(bwxTextEditor::OnIdle)
 wxEND_EVENT_TABLE()
 
+/// Time per idle event spent on deferred layout (lazy layout mode)
+static const int IDLE_LAYOUT_BUDGET_MS = 8;
+
 // ============================================================================
 // Construction / Destruction
 // ============================================================================
@@ -45,11 +59,20 @@ bwxTextEditor::bwxTextEditor()
 	, m_document()
 	, m_viewMode(VIEW_FULL)
 	, m_renderer(nullptr)
-	, m_caretTimer(this, wxID_ANY)
+	, m_caretTimer(this, ID_CARET_TIMER)
 	, m_caretVisible(true)
 	, m_hasFocus(false)
 	, m_scrollY(0)
+	, m_autoSaveTimer(this, ID_AUTOSAVE_TIMER)
+	, m_autoSavePath()
+	, m_autoSaveChangeCount(0)
+	, m_caretRect()
+	, m_selectionStart(0)
+	, m_selectionEnd(0)
 	, m_isSelecting(false)
+	, m_searchText()
+	, m_searchMatchCase(true)
+	, m_searchMatches()
 {
 	Init();
 }
@@ -65,11 +88,20 @@ bwxTextEditor::bwxTextEditor(wxWindow* parent,
 	, m_document()
 	, m_viewMode(VIEW_FULL)
 	, m_renderer(nullptr)
-	, m_caretTimer(this, wxID_ANY)
+	, m_caretTimer(this, ID_CARET_TIMER)
 	, m_caretVisible(true)
 	, m_hasFocus(false)
 	, m_scrollY(0)
+	, m_autoSaveTimer(this, ID_AUTOSAVE_TIMER)
+	, m_autoSavePath()
+	, m_autoSaveChangeCount(0)
+	, m_caretRect()
+	, m_selectionStart(0)
+	, m_selectionEnd(0)
 	, m_isSelecting(false)
+	, m_searchText()
+	, m_searchMatchCase(true)
+	, m_searchMatches()
 {
 	Init();
 	Create(parent, id, pos, size, style, validator, name);
@@ -77,8 +109,16 @@ bwxTextEditor::bwxTextEditor(wxWindow* parent,
 
 bwxTextEditor::~bwxTextEditor()
 {
-	// Stop timer
+	// Renderer window is a child - destroy it while this window still exists
+	if (m_renderer)
+		m_renderer->Detach();
+
+	// Stop timers
 	StopCaretTimer();
+	m_autoSaveTimer.Stop();
+
+	// Autosave result is posted to this window - no more after this
+	m_document.WaitForSave();
 
 	// Unregister as document observer
 	m_document.RemoveObserver(this);
@@ -111,9 +151,10 @@ bool bwxTextEditor::Create(wxWindow* parent,
 	// Set initial size
 	SetInitialSize(size);
 
-	// Update renderer size
+	// Attach renderer (own window, if any) and update its size
 	if (m_renderer)
 	{
+		m_renderer->Attach(this);
 		wxSize clientSize = GetClientSize();
 		m_renderer->OnResize(clientSize.GetWidth(), clientSize.GetHeight());
 	}
@@ -123,32 +164,53 @@ bool bwxTextEditor::Create(wxWindow* parent,
 
 void bwxTextEditor::CreateRenderer()
 {
-	// MVP: Only Full View renderer
-	switch (m_viewMode)
-	{
-		case VIEW_FULL:
-			m_renderer = std::make_unique<FullViewRenderer>();
-			break;
+	// Window of old renderer goes with it
+	if (m_renderer)
+		m_renderer->Detach();
+	m_renderer.reset();
 
-		case VIEW_PAGE:
-		case VIEW_TYPEWRITER:
-		case VIEW_PUBLISHER:
-			// Future: Other renderers (Tasks #00020-#00022)
-			wxLogWarning("View mode %d not yet implemented, using Full View", m_viewMode);
-			m_renderer = std::make_unique<FullViewRenderer>();
-			m_viewMode = VIEW_FULL;
-			break;
+	if (m_rendererFactory)
+		m_renderer = m_rendererFactory(m_viewMode);
 
-		default:
-			wxLogError("Unknown view mode %d", m_viewMode);
-			m_renderer = std::make_unique<FullViewRenderer>();
-			m_viewMode = VIEW_FULL;
-			break;
+	if (!m_renderer)
+	{
+		switch (m_viewMode)
+		{
+			case VIEW_FULL:
+				m_renderer = std::make_unique<FullViewRenderer>();
+				break;
+
+			case VIEW_PAGE:
+				m_renderer = std::make_unique<PageViewRenderer>();
+				break;
+
+			case VIEW_TYPEWRITER:
+			case VIEW_PUBLISHER:
+				// Future: Other renderers (Tasks #00021-#00022)
+				wxLogWarning("View mode %d not yet implemented, using Full View", m_viewMode);
+				m_renderer = std::make_unique<FullViewRenderer>();
+				m_viewMode = VIEW_FULL;
+				break;
+
+			default:
+				wxLogError("Unknown view mode %d", m_viewMode);
+				m_renderer = std::make_unique<FullViewRenderer>();
+				m_viewMode = VIEW_FULL;
+				break;
+		}
 	}
 
 	// Connect document to renderer
 	if (m_renderer)
+	{
 		m_renderer->SetDocument(&m_document);
+		m_renderer->SetCursorVisible(m_hasFocus && m_caretVisible);
+		m_renderer->SetHighlights(m_searchMatches);
+
+		// Before Create() there is no window yet - Create() attaches
+		if (GetHandle())
+			m_renderer->Attach(this);
+	}
 }
 
 // ============================================================================
@@ -183,6 +245,30 @@ void bwxTextEditor::SetViewMode(ViewMode mode)
 	Refresh();
 }
 
+void bwxTextEditor::SetRendererFactory(RendererFactory factory)
+{
+	m_rendererFactory = std::move(factory);
+	CreateRenderer();
+
+	if (m_renderer)
+	{
+		wxSize clientSize = GetClientSize();
+		m_renderer->OnResize(clientSize.GetWidth(), clientSize.GetHeight());
+	}
+
+	Refresh();
+}
+
+void bwxTextEditor::Refresh(bool eraseBackground, const wxRect* rect)
+{
+	wxControl::Refresh(eraseBackground, rect);
+
+	// Renderer's own window is repainted whole
+	wxWindow* surface = m_renderer ? m_renderer->GetSurface() : nullptr;
+	if (surface)
+		surface->Refresh(false);
+}
+
 // ============================================================================
 // Editing Operations
 // ============================================================================
@@ -226,6 +312,9 @@ void bwxTextEditor::Paste()
 		wxTheClipboard->GetData(data);
 		wxString text = data.GetText();
 
+		// Replace selection as one undo step and one repaint
+		TextBatch batch(m_document);
+
 		// Delete selection if active
 		Selection sel = m_document.GetSelection();
 		if (sel.active && !sel.IsEmpty())
@@ -247,10 +336,78 @@ void bwxTextEditor::SelectAll()
 	if (length > 0)
 	{
 		m_document.SetSelection(0, length);
-		Refresh();
 	}
 }
 
+// ============================================================================
+// Search
+// ============================================================================
+
+void bwxTextEditor::SetSearchHighlight(const wxString& text, bool matchCase)
+{
+	m_searchText = text;
+	m_searchMatchCase = matchCase;
+	m_searchMatches.clear();
+	if (!text.IsEmpty())
+		m_searchMatches = m_document.FindAll(text, matchCase);
+
+	if (m_renderer)
+		m_renderer->SetHighlights(m_searchMatches);
+	Refresh();
+}
+
+bool bwxTextEditor::FindNext(const wxString& text, bool matchCase)
+{
+	// Search after cursor, then wrap around to the start
+	int pos = m_document.Find(text, m_document.GetCursor().position, matchCase);
+	if (pos < 0)
+		pos = m_document.Find(text, 0, matchCase);
+	if (pos < 0)
+		return false;
+
+	int end = pos + static_cast<int>(text.Length());
+	TextBatch batch(m_document);
+	m_document.SetCursorPosition(end);
+	m_document.SetSelection(pos, end);
+	return true;
+}
+
+void bwxTextEditor::UpdateSearchMatches(int pos, int removedLength, int insertedLength)
+{
+	if (m_searchText.IsEmpty())
+		return;
+
+	int length = static_cast<int>(m_searchText.Length());
+	int delta = insertedLength - removedLength;
+
+	// Matches ending before the edit stay, matches after it shift, the rest is searched again
+	auto before = std::lower_bound(m_searchMatches.begin(), m_searchMatches.end(), pos,
+		[](const TextRange& range, int p) { return range.endPos <= p; });
+	auto after = std::lower_bound(before, m_searchMatches.end(), pos + removedLength,
+		[](const TextRange& range, int p) { return range.startPos < p; });
+
+	// Search window - new text plus overlap of one match on both sides
+	int windowStart = std::max(pos - length + 1, 0);
+	if (before != m_searchMatches.begin())
+		windowStart = std::max(windowStart, std::prev(before)->endPos);
+	int windowEnd = std::min(pos + insertedLength + length - 1, m_document.GetLength());
+	if (after != m_searchMatches.end())
+		windowEnd = std::min(windowEnd, after->startPos + delta);
+
+	std::vector<TextRange> found = m_document.FindAll(m_searchText, m_searchMatchCase, windowStart, windowEnd);
+
+	for (auto it = after; it != m_searchMatches.end(); ++it)
+	{
+		it->startPos += delta;
+		it->endPos += delta;
+	}
+	before = m_searchMatches.erase(before, after);
+	m_searchMatches.insert(before, found.begin(), found.end());
+
+	if (m_renderer)
+		m_renderer->SetHighlights(m_searchMatches);
+}
+
 void bwxTextEditor::Undo()
 {
 	if (m_document.CanUndo())
@@ -278,21 +435,56 @@ bool bwxTextEditor::CanRedo() const
 }
 
 // ============================================================================
-// File I/O (stub for Days 11-12)
+// File I/O
 // ============================================================================
 
-bool bwxTextEditor::LoadFromFile(const wxString& WXUNUSED(path))
+bool bwxTextEditor::LoadFromFile(const wxString& path)
 {
-	// TODO: Implement in Days 11-12
-	wxLogWarning("LoadFromFile not yet implemented");
-	return false;
+	// Document notifies us - layout, scrollbar and caret follow
+	if (!m_document.LoadFromFile(path))
+		return false;
+
+	ScrollTo(0);
+	return true;
 }
 
-bool bwxTextEditor::SaveToFile(const wxString& WXUNUSED(path))
+bool bwxTextEditor::SaveToFile(const wxString& path)
 {
-	// TODO: Implement in Days 11-12
-	wxLogWarning("SaveToFile not yet implemented");
-	return false;
+	if (!m_document.SaveToFile(path))
+		return false;
+
+	// Saved state is current - autosave has nothing new to write
+	m_autoSaveChangeCount = m_document.GetChangeCount();
+	return true;
+}
+
+void bwxTextEditor::SetAutoSave(const wxString& path, int intervalMs)
+{
+	m_autoSaveTimer.Stop();
+	m_autoSavePath = path;
+	m_autoSaveChangeCount = m_document.GetChangeCount();
+
+	if (!path.IsEmpty() && intervalMs > 0)
+		m_autoSaveTimer.Start(intervalMs);
+}
+
+void bwxTextEditor::OnAutoSaveTimer(wxTimerEvent& WXUNUSED(event))
+{
+	// Unchanged since last save, or previous save still writing - try next tick
+	if (m_document.GetChangeCount() == m_autoSaveChangeCount || m_document.IsSaving())
+		return;
+
+	// Counted as saved only once written - a failed save is retried next tick
+	unsigned int changeCount = m_document.GetChangeCount();
+	wxString path = m_autoSavePath;
+	m_document.SaveToFileAsync(path, [this, changeCount, path](bool saved) {
+		CallAfter([this, changeCount, path, saved]() {
+			if (!saved)
+				wxLogWarning("Autosave to '%s' failed, retrying", path);
+			else if (changeCount > m_autoSaveChangeCount)
+				m_autoSaveChangeCount = changeCount;
+		});
+	});
 }
 
 // ============================================================================
@@ -308,11 +500,20 @@ void bwxTextEditor::OnPaint(wxPaintEvent& WXUNUSED(event))
 	if (!m_renderer)
 		return;
 
-	// Get client rect
+	// Get client rect and the part of it to repaint
 	wxRect clientRect = GetClientRect();
-
-	// Render document
-	m_renderer->Render(dc, clientRect, m_scrollY);
+	wxRect updateRect = GetUpdateRegion().GetBox();
+	if (updateRect.IsEmpty())
+		updateRect = clientRect;
+
+	// Layout of text scrolled into view may move more than this paint covers
+	wxRect damage = m_renderer->UpdateLayout(m_scrollY, clientRect);
+	if (!damage.IsEmpty() && !updateRect.Contains(damage))
+		RefreshRect(damage, false);
+
+	// Render repainted area only
+	dc.SetClippingRegion(updateRect);
+	m_renderer->RenderArea(dc, clientRect, m_scrollY, updateRect);
 }
 
 void bwxTextEditor::OnSize(wxSizeEvent& event)
@@ -369,6 +570,9 @@ void bwxTextEditor::OnKeyDown(wxKeyEvent& event)
 
 void bwxTextEditor::HandleCharInput(wxChar ch)
 {
+	// Typing over selection is one undo step and one repaint
+	TextBatch batch(m_document);
+
 	// Delete selection if active
 	Selection sel = m_document.GetSelection();
 	if (sel.active && !sel.IsEmpty())
@@ -376,12 +580,9 @@ void bwxTextEditor::HandleCharInput(wxChar ch)
 		m_document.DeleteText(sel.GetMin(), sel.GetMax());
 	}
 
-	// Insert character at cursor
+	// Insert character at cursor (repaint follows from OnTextChanged)
 	Cursor cursor = m_document.GetCursor();
 	m_document.InsertText(cursor.position, wxString(ch));
-
-	// Refresh
-	Refresh();
 }
 
 void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
@@ -516,9 +717,8 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 				else if (cursor.position > 0)
 				{
 					// Delete character before cursor
-					m_document.DeleteText(cursor.position - 1, cursor.position);
+					m_document.DeleteText(cursor.position - 1, cursor.position, true);
 				}
-				Refresh();
 			}
 			break;
 
@@ -533,9 +733,8 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 				else if (cursor.position < textLength)
 				{
 					// Delete character after cursor
-					m_document.DeleteText(cursor.position, cursor.position + 1);
+					m_document.DeleteText(cursor.position, cursor.position + 1, true);
 				}
-				Refresh();
 			}
 			break;
 
@@ -546,6 +745,8 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 		case WXK_RETURN:
 		case WXK_NUMPAD_ENTER:
 			{
+				TextBatch batch(m_document);
+
 				// Delete selection if active
 				Selection sel = m_document.GetSelection();
 				if (sel.active && !sel.IsEmpty())
@@ -556,7 +757,6 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 				// Insert newline
 				Cursor cur = m_document.GetCursor();
 				m_document.InsertText(cur.position, "\n");
-				Refresh();
 			}
 			break;
 
@@ -613,7 +813,6 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 					TextFormat format = m_document.GetFormatAt(sel.GetMin());
 					format.bold = !format.bold;
 					m_document.ApplyFormat(sel.GetMin(), sel.GetMax(), format);
-					Refresh();
 				}
 			}
 			break;
@@ -628,7 +827,6 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 					TextFormat format = m_document.GetFormatAt(sel.GetMin());
 					format.italic = !format.italic;
 					m_document.ApplyFormat(sel.GetMin(), sel.GetMax(), format);
-					Refresh();
 				}
 			}
 			break;
@@ -643,7 +841,6 @@ void bwxTextEditor::HandleKeyCommand(int keyCode, bool ctrl, bool shift)
 					TextFormat format = m_document.GetFormatAt(sel.GetMin());
 					format.underline = !format.underline;
 					m_document.ApplyFormat(sel.GetMin(), sel.GetMax(), format);
-					Refresh();
 				}
 			}
 			break;
@@ -696,8 +893,6 @@ void bwxTextEditor::OnLeftDown(wxMouseEvent& event)
 			m_document.ClearSelection();
 			m_isSelecting = true;
 		}
-
-		Refresh();
 	}
 }
 
@@ -717,7 +912,6 @@ void bwxTextEditor::OnMotion(wxMouseEvent& event)
 			if (docPos != cursor.position)
 			{
 				m_document.SetSelection(cursor.position, docPos);
-				Refresh();
 			}
 		}
 	}
@@ -736,25 +930,7 @@ void bwxTextEditor::OnMouseWheel(wxMouseEvent& event)
 	// Calculate scroll amount (negative delta = scroll down)
 	int scrollAmount = -delta / event.GetWheelDelta() * lines * 20;  // 20 pixels per line
 
-	int newScrollY = m_scrollY + scrollAmount;
-
-	// Clamp to valid range
-	int maxScroll = 0;
-	if (m_renderer)
-	{
-		int totalHeight = m_renderer->GetTotalHeight();
-		int clientHeight = GetClientSize().GetHeight();
-		maxScroll = std::max(0, totalHeight - clientHeight);
-	}
-
-	newScrollY = std::max(0, std::min(newScrollY, maxScroll));
-
-	if (newScrollY != m_scrollY)
-	{
-		m_scrollY = newScrollY;
-		UpdateScrollbar();
-		Refresh();
-	}
+	ScrollTo(m_scrollY + scrollAmount);
 }
 
 // ============================================================================
@@ -764,24 +940,47 @@ void bwxTextEditor::OnMouseWheel(wxMouseEvent& event)
 void bwxTextEditor::OnSetFocus(wxFocusEvent& event)
 {
 	m_hasFocus = true;
+	m_caretVisible = true;
+	if (m_renderer)
+		m_renderer->SetCursorVisible(true);
 	StartCaretTimer();
-	Refresh();
+	RefreshCaret();
 	event.Skip();
 }
 
 void bwxTextEditor::OnKillFocus(wxFocusEvent& event)
 {
 	m_hasFocus = false;
+	if (m_renderer)
+		m_renderer->SetCursorVisible(false);
 	StopCaretTimer();
-	Refresh();
+	RefreshCaret();
 	event.Skip();
 }
 
 void bwxTextEditor::OnCaretTimer(wxTimerEvent& WXUNUSED(event))
 {
-	// Toggle caret visibility
+	// Toggle caret visibility - repaint caret only
 	m_caretVisible = !m_caretVisible;
-	Refresh();
+	if (m_renderer)
+		m_renderer->SetCursorVisible(m_caretVisible);
+	RefreshDocumentRect(m_caretRect);
+}
+
+void bwxTextEditor::OnIdle(wxIdleEvent& event)
+{
+	// Measure off-screen paragraphs in small batches (lazy layout)
+	if (m_renderer)
+	{
+		int totalHeight = m_renderer->GetTotalHeight();
+		if (m_renderer->LayoutIdle(IDLE_LAYOUT_BUDGET_MS, m_scrollY))
+			event.RequestMore();
+
+		if (m_renderer->GetTotalHeight() != totalHeight)
+			UpdateScrollbar();
+	}
+
+	event.Skip();
 }
 
 // ============================================================================
@@ -790,34 +989,45 @@ void bwxTextEditor::OnCaretTimer(wxTimerEvent& WXUNUSED(event))
 
 void bwxTextEditor::OnTextChanged()
 {
-	// Text changed - refresh
+	// Text changed - repaint what the edited paragraphs changed
+	UpdateScrollbar();
+	RefreshLayoutChanges();
+}
+
+void bwxTextEditor::OnTextRangeChanged(int pos, int removedLength, int insertedLength)
+{
+	// Re-layout edited paragraphs only
 	if (m_renderer)
-		m_renderer->InvalidateLayout();
+		m_renderer->OnTextEdited(pos, removedLength, insertedLength);
 
-	UpdateScrollbar();
-	Refresh();
+	// Highlighted matches - search again around the edit only
+	UpdateSearchMatches(pos, removedLength, insertedLength);
 }
 
 void bwxTextEditor::OnCursorMoved()
 {
 	// Cursor moved - update caret
 	UpdateCaret();
-	Refresh();
+	RefreshCaret();
 }
 
 void bwxTextEditor::OnSelectionChanged()
 {
-	// Selection changed - refresh
-	Refresh();
+	// Selection changed - repaint old and new selection lines
+	RefreshSelection();
 }
 
 void bwxTextEditor::OnFormatChanged()
 {
-	// Format changed - refresh
-	if (m_renderer)
-		m_renderer->InvalidateLayout();
+	// Format changed - repaint what the reformatted paragraphs changed
+	RefreshLayoutChanges();
+}
 
-	Refresh();
+void bwxTextEditor::OnFormatRangeChanged(int startPos, int endPos)
+{
+	// Re-layout reformatted paragraphs only
+	if (m_renderer)
+		m_renderer->InvalidateRange(startPos, endPos);
 }
 
 // ============================================================================
@@ -831,6 +1041,8 @@ void bwxTextEditor::UpdateCaret()
 
 	// Reset caret blink
 	m_caretVisible = true;
+	if (m_renderer)
+		m_renderer->SetCursorVisible(m_hasFocus);
 	if (m_hasFocus)
 		StartCaretTimer();
 }
@@ -838,13 +1050,17 @@ void bwxTextEditor::UpdateCaret()
 void bwxTextEditor::ShowCaret()
 {
 	m_caretVisible = true;
-	Refresh();
+	if (m_renderer)
+		m_renderer->SetCursorVisible(true);
+	RefreshDocumentRect(m_caretRect);
 }
 
 void bwxTextEditor::HideCaret()
 {
 	m_caretVisible = false;
-	Refresh();
+	if (m_renderer)
+		m_renderer->SetCursorVisible(false);
+	RefreshDocumentRect(m_caretRect);
 }
 
 void bwxTextEditor::StartCaretTimer()
@@ -877,22 +1093,20 @@ void bwxTextEditor::ScrollToCursor()
 	wxRect cursorRect = m_renderer->GetCursorRect(cursor.position);
 
 	int clientHeight = GetClientSize().GetHeight();
+	int scrollY = m_scrollY;
 
 	// Check if cursor is above visible area
-	if (cursorRect.y - m_scrollY < 0)
+	if (cursorRect.y - scrollY < 0)
 	{
-		m_scrollY = cursorRect.y;
+		scrollY = cursorRect.y;
 	}
 	// Check if cursor is below visible area
-	else if (cursorRect.y + cursorRect.height - m_scrollY > clientHeight)
+	else if (cursorRect.y + cursorRect.height - scrollY > clientHeight)
 	{
-		m_scrollY = cursorRect.y + cursorRect.height - clientHeight;
+		scrollY = cursorRect.y + cursorRect.height - clientHeight;
 	}
 
-	// Clamp scroll position
-	int totalHeight = m_renderer->GetTotalHeight();
-	int maxScroll = std::max(0, totalHeight - clientHeight);
-	m_scrollY = std::max(0, std::min(m_scrollY, maxScroll));
+	SetScrollPosition(scrollY);
 }
 
 void bwxTextEditor::ScrollTo(int y)
@@ -900,13 +1114,108 @@ void bwxTextEditor::ScrollTo(int y)
 	if (!m_renderer)
 		return;
 
+	int oldScrollY = m_scrollY;
+	SetScrollPosition(y);
+	if (m_scrollY != oldScrollY)
+		UpdateScrollbar();
+}
+
+void bwxTextEditor::SetScrollPosition(int y)
+{
+	if (!m_renderer)
+		return;
+
+	// Clamp scroll position
 	int totalHeight = m_renderer->GetTotalHeight();
-	int clientHeight = GetClientSize().GetHeight();
-	int maxScroll = std::max(0, totalHeight - clientHeight);
+	wxSize clientSize = GetClientSize();
+	int maxScroll = std::max(0, totalHeight - clientSize.GetHeight());
+	y = std::max(0, std::min(y, maxScroll));
 
-	m_scrollY = std::max(0, std::min(y, maxScroll));
-	UpdateScrollbar();
-	Refresh();
+	int delta = y - m_scrollY;
+	if (delta == 0)
+		return;
+
+	m_scrollY = y;
+
+	// Renderer's own window is repainted whole (scrolling pixels would move the window)
+	if (m_renderer->GetSurface())
+	{
+		m_renderer->UpdateLayout(m_scrollY, GetClientRect());
+		Refresh(false);
+	}
+	// Move what is still visible, repaint only the exposed strip
+	else if (std::abs(delta) < clientSize.GetHeight())
+		ScrollWindow(0, -delta);
+	else
+		Refresh();
+}
+
+// ============================================================================
+// Partial Repaint
+// ============================================================================
+
+void bwxTextEditor::RefreshDocumentRect(const wxRect& rect)
+{
+	if (rect.IsEmpty())
+		return;
+
+	// Caret is drawn as a 1px line - cover neighbouring pixels too
+	wxRect clientRect(rect.x - 1, rect.y - m_scrollY, rect.width + 2, rect.height);
+	if (clientRect.Intersects(GetClientRect()))
+		RefreshRect(clientRect, false);
+}
+
+void bwxTextEditor::RefreshLayoutChanges()
+{
+	if (!m_renderer)
+		return;
+
+	wxRect damage = m_renderer->UpdateLayout(m_scrollY, GetClientRect());
+	if (!damage.IsEmpty())
+		RefreshRect(damage, false);
+
+	// Edits move caret and selection without separate notifications
+	RefreshCaret();
+	RefreshSelection();
+}
+
+void bwxTextEditor::RefreshCaret()
+{
+	if (!m_renderer)
+		return;
+
+	wxRect caretRect = m_renderer->GetCursorRect(m_document.GetCursor().position);
+	if (caretRect == m_caretRect)
+	{
+		RefreshDocumentRect(caretRect);
+		return;
+	}
+
+	RefreshDocumentRect(m_caretRect);
+	RefreshDocumentRect(caretRect);
+	m_caretRect = caretRect;
+}
+
+void bwxTextEditor::RefreshSelection()
+{
+	if (!m_renderer)
+		return;
+
+	Selection sel = m_document.GetSelection();
+	int start = sel.active ? sel.GetMin() : 0;
+	int end = sel.active ? sel.GetMax() : 0;
+	if (start == m_selectionStart && end == m_selectionEnd)
+		return;
+
+	// Old range may lie past the end after a deletion
+	int length = m_document.GetLength();
+	for (const wxRect& rect : m_renderer->GetSelectionRects(std::min(m_selectionStart, length), std::min(m_selectionEnd, length)))
+		RefreshDocumentRect(rect);
+	for (const wxRect& rect : m_renderer->GetSelectionRects(start, end))
+		RefreshDocumentRect(rect);
+
+	m_selectionStart = start;
+	m_selectionEnd = end;
 }
 
 } // namespace gui
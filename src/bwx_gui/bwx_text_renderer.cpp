@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        bwx_text_renderer.cpp
-// Purpose:     Full View text renderer implementation
+// Purpose:     Full View and Page View text renderer implementation
 // Author:      Kalahari Team
 // Created:     2025-11-04
 // Copyright:   (c) 2025 Kalahari Project
@@ -14,37 +14,155 @@
 
 #include <bwx_sdk/bwx_gui/bwx_text_renderer.h>
 #include <algorithm>
+#include <chrono>
+#include <climits>
 
 namespace bwx_sdk {
 namespace gui {
 
+// Worker batch limits (a batch is copied on UI thread, so keep it small)
+static constexpr size_t LAYOUT_JOB_PARAGRAPHS = 512;
+static constexpr size_t LAYOUT_JOB_CHARS = 128 * 1024;
+
+// ============================================================================
+// HeightIndex Implementation
+// ============================================================================
+
+void FullViewRenderer::HeightIndex::Assign(const std::vector<ParagraphLayout>& paragraphs)
+{
+	int count = static_cast<int>(paragraphs.size());
+	m_heights.resize(count);
+	m_tree.assign(count + 1, 0);
+	m_total = 0;
+
+	// Linear build: every node passes its sum on to its parent
+	for (int i = 1; i <= count; ++i)
+	{
+		m_heights[i - 1] = paragraphs[i - 1].height;
+		m_total += m_heights[i - 1];
+		m_tree[i] += m_heights[i - 1];
+
+		int parent = i + (i & -i);
+		if (parent <= count)
+			m_tree[parent] += m_tree[i];
+	}
+}
+
+void FullViewRenderer::HeightIndex::Set(int index, int height)
+{
+	if (index < 0 || index >= GetCount())
+		return;
+
+	int delta = height - m_heights[index];
+	if (delta == 0)
+		return;
+
+	m_heights[index] = height;
+	m_total += delta;
+	for (int i = index + 1; i <= GetCount(); i += i & -i)
+		m_tree[i] += delta;
+}
+
+int FullViewRenderer::HeightIndex::GetOffset(int index) const
+{
+	int sum = 0;
+	for (int i = std::min(index, GetCount()); i > 0; i -= i & -i)
+		sum += m_tree[i];
+	return sum;
+}
+
+int FullViewRenderer::HeightIndex::FindIndex(int offset) const
+{
+	int count = GetCount();
+	if (count == 0)
+		return 0;
+
+	// Descend the tree: largest prefix whose sum does not exceed offset
+	int index = 0;
+	int step = 1;
+	while (step * 2 <= count)
+		step *= 2;
+
+	for (; step > 0; step /= 2)
+	{
+		if (index + step <= count && m_tree[index + step] <= offset)
+		{
+			index += step;
+			offset -= m_tree[index];
+		}
+	}
+
+	return std::min(index, count - 1);
+}
+
+// ============================================================================
+// ParagraphLayout Implementation
+// ============================================================================
+
+int FullViewRenderer::ParagraphLayout::FindChar(const LayoutLine& line, int x) const
+{
+	// First character whose right edge is past x
+	auto first = edges.begin() + line.edgeOffset;
+	auto last = first + line.GetLength();
+	return static_cast<int>(std::upper_bound(first, last, x) - first);
+}
+
 // ============================================================================
 // FullViewRenderer Implementation
 // ============================================================================
 
 FullViewRenderer::FullViewRenderer()
 	: m_document(nullptr)
-	, m_lines()
+	, m_paragraphs()
+	, m_heights()
+	, m_dirtyFirst(-1)
+	, m_dirtyLast(-1)
 	, m_clientWidth(800)
 	, m_clientHeight(600)
 	, m_marginLeft(20)
+	, m_marginTop(20)
 	, m_marginRight(20)
 	, m_lineSpacing(1.2)
 	, m_layoutValid(false)
+	, m_damageTop(-1)
+	, m_damageBottom(-1)
+	, m_cursorVisible(true)
+	, m_lazyLayout(false)
+	, m_idleNext(-1)
+	, m_backgroundLayout(true)
+	, m_layoutJob()
+	, m_layoutJobs()
+	, m_layoutGeneration(0)
+	, m_layoutEnd(0)
+	, m_averageCharWidth(8)
+	, m_averageLineHeight(16)
 	, m_selectionColor(100, 150, 255)  // Blue (Task #00019 Settings)
 	, m_selectionOpacity(128)           // Semi-transparent (Task #00019 Settings)
-	, m_fontCache()
+	, m_highlights()
+	, m_highlightColor(255, 220, 0)     // Yellow
+	, m_styleCache()
+	, m_measureBitmap()
+	, m_measureDC()
+	, m_measureStyle(-1)
 {
 }
 
 FullViewRenderer::~FullViewRenderer()
 {
-	// Font cache cleared automatically (std::map destructor)
+	// Job holds its own data, but still counts down m_layoutJobs
+	if (!m_layoutJobs.IsDone())
+		bwxJobSystem::GetInstance().Wait(m_layoutJobs);
+
+	// Style cache cleared automatically (std::vector destructor)
 }
 
 void FullViewRenderer::SetDocument(bwxTextDocument* doc)
 {
 	m_document = doc;
+
+	// Style IDs belong to the document
+	m_styleCache.clear();
+	m_measureStyle = -1;
 	InvalidateLayout();
 }
 
@@ -61,15 +179,130 @@ void FullViewRenderer::OnResize(int width, int height)
 void FullViewRenderer::InvalidateLayout()
 {
 	m_layoutValid = false;
+	DiscardLayoutJob();
+	AddDamage(0, INT_MAX);
+}
+
+void FullViewRenderer::OnTextEdited(int pos, [[maybe_unused]] int removedLength, int insertedLength)
+{
+	// Full layout pending anyway
+	if (!m_document || !m_layoutValid)
+		return;
+
+	// Paragraphs [first, oldLast] were replaced by [first, newLast]
+	int oldCount = static_cast<int>(m_paragraphs.size());
+	int delta = m_document->GetLineCount() - oldCount;
+	int first = m_document->GetLineFromPosition(pos);
+	int newLast = m_document->GetLineFromPosition(pos + insertedLength);
+	int oldLast = newLast - delta;
+
+	if (oldLast < first || oldLast >= oldCount)
+	{
+		InvalidateLayout();
+		return;
+	}
+
+	if (delta != 0)
+	{
+		if (delta > 0)
+			m_paragraphs.insert(m_paragraphs.begin() + oldLast + 1, delta, ParagraphLayout());
+		else
+			m_paragraphs.erase(m_paragraphs.begin() + newLast + 1, m_paragraphs.begin() + oldLast + 1);
+
+		// Paragraphs after the edit moved - renumber pending range, rebuild prefix sums
+		auto remap = [&](int i) { return i > oldLast ? i + delta : std::min(i, newLast); };
+		if (m_dirtyFirst >= 0)
+		{
+			m_dirtyFirst = remap(m_dirtyFirst);
+			m_dirtyLast = remap(m_dirtyLast);
+		}
+		if (m_idleNext >= 0)
+			m_idleNext = remap(m_idleNext);
+		m_heights.Assign(m_paragraphs);
+
+		// Everything below the edit moved
+		AddDamage(GetParagraphY(first), INT_MAX);
+	}
+
+	MarkDirty(first, newLast);
+}
+
+void FullViewRenderer::InvalidateRange(int startPos, int endPos)
+{
+	if (!m_document || !m_layoutValid || m_paragraphs.empty())
+		return;
+
+	int last = static_cast<int>(m_paragraphs.size()) - 1;
+	MarkDirty(std::min(m_document->GetLineFromPosition(startPos), last),
+		std::min(m_document->GetLineFromPosition(endPos), last));
+}
+
+void FullViewRenderer::MarkDirty(int first, int last)
+{
+	DiscardLayoutJob();
+	if (m_dirtyFirst < 0)
+	{
+		m_dirtyFirst = first;
+		m_dirtyLast = last;
+	}
+	else
+	{
+		m_dirtyFirst = std::min(m_dirtyFirst, first);
+		m_dirtyLast = std::max(m_dirtyLast, last);
+	}
+}
+
+void FullViewRenderer::AddDamage(int top, int bottom)
+{
+	if (m_damageTop < 0)
+	{
+		m_damageTop = top;
+		m_damageBottom = bottom;
+	}
+	else
+	{
+		m_damageTop = std::min(m_damageTop, top);
+		m_damageBottom = std::max(m_damageBottom, bottom);
+	}
+}
+
+void FullViewRenderer::AddParagraphDamage(int paragraph, int oldHeight)
+{
+	int y = GetParagraphY(paragraph);
+	int height = m_paragraphs[paragraph].height;
+	AddDamage(y, height != oldHeight ? INT_MAX : y + height);
+}
+
+wxRect FullViewRenderer::UpdateLayout(int scrollY, const wxRect& clientRect)
+{
+	CalculateLayout();
+
+	if (m_lazyLayout && !m_paragraphs.empty())
+	{
+		LayoutVisible(GetMeasureDC(), scrollY, clientRect.GetHeight());
+	}
+
+	if (m_damageTop < 0)
+		return wxRect();
+
+	// Document coords to client coords, clipped to viewport
+	int top = std::max(m_damageTop - scrollY, clientRect.GetTop());
+	int bottom = m_damageBottom == INT_MAX ? clientRect.GetBottom() + 1
+		: std::min(m_damageBottom - scrollY, clientRect.GetBottom() + 1);
+	m_damageTop = m_damageBottom = -1;
+
+	if (top >= bottom)
+		return wxRect();
+
+	return wxRect(clientRect.GetLeft(), top, clientRect.GetWidth(), bottom - top);
 }
 
 int FullViewRenderer::GetTotalHeight() const
 {
-	if (m_lines.empty())
+	if (m_paragraphs.empty())
 		return 0;
 
-	const LayoutLine& lastLine = m_lines.back();
-	return lastLine.y + lastLine.height;
+	return m_marginTop + m_heights.GetTotal();
 }
 
 // ============================================================================
@@ -78,196 +311,347 @@ int FullViewRenderer::GetTotalHeight() const
 
 void FullViewRenderer::CalculateLayout()
 {
-	if (!m_document || m_layoutValid)
+	if (!m_document || (m_layoutValid && m_dirtyFirst < 0))
 		return;
 
-	m_lines.clear();
-
-	wxString text = m_document->GetText();
-	if (text.IsEmpty())
+	if (m_document->GetLength() == 0)
 	{
+		AddDamage(0, INT_MAX);
+		m_paragraphs.clear();
+		m_heights.Clear();
+		m_dirtyFirst = m_dirtyLast = -1;
+		m_idleNext = -1;
 		m_layoutValid = true;
 		return;
 	}
 
-	// Create temporary DC for measurements
-	// Use client width/height for proper text extent calculations
-	wxMemoryDC memDC;
-	wxBitmap tempBitmap(std::max(m_clientWidth, 1), std::max(m_clientHeight, 1));
-	memDC.SelectObject(tempBitmap);
+	if (m_layoutValid && m_lazyLayout)
+	{
+		// Edited paragraphs wait for LayoutVisible() or idle time
+		int first = m_dirtyFirst;
+		int last = std::min(m_dirtyLast, static_cast<int>(m_paragraphs.size()) - 1);
+		DeferDirtyParagraphs();
+		OnParagraphsLaidOut(first, last);
+		return;
+	}
 
-	int yPos = m_marginLeft;  // Start with top margin
+	wxDC& measureDC = GetMeasureDC();
 
-	// Process text line by line (split by \n)
-	int lineStart = 0;
-	for (size_t i = 0; i <= text.Length(); ++i)
+	bool fullLayout = !m_layoutValid;
+	if (fullLayout)
 	{
-		if (i == text.Length() || text[i] == '\n')
-		{
-			// Found line end
-			wxString lineText = text.Mid(lineStart, i - lineStart);
+		// Process text paragraph by paragraph (line index - no full-text copy)
+		m_paragraphs.assign(m_document->GetLineCount(), ParagraphLayout());
+		m_dirtyFirst = 0;
+		m_dirtyLast = static_cast<int>(m_paragraphs.size()) - 1;
+		m_idleNext = -1;
 
-			if (lineText.IsEmpty())
-			{
-				// Empty line (just newline)
-				TextFormat defaultFormat;
-				wxFont font = GetFont(defaultFormat);
-				memDC.SetFont(font);
-
-				wxSize textSize = memDC.GetTextExtent("M");  // Measure M for line height
-				int lineHeight = static_cast<int>(textSize.GetHeight() * m_lineSpacing);
-
-				LayoutLine emptyLine;
-				emptyLine.startPos = lineStart;
-				emptyLine.endPos = lineStart;
-				emptyLine.y = yPos;
-				emptyLine.height = lineHeight;
-				m_lines.push_back(emptyLine);
-
-				yPos += lineHeight;
-			}
-			else
-			{
-				// Non-empty line - word wrap
-				CalculateLine(lineText, lineStart, memDC, yPos);
-			}
+		if (m_lazyLayout)
+		{
+			// Estimated heights only - precise layout follows the viewport
+			MeasureAverages(measureDC);
+			for (int paragraph = 0; paragraph <= m_dirtyLast; ++paragraph)
+				m_paragraphs[paragraph].height = EstimateHeight(paragraph);
+
+			m_heights.Assign(m_paragraphs);
+			OnParagraphsLaidOut(0, m_dirtyLast);
+			m_dirtyFirst = m_dirtyLast = -1;
+			m_idleNext = 0;
+			m_layoutValid = true;
+			return;
+		}
+	}
 
-			lineStart = i + 1;
+	int first = std::max(m_dirtyFirst, 0);
+	int last = std::min(m_dirtyLast, static_cast<int>(m_paragraphs.size()) - 1);
+	for (int paragraph = first; paragraph <= last; ++paragraph)
+	{
+		int oldHeight = m_paragraphs[paragraph].height;
+		LayoutParagraph(paragraph, measureDC);
+		if (!fullLayout)
+		{
+			AddParagraphDamage(paragraph, oldHeight);
+			m_heights.Set(paragraph, m_paragraphs[paragraph].height);
 		}
 	}
 
+	if (fullLayout)
+		m_heights.Assign(m_paragraphs);
+	if (first <= last)
+		OnParagraphsLaidOut(first, last);
+
+	m_dirtyFirst = m_dirtyLast = -1;
 	m_layoutValid = true;
 }
 
-void FullViewRenderer::CalculateLine(const wxString& text, int startPos, wxDC& dc, int& yPos)
+void FullViewRenderer::LayoutParagraph(int paragraph, wxDC& dc)
+{
+	int paragraphStart = m_document->GetLineStart(paragraph);
+	wxString paragraphText = m_document->GetLineText(paragraph);
+
+	ParagraphLayout& layout = m_paragraphs[paragraph];
+	layout.Clear();
+	int yPos = 0;
+
+	if (paragraphText.IsEmpty())
+	{
+		// Empty line (just newline) - default style line height
+		const StyleCache& style = SelectStyle(dc, TextStyleTable::DefaultStyle);
+		int lineHeight = static_cast<int>(style.height * m_lineSpacing);
+
+		LayoutLine emptyLine;
+		emptyLine.startPos = 0;
+		emptyLine.endPos = 0;
+		emptyLine.y = 0;
+		emptyLine.height = lineHeight;
+		emptyLine.edgeOffset = 0;
+		layout.lines.push_back(emptyLine);
+
+		yPos += lineHeight;
+	}
+	else
+	{
+		// Non-empty line - word wrap (positions paragraph-relative)
+		CalculateLine(paragraphText, paragraphStart, dc, layout, yPos);
+	}
+
+	layout.height = yPos;
+	layout.measured = true;
+}
+
+// ============================================================================
+// Lazy Layout
+// ============================================================================
+
+void FullViewRenderer::DeferDirtyParagraphs()
 {
+	int last = std::min(m_dirtyLast, static_cast<int>(m_paragraphs.size()) - 1);
+	for (int paragraph = std::max(m_dirtyFirst, 0); paragraph <= last; ++paragraph)
+	{
+		// Old height is the best estimate for an edited paragraph
+		// (repainted once LayoutVisible() measures it, if visible)
+		ParagraphLayout& layout = m_paragraphs[paragraph];
+		layout.Clear();
+		layout.measured = false;
+		if (layout.height == 0)
+		{
+			layout.height = EstimateHeight(paragraph);
+			AddDamage(GetParagraphY(paragraph), INT_MAX);
+		}
+		m_heights.Set(paragraph, layout.height);
+	}
+
+	if (m_dirtyFirst >= 0)
+		m_idleNext = m_idleNext < 0 ? m_dirtyFirst : std::min(m_idleNext, m_dirtyFirst);
 
-	// Get default format for this line (simplified - take format at start position)
-	TextFormat format = m_document->GetFormatAt(startPos);
-	wxFont font = GetFont(format);
-	dc.SetFont(font);
+	m_dirtyFirst = m_dirtyLast = -1;
+}
 
-	// Word wrap algorithm
-	std::vector<wxString> words;
-	std::vector<int> wordStartPositions;
+void FullViewRenderer::LayoutVisible(wxDC& dc, int scrollY, int clientHeight)
+{
+	if (!m_lazyLayout || m_paragraphs.empty())
+		return;
 
-	// Split into words
-	wxString currentWord;
-	int wordStart = startPos;
-	for (size_t i = 0; i < text.Length(); ++i)
+	// Measured heights move paragraphs, so repeat until viewport (plus one screen below) is measured
+	for (int pass = 0; pass < 4; ++pass)
 	{
-		wxChar ch = text[i];
-		if (ch == ' ' || ch == '\t')
+		int firstParagraph, lastParagraph;
+		GetVisibleParagraphRange(scrollY, clientHeight * 2, firstParagraph, lastParagraph);
+
+		int firstChanged = -1;
+		int lastChanged = -1;
+		for (int paragraph = firstParagraph; paragraph <= lastParagraph; ++paragraph)
 		{
-			if (!currentWord.IsEmpty())
+			if (!m_paragraphs[paragraph].measured)
 			{
-				words.push_back(currentWord);
-				wordStartPositions.push_back(wordStart);
-				currentWord.Clear();
+				int oldHeight = m_paragraphs[paragraph].height;
+				LayoutParagraph(paragraph, dc);
+				AddParagraphDamage(paragraph, oldHeight);
+				m_heights.Set(paragraph, m_paragraphs[paragraph].height);
+				if (firstChanged < 0)
+					firstChanged = paragraph;
+				lastChanged = paragraph;
 			}
-			// Add space as separate "word"
-			words.push_back(wxString(ch));
-			wordStartPositions.push_back(startPos + i);
-			wordStart = startPos + i + 1;
 		}
-		else
+
+		if (firstChanged < 0)
+			break;
+		OnParagraphsLaidOut(firstChanged, lastChanged);
+	}
+}
+
+bool FullViewRenderer::LayoutIdle(int maxMilliseconds, int& scrollY)
+{
+	// Pending edits are handled by the next render first
+	if (!m_document || !m_lazyLayout || !m_layoutValid || m_dirtyFirst >= 0 || m_idleNext < 0)
+		return false;
+
+	// Worker still busy - it wakes idle processing up when done
+	if (m_layoutJob && !m_layoutJobs.IsDone())
+		return false;
+
+	// Keep paragraph at top of viewport in place while heights above it change
+	int anchor = m_heights.FindIndex(std::max(0, scrollY - m_marginTop));
+	int anchorOffset = scrollY - GetParagraphY(anchor);
+
+	int count = static_cast<int>(m_paragraphs.size());
+	int first = m_idleNext;
+	bool background = m_backgroundLayout && bwxJobSystem::GetInstance().GetWorkerCount() > 0;
+	if (m_layoutJob)
+		ApplyLayoutJob();
+	if (!background)
+		m_layoutEnd = count;
+
+	// Paragraphs the worker could not measure (glyphs not in advance cache yet, complex scripts) -
+	// laying them out here fills the cache for the next batches
+	wxDC& measureDC = GetMeasureDC();
+
+	auto start = std::chrono::steady_clock::now();
+	int end = std::min(m_layoutEnd, count);
+	while (m_idleNext < end)
+	{
+		if (!m_paragraphs[m_idleNext].measured)
 		{
-			if (currentWord.IsEmpty())
-				wordStart = startPos + i;
-			currentWord += ch;
+			LayoutParagraph(m_idleNext, measureDC);
+			m_heights.Set(m_idleNext, m_paragraphs[m_idleNext].height);
 		}
+		++m_idleNext;
+
+		if (std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(maxMilliseconds))
+			break;
 	}
-	if (!currentWord.IsEmpty())
+	OnParagraphsLaidOut(first, std::min(m_idleNext, count - 1));
+
+	scrollY = std::max(0, GetParagraphY(anchor) + anchorOffset);
+
+	if (m_idleNext >= count)
 	{
-		words.push_back(currentWord);
-		wordStartPositions.push_back(wordStart);
+		m_idleNext = -1;
+		return false;
 	}
 
-	// Pack words into lines
-	int currentX = m_marginLeft;
-	int lineStartPos = startPos;
-	wxString currentLine;
-	std::vector<CharInfo> currentCharInfo;
+	// Out of time, or next batch goes to worker
+	if (m_idleNext < end)
+		return true;
+
+	StartLayoutJob();
+	return false;
+}
+
+void FullViewRenderer::MeasureAverages(wxDC& dc)
+{
+	const StyleCache& style = SelectStyle(dc, TextStyleTable::DefaultStyle);
+
+	wxString sample = "The quick brown fox jumps over the lazy dog";
+	wxSize sampleSize = dc.GetTextExtent(sample);
+
+	m_averageCharWidth = std::max(1, sampleSize.GetWidth() / static_cast<int>(sample.Length()));
+	m_averageLineHeight = std::max(1, static_cast<int>(style.height * m_lineSpacing));
+}
 
-	int lineHeight = static_cast<int>(dc.GetTextExtent("M").GetHeight() * m_lineSpacing);
+int FullViewRenderer::EstimateHeight(int paragraph) const
+{
+	int length = m_document->GetLineEnd(paragraph) - m_document->GetLineStart(paragraph);
+	int width = std::max(m_clientWidth - m_marginLeft - m_marginRight, 1);
+	int lines = std::max(1, (length * m_averageCharWidth + width - 1) / width);
+	return lines * m_averageLineHeight;
+}
 
-	for (size_t i = 0; i < words.size(); ++i)
+void FullViewRenderer::CalculateLine(const wxString& text, int startPos, wxDC& dc, ParagraphLayout& layout, int& yPos)
+{
+	// Get style for this line (simplified - take style at start position)
+	StyleCache& style = SelectStyle(dc, m_document->GetStyleIdAt(startPos));
+
+	// Measure word by word - complex scripts are shaped per word
+	size_t length = text.Length();
+	std::vector<int> advances(length);
+	std::vector<int> wordAdvances;
+	size_t wordStart = 0;
+	for (size_t i = 0; i <= length; ++i)
 	{
-		wxString word = words[i];
-		wxSize wordSize = dc.GetTextExtent(word);
+		if (i < length && text[i] != ' ' && text[i] != '\t')
+			continue;
+
+		if (i > wordStart)
+		{
+			MeasureWord(style, text.Mid(wordStart, i - wordStart), dc, wordAdvances);
+			std::copy(wordAdvances.begin(), wordAdvances.end(), advances.begin() + wordStart);
+		}
+		if (i < length)
+			advances[i] = GetAdvance(style, text[i], dc);
+		wordStart = i + 1;
+	}
 
-		if (currentX + wordSize.GetWidth() > m_clientWidth - m_marginRight && !currentLine.IsEmpty())
+	int width = std::max(m_clientWidth - m_marginLeft - m_marginRight, 1);
+	int lineHeight = static_cast<int>(style.height * m_lineSpacing);
+	WrapLines(text.wc_str(), length, advances, width, lineHeight, layout, yPos);
+}
+
+void FullViewRenderer::WrapLines(const wxChar* text, size_t length, const std::vector<int>& advances,
+	int width, int lineHeight, ParagraphLayout& layout, int& yPos)
+{
+	int currentX = 0;
+	size_t lineStartPos = 0;
+	bool lineEmpty = true;
+	int lineEdgeOffset = static_cast<int>(layout.edges.size());
+
+	layout.edges.reserve(layout.edges.size() + length);
+
+	// Words are runs of non-space characters; every space or tab is a word of its own
+	size_t wordStart = 0;
+	while (wordStart < length)
+	{
+		size_t wordEnd = wordStart + 1;
+		if (text[wordStart] != ' ' && text[wordStart] != '\t')
+		{
+			while (wordEnd < length && text[wordEnd] != ' ' && text[wordEnd] != '\t')
+				++wordEnd;
+		}
+
+		int wordWidth = 0;
+		for (size_t i = wordStart; i < wordEnd; ++i)
+			wordWidth += advances[i];
+
+		if (currentX + wordWidth > width && !lineEmpty)
 		{
 			// Word doesn't fit - create new line
 			LayoutLine line;
-			line.startPos = lineStartPos;
-			line.endPos = wordStartPositions[i];
+			line.startPos = static_cast<int>(lineStartPos);
+			line.endPos = static_cast<int>(wordStart);
 			line.y = yPos;
 			line.height = lineHeight;
-			line.charInfo = currentCharInfo;
-			m_lines.push_back(line);
+			line.edgeOffset = lineEdgeOffset;
+			layout.lines.push_back(line);
 
 			yPos += lineHeight;
 
 			// Start new line with current word
-			currentLine = word;
-			currentX = m_marginLeft + wordSize.GetWidth();
-			lineStartPos = wordStartPositions[i];
-
-			// Calculate char info for new line
-			currentCharInfo.clear();
-			int charX = m_marginLeft;
-			for (size_t j = 0; j < word.Length(); ++j)
-			{
-				wxString ch = word.Mid(j, 1);
-				int charWidth = dc.GetTextExtent(ch).GetWidth();
-				currentCharInfo.push_back({charX, charWidth});
-				charX += charWidth;
-			}
+			lineEdgeOffset = static_cast<int>(layout.edges.size());
+			currentX = 0;
+			lineStartPos = wordStart;
 		}
-		else
-		{
-			// Word fits - add to current line
-			if (!currentLine.IsEmpty() || i > 0)
-			{
-				// Add char info for word
-				int charX = currentX;
-				for (size_t j = 0; j < word.Length(); ++j)
-				{
-					wxString ch = word.Mid(j, 1);
-					int charWidth = dc.GetTextExtent(ch).GetWidth();
-					currentCharInfo.push_back({charX, charWidth});
-					charX += charWidth;
-				}
-			}
-			else
-			{
-				// First word in line
-				int charX = m_marginLeft;
-				for (size_t j = 0; j < word.Length(); ++j)
-				{
-					wxString ch = word.Mid(j, 1);
-					int charWidth = dc.GetTextExtent(ch).GetWidth();
-					currentCharInfo.push_back({charX, charWidth});
-					charX += charWidth;
-				}
-			}
 
-			currentLine += word;
-			currentX += wordSize.GetWidth();
+		// Add character edges for word (clamped - only an unbreakable giant word gets there)
+		for (size_t i = wordStart; i < wordEnd; ++i)
+		{
+			currentX += advances[i];
+			layout.edges.push_back(static_cast<uint16_t>(std::min(currentX, 0xFFFF)));
 		}
+
+		lineEmpty = false;
+		wordStart = wordEnd;
 	}
 
 	// Add final line
-	if (!currentLine.IsEmpty())
+	if (!lineEmpty)
 	{
 		LayoutLine line;
-		line.startPos = lineStartPos;
-		line.endPos = startPos + text.Length();
+		line.startPos = static_cast<int>(lineStartPos);
+		line.endPos = static_cast<int>(length);
 		line.y = yPos;
 		line.height = lineHeight;
-		line.charInfo = currentCharInfo;
-		m_lines.push_back(line);
+		line.edgeOffset = lineEdgeOffset;
+		layout.lines.push_back(line);
 
 		yPos += lineHeight;
 	}
@@ -278,28 +662,43 @@ void FullViewRenderer::CalculateLine(const wxString& text, int startPos, wxDC& d
 // ============================================================================
 
 void FullViewRenderer::Render(wxDC& dc, const wxRect& clientRect, int scrollY)
+{
+	RenderArea(dc, clientRect, scrollY, clientRect);
+}
+
+void FullViewRenderer::RenderArea(wxDC& dc, const wxRect& clientRect, int scrollY, const wxRect& updateRect)
 {
 	if (!m_document)
 		return;
 
-	// Recalculate layout if needed
-	if (!m_layoutValid)
-		CalculateLayout();
+	// Recalculate layout if needed (whole document or dirty paragraphs)
+	CalculateLayout();
+	LayoutVisible(dc, scrollY, clientRect.GetHeight());
 
-	// Clear background
-	dc.SetBackground(*wxWHITE_BRUSH);
-	dc.Clear();
+	// Clear background of repainted area only
+	RenderBackground(dc, scrollY, updateRect);
 
-	// Get visible line range
-	int firstLine, lastLine;
-	GetVisibleLineRange(scrollY, clientRect.GetHeight(), firstLine, lastLine);
+	// Get paragraph range of repainted area
+	int firstParagraph, lastParagraph;
+	GetVisibleParagraphRange(scrollY + updateRect.GetTop(), updateRect.GetHeight(), firstParagraph, lastParagraph);
 
-	// Render visible lines
-	for (int i = firstLine; i <= lastLine && i < (int)m_lines.size(); ++i)
+	// Render lines intersecting repainted area
+	for (int paragraph = firstParagraph; paragraph <= lastParagraph; ++paragraph)
 	{
-		RenderLine(dc, m_lines[i], scrollY);
+		int paragraphStart = m_document->GetLineStart(paragraph);
+		int yPos = GetParagraphY(paragraph) - scrollY;
+
+		for (const LayoutLine& line : m_paragraphs[paragraph].lines)
+		{
+			if (yPos + line.y + line.height > updateRect.GetTop() && yPos + line.y <= updateRect.GetBottom())
+				RenderLine(dc, line, paragraphStart, yPos);
+		}
 	}
 
+	// Render highlights of repainted paragraphs
+	if (!m_highlights.empty() && firstParagraph <= lastParagraph)
+		RenderHighlights(dc, scrollY, m_document->GetLineStart(firstParagraph), m_document->GetLineEnd(lastParagraph));
+
 	// Render selection
 	if (m_document->GetSelection().active)
 		RenderSelection(dc, scrollY);
@@ -308,52 +707,53 @@ void FullViewRenderer::Render(wxDC& dc, const wxRect& clientRect, int scrollY)
 	RenderCursor(dc, scrollY);
 }
 
-void FullViewRenderer::RenderLine(wxDC& dc, const LayoutLine& line, int scrollY)
+void FullViewRenderer::RenderBackground(wxDC& dc, [[maybe_unused]] int scrollY, const wxRect& updateRect)
+{
+	dc.SetBrush(*wxWHITE_BRUSH);
+	dc.SetPen(*wxTRANSPARENT_PEN);
+	dc.DrawRectangle(updateRect);
+}
+
+void FullViewRenderer::RenderLine(wxDC& dc, const LayoutLine& line, int paragraphStart, int yPos)
 {
 	if (!m_document)
 		return;
 
-	int yPos = line.y - scrollY;
+	int lineStart = paragraphStart + line.startPos;
+	int lineEnd = paragraphStart + line.endPos;
+	yPos += line.y;
 
 	// Get text for this line
-	wxString lineText = m_document->GetText(line.startPos, line.endPos);
-
-	// Get format runs for this line
-	std::vector<FormatRun> runs = m_document->GetFormatRuns(line.startPos, line.endPos);
-
-	if (runs.empty())
+	wxString lineText = m_document->GetText(lineStart, lineEnd);
+
+	// Render each style run of this line
+	int xPos = m_marginLeft;
+	bool anyRun = false;
+	m_document->ForEachFormatRun(lineStart, lineEnd, [&](int runStartPos, int runEndPos, int styleId) {
+		int runStart = runStartPos - lineStart;
+		int runEnd = runEndPos - lineStart;
+
+		wxString runText = lineText.Mid(runStart, runEnd - runStart);
+		ApplyStyle(dc, styleId);
+		dc.DrawText(runText, xPos, yPos);
+
+		// Advance x position
+		wxSize textSize = dc.GetTextExtent(runText);
+		xPos += textSize.GetWidth();
+		anyRun = true;
+	});
+
+	if (!anyRun)
 	{
 		// No formatting - use default
-		TextFormat defaultFormat;
-		ApplyFormat(dc, defaultFormat);
+		ApplyStyle(dc, TextStyleTable::DefaultStyle);
 		dc.DrawText(lineText, m_marginLeft, yPos);
 	}
-	else
-	{
-		// Render each format run
-		int xPos = m_marginLeft;
-		for (const FormatRun& run : runs)
-		{
-			int runStart = std::max(run.startPos, line.startPos) - line.startPos;
-			int runEnd = std::min(run.endPos, line.endPos) - line.startPos;
-
-			if (runStart < runEnd)
-			{
-				wxString runText = lineText.Mid(runStart, runEnd - runStart);
-				ApplyFormat(dc, run.format);
-				dc.DrawText(runText, xPos, yPos);
-
-				// Advance x position
-				wxSize textSize = dc.GetTextExtent(runText);
-				xPos += textSize.GetWidth();
-			}
-		}
-	}
 }
 
 void FullViewRenderer::RenderCursor(wxDC& dc, int scrollY)
 {
-	if (!m_document)
+	if (!m_document || !m_cursorVisible)
 		return;
 
 	Cursor cursor = m_document->GetCursor();
@@ -394,42 +794,52 @@ void FullViewRenderer::RenderSelection(wxDC& dc, int scrollY)
 	}
 }
 
-void FullViewRenderer::ApplyFormat(wxDC& dc, const TextFormat& format)
+void FullViewRenderer::RenderHighlights(wxDC& dc, int scrollY, int startPos, int endPos)
 {
-	wxFont font = GetFont(format);
-	dc.SetFont(font);
-	dc.SetTextForeground(format.textColor);
-	dc.SetTextBackground(format.backgroundColor);
-}
+	// First highlight ending inside range (ranges are ascending)
+	auto it = std::lower_bound(m_highlights.begin(), m_highlights.end(), startPos,
+		[](const TextRange& range, int pos) { return range.endPos <= pos; });
+	if (it == m_highlights.end() || it->startPos >= endPos)
+		return;
 
-void FullViewRenderer::GetVisibleLineRange(int scrollY, int clientHeight, int& firstLine, int& lastLine) const
-{
-	firstLine = 0;
-	lastLine = m_lines.size() - 1;
+	wxColour color(m_highlightColor.Red(), m_highlightColor.Green(),
+	               m_highlightColor.Blue(), m_selectionOpacity);
+	dc.SetBrush(wxBrush(color));
+	dc.SetPen(*wxTRANSPARENT_PEN);
 
-	// Binary search for first visible line
-	for (size_t i = 0; i < m_lines.size(); ++i)
+	for (; it != m_highlights.end() && it->startPos < endPos; ++it)
 	{
-		if (m_lines[i].y + m_lines[i].height > scrollY)
+		for (wxRect rect : GetSelectionRects(it->startPos, it->endPos))
 		{
-			firstLine = i;
-			break;
+			rect.y -= scrollY;
+			dc.DrawRectangle(rect);
 		}
 	}
+}
 
-	// Find last visible line
-	for (size_t i = firstLine; i < m_lines.size(); ++i)
-	{
-		if (m_lines[i].y > scrollY + clientHeight)
-		{
-			lastLine = i - 1;
-			break;
-		}
-	}
+void FullViewRenderer::ApplyStyle(wxDC& dc, int styleId)
+{
+	SelectStyle(dc, styleId);
+
+	const TextFormat& format = m_document->GetStyle(styleId);
+	dc.SetTextForeground(format.textColor);
+	dc.SetTextBackground(format.backgroundColor);
+}
+
+void FullViewRenderer::GetVisibleParagraphRange(int scrollY, int clientHeight, int& firstParagraph, int& lastParagraph) const
+{
+	firstParagraph = 0;
+	lastParagraph = -1;
+
+	if (m_paragraphs.empty())
+		return;
+
+	// Prefix sums map viewport edges straight to paragraphs
+	firstParagraph = m_heights.FindIndex(std::max(0, scrollY - m_marginTop));
+	lastParagraph = m_heights.FindIndex(std::max(0, scrollY + clientHeight - m_marginTop));
 
 	// Clamp
-	firstLine = std::max(0, firstLine);
-	lastLine = std::min((int)m_lines.size() - 1, lastLine);
+	lastParagraph = std::min(static_cast<int>(m_paragraphs.size()) - 1, lastParagraph);
 }
 
 // ============================================================================
@@ -438,174 +848,558 @@ void FullViewRenderer::GetVisibleLineRange(int scrollY, int clientHeight, int& f
 
 int FullViewRenderer::HitTest(int x, int y, int scrollY) const
 {
-	if (m_lines.empty())
+	if (!m_document || m_paragraphs.empty())
 		return 0;
 
 	int adjustedY = y + scrollY;
 
-	// Find line
-	for (size_t i = 0; i < m_lines.size(); ++i)
+	// Click below all lines
+	if (adjustedY >= m_marginTop + m_heights.GetTotal())
+		return m_document->GetLength();
+
+	// Find paragraph, then line
+	int paragraph = m_heights.FindIndex(std::max(0, adjustedY - m_marginTop));
+	int paragraphStart = m_document->GetLineStart(paragraph);
+	int localY = adjustedY - GetParagraphY(paragraph);
+
+	const ParagraphLayout& layout = m_paragraphs[paragraph];
+	if (layout.lines.empty())
+		return paragraphStart;
+
+	// Last line starting at or above localY (lines are sorted by y)
+	auto it = std::upper_bound(layout.lines.begin(), layout.lines.end(), localY,
+		[](int value, const LayoutLine& line) { return value < line.y; });
+	if (it != layout.lines.begin())
 	{
-		const LayoutLine& line = m_lines[i];
-		if (adjustedY >= line.y && adjustedY < line.y + line.height)
+		const LayoutLine& line = *(it - 1);
+		if (localY < line.y + line.height)
 		{
+			int lineStart = paragraphStart + line.startPos;
+
 			// Found line - now find character
 			if (x < m_marginLeft)
-				return line.startPos;
+				return lineStart;
 
 			int localX = x - m_marginLeft;
-			for (size_t j = 0; j < line.charInfo.size(); ++j)
+			int index = layout.FindChar(line, localX);
+			if (index < line.GetLength())
 			{
-				const CharInfo& charInfo = line.charInfo[j];
-				int charLeft = charInfo.x - m_marginLeft;
-				int charRight = charLeft + charInfo.width;
-
-				if (localX >= charLeft && localX < charRight)
-				{
-					// Found character - return position
-					// If click is in left half of char, return before char; otherwise after
-					if (localX < charLeft + charInfo.width / 2)
-						return line.startPos + j;
-					else
-						return line.startPos + j + 1;
-				}
+				// Found character - return position
+				// If click is in left half of char, return before char; otherwise after
+				int charLeft = layout.GetEdge(line, index);
+				int charRight = layout.GetEdge(line, index + 1);
+				if (localX < charLeft + (charRight - charLeft) / 2)
+					return lineStart + index;
+				else
+					return lineStart + index + 1;
 			}
 
 			// Click after last character in line
-			return line.endPos;
+			return paragraphStart + line.endPos;
 		}
+
+		// Below line but inside paragraph (page gap) - end of line above
+		return paragraphStart + line.endPos;
 	}
 
-	// Click below all lines
-	return m_document ? m_document->GetLength() : 0;
+	// Paragraph not laid out yet
+	return paragraphStart;
 }
 
 wxRect FullViewRenderer::GetCursorRect(int position) const
 {
-	if (m_lines.empty())
+	if (!m_document || m_paragraphs.empty())
 		return wxRect(m_marginLeft, 0, 1, 20);
 
-	// Find line containing position
-	for (const LayoutLine& line : m_lines)
+	// Find paragraph, then line containing position
+	int paragraph = std::min(m_document->GetLineFromPosition(position), static_cast<int>(m_paragraphs.size()) - 1);
+	int paragraphY = GetParagraphY(paragraph);
+	const ParagraphLayout& layout = m_paragraphs[paragraph];
+
+	if (layout.lines.empty())
+		return wxRect(m_marginLeft, paragraphY, 1, 20);
+
+	int paragraphPos = position - m_document->GetLineStart(paragraph);
+
+	// Line containing position (lines are sorted by start), or after last line
+	auto it = std::upper_bound(layout.lines.begin(), layout.lines.end(), paragraphPos,
+		[](int value, const LayoutLine& line) { return value < line.startPos; });
+	const LayoutLine& line = it != layout.lines.begin() ? *(it - 1) : layout.lines.front();
+
+	// Past the end of line the cursor sits after its last character
+	int localPos = std::max(paragraphPos - line.startPos, 0);
+	int xPos = m_marginLeft + layout.GetEdge(line, localPos);
+	return wxRect(xPos, paragraphY + line.y, 1, line.height);
+}
+
+std::vector<wxRect> FullViewRenderer::GetSelectionRects(int startPos, int endPos) const
+{
+	std::vector<wxRect> rects;
+
+	if (!m_document || m_paragraphs.empty() || startPos >= endPos)
+		return rects;
+
+	// Find lines intersecting selection (only paragraphs inside it)
+	int lastParagraph = static_cast<int>(m_paragraphs.size()) - 1;
+	int firstParagraph = std::min(m_document->GetLineFromPosition(startPos), lastParagraph);
+	lastParagraph = std::min(m_document->GetLineFromPosition(endPos), lastParagraph);
+
+	for (int paragraph = firstParagraph; paragraph <= lastParagraph; ++paragraph)
 	{
-		if (line.Contains(position))
+		int paragraphStart = m_document->GetLineStart(paragraph);
+		int paragraphY = GetParagraphY(paragraph);
+		const ParagraphLayout& layout = m_paragraphs[paragraph];
+
+		for (const LayoutLine& line : layout.lines)
 		{
-			int localPos = position - line.startPos;
-			if (localPos < (int)line.charInfo.size())
-			{
-				const CharInfo& charInfo = line.charInfo[localPos];
-				return wxRect(charInfo.x, line.y, 1, line.height);
-			}
-			else
-			{
-				// Cursor at end of line
-				int xPos = m_marginLeft;
-				if (!line.charInfo.empty())
-				{
-					const CharInfo& lastChar = line.charInfo.back();
-					xPos = lastChar.x + lastChar.width;
-				}
-				return wxRect(xPos, line.y, 1, line.height);
-			}
+			int lineStart = paragraphStart + line.startPos;
+			int lineEnd = paragraphStart + line.endPos;
+
+			if (lineEnd <= startPos || lineStart >= endPos)
+				continue;
+
+			int selStart = std::max(startPos, lineStart);
+			int selEnd = std::min(endPos, lineEnd);
+
+			int localStart = selStart - lineStart;
+			int localEnd = selEnd - lineStart;
+
+			int xStart = m_marginLeft + layout.GetEdge(line, localStart);
+			int xEnd = m_marginLeft + layout.GetEdge(line, localEnd);
+
+			wxRect selRect(xStart, paragraphY + line.y, xEnd - xStart, line.height);
+			rects.push_back(selRect);
 		}
 	}
 
-	// Position not found - return at end
-	if (!m_lines.empty())
+	return rects;
+}
+
+// ============================================================================
+// Font Management
+// ============================================================================
+
+FullViewRenderer::StyleCache& FullViewRenderer::SelectStyle(wxDC& dc, int styleId)
+{
+	if (styleId < 0 || styleId >= m_document->GetStyleCount())
+		styleId = TextStyleTable::DefaultStyle;
+
+	// Styles interned since last call get empty slots
+	if (styleId >= static_cast<int>(m_styleCache.size()))
+		m_styleCache.resize(m_document->GetStyleCount());
+
+	bool measuring = m_measureDC && &dc == m_measureDC.get();
+	StyleCache& style = m_styleCache[styleId];
+	if (!style.valid)
+	{
+		// Create font and measure it once per style
+		const TextFormat& format = m_document->GetStyle(styleId);
+		style.font = wxFont(format.fontSize,
+			wxFONTFAMILY_DEFAULT,
+			format.italic ? wxFONTSTYLE_ITALIC : wxFONTSTYLE_NORMAL,
+			format.bold ? wxFONTWEIGHT_BOLD : wxFONTWEIGHT_NORMAL,
+			format.underline,
+			format.fontName);
+
+		dc.SetFont(style.font);
+		wxCoord width = 0, height = 0, descent = 0;
+		dc.GetTextExtent("M", &width, &height, &descent);
+		style.height = height;
+		style.descent = descent;
+		style.ascent = height - descent;
+		style.directAdvances.assign(StyleCache::DirectAdvances, -1);
+		style.otherAdvances.clear();
+		style.valid = true;
+		if (measuring)
+			m_measureStyle = styleId;
+		return style;
+	}
+
+	if (!measuring || m_measureStyle != styleId)
+	{
+		dc.SetFont(style.font);
+		if (measuring)
+			m_measureStyle = styleId;
+	}
+	return style;
+}
+
+wxDC& FullViewRenderer::GetMeasureDC()
+{
+	if (!m_measureDC)
+	{
+		// Text extents do not depend on bitmap size - smallest one will do
+		m_measureBitmap.Create(1, 1);
+		m_measureDC = std::make_unique<wxMemoryDC>();
+		m_measureDC->SelectObject(m_measureBitmap);
+		m_measureStyle = -1;
+	}
+	return *m_measureDC;
+}
+
+/// Check if character needs shaping - its advance depends on its neighbours
+/// (combining marks, joining and complex scripts, surrogate pairs)
+static bool IsComplexScript(wxChar ch)
+{
+	unsigned int code = static_cast<unsigned int>(ch);
+	return (code >= 0x0300 && code <= 0x036F)    // Combining diacritical marks
+		|| (code >= 0x0590 && code <= 0x0DFF)     // Hebrew, Arabic, Syriac, Thaana, Indic
+		|| (code >= 0x0E00 && code <= 0x109F)     // Thai, Lao, Tibetan, Myanmar
+		|| (code >= 0x1780 && code <= 0x17FF)     // Khmer
+		|| (code >= 0x200C && code <= 0x200F)     // Joiners, direction marks
+		|| (code >= 0xD800 && code <= 0xDFFF)     // Surrogates (UTF-16 builds)
+		|| (code >= 0xFB1D && code <= 0xFDFF)     // Hebrew / Arabic presentation forms
+		|| (code >= 0xFE00 && code <= 0xFE0F)     // Variation selectors
+		|| (code >= 0xFE20 && code <= 0xFE2F)     // Combining half marks
+		|| (code >= 0xFE70 && code <= 0xFEFF);    // Arabic presentation forms-B
+}
+
+int FullViewRenderer::GetAdvance(StyleCache& style, wxChar ch, wxDC& dc)
+{
+	unsigned int code = static_cast<unsigned int>(ch);
+	if (code < StyleCache::DirectAdvances)
+	{
+		int& advance = style.directAdvances[code];
+		if (advance < 0)
+			advance = dc.GetTextExtent(wxString(ch)).GetWidth();
+		return advance;
+	}
+
+	auto it = style.otherAdvances.find(ch);
+	if (it != style.otherAdvances.end())
+		return it->second;
+
+	int advance = dc.GetTextExtent(wxString(ch)).GetWidth();
+	style.otherAdvances.emplace(ch, advance);
+	return advance;
+}
+
+int FullViewRenderer::MeasureWord(StyleCache& style, const wxString& word, wxDC& dc, std::vector<int>& advances)
+{
+	advances.resize(word.Length());
+
+	bool complex = std::any_of(word.begin(), word.end(), [](wxChar ch) { return IsComplexScript(ch); });
+	if (complex)
 	{
-		const LayoutLine& lastLine = m_lines.back();
-		int xPos = m_marginLeft;
-		if (!lastLine.charInfo.empty())
+		// Shaped text - glyphs are not independent, let the DC measure the whole word
+		wxArrayInt extents;
+		dc.GetPartialTextExtents(word, extents);
+
+		int previous = 0;
+		for (size_t i = 0; i < advances.size(); ++i)
 		{
-			const CharInfo& lastChar = lastLine.charInfo.back();
-			xPos = lastChar.x + lastChar.width;
+			int extent = i < extents.size() ? extents[i] : previous;
+			advances[i] = extent - previous;
+			previous = extent;
 		}
-		return wxRect(xPos, lastLine.y, 1, lastLine.height);
+		return previous;
 	}
 
-	return wxRect(m_marginLeft, 0, 1, 20);
+	int width = 0;
+	for (size_t i = 0; i < advances.size(); ++i)
+	{
+		advances[i] = GetAdvance(style, word[i], dc);
+		width += advances[i];
+	}
+	return width;
 }
 
-std::vector<wxRect> FullViewRenderer::GetSelectionRects(int startPos, int endPos) const
+wxSize FullViewRenderer::MeasureText(const wxString& text, int styleId, wxDC& dc)
 {
-	std::vector<wxRect> rects;
+	SelectStyle(dc, styleId);
+	return dc.GetTextExtent(text);
+}
 
-	if (m_lines.empty() || startPos >= endPos)
-		return rects;
+// ============================================================================
+// Background Layout
+// ============================================================================
+
+void FullViewRenderer::StartLayoutJob()
+{
+	auto job = std::make_shared<LayoutJob>();
+	job->generation = m_layoutGeneration;
+	job->first = m_idleNext;
+	job->width = std::max(m_clientWidth - m_marginLeft - m_marginRight, 1);
+	job->lineSpacing = m_lineSpacing;
+	CopyAdvanceTable(*job, TextStyleTable::DefaultStyle);
+
+	// Copy unmeasured paragraphs (measured ones get empty slots, skipped when applied)
+	int count = static_cast<int>(m_paragraphs.size());
+	size_t chars = 0;
+	for (int paragraph = m_idleNext;
+		paragraph < count && job->texts.size() < LAYOUT_JOB_PARAGRAPHS && chars < LAYOUT_JOB_CHARS;
+		++paragraph)
+	{
+		int styleId = TextStyleTable::DefaultStyle;
+		if (m_paragraphs[paragraph].measured)
+			job->texts.emplace_back();
+		else
+		{
+			job->texts.push_back(m_document->GetLineText(paragraph).ToStdWstring());
+			styleId = m_document->GetStyleIdAt(m_document->GetLineStart(paragraph));
+			if (styleId < 0 || styleId >= m_document->GetStyleCount())
+				styleId = TextStyleTable::DefaultStyle;
+			if (job->styles.find(styleId) == job->styles.end())
+				CopyAdvanceTable(*job, styleId);
+		}
+		job->styleIds.push_back(styleId);
+		chars += job->texts.back().length();
+	}
+	job->results.resize(job->texts.size());
+
+	m_layoutEnd = job->first + static_cast<int>(job->texts.size());
+	m_layoutJob = job;
+	bwxJobSystem::GetInstance().Schedule([job]() {
+		RunLayoutJob(*job);
+		wxWakeUpIdle();
+	}, &m_layoutJobs);
+}
 
-	// Find lines intersecting selection
-	for (const LayoutLine& line : m_lines)
+void FullViewRenderer::ApplyLayoutJob()
+{
+	std::shared_ptr<LayoutJob> job = std::move(m_layoutJob);
+	m_layoutJob.reset();
+
+	// Edited or re-laid out since job started - paragraphs may have moved
+	if (job->generation != m_layoutGeneration)
+	{
+		m_layoutEnd = 0;
+		return;
+	}
+
+	int count = static_cast<int>(m_paragraphs.size());
+	int size = std::min(static_cast<int>(job->results.size()), count - job->first);
+	for (int i = 0; i < size; ++i)
 	{
-		if (line.endPos <= startPos || line.startPos >= endPos)
+		ParagraphLayout& result = job->results[i];
+		ParagraphLayout& layout = m_paragraphs[job->first + i];
+		if (!result.measured || layout.measured)
 			continue;
 
-		int selStart = std::max(startPos, line.startPos);
-		int selEnd = std::min(endPos, line.endPos);
+		layout.lines = std::move(result.lines);
+		layout.edges = std::move(result.edges);
+		layout.height = result.height;
+		layout.measured = true;
+		m_heights.Set(job->first + i, layout.height);
+	}
+}
+
+void FullViewRenderer::CopyAdvanceTable(LayoutJob& job, int styleId) const
+{
+	if (styleId >= static_cast<int>(m_styleCache.size()) || !m_styleCache[styleId].valid)
+		return;
+
+	const StyleCache& style = m_styleCache[styleId];
+	AdvanceTable& table = job.styles[styleId];
+	table.height = style.height;
+	table.directAdvances = style.directAdvances;
+	table.otherAdvances = style.otherAdvances;
+}
+
+void FullViewRenderer::RunLayoutJob(LayoutJob& job)
+{
+	std::vector<int> advances;
+	for (size_t i = 0; i < job.texts.size(); ++i)
+	{
+		const std::wstring& text = job.texts[i];
+		auto it = job.styles.find(text.empty() ? static_cast<int>(TextStyleTable::DefaultStyle) : job.styleIds[i]);
+		if (it == job.styles.end())
+			continue;
 
-		int localStart = selStart - line.startPos;
-		int localEnd = selEnd - line.startPos;
+		const AdvanceTable& table = it->second;
+		int lineHeight = static_cast<int>(table.height * job.lineSpacing);
+		ParagraphLayout& layout = job.results[i];
 
-		int xStart = m_marginLeft;
-		if (localStart > 0 && localStart <= (int)line.charInfo.size())
-			xStart = line.charInfo[localStart - 1].x + line.charInfo[localStart - 1].width;
+		if (text.empty())
+		{
+			// Empty line (just newline), or measured paragraph (skipped when applied)
+			LayoutLine emptyLine;
+			emptyLine.startPos = 0;
+			emptyLine.endPos = 0;
+			emptyLine.y = 0;
+			emptyLine.height = lineHeight;
+			emptyLine.edgeOffset = 0;
+			layout.lines.push_back(emptyLine);
+			layout.height = lineHeight;
+			layout.measured = true;
+			continue;
+		}
 
-		int xEnd = m_marginLeft;
-		if (localEnd > 0 && localEnd <= (int)line.charInfo.size())
+		// Every character needs a cached advance - otherwise UI thread measures paragraph
+		advances.resize(text.length());
+		bool complete = true;
+		for (size_t j = 0; j < text.length() && complete; ++j)
 		{
-			if (localEnd < (int)line.charInfo.size())
-				xEnd = line.charInfo[localEnd].x;
+			wxChar ch = text[j];
+			unsigned int code = static_cast<unsigned int>(ch);
+			if (IsComplexScript(ch))
+				complete = false;
+			else if (code < StyleCache::DirectAdvances)
+			{
+				advances[j] = table.directAdvances[code];
+				complete = advances[j] >= 0;
+			}
 			else
 			{
-				const CharInfo& lastChar = line.charInfo.back();
-				xEnd = lastChar.x + lastChar.width;
+				auto advance = table.otherAdvances.find(ch);
+				complete = advance != table.otherAdvances.end();
+				if (complete)
+					advances[j] = advance->second;
 			}
 		}
+		if (!complete)
+			continue;
 
-		wxRect selRect(xStart, line.y, xEnd - xStart, line.height);
-		rects.push_back(selRect);
+		int yPos = 0;
+		WrapLines(text.c_str(), text.length(), advances, job.width, lineHeight, layout, yPos);
+		layout.height = yPos;
+		layout.measured = true;
 	}
+}
 
-	return rects;
+void FullViewRenderer::DiscardLayoutJob()
+{
+	// Running job finishes on its own, ApplyLayoutJob() drops its results
+	++m_layoutGeneration;
+	m_layoutEnd = 0;
 }
 
 // ============================================================================
-// Font Management
+// PageViewRenderer Implementation
 // ============================================================================
 
-wxFont FullViewRenderer::GetFont(const TextFormat& format)
+PageViewRenderer::PageViewRenderer()
+	: m_pageSize(794, 1123)
+	, m_pageMarginH(96)
+	, m_pageMarginV(96)
+	, m_pageGap(20)
 {
-	// Create cache key
-	wxString key = wxString::Format("%s-%d-%d-%d-%d",
-		format.fontName,
-		format.fontSize,
-		format.bold ? 1 : 0,
-		format.italic ? 1 : 0,
-		format.underline ? 1 : 0);
+	m_marginTop = m_pageGap + m_pageMarginV;
+	UpdateColumn();
+}
 
-	// Check cache
-	auto it = m_fontCache.find(key);
-	if (it != m_fontCache.end())
-		return it->second;
+void PageViewRenderer::SetPageSize(const wxSize& size)
+{
+	m_pageSize = size;
+	UpdateColumn();
+	InvalidateLayout();
+}
+
+void PageViewRenderer::SetPageMargins(int horizontal, int vertical)
+{
+	m_pageMarginH = horizontal;
+	m_pageMarginV = vertical;
+	m_marginTop = m_pageGap + m_pageMarginV;
+	UpdateColumn();
+	InvalidateLayout();
+}
 
-	// Create new font
-	wxFont font(format.fontSize,
-		wxFONTFAMILY_DEFAULT,
-		format.italic ? wxFONTSTYLE_ITALIC : wxFONTSTYLE_NORMAL,
-		format.bold ? wxFONTWEIGHT_BOLD : wxFONTWEIGHT_NORMAL,
-		format.underline,
-		format.fontName);
+void PageViewRenderer::UpdateColumn()
+{
+	// Column width stays page width minus margins, whatever client width is
+	int columnWidth = std::max(m_pageSize.GetWidth() - 2 * m_pageMarginH, 1);
+	m_marginLeft = std::max((m_clientWidth - m_pageSize.GetWidth()) / 2, 0) + m_pageMarginH;
+	m_marginRight = m_clientWidth - m_marginLeft - columnWidth;
+}
 
-	// Cache it
-	m_fontCache[key] = font;
+void PageViewRenderer::OnResize(int width, int height)
+{
+	if (width == m_clientWidth && height == m_clientHeight)
+		return;
 
-	return font;
+	// Pages only move sideways - no re-wrap needed
+	m_clientWidth = width;
+	m_clientHeight = height;
+	UpdateColumn();
+	AddDamage(0, INT_MAX);
 }
 
-wxSize FullViewRenderer::MeasureText(const wxString& text, const TextFormat& format, wxDC& dc)
+int PageViewRenderer::GetPageCount() const
 {
-	wxFont font = GetFont(format);
-	dc.SetFont(font);
-	return dc.GetTextExtent(text);
+	return m_heights.GetTotal() / GetPageStride() + 1;
+}
+
+int PageViewRenderer::GetTotalHeight() const
+{
+	return m_pageGap + GetPageCount() * GetPageStride();
+}
+
+void PageViewRenderer::PaginateParagraph(ParagraphLayout& layout, int pageY)
+{
+	layout.pageY = pageY;
+	if (!layout.measured)
+		return;
+
+	// Lines are stacked from LayoutParagraph() or a previous pagination -
+	// restack them, skipping to next page text area where a line would cross page bottom
+	int stride = GetPageStride();
+	int textHeight = GetPageTextHeight();
+	int yPos = 0;
+	int yInPage = pageY;
+	for (LayoutLine& line : layout.lines)
+	{
+		if (yInPage > 0 && yInPage + line.height > textHeight)
+		{
+			yPos += std::max(stride - yInPage, 0);
+			yInPage = 0;
+		}
+		line.y = yPos;
+		yPos += line.height;
+		yInPage += line.height;
+	}
+	layout.height = yPos;
+}
+
+void PageViewRenderer::OnParagraphsLaidOut(int first, int last)
+{
+	int count = static_cast<int>(m_paragraphs.size());
+	if (first < 0 || first >= count)
+		return;
+
+	// Re-flow from first laid out paragraph until paragraphs start
+	// where they started before (page breaks below are unchanged then)
+	int stride = GetPageStride();
+	int offset = m_heights.GetOffset(first);
+	for (int paragraph = first; paragraph < count; ++paragraph)
+	{
+		ParagraphLayout& layout = m_paragraphs[paragraph];
+		int pageY = offset % stride;
+		if (paragraph > last && (layout.pageY == pageY || !layout.measured))
+		{
+			layout.pageY = pageY;
+			break;
+		}
+
+		int oldHeight = layout.height;
+		PaginateParagraph(layout, pageY);
+		if (layout.height != oldHeight)
+			m_heights.Set(paragraph, layout.height);
+		AddParagraphDamage(paragraph, oldHeight);
+		offset += layout.height;
+	}
+}
+
+void PageViewRenderer::RenderBackground(wxDC& dc, int scrollY, const wxRect& updateRect)
+{
+	// Desk
+	dc.SetPen(*wxTRANSPARENT_PEN);
+	dc.SetBrush(wxBrush(wxColour(160, 160, 160)));
+	dc.DrawRectangle(updateRect);
+
+	// Pages intersecting repainted area only
+	int stride = GetPageStride();
+	int top = updateRect.GetTop() + scrollY - m_pageGap;
+	int firstPage = std::max(top / stride, 0);
+	int lastPage = std::min((updateRect.GetBottom() + scrollY - m_pageGap) / stride, GetPageCount() - 1);
+	int pageX = m_marginLeft - m_pageMarginH;
+
+	dc.SetBrush(*wxWHITE_BRUSH);
+	dc.SetPen(wxPen(wxColour(120, 120, 120)));
+	for (int page = firstPage; page <= lastPage; ++page)
+	{
+		int pageTop = m_pageGap + page * stride - scrollY;
+		dc.DrawRectangle(pageX, pageTop, m_pageSize.GetWidth(), m_pageSize.GetHeight());
+	}
 }
 
 } // namespace gui